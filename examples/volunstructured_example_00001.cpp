@@ -0,0 +1,251 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+/*!
+	\example volunstructured_example_00001.cpp
+
+	\brief Spatial reordering of an unstructured patch
+
+	This example creates a structured grid of hexahedra whose vertices and
+	cells are stored in random order, then reorders the patch using the
+	available spatial orderings and measures the time needed to perform a
+	loop over the face neighbours of all the cells.
+
+	<b>To run</b>: ./volunstructured_example_00001 [n] \n
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <random>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_volunstructured.hpp"
+
+using namespace bitpit;
+
+/**
+ * Creates a structured grid of hexahedra whose vertices and cells are
+ * created in random order.
+ *
+ * \param n is the number of cells along each direction
+ * \param patch is the patch that will be filled
+ */
+void createShuffledGrid(int n, VolUnstructured *patch)
+{
+	std::mt19937 generator(1);
+
+	std::vector<std::array<int, 3>> vertexIndexes;
+	for (int k = 0; k <= n; ++k) {
+		for (int j = 0; j <= n; ++j) {
+			for (int i = 0; i <= n; ++i) {
+				vertexIndexes.push_back({{i, j, k}});
+			}
+		}
+	}
+	std::shuffle(vertexIndexes.begin(), vertexIndexes.end(), generator);
+
+	double h = 1. / n;
+	std::vector<long> vertexIds((n + 1) * (n + 1) * (n + 1));
+	auto vertexIndex = [n](int i, int j, int k) {
+		return i + (n + 1) * (j + (n + 1) * k);
+	};
+
+	patch->reserveVertices(vertexIndexes.size());
+	for (const std::array<int, 3> &ijk : vertexIndexes) {
+		std::array<double, 3> coords = {{ijk[0] * h, ijk[1] * h, ijk[2] * h}};
+		vertexIds[vertexIndex(ijk[0], ijk[1], ijk[2])] = patch->addVertex(coords)->getId();
+	}
+
+	std::vector<std::array<int, 3>> cellIndexes;
+	for (int k = 0; k < n; ++k) {
+		for (int j = 0; j < n; ++j) {
+			for (int i = 0; i < n; ++i) {
+				cellIndexes.push_back({{i, j, k}});
+			}
+		}
+	}
+	std::shuffle(cellIndexes.begin(), cellIndexes.end(), generator);
+
+	patch->reserveCells(cellIndexes.size());
+	for (const std::array<int, 3> &ijk : cellIndexes) {
+		int i = ijk[0];
+		int j = ijk[1];
+		int k = ijk[2];
+
+		std::vector<long> connect = {{
+			vertexIds[vertexIndex(i,     j,     k)], vertexIds[vertexIndex(i + 1, j,     k)],
+			vertexIds[vertexIndex(i + 1, j + 1, k)], vertexIds[vertexIndex(i,     j + 1, k)],
+			vertexIds[vertexIndex(i,     j,     k + 1)], vertexIds[vertexIndex(i + 1, j,     k + 1)],
+			vertexIds[vertexIndex(i + 1, j + 1, k + 1)], vertexIds[vertexIndex(i,     j + 1, k + 1)]
+		}};
+
+		patch->addCell(ElementType::HEXAHEDRON, connect);
+	}
+}
+
+/**
+ * Measures the time needed to loop over the face neighbours of all the
+ * cells of the patch.
+ *
+ * For each cell, the loop gathers the coordinates of the vertices and the
+ * values of a field defined on the neighbouring cells.
+ *
+ * \param patch is the patch
+ * \param nSweeps is the number of sweeps that will be performed
+ * \result The average time needed to perform a sweep, expressed in
+ * milliseconds.
+ */
+double measureNeighbourSweep(const VolUnstructured &patch, int nSweeps)
+{
+	PiercedStorage<double, long> values(1, &patch.getCells());
+	PiercedStorage<double, long> results(1, &patch.getCells());
+	for (const Cell &cell : patch.getCells()) {
+		values[cell.getId()] = static_cast<double>(cell.getId());
+	}
+
+	double checksum = 0.;
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	for (int n = 0; n < nSweeps; ++n) {
+		for (const Cell &cell : patch.getCells()) {
+			long cellId = cell.getId();
+
+			double result = 0.;
+			for (long vertexId : cell.getVertexIds()) {
+				result += patch.getVertexCoords(vertexId)[0];
+			}
+
+			int nCellAdjacencies = cell.getAdjacencyCount();
+			const long *cellAdjacencies = cell.getAdjacencies();
+			for (int k = 0; k < nCellAdjacencies; ++k) {
+				long neighId = cellAdjacencies[k];
+				if (neighId >= 0) {
+					result += values[neighId] - values[cellId];
+				}
+			}
+
+			results[cellId] = result;
+		}
+
+		checksum += results[patch.getCells().begin()->getId()];
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	log::cout() << "   (checksum " << checksum << ")" << std::endl;
+
+	return std::chrono::duration<double, std::milli>(end - begin).count() / nSweeps;
+}
+
+/**
+ * Run the example.
+ *
+ * \param n is the number of cells along each direction
+ */
+void run(int n)
+{
+	const int N_SWEEPS = 10;
+
+	// Create the patch
+	log::cout() << std::endl << "::: Creating a shuffled grid of " << n << "x" << n << "x" << n << " hexahedra :::" << std::endl;
+
+#if BITPIT_ENABLE_MPI==1
+	VolUnstructured reference(3, MPI_COMM_NULL);
+#else
+	VolUnstructured reference(3);
+#endif
+	createShuffledGrid(n, &reference);
+	reference.initializeAdjacencies();
+	reference.update();
+
+	// Measure the sweep on the shuffled patch
+	log::cout() << std::endl << "::: Measuring neighbour sweep :::" << std::endl;
+	log::cout() << std::endl;
+
+	double referenceTime = measureNeighbourSweep(reference, N_SWEEPS);
+	log::cout() << "  Shuffled storage: " << referenceTime << " ms" << std::endl;
+
+	// Measure the sweep on the reordered patches
+	std::map<PatchKernel::SpatialOrdering, std::string> orderings = {
+		{PatchKernel::SPATIAL_ORDERING_HILBERT, "Hilbert"},
+		{PatchKernel::SPATIAL_ORDERING_MORTON, "Morton"},
+		{PatchKernel::SPATIAL_ORDERING_RCM, "Reverse Cuthill-McKee"}
+	};
+
+	for (const auto &entry : orderings) {
+		VolUnstructured patch(reference);
+
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		patch.reorder(entry.first, true, false);
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		double reorderTime = std::chrono::duration<double, std::milli>(end - begin).count();
+
+		double time = measureNeighbourSweep(patch, N_SWEEPS);
+		log::cout() << "  " << entry.second << " ordering: " << time << " ms";
+		log::cout() << " (speedup " << (referenceTime / time) << ", reorder time " << reorderTime << " ms)" << std::endl;
+	}
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#endif
+
+	int nProcs;
+	int rank;
+#if BITPIT_ENABLE_MPI==1
+	MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+	nProcs = 1;
+	rank   = 0;
+#endif
+
+	// Initialize the logger
+	log::manager().initialize(log::MODE_SEPARATE, false, nProcs, rank);
+	log::cout() << log::fileVerbosity(log::LEVEL_INFO);
+
+	// Run the example
+	int n = 48;
+	if (argc > 1) {
+		n = std::max(std::atoi(argv[1]), 1);
+	}
+
+	try {
+		run(n);
+	} catch (const std::exception &exception) {
+		log::cout() << exception.what();
+		exit(1);
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+}
@@ -43,6 +43,7 @@
 #include "binary_archive.hpp"
 #include "configuration.hpp"
 #include "index_generator.hpp"
+#include "mapped_archive.hpp"
 #include "VTK.hpp"
 #include "DGF.hpp"
 #include "GenericIO.hpp"
@@ -0,0 +1,795 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bitpit_common.hpp"
+
+#include "binary_archive.hpp"
+#include "mapped_archive.hpp"
+
+namespace bitpit {
+
+/*!
+    \class MappedArchive
+    \ingroup Binary
+
+    \brief Base class for memory-mappable binary archives.
+
+    A mapped archive is a binary file made of a fixed-size header followed
+    by a list of sections. Each section is an array of trivially copyable
+    items identified by a numeric key. Sections start at offsets that are
+    multiple of SECTION_ALIGNMENT, this allows to map the archive in memory
+    and to access the items of the sections directly, without copying them
+    into intermediate buffers.
+
+    Data that cannot be stored in sections, can be written to the metadata
+    of the archive, which is accessed through the standard stream interface
+    of the archive. Metadata is stored as a special section of the archive.
+
+    The header contains a signature, the version of the format, a byte order
+    mark, the version of the archive and the list of the sections. Archives
+    written on a machine with a different byte order cannot be read.
+
+    Names of the archives are generated using the same rules used for
+    generating the names of binary archives, the only difference is the
+    default extension.
+*/
+
+const std::size_t MappedArchive::HEADER_SIZE       = 4096;
+const std::size_t MappedArchive::SECTION_ALIGNMENT = 4096;
+const std::size_t MappedArchive::MAX_SECTIONS      = 128;
+
+const std::string MappedArchive::EXTENSION_DEFAULT = "ckp";
+
+const char MappedArchive::SIGNATURE[16]   = "bitpit-mapped";
+const uint32_t MappedArchive::FORMAT_VERSION  = 1;
+const uint32_t MappedArchive::BYTE_ORDER_MARK = 0x01020304;
+const uint32_t MappedArchive::METADATA_KEY    = std::numeric_limits<uint32_t>::max();
+
+/*!
+    Generates the path of the archive with the specified properties.
+
+    \param name is the name of the file
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+    \result The path of the archive with the specified properties.
+*/
+std::string MappedArchive::generatePath(const std::string &name, int block)
+{
+    return generatePath(name, EXTENSION_DEFAULT, block);
+}
+
+/*!
+    Generates the path of the archive with the specified properties.
+
+    \param name is the name of the file
+    \param extension is the extension of the file
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+    \result The path of the archive with the specified properties.
+*/
+std::string MappedArchive::generatePath(const std::string &name, const std::string &extension, int block)
+{
+    return BinaryArchive::generatePath(name, extension, block);
+}
+
+/*!
+    Default constructor
+*/
+MappedArchive::MappedArchive()
+    : m_version(VERSION_UNDEFINED)
+{
+}
+
+/*!
+    Gets the version associated to the archive.
+
+    \result The version associated to the archive.
+*/
+int MappedArchive::getVersion() const
+{
+    return m_version;
+}
+
+/*!
+    Gets the path of the archive.
+
+    \result The path of the archive.
+*/
+std::string MappedArchive::getPath() const
+{
+    return m_path;
+}
+
+/*!
+    Gets the number of sections stored in the archive.
+
+    The section containing the metadata of the archive is not taken into
+    account.
+
+    \result The number of sections stored in the archive.
+*/
+std::size_t MappedArchive::getSectionCount() const
+{
+    std::size_t nSections = m_sections.size();
+    if (hasSection(METADATA_KEY)) {
+        --nSections;
+    }
+
+    return nSections;
+}
+
+/*!
+    Checks if the archive contains the specified section.
+
+    \param key is the key of the section
+    \result Returns true if the archive contains the specified section, false
+    otherwise.
+*/
+bool MappedArchive::hasSection(uint32_t key) const
+{
+    return (findSection(key) != nullptr);
+}
+
+/*!
+    Gets the number of items stored in the specified section.
+
+    \param key is the key of the section
+    \result The number of items stored in the specified section, if the
+    section doesn't exist, zero is returned.
+*/
+std::size_t MappedArchive::getSectionSize(uint32_t key) const
+{
+    const SectionInfo *section = findSection(key);
+    if (!section) {
+        return 0;
+    }
+
+    return static_cast<std::size_t>(section->count);
+}
+
+/*!
+    Finds the information associated with the specified section.
+
+    \param key is the key of the section
+    \result A pointer to the information associated with the specified section
+    or a null pointer if the archive doesn't contain the specified section.
+*/
+const MappedArchive::SectionInfo * MappedArchive::findSection(uint32_t key) const
+{
+    for (const SectionInfo &section : m_sections) {
+        if (section.key == key) {
+            return &section;
+        }
+    }
+
+    return nullptr;
+}
+
+/*!
+    Resets the information associated with the archive.
+*/
+void MappedArchive::resetArchive()
+{
+    m_version = VERSION_UNDEFINED;
+    m_path.clear();
+    m_sections.clear();
+}
+
+/*!
+    \ingroup Binary
+    \class OMappedArchive
+    \brief Output memory-mappable binary archive.
+
+    Sections are written directly to the file, hence they can be written in
+    chunks and there is no need to hold the whole contents of a section in
+    memory. Metadata is buffered in memory and it is written to the file,
+    together with the header, when the archive is closed.
+*/
+
+/*!
+    Creates a new output archive.
+*/
+OMappedArchive::OMappedArchive()
+    : std::ostream(nullptr),
+      m_sectionOpen(false)
+{
+    rdbuf(&m_metadata);
+}
+
+/*!
+    Creates a new output archive.
+
+    \param name is the name of the file
+    \param version is the version of the archive
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+OMappedArchive::OMappedArchive(const std::string &name, int version, int block)
+    : OMappedArchive()
+{
+    open(name, EXTENSION_DEFAULT, version, block);
+}
+
+/*!
+    Creates a new output archive.
+
+    \param name is the name of the file
+    \param extension is the extension of the file
+    \param version is the version of the archive
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+OMappedArchive::OMappedArchive(const std::string &name, const std::string &extension, int version, int block)
+    : OMappedArchive()
+{
+    open(name, extension, version, block);
+}
+
+/*!
+    Destructor.
+
+    If the archive is still open, it will be closed. Errors cannot be reported
+    by the destructor, archives should be explicitly closed to detect errors
+    that occur while finalizing the file.
+*/
+OMappedArchive::~OMappedArchive()
+{
+    try {
+        close();
+    } catch (const std::exception &exception) {
+        BITPIT_UNUSED(exception);
+    }
+}
+
+/*!
+    Opens the specified file.
+
+    \param name is the name of the file
+    \param version is the version of the archive
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+void OMappedArchive::open(const std::string &name, int version, int block)
+{
+    open(name, EXTENSION_DEFAULT, version, block);
+}
+
+/*!
+    Opens the specified file.
+
+    \param name is the name of the file
+    \param extension is the extension of the file
+    \param version is the version of the archive
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+void OMappedArchive::open(const std::string &name, const std::string &extension, int version, int block)
+{
+    // Close the previous file
+    close();
+
+    // Open the file
+    m_path    = generatePath(name, extension, block);
+    m_version = version;
+
+    m_file.open(m_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.good()) {
+        throw std::runtime_error("Unable to open the mapped archive \"" + m_path + "\".");
+    }
+
+    // Reserve space for the header
+    std::vector<char> emptyHeader(HEADER_SIZE, 0);
+    m_file.write(emptyHeader.data(), emptyHeader.size());
+
+    // Reset metadata
+    m_metadata.str(std::string());
+    clear();
+}
+
+/*!
+    Closes the archive.
+
+    Metadata and header are written to the file, then the file is closed.
+*/
+void OMappedArchive::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    if (m_sectionOpen) {
+        endSection();
+    }
+
+    // Write metadata
+    std::string metadata = m_metadata.str();
+
+    alignFile();
+    m_sections.push_back({METADATA_KEY, 1, metadata.size(), static_cast<uint64_t>(m_file.tellp())});
+    m_file.write(metadata.data(), metadata.size());
+
+    m_metadata.str(std::string());
+
+    // Write the header
+    std::vector<char> header(HEADER_SIZE, 0);
+    std::size_t headerOffset = 0;
+
+    std::memcpy(header.data() + headerOffset, SIGNATURE, sizeof(SIGNATURE));
+    headerOffset += sizeof(SIGNATURE);
+
+    std::memcpy(header.data() + headerOffset, &FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    headerOffset += sizeof(FORMAT_VERSION);
+
+    std::memcpy(header.data() + headerOffset, &BYTE_ORDER_MARK, sizeof(BYTE_ORDER_MARK));
+    headerOffset += sizeof(BYTE_ORDER_MARK);
+
+    int32_t version = m_version;
+    std::memcpy(header.data() + headerOffset, &version, sizeof(version));
+    headerOffset += sizeof(version);
+
+    uint32_t nSections = static_cast<uint32_t>(m_sections.size());
+    std::memcpy(header.data() + headerOffset, &nSections, sizeof(nSections));
+    headerOffset += sizeof(nSections);
+
+    std::memcpy(header.data() + headerOffset, m_sections.data(), nSections * sizeof(SectionInfo));
+
+    m_file.seekp(0);
+    m_file.write(header.data(), header.size());
+
+    // Close the file
+    bool good = m_file.good();
+    m_file.close();
+    good &= !m_file.fail();
+
+    std::string path = m_path;
+    resetArchive();
+    if (!good) {
+        throw std::runtime_error("Unable to write the mapped archive \"" + path + "\".");
+    }
+}
+
+/*!
+    Checks if the archive is open.
+
+    \result Returns true if the archive is open, false otherwise.
+*/
+bool OMappedArchive::isOpen() const
+{
+    return m_file.is_open();
+}
+
+/*!
+    Begins a new section.
+
+    Only one section at a time can be written. The contents of the section
+    are written using writeSectionData.
+
+    \param key is the key of the section
+    \param itemSize is the size, expressed in bytes, of the items of the
+    section
+*/
+void OMappedArchive::beginSection(uint32_t key, std::size_t itemSize)
+{
+    if (!isOpen()) {
+        throw std::runtime_error("The mapped archive is not open.");
+    } else if (m_sectionOpen) {
+        throw std::runtime_error("Another section of the mapped archive is being written.");
+    } else if (key == METADATA_KEY || hasSection(key)) {
+        throw std::runtime_error("The mapped archive already contains a section with the specified key.");
+    } else if (m_sections.size() >= MAX_SECTIONS - 1) {
+        throw std::runtime_error("The mapped archive cannot contain additional sections.");
+    }
+
+    alignFile();
+    m_sections.push_back({key, static_cast<uint32_t>(itemSize), 0, static_cast<uint64_t>(m_file.tellp())});
+    m_sectionOpen = true;
+}
+
+/*!
+    Appends the specified items to the section that is being written.
+
+    \param data is a pointer to the items
+    \param count is the number of items
+*/
+void OMappedArchive::writeSectionData(const void *data, std::size_t count)
+{
+    if (!m_sectionOpen) {
+        throw std::runtime_error("No section of the mapped archive is being written.");
+    }
+
+    SectionInfo &section = m_sections.back();
+    m_file.write(static_cast<const char *>(data), count * section.itemSize);
+    section.count += count;
+}
+
+/*!
+    Ends the section that is being written.
+*/
+void OMappedArchive::endSection()
+{
+    m_sectionOpen = false;
+}
+
+/*!
+    Get a reference to the output stream associated to the metadata of the
+    archive.
+
+    \result A reference to the output stream associated to the metadata of
+    the archive.
+*/
+std::ostream & OMappedArchive::getStream()
+{
+    return *this;
+}
+
+/*!
+    Pads the file so that its size is a multiple of the section alignment.
+*/
+void OMappedArchive::alignFile()
+{
+    std::size_t position = static_cast<std::size_t>(m_file.tellp());
+    std::size_t padding  = (SECTION_ALIGNMENT - position % SECTION_ALIGNMENT) % SECTION_ALIGNMENT;
+    if (padding == 0) {
+        return;
+    }
+
+    std::vector<char> paddingData(padding, 0);
+    m_file.write(paddingData.data(), paddingData.size());
+}
+
+/*!
+    \ingroup Binary
+    \class IMappedArchive
+    \brief Input memory-mappable binary archive.
+
+    The archive is mapped in memory when it is opened. Sections are accessed
+    directly through the mapping, without copying their contents, whereas
+    metadata is read through the standard stream interface of the archive.
+
+    Memory pages of the sections that are no longer needed can be released
+    using releaseSection, this allows to limit the memory used while the
+    contents of the archive are loaded into other data structures.
+*/
+
+/*!
+    Creates a new input archive.
+*/
+IMappedArchive::IMappedArchive()
+    : std::istream(nullptr),
+      m_mapping(nullptr), m_mappingSize(0)
+{
+    rdbuf(&m_metadata);
+}
+
+/*!
+    Creates a new input archive.
+
+    \param name is the name of the file
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+IMappedArchive::IMappedArchive(const std::string &name, int block)
+    : IMappedArchive()
+{
+    open(name, EXTENSION_DEFAULT, block);
+}
+
+/*!
+    Creates a new input archive.
+
+    \param name is the name of the file
+    \param extension is the extension of the file
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+IMappedArchive::IMappedArchive(const std::string &name, const std::string &extension, int block)
+    : IMappedArchive()
+{
+    open(name, extension, block);
+}
+
+/*!
+    Destructor.
+*/
+IMappedArchive::~IMappedArchive()
+{
+    close();
+}
+
+/*!
+    Opens the specified file and maps it in memory.
+
+    \param name is the name of the file
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+void IMappedArchive::open(const std::string &name, int block)
+{
+    open(name, EXTENSION_DEFAULT, block);
+}
+
+/*!
+    Opens the specified file and maps it in memory.
+
+    \param name is the name of the file
+    \param extension is the extension of the file
+    \param block is the parallel block the file belongs to, a negative value
+    mean that the file is serial
+*/
+void IMappedArchive::open(const std::string &name, const std::string &extension, int block)
+{
+    // Close the previous file
+    close();
+
+    // Map the file
+    std::string path = generatePath(name, extension, block);
+
+    int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throw std::runtime_error("Unable to open the mapped archive \"" + path + "\".");
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || static_cast<std::size_t>(fileStatus.st_size) < HEADER_SIZE) {
+        ::close(fileDescriptor);
+        throw std::runtime_error("The file \"" + path + "\" is not a valid mapped archive.");
+    }
+
+    std::size_t mappingSize = static_cast<std::size_t>(fileStatus.st_size);
+    void *mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Unable to map the archive \"" + path + "\" in memory.");
+    }
+
+    m_mapping     = mapping;
+    m_mappingSize = mappingSize;
+    m_path        = path;
+
+    // Sections are usually read sequentially
+    madvise(m_mapping, m_mappingSize, MADV_SEQUENTIAL);
+
+    // Read the header
+    const char *header = static_cast<const char *>(m_mapping);
+    std::size_t headerOffset = 0;
+
+    bool valid = (std::memcmp(header + headerOffset, SIGNATURE, sizeof(SIGNATURE)) == 0);
+    headerOffset += sizeof(SIGNATURE);
+
+    uint32_t formatVersion;
+    std::memcpy(&formatVersion, header + headerOffset, sizeof(formatVersion));
+    headerOffset += sizeof(formatVersion);
+    valid &= (formatVersion == FORMAT_VERSION);
+
+    uint32_t byteOrderMark;
+    std::memcpy(&byteOrderMark, header + headerOffset, sizeof(byteOrderMark));
+    headerOffset += sizeof(byteOrderMark);
+    valid &= (byteOrderMark == BYTE_ORDER_MARK);
+
+    int32_t version;
+    std::memcpy(&version, header + headerOffset, sizeof(version));
+    headerOffset += sizeof(version);
+
+    uint32_t nSections;
+    std::memcpy(&nSections, header + headerOffset, sizeof(nSections));
+    headerOffset += sizeof(nSections);
+    valid &= (nSections <= MAX_SECTIONS);
+
+    if (valid) {
+        m_sections.resize(nSections);
+        std::memcpy(m_sections.data(), header + headerOffset, nSections * sizeof(SectionInfo));
+        for (const SectionInfo &section : m_sections) {
+            if (section.offset + section.count * section.itemSize > m_mappingSize) {
+                valid = false;
+                break;
+            }
+        }
+    }
+
+    const SectionInfo *metadataSection = nullptr;
+    if (valid) {
+        metadataSection = findSection(METADATA_KEY);
+        valid = (metadataSection != nullptr);
+    }
+
+    if (!valid) {
+        close();
+        throw std::runtime_error("The file \"" + path + "\" is not a valid mapped archive or it was written on a machine with a different byte order.");
+    }
+
+    m_version = version;
+
+    // Initialize metadata stream
+    const char *metadataBegin = static_cast<const char *>(m_mapping) + metadataSection->offset;
+    const char *metadataEnd   = metadataBegin + metadataSection->count;
+    m_metadata.setData(metadataBegin, metadataEnd);
+    clear();
+}
+
+/*!
+    Closes the archive, unmapping it from memory.
+
+    Pointers to the contents of the sections are no longer valid after the
+    archive is closed.
+*/
+void IMappedArchive::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    munmap(m_mapping, m_mappingSize);
+    m_mapping     = nullptr;
+    m_mappingSize = 0;
+
+    m_metadata.setData(nullptr, nullptr);
+
+    resetArchive();
+}
+
+/*!
+    Checks if the archive is open.
+
+    \result Returns true if the archive is open, false otherwise.
+*/
+bool IMappedArchive::isOpen() const
+{
+    return (m_mapping != nullptr);
+}
+
+/*!
+    Checks if the version of the archive matches the specified version.
+
+    \param version is the requested version
+    \result Retuns true if the version of the archive matches the specified
+    version, otherwise it returns false.
+*/
+bool IMappedArchive::checkVersion(int version) const
+{
+    return (version == m_version);
+}
+
+/*!
+    Gets a pointer to the data stored in the specified section.
+
+    The pointer references the memory mapping of the archive, hence it
+    remains valid until the archive is closed.
+
+    \param key is the key of the section
+    \param itemSize is the expected size, expressed in bytes, of the items
+    of the section
+    \param[out] count on output will contain the number of items stored in
+    the section
+    \result A pointer to the data stored in the specified section.
+*/
+const void * IMappedArchive::getSectionData(uint32_t key, std::size_t itemSize, std::size_t *count) const
+{
+    const SectionInfo *section = findSection(key);
+    if (!section || key == METADATA_KEY) {
+        throw std::runtime_error("The mapped archive \"" + m_path + "\" doesn't contain the requested section.");
+    } else if (section->itemSize != itemSize) {
+        throw std::runtime_error("The items of the requested section of the mapped archive \"" + m_path + "\" have an unexpected size.");
+    }
+
+    *count = static_cast<std::size_t>(section->count);
+
+    return static_cast<const char *>(m_mapping) + section->offset;
+}
+
+/*!
+    Releases the memory pages associated with the specified section.
+
+    The contents of the section remain accessible, if they are accessed again
+    they will be read again from the file.
+
+    \param key is the key of the section
+*/
+void IMappedArchive::releaseSection(uint32_t key) const
+{
+    const SectionInfo *section = findSection(key);
+    if (!section || section->count == 0) {
+        return;
+    }
+
+    char *sectionData = static_cast<char *>(m_mapping) + section->offset;
+    madvise(sectionData, section->count * section->itemSize, MADV_DONTNEED);
+}
+
+/*!
+    Get a reference to the input stream associated to the metadata of the
+    archive.
+
+    \result A reference to the input stream associated to the metadata of
+    the archive.
+*/
+std::istream & IMappedArchive::getStream()
+{
+    return *this;
+}
+
+/*!
+    Sets the data the buffer will read from.
+
+    \param begin is a pointer to the beginning of the data
+    \param end is a pointer to the end of the data
+*/
+void IMappedArchive::MemoryBuffer::setData(const char *begin, const char *end)
+{
+    char *data = const_cast<char *>(begin);
+    setg(data, data, const_cast<char *>(end));
+}
+
+/*!
+    Sets the position of the buffer relative to some other position.
+
+    \param offset is the relative position to set the position indicator to
+    \param direction defines base position to apply the relative offset to
+    \param mode defines which of the input and/or output sequences to affect
+    \result The resulting absolute position.
+*/
+IMappedArchive::MemoryBuffer::pos_type IMappedArchive::MemoryBuffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode)
+{
+    if (!(mode & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+
+    off_type position;
+    if (direction == std::ios_base::beg) {
+        position = offset;
+    } else if (direction == std::ios_base::cur) {
+        position = (gptr() - eback()) + offset;
+    } else {
+        position = (egptr() - eback()) + offset;
+    }
+
+    if (position < 0 || position > (egptr() - eback())) {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + position, egptr());
+
+    return pos_type(position);
+}
+
+/*!
+    Sets the position of the buffer to an absolute position.
+
+    \param position is the absolute position to set the position indicator to
+    \param mode defines which of the input and/or output sequences to affect
+    \result The resulting absolute position.
+*/
+IMappedArchive::MemoryBuffer::pos_type IMappedArchive::MemoryBuffer::seekpos(pos_type position, std::ios_base::openmode mode)
+{
+    return seekoff(off_type(position), std::ios_base::beg, mode);
+}
+
+}
@@ -0,0 +1,176 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_MAPPED_ARCHIVE_HPP__
+#define __BITPIT_MAPPED_ARCHIVE_HPP__
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bitpit_common.hpp"
+
+namespace bitpit {
+
+class MappedArchive
+{
+
+public:
+    BITPIT_PUBLIC_API static const std::size_t HEADER_SIZE;
+    BITPIT_PUBLIC_API static const std::size_t SECTION_ALIGNMENT;
+    BITPIT_PUBLIC_API static const std::size_t MAX_SECTIONS;
+    BITPIT_PUBLIC_API static const int VERSION_UNDEFINED = - std::numeric_limits<int>::max();
+
+    BITPIT_PUBLIC_API static const std::string EXTENSION_DEFAULT;
+
+    static std::string generatePath(const std::string &name, int block = -1);
+    static std::string generatePath(const std::string &name, const std::string &extension, int block = -1);
+
+    MappedArchive();
+
+    int getVersion() const;
+    std::string getPath() const;
+
+    std::size_t getSectionCount() const;
+    bool hasSection(uint32_t key) const;
+    std::size_t getSectionSize(uint32_t key) const;
+
+protected:
+    /*!
+     * Information about a section of the archive.
+     */
+    struct SectionInfo {
+        uint32_t key;      //!< Key of the section
+        uint32_t itemSize; //!< Size, expressed in bytes, of the items of the section
+        uint64_t count;    //!< Number of items stored in the section
+        uint64_t offset;   //!< Offset, expressed in bytes, of the section inside the archive
+    };
+
+    static const char SIGNATURE[16];
+    static const uint32_t FORMAT_VERSION;
+    static const uint32_t BYTE_ORDER_MARK;
+    static const uint32_t METADATA_KEY;
+
+    int m_version;
+    std::string m_path;
+    std::vector<SectionInfo> m_sections;
+
+    const SectionInfo * findSection(uint32_t key) const;
+
+    void resetArchive();
+
+};
+
+class OMappedArchive : public MappedArchive, public std::ostream
+{
+
+public:
+    OMappedArchive();
+    OMappedArchive(const std::string &name, int version, int block = -1);
+    OMappedArchive(const std::string &name, const std::string &extension, int version, int block = -1);
+    ~OMappedArchive();
+
+    void open(const std::string &name, int version, int block = -1);
+    void open(const std::string &name, const std::string &extension, int version, int block = -1);
+    void close();
+
+    bool isOpen() const;
+
+    void beginSection(uint32_t key, std::size_t itemSize);
+    void writeSectionData(const void *data, std::size_t count);
+    template<typename T, typename InputIterator, typename UnaryFunction>
+    void writeSectionData(InputIterator first, InputIterator last, UnaryFunction function);
+    void endSection();
+
+    template<typename T>
+    void writeSection(uint32_t key, const T *data, std::size_t count);
+    template<typename T, typename InputIterator, typename UnaryFunction>
+    void writeSection(uint32_t key, InputIterator first, InputIterator last, UnaryFunction function);
+
+    std::ostream & getStream();
+
+private:
+    std::ofstream m_file;
+    std::stringbuf m_metadata;
+    bool m_sectionOpen;
+
+    void alignFile();
+
+};
+
+class IMappedArchive : public MappedArchive, public std::istream
+{
+
+public:
+    IMappedArchive();
+    IMappedArchive(const std::string &name, int block = -1);
+    IMappedArchive(const std::string &name, const std::string &extension, int block = -1);
+    ~IMappedArchive();
+
+    void open(const std::string &name, int block = -1);
+    void open(const std::string &name, const std::string &extension, int block = -1);
+    void close();
+
+    bool isOpen() const;
+
+    bool checkVersion(int version) const;
+
+    const void * getSectionData(uint32_t key, std::size_t itemSize, std::size_t *count) const;
+
+    template<typename T>
+    const T * getSection(uint32_t key, std::size_t *count) const;
+
+    void releaseSection(uint32_t key) const;
+
+    std::istream & getStream();
+
+private:
+    class MemoryBuffer : public std::streambuf
+    {
+
+    public:
+        void setData(const char *begin, const char *end);
+
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode = std::ios_base::in) override;
+        pos_type seekpos(pos_type position, std::ios_base::openmode mode = std::ios_base::in) override;
+
+    };
+
+    void *m_mapping;
+    std::size_t m_mappingSize;
+    MemoryBuffer m_metadata;
+
+};
+
+}
+
+// Include template implementations
+#include "mapped_archive.tpp"
+
+#endif
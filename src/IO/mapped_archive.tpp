@@ -0,0 +1,125 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_MAPPED_ARCHIVE_TPP__
+#define __BITPIT_MAPPED_ARCHIVE_TPP__
+
+#include <algorithm>
+#include <type_traits>
+
+namespace bitpit {
+
+/*!
+    Writes a section containing the specified items.
+
+    Items are written as raw bytes, hence they should be trivially copyable.
+
+    \param key is the key of the section
+    \param data is a pointer to the items
+    \param count is the number of items
+*/
+template<typename T>
+void OMappedArchive::writeSection(uint32_t key, const T *data, std::size_t count)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Sections can only contain trivially copyable items");
+
+    beginSection(key, sizeof(T));
+    writeSectionData(data, count);
+    endSection();
+}
+
+/*!
+    Appends to the section that is being written the items obtained applying
+    the given function to the elements in the specified range.
+
+    Items are evaluated in chunks, hence there is no need to store all the
+    items of the section in memory.
+
+    \param first is the beginning of the range
+    \param last is the end of the range
+    \param function is the function that will be applied to the elements of
+    the range, it should return the item that will be written
+*/
+template<typename T, typename InputIterator, typename UnaryFunction>
+void OMappedArchive::writeSectionData(InputIterator first, InputIterator last, UnaryFunction function)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Sections can only contain trivially copyable items");
+
+    const std::size_t CHUNK_SIZE = std::max(std::size_t(1), std::size_t(1024 * 1024) / sizeof(T));
+
+    std::vector<T> chunk;
+    chunk.reserve(CHUNK_SIZE);
+    for (InputIterator itr = first; itr != last; ++itr) {
+        chunk.push_back(function(*itr));
+        if (chunk.size() == CHUNK_SIZE) {
+            writeSectionData(chunk.data(), chunk.size());
+            chunk.clear();
+        }
+    }
+
+    if (!chunk.empty()) {
+        writeSectionData(chunk.data(), chunk.size());
+    }
+}
+
+/*!
+    Writes a section containing the items obtained applying the given
+    function to the elements in the specified range.
+
+    \param key is the key of the section
+    \param first is the beginning of the range
+    \param last is the end of the range
+    \param function is the function that will be applied to the elements of
+    the range, it should return the item that will be written
+*/
+template<typename T, typename InputIterator, typename UnaryFunction>
+void OMappedArchive::writeSection(uint32_t key, InputIterator first, InputIterator last, UnaryFunction function)
+{
+    beginSection(key, sizeof(T));
+    writeSectionData<T>(first, last, function);
+    endSection();
+}
+
+/*!
+    Gets a pointer to the items stored in the specified section.
+
+    The pointer references the memory mapping of the archive, hence it
+    remains valid until the archive is closed.
+
+    \param key is the key of the section
+    \param[out] count on output will contain the number of items stored in
+    the section
+    \result A pointer to the items stored in the specified section.
+*/
+template<typename T>
+const T * IMappedArchive::getSection(uint32_t key, std::size_t *count) const
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Sections can only contain trivially copyable items");
+
+    return static_cast<const T *>(getSectionData(key, sizeof(T), count));
+}
+
+}
+
+#endif
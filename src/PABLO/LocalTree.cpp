@@ -27,6 +27,7 @@
 // =================================================================================== //
 #include "LocalTree.hpp"
 #include "morton.hpp"
+#include "threadUtils.hpp"
 
 #include <map>
 #include <unordered_map>
@@ -101,6 +102,31 @@ namespace bitpit {
         return m_octants.size();
     };
 
+    /*! Evaluate the memory used by the local tree.
+     * The memory occupied by the tree object itself is not included.
+     * \return Memory, expressed in bytes, used by the local tree.
+     */
+    std::size_t
+    LocalTree::getMemoryUsage() const{
+        std::size_t memoryUsage = 0;
+        memoryUsage += utils::getMemoryUsage(m_octants);
+        memoryUsage += utils::getMemoryUsage(m_ghosts);
+        memoryUsage += utils::getMemoryUsage(m_intersections);
+        memoryUsage += utils::getMemoryUsage(m_globalIdxGhosts);
+        memoryUsage += utils::getMemoryUsage(m_lastGhostBros);
+        memoryUsage += utils::getMemoryUsage(m_firstGhostBros);
+        memoryUsage += utils::getMemoryUsage(m_nodes);
+        memoryUsage += utils::getMemoryUsage(m_periodic);
+        for (const u32vector2D *connectivity : {&m_connectivity, &m_ghostsConnectivity}) {
+            memoryUsage += utils::getMemoryUsage(*connectivity);
+            for (const u32vector &octantConnectivity : *connectivity) {
+                memoryUsage += utils::getMemoryUsage(octantConnectivity);
+            }
+        }
+
+        return memoryUsage;
+    };
+
     /*! Get max depth reached in local tree
      *  If the tree is empty a negative number is returned.
      * \return Max depth in local partition of the octree.
@@ -987,9 +1013,10 @@ namespace bitpit {
      * \param[in,out] isghost Vector with boolean flag; true if the respective octant in neighbours is a ghost octant. Can be ignored in serial runs
      * \param[in] onlyinternal A boolean flag to specify if neighbours have to be found among all the octants (false) or only among the internal ones (true).
      * \param[in] append A boolean flag to specify if neighbours will be appended to the given vector or if the given vectors will be cleared before adding the neighbours.
+     * \param[in,out] hint If a valid pointer is provided, the search for the neighbours will start from the positions stored in the hint and, on output, the hint will be updated with the positions where the search for this octant has started. Queries for octants that are close along the Morton curve will then need only a few steps.
      */
     void
-    LocalTree::findNeighbours(const Octant* oct, uint8_t iface, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append) const{
+    LocalTree::findNeighbours(const Octant* oct, uint8_t iface, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append, NeighSearchHint *hint) const{
 
         if (!append) {
             isghost.clear();
@@ -1053,7 +1080,7 @@ namespace bitpit {
         //
 
         // Identify the index of the first neighbour candidate
-        computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_octants, &candidateIdx, &candidateMorton);
+        computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_octants, (hint ? &(hint->octantIdx) : nullptr), &candidateIdx, &candidateMorton);
 
         // Early return if a neighbour of the same size has been found
         if(candidateMorton == sameSizeVirtualNeighMorton && m_octants[candidateIdx].m_level == level){
@@ -1157,7 +1184,7 @@ namespace bitpit {
         // Search in ghosts
         if(ghostSearch){
             // Identify the index of the first neighbour candidate
-            computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_ghosts, &candidateIdx, &candidateMorton);
+            computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_ghosts, (hint ? &(hint->ghostIdx) : nullptr), &candidateIdx, &candidateMorton);
 
             // Early return if a neighbour of the same size has been found
             if(candidateMorton == sameSizeVirtualNeighMorton && m_ghosts[candidateIdx].getLevel() == level){
@@ -1244,9 +1271,10 @@ namespace bitpit {
      * \param[in,out] isghost Vector with boolean flag; true if the respective octant in neighbours is a ghost octant. Can be ignored in serial runs
      * \param[in] onlyinternal A boolean flag to specify if neighbours have to be found among all the octants (false) or only among the internal ones (true).
      * \param[in] append A boolean flag to specify if neighbours will be appended to the given vector or if the given vectors will be cleared before adding the neighbours.
+     * \param[in,out] hint If a valid pointer is provided, the search for the neighbours will start from the positions stored in the hint and, on output, the hint will be updated with the positions where the search for this octant has started. Queries for octants that are close along the Morton curve will then need only a few steps.
      */
     void
-    LocalTree::findEdgeNeighbours(const Octant* oct, uint8_t iedge, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append) const{
+    LocalTree::findEdgeNeighbours(const Octant* oct, uint8_t iedge, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append, NeighSearchHint *hint) const{
 
         if (!append) {
             isghost.clear();
@@ -1310,7 +1338,7 @@ namespace bitpit {
         //
 
         // Identify the index of the first neighbour candidate
-        computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_octants, &candidateIdx, &candidateMorton);
+        computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_octants, (hint ? &(hint->octantIdx) : nullptr), &candidateIdx, &candidateMorton);
 
         // Early return if a neighbour of the same size has been found
         if(candidateMorton == sameSizeVirtualNeighMorton && m_octants[candidateIdx].m_level == level){
@@ -1404,7 +1432,7 @@ namespace bitpit {
         //
         if (getNumGhosts() > 0 && !onlyinternal){
             // Identify the index of the first neighbour candidate
-            computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_ghosts, &candidateIdx, &candidateMorton);
+            computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_ghosts, (hint ? &(hint->ghostIdx) : nullptr), &candidateIdx, &candidateMorton);
 
             // Early return if a neighbour of the same size has been found
             if(candidateMorton == sameSizeVirtualNeighMorton && m_ghosts[candidateIdx].m_level == level){
@@ -1493,9 +1521,10 @@ namespace bitpit {
      * \param[in,out] isghost Vector with boolean flag; true if the respective octant in neighbours is a ghost octant. Can be ignored in serial runs
     * \param[in] append A boolean flag to specify if neighbours will be appended to the given vector or if the given vectors will be cleared before adding the neighbours.*
      * \param[in] onlyinternal A boolean flag to specify if neighbours have to be found among all the octants (false) or only among the internal ones (true).
+     * \param[in,out] hint If a valid pointer is provided, the search for the neighbours will start from the positions stored in the hint and, on output, the hint will be updated with the positions where the search for this octant has started. Queries for octants that are close along the Morton curve will then need only a few steps.
      */
     void
-    LocalTree::findNodeNeighbours(const Octant* oct, uint8_t inode, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append) const{
+    LocalTree::findNodeNeighbours(const Octant* oct, uint8_t inode, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append, NeighSearchHint *hint) const{
 
         if (!append) {
             isghost.clear();
@@ -1556,7 +1585,7 @@ namespace bitpit {
         //
 
         // Identify the index of the first neighbour candidate
-        computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_octants, &candidateIdx, &candidateMorton);
+        computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_octants, (hint ? &(hint->octantIdx) : nullptr), &candidateIdx, &candidateMorton);
 
         // Early return if a neighbour of the same size has been found
         if(candidateMorton == sameSizeVirtualNeighMorton && m_octants[candidateIdx].m_level == oct->m_level){
@@ -1620,7 +1649,7 @@ namespace bitpit {
 
         if (getNumGhosts() > 0 && !onlyinternal){
             // Identify the index of the first neighbour candidate
-            computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_ghosts, &candidateIdx, &candidateMorton);
+            computeNeighSearchBegin(sameSizeVirtualNeighMorton, m_ghosts, (hint ? &(hint->ghostIdx) : nullptr), &candidateIdx, &candidateMorton);
 
             // Early return if a neighbour of the same size has been found
             if(candidateMorton == sameSizeVirtualNeighMorton && m_ghosts[candidateIdx].m_level == oct->m_level){
@@ -1680,13 +1709,16 @@ namespace bitpit {
      * \param[in] sameSizeVirtualNeighMorton Morton number of the same-size
     *  virtual neighbour
      * \param[in] octants list of octants
+     * \param[in,out] searchHintIdx if a valid pointer is provided, the search
+     * will start from the specified index, on output it will contain the index
+     * of the lower bound of the same-size virtual neighbour
      * \param[out] searchBeginIdx on output will contain the index from which a
      * neighbour search should begin
      * \param[out] searchBeginMorton on output will contain the Morton of the
      * octant from which a neighbour search should begin
      */
     void
-    LocalTree::computeNeighSearchBegin(uint64_t sameSizeVirtualNeighMorton, const octvector &octants, uint32_t *searchBeginIdx, uint64_t *searchBeginMorton) const {
+    LocalTree::computeNeighSearchBegin(uint64_t sameSizeVirtualNeighMorton, const octvector &octants, uint32_t *searchHintIdx, uint32_t *searchBeginIdx, uint64_t *searchBeginMorton) const {
 
         // Early return if there are no octants
         if (octants.empty()) {
@@ -1701,7 +1733,12 @@ namespace bitpit {
         // search should start form the octant preceding the lower bound.
         uint32_t lowerBoundIdx;
         uint64_t lowerBoundMorton;
-        findMortonLowerBound(sameSizeVirtualNeighMorton, octants, &lowerBoundIdx, &lowerBoundMorton);
+        if (searchHintIdx) {
+            findMortonLowerBound(sameSizeVirtualNeighMorton, octants, *searchHintIdx, &lowerBoundIdx, &lowerBoundMorton);
+            *searchHintIdx = lowerBoundIdx;
+        } else {
+            findMortonLowerBound(sameSizeVirtualNeighMorton, octants, &lowerBoundIdx, &lowerBoundMorton);
+        }
 
         if (lowerBoundMorton == sameSizeVirtualNeighMorton || lowerBoundIdx == 0) {
             *searchBeginIdx    = lowerBoundIdx;
@@ -1715,6 +1752,127 @@ namespace bitpit {
 
     // =================================================================================== //
 
+    /*! Compute the neighbours of all the octants through the entities of the
+     *  specified codimension.
+     *  The neighbours are stored in compressed row format: there is a row for
+     *  every entity of every internal octant, followed by a row for every
+     *  entity of every ghost octant. The neighbours of the entity iEntity of
+     *  the n-th octant (ghost octants are numbered after the internal ones)
+     *  are stored in the positions [offsets[r], offsets[r + 1]), where r is
+     *  equal to n * nEntities + iEntity. Neighbours are searched among both
+     *  internal and ghost octants.
+     *  Octants are split in chunks of consecutive octants that are processed
+     *  concurrently. Inside a chunk, octants are processed in Morton order and
+     *  the searches for the neighbours through an entity start from the
+     *  position where the search for the previous octant has started: since
+     *  consecutive octants are close to each other, their neighbours are
+     *  close to each other as well and they are found after a few steps.
+     * \param[in] codim Codimension of the entities (1=face, 2=edge and 3=vertex
+     * for 3D trees, 1=face, 2=vertex for 2D trees)
+     * \param[out] offsets on output will contain the offsets of the rows
+     * \param[out] neighbours on output will contain the indices of the
+     * neighbours in their structure (octants or ghosts)
+     * \param[out] ghostFlags on output will contain the flags that identify
+     * the neighbours that are ghosts
+     */
+    void
+    LocalTree::computeNeighbourTable(uint8_t codim, std::vector<std::size_t> *offsets, u32vector *neighbours, bvector *ghostFlags) const{
+
+        static const std::size_t MIN_CHUNK_SIZE = 1024;
+
+        // Identify the entities
+        uint8_t nEntities;
+        if (codim == 1){
+            nEntities = m_treeConstants->nFaces;
+        }
+        else if (codim == 2 && m_dim == 3){
+            nEntities = m_treeConstants->nEdges;
+        }
+        else if (codim == m_dim){
+            nEntities = m_treeConstants->nNodes;
+        }
+        else {
+            throw std::runtime_error("Requested codimension is not supported");
+        }
+
+        // Split the octants in chunks
+        uint32_t noctants = getNumOctants();
+        uint32_t nghosts  = getNumGhosts();
+
+        std::size_t nTotalOctants = static_cast<std::size_t>(noctants) + nghosts;
+        std::size_t nThreads      = static_cast<std::size_t>(utils::threads::getThreadCount());
+        std::size_t nChunks       = std::max(std::min(nThreads, nTotalOctants / MIN_CHUNK_SIZE), std::size_t(1));
+
+        std::vector<std::size_t> chunkBegins(nChunks + 1);
+        for (std::size_t chunk = 0; chunk <= nChunks; ++chunk) {
+            chunkBegins[chunk] = (nTotalOctants * chunk) / nChunks;
+        }
+
+        // Find the neighbours
+        //
+        // Every chunk stores its neighbours in a separate list, the offsets
+        // of the rows are evaluated relative to the beginning of the list.
+        offsets->resize(nTotalOctants * nEntities + 1);
+        (*offsets)[0] = 0;
+
+        std::vector<u32vector> chunkNeighbours(nChunks);
+        std::vector<bvector> chunkGhostFlags(nChunks);
+        utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+            u32vector &neighs = chunkNeighbours[chunk];
+            bvector &isghost  = chunkGhostFlags[chunk];
+
+            std::vector<NeighSearchHint> hints(nEntities);
+            for (std::size_t n = chunkBegins[chunk]; n < chunkBegins[chunk + 1]; ++n){
+                const Octant *octant;
+                if (n < noctants) {
+                    octant = &(m_octants[static_cast<uint32_t>(n)]);
+                } else {
+                    octant = &(m_ghosts[static_cast<uint32_t>(n - noctants)]);
+                }
+
+                for (uint8_t i = 0; i < nEntities; ++i){
+                    if (codim == 1){
+                        findNeighbours(octant, i, neighs, isghost, false, true, &(hints[i]));
+                    }
+                    else if (codim == 2 && m_dim == 3){
+                        findEdgeNeighbours(octant, i, neighs, isghost, false, true, &(hints[i]));
+                    }
+                    else {
+                        findNodeNeighbours(octant, i, neighs, isghost, false, true, &(hints[i]));
+                    }
+
+                    (*offsets)[n * nEntities + i + 1] = neighs.size();
+                }
+            }
+        });
+
+        // Evaluate the offsets of the rows
+        std::vector<std::size_t> chunkOffsets(nChunks + 1, 0);
+        for (std::size_t chunk = 0; chunk < nChunks; ++chunk) {
+            chunkOffsets[chunk + 1] = chunkOffsets[chunk] + chunkNeighbours[chunk].size();
+        }
+
+        utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+            std::size_t chunkOffset = chunkOffsets[chunk];
+            for (std::size_t r = chunkBegins[chunk] * nEntities; r < chunkBegins[chunk + 1] * nEntities; ++r){
+                (*offsets)[r + 1] += chunkOffset;
+            }
+        });
+
+        // Gather the neighbours
+        neighbours->clear();
+        neighbours->reserve(chunkOffsets[nChunks]);
+        ghostFlags->clear();
+        ghostFlags->reserve(chunkOffsets[nChunks]);
+        for (std::size_t chunk = 0; chunk < nChunks; ++chunk) {
+            neighbours->insert(neighbours->end(), chunkNeighbours[chunk].begin(), chunkNeighbours[chunk].end());
+            ghostFlags->insert(ghostFlags->end(), chunkGhostFlags[chunk].begin(), chunkGhostFlags[chunk].end());
+        }
+
+    }
+
+    // =================================================================================== //
+
     /*! Fix markers of broken families over processes.
      * \param[out] updatedOctants If a valid pointer is provided, the pointers of the updated
      * octants will be added to the specified list.
@@ -2802,6 +2960,100 @@ namespace bitpit {
 
     }
 
+    // =================================================================================== //
+    /*! Given a target Morton number and a sorted list of octants, finds the
+     *  index of the first octant whose Morton number does not compare less
+     *  than the target Morton number, starting the search from the specified
+     *  index.
+     *  The lower bound is bracketed moving away from the hint with steps of
+     *  exponentially increasing size and then it is located with a binary
+     *  search inside the bracket. The cost of the search is logarithmic in
+     *  the distance between the hint and the lower bound, rather than in the
+     *  number of octants.
+     * \param[in] targetMorton is the Morton index to be found.
+     * \param[in] octants list of octants
+     * \param[in] hintIdx is the index from which the search will start
+     * \param[out] lowerBoundIdx on output will contain the index of first
+     * octant whose Morton number does not compare less than the target Morton
+     * number. If the target Morton numer is greater than the Morton number of
+     * the last element, the index of the past-the-element element is returned
+     * \param[out] lowerBoundMorton on output will contain the Morton associated
+     * with the lower bound. If the target Morton is greater than the Morton
+     * number of the last element, the maximum finite value representable by
+     * the numeric type is returned
+     */
+    void
+    LocalTree::findMortonLowerBound(uint64_t targetMorton, const octvector &octants, uint32_t hintIdx, uint32_t *lowerBoundIdx, uint64_t *lowerBoundMorton) const {
+
+        uint32_t nOctants = octants.size();
+        if (nOctants == 0) {
+            *lowerBoundIdx    = 0;
+            *lowerBoundMorton = PABLO::INVALID_MORTON;
+            return;
+        }
+
+        hintIdx = std::min(hintIdx, nOctants - 1);
+
+        // Bracket the lower bound
+        //
+        // On output, the Morton number of the octant preceding the low index
+        // is less than the target and the Morton number of the octant at the
+        // high index does not compare less than the target.
+        uint32_t lowIndex;
+        uint32_t highIndex;
+        if (octants[hintIdx].getMorton() < targetMorton) {
+            lowIndex  = hintIdx + 1;
+            highIndex = nOctants;
+
+            uint64_t step = 1;
+            while (step < nOctants - hintIdx) {
+                uint32_t probeIndex = static_cast<uint32_t>(hintIdx + step);
+                if (octants[probeIndex].getMorton() >= targetMorton) {
+                    highIndex = probeIndex;
+                    break;
+                }
+
+                lowIndex = probeIndex + 1;
+                step *= 2;
+            }
+        } else {
+            lowIndex  = 0;
+            highIndex = hintIdx;
+
+            uint64_t step = 1;
+            while (step <= hintIdx) {
+                uint32_t probeIndex = static_cast<uint32_t>(hintIdx - step);
+                if (octants[probeIndex].getMorton() < targetMorton) {
+                    lowIndex = probeIndex + 1;
+                    break;
+                }
+
+                highIndex = probeIndex;
+                step *= 2;
+            }
+        }
+
+        // Locate the lower bound inside the bracket
+        while (lowIndex < highIndex) {
+            uint32_t midIndex = lowIndex + (highIndex - lowIndex) / 2;
+            if (octants[midIndex].getMorton() < targetMorton) {
+                lowIndex = midIndex + 1;
+            }
+            else {
+                highIndex = midIndex;
+            }
+        }
+
+        *lowerBoundIdx = lowIndex;
+        if (*lowerBoundIdx < nOctants) {
+            *lowerBoundMorton = octants[*lowerBoundIdx].getMorton();
+        }
+        else {
+            *lowerBoundMorton = PABLO::INVALID_MORTON;
+        }
+
+    }
+
     // =================================================================================== //
     /*! Given a target Morton number and a sorted list of octants, finds the
      *  index of the first octant whose Morton number is greater than the
@@ -2865,12 +3117,34 @@ namespace bitpit {
 
 
 
+        // Decode the coordinates of the octants
+        //
+        // Coordinates are decoded in a single pass, this allows to use the
+        // batched decoding kernels instead of decoding the Morton number of
+        // each octant once for every node.
+        uint64_t nTotalOctants = noctants + nghosts;
+
+        vector<uint64_t> mortons(nTotalOctants);
+        for (uint64_t n = 0; n < nTotalOctants; n++){
+            if (n < noctants) {
+                mortons[n] = m_octants[static_cast<uint32_t>(n)].getMorton();
+            } else {
+                mortons[n] = m_ghosts[static_cast<uint32_t>(n - noctants)].getMorton();
+            }
+        }
+
+        vector<uint32_t> octantCoords(3 * nTotalOctants);
+        uint32_t *octantCoordsX = octantCoords.data();
+        uint32_t *octantCoordsY = octantCoordsX + nTotalOctants;
+        uint32_t *octantCoordsZ = octantCoordsY + nTotalOctants;
+        PABLO::computeCoordinates(m_dim, nTotalOctants, mortons.data(), octantCoordsX, octantCoordsY, octantCoordsZ);
+
         // Gather node information
         nodeKeys.reserve(noctants);
         nodeCoords.reserve(noctants);
         nodeOctants.reserve(noctants);
 
-        for (uint64_t n = 0; n < (noctants + nghosts); n++){
+        for (uint64_t n = 0; n < nTotalOctants; n++){
             const Octant *octant;
             if (n < noctants) {
                 uint32_t octantId = static_cast<uint32_t>(n);
@@ -2880,9 +3154,12 @@ namespace bitpit {
                 octant = &(m_ghosts[octantId]);
             }
 
+            uint32_t octantSize = octant->getLogicalSize();
             for (uint8_t i = 0; i < m_treeConstants->nNodes; ++i){
                 u32array3 node;
-                octant->getLogicalNode(node, i);
+                node[0] = octantCoordsX[n] + m_treeConstants->nodeCoordinates[i][0] * octantSize;
+                node[1] = octantCoordsY[n] + m_treeConstants->nodeCoordinates[i][1] * octantSize;
+                node[2] = octantCoordsZ[n] + m_treeConstants->nodeCoordinates[i][2] * octantSize;
 
                 uint64_t nodeKey = octant->computeNodePersistentKey(node);
                 if (nodeCoords.count(nodeKey) == 0) {
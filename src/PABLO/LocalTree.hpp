@@ -114,6 +114,13 @@ public:
 	// =================================================================================== //
 
 private:
+	/*!Positions from which the searches of the neighbours of an octant start.
+	 */
+	struct NeighSearchHint {
+		uint32_t octantIdx = 0;		/**< Index in the internal octants */
+		uint32_t ghostIdx  = 0;		/**< Index in the ghost octants */
+	};
+
 	octvector				m_octants;				/**< Local vector of octants ordered with Morton Number */
 	octvector				m_ghosts;				/**< Local vector of ghost octants ordered with Morton Number */
 	intervector				m_intersections;		/**< Local vector of intersections */
@@ -176,6 +183,7 @@ private:
 	uint64_t		getLastDescMorton() const;
 	uint32_t 		getNumGhosts() const;
 	uint32_t 		getNumOctants() const;
+	std::size_t		getMemoryUsage() const;
 	int8_t 			getLocalMaxDepth() const;
 	int8_t 			getMarker(int32_t idx) const;
 	uint8_t 		getLevel(int32_t idx) const;
@@ -221,11 +229,13 @@ private:
 	void 		checkCoarse(uint64_t partLastDesc, u32vector & mapidx);
 	void 		updateLocalMaxDepth();
 
-    void        findNeighbours(const Octant* oct, uint8_t iface, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append) const;
-    void        findEdgeNeighbours(const Octant* oct, uint8_t iedge, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append) const;
-    void        findNodeNeighbours(const Octant* oct, uint8_t inode, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append) const;
+    void        findNeighbours(const Octant* oct, uint8_t iface, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append, NeighSearchHint *hint = nullptr) const;
+    void        findEdgeNeighbours(const Octant* oct, uint8_t iedge, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append, NeighSearchHint *hint = nullptr) const;
+    void        findNodeNeighbours(const Octant* oct, uint8_t inode, u32vector & neighbours, bvector & isghost, bool onlyinternal, bool append, NeighSearchHint *hint = nullptr) const;
+
+	void 		computeNeighSearchBegin(uint64_t sameSizeVirtualNeighMorton, const octvector &octants, uint32_t *searchHintIdx, uint32_t *searchBeginIdx, uint64_t *searchBeginMorton) const;
 
-	void 		computeNeighSearchBegin(uint64_t sameSizeVirtualNeighMorton, const octvector &octants, uint32_t *searchBeginIdx, uint64_t *searchBeginMorton) const;
+	void 		computeNeighbourTable(uint8_t codim, std::vector<std::size_t> *offsets, u32vector *neighbours, bvector *ghostFlags) const;
 
 	bool 		localBalance(bool doNew, bool checkInterior, bool checkGhost);
 
@@ -237,6 +247,7 @@ private:
 	uint32_t 	findGhostMorton(uint64_t targetMorton) const;
 	uint32_t 	findMorton(uint64_t targetMorton, const octvector &octants) const;
 	void 		findMortonLowerBound(uint64_t targetMorton, const octvector &octants, uint32_t *lowerBoundIdx, uint64_t *lowerBoundMorton) const;
+	void 		findMortonLowerBound(uint64_t targetMorton, const octvector &octants, uint32_t hintIdx, uint32_t *lowerBoundIdx, uint64_t *lowerBoundMorton) const;
 	void 		findMortonUpperBound(uint64_t targetMorton, const octvector &octants, uint32_t *upperBoundIdx, uint64_t *upperBoundMorton) const;
 
 	void 		computeConnectivity();
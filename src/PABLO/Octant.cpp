@@ -57,7 +57,9 @@ IBinaryStream& operator>>(IBinaryStream &buffer, Octant &octant)
 
     buffer >> octant.m_marker;
 
-    buffer >> octant.m_ghost;
+    int ghost;
+    buffer >> ghost;
+    octant.m_ghost = static_cast<int8_t>(ghost);
 
     for(int i = 0; i < Octant::INFO_ITEM_COUNT; ++i){
         bool value;
@@ -85,7 +87,7 @@ OBinaryStream& operator<<(OBinaryStream  &buffer, const Octant &octant)
 
     buffer << octant.m_marker;
 
-    buffer << octant.m_ghost;
+    buffer << static_cast<int>(octant.m_ghost);
 
     for(int i = 0; i < Octant::INFO_ITEM_COUNT; ++i){
         buffer << (bool) octant.m_info[i];
@@ -417,7 +419,7 @@ Octant::setPbound(uint8_t face, bool flag){
  */
 void
 Octant::setGhostLayer(int ghostLayer){
-    m_ghost = ghostLayer;
+    m_ghost = static_cast<int8_t>(ghostLayer);
 };
 
 
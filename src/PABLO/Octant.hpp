@@ -129,16 +129,100 @@ class Octant{
         INFO_ITEM_COUNT     = 15  /**< Number of items contained in the enum */
     };
 
+    /*!
+     * \brief Compact storage for the octant information bits.
+     *
+     * Behaves like a std::bitset<INFO_ITEM_COUNT> for the operations used by
+     * the tree, but stores the bits in a 16-bit integer instead of a machine
+     * word. This allows the octant to fit in 16 bytes.
+     */
+    class InfoBits {
+
+    public:
+        /*!
+         * \brief Reference to a single bit of the information.
+         */
+        class reference {
+
+        public:
+            reference(uint16_t *bits, std::size_t pos)
+                : m_bits(bits), m_mask(static_cast<uint16_t>(1u << pos))
+            {
+            }
+
+            reference & operator=(bool value)
+            {
+                if (value) {
+                    *m_bits = static_cast<uint16_t>(*m_bits | m_mask);
+                } else {
+                    *m_bits = static_cast<uint16_t>(*m_bits & ~m_mask);
+                }
+
+                return *this;
+            }
+
+            reference & operator=(const reference &other)
+            {
+                return (*this = static_cast<bool>(other));
+            }
+
+            operator bool() const
+            {
+                return ((*m_bits & m_mask) != 0);
+            }
+
+        private:
+            uint16_t *m_bits;
+            uint16_t m_mask;
+
+        };
+
+        InfoBits() : m_bits(0)
+        {
+        }
+
+        bool operator[](std::size_t pos) const
+        {
+            return test(pos);
+        }
+
+        reference operator[](std::size_t pos)
+        {
+            return reference(&m_bits, pos);
+        }
+
+        bool test(std::size_t pos) const
+        {
+            return (((m_bits >> pos) & 1u) != 0);
+        }
+
+        void set(std::size_t pos, bool value = true)
+        {
+            (*this)[pos] = value;
+        }
+
+        void reset()
+        {
+            m_bits = 0;
+        }
+
+    private:
+        static_assert(INFO_ITEM_COUNT <= 16, "Octant information bits do not fit in the storage");
+
+        uint16_t m_bits;
+
+    };
+
 private:
     uint64_t                        m_morton;       /**< Morton number */
-    uint8_t                         m_level;        /**< Refinement level (0=root) */
-    int8_t                          m_marker;       /**< Set for Refinement(m>0) or Coarsening(m<0) |m|-times */
-    std::bitset<INFO_ITEM_COUNT>    m_info;         /**< -Info[0..5]: true if 0..5 face is a boundary face [bound] \n
+    InfoBits                        m_info;         /**< -Info[0..5]: true if 0..5 face is a boundary face [bound] \n
                                                          -Info[6..11]: true if 0..6 face is a process boundary face [pbound] \n
                                                          -Info[12/13]: true if octant is new after refinement/coarsening \n
                                                          -Info[14]   : true if balancing is required for this octant \n */
+    uint8_t                         m_level;        /**< Refinement level (0=root) */
+    int8_t                          m_marker;       /**< Set for Refinement(m>0) or Coarsening(m<0) |m|-times */
     uint8_t                         m_dim;          /**< Dimension of octant (2D/3D) */
-    int                             m_ghost;        /**< Ghost specifier:\n
+    int8_t                          m_ghost;        /**< Ghost specifier:\n
                                                          -1 : internal, \n
                                                           0 : ghost in the 0-th layer of the halo, \n
                                                           1 : ghost in the 1-st layer of the halo, \n
@@ -30,7 +30,10 @@
 #include "morton.hpp"
 #include "ParaTree.hpp"
 
+#include <algorithm>
 #include <climits>
+#include <limits>
+#include <numeric>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
@@ -116,6 +119,87 @@ namespace bitpit {
         recvRanges.clear();
     }
 
+    /*!
+        \struct ParaTree::NeighbourTable
+        \ingroup PABLO
+
+        Stores the neighbours of all the octants through the entities (faces,
+        edges or nodes) of a given codimension.
+
+        Neighbours are stored in compressed row format. There is a row for
+        every entity of every internal octant, followed by a row for every
+        entity of every ghost octant. The neighbours of a row are stored in
+        the positions [offsets[r], offsets[r + 1]) of the list of neighbours
+        and of the list of ghost flags.
+    */
+
+    /*! Default constructor
+    */
+    ParaTree::NeighbourTable::NeighbourTable()
+        : codimension(0), nEntities(0), nOctants(0), nGhosts(0)
+    {
+        offsets.push_back(0);
+    }
+
+    /*! Get the row associated with the specified entity of an octant.
+     * \param idx is the index of the octant
+     * \param entityIdx is the index of the entity
+     * \param isghost controls if the octant is a ghost octant
+     * \result The row associated with the specified entity of the octant.
+     */
+    std::size_t ParaTree::NeighbourTable::getRow(uint32_t idx, uint8_t entityIdx, bool isghost) const
+    {
+        std::size_t octantRow = idx;
+        if (isghost) {
+            octantRow += nOctants;
+        }
+
+        return octantRow * nEntities + entityIdx;
+    }
+
+    /*! Get the number of neighbours of an octant through the specified entity.
+     * \param idx is the index of the octant
+     * \param entityIdx is the index of the entity
+     * \param isghost controls if the octant is a ghost octant
+     * \result The number of neighbours of the octant through the specified
+     * entity.
+     */
+    std::size_t ParaTree::NeighbourTable::getNeighbourCount(uint32_t idx, uint8_t entityIdx, bool isghost) const
+    {
+        std::size_t row = getRow(idx, entityIdx, isghost);
+
+        return (offsets[row + 1] - offsets[row]);
+    }
+
+    /*! Get the neighbours of an octant through the specified entity.
+     * The ghost flags of the neighbours are stored in the list of ghost flags
+     * starting from the position offsets[getRow(idx, entityIdx, isghost)].
+     * \param idx is the index of the octant
+     * \param entityIdx is the index of the entity
+     * \param isghost controls if the octant is a ghost octant
+     * \result A pointer to the indices of the neighbours in their container.
+     */
+    const uint32_t * ParaTree::NeighbourTable::getNeighbours(uint32_t idx, uint8_t entityIdx, bool isghost) const
+    {
+        std::size_t row = getRow(idx, entityIdx, isghost);
+
+        return (neighbours.data() + offsets[row]);
+    }
+
+    /*! Clear the table
+     */
+    void ParaTree::NeighbourTable::clear()
+    {
+        codimension = 0;
+        nEntities   = 0;
+        nOctants    = 0;
+        nGhosts     = 0;
+
+        offsets.assign(1, 0);
+        neighbours.clear();
+        ghostFlags.clear();
+    }
+
     // =================================================================================== //
     // CLASS IMPLEMENTATION                                                                //
     // =================================================================================== //
@@ -2135,6 +2219,33 @@ namespace bitpit {
         return m_octree.m_nodes.size();
     }
 
+    /** Evaluate the memory used by the octree.
+     * The memory includes the local tree, the partitioning information and
+     * the mapping data of the last adaption. The memory occupied by the
+     * octree object itself is not included.
+     * \return Memory, expressed in bytes, used by the octree.
+     */
+    std::size_t
+    ParaTree::getMemoryUsage() const{
+        std::size_t memoryUsage = m_octree.getMemoryUsage();
+        memoryUsage += utils::getMemoryUsage(m_partitionFirstDesc);
+        memoryUsage += utils::getMemoryUsage(m_partitionLastDesc);
+        memoryUsage += utils::getMemoryUsage(m_partitionRangeGlobalIdx);
+        memoryUsage += utils::getMemoryUsage(m_partitionRangeGlobalIdx0);
+        memoryUsage += utils::getMemoryUsage(m_bordersPerProc);
+        for (const auto &entry : m_bordersPerProc) {
+            memoryUsage += utils::getMemoryUsage(entry.second);
+        }
+        memoryUsage += utils::getMemoryUsage(m_internals);
+        memoryUsage += utils::getMemoryUsage(m_pborders);
+        memoryUsage += utils::getMemoryUsage(m_mapIdx);
+        memoryUsage += utils::getMemoryUsage(m_loadBalanceRanges.sendRanges);
+        memoryUsage += utils::getMemoryUsage(m_loadBalanceRanges.recvRanges);
+        memoryUsage += utils::getMemoryUsage(m_periodic);
+
+        return memoryUsage;
+    }
+
     /*! Get the local depth of the octree.
      * \return Local depth of the octree.
      */
@@ -2544,7 +2655,10 @@ namespace bitpit {
             throw std::runtime_error ("It is not possible to disable the ghost halo!");
         }
 
-        typedef std::invoke_result_t<decltype(&Octant::getGhostLayer), Octant> layer_t;
+        // The ghost layer is stored in the octant using a narrower type than
+        // the one returned by Octant::getGhostLayer, the limit is set by the
+        // storage type.
+        typedef decltype(Octant::m_ghost) layer_t;
         typedef std::make_unsigned<layer_t>::type ulayer_t;
         ulayer_t maxNofGhostLayers = std::numeric_limits<layer_t>::max() + (ulayer_t) 1;
         if (nofGhostLayers > maxNofGhostLayers) {
@@ -2763,6 +2877,38 @@ namespace bitpit {
 
     };
 
+    /** Computes the neighbours (both local and ghost ones) of all the octants
+     * (both local and ghost ones) through the entities (face/edge/node) of the
+     * specified codimension.
+     * The table is built with a single sweep over the octants in Morton order,
+     * which is faster than calling findNeighbours for every entity of every
+     * octant. Octants are processed concurrently by the threads enabled for
+     * the process. Neighbours are the same that would be found by
+     * findNeighbours for internal octants and by findGhostNeighbours for
+     * ghost octants.
+     * \param[in] entityCodim Codimension of the entities (1=face, 2=edge and 3=vertex for 3D trees, 1=face, 2=vertex for 2D trees)
+     * \param[out] table On output will contain the neighbours of the octants
+     */
+    void
+    ParaTree::computeNeighbourTable(uint8_t entityCodim, NeighbourTable *table) const {
+
+        m_octree.computeNeighbourTable(entityCodim, &(table->offsets), &(table->neighbours), &(table->ghostFlags));
+
+        table->codimension = entityCodim;
+        table->nOctants    = getNumOctants();
+        table->nGhosts     = getNumGhosts();
+        if (entityCodim == 1){
+            table->nEntities = m_treeConstants->nFaces;
+        }
+        else if (entityCodim == 2 && m_dim == 3){
+            table->nEntities = m_treeConstants->nEdges;
+        }
+        else {
+            table->nEntities = m_treeConstants->nNodes;
+        }
+
+    };
+
     /** Finds all the neighbours of a node
     * \param[in] oct Pointer to current octant
     * \param[in] node Index of node passed through for neighbours finding
@@ -4076,6 +4222,52 @@ namespace bitpit {
 
     };
 
+    /** Distribute Load-Balancing the octants (with user defined weights) of the whole tree over
+     * the processes of the job, moving only the octants at the boundaries between neighbouring
+     * processes. The partition is updated only if the imbalance exceeds the tolerance (see
+     * computeDiffusivePartition).
+     * \param[in] tolerance Tolerated imbalance, relative to the average weight of the processes.
+     * \param[in] weight Pointer to a vector of weights of the local octants (weight=NULL is uniform distribution).
+     */
+    void
+    ParaTree::loadBalanceDiffusive(double tolerance, const dvector* weight){
+
+        //Write info on log
+        (*m_log) << "---------------------------------------------" << endl;
+        (*m_log) << " LOAD BALANCE (DIFFUSIVE) " << endl;
+
+        m_lastOp = OP_LOADBALANCE;
+        if (m_nproc>1){
+
+            std::vector<uint32_t> partition(m_nproc);
+            computeDiffusivePartition(tolerance, weight, partition.data());
+
+            (*m_log) << " " << endl;
+            (*m_log) << " Octants to migrate	:	" + to_string(static_cast<unsigned long long>(evalPartitionMigration(partition.data()))) << endl;
+
+            privateLoadBalance<DummyDataLBImpl>(partition.data(), nullptr);
+
+            //Write info of final partition on log
+            (*m_log) << " " << endl;
+            (*m_log) << " Final Parallel partition : " << endl;
+            (*m_log) << " Octants for proc	"+ to_string(static_cast<unsigned long long>(0))+"	:	" + to_string(static_cast<unsigned long long>(m_partitionRangeGlobalIdx[0]+1)) << endl;
+            for(int ii=1; ii<m_nproc; ii++){
+                (*m_log) << " Octants for proc	"+ to_string(static_cast<unsigned long long>(ii))+"	:	" + to_string(static_cast<unsigned long long>(m_partitionRangeGlobalIdx[ii]-m_partitionRangeGlobalIdx[ii-1])) << endl;
+            }
+            (*m_log) << " " << endl;
+            (*m_log) << "---------------------------------------------" << endl;
+
+        }
+        else{
+            (*m_log) << " " << endl;
+            (*m_log) << " Serial partition : " << endl;
+            (*m_log) << " Octants for proc	"+ to_string(static_cast<unsigned long long>(0))+"	:	" + to_string(static_cast<unsigned long long>(m_partitionRangeGlobalIdx[0]+1)) << endl;
+            (*m_log) << " " << endl;
+            (*m_log) << "---------------------------------------------" << endl;
+        }
+
+    }
+
     /**
      * Evaluate the elements of the current partition that will be exchanged
      * with other processes during the load balance.
@@ -4143,6 +4335,67 @@ namespace bitpit {
         return evalLoadBalanceRanges(updatedPartition.data());
     }
 
+    /**
+     * Evaluate the elements of the current partition that will be exchanged
+     * with other processes during a diffusive load balance.
+     *
+     * \param[in] tolerance is the tolerated imbalance, relative to the
+     * average weight of the processes
+     * \param[in] weights are the weights of the local octants (if a null
+     * pointer is given a uniform distribution is used)
+     * \return The ranges of local ids that will be exchanged with other
+     * processes.
+     */
+    ParaTree::LoadBalanceRanges
+    ParaTree::evalDiffusiveLoadBalanceRanges(double tolerance, const dvector *weights){
+
+        // If there is only one process no octants can be exchanged
+        if (m_nproc == 1) {
+            LoadBalanceRanges loadBalanceInfo;
+            loadBalanceInfo.sendAction = LoadBalanceRanges::ACTION_NONE;
+            loadBalanceInfo.recvAction = LoadBalanceRanges::ACTION_NONE;
+
+            return loadBalanceInfo;
+        }
+
+        // Compute updated partition
+        std::vector<uint32_t> updatedPartition(m_nproc);
+        computeDiffusivePartition(tolerance, weights, updatedPartition.data());
+
+        // Evaluate send ranges
+        return evalLoadBalanceRanges(updatedPartition.data());
+    }
+
+    /**
+     * Evaluate the global number of octants that will be migrated to another
+     * process during a diffusive load balance.
+     *
+     * The partition is not modified, this allows to estimate the cost of the
+     * load balance before actually performing it.
+     *
+     * \param[in] tolerance is the tolerated imbalance, relative to the
+     * average weight of the processes
+     * \param[in] weights are the weights of the local octants (if a null
+     * pointer is given a uniform distribution is used)
+     * \return The global number of octants that will be migrated to another
+     * process.
+     */
+    uint64_t
+    ParaTree::evalDiffusiveLoadBalanceMigration(double tolerance, const dvector *weights){
+
+        // If there is only one process no octants can be exchanged
+        if (m_nproc == 1) {
+            return 0;
+        }
+
+        // Compute updated partition
+        std::vector<uint32_t> updatedPartition(m_nproc);
+        computeDiffusivePartition(tolerance, weights, updatedPartition.data());
+
+        // Evaluate the number of migrated octants
+        return evalPartitionMigration(updatedPartition.data());
+    }
+
     /**
      * Evaluate the elements of the current partition that will be exchanged
      * with other processes during the load balance.
@@ -4169,6 +4422,39 @@ namespace bitpit {
         return LoadBalanceRanges(m_serial, std::move(sendRanges), std::move(recvRanges));
     }
 
+    /**
+     * Evaluate the global number of octants that will be assigned to a
+     * different process when the tree will be distributed according to
+     * the specified partition.
+     *
+     * \param[in] updatedPartition is the pointer to the updated pattition
+     * \return The global number of octants that will be assigned to a
+     * different process.
+     */
+    uint64_t
+    ParaTree::evalPartitionMigration(const uint32_t *updatedPartition) const {
+
+        uint64_t nMigratedOctants = m_globalNumOctants;
+
+        uint64_t currentBegin = 0;
+        uint64_t updatedBegin = 0;
+        for (int p = 0; p < m_nproc; ++p) {
+            uint64_t currentEnd = m_partitionRangeGlobalIdx[p] + 1;
+            uint64_t updatedEnd = updatedBegin + updatedPartition[p];
+
+            uint64_t overlapBegin = std::max(currentBegin, updatedBegin);
+            uint64_t overlapEnd   = std::min(currentEnd, updatedEnd);
+            if (overlapEnd > overlapBegin) {
+                nMigratedOctants -= overlapEnd - overlapBegin;
+            }
+
+            currentBegin = currentEnd;
+            updatedBegin = updatedEnd;
+        }
+
+        return nMigratedOctants;
+    }
+
     /**
      * Evaluate the elements of the current partition that will be sent to
      * other processes after the load balance.
@@ -4557,80 +4843,97 @@ namespace bitpit {
 
     /*! Compute the partition of the octree over the processes (only compute the information about
      * how distribute the mesh). This is an weighted distribution method: each process will have the same weight.
+     *
+     * The partition is evaluated without gathering the weights of all the octants: each process
+     * evaluates the sum of the weights of its octants and, through an exclusive scan, the weight
+     * of the octants that precede its partition. The boundary between the i-th and the (i+1)-th
+     * process is placed right after the first octant whose cumulative weight is greater than or
+     * equal to (i+1)/nproc of the global weight. Each process looks for the boundaries that fall
+     * inside its partition and the boundaries are then exchanged among the processes. Memory and
+     * time are proportional to the number of local octants plus the number of processes.
+     *
+     * Weights should be non-negative. If the global weight is zero, the octants are distributed
+     * uniformly.
+     *
      * \param[out] partition Pointer to partition information array. partition[i] = number of octants
      * to be stored on the i-th process (i-th rank).
-     * \param[in] weights Pointer to weight array. weight[i] = weight of i-th local octant.
+     * \param[in] weight Pointer to weight array. weight[i] = weight of i-th local octant.
      */
     void
     ParaTree::computePartition(const dvector *weight, uint32_t *partition){
 
-        assert(weight->size() >= m_octree.getNumOctants());
+        uint32_t nOctants = m_octree.getNumOctants();
+        assert(weight->size() >= nOctants);
 
-        // Evaluate global weights
+        // Evaluate the weight of the octants
         //
         // If the tree is serial, all process have all the octants, hence
         // global weights and local weights are the same.
-        std::vector<double> globalWeightsStorage;
+        double localWeight = 0.;
+        for (uint32_t n = 0; n < nOctants; ++n) {
+            localWeight += (*weight)[n];
+        }
 
-        const double *globalWeights;
-        if (m_serial) {
-            globalWeights = weight->data();
-        } else {
-            // Information about current partitioning and displacements should
-            // be stored using uint32_t, however the maximum number of items
-            // that can be exchanged using MPI funcitons is limited to INT_MAX.
-            assert(m_globalNumOctants <= INT_MAX);
-            std::vector<int> currentPartition(m_nproc);
-            int nOctants = m_octree.getNumOctants();
-            MPI_Allgather(&nOctants, 1, MPI_INT, currentPartition.data(), 1, MPI_INT, m_comm);
-
-            std::vector<int> displacements(m_nproc);
-            displacements[0] = 0;
-            for(int i = 1; i < m_nproc; ++i){
-                displacements[i] = displacements[i - 1] + currentPartition[i - 1];
-            }
+        double offsetWeight = 0.;
+        double globalWeight = localWeight;
+        uint64_t globalOffset = 0;
+        if (!m_serial) {
+            MPI_Exscan(&localWeight, &offsetWeight, 1, MPI_DOUBLE, MPI_SUM, m_comm);
+            MPI_Allreduce(&localWeight, &globalWeight, 1, MPI_DOUBLE, MPI_SUM, m_comm);
 
-            globalWeightsStorage.resize(m_globalNumOctants);
-            globalWeights = globalWeightsStorage.data();
-            MPI_Allgatherv(weight->data(), nOctants, MPI_DOUBLE, globalWeightsStorage.data(),
-                           currentPartition.data(), displacements.data(), MPI_DOUBLE, m_comm);
+            // The result of the exclusive scan is undefined on the first process
+            if (m_rank == 0) {
+                offsetWeight = 0.;
+            } else {
+                globalOffset = m_partitionRangeGlobalIdx[m_rank - 1] + 1;
+            }
         }
 
-        // Initialize partitioning
-        for (int i = 0; i < m_nproc; ++i) {
-            partition[i] = 0;
+        if (globalWeight <= 0.) {
+            computePartition(partition);
+            return;
         }
 
-        // Assign octants to partitions
+        // Find the boundaries that fall inside the local octants
         //
-        // After evaluationg the target weight of a partition, octants will
-        // be added to that partition until the weigth of the partition is
-        // greater or equal the target weigth or until all the octant are
-        // assigned
-        uint32_t nAssigendOctants = 0;
-        for (int i = 0; i < m_nproc - 1; ++i) {
-            double unassignedWeight = 0.;
-            for (uint32_t n=nAssigendOctants; n<m_globalNumOctants; n++){
-                unassignedWeight += globalWeights[n];
+        // The boundary between the i-th and the (i+1)-th process is stored
+        // as the global index of the first octant of the (i+1)-th process.
+        // Boundaries that don't fall inside the local octants are set to the
+        // global number of octants, this way the actual boundaries can be
+        // evaluated with a minimum reduction.
+        int nBoundaries = m_nproc - 1;
+        std::vector<uint64_t> boundaries(nBoundaries, m_globalNumOctants);
+
+        // Boundaries whose target weight is reached by the previous processes
+        // are assigned to the first local octant, the reduction will discard
+        // them (this avoids missing a boundary because of round-off errors).
+        int boundary = 0;
+        double cumulativeWeight = offsetWeight;
+        for (uint32_t n = 0; n < nOctants; ++n) {
+            if (boundary == nBoundaries) {
+                break;
             }
-            double targetWeight = unassignedWeight / (m_nproc - i);
-
-            double partitionWeight = 0.;
-            while(partitionWeight < targetWeight){
-                partitionWeight += globalWeights[nAssigendOctants];
-                partition[i]++;
 
-                nAssigendOctants++;
-                if (nAssigendOctants == m_globalNumOctants) {
-                    break;
-                }
+            cumulativeWeight += (*weight)[n];
+            while (boundary < nBoundaries && cumulativeWeight >= globalWeight * (boundary + 1) / m_nproc) {
+                boundaries[boundary] = globalOffset + n + 1;
+                ++boundary;
             }
+        }
 
-            if (nAssigendOctants == m_globalNumOctants) {
-                    break;
-            }
+        // Exchange the boundaries
+        if (!m_serial) {
+            MPI_Allreduce(MPI_IN_PLACE, boundaries.data(), nBoundaries, MPI_UINT64_T, MPI_MIN, m_comm);
+        }
+
+        // Evaluate the partition
+        uint64_t previousBoundary = 0;
+        for (int i = 0; i < nBoundaries; ++i) {
+            uint64_t currentBoundary = std::max(boundaries[i], previousBoundary);
+            partition[i] = static_cast<uint32_t>(currentBoundary - previousBoundary);
+            previousBoundary = currentBoundary;
         }
-        partition[m_nproc-1] = static_cast<uint32_t>(m_globalNumOctants - nAssigendOctants);
+        partition[m_nproc - 1] = static_cast<uint32_t>(m_globalNumOctants - previousBoundary);
     };
 
     /*! Compute the partition of the octree over the processes (only compute the information about
@@ -4663,18 +4966,13 @@ namespace bitpit {
         // the desired level above the maximum depth reached in the tree
         // are retained compact on the same process.
         uint8_t level = uint8_t(min(int(max(int(m_maxDepth) - int(level_), int(1))) , int(m_treeConstants->maxLevel)));
-        uint8_t* new_boundary_owner = new uint8_t[m_nproc-1];
-        uint8_t new_interfaces_count;
-        uint8_t first_new_interface_rank_index;
-        uint8_t* new_interfaces_count_per_rank = new uint8_t[m_nproc];
-        uint8_t* first_new_interface_rank_index_per_rank = new uint8_t[m_nproc];
+        uint32_t* new_boundary_owner = new uint32_t[m_nproc-1];
 
         uint32_t Dh = uint32_t(pow(double(2),double(m_treeConstants->maxLevel-level)));
         uint32_t istart, nocts, rest;
         uint32_t forw = 0, backw = 0;
         uint32_t i = 0, iproc, j;
         uint64_t sum;
-        int32_t* pointercomm;
         int32_t* deplace = new int32_t[m_nproc-1];
 
         // Find processes currently owning the new incoming process boundaries
@@ -4693,28 +4991,18 @@ namespace bitpit {
         nocts = getNumOctants();
         sum = 0;
 
-        // Store how many process interfaces fall in the current rank. For these interfaces
-        // the current rank has to communicate the info about the correction to the partition
-        // strcture aimed to maintain the families compact.
-        new_interfaces_count = 0;
-
-        // Store the index of the first process owner of the new process interface
-        // It will be the starting index for the communication of the corrections on
-        // the partition structure.
-        first_new_interface_rank_index = 0;
-
+        // Only the owner of a new process interface evaluates the correction to the partition
+        // structure aimed to maintain the families compact. The corrections of the interfaces
+        // owned by other processes are set to zero, this way they can be communicated summing
+        // the corrections evaluated by all the processes.
         for (iproc=0; iproc<(uint32_t)(m_nproc-1); iproc++){
-            deplace[iproc] = 1;
+            deplace[iproc] = 0;
             sum += partition_temp[iproc];
 
             // If the current process owns a new process interface, check if
             // the family at the interface is compact and store the correction on the
             // temporary partition structure.
-            if (new_boundary_owner[iproc] == m_rank){
-                if (new_interfaces_count == 0){
-                    first_new_interface_rank_index = iproc;
-                }
-                new_interfaces_count++;
+            if (new_boundary_owner[iproc] == (uint32_t)m_rank){
 
                 // Place istart at index of the last octant at new incoming process interface
                 if (m_rank!=0)
@@ -4781,12 +5069,7 @@ namespace bitpit {
         }
 
         // Communicate the right corrections to other processes
-        m_errorFlag = MPI_Allgather(&new_interfaces_count,1,MPI_UINT8_T,new_interfaces_count_per_rank,1,MPI_UINT8_T,m_comm);
-        m_errorFlag = MPI_Allgather(&first_new_interface_rank_index,1,MPI_UINT8_T,first_new_interface_rank_index_per_rank,1,MPI_UINT8_T,m_comm);
-        for (iproc=0; iproc<(uint32_t)(m_nproc); iproc++){
-            pointercomm = &deplace[first_new_interface_rank_index_per_rank[iproc]];
-            m_errorFlag = MPI_Bcast(pointercomm, new_interfaces_count_per_rank[iproc], MPI_INT32_T, iproc, m_comm);
-        }
+        m_errorFlag = MPI_Allreduce(MPI_IN_PLACE,deplace,m_nproc-1,MPI_INT32_T,MPI_SUM,m_comm);
 
         // Apply the corrections stored in deplace container to the termporary
         // computed partition structure.
@@ -4804,11 +5087,156 @@ namespace bitpit {
 
         delete [] partition_temp; partition_temp = NULL;
         delete [] new_boundary_owner; new_boundary_owner = NULL;
-        delete [] new_interfaces_count_per_rank; new_interfaces_count_per_rank = NULL;
-        delete [] first_new_interface_rank_index_per_rank; first_new_interface_rank_index_per_rank = NULL;
         delete [] deplace; deplace = NULL;
     }
 
+    /*! Compute the partition of the octree over the processes (only compute the information about
+     * how distribute the mesh). This is a diffusive weighted distribution method: the current
+     * partition is modified moving only the octants at the boundaries between neighbouring
+     * processes.
+     *
+     * If the weight of every process is not greater than (1 + tolerance) times the average
+     * weight, the current partition is retained. Otherwise, each boundary between two processes
+     * is moved by the least amount needed to bring the cumulative weight of the octants that
+     * precede it within half the tolerance from its target value (i.e., the value it would have
+     * in a perfectly balanced partition). Boundaries that already satisfy this condition are not
+     * moved. Since a boundary can only be moved across the octants of the two processes that
+     * share it, octants are exchanged only between neighbouring processes. Large imbalances may
+     * need more than one load balance to be fully removed.
+     *
+     * If the tree is serial or some processes have no octants, the boundaries between the
+     * processes are not defined, hence the partition is computed from scratch.
+     *
+     * Weights should be non-negative.
+     *
+     * \param[in] tolerance Tolerated imbalance, relative to the average weight of the processes.
+     * \param[in] weight Pointer to weight array. weight[i] = weight of i-th local octant (weight=NULL
+     * is uniform distribution).
+     * \param[out] partition Pointer to partition information array. partition[i] = number of octants
+     * to be stored on the i-th process (i-th rank).
+     */
+    void
+    ParaTree::computeDiffusivePartition(double tolerance, const dvector *weight, uint32_t *partition){
+
+        // Check if the partition can be diffused
+        bool isDiffusionPossible = !m_serial;
+        if (isDiffusionPossible) {
+            uint64_t previousEnd = 0;
+            for (int p = 0; p < m_nproc; ++p) {
+                uint64_t end = m_partitionRangeGlobalIdx[p] + 1;
+                if (end == previousEnd) {
+                    isDiffusionPossible = false;
+                    break;
+                }
+                previousEnd = end;
+            }
+        }
+
+        if (!isDiffusionPossible) {
+            if (weight == NULL) {
+                computePartition(partition);
+            } else {
+                computePartition(weight, partition);
+            }
+
+            return;
+        }
+
+        // Evaluate the weight of the processes
+        uint32_t nOctants = m_octree.getNumOctants();
+        assert(weight == NULL || weight->size() >= nOctants);
+
+        double localWeight = 0.;
+        if (weight == NULL) {
+            localWeight = nOctants;
+        } else {
+            for (uint32_t n = 0; n < nOctants; ++n) {
+                localWeight += (*weight)[n];
+            }
+        }
+
+        std::vector<double> processWeights(m_nproc);
+        MPI_Allgather(&localWeight, 1, MPI_DOUBLE, processWeights.data(), 1, MPI_DOUBLE, m_comm);
+
+        std::vector<double> cumulativeWeights(m_nproc);
+        std::partial_sum(processWeights.begin(), processWeights.end(), cumulativeWeights.begin());
+
+        // Initialize the boundaries using the current partition
+        //
+        // The boundary between the i-th and the (i+1)-th process is stored
+        // as the global index of the first octant of the (i+1)-th process.
+        int nBoundaries = m_nproc - 1;
+        std::vector<uint64_t> boundaries(nBoundaries);
+        for (int i = 0; i < nBoundaries; ++i) {
+            boundaries[i] = m_partitionRangeGlobalIdx[i] + 1;
+        }
+
+        // Move the boundaries
+        //
+        // Only the processes that share a boundary can find its updated
+        // position: if the boundary moves backward the octants that cross
+        // it belongs to the process that precedes the boundary, otherwise
+        // they belong to the process that follows it. The position of the
+        // boundaries that are not evaluated by the process is set to the
+        // maximum possible value, this way the updated boundaries can be
+        // exchanged with a minimum reduction.
+        double globalWeight = cumulativeWeights.back();
+        double targetWeight = globalWeight / m_nproc;
+        double maximumWeight = *std::max_element(processWeights.begin(), processWeights.end());
+        if (globalWeight > 0. && maximumWeight > (1. + std::max(tolerance, 0.)) * targetWeight) {
+            double halfBand = 0.5 * std::max(tolerance, 0.) * targetWeight;
+            uint64_t globalOffset = (m_rank > 0) ? m_partitionRangeGlobalIdx[m_rank - 1] + 1 : 0;
+
+            // Find the first position where the cumulative weight reaches
+            // the specified value, the search starts from the first local
+            // octant.
+            auto findLocalBoundary = [&](double cumulativeWeight, double boundaryWeight) {
+                if (cumulativeWeight >= boundaryWeight) {
+                    return globalOffset;
+                }
+
+                for (uint32_t n = 0; n < nOctants; ++n) {
+                    cumulativeWeight += (weight == NULL) ? 1. : (*weight)[n];
+                    if (cumulativeWeight >= boundaryWeight) {
+                        return globalOffset + n + 1;
+                    }
+                }
+
+                return globalOffset + nOctants;
+            };
+
+            for (int i = 0; i < nBoundaries; ++i) {
+                double lowerWeight = (i + 1) * targetWeight - halfBand;
+                double upperWeight = (i + 1) * targetWeight + halfBand;
+                if (cumulativeWeights[i] > upperWeight) {
+                    if (m_rank == i) {
+                        double previousWeight = (i > 0) ? cumulativeWeights[i - 1] : 0.;
+                        boundaries[i] = findLocalBoundary(previousWeight, upperWeight);
+                    } else {
+                        boundaries[i] = std::numeric_limits<uint64_t>::max();
+                    }
+                } else if (cumulativeWeights[i] < lowerWeight) {
+                    if (m_rank == i + 1) {
+                        boundaries[i] = findLocalBoundary(cumulativeWeights[i], lowerWeight);
+                    } else {
+                        boundaries[i] = std::numeric_limits<uint64_t>::max();
+                    }
+                }
+            }
+
+            MPI_Allreduce(MPI_IN_PLACE, boundaries.data(), nBoundaries, MPI_UINT64_T, MPI_MIN, m_comm);
+        }
+
+        // Evaluate the partition
+        uint64_t previousBoundary = 0;
+        for (int i = 0; i < nBoundaries; ++i) {
+            uint64_t currentBoundary = std::max(boundaries[i], previousBoundary);
+            partition[i] = static_cast<uint32_t>(currentBoundary - previousBoundary);
+            previousBoundary = currentBoundary;
+        }
+        partition[m_nproc - 1] = static_cast<uint32_t>(m_globalNumOctants - previousBoundary);
+    }
+
     /*! Update the distributed octree after a LoadBalance over the processes.
      */
     void
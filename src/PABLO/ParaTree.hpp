@@ -151,6 +151,25 @@ namespace bitpit {
             void clear();
         };
 
+        struct NeighbourTable {
+            uint8_t codimension;
+            uint8_t nEntities;
+            uint32_t nOctants;
+            uint32_t nGhosts;
+
+            std::vector<std::size_t> offsets;
+            u32vector neighbours;
+            bvector ghostFlags;
+
+            NeighbourTable();
+
+            std::size_t getRow(uint32_t idx, uint8_t entityIdx, bool isghost = false) const;
+            std::size_t getNeighbourCount(uint32_t idx, uint8_t entityIdx, bool isghost = false) const;
+            const uint32_t * getNeighbours(uint32_t idx, uint8_t entityIdx, bool isghost = false) const;
+
+            void clear();
+        };
+
     private:
         typedef std::unordered_map<int, std::array<uint64_t, 2>> PartitionIntersections;
 
@@ -387,6 +406,7 @@ namespace bitpit {
         uint32_t 	getNumOctants() const;
         uint32_t 	getNumGhosts() const;
         uint32_t 	getNumNodes() const;
+        std::size_t	getMemoryUsage() const;
         uint8_t 	getLocalMaxDepth() const;
         double	 	getLocalMaxSize() const;
         double	 	getLocalMinSize() const;
@@ -487,6 +507,7 @@ namespace bitpit {
         void 		findAllNodeNeighbours(const Octant* oct, uint32_t node, u32vector & neighbours, bvector & isghost) const;
         void 		findAllCodimensionNeighbours(uint32_t idx, u32vector & neighbours, bvector & isghost);
         void 		findAllCodimensionNeighbours(const Octant* oct, u32vector & neighbours, bvector & isghost);
+        void 		computeNeighbourTable(uint8_t entityCodim, NeighbourTable *table) const;
         void 		findGhostAllCodimensionNeighbours(uint32_t idx, u32vector & neighbours, bvector & isghost);
         void 		findGhostAllCodimensionNeighbours(Octant* oct, u32vector & neighbours, bvector & isghost);
         Octant* 	getPointOwner(const dvector &point);
@@ -537,11 +558,15 @@ namespace bitpit {
 #if BITPIT_ENABLE_MPI==1
         void 		loadBalance(const dvector* weight = NULL);
         void 		loadBalance(uint8_t & level, const dvector* weight = NULL);
+        void 		loadBalanceDiffusive(double tolerance, const dvector* weight = NULL);
 
         LoadBalanceRanges evalLoadBalanceRanges(dvector *weights);
         LoadBalanceRanges evalLoadBalanceRanges(uint8_t level, dvector *weights);
+        LoadBalanceRanges evalDiffusiveLoadBalanceRanges(double tolerance, const dvector *weights);
+        uint64_t    evalDiffusiveLoadBalanceMigration(double tolerance, const dvector *weights);
     private:
         LoadBalanceRanges evalLoadBalanceRanges(const uint32_t *updatedPartition);
+        uint64_t    evalPartitionMigration(const uint32_t *updatedPartition) const;
 
         ExchangeRanges evalLoadBalanceSendRanges(const uint32_t *updatedPartition);
         ExchangeRanges evalLoadBalanceRecvRanges(const uint32_t *updatedPartition);
@@ -567,6 +592,7 @@ namespace bitpit {
         void 		computePartition(uint32_t *partition);
         void 		computePartition(const dvector *weight, uint32_t *partition);
         void 		computePartition(uint8_t level_, const dvector *weight, uint32_t *partition);
+        void 		computeDiffusivePartition(double tolerance, const dvector *weight, uint32_t *partition);
         void 		updateLoadBalance();
         void 		setPboundGhosts();
         void 		buildGhostOctants(const std::map<int, u32vector> &bordersPerProc, const std::vector<AccretionData> &accretions);
@@ -751,6 +777,56 @@ namespace bitpit {
 
         }
 
+        /** Distribute Load-Balancing the octants (with user defined weights) of the whole tree and data provided by the user
+         * over the processes of the job, moving only the octants at the boundaries between neighbouring processes.
+         * The partition is updated only if the imbalance exceeds the tolerance (see computeDiffusivePartition).
+         * Even distribute data provided by the user between the processes.
+         * \param[in] userData User interface to distribute the data during loadBalance.
+         * \param[in] tolerance Tolerated imbalance, relative to the average weight of the processes.
+         * \param[in] weight Pointer to a vector of weights of the local octants (weight=NULL is uniform distribution).
+         */
+        template<class Impl>
+        void
+        loadBalanceDiffusive(DataLBInterface<Impl> & userData, double tolerance, const dvector* weight = NULL){
+
+            //Write info on log
+            (*m_log) << "---------------------------------------------" << std::endl;
+            (*m_log) << " LOAD BALANCE (DIFFUSIVE) " << std::endl;
+
+            m_lastOp = OP_LOADBALANCE;
+            if (m_nproc>1){
+
+                std::vector<uint32_t> partition(m_nproc);
+                computeDiffusivePartition(tolerance, weight, partition.data());
+
+                (*m_log) << " " << std::endl;
+                (*m_log) << " Octants to migrate	:	" + std::to_string(static_cast<unsigned long long>(evalPartitionMigration(partition.data()))) << std::endl;
+
+                privateLoadBalance(partition.data(), &userData);
+
+                //Write info of final partition on log
+                (*m_log) << " " << std::endl;
+                (*m_log) << " Final Parallel partition : " << std::endl;
+                (*m_log) << " Octants for proc	"+ std::to_string(static_cast<unsigned long long>(0))+"	:	" + std::to_string(static_cast<unsigned long long>(m_partitionRangeGlobalIdx[0]+1)) << std::endl;
+                for(int ii=1; ii<m_nproc; ii++){
+                    (*m_log) << " Octants for proc	"+ std::to_string(static_cast<unsigned long long>(ii))+"	:	" + std::to_string(static_cast<unsigned long long>(m_partitionRangeGlobalIdx[ii]-m_partitionRangeGlobalIdx[ii-1])) << std::endl;
+                }
+                (*m_log) << " " << std::endl;
+                (*m_log) << "---------------------------------------------" << std::endl;
+
+            }
+            else{
+                m_loadBalanceRanges.clear();
+
+                (*m_log) << " " << std::endl;
+                (*m_log) << " Serial partition : " << std::endl;
+                (*m_log) << " Octants for proc	"+ std::to_string(static_cast<unsigned long long>(0))+"	:	" + std::to_string(static_cast<unsigned long long>(m_partitionRangeGlobalIdx[0]+1)) << std::endl;
+                (*m_log) << " " << std::endl;
+                (*m_log) << "---------------------------------------------" << std::endl;
+            }
+
+        }
+
         /**
         * Distribute Load-Balancing octants and user data of the whole
         * tree over the processes of the job following a given partition
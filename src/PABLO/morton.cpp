@@ -0,0 +1,757 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "morton.hpp"
+
+#include <cstring>
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+#include <cpuid.h>
+#endif
+
+namespace bitpit {
+
+namespace PABLO {
+
+namespace {
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+/**
+* Check if the processor supports the BMI2 set.
+*
+* \result Returns true if the processor supports the BMI2 set, false
+* otherwise.
+*/
+bool hasBMI2()
+{
+    static const bool supported = []() {
+        __builtin_cpu_init();
+        return (__builtin_cpu_supports("bmi2") != 0);
+    }();
+
+    return supported;
+}
+
+/**
+* Check if the processor supports the AVX2 set.
+*
+* The check takes into account also the support of the operating system
+* for the extended registers.
+*
+* \result Returns true if the processor supports the AVX2 set, false
+* otherwise.
+*/
+bool hasAVX2()
+{
+    static const bool supported = []() {
+        __builtin_cpu_init();
+        return (__builtin_cpu_supports("avx2") != 0);
+    }();
+
+    return supported;
+}
+
+/**
+* Check if the bit deposit and extract instructions of the processor are
+* fast.
+*
+* AMD processors older than Zen 3 (and the Hygon processors derived from
+* them) implement the instructions in microcode, with a latency that is
+* much higher than the one of the "magic bits" algorithm.
+*
+* \result Returns true if the bit deposit and extract instructions of the
+* processor are fast, false otherwise.
+*/
+bool hasFastBMI2()
+{
+    static const bool fast = []() {
+        if (!hasBMI2()) {
+            return false;
+        }
+
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+            return true;
+        }
+
+        char vendor[13];
+        std::memcpy(vendor + 0, &ebx, 4);
+        std::memcpy(vendor + 4, &edx, 4);
+        std::memcpy(vendor + 8, &ecx, 4);
+        vendor[12] = '\0';
+
+        if (std::strcmp(vendor, "AuthenticAMD") != 0 && std::strcmp(vendor, "HygonGenuine") != 0) {
+            return true;
+        }
+
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+
+        unsigned int family = (eax >> 8) & 0xf;
+        if (family == 0xf) {
+            family += (eax >> 20) & 0xff;
+        }
+
+        return (family >= 0x19);
+    }();
+
+    return fast;
+}
+
+/**
+* Seperate bits of the given integers 3 positions apart.
+*
+* \param x are the integer positions, stored as 64-bit integers
+* \result Separated bits.
+*/
+__attribute__((target("avx2")))
+inline __m256i splitBy3AVX2(__m256i x)
+{
+    x = _mm256_and_si256(x, _mm256_set1_epi64x(0x1fffff));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 32)), _mm256_set1_epi64x(0x001F00000000FFFF));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 16)), _mm256_set1_epi64x(0x001F0000FF0000FF));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  8)), _mm256_set1_epi64x(0x100F00F00F00F00F));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  4)), _mm256_set1_epi64x(0x10C30C30C30C30C3));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  2)), _mm256_set1_epi64x(0x1249249249249249));
+
+    return x;
+}
+
+/**
+* Seperate bits of the given integers 2 positions apart.
+*
+* \param x are the integer positions, stored as 64-bit integers
+* \result Separated bits.
+*/
+__attribute__((target("avx2")))
+inline __m256i splitBy2AVX2(__m256i x)
+{
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 16)), _mm256_set1_epi64x(0x0000FFFF0000FFFF));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  8)), _mm256_set1_epi64x(0x00FF00FF00FF00FF));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  4)), _mm256_set1_epi64x(0x0F0F0F0F0F0F0F0F));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  2)), _mm256_set1_epi64x(0x3333333333333333));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x,  1)), _mm256_set1_epi64x(0x5555555555555555));
+
+    return x;
+}
+
+/**
+* Get the third bits of the given Morton numbers.
+*
+* \param morton are the morton numbers
+* \result The third bits of the given Morton numbers, stored as 64-bit
+* integers.
+*/
+__attribute__((target("avx2")))
+inline __m256i getThirdBitsAVX2(__m256i morton)
+{
+    __m256i x = _mm256_and_si256(morton, _mm256_set1_epi64x(0x1249249249249249));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  2)), _mm256_set1_epi64x(0x10C30C30C30C30C3));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  4)), _mm256_set1_epi64x(0x100F00F00F00F00F));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  8)), _mm256_set1_epi64x(0x001F0000FF0000FF));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x, 16)), _mm256_set1_epi64x(0x001F00000000FFFF));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x, 32)), _mm256_set1_epi64x(0x00000000001FFFFF));
+
+    return x;
+}
+
+/**
+* Get the second bits of the given Morton numbers.
+*
+* \param morton are the morton numbers
+* \result The second bits of the given Morton numbers, stored as 64-bit
+* integers.
+*/
+__attribute__((target("avx2")))
+inline __m256i getSecondBitsAVX2(__m256i morton)
+{
+    __m256i x = _mm256_and_si256(morton, _mm256_set1_epi64x(0x5555555555555555));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  1)), _mm256_set1_epi64x(0x3333333333333333));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  2)), _mm256_set1_epi64x(0x0F0F0F0F0F0F0F0F));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  4)), _mm256_set1_epi64x(0x00FF00FF00FF00FF));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x,  8)), _mm256_set1_epi64x(0x0000FFFF0000FFFF));
+    x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x, 16)), _mm256_set1_epi64x(0x00000000FFFFFFFF));
+
+    return x;
+}
+
+/**
+* Load four 32-bit integers and widen them to 64-bit integers.
+*
+* \param values are the integers that will be loaded
+* \result The widened integers.
+*/
+__attribute__((target("avx2")))
+inline __m256i loadWidenedAVX2(const uint32_t *values)
+{
+    return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values)));
+}
+
+/**
+* Narrow four 64-bit integers to 32-bit integers and store them.
+*
+* \param x are the integers that will be stored, they should fit in 32 bits
+* \param[out] values on output will contain the narrowed integers
+*/
+__attribute__((target("avx2")))
+inline void storeNarrowedAVX2(__m256i x, uint32_t *values)
+{
+    __m256i packed = _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(values), _mm256_castsi256_si128(packed));
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates using AVX2
+* instructions.
+*
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param z are the integer z positions
+* \param[out] mortons on output will contain the Morton numbers
+*/
+__attribute__((target("avx2")))
+void computeMortons3DAVX2(std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i xSplit = splitBy3AVX2(loadWidenedAVX2(x + i));
+        __m256i ySplit = splitBy3AVX2(loadWidenedAVX2(y + i));
+        __m256i zSplit = splitBy3AVX2(loadWidenedAVX2(z + i));
+
+        __m256i morton = _mm256_or_si256(xSplit, _mm256_or_si256(_mm256_slli_epi64(ySplit, 1), _mm256_slli_epi64(zSplit, 2)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(mortons + i), morton);
+    }
+
+    for (; i < n; ++i) {
+        mortons[i] = computeMorton3DMagicBits(x[i], y[i], z[i]);
+    }
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates using AVX2
+* instructions.
+*
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param[out] mortons on output will contain the Morton numbers
+*/
+__attribute__((target("avx2")))
+void computeMortons2DAVX2(std::size_t n, const uint32_t *x, const uint32_t *y, uint64_t *mortons)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i xSplit = splitBy2AVX2(loadWidenedAVX2(x + i));
+        __m256i ySplit = splitBy2AVX2(loadWidenedAVX2(y + i));
+
+        __m256i morton = _mm256_or_si256(xSplit, _mm256_slli_epi64(ySplit, 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(mortons + i), morton);
+    }
+
+    for (; i < n; ++i) {
+        mortons[i] = computeMorton2DMagicBits(x[i], y[i]);
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers using AVX2
+* instructions.
+*
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions
+* \param[out] y on output will contain the integer y positions
+* \param[out] z on output will contain the integer z positions
+*/
+__attribute__((target("avx2")))
+void computeCoordinates3DAVX2(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i morton = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mortons + i));
+
+        storeNarrowedAVX2(getThirdBitsAVX2(morton), x + i);
+        storeNarrowedAVX2(getThirdBitsAVX2(_mm256_srli_epi64(morton, 1)), y + i);
+        storeNarrowedAVX2(getThirdBitsAVX2(_mm256_srli_epi64(morton, 2)), z + i);
+    }
+
+    for (; i < n; ++i) {
+        x[i] = computeCoordinate3DMagicBits(mortons[i], 0);
+        y[i] = computeCoordinate3DMagicBits(mortons[i], 1);
+        z[i] = computeCoordinate3DMagicBits(mortons[i], 2);
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers using AVX2
+* instructions.
+*
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions
+* \param[out] y on output will contain the integer y positions
+*/
+__attribute__((target("avx2")))
+void computeCoordinates2DAVX2(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i morton = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mortons + i));
+
+        storeNarrowedAVX2(getSecondBitsAVX2(morton), x + i);
+        storeNarrowedAVX2(getSecondBitsAVX2(_mm256_srli_epi64(morton, 1)), y + i);
+    }
+
+    for (; i < n; ++i) {
+        x[i] = computeCoordinate2DMagicBits(mortons[i], 0);
+        y[i] = computeCoordinate2DMagicBits(mortons[i], 1);
+    }
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates using BMI2
+* instructions.
+*
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param z are the integer z positions
+* \param[out] mortons on output will contain the Morton numbers
+*/
+__attribute__((target("bmi2")))
+void computeMortons3DBMI2(std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        mortons[i] = computeMorton3DBMI2(x[i], y[i], z[i]);
+    }
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates using BMI2
+* instructions.
+*
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param[out] mortons on output will contain the Morton numbers
+*/
+__attribute__((target("bmi2")))
+void computeMortons2DBMI2(std::size_t n, const uint32_t *x, const uint32_t *y, uint64_t *mortons)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        mortons[i] = computeMorton2DBMI2(x[i], y[i]);
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers using BMI2
+* instructions.
+*
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions
+* \param[out] y on output will contain the integer y positions
+* \param[out] z on output will contain the integer z positions
+*/
+__attribute__((target("bmi2")))
+void computeCoordinates3DBMI2(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = computeCoordinate3DBMI2(mortons[i], 0);
+        y[i] = computeCoordinate3DBMI2(mortons[i], 1);
+        z[i] = computeCoordinate3DBMI2(mortons[i], 2);
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers using BMI2
+* instructions.
+*
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions
+* \param[out] y on output will contain the integer y positions
+*/
+__attribute__((target("bmi2")))
+void computeCoordinates2DBMI2(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = computeCoordinate2DBMI2(mortons[i], 0);
+        y[i] = computeCoordinate2DBMI2(mortons[i], 1);
+    }
+}
+#endif
+
+/**
+* Check that the specified kernel is supported by the processor.
+*
+* An exception is thrown if the kernel is not supported.
+*
+* \param kernel is the kernel
+*/
+void checkMortonKernel(MortonKernel kernel)
+{
+    if (!isMortonKernelSupported(kernel)) {
+        throw std::runtime_error("Requested Morton kernel is not supported by the processor");
+    }
+}
+
+}
+
+/**
+* Check if the specified kernel for encoding and decoding arrays of Morton
+* numbers is supported by the processor.
+*
+* \param kernel is the kernel
+* \result Returns true if the kernel is supported, false otherwise.
+*/
+bool isMortonKernelSupported(MortonKernel kernel)
+{
+    switch (kernel) {
+
+    case MORTON_KERNEL_MAGIC_BITS:
+        return true;
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+    case MORTON_KERNEL_AVX2:
+        return hasAVX2();
+
+    case MORTON_KERNEL_BMI2:
+        return hasBMI2();
+#endif
+
+    default:
+        return false;
+
+    }
+}
+
+/**
+* Get the kernel used by default for encoding and decoding arrays of Morton
+* numbers.
+*
+* The kernel is chosen the first time the function is called, looking at
+* the instruction sets supported by the processor: the BMI2 kernel is used
+* when the bit deposit and extract instructions are fast, otherwise the
+* AVX2 kernel is used when available. The portable "magic bits" kernel is
+* used as a fallback.
+*
+* \result The kernel used by default for encoding and decoding arrays of
+* Morton numbers.
+*/
+MortonKernel getDefaultMortonKernel()
+{
+    static const MortonKernel kernel = []() {
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+        if (hasFastBMI2()) {
+            return MORTON_KERNEL_BMI2;
+        } else if (hasAVX2()) {
+            return MORTON_KERNEL_AVX2;
+        }
+#endif
+
+        return MORTON_KERNEL_MAGIC_BITS;
+    }();
+
+    return kernel;
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates.
+*
+* The default kernel is used.
+*
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param z are the integer z positions
+* \param[out] mortons on output will contain the Morton numbers, the array
+* should be able to contain n numbers
+*/
+void computeMortons3D(std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons)
+{
+    computeMortons3D(getDefaultMortonKernel(), n, x, y, z, mortons);
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates.
+*
+* \param kernel is the kernel that will be used, it should be supported by
+* the processor
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param z are the integer z positions
+* \param[out] mortons on output will contain the Morton numbers, the array
+* should be able to contain n numbers
+*/
+void computeMortons3D(MortonKernel kernel, std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons)
+{
+    checkMortonKernel(kernel);
+
+    switch (kernel) {
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+    case MORTON_KERNEL_AVX2:
+        computeMortons3DAVX2(n, x, y, z, mortons);
+        break;
+
+    case MORTON_KERNEL_BMI2:
+        computeMortons3DBMI2(n, x, y, z, mortons);
+        break;
+#endif
+
+    default:
+        for (std::size_t i = 0; i < n; ++i) {
+            mortons[i] = computeMorton3DMagicBits(x[i], y[i], z[i]);
+        }
+        break;
+
+    }
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates.
+*
+* The default kernel is used.
+*
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param[out] mortons on output will contain the Morton numbers, the array
+* should be able to contain n numbers
+*/
+void computeMortons2D(std::size_t n, const uint32_t *x, const uint32_t *y, uint64_t *mortons)
+{
+    computeMortons2D(getDefaultMortonKernel(), n, x, y, mortons);
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates.
+*
+* \param kernel is the kernel that will be used, it should be supported by
+* the processor
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param[out] mortons on output will contain the Morton numbers, the array
+* should be able to contain n numbers
+*/
+void computeMortons2D(MortonKernel kernel, std::size_t n, const uint32_t *x, const uint32_t *y, uint64_t *mortons)
+{
+    checkMortonKernel(kernel);
+
+    switch (kernel) {
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+    case MORTON_KERNEL_AVX2:
+        computeMortons2DAVX2(n, x, y, mortons);
+        break;
+
+    case MORTON_KERNEL_BMI2:
+        computeMortons2DBMI2(n, x, y, mortons);
+        break;
+#endif
+
+    default:
+        for (std::size_t i = 0; i < n; ++i) {
+            mortons[i] = computeMorton2DMagicBits(x[i], y[i]);
+        }
+        break;
+
+    }
+}
+
+/**
+* Compute the Morton numbers of the given sets of coordinates.
+*
+* The default kernel is used.
+*
+* \param dimension is the dimension of the space
+* \param n is the number of sets of coordinates
+* \param x are the integer x positions
+* \param y are the integer y positions
+* \param z are the integer z positions, they are ignored in two dimensions
+* \param[out] mortons on output will contain the Morton numbers, the array
+* should be able to contain n numbers
+*/
+void computeMortons(uint8_t dimension, std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons)
+{
+    if (dimension == 3) {
+        computeMortons3D(n, x, y, z, mortons);
+    } else if (dimension == 2) {
+        computeMortons2D(n, x, y, mortons);
+    } else {
+        throw std::runtime_error("Requested dimension is not supported");
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers.
+*
+* The default kernel is used.
+*
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions, the array
+* should be able to contain n values
+* \param[out] y on output will contain the integer y positions, the array
+* should be able to contain n values
+* \param[out] z on output will contain the integer z positions, the array
+* should be able to contain n values
+*/
+void computeCoordinates3D(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z)
+{
+    computeCoordinates3D(getDefaultMortonKernel(), n, mortons, x, y, z);
+}
+
+/**
+* Compute the coordinates of the given Morton numbers.
+*
+* \param kernel is the kernel that will be used, it should be supported by
+* the processor
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions, the array
+* should be able to contain n values
+* \param[out] y on output will contain the integer y positions, the array
+* should be able to contain n values
+* \param[out] z on output will contain the integer z positions, the array
+* should be able to contain n values
+*/
+void computeCoordinates3D(MortonKernel kernel, std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z)
+{
+    checkMortonKernel(kernel);
+
+    switch (kernel) {
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+    case MORTON_KERNEL_AVX2:
+        computeCoordinates3DAVX2(n, mortons, x, y, z);
+        break;
+
+    case MORTON_KERNEL_BMI2:
+        computeCoordinates3DBMI2(n, mortons, x, y, z);
+        break;
+#endif
+
+    default:
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = computeCoordinate3DMagicBits(mortons[i], 0);
+            y[i] = computeCoordinate3DMagicBits(mortons[i], 1);
+            z[i] = computeCoordinate3DMagicBits(mortons[i], 2);
+        }
+        break;
+
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers.
+*
+* The default kernel is used.
+*
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions, the array
+* should be able to contain n values
+* \param[out] y on output will contain the integer y positions, the array
+* should be able to contain n values
+*/
+void computeCoordinates2D(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y)
+{
+    computeCoordinates2D(getDefaultMortonKernel(), n, mortons, x, y);
+}
+
+/**
+* Compute the coordinates of the given Morton numbers.
+*
+* \param kernel is the kernel that will be used, it should be supported by
+* the processor
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions, the array
+* should be able to contain n values
+* \param[out] y on output will contain the integer y positions, the array
+* should be able to contain n values
+*/
+void computeCoordinates2D(MortonKernel kernel, std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y)
+{
+    checkMortonKernel(kernel);
+
+    switch (kernel) {
+
+#if BITPIT_PABLO_MORTON_X86_KERNELS
+    case MORTON_KERNEL_AVX2:
+        computeCoordinates2DAVX2(n, mortons, x, y);
+        break;
+
+    case MORTON_KERNEL_BMI2:
+        computeCoordinates2DBMI2(n, mortons, x, y);
+        break;
+#endif
+
+    default:
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = computeCoordinate2DMagicBits(mortons[i], 0);
+            y[i] = computeCoordinate2DMagicBits(mortons[i], 1);
+        }
+        break;
+
+    }
+}
+
+/**
+* Compute the coordinates of the given Morton numbers.
+*
+* The default kernel is used.
+*
+* \param dimension is the dimension of the space
+* \param n is the number of Morton numbers
+* \param mortons are the Morton numbers
+* \param[out] x on output will contain the integer x positions, the array
+* should be able to contain n values
+* \param[out] y on output will contain the integer y positions, the array
+* should be able to contain n values
+* \param[out] z on output will contain the integer z positions, the array
+* should be able to contain n values, in two dimensions it will be filled
+* with zeros
+*/
+void computeCoordinates(uint8_t dimension, std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z)
+{
+    if (dimension == 3) {
+        computeCoordinates3D(n, mortons, x, y, z);
+    } else if (dimension == 2) {
+        computeCoordinates2D(n, mortons, x, y);
+        std::fill(z, z + n, 0);
+    } else {
+        throw std::runtime_error("Requested dimension is not supported");
+    }
+}
+
+}
+
+}
@@ -26,16 +26,61 @@
 #define __BITPIT_PABLO_MORTON_HPP__
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <stdexcept>
 
+// BMI2 and AVX2 kernels are available when the compiler allows to enable
+// the instruction sets on a per-function basis.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BITPIT_PABLO_MORTON_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define BITPIT_PABLO_MORTON_X86_KERNELS 0
+#endif
+
+// Functions that encode or decode a single Morton number use the BMI2
+// instructions only when the code is compiled for a processor on which
+// they are fast. AMD processors older than Zen 3 (and the Hygon processors
+// derived from them) implement the instructions in microcode, the same
+// processors are excluded by the runtime check of the array functions.
+#if BITPIT_PABLO_MORTON_X86_KERNELS && defined(__BMI2__) && !defined(__bdver4__) && !defined(__znver1__) && !defined(__znver2__)
+#define BITPIT_PABLO_MORTON_SCALAR_BMI2 1
+#else
+#define BITPIT_PABLO_MORTON_SCALAR_BMI2 0
+#endif
+
 namespace bitpit {
 
 namespace PABLO {
 
 const uint64_t INVALID_MORTON = std::numeric_limits<uint64_t>::max();
 
+/*!
+* Kernels available for encoding and decoding arrays of Morton numbers.
+*/
+enum MortonKernel {
+    MORTON_KERNEL_MAGIC_BITS,  //! Portable "magic bits" algorithm
+    MORTON_KERNEL_AVX2,        //! "Magic bits" algorithm vectorized with AVX2 instructions
+    MORTON_KERNEL_BMI2         //! Bit deposit and extract instructions of the BMI2 set
+};
+
+bool isMortonKernelSupported(MortonKernel kernel);
+MortonKernel getDefaultMortonKernel();
+
+/*!
+* Masks that select the bits of each coordinate in a three-dimensional
+* Morton number.
+*/
+const uint64_t MORTON_MASKS_3D[3] = {0x1249249249249249, 0x2492492492492492, 0x4924924924924924};
+
+/*!
+* Masks that select the bits of each coordinate in a two-dimensional
+* Morton number.
+*/
+const uint64_t MORTON_MASKS_2D[2] = {0x5555555555555555, 0xAAAAAAAAAAAAAAAA};
+
 /**
 * Compute the maximum allowed level.
 *
@@ -168,7 +213,7 @@ inline uint32_t getSecondBits(uint64_t morton)
 * \param z is the integer z position
 * \result The Morton number.
 */
-inline uint64_t computeMorton3D(uint32_t x, uint32_t y, uint32_t z)
+inline uint64_t computeMorton3DMagicBits(uint32_t x, uint32_t y, uint32_t z)
 {
     uint64_t morton = splitBy3(x) | (splitBy3(y) << 1) | (splitBy3(z) << 2);
 
@@ -185,18 +230,97 @@ inline uint64_t computeMorton3D(uint32_t x, uint32_t y, uint32_t z)
 * \param y is the integer y position
 * \result The Morton number.
 */
-inline uint64_t computeMorton2D(uint32_t x, uint32_t y)
+inline uint64_t computeMorton2DMagicBits(uint32_t x, uint32_t y)
 {
     uint64_t morton = splitBy2(x) | (splitBy2(y) << 1);
 
     return morton;
 }
 
+#if BITPIT_PABLO_MORTON_X86_KERNELS
 /**
 * Compute the Morton number of the given set of coordinates.
 *
-* The function uses the "magic bits" algorithm of the libmorton library
-* (see https://github.com/Forceflow/libmorton).
+* The function uses the bit deposit instruction of the BMI2 set, the caller
+* is responsible for checking that the processor supports it.
+*
+* \param x is the integer x position
+* \param y is the integer y position
+* \param z is the integer z position
+* \result The Morton number.
+*/
+__attribute__((target("bmi2")))
+inline uint64_t computeMorton3DBMI2(uint32_t x, uint32_t y, uint32_t z)
+{
+    uint64_t morton = _pdep_u64(x, MORTON_MASKS_3D[0]) | _pdep_u64(y, MORTON_MASKS_3D[1]) | _pdep_u64(z, MORTON_MASKS_3D[2]);
+
+    return morton;
+}
+
+/**
+* Compute the Morton number of the given set of coordinates.
+*
+* The function uses the bit deposit instruction of the BMI2 set, the caller
+* is responsible for checking that the processor supports it.
+*
+* \param x is the integer x position
+* \param y is the integer y position
+* \result The Morton number.
+*/
+__attribute__((target("bmi2")))
+inline uint64_t computeMorton2DBMI2(uint32_t x, uint32_t y)
+{
+    uint64_t morton = _pdep_u64(x, MORTON_MASKS_2D[0]) | _pdep_u64(y, MORTON_MASKS_2D[1]);
+
+    return morton;
+}
+#endif
+
+/**
+* Compute the Morton number of the given set of coordinates.
+*
+* When the code is compiled for a processor with fast BMI2 instructions,
+* the function uses the bit deposit instruction, otherwise it uses the
+* "magic bits" algorithm. Checking the processor at run time would cost
+* more than the encoding itself, runtime dispatch is only performed by
+* the functions that process arrays of coordinates.
+*
+* \param x is the integer x position
+* \param y is the integer y position
+* \param z is the integer z position
+* \result The Morton number.
+*/
+inline uint64_t computeMorton3D(uint32_t x, uint32_t y, uint32_t z)
+{
+#if BITPIT_PABLO_MORTON_SCALAR_BMI2
+    return computeMorton3DBMI2(x, y, z);
+#else
+    return computeMorton3DMagicBits(x, y, z);
+#endif
+}
+
+/**
+* Compute the Morton number of the given set of coordinates.
+*
+* When the code is compiled for a processor with fast BMI2 instructions,
+* the function uses the bit deposit instruction, otherwise it uses the
+* "magic bits" algorithm.
+*
+* \param x is the integer x position
+* \param y is the integer y position
+* \result The Morton number.
+*/
+inline uint64_t computeMorton2D(uint32_t x, uint32_t y)
+{
+#if BITPIT_PABLO_MORTON_SCALAR_BMI2
+    return computeMorton2DBMI2(x, y);
+#else
+    return computeMorton2DMagicBits(x, y);
+#endif
+}
+
+/**
+* Compute the Morton number of the given set of coordinates.
 *
 * \param dimension is the dimension of the space
 * \param x is the integer x position
@@ -225,7 +349,7 @@ inline uint64_t computeMorton(uint8_t dimension, uint32_t x, uint32_t y, uint32_
 * \param coord is the coordinate that will be computed
 * \result The coordinate value.
 */
-inline uint32_t computeCoordinate3D(uint64_t morton, int coord)
+inline uint32_t computeCoordinate3DMagicBits(uint64_t morton, int coord)
 {
     return getThirdBits(morton >> coord);
 }
@@ -240,7 +364,7 @@ inline uint32_t computeCoordinate3D(uint64_t morton, int coord)
 * \param coord is the coordinate that will be computed
 * \result The coordinate value.
 */
-inline uint32_t computeCoordinate2D(uint64_t morton, int coord)
+inline uint32_t computeCoordinate2DMagicBits(uint64_t morton, int coord)
 {
     if (coord < 2) {
         return getSecondBits(morton >> coord);
@@ -249,11 +373,86 @@ inline uint32_t computeCoordinate2D(uint64_t morton, int coord)
     }
 }
 
+#if BITPIT_PABLO_MORTON_X86_KERNELS
 /**
 * Compute the specified coordinate value from the given Morton number.
 *
-* The function uses the "magic bits" algorithm of the libmorton library
-* (see https://github.com/Forceflow/libmorton).
+* The function uses the bit extract instruction of the BMI2 set, the caller
+* is responsible for checking that the processor supports it.
+*
+* \param morton is the morton number
+* \param coord is the coordinate that will be computed
+* \result The coordinate value.
+*/
+__attribute__((target("bmi2")))
+inline uint32_t computeCoordinate3DBMI2(uint64_t morton, int coord)
+{
+    return static_cast<uint32_t>(_pext_u64(morton, MORTON_MASKS_3D[coord]));
+}
+
+/**
+* Compute the specified coordinate value from the given Morton number.
+*
+* The function uses the bit extract instruction of the BMI2 set, the caller
+* is responsible for checking that the processor supports it.
+*
+* \param morton is the morton number
+* \param coord is the coordinate that will be computed
+* \result The coordinate value.
+*/
+__attribute__((target("bmi2")))
+inline uint32_t computeCoordinate2DBMI2(uint64_t morton, int coord)
+{
+    if (coord < 2) {
+        return static_cast<uint32_t>(_pext_u64(morton, MORTON_MASKS_2D[coord]));
+    } else {
+        return 0;
+    }
+}
+#endif
+
+/**
+* Compute the specified coordinate value from the given Morton number.
+*
+* When the code is compiled for a processor with fast BMI2 instructions,
+* the function uses the bit extract instruction, otherwise it uses the
+* "magic bits" algorithm.
+*
+* \param morton is the morton number
+* \param coord is the coordinate that will be computed
+* \result The coordinate value.
+*/
+inline uint32_t computeCoordinate3D(uint64_t morton, int coord)
+{
+#if BITPIT_PABLO_MORTON_SCALAR_BMI2
+    return computeCoordinate3DBMI2(morton, coord);
+#else
+    return computeCoordinate3DMagicBits(morton, coord);
+#endif
+}
+
+/**
+* Compute the specified coordinate value from the given Morton number.
+*
+* When the code is compiled for a processor with fast BMI2 instructions,
+* the function uses the bit extract instruction, otherwise it uses the
+* "magic bits" algorithm.
+*
+* \param morton is the morton number
+* \param coord is the coordinate that will be computed
+* \result The coordinate value.
+*/
+inline uint32_t computeCoordinate2D(uint64_t morton, int coord)
+{
+#if BITPIT_PABLO_MORTON_SCALAR_BMI2
+    return computeCoordinate2DBMI2(morton, coord);
+#else
+    return computeCoordinate2DMagicBits(morton, coord);
+#endif
+}
+
+/**
+* Compute the specified coordinate value from the given Morton number.
 *
 * \param dimension is the dimension of the space
 * \param morton is the morton number
@@ -271,6 +470,18 @@ inline uint32_t computeCoordinate(uint8_t dimension, uint64_t morton, int coord)
     }
 }
 
+void computeMortons3D(std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons);
+void computeMortons3D(MortonKernel kernel, std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons);
+void computeMortons2D(std::size_t n, const uint32_t *x, const uint32_t *y, uint64_t *mortons);
+void computeMortons2D(MortonKernel kernel, std::size_t n, const uint32_t *x, const uint32_t *y, uint64_t *mortons);
+void computeMortons(uint8_t dimension, std::size_t n, const uint32_t *x, const uint32_t *y, const uint32_t *z, uint64_t *mortons);
+
+void computeCoordinates3D(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z);
+void computeCoordinates3D(MortonKernel kernel, std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z);
+void computeCoordinates2D(std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y);
+void computeCoordinates2D(MortonKernel kernel, std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y);
+void computeCoordinates(uint8_t dimension, std::size_t n, const uint64_t *mortons, uint32_t *x, uint32_t *y, uint32_t *z);
+
 /**
 * Compute the XYZ key of the given set of coordinates.
 *
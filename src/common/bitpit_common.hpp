@@ -33,7 +33,10 @@
  * @defgroup common_binary Binary streams
  * @defgroup common_hashing Hashing
  * @defgroup common_logger Logger
+ * @defgroup common_memory Memory
  * @defgroup common_misc Miscellaneous
+ * @defgroup common_threads Threads
+ * @defgroup common_sfc Space-filling curves
  * @defgroup common_macro Macros
  * @defgroup common_constants Constants
  * @}
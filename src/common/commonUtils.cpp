@@ -39,6 +39,44 @@ template bool addToOrderedVector<>(const unsigned long&, std::vector<unsigned lo
 template std::vector<long>::const_iterator findInOrderedVector<>(const long&, const std::vector<long>&, std::less<long>);
 template std::vector<unsigned long>::const_iterator findInOrderedVector<>(const unsigned long&, const std::vector<unsigned long>&, std::less<unsigned long>);
 
+/*!
+* Maximum amount of temporary memory, expressed in bytes, that can be used
+* for permuting a vector out of place.
+*/
+static std::size_t reorderMemoryLimit = std::size_t(1) << 30;
+
+/*!
+* \ingroup common_misc
+*
+* Sets the maximum amount of temporary memory that can be used for permuting
+* a vector out of place.
+*
+* Permuting a vector out of place is faster and can be performed by
+* multiple threads, but requires a temporary copy of the vector. Vectors
+* whose copy would exceed the limit are permuted in place by the calling
+* thread. The default limit is 1GiB.
+*
+* \param limit is the maximum amount of temporary memory, expressed in bytes
+*/
+void setReorderMemoryLimit(std::size_t limit)
+{
+    reorderMemoryLimit = limit;
+}
+
+/*!
+* \ingroup common_misc
+*
+* Gets the maximum amount of temporary memory that can be used for permuting
+* a vector out of place.
+*
+* \result The maximum amount of temporary memory, expressed in bytes, that
+* can be used for permuting a vector out of place.
+*/
+std::size_t getReorderMemoryLimit()
+{
+    return reorderMemoryLimit;
+}
+
 /*!
 * \ingroup common_misc
 *
@@ -30,6 +30,7 @@
 #include <array>
 #include <algorithm>
 #include <cfloat>
+#include <climits>
 #include <cmath>
 #include <functional>
 #include <limits>
@@ -39,6 +40,11 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "threadUtils.hpp"
 
 // Stringification macro
 #define BITPIT_STR2(X) #X
@@ -100,6 +106,15 @@ void reorderVector(std::vector<size_t>& order, std::vector<T>& v, std::size_t si
 template<typename OrderContainer, typename DataContainer>
 void reorderContainer(OrderContainer &order, DataContainer &v, std::size_t size);
 
+void setReorderMemoryLimit(std::size_t limit);
+std::size_t getReorderMemoryLimit();
+
+template<typename T, typename Allocator>
+void permuteVector(const std::vector<std::size_t> &order, std::vector<T, Allocator> &v, std::size_t size, std::size_t blockSize = 1);
+
+template<typename Allocator>
+void permuteVector(const std::vector<std::size_t> &order, std::vector<bool, Allocator> &v, std::size_t size, std::size_t blockSize = 1);
+
 template<typename Container, typename Index>
 void swapValue(Container &v, Index i, Index j);
 
@@ -112,6 +127,24 @@ void eraseValue(std::vector<T> &, const T&);
 template <class T>
 std::vector<T> intersectionVector(const std::vector<T>&, const std::vector<T>&);
 
+template<typename T, typename Allocator>
+std::size_t getMemoryUsage(const std::vector<T, Allocator> &container);
+
+template<typename Allocator>
+std::size_t getMemoryUsage(const std::vector<bool, Allocator> &container);
+
+template<typename Key, typename T, typename Compare, typename Allocator>
+std::size_t getMemoryUsage(const std::map<Key, T, Compare, Allocator> &container);
+
+template<typename Key, typename Compare, typename Allocator>
+std::size_t getMemoryUsage(const std::set<Key, Compare, Allocator> &container);
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+std::size_t getMemoryUsage(const std::unordered_map<Key, T, Hash, KeyEqual, Allocator> &container);
+
+template<typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::size_t getMemoryUsage(const std::unordered_set<Key, Hash, KeyEqual, Allocator> &container);
+
 #ifndef __BITPIT_COMMON_UTILS_SRC__
 extern template bool addToOrderedVector<>(const long&, std::vector<long>&, std::less<long>);
 extern template bool addToOrderedVector<>(const unsigned long&, std::vector<unsigned long>&, std::less<unsigned long>);
@@ -140,6 +140,108 @@ void reorderContainer(OrderContainer &order, DataContainer &v, std::size_t size)
     }
 }
 
+/*!
+* \ingroup common_misc
+*
+* Permute a vector according to a reordering vector.
+*
+* Values are grouped in blocks of the specified size, after the permutation
+* the i-th block of the vector will contain the block that was in position
+* order[i] before the permutation. Only the first size blocks are permuted.
+*
+* If the memory needed by a copy of the permuted blocks doesn't exceed the
+* limit returned by getReorderMemoryLimit(), the blocks are gathered into a
+* new vector and the gather is performed concurrently by the threads
+* available to the process. Otherwise, the blocks are permuted in place
+* following the cycles of the permutation, the only temporary memory used
+* is a copy of the reordering vector.
+*
+* \tparam T is the type of data that needs to be permuted
+* \param order is the reordering vector
+* \param v is a reference to the vector that will be permuted
+* \param size is the number of blocks that will be permuted
+* \param blockSize is the number of values in a block
+*/
+template<typename T, typename Allocator>
+void permuteVector(const std::vector<std::size_t> &order, std::vector<T, Allocator> &v, std::size_t size, std::size_t blockSize)
+{
+    static const std::size_t MIN_CHUNK_SIZE = 16384;
+
+    if (size == 0 || blockSize == 0) {
+        return;
+    }
+
+    // In-place permutation
+    //
+    // Memory is bounded: blocks are swapped following the cycles of the
+    // permutation.
+    std::size_t nValues = size * blockSize;
+    if (nValues * sizeof(T) > getReorderMemoryLimit()) {
+        std::vector<std::size_t> cycleOrder(order.begin(), order.begin() + size);
+        for (std::size_t i = 0; i < size; i++) {
+            std::size_t j;
+            while (i != (j = cycleOrder[i])) {
+                std::size_t k = cycleOrder[j];
+
+                std::swap_ranges(v.begin() + j * blockSize, v.begin() + (j + 1) * blockSize, v.begin() + k * blockSize);
+                std::swap(cycleOrder[i], cycleOrder[j]);
+            }
+        }
+
+        return;
+    }
+
+    // Out-of-place permutation
+    //
+    // The permuted blocks are gathered into a new vector, blocks are split
+    // in chunks that are gathered concurrently.
+    std::vector<T, Allocator> permuted(v.size());
+
+    std::size_t nChunks = std::max(std::min(static_cast<std::size_t>(threads::getThreadCount()), size / MIN_CHUNK_SIZE), std::size_t(1));
+    threads::parallelFor(nChunks, [&order, &v, &permuted, size, blockSize, nChunks](std::size_t chunk) {
+        std::size_t chunkBegin = (size * chunk) / nChunks;
+        std::size_t chunkEnd   = (size * (chunk + 1)) / nChunks;
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            auto sourceBegin = v.begin() + order[i] * blockSize;
+            std::move(sourceBegin, sourceBegin + blockSize, permuted.begin() + i * blockSize);
+        }
+    });
+
+    std::move(v.begin() + nValues, v.end(), permuted.begin() + nValues);
+
+    v.swap(permuted);
+}
+
+/*!
+* \ingroup common_misc
+*
+* Permute a vector of booleans according to a reordering vector.
+*
+* Values of a vector of booleans cannot be updated concurrently, hence the
+* values are always permuted in place by the calling thread.
+*
+* \param order is the reordering vector
+* \param v is a reference to the vector that will be permuted
+* \param size is the number of blocks that will be permuted
+* \param blockSize is the number of values in a block
+*/
+template<typename Allocator>
+void permuteVector(const std::vector<std::size_t> &order, std::vector<bool, Allocator> &v, std::size_t size, std::size_t blockSize)
+{
+    std::vector<std::size_t> cycleOrder(order.begin(), order.begin() + size);
+    for (std::size_t i = 0; i < size; i++) {
+        std::size_t j;
+        while (i != (j = cycleOrder[i])) {
+            std::size_t k = cycleOrder[j];
+
+            for (std::size_t n = 0; n < blockSize; ++n) {
+                v.swap(v[j * blockSize + n], v[k * blockSize + n]);
+            }
+            std::swap(cycleOrder[i], cycleOrder[j]);
+        }
+    }
+}
+
 /*!
 * \ingroup common_misc
 *
@@ -204,6 +306,134 @@ std::vector<T> intersectionVector(const std::vector<T> &vec_1, const std::vector
     return intersect;
 }
 
+/*!
+* \ingroup common_misc
+*
+* Evaluates the memory allocated by the specified vector.
+*
+* The evaluation is shallow: the memory occupied by the vector object itself
+* and the memory dynamically allocated by the elements are not included.
+*
+* \param[in] container is the vector
+* \result The memory, expressed in bytes, allocated by the vector.
+*/
+template<typename T, typename Allocator>
+std::size_t getMemoryUsage(const std::vector<T, Allocator> &container)
+{
+    return container.capacity() * sizeof(T);
+}
+
+/*!
+* \ingroup common_misc
+*
+* Evaluates the memory allocated by the specified boolean vector.
+*
+* The evaluation is shallow: the memory occupied by the vector object itself
+* is not included.
+*
+* \param[in] container is the vector
+* \result The memory, expressed in bytes, allocated by the vector.
+*/
+template<typename Allocator>
+std::size_t getMemoryUsage(const std::vector<bool, Allocator> &container)
+{
+    return (container.capacity() + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+/*!
+* \ingroup common_misc
+*
+* Evaluates the memory allocated by the specified map.
+*
+* The memory allocated by the map cannot be accessed directly, it is
+* estimated assuming that each element is stored in a tree node that
+* contains three pointers and the color of the node.
+*
+* The evaluation is shallow: the memory occupied by the map object itself
+* and the memory dynamically allocated by the elements are not included.
+*
+* \param[in] container is the map
+* \result The estimated memory, expressed in bytes, allocated by the map.
+*/
+template<typename Key, typename T, typename Compare, typename Allocator>
+std::size_t getMemoryUsage(const std::map<Key, T, Compare, Allocator> &container)
+{
+    const std::size_t NODE_SIZE = 4 * sizeof(void *) + sizeof(typename std::map<Key, T, Compare, Allocator>::value_type);
+
+    return container.size() * NODE_SIZE;
+}
+
+/*!
+* \ingroup common_misc
+*
+* Evaluates the memory allocated by the specified set.
+*
+* The memory allocated by the set cannot be accessed directly, it is
+* estimated assuming that each element is stored in a tree node that
+* contains three pointers and the color of the node.
+*
+* The evaluation is shallow: the memory occupied by the set object itself
+* and the memory dynamically allocated by the elements are not included.
+*
+* \param[in] container is the set
+* \result The estimated memory, expressed in bytes, allocated by the set.
+*/
+template<typename Key, typename Compare, typename Allocator>
+std::size_t getMemoryUsage(const std::set<Key, Compare, Allocator> &container)
+{
+    const std::size_t NODE_SIZE = 4 * sizeof(void *) + sizeof(Key);
+
+    return container.size() * NODE_SIZE;
+}
+
+/*!
+* \ingroup common_misc
+*
+* Evaluates the memory allocated by the specified unordered map.
+*
+* The memory allocated by the map cannot be accessed directly, it is
+* estimated assuming that the map contains an array of bucket pointers
+* and that each element is stored in a node that contains a pointer to
+* the next node and the hash of the element.
+*
+* The evaluation is shallow: the memory occupied by the map object itself
+* and the memory dynamically allocated by the elements are not included.
+*
+* \param[in] container is the map
+* \result The estimated memory, expressed in bytes, allocated by the map.
+*/
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+std::size_t getMemoryUsage(const std::unordered_map<Key, T, Hash, KeyEqual, Allocator> &container)
+{
+    const std::size_t NODE_SIZE = sizeof(void *) + sizeof(std::size_t) + sizeof(typename std::unordered_map<Key, T, Hash, KeyEqual, Allocator>::value_type);
+
+    return (container.bucket_count() * sizeof(void *) + container.size() * NODE_SIZE);
+}
+
+/*!
+* \ingroup common_misc
+*
+* Evaluates the memory allocated by the specified unordered set.
+*
+* The memory allocated by the set cannot be accessed directly, it is
+* estimated assuming that the set contains an array of bucket pointers
+* and that each element is stored in a node that contains a pointer to
+* the next node and the hash of the element.
+*
+* The evaluation is shallow: the memory occupied by the set object itself
+* and the memory dynamically allocated by the elements are not included.
+*
+* \param[in] container is the set
+* \result The estimated memory, expressed in bytes, allocated by the set.
+*/
+template<typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::size_t getMemoryUsage(const std::unordered_set<Key, Hash, KeyEqual, Allocator> &container)
+{
+    const std::size_t NODE_SIZE = sizeof(void *) + sizeof(std::size_t) + sizeof(Key);
+
+    return (container.bucket_count() * sizeof(void *) + container.size() * NODE_SIZE);
+}
+
 /*!
 * \ingroup common_misc
 *
@@ -0,0 +1,137 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "memoryUtils.hpp"
+
+namespace bitpit {
+
+namespace utils {
+
+namespace memory {
+
+/*!
+* \ingroup common_memory
+*
+* Checks if the specified pointer is aligned to the given boundary.
+*
+* \param pointer is the pointer that will be checked
+* \param alignment is the alignment, expressed in bytes
+* \result Returns true if the pointer is aligned to the given boundary,
+* false otherwise.
+*/
+bool isAligned(const void *pointer, std::size_t alignment)
+{
+    return (reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0);
+}
+
+/*!
+* \ingroup common_memory
+*
+* Allocates a buffer backed by huge pages.
+*
+* The buffer is mapped directly from the operating system, it is aligned to
+* the size of a huge page and its size is rounded up to a multiple of that
+* size. On Linux, the system is advised to back the buffer with transparent
+* huge pages; whether the advice is followed depends on the configuration
+* of the system. On other systems, the buffer is just aligned to the size
+* of a huge page.
+*
+* Memory mapped from the operating system is zero-initialized and is
+* physically allocated only when it is first written.
+*
+* \param size is the size, expressed in bytes, of the buffer
+* \result A pointer to the allocated buffer.
+*/
+void * allocateHugePages(std::size_t size)
+{
+#if defined(__linux__)
+    std::size_t mappedSize = ((size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+
+    // Map the region
+    //
+    // The system only guarantees that the region is aligned to the size of
+    // a regular page. An additional huge page is mapped and the portions of
+    // the region outside the aligned buffer are then released.
+    void *region = mmap(nullptr, mappedSize + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    std::uintptr_t regionAddress = reinterpret_cast<std::uintptr_t>(region);
+    std::uintptr_t bufferAddress = ((regionAddress + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+
+    std::size_t headSize = bufferAddress - regionAddress;
+    if (headSize > 0) {
+        munmap(region, headSize);
+    }
+
+    std::size_t tailSize = HUGE_PAGE_SIZE - headSize;
+    if (tailSize > 0) {
+        munmap(reinterpret_cast<void *>(bufferAddress + mappedSize), tailSize);
+    }
+
+    void *buffer = reinterpret_cast<void *>(bufferAddress);
+
+    // Request huge pages
+#if defined(MADV_HUGEPAGE)
+    madvise(buffer, mappedSize, MADV_HUGEPAGE);
+#endif
+
+    return buffer;
+#else
+    return ::operator new(size, std::align_val_t(HUGE_PAGE_SIZE));
+#endif
+}
+
+/*!
+* \ingroup common_memory
+*
+* Deallocates a buffer allocated by allocateHugePages.
+*
+* \param pointer is the pointer to the buffer
+* \param size is the size, expressed in bytes, the buffer was allocated with
+*/
+void deallocateHugePages(void *pointer, std::size_t size) noexcept
+{
+#if defined(__linux__)
+    std::size_t mappedSize = ((size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+    munmap(pointer, mappedSize);
+#else
+    BITPIT_UNUSED(size);
+
+    ::operator delete(pointer, std::align_val_t(HUGE_PAGE_SIZE));
+#endif
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,242 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#ifndef __BITPIT_COMMON_MEMORY_UTILS_HPP__
+#define __BITPIT_COMMON_MEMORY_UTILS_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "compiler.hpp"
+#include "threadUtils.hpp"
+
+namespace bitpit {
+
+namespace utils {
+
+/*!
+    \ingroup common_memory
+    \brief The namespace 'memory' contains routines and allocators for
+    controlling how memory is allocated.
+*/
+namespace memory {
+
+/*!
+    Alignment, expressed in bytes, suitable for vectorized loops.
+
+    The value matches the size of a cache line on most architectures and is
+    also a multiple of the width of all the common SIMD registers.
+*/
+constexpr std::size_t SIMD_ALIGNMENT = 64;
+
+/*!
+    \ingroup common_memory
+
+    \brief Allocator that returns memory aligned to the specified boundary.
+
+    The allocator can be used with standard containers to obtain buffers
+    whose first element is aligned to the specified boundary (e.g., for
+    passing the buffer to vectorized loops or BLAS routines).
+
+    \tparam T is the type of the elements that will be allocated
+    \tparam Alignment is the alignment, expressed in bytes, of the allocated
+    memory; it should be a power of two not smaller than the alignment of T
+*/
+template<typename T, std::size_t Alignment = SIMD_ALIGNMENT>
+class AlignedAllocator {
+
+static_assert((Alignment & (Alignment - 1)) == 0, "Alignment should be a power of two.");
+static_assert(Alignment >= alignof(T), "Alignment should not be smaller than the alignment of the type.");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    /*!
+        Allocator rebind
+    */
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &other) noexcept;
+
+    T * allocate(std::size_t n);
+    void deallocate(T *pointer, std::size_t n) noexcept;
+
+};
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &lhs, const AlignedAllocator<U, Alignment> &rhs) noexcept;
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &lhs, const AlignedAllocator<U, Alignment> &rhs) noexcept;
+
+/*!
+    Size, expressed in bytes, of the huge pages.
+
+    The value matches the size of the default huge pages on x86-64 and
+    aarch64 Linux systems.
+*/
+constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/*!
+    \ingroup common_memory
+
+    \brief Allocator that stores large buffers in huge pages.
+
+    Buffers whose size is at least HUGE_PAGE_SIZE are mapped directly from
+    the operating system, aligned to the size of a huge page, and the system
+    is advised to back them with transparent huge pages. Huge pages reduce
+    the number of TLB misses when traversing large buffers (e.g., the cells
+    or the vertices of a large patch). Since large buffers are not taken
+    from the heap, they are returned to the system when deallocated and
+    repeatedly growing and releasing them will not fragment the heap.
+    Smaller buffers are allocated using the standard allocator.
+
+    Objects are constructed as with the standard allocator, hence resizing
+    a container value-initializes the new elements. Containers that should
+    leave their trivial elements uninitialized, for example to initialize
+    them afterwards with firstTouch, can use DefaultInitAllocator.
+
+    Huge pages are only requested on Linux, on other systems large buffers
+    are just aligned to the size of a huge page.
+
+    \tparam T is the type of the elements that will be allocated
+*/
+template<typename T>
+class HugePageAllocator {
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    /*!
+        Allocator rebind
+    */
+    template<typename U>
+    struct rebind {
+        typedef HugePageAllocator<U> other;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U> &other) noexcept;
+
+    T * allocate(std::size_t n);
+    void deallocate(T *pointer, std::size_t n) noexcept;
+
+};
+
+template<typename T, typename U>
+bool operator==(const HugePageAllocator<T> &lhs, const HugePageAllocator<U> &rhs) noexcept;
+
+template<typename T, typename U>
+bool operator!=(const HugePageAllocator<T> &lhs, const HugePageAllocator<U> &rhs) noexcept;
+
+/*!
+    \ingroup common_memory
+
+    \brief Allocator adaptor that default-initializes the objects constructed
+    without arguments.
+
+    Storage is allocated by the adapted allocator. Objects constructed
+    without arguments are default-initialized, hence trivial objects are
+    not written when a container is resized and their value is undefined
+    until they are explicitly set. This allows to initialize large buffers
+    afterwards with firstTouch. Objects constructed with arguments are
+    constructed by the adapted allocator.
+
+    \tparam T is the type of the elements that will be allocated
+    \tparam Allocator is the allocator that will be adapted
+*/
+template<typename T, typename Allocator = HugePageAllocator<T>>
+class DefaultInitAllocator : public Allocator {
+
+static_assert(std::is_same<typename std::allocator_traits<Allocator>::value_type, T>::value,
+              "The adapted allocator should allocate objects of the same type");
+
+public:
+    /*!
+        Allocator rebind
+    */
+    template<typename U>
+    struct rebind {
+        typedef DefaultInitAllocator<U, typename std::allocator_traits<Allocator>::template rebind_alloc<U>> other;
+    };
+
+    DefaultInitAllocator() = default;
+
+    template<typename U, typename U_Allocator>
+    DefaultInitAllocator(const DefaultInitAllocator<U, U_Allocator> &other);
+
+    template<typename U>
+    void construct(U *pointer) noexcept(std::is_nothrow_default_constructible<U>::value);
+
+    template<typename U, typename... Args>
+    void construct(U *pointer, Args&&... args);
+
+};
+
+template<typename T, typename T_Allocator, typename U, typename U_Allocator>
+bool operator==(const DefaultInitAllocator<T, T_Allocator> &lhs, const DefaultInitAllocator<U, U_Allocator> &rhs) noexcept;
+
+template<typename T, typename T_Allocator, typename U, typename U_Allocator>
+bool operator!=(const DefaultInitAllocator<T, T_Allocator> &lhs, const DefaultInitAllocator<U, U_Allocator> &rhs) noexcept;
+
+bool isAligned(const void *pointer, std::size_t alignment);
+
+void * allocateHugePages(std::size_t size);
+void deallocateHugePages(void *pointer, std::size_t size) noexcept;
+
+template<typename T>
+void firstTouch(T *data, std::size_t n, const T &value);
+
+}
+
+}
+
+}
+
+// Include template implementations
+#include "memoryUtils.tpp"
+
+#endif
@@ -0,0 +1,307 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#ifndef __BITPIT_COMMON_MEMORY_UTILS_TPP__
+#define __BITPIT_COMMON_MEMORY_UTILS_TPP__
+
+namespace bitpit {
+
+namespace utils {
+
+namespace memory {
+
+/*!
+* Copy constructor from an allocator of another type.
+*
+* Aligned allocators are stateless, hence there is nothing to copy.
+*
+* \param other is the allocator that will be copied
+*/
+template<typename T, std::size_t Alignment>
+template<typename U>
+AlignedAllocator<T, Alignment>::AlignedAllocator(const AlignedAllocator<U, Alignment> &other) noexcept
+{
+    BITPIT_UNUSED(other);
+}
+
+/*!
+* Allocates uninitialized storage for the specified number of elements.
+*
+* \param n is the number of elements for which storage will be allocated
+* \result A pointer to the first element of the allocated storage, the
+* pointer is aligned to the alignment of the allocator.
+*/
+template<typename T, std::size_t Alignment>
+T * AlignedAllocator<T, Alignment>::allocate(std::size_t n)
+{
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+}
+
+/*!
+* Deallocates the storage referenced by the specified pointer.
+*
+* \param pointer is the pointer to the storage that will be deallocated, it
+* should have been obtained by a call to allocate
+* \param n is the number of elements the storage was allocated for
+*/
+template<typename T, std::size_t Alignment>
+void AlignedAllocator<T, Alignment>::deallocate(T *pointer, std::size_t n) noexcept
+{
+    BITPIT_UNUSED(n);
+
+    ::operator delete(pointer, std::align_val_t(Alignment));
+}
+
+/*!
+* Compares two aligned allocators.
+*
+* Aligned allocators are stateless, hence memory allocated by one of them
+* can be deallocated by any other with the same alignment.
+*
+* \param lhs is the first allocator
+* \param rhs is the second allocator
+* \result Always returns true.
+*/
+template<typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &lhs, const AlignedAllocator<U, Alignment> &rhs) noexcept
+{
+    BITPIT_UNUSED(lhs);
+    BITPIT_UNUSED(rhs);
+
+    return true;
+}
+
+/*!
+* Compares two aligned allocators.
+*
+* \param lhs is the first allocator
+* \param rhs is the second allocator
+* \result Always returns false.
+*/
+template<typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &lhs, const AlignedAllocator<U, Alignment> &rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/*!
+* Copy constructor from an allocator of another type.
+*
+* Huge page allocators are stateless, hence there is nothing to copy.
+*
+* \param other is the allocator that will be copied
+*/
+template<typename T>
+template<typename U>
+HugePageAllocator<T>::HugePageAllocator(const HugePageAllocator<U> &other) noexcept
+{
+    BITPIT_UNUSED(other);
+}
+
+/*!
+* Allocates uninitialized storage for the specified number of elements.
+*
+* \param n is the number of elements for which storage will be allocated
+* \result A pointer to the first element of the allocated storage.
+*/
+template<typename T>
+T * HugePageAllocator<T>::allocate(std::size_t n)
+{
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    std::size_t size = n * sizeof(T);
+    if (size < HUGE_PAGE_SIZE) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    return static_cast<T *>(allocateHugePages(size));
+}
+
+/*!
+* Deallocates the storage referenced by the specified pointer.
+*
+* \param pointer is the pointer to the storage that will be deallocated, it
+* should have been obtained by a call to allocate
+* \param n is the number of elements the storage was allocated for
+*/
+template<typename T>
+void HugePageAllocator<T>::deallocate(T *pointer, std::size_t n) noexcept
+{
+    std::size_t size = n * sizeof(T);
+    if (size < HUGE_PAGE_SIZE) {
+        std::allocator<T>().deallocate(pointer, n);
+        return;
+    }
+
+    deallocateHugePages(pointer, size);
+}
+
+/*!
+* Compares two huge page allocators.
+*
+* Huge page allocators are stateless, hence memory allocated by one of them
+* can be deallocated by any other.
+*
+* \param lhs is the first allocator
+* \param rhs is the second allocator
+* \result Always returns true.
+*/
+template<typename T, typename U>
+bool operator==(const HugePageAllocator<T> &lhs, const HugePageAllocator<U> &rhs) noexcept
+{
+    BITPIT_UNUSED(lhs);
+    BITPIT_UNUSED(rhs);
+
+    return true;
+}
+
+/*!
+* Compares two huge page allocators.
+*
+* \param lhs is the first allocator
+* \param rhs is the second allocator
+* \result Always returns false.
+*/
+template<typename T, typename U>
+bool operator!=(const HugePageAllocator<T> &lhs, const HugePageAllocator<U> &rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/*!
+* Copy constructor from an adaptor of another type.
+*
+* \param other is the allocator that will be copied
+*/
+template<typename T, typename Allocator>
+template<typename U, typename U_Allocator>
+DefaultInitAllocator<T, Allocator>::DefaultInitAllocator(const DefaultInitAllocator<U, U_Allocator> &other)
+    : Allocator(static_cast<const U_Allocator &>(other))
+{
+}
+
+/*!
+* Default-initializes an object in the specified storage.
+*
+* Trivial objects are left uninitialized, hence their memory is not
+* touched.
+*
+* \param pointer is the pointer to the storage of the object
+*/
+template<typename T, typename Allocator>
+template<typename U>
+void DefaultInitAllocator<T, Allocator>::construct(U *pointer) noexcept(std::is_nothrow_default_constructible<U>::value)
+{
+    ::new(static_cast<void *>(pointer)) U;
+}
+
+/*!
+* Constructs an object in the specified storage using the adapted allocator.
+*
+* \param pointer is the pointer to the storage of the object
+* \param args are the arguments that will be forwarded to the constructor
+*/
+template<typename T, typename Allocator>
+template<typename U, typename... Args>
+void DefaultInitAllocator<T, Allocator>::construct(U *pointer, Args&&... args)
+{
+    std::allocator_traits<Allocator>::construct(static_cast<Allocator &>(*this), pointer, std::forward<Args>(args)...);
+}
+
+/*!
+* Compares two default-initializing adaptors.
+*
+* The adaptors are equal if the adapted allocators are equal.
+*
+* \param lhs is the first allocator
+* \param rhs is the second allocator
+* \result Returns true if the adapted allocators are equal, false otherwise.
+*/
+template<typename T, typename T_Allocator, typename U, typename U_Allocator>
+bool operator==(const DefaultInitAllocator<T, T_Allocator> &lhs, const DefaultInitAllocator<U, U_Allocator> &rhs) noexcept
+{
+    return (static_cast<const T_Allocator &>(lhs) == static_cast<const U_Allocator &>(rhs));
+}
+
+/*!
+* Compares two default-initializing adaptors.
+*
+* \param lhs is the first allocator
+* \param rhs is the second allocator
+* \result Returns true if the adapted allocators are different, false
+* otherwise.
+*/
+template<typename T, typename T_Allocator, typename U, typename U_Allocator>
+bool operator!=(const DefaultInitAllocator<T, T_Allocator> &lhs, const DefaultInitAllocator<U, U_Allocator> &rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/*!
+* \ingroup common_memory
+*
+* Initializes a buffer using all the threads available to the process.
+*
+* On NUMA systems, the operating system usually places a memory page in the
+* domain of the thread that first writes to it. A buffer initialized by a
+* single thread is therefore entirely placed in the domain of that thread
+* and, when it is later processed by multiple threads, most of them will
+* access remote memory. This function splits the buffer in one chunk for
+* each thread and lets the threads initialize the chunks concurrently, in
+* this way the pages of the buffer are spread among the domains the threads
+* run on. The buffer should not have been written before (e.g., it should
+* belong to a container that uses a DefaultInitAllocator, that doesn't
+* initialize trivial objects).
+*
+* The placement is effective only if the threads are bound to the cores
+* (e.g., setting OMP_PROC_BIND) and if the loops that process the buffer
+* split it in the same chunks.
+*
+* \param data is a pointer to the buffer
+* \param n is the number of elements of the buffer
+* \param value is the value the elements will be initialized with
+*/
+template<typename T>
+void firstTouch(T *data, std::size_t n, const T &value)
+{
+    std::size_t nChunks = std::max(std::min(static_cast<std::size_t>(threads::getThreadCount()), n), std::size_t(1));
+    threads::parallelFor(nChunks, [data, n, nChunks, &value](std::size_t chunk) {
+        std::size_t chunkBegin = (n * chunk) / nChunks;
+        std::size_t chunkEnd   = (n * (chunk + 1)) / nChunks;
+        std::fill(data + chunkBegin, data + chunkEnd, value);
+    });
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,344 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "compiler.hpp"
+#include "sfcUtils.hpp"
+#include "threadUtils.hpp"
+
+namespace bitpit {
+
+namespace utils {
+
+namespace sfc {
+
+namespace {
+
+/*!
+    Spreads the lowest 21 bits of the specified value, inserting two zero
+    bits between each bit of the value.
+
+    \param value is the value
+    \result The spread value.
+*/
+uint64_t spreadBits(uint32_t value)
+{
+    uint64_t x = value & 0x1fffff;
+    x = (x | (x << 32)) & 0x001f00000000ffff;
+    x = (x | (x << 16)) & 0x001f0000ff0000ff;
+    x = (x | (x <<  8)) & 0x100f00f00f00f00f;
+    x = (x | (x <<  4)) & 0x10c30c30c30c30c3;
+    x = (x | (x <<  2)) & 0x1249249249249249;
+
+    return x;
+}
+
+/*!
+    Computes the Hilbert key of the specified integer coordinates.
+
+    The key is evaluated using the algorithm described by J. Skilling in
+    "Programming the Hilbert curve" (AIP Conference Proceedings 707, 2004):
+    the coordinates are converted in place into the "transposed" Hilbert
+    index, whose bits are then interleaved.
+
+    \param nDimensions is the number of dimensions
+    \param coords are the integer coordinates, on output they will contain
+    the transposed Hilbert index
+    \result The Hilbert key of the specified integer coordinates.
+*/
+uint64_t evalHilbertKey(int nDimensions, uint32_t *coords)
+{
+    const uint32_t highestBit = uint32_t(1) << (KEY_BITS_PER_COORDINATE - 1);
+
+    // Inverse undo
+    for (uint32_t q = highestBit; q > 1; q >>= 1) {
+        uint32_t p = q - 1;
+        for (int i = 0; i < nDimensions; ++i) {
+            if (coords[i] & q) {
+                coords[0] ^= p;
+            } else {
+                uint32_t t = (coords[0] ^ coords[i]) & p;
+                coords[0] ^= t;
+                coords[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for (int i = 1; i < nDimensions; ++i) {
+        coords[i] ^= coords[i - 1];
+    }
+
+    uint32_t t = 0;
+    for (uint32_t q = highestBit; q > 1; q >>= 1) {
+        if (coords[nDimensions - 1] & q) {
+            t ^= q - 1;
+        }
+    }
+
+    for (int i = 0; i < nDimensions; ++i) {
+        coords[i] ^= t;
+    }
+
+    // Interleave the bits of the transposed index
+    uint64_t key = 0;
+    for (int b = KEY_BITS_PER_COORDINATE - 1; b >= 0; --b) {
+        for (int i = 0; i < nDimensions; ++i) {
+            key = (key << 1) | ((coords[i] >> b) & 1);
+        }
+    }
+
+    return key;
+}
+
+/*!
+    Maps the specified points onto a uniform integer grid that covers their
+    bounding box and evaluates the keys of the points using the given
+    function.
+
+    Degenerate directions of the bounding box are discarded: the function
+    that evaluates the keys will receive in input the number of directions
+    that are not degenerate and the integer coordinates of the point along
+    those directions.
+
+    \param nPoints is the number of points
+    \param points are the points
+    \param evalKey is the function that will be used to evaluate the keys
+    \param[out] keys on output will contain the keys of the points
+*/
+template<typename KeyFunction>
+void computeKeys(std::size_t nPoints, const std::array<double, 3> *points, KeyFunction evalKey, uint64_t *keys)
+{
+    if (nPoints == 0) {
+        return;
+    }
+
+    // Bounding box of the points
+    std::array<double, 3> boxMin;
+    std::array<double, 3> boxMax;
+    boxMin.fill(std::numeric_limits<double>::max());
+    boxMax.fill(-std::numeric_limits<double>::max());
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        for (int d = 0; d < 3; ++d) {
+            boxMin[d] = std::min(boxMin[d], points[i][d]);
+            boxMax[d] = std::max(boxMax[d], points[i][d]);
+        }
+    }
+
+    // Scale factors
+    const double maxCoordinate = static_cast<double>((uint32_t(1) << KEY_BITS_PER_COORDINATE) - 1);
+
+    int nDimensions = 0;
+    std::array<int, 3> directions;
+    std::array<double, 3> scale;
+    for (int d = 0; d < 3; ++d) {
+        double length = boxMax[d] - boxMin[d];
+        if (length > 0.) {
+            directions[nDimensions] = d;
+            scale[nDimensions] = maxCoordinate / length;
+            ++nDimensions;
+        }
+    }
+
+    // Evaluate the keys
+    static const std::size_t CHUNK_SIZE = 4096;
+    std::size_t nChunks = (nPoints + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    threads::parallelFor(nChunks, [&](std::size_t chunk) {
+        std::size_t chunkBegin = chunk * CHUNK_SIZE;
+        std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nPoints);
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            std::array<uint32_t, 3> coords = {{0, 0, 0}};
+            for (int n = 0; n < nDimensions; ++n) {
+                int d = directions[n];
+                double scaled = std::floor((points[i][d] - boxMin[d]) * scale[n]);
+                coords[n] = static_cast<uint32_t>(std::min(std::max(scaled, 0.), maxCoordinate));
+            }
+
+            keys[i] = evalKey(nDimensions, coords.data());
+        }
+    });
+}
+
+/*!
+    Sorts the specified keys.
+
+    Keys with the same value are ordered by their index.
+
+    \param nKeys is the number of keys
+    \param keys are the keys
+    \param[out] order on output will contain the indices of the sorted keys
+*/
+void computeOrder(std::size_t nKeys, const uint64_t *keys, std::vector<std::size_t> *order)
+{
+    std::vector<std::pair<uint64_t, std::size_t>> sortedKeys(nKeys);
+    for (std::size_t i = 0; i < nKeys; ++i) {
+        sortedKeys[i] = std::make_pair(keys[i], i);
+    }
+    threads::parallelSort(sortedKeys.begin(), sortedKeys.end());
+
+    order->resize(nKeys);
+    for (std::size_t i = 0; i < nKeys; ++i) {
+        (*order)[i] = sortedKeys[i].second;
+    }
+}
+
+}
+
+/*!
+    \ingroup common_sfc
+
+    Computes the Morton key of the specified integer coordinates.
+
+    Only the lowest KEY_BITS_PER_COORDINATE bits of each coordinate are
+    encoded.
+
+    \param x is the x coordinate
+    \param y is the y coordinate
+    \param z is the z coordinate
+    \result The Morton key of the specified integer coordinates.
+*/
+uint64_t computeMortonKey(uint32_t x, uint32_t y, uint32_t z)
+{
+    return (spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2));
+}
+
+/*!
+    \ingroup common_sfc
+
+    Computes the Morton keys of the specified points.
+
+    Points are mapped onto a uniform integer grid that covers their
+    bounding box. Degenerate directions of the bounding box are discarded,
+    the remaining directions are mapped onto the first coordinates of the
+    key.
+
+    \param nPoints is the number of points
+    \param points are the points
+    \param[out] keys on output will contain the Morton keys of the points,
+    the array should be able to contain nPoints keys
+*/
+void computeMortonKeys(std::size_t nPoints, const std::array<double, 3> *points, uint64_t *keys)
+{
+    computeKeys(nPoints, points, [](int nDimensions, const uint32_t *coords) {
+        BITPIT_UNUSED(nDimensions);
+
+        return computeMortonKey(coords[0], coords[1], coords[2]);
+    }, keys);
+}
+
+/*!
+    \ingroup common_sfc
+
+    Evaluates the order of the specified points along the Morton curve
+    that covers their bounding box.
+
+    Points with the same Morton key are ordered by their index.
+
+    \param nPoints is the number of points
+    \param points are the points
+    \param[out] order on output will contain the indices of the points
+    sorted along the Morton curve
+*/
+void computeMortonOrder(std::size_t nPoints, const std::array<double, 3> *points, std::vector<std::size_t> *order)
+{
+    std::vector<uint64_t> keys(nPoints);
+    computeMortonKeys(nPoints, points, keys.data());
+
+    computeOrder(nPoints, keys.data(), order);
+}
+
+/*!
+    \ingroup common_sfc
+
+    Computes the Hilbert key of the specified integer coordinates.
+
+    Only the lowest KEY_BITS_PER_COORDINATE bits of each coordinate are
+    encoded.
+
+    \param x is the x coordinate
+    \param y is the y coordinate
+    \param z is the z coordinate
+    \result The Hilbert key of the specified integer coordinates.
+*/
+uint64_t computeHilbertKey(uint32_t x, uint32_t y, uint32_t z)
+{
+    const uint32_t mask = (uint32_t(1) << KEY_BITS_PER_COORDINATE) - 1;
+
+    std::array<uint32_t, 3> coords = {{x & mask, y & mask, z & mask}};
+
+    return evalHilbertKey(3, coords.data());
+}
+
+/*!
+    \ingroup common_sfc
+
+    Computes the Hilbert keys of the specified points.
+
+    Points are mapped onto a uniform integer grid that covers their
+    bounding box. Degenerate directions of the bounding box are discarded,
+    hence points lying on a plane are ordered along a two-dimensional
+    Hilbert curve.
+
+    \param nPoints is the number of points
+    \param points are the points
+    \param[out] keys on output will contain the Hilbert keys of the points,
+    the array should be able to contain nPoints keys
+*/
+void computeHilbertKeys(std::size_t nPoints, const std::array<double, 3> *points, uint64_t *keys)
+{
+    computeKeys(nPoints, points, [](int nDimensions, uint32_t *coords) {
+        return evalHilbertKey(nDimensions, coords);
+    }, keys);
+}
+
+/*!
+    \ingroup common_sfc
+
+    Evaluates the order of the specified points along the Hilbert curve
+    that covers their bounding box.
+
+    Points with the same Hilbert key are ordered by their index.
+
+    \param nPoints is the number of points
+    \param points are the points
+    \param[out] order on output will contain the indices of the points
+    sorted along the Hilbert curve
+*/
+void computeHilbertOrder(std::size_t nPoints, const std::array<double, 3> *points, std::vector<std::size_t> *order)
+{
+    std::vector<uint64_t> keys(nPoints);
+    computeHilbertKeys(nPoints, points, keys.data());
+
+    computeOrder(nPoints, keys.data(), order);
+}
+
+}
+
+}
+
+}
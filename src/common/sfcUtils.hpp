@@ -0,0 +1,65 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_COMMON_SFC_UTILS_HPP__
+#define __BITPIT_COMMON_SFC_UTILS_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bitpit {
+
+namespace utils {
+
+/*!
+    \ingroup common_sfc
+    \brief The namespace 'sfc' contains routines for sorting points along
+    space-filling curves.
+*/
+namespace sfc {
+
+/*!
+    Number of bits used for encoding each coordinate.
+*/
+const int KEY_BITS_PER_COORDINATE = 21;
+
+uint64_t computeMortonKey(uint32_t x, uint32_t y, uint32_t z);
+
+void computeMortonKeys(std::size_t nPoints, const std::array<double, 3> *points, uint64_t *keys);
+void computeMortonOrder(std::size_t nPoints, const std::array<double, 3> *points, std::vector<std::size_t> *order);
+
+uint64_t computeHilbertKey(uint32_t x, uint32_t y, uint32_t z);
+
+void computeHilbertKeys(std::size_t nPoints, const std::array<double, 3> *points, uint64_t *keys);
+void computeHilbertOrder(std::size_t nPoints, const std::array<double, 3> *points, std::vector<std::size_t> *order);
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,468 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#if BITPIT_ENABLE_OPENMP==1
+#include <omp.h>
+#endif
+
+#include "threadUtils.hpp"
+
+namespace bitpit {
+
+namespace utils {
+
+namespace threads {
+
+/*!
+    \class ThreadPool
+    \ingroup common_threads
+
+    \brief Pool of worker threads.
+*/
+
+/*!
+    Constructor.
+
+    \param nThreads is the number of threads that will process the tasks,
+    this number includes the calling thread, hence the pool will create
+    (nThreads - 1) worker threads
+*/
+ThreadPool::ThreadPool(int nThreads)
+    : m_terminate(false), m_generation(0), m_nBusyWorkers(0),
+      m_function(nullptr), m_nTasks(0), m_nextTask(0)
+{
+    int nWorkers = std::max(nThreads - 1, 0);
+    m_workers.reserve(nWorkers);
+    for (int i = 0; i < nWorkers; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/*!
+    Destructor.
+*/
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_terminate = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (std::thread &worker : m_workers) {
+        worker.join();
+    }
+}
+
+/*!
+    Gets the number of threads that will process the tasks.
+
+    \result The number of threads that will process the tasks, including
+    the calling thread.
+*/
+int ThreadPool::getThreadCount() const
+{
+    return static_cast<int>(m_workers.size() + 1);
+}
+
+/*!
+    Runs the specified function for all the tasks in the range [0, nTasks).
+
+    The function returns when all the tasks have been processed. If a task
+    throws an exception, the remaining tasks are skipped and the exception
+    is re-thrown by this function.
+
+    \param nTasks is the number of tasks
+    \param function is the function that will be called for each task
+*/
+void ThreadPool::run(std::size_t nTasks, const TaskFunction &function)
+{
+    // Wake up the workers
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_function  = &function;
+        m_nTasks    = nTasks;
+        m_nextTask  = 0;
+        m_exception = nullptr;
+
+        m_nBusyWorkers = static_cast<int>(m_workers.size());
+        ++m_generation;
+    }
+    m_wakeCondition.notify_all();
+
+    // The calling thread takes part to the processing
+    processTasks();
+
+    // Wait until all the workers have finished
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return (m_nBusyWorkers == 0); });
+
+        m_function = nullptr;
+        std::swap(exception, m_exception);
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+/*!
+    Main loop of the worker threads.
+*/
+void ThreadPool::workerLoop()
+{
+    std::size_t processedGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, processedGeneration] { return (m_terminate || m_generation != processedGeneration); });
+            if (m_terminate) {
+                return;
+            }
+
+            processedGeneration = m_generation;
+        }
+
+        processTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_nBusyWorkers;
+            if (m_nBusyWorkers == 0) {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+/*!
+    Process tasks until there are no more tasks available.
+*/
+void ThreadPool::processTasks()
+{
+    while (true) {
+        std::size_t task = m_nextTask.fetch_add(1);
+        if (task >= m_nTasks) {
+            break;
+        }
+
+        try {
+            (*m_function)(task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+            m_nextTask = m_nTasks;
+        }
+    }
+}
+
+namespace {
+
+/*!
+    Internal state of the threading facility.
+*/
+struct ThreadingState {
+    std::mutex mutex;
+    Backend backend;
+    int nThreads;
+    std::shared_ptr<ThreadPool> pool;
+
+    ThreadingState()
+    {
+#if BITPIT_ENABLE_OPENMP==1
+        backend  = BACKEND_OPENMP;
+        nThreads = omp_get_max_threads();
+#else
+        backend  = BACKEND_THREAD_POOL;
+        nThreads = 1;
+#endif
+
+        const char *envThreads = std::getenv("BITPIT_NUM_THREADS");
+        if (envThreads) {
+            nThreads = std::max(std::atoi(envThreads), 1);
+        }
+    }
+};
+
+/*!
+    Gets the internal state of the threading facility.
+
+    \result The internal state of the threading facility.
+*/
+ThreadingState & getState()
+{
+    static ThreadingState state;
+
+    return state;
+}
+
+/*!
+    Flag that tells if the current thread is processing a task.
+
+    Tasks run within another task are processed sequentially.
+*/
+thread_local bool insideTask = false;
+
+/*!
+    Guard that marks the current thread as processing a task.
+*/
+struct TaskGuard {
+    bool previous;
+
+    TaskGuard() : previous(insideTask)
+    {
+        insideTask = true;
+    }
+
+    ~TaskGuard()
+    {
+        insideTask = previous;
+    }
+};
+
+}
+
+/*!
+    \ingroup common_threads
+
+    Checks if the specified backend is available.
+
+    \param backend is the backend
+    \result Returns true if the specified backend is available, false
+    otherwise.
+*/
+bool isBackendAvailable(Backend backend)
+{
+    switch (backend) {
+
+    case BACKEND_SERIAL:
+    case BACKEND_THREAD_POOL:
+        return true;
+
+    case BACKEND_OPENMP:
+#if BITPIT_ENABLE_OPENMP==1
+        return true;
+#else
+        return false;
+#endif
+
+    default:
+        return false;
+
+    }
+}
+
+/*!
+    \ingroup common_threads
+
+    Sets the backend used for running the tasks.
+
+    \param backend is the backend
+*/
+void setBackend(Backend backend)
+{
+    if (!isBackendAvailable(backend)) {
+        throw std::runtime_error("The requested threading backend is not available.");
+    }
+
+    ThreadingState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.backend = backend;
+}
+
+/*!
+    \ingroup common_threads
+
+    Gets the backend used for running the tasks.
+
+    \result The backend used for running the tasks.
+*/
+Backend getBackend()
+{
+    ThreadingState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    return state.backend;
+}
+
+/*!
+    \ingroup common_threads
+
+    Sets the number of threads that will be used for running the tasks.
+
+    The default number of threads can be controlled using the environment
+    variable BITPIT_NUM_THREADS. If the variable is not set, the default
+    number of threads is the one returned by omp_get_max_threads() when
+    OpenMP support is enabled, or one otherwise. When running multiple
+    MPI processes on the same node, the number of threads should be
+    chosen so that the cores are not oversubscribed.
+
+    \param nThreads is the number of threads
+*/
+void setThreadCount(int nThreads)
+{
+    ThreadingState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    state.nThreads = std::max(nThreads, 1);
+    if (state.pool && state.pool->getThreadCount() != state.nThreads) {
+        state.pool.reset();
+    }
+}
+
+/*!
+    \ingroup common_threads
+
+    Gets the number of threads that will be used for running the tasks.
+
+    \result The number of threads that will be used for running the tasks.
+*/
+int getThreadCount()
+{
+    ThreadingState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (state.backend == BACKEND_SERIAL) {
+        return 1;
+    }
+
+    return state.nThreads;
+}
+
+/*!
+    \ingroup common_threads
+
+    Runs the specified function for all the tasks in the range [0, nTasks).
+
+    Tasks are distributed among the threads using the current backend. If
+    the function is called from within a task, the tasks will be processed
+    sequentially by the calling thread.
+
+    \param nTasks is the number of tasks
+    \param function is the function that will be called for each task
+*/
+void runTasks(std::size_t nTasks, const TaskFunction &function)
+{
+    // Get backend information
+    ThreadingState &state = getState();
+
+    Backend backend;
+    int nThreads;
+    std::shared_ptr<ThreadPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        backend  = state.backend;
+        nThreads = state.nThreads;
+        if (backend == BACKEND_THREAD_POOL && nThreads > 1 && !insideTask) {
+            if (!state.pool) {
+                state.pool = std::make_shared<ThreadPool>(nThreads);
+            }
+            pool = state.pool;
+        }
+    }
+
+    // Nested tasks and serial runs are processed by the calling thread
+    if (insideTask || backend == BACKEND_SERIAL || nThreads <= 1) {
+        for (std::size_t i = 0; i < nTasks; ++i) {
+            function(i);
+        }
+
+        return;
+    }
+
+    // Run the tasks
+    TaskFunction guardedFunction = [&function](std::size_t task) {
+        TaskGuard guard;
+        function(task);
+    };
+
+    switch (backend) {
+
+#if BITPIT_ENABLE_OPENMP==1
+    case BACKEND_OPENMP:
+    {
+        long nLongTasks = static_cast<long>(nTasks);
+        std::exception_ptr exception;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads)
+        for (long i = 0; i < nLongTasks; ++i) {
+            try {
+                guardedFunction(static_cast<std::size_t>(i));
+            } catch (...) {
+#pragma omp critical (bitpit_threads_exception)
+                {
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+
+        break;
+    }
+#endif
+
+    case BACKEND_THREAD_POOL:
+    {
+        // Only one thread at a time can use the pool
+        static std::mutex poolMutex;
+        std::lock_guard<std::mutex> lock(poolMutex);
+
+        pool->run(nTasks, guardedFunction);
+
+        break;
+    }
+
+    default:
+    {
+        for (std::size_t i = 0; i < nTasks; ++i) {
+            function(i);
+        }
+
+        break;
+    }
+
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,134 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#ifndef __BITPIT_COMMON_THREAD_UTILS_HPP__
+#define __BITPIT_COMMON_THREAD_UTILS_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bitpit {
+
+namespace utils {
+
+/*!
+    \ingroup common_threads
+    \brief The namespace 'threads' contains routines for running tasks
+    concurrently on the threads available to the process.
+*/
+namespace threads {
+
+/*!
+    Backend used for running tasks concurrently.
+*/
+enum Backend {
+    BACKEND_SERIAL,      //! Tasks are run sequentially by the calling thread
+    BACKEND_OPENMP,      //! Tasks are run by an OpenMP parallel region
+    BACKEND_THREAD_POOL  //! Tasks are run by the built-in pool of threads
+};
+
+/*!
+    Type of the function that process a task.
+*/
+typedef std::function<void(std::size_t)> TaskFunction;
+
+/*!
+    \ingroup common_threads
+
+    \brief Pool of worker threads.
+
+    Tasks are identified by an index and are dispatched dynamically to the
+    worker threads. The calling thread takes part to the processing of the
+    tasks and the call returns once all the tasks have been processed.
+*/
+class ThreadPool {
+
+public:
+    ThreadPool(int nThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool & operator=(const ThreadPool &other) = delete;
+
+    int getThreadCount() const;
+
+    void run(std::size_t nTasks, const TaskFunction &function);
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+
+    bool m_terminate;
+    std::size_t m_generation;
+    int m_nBusyWorkers;
+
+    const TaskFunction *m_function;
+    std::size_t m_nTasks;
+    std::atomic<std::size_t> m_nextTask;
+    std::exception_ptr m_exception;
+
+    void workerLoop();
+    void processTasks();
+
+};
+
+bool isBackendAvailable(Backend backend);
+void setBackend(Backend backend);
+Backend getBackend();
+
+void setThreadCount(int nThreads);
+int getThreadCount();
+
+void runTasks(std::size_t nTasks, const TaskFunction &function);
+
+template<typename Function>
+void parallelFor(std::size_t nTasks, Function &&function);
+
+template<typename RandomIterator>
+void parallelSort(RandomIterator first, RandomIterator last);
+
+template<typename RandomIterator, typename Compare>
+void parallelSort(RandomIterator first, RandomIterator last, Compare comp);
+
+}
+
+}
+
+}
+
+// Include template implementations
+#include "threadUtils.tpp"
+
+#endif
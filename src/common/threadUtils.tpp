@@ -0,0 +1,142 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#ifndef __BITPIT_COMMON_THREAD_UTILS_TPP__
+#define __BITPIT_COMMON_THREAD_UTILS_TPP__
+
+namespace bitpit {
+
+namespace utils {
+
+namespace threads {
+
+/*!
+* \ingroup common_threads
+*
+* Runs the specified function for all the tasks in the range [0, nTasks).
+*
+* Tasks are distributed among the threads using the current backend. The
+* function should be safe to be called concurrently for different tasks.
+* If the function throws an exception, the remaining tasks may be skipped
+* and the first exception thrown will be re-thrown by this function.
+*
+* \param nTasks is the number of tasks
+* \param function is the function that will be called for each task, it
+* will receive the index of the task
+*/
+template<typename Function>
+void parallelFor(std::size_t nTasks, Function &&function)
+{
+    if (nTasks == 0) {
+        return;
+    }
+
+    // Small loops are run by the calling thread
+    if (nTasks == 1 || getBackend() == BACKEND_SERIAL || getThreadCount() <= 1) {
+        for (std::size_t i = 0; i < nTasks; ++i) {
+            function(i);
+        }
+
+        return;
+    }
+
+    runTasks(nTasks, TaskFunction(std::ref(function)));
+}
+
+/*!
+* \ingroup common_threads
+*
+* Sorts the elements in the range [first, last) in ascending order.
+*
+* See parallelSort(RandomIterator, RandomIterator, Compare) for the details.
+*
+* \param first is the beginning of the range
+* \param last is the end of the range
+*/
+template<typename RandomIterator>
+void parallelSort(RandomIterator first, RandomIterator last)
+{
+    parallelSort(first, last, std::less<typename std::iterator_traits<RandomIterator>::value_type>());
+}
+
+/*!
+* \ingroup common_threads
+*
+* Sorts the elements in the range [first, last) using the specified
+* comparison function.
+*
+* The range is split into one chunk per thread, chunks are sorted
+* concurrently and then merged pairwise (merges of the same level are
+* performed concurrently). Small ranges are sorted by the calling thread.
+* As for std::sort, the order of equal elements is not guaranteed to be
+* preserved.
+*
+* \param first is the beginning of the range
+* \param last is the end of the range
+* \param comp is the comparison function, it should return true if the
+* first argument is less than the second
+*/
+template<typename RandomIterator, typename Compare>
+void parallelSort(RandomIterator first, RandomIterator last, Compare comp)
+{
+    static const std::size_t MIN_CHUNK_SIZE = 16384;
+
+    std::size_t nElements = static_cast<std::size_t>(std::distance(first, last));
+    std::size_t nThreads  = static_cast<std::size_t>(getThreadCount());
+    std::size_t nChunks   = std::min(nThreads, nElements / MIN_CHUNK_SIZE);
+    if (nChunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // Sort the chunks
+    std::vector<RandomIterator> boundaries(nChunks + 1);
+    for (std::size_t k = 0; k <= nChunks; ++k) {
+        boundaries[k] = first + (nElements * k) / nChunks;
+    }
+
+    parallelFor(nChunks, [&boundaries, &comp](std::size_t k) {
+        std::sort(boundaries[k], boundaries[k + 1], comp);
+    });
+
+    // Merge the chunks
+    for (std::size_t width = 1; width < nChunks; width *= 2) {
+        std::size_t nMerges = (nChunks + 2 * width - 1) / (2 * width);
+        parallelFor(nMerges, [&boundaries, &comp, width, nChunks](std::size_t m) {
+            std::size_t begin  = 2 * width * m;
+            std::size_t middle = std::min(begin + width, nChunks);
+            std::size_t end    = std::min(begin + 2 * width, nChunks);
+            if (middle < end) {
+                std::inplace_merge(boundaries[begin], boundaries[middle], boundaries[end], comp);
+            }
+        });
+    }
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -30,7 +30,10 @@
 #include "commonUtils.hpp"
 #include "binaryUtils.hpp"
 #include "hashingUtils.hpp"
+#include "memoryUtils.hpp"
+#include "sfcUtils.hpp"
 #include "stringUtils.hpp"
+#include "threadUtils.hpp"
 
 namespace bitpit {
 
@@ -64,6 +64,21 @@ void SendBuffer::write(const char *data, std::size_t size)
     getFront().write(data, size);
 }
 
+/*!
+* Get a region of the buffer where data can be written in place.
+*
+* The region will be filled by the caller, this allows to avoid building
+* the data in a temporary memory location before writing it into the
+* buffer. The pointer remains valid until the next write operation.
+*
+* \param[in] size is the size (in bytes) of the region
+* \result A pointer to the region of the buffer where data can be written.
+*/
+char * SendBuffer::writeInPlace(std::size_t size)
+{
+    return getFront().writeInPlace(size);
+}
+
 /*!
     \class RecvBuffer
     \ingroup communications
@@ -91,4 +106,19 @@ void RecvBuffer::read(char *data, std::size_t size)
     getFront().read(data, size);
 }
 
+/*!
+* Read data from the buffer without copying it.
+*
+* The data is left in the buffer and a pointer to it is returned. The
+* pointer remains valid until the buffer is resized.
+*
+* \param[in] size is the size (in bytes) of the data to be read from the
+* stream
+* \result A pointer to the data inside the buffer.
+*/
+const char * RecvBuffer::readInPlace(std::size_t size)
+{
+    return getFront().readInPlace(size);
+}
+
 }
@@ -100,6 +100,10 @@ public:
     void squeeze();
 
     void write(const char *data, std::size_t size);
+    char * writeInPlace(std::size_t size);
+
+    template<typename value_t, typename id_t, typename allocator_t>
+    void write(const PiercedStorage<value_t, id_t, allocator_t> &storage, std::size_t nItems, const std::size_t *positions);
 
 };
 
@@ -114,6 +118,10 @@ public:
     RecvBuffer(size_t size = 0, bool doubleBuffer = false);
 
     void read(char *data, std::size_t size);
+    const char * readInPlace(std::size_t size);
+
+    template<typename value_t, typename id_t, typename allocator_t>
+    void read(PiercedStorage<value_t, id_t, allocator_t> &storage, std::size_t nItems, const std::size_t *positions);
 
 };
 
@@ -57,6 +57,44 @@ bitpit::RecvBuffer & operator>>(bitpit::RecvBuffer &buffer, T &value)
     return buffer;
 }
 
+/*!
+    Write into the buffer the items of the storage at the specified raw
+    positions.
+
+    Items are packed directly into the buffer, with no intermediate copies
+    (see PiercedStorage::rawPack). The layout of the data is the same that
+    would be obtained streaming the fields of the items one by one.
+
+    \param storage is the storage
+    \param nItems is the number of items that will be written
+    \param positions are the raw positions of the items
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+void SendBuffer::write(const PiercedStorage<value_t, id_t, allocator_t> &storage, std::size_t nItems, const std::size_t *positions)
+{
+    char *region = writeInPlace(storage.getPackedSize(nItems));
+    storage.rawPack(nItems, positions, region);
+}
+
+/*!
+    Read from the buffer the items of the storage at the specified raw
+    positions.
+
+    Items are unpacked directly from the buffer, with no intermediate copies
+    (see PiercedStorage::rawUnpack). The data should have been written using
+    the layout of SendBuffer::write.
+
+    \param storage is the storage
+    \param nItems is the number of items that will be read
+    \param positions are the raw positions of the items
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+void RecvBuffer::read(PiercedStorage<value_t, id_t, allocator_t> &storage, std::size_t nItems, const std::size_t *positions)
+{
+    const char *region = readInPlace(storage.getPackedSize(nItems));
+    storage.rawUnpack(nItems, positions, region);
+}
+
 /*!
     Create a new communication buffer
  */
@@ -420,13 +420,33 @@ void IBinaryStream::open(const char *buffer, std::size_t size)
 * stream
 */
 void IBinaryStream::read(char *data, std::size_t size)
+{
+    std::memcpy(data, readInPlace(size), size);
+}
+
+/*!
+* Read data from the stream without copying it.
+*
+* The cursor is advanced as if the data were read, but, instead of being
+* copied into a user-provided memory location, the data is left in the
+* stream and a pointer to it is returned. The pointer remains valid until
+* the stream is re-opened or resized. No alignment is guaranteed for the
+* returned pointer.
+*
+* \param[in] size is the size (in bytes) of the data to be read from the
+* stream
+* \result A pointer to the data inside the stream.
+*/
+const char * IBinaryStream::readInPlace(std::size_t size)
 {
     if ((m_pos + size) > getSize()) {
         throw std::runtime_error("Bad memory access!");
     }
 
-    std::memcpy(data, m_buffer.data() + m_pos, size);
+    const char *region = m_buffer.data() + m_pos;
     m_pos += size;
+
+    return region;
 }
 
 /*!
@@ -523,6 +543,24 @@ void OBinaryStream::squeeze()
 * the stream
 */
 void OBinaryStream::write(const char *data, std::size_t size)
+{
+    std::memcpy(writeInPlace(size), data, size);
+}
+
+/*!
+* Get a region of the stream where data can be written in place.
+*
+* The cursor is advanced as if the data were written, the caller is then
+* responsible for filling the returned region with the actual data. This
+* allows to write data directly into the stream, without building it in
+* a temporary memory location. The pointer remains valid until the next
+* operation that can change the size of the stream. No alignment is
+* guaranteed for the returned pointer.
+*
+* \param[in] size is the size (in bytes) of the region
+* \result A pointer to the region of the stream where data can be written.
+*/
+char * OBinaryStream::writeInPlace(std::size_t size)
 {
     if (getSize() - m_pos < size) {
         // If the stream is not expandable, the request for a new size
@@ -531,8 +569,10 @@ void OBinaryStream::write(const char *data, std::size_t size)
         setSize(bufferSize);
     }
 
-    std::memcpy(m_buffer.data() + m_pos, data, size);
+    char *region = m_buffer.data() + m_pos;
     m_pos += size;
+
+    return region;
 }
 
 }
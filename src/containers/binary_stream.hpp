@@ -44,10 +44,10 @@ IBinaryStream &operator>>(IBinaryStream &stream, std::array<T, d> &data);
 template<typename T, std::size_t d>
 OBinaryStream &operator<<(OBinaryStream &stream, const std::array<T, d> &data);
 
-template<typename T>
-IBinaryStream& operator>>(IBinaryStream &stream, std::vector<T> &data);
-template<typename T>
-OBinaryStream& operator<<(OBinaryStream &stream, const std::vector<T> &data);
+template<typename T, typename Allocator>
+IBinaryStream& operator>>(IBinaryStream &stream, std::vector<T, Allocator> &data);
+template<typename T, typename Allocator>
+OBinaryStream& operator<<(OBinaryStream &stream, const std::vector<T, Allocator> &data);
 
 template<typename K, typename T>
 IBinaryStream &operator>>(IBinaryStream &stream, std::pair<K, T> &data);
@@ -137,6 +137,7 @@ public:
     void open(std::size_t size);
 
     void read(char *data, std::size_t size);
+    const char * readInPlace(std::size_t size);
 
 };
 
@@ -155,6 +156,7 @@ public:
     void squeeze();
 
     void write(const char *data, std::size_t size);
+    char * writeInPlace(std::size_t size);
 
 private:
     bool m_expandable;
@@ -36,6 +36,7 @@
 
 #include "binary_stream.hpp"
 #include "flatVector2D.hpp"
+#include "piercedComponentStorage.hpp"
 #include "piercedKernel.hpp"
 #include "piercedStorage.hpp"
 #include "piercedVector.hpp"
@@ -31,17 +31,18 @@
 #include <memory>
 
 #include "binary_stream.hpp"
+#include "threadUtils.hpp"
 
 namespace bitpit{
 
-template<class T>
+template<class T, class Allocator = std::allocator<T>>
 class FlatVector2D;
 
-template<class T>
-OBinaryStream& operator<<(OBinaryStream &buffer, const FlatVector2D<T> &vector);
+template<class T, class Allocator>
+OBinaryStream& operator<<(OBinaryStream &buffer, const FlatVector2D<T, Allocator> &vector);
 
-template<class T>
-IBinaryStream& operator>>(IBinaryStream &buffer, FlatVector2D<T> &vector);
+template<class T, class Allocator>
+IBinaryStream& operator>>(IBinaryStream &buffer, FlatVector2D<T, Allocator> &vector);
 
 /*!
     @ingroup containers
@@ -53,16 +54,17 @@ IBinaryStream& operator>>(IBinaryStream &buffer, FlatVector2D<T> &vector);
     vectors.
 
     @tparam T The type of the objects stored in the vector
+    @tparam Allocator The allocator used for storing the objects
 */
 
-template <class T>
+template <class T, class Allocator>
 class FlatVector2D
 {
 
-template<class U>
-friend OBinaryStream& (operator<<) (OBinaryStream &buffer, const FlatVector2D<U> &vector);
-template<class U>
-friend IBinaryStream& (operator>>) (IBinaryStream &buffer, FlatVector2D<U> &vector);
+template<class U, class U_Allocator>
+friend OBinaryStream& (operator<<) (OBinaryStream &buffer, const FlatVector2D<U, U_Allocator> &vector);
+template<class U, class U_Allocator>
+friend IBinaryStream& (operator>>) (IBinaryStream &buffer, FlatVector2D<U, U_Allocator> &vector);
 
 public:
     FlatVector2D(bool initialize = true);
@@ -97,7 +99,10 @@ public:
     void initialize(std::size_t nVectors, const std::size_t *sizes, const T &value);
     void initialize(std::size_t nVectors, const std::size_t *sizes, const T *values);
     void initialize(const std::vector<std::vector<T> > &vector2D);
-    void initialize(const FlatVector2D<T> &other);
+    void initialize(const FlatVector2D<T, Allocator> &other);
+
+    template<typename CountFunction, typename FillFunction>
+    void build(std::size_t nVectors, CountFunction countItems, FillFunction fillItems);
 
     void destroy();
     void reserve(std::size_t nVectors, std::size_t nItems = 0);
@@ -115,7 +120,7 @@ public:
 
     T * data() noexcept;
     const T * data() const noexcept;
-    const std::vector<T> & vector() const;
+    const std::vector<T, Allocator> & vector() const;
 
     void pushBack();
     void pushBack(std::size_t subArraySize, const T &value = T());
@@ -158,9 +163,10 @@ public:
     std::size_t getItemCapacity() const;
 
     std::size_t getBinarySize() const;
+    std::size_t getMemoryUsage() const;
 
 private:
-    std::vector<T> m_v;
+    std::vector<T, Allocator> m_v;
     std::vector<std::size_t> m_index;
 
     const T* operator[](std::size_t i) const;
@@ -31,6 +31,7 @@
 #include <memory>
 
 #include "binary_stream.hpp"
+#include "threadUtils.hpp"
 
 namespace bitpit {
 
@@ -42,8 +43,8 @@ namespace bitpit {
     \param[in] vetor is the container to be streamed
     \result Returns the same output stream received in input.
 */
-template<class T>
-OBinaryStream& operator<<(OBinaryStream &buffer, const FlatVector2D<T> &vector)
+template<class T, class Allocator>
+OBinaryStream& operator<<(OBinaryStream &buffer, const FlatVector2D<T, Allocator> &vector)
 {
     buffer << vector.m_index;
     buffer << vector.m_v;
@@ -59,8 +60,8 @@ OBinaryStream& operator<<(OBinaryStream &buffer, const FlatVector2D<T> &vector)
     \param[in] vector is the container to be streamed
     \result Returns the same input stream received in input.
 */
-template<class T>
-IBinaryStream& operator>>(IBinaryStream &buffer, FlatVector2D<T> &vector)
+template<class T, class Allocator>
+IBinaryStream& operator>>(IBinaryStream &buffer, FlatVector2D<T, Allocator> &vector)
 {
     buffer >> vector.m_index;
     buffer >> vector.m_v;
@@ -71,8 +72,8 @@ IBinaryStream& operator>>(IBinaryStream &buffer, FlatVector2D<T> &vector)
 /*!
     Default constructor.
 */
-template <class T>
-FlatVector2D<T>::FlatVector2D(bool initialize)
+template <class T, class Allocator>
+FlatVector2D<T, Allocator>::FlatVector2D(bool initialize)
     : m_index(initialize ? 1 : 0, 0L)
 {
 }
@@ -84,8 +85,8 @@ FlatVector2D<T>::FlatVector2D(bool initialize)
     \param value is the value that will be use to initialize the items of
     the vectors
 */
-template <class T>
-FlatVector2D<T>::FlatVector2D(const std::vector<std::size_t> &sizes, const T &value)
+template <class T, class Allocator>
+FlatVector2D<T, Allocator>::FlatVector2D(const std::vector<std::size_t> &sizes, const T &value)
 {
     initialize(sizes.size(), sizes.data(), 1, &value, 0);
 }
@@ -98,8 +99,8 @@ FlatVector2D<T>::FlatVector2D(const std::vector<std::size_t> &sizes, const T &va
     \param value is the value that will be use to initialize the
     items of the vectors
 */
-template <class T>
-FlatVector2D<T>::FlatVector2D(std::size_t nVectors, std::size_t size, const T &value)
+template <class T, class Allocator>
+FlatVector2D<T, Allocator>::FlatVector2D(std::size_t nVectors, std::size_t size, const T &value)
 {
     initialize(nVectors, &size, 0, &value, 0);
 }
@@ -112,8 +113,8 @@ FlatVector2D<T>::FlatVector2D(std::size_t nVectors, std::size_t size, const T &v
     \param value is the value that will be use to initialize the
     items of the vectors
 */
-template <class T>
-FlatVector2D<T>::FlatVector2D(std::size_t nVectors, const std::size_t *sizes, const T &value)
+template <class T, class Allocator>
+FlatVector2D<T, Allocator>::FlatVector2D(std::size_t nVectors, const std::size_t *sizes, const T &value)
 {
     initialize(nVectors, sizes, 1, &value, 0);
 }
@@ -125,8 +126,8 @@ FlatVector2D<T>::FlatVector2D(std::size_t nVectors, const std::size_t *sizes, co
     \param sizes are the sizes of the vectors
     \param values are the values of the vectors
 */
-template <class T>
-FlatVector2D<T>::FlatVector2D(std::size_t nVectors, const std::size_t *sizes, const T *values)
+template <class T, class Allocator>
+FlatVector2D<T, Allocator>::FlatVector2D(std::size_t nVectors, const std::size_t *sizes, const T *values)
 {
     initialize(nVectors, sizes, 1, values, 1);
 }
@@ -137,8 +138,8 @@ FlatVector2D<T>::FlatVector2D(std::size_t nVectors, const std::size_t *sizes, co
     \param vector2D is a 2D vector that will be used to initialize the
     newly created container
 */
-template <class T>
-FlatVector2D<T>::FlatVector2D(const std::vector<std::vector<T> > &vector2D)
+template <class T, class Allocator>
+FlatVector2D<T, Allocator>::FlatVector2D(const std::vector<std::vector<T> > &vector2D)
 {
     initialize(vector2D);
 }
@@ -148,8 +149,8 @@ FlatVector2D<T>::FlatVector2D(const std::vector<std::vector<T> > &vector2D)
 
     \result Returns true if the container has been initialized, false otherwise.
 */
-template <class T>
-bool FlatVector2D<T>::isInitialized() const
+template <class T, class Allocator>
+bool FlatVector2D<T, Allocator>::isInitialized() const
 {
     return (!m_index.empty());
 }
@@ -161,8 +162,8 @@ bool FlatVector2D<T>::isInitialized() const
     \param value is the value that will be use to initialize the items of
     the vectors
 */
-template <class T>
-void FlatVector2D<T>::initialize(const std::vector<std::size_t> &sizes, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(const std::vector<std::size_t> &sizes, const T &value)
 {
     initialize(sizes.size(), sizes.data(), 1, &value, 1);
 }
@@ -175,8 +176,8 @@ void FlatVector2D<T>::initialize(const std::vector<std::size_t> &sizes, const T
     \param value is the value that will be use to initialize the
     items of the vectors
 */
-template <class T>
-void FlatVector2D<T>::initialize(std::size_t nVectors, std::size_t size, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(std::size_t nVectors, std::size_t size, const T &value)
 {
     initialize(nVectors, &size, 0, &value, 0);
 }
@@ -189,8 +190,8 @@ void FlatVector2D<T>::initialize(std::size_t nVectors, std::size_t size, const T
     \param value is the value that will be use to initialize the
     items of the vectors
 */
-template <class T>
-void FlatVector2D<T>::initialize(std::size_t nVectors, const std::size_t *sizes, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(std::size_t nVectors, const std::size_t *sizes, const T &value)
 {
     initialize(nVectors, sizes, 1, &value, 0);
 }
@@ -203,8 +204,8 @@ void FlatVector2D<T>::initialize(std::size_t nVectors, const std::size_t *sizes,
     \param sizes are the sizes of the vectors
     \param values are the values of the vectors
 */
-template <class T>
-void FlatVector2D<T>::initialize(std::size_t nVectors, const std::size_t *sizes, const T *values)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(std::size_t nVectors, const std::size_t *sizes, const T *values)
 {
     initialize(nVectors, sizes, 1, values, 1);
 }
@@ -218,8 +219,8 @@ void FlatVector2D<T>::initialize(std::size_t nVectors, const std::size_t *sizes,
     \param values are the values of each vector
     \param valuesStride is the stride for accessing the values
 */
-template <class T>
-void FlatVector2D<T>::initialize(std::size_t nVectors,
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(std::size_t nVectors,
                                  const std::size_t *sizes, std::size_t sizesStride,
                                  const T *values, std::size_t valuesStride)
 {
@@ -286,8 +287,8 @@ void FlatVector2D<T>::initialize(std::size_t nVectors,
     \param vector2D is a 2D vector that will be used to initialize the
     container
 */
-template <class T>
-void FlatVector2D<T>::initialize(const std::vector<std::vector<T> > &vector2D)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(const std::vector<std::vector<T> > &vector2D)
 {
     std::size_t nVectors = vector2D.size();
 
@@ -344,21 +345,119 @@ void FlatVector2D<T>::initialize(const std::vector<std::vector<T> > &vector2D)
     \param other is antoher container of the same type, whose contents will
     be used to initialize the current container
 */
-template <class T>
-void FlatVector2D<T>::initialize(const FlatVector2D<T> &other)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::initialize(const FlatVector2D<T, Allocator> &other)
 {
     m_v.assign(other.m_v.begin(), other.m_v.end());
     m_index.assign(other.m_index.begin(), other.m_index.end());
 }
 
+/*!
+    Builds the container in two passes.
+
+    In the first pass, the number of items of each vector is evaluated
+    calling the count function. The index of the container is then built
+    from the counts and the items are allocated at once. In the second pass
+    the items of each vector are set calling the fill function. Both
+    passes, as well as the evaluation of the index, are performed
+    concurrently by the threads available to the process: the vectors are
+    split in chunks and, in each pass, every chunk is processed by a single
+    thread.
+
+    The count function will be called once for every vector, it will receive
+    the index of the vector and should return its number of items. The fill
+    function will be called once for every vector, it will receive the index
+    of the vector and a pointer to its items (that will be default
+    constructed). Both functions should be safe to be called concurrently
+    for different vectors and the fill function should only modify the items
+    of the vector it receives. The index of the container is complete when
+    the fill function is called, hence the items can also be set using
+    setItem or rawSetItem.
+
+    \param nVectors is the number of vectors
+    \param countItems is the function that evaluates the number of items of
+    a vector
+    \param fillItems is the function that sets the items of a vector
+*/
+template <class T, class Allocator>
+template<typename CountFunction, typename FillFunction>
+void FlatVector2D<T, Allocator>::build(std::size_t nVectors, CountFunction countItems, FillFunction fillItems)
+{
+    static const std::size_t MIN_CHUNK_SIZE = 1024;
+
+    // Split the vectors in chunks
+    std::size_t nThreads = static_cast<std::size_t>(utils::threads::getThreadCount());
+    std::size_t nChunks  = std::max(std::min(nThreads, nVectors / MIN_CHUNK_SIZE), std::size_t(1));
+
+    std::vector<std::size_t> chunkBegins(nChunks + 1);
+    for (std::size_t chunk = 0; chunk <= nChunks; ++chunk) {
+        chunkBegins[chunk] = (nVectors * chunk) / nChunks;
+    }
+
+    // Initialize the index
+    //
+    // The index will contain the sizes of the vectors, that will be later
+    // transformed into the indices of the vectors by a prefix sum.
+    if (!isInitialized() || nVectors != size()) {
+        destroy(true, false);
+        m_index.resize(nVectors + 1);
+    }
+
+    // Count the items
+    //
+    // Every chunk counts the items of its vectors, the offset of each chunk
+    // is then evaluated by a prefix sum of the chunk counts.
+    std::vector<std::size_t> chunkOffsets(nChunks + 1, 0);
+    utils::threads::parallelFor(nChunks, [this, &countItems, &chunkBegins, &chunkOffsets](std::size_t chunk) {
+        std::size_t chunkItems = 0;
+        for (std::size_t i = chunkBegins[chunk]; i < chunkBegins[chunk + 1]; ++i) {
+            std::size_t nVectorItems = countItems(i);
+            m_index[i + 1] = nVectorItems;
+            chunkItems += nVectorItems;
+        }
+        chunkOffsets[chunk + 1] = chunkItems;
+    });
+
+    for (std::size_t chunk = 0; chunk < nChunks; ++chunk) {
+        chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+    }
+
+    // Allocate the items
+    std::size_t nItems = chunkOffsets[nChunks];
+    if (nItems != getItemCount()) {
+        destroy(false, true);
+    }
+    m_v.assign(nItems, T());
+
+    // Evaluate the indices
+    //
+    // Every chunk evaluates the indices of its vectors starting from the
+    // offset of the chunk.
+    m_index[0] = 0;
+    utils::threads::parallelFor(nChunks, [this, &chunkBegins, &chunkOffsets](std::size_t chunk) {
+        std::size_t offset = chunkOffsets[chunk];
+        for (std::size_t i = chunkBegins[chunk]; i < chunkBegins[chunk + 1]; ++i) {
+            offset += m_index[i + 1];
+            m_index[i + 1] = offset;
+        }
+    });
+
+    // Fill the items
+    utils::threads::parallelFor(nChunks, [this, &fillItems, &chunkBegins](std::size_t chunk) {
+        for (std::size_t i = chunkBegins[chunk]; i < chunkBegins[chunk + 1]; ++i) {
+            fillItems(i, m_v.data() + m_index[i]);
+        }
+    });
+}
+
 /*!
     Destroy the container.
 
     After calling this function the container will be non-functional
     until it is re-initialized.
 */
-template <class T>
-void FlatVector2D<T>::destroy()
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::destroy()
 {
     destroy(true, true);
 }
@@ -372,8 +471,8 @@ void FlatVector2D<T>::destroy()
     \param destroyIndex if true the index data structure will be destoryed
     \param destroyValues if true the values data structure will be destoryed
 */
-template <class T>
-void FlatVector2D<T>::destroy(bool destroyIndex, bool destroyValues)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::destroy(bool destroyIndex, bool destroyValues)
 {
     if (destroyIndex) {
         m_index.clear();
@@ -397,8 +496,8 @@ void FlatVector2D<T>::destroy(bool destroyIndex, bool destroyValues)
     \param nItems is the minimum number of items that the container should
     be able to contain
 */
-template <class T>
-void FlatVector2D<T>::reserve(std::size_t nVectors, std::size_t nItems)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::reserve(std::size_t nVectors, std::size_t nItems)
 {
     m_index.reserve(nVectors + 1);
     if (nItems > 0) {
@@ -411,8 +510,8 @@ void FlatVector2D<T>::reserve(std::size_t nVectors, std::size_t nItems)
 
     \param other is another container of the same type
 */
-template <class T>
-void FlatVector2D<T>::swap(FlatVector2D &other) noexcept
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::swap(FlatVector2D &other) noexcept
 {
     m_index.swap(other.m_index);
     m_v.swap(other.m_v);
@@ -424,8 +523,8 @@ void FlatVector2D<T>::swap(FlatVector2D &other) noexcept
 
     \param value is the value to fill the container with
 */
-template <class T>
-void FlatVector2D<T>::fill(T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::fill(T &value)
 {
     std::fill(m_v.begin(), m_v.end(), value);
 }
@@ -435,8 +534,8 @@ void FlatVector2D<T>::fill(T &value)
 
     \result true if the containers are equal, false otherwise.
 */
-template <class T>
-bool FlatVector2D<T>::operator==(const FlatVector2D& rhs) const
+template <class T, class Allocator>
+bool FlatVector2D<T, Allocator>::operator==(const FlatVector2D& rhs) const
 {
     return m_index == rhs.m_index && m_v == rhs.m_v;
 }
@@ -446,8 +545,8 @@ bool FlatVector2D<T>::operator==(const FlatVector2D& rhs) const
 
     \result true if the container size is 0, false otherwise.
 */
-template <class T>
-bool FlatVector2D<T>::empty() const
+template <class T, class Allocator>
+bool FlatVector2D<T, Allocator>::empty() const
 {
     return size() == 0;
 }
@@ -462,11 +561,11 @@ bool FlatVector2D<T>::empty() const
     released, otherwise the container will be cleared but its memory will
     not be relased
 */
-template <class T>
-void FlatVector2D<T>::clear(bool release)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::clear(bool release)
 {
     if (release) {
-        std::vector<T>(0).swap(m_v);
+        std::vector<T, Allocator>(0).swap(m_v);
 
         std::vector<size_t>(1, 0L).swap(m_index);
     } else {
@@ -487,12 +586,12 @@ void FlatVector2D<T>::clear(bool release)
     released, otherwise the container will be cleared but its memory will
     not be relased
 */
-template <class T>
-void FlatVector2D<T>::clearItems(bool release)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::clearItems(bool release)
 {
     std::size_t nVectors = size();
     if (release) {
-        std::vector<T>(0).swap(m_v);
+        std::vector<T, Allocator>(0).swap(m_v);
 
         std::vector<size_t>(nVectors + 1, 0L).swap(m_index);
     } else {
@@ -507,8 +606,8 @@ void FlatVector2D<T>::clearItems(bool release)
 
     Requests the container to reduce its capacity to fit its size.
 */
-template <class T>
-void FlatVector2D<T>::shrinkToFit()
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::shrinkToFit()
 {
     m_v.shrink_to_fit();
     m_index.shrink_to_fit();
@@ -521,8 +620,8 @@ void FlatVector2D<T>::shrinkToFit()
     \result A constant pointer to the first item in the vector used
     internally by the container to store the indices.
 */
-template <class T>
-const std::size_t * FlatVector2D<T>::indices() const noexcept
+template <class T, class Allocator>
+const std::size_t * FlatVector2D<T, Allocator>::indices() const noexcept
 {
     return m_index.data();
 }
@@ -537,8 +636,8 @@ const std::size_t * FlatVector2D<T>::indices() const noexcept
     internally by the container to store the indices of the specified
     vector.
 */
-template <class T>
-const std::size_t * FlatVector2D<T>::indices(std::size_t i) const noexcept
+template <class T, class Allocator>
+const std::size_t * FlatVector2D<T, Allocator>::indices(std::size_t i) const noexcept
 {
     return (m_index.data() + i);
 }
@@ -551,8 +650,8 @@ const std::size_t * FlatVector2D<T>::indices(std::size_t i) const noexcept
             internally by the container.
 
 */
-template <class T>
-T * FlatVector2D<T>::data() noexcept
+template <class T, class Allocator>
+T * FlatVector2D<T, Allocator>::data() noexcept
 {
     return m_v.data();
 }
@@ -565,8 +664,8 @@ T * FlatVector2D<T>::data() noexcept
             internally by the container.
 
 */
-template <class T>
-const T * FlatVector2D<T>::data() const noexcept
+template <class T, class Allocator>
+const T * FlatVector2D<T, Allocator>::data() const noexcept
 {
     return m_v.data();
 }
@@ -579,8 +678,8 @@ const T * FlatVector2D<T>::data() const noexcept
     container.
 
 */
-template <class T>
-const std::vector<T> & FlatVector2D<T>::vector() const
+template <class T, class Allocator>
+const std::vector<T, Allocator> & FlatVector2D<T, Allocator>::vector() const
 {
     return m_v;
 }
@@ -591,8 +690,8 @@ const std::vector<T> & FlatVector2D<T>::vector() const
     Adds an empty vector at the end of the container, after its current
     last vector.
 */
-template <class T>
-void FlatVector2D<T>::pushBack()
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBack()
 {
     pushBack(0);
 }
@@ -608,8 +707,8 @@ void FlatVector2D<T>::pushBack()
     \param value is the value to be copied (or moved) to the new
     item
 */
-template <class T>
-void FlatVector2D<T>::pushBack(std::size_t subArraySize, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBack(std::size_t subArraySize, const T &value)
 {
     std::size_t previousLastIndex = m_index.back();
     m_index.emplace_back(previousLastIndex + subArraySize);
@@ -625,8 +724,8 @@ void FlatVector2D<T>::pushBack(std::size_t subArraySize, const T &value)
 
     \param subArray is the vector that will be added
 */
-template <class T>
-void FlatVector2D<T>::pushBack(const std::vector<T> &subArray)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBack(const std::vector<T> &subArray)
 {
     pushBack(subArray.size(), subArray.data());
 }
@@ -640,8 +739,8 @@ void FlatVector2D<T>::pushBack(const std::vector<T> &subArray)
     \param subArraySize is the size of the sub array
     \param subArray is a pointer to the sub array will be added
 */
-template <class T>
-void FlatVector2D<T>::pushBack(std::size_t subArraySize, const T *subArray)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBack(std::size_t subArraySize, const T *subArray)
 {
     std::size_t previousLastIndex = m_index.back();
     m_index.emplace_back(previousLastIndex + subArraySize);
@@ -656,8 +755,8 @@ void FlatVector2D<T>::pushBack(std::size_t subArraySize, const T *subArray)
 
     \param value is the value that will be added
 */
-template <class T>
-void FlatVector2D<T>::pushBackItem(const T& value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBackItem(const T& value)
 {
     m_index.back()++;
 
@@ -671,8 +770,8 @@ void FlatVector2D<T>::pushBackItem(const T& value)
 
     \param value is the value that will be added
 */
-template <class T>
-void FlatVector2D<T>::pushBackItem(T &&value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBackItem(T &&value)
 {
     m_index.back()++;
 
@@ -687,8 +786,8 @@ void FlatVector2D<T>::pushBackItem(T &&value)
     \param i is the index of the vector
     \param value is the value that will be added
 */
-template <class T>
-void FlatVector2D<T>::pushBackItem(std::size_t i, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBackItem(std::size_t i, const T &value)
 {
     assert(isIndexValid(i));
 
@@ -709,8 +808,8 @@ void FlatVector2D<T>::pushBackItem(std::size_t i, const T &value)
     \param i is the index of the vector
     \param value is the value that will be added
 */
-template <class T>
-void FlatVector2D<T>::pushBackItem(std::size_t i, T &&value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::pushBackItem(std::size_t i, T &&value)
 {
     assert(isIndexValid(i));
 
@@ -728,8 +827,8 @@ void FlatVector2D<T>::pushBackItem(std::size_t i, T &&value)
     Removes the last vector in the container, effectively reducing the
     container size by one.
 */
-template <class T>
-void FlatVector2D<T>::popBack()
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::popBack()
 {
     if (size() == 0) {
         return;
@@ -744,8 +843,8 @@ void FlatVector2D<T>::popBack()
 
     Removes the last item from the last vector in the container.
 */
-template <class T>
-void FlatVector2D<T>::popBackItem()
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::popBackItem()
 {
     if (getItemCount(size() - 1) == 0) {
         return;
@@ -762,8 +861,8 @@ void FlatVector2D<T>::popBackItem()
 
     \param i is the index of the vector
 */
-template <class T>
-void FlatVector2D<T>::popBackItem(std::size_t i)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::popBackItem(std::size_t i)
 {
     assert(isIndexValid(i));
 
@@ -787,8 +886,8 @@ void FlatVector2D<T>::popBackItem(std::size_t i)
 
     \param i is the index of the vector
 */
-template <class T>
-void FlatVector2D<T>::erase(std::size_t i)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::erase(std::size_t i)
 {
     assert(isIndexValid(i));
 
@@ -802,8 +901,8 @@ void FlatVector2D<T>::erase(std::size_t i)
     \param i is the index of the vector
     \param j is the index of the item that will be removed
 */
-template <class T>
-void FlatVector2D<T>::eraseItem(std::size_t i, std::size_t j)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::eraseItem(std::size_t i, std::size_t j)
 {
     assert(isIndexValid(i, j));
 
@@ -822,8 +921,8 @@ void FlatVector2D<T>::eraseItem(std::size_t i, std::size_t j)
     \param j is the index of the item that will be removed
     \param value is the value that will be set
 */
-template <class T>
-void FlatVector2D<T>::setItem(std::size_t i, std::size_t j, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::setItem(std::size_t i, std::size_t j, const T &value)
 {
     assert(isIndexValid(i, j));
     (*this)[i][j] = value;
@@ -836,8 +935,8 @@ void FlatVector2D<T>::setItem(std::size_t i, std::size_t j, const T &value)
     \param j is the index of the item that will be removed
     \param value is the value that will be set
 */
-template <class T>
-void FlatVector2D<T>::setItem(std::size_t i, std::size_t j, T &&value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::setItem(std::size_t i, std::size_t j, T &&value)
 {
     assert(isIndexValid(i, j));
     (*this)[i][j] = std::move(value);
@@ -850,8 +949,8 @@ void FlatVector2D<T>::setItem(std::size_t i, std::size_t j, T &&value)
     \param j is the index of the item that will be removed
     \result A reference to the requested value.
 */
-template <class T>
-T & FlatVector2D<T>::getItem(std::size_t i, std::size_t j)
+template <class T, class Allocator>
+T & FlatVector2D<T, Allocator>::getItem(std::size_t i, std::size_t j)
 {
     assert(isIndexValid(i, j));
     return (*this)[i][j];
@@ -864,8 +963,8 @@ T & FlatVector2D<T>::getItem(std::size_t i, std::size_t j)
     \param j is the index of the item that will be removed
     \result A constant reference to the requested value.
 */
-template <class T>
-const T & FlatVector2D<T>::getItem(std::size_t i, std::size_t j) const
+template <class T, class Allocator>
+const T & FlatVector2D<T, Allocator>::getItem(std::size_t i, std::size_t j) const
 {
     assert(isIndexValid(i, j));
     return (*this)[i][j];
@@ -877,8 +976,8 @@ const T & FlatVector2D<T>::getItem(std::size_t i, std::size_t j) const
     \param i is the index of the vector
     \result A constant pointer to the first item of the specified vector.
 */
-template <class T>
-const T * FlatVector2D<T>::get(std::size_t i) const
+template <class T, class Allocator>
+const T * FlatVector2D<T, Allocator>::get(std::size_t i) const
 {
     assert(!empty());
     assert(isIndexValid(i));
@@ -891,8 +990,8 @@ const T * FlatVector2D<T>::get(std::size_t i) const
     \param i is the index of the vector
     \result A pointer to the first item of the specified vector.
 */
-template <class T>
-T * FlatVector2D<T>::get(std::size_t i)
+template <class T, class Allocator>
+T * FlatVector2D<T, Allocator>::get(std::size_t i)
 {
     assert(!empty());
     assert(isIndexValid(i));
@@ -905,8 +1004,8 @@ T * FlatVector2D<T>::get(std::size_t i)
     \param k is the raw index
     \param value is the value that will be set
 */
-template <class T>
-void FlatVector2D<T>::rawSetItem(std::size_t k, const T &value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::rawSetItem(std::size_t k, const T &value)
 {
     m_v[k] = value;
 }
@@ -917,8 +1016,8 @@ void FlatVector2D<T>::rawSetItem(std::size_t k, const T &value)
     \param k is the raw index
     \param value is the value that will be set
 */
-template <class T>
-void FlatVector2D<T>::rawSetItem(std::size_t k, T &&value)
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::rawSetItem(std::size_t k, T &&value)
 {
     m_v[k] = std::move(value);
 }
@@ -929,8 +1028,8 @@ void FlatVector2D<T>::rawSetItem(std::size_t k, T &&value)
     \param k is the raw index
     \result A reference to the requested value.
 */
-template <class T>
-T & FlatVector2D<T>::rawGetItem(std::size_t k)
+template <class T, class Allocator>
+T & FlatVector2D<T, Allocator>::rawGetItem(std::size_t k)
 {
     return m_v[k];
 }
@@ -941,8 +1040,8 @@ T & FlatVector2D<T>::rawGetItem(std::size_t k)
     \param k is the raw index
     \result A constant reference to the requested value.
 */
-template <class T>
-const T & FlatVector2D<T>::rawGetItem(std::size_t k) const
+template <class T, class Allocator>
+const T & FlatVector2D<T, Allocator>::rawGetItem(std::size_t k) const
 {
     return m_v[k];
 }
@@ -952,8 +1051,8 @@ const T & FlatVector2D<T>::rawGetItem(std::size_t k) const
 
     \result A pointer to the first item of the vector.
 */
-template <class T>
-T * FlatVector2D<T>::back()
+template <class T, class Allocator>
+T * FlatVector2D<T, Allocator>::back()
 {
     return get(size() - 1);
 }
@@ -963,8 +1062,8 @@ T * FlatVector2D<T>::back()
 
     \result A pointer to the first item of the vector.
 */
-template <class T>
-T * FlatVector2D<T>::first()
+template <class T, class Allocator>
+T * FlatVector2D<T, Allocator>::first()
 {
     return get(0);
 }
@@ -974,8 +1073,8 @@ T * FlatVector2D<T>::first()
 
     \result The number of vectors in the container.
 */
-template <class T>
-std::size_t FlatVector2D<T>::size() const
+template <class T, class Allocator>
+std::size_t FlatVector2D<T, Allocator>::size() const
 {
     if (!isInitialized()) {
         return 0;
@@ -991,8 +1090,8 @@ std::size_t FlatVector2D<T>::size() const
     \result The size of the storage space currently allocated for
     storing vectors, expressed in terms of items.
 */
-template <class T>
-std::size_t FlatVector2D<T>::capacity() const
+template <class T, class Allocator>
+std::size_t FlatVector2D<T, Allocator>::capacity() const
 {
     if (!isInitialized()) {
         return 0;
@@ -1004,8 +1103,8 @@ std::size_t FlatVector2D<T>::capacity() const
 /*!
     Merge the arrays together.
 */
-template <class T>
-void FlatVector2D<T>::merge()
+template <class T, class Allocator>
+void FlatVector2D<T, Allocator>::merge()
 {
     if (size() == 0) {
         return;
@@ -1020,8 +1119,8 @@ void FlatVector2D<T>::merge()
 
     \result The total size of all the vectors.
 */
-template <class T>
-std::size_t FlatVector2D<T>::getItemCount() const
+template <class T, class Allocator>
+std::size_t FlatVector2D<T, Allocator>::getItemCount() const
 {
     if (!isInitialized()) {
         return 0;
@@ -1036,8 +1135,8 @@ std::size_t FlatVector2D<T>::getItemCount() const
     \param i is the index of the vector
     \result The size of the vector.
 */
-template <class T>
-std::size_t FlatVector2D<T>::getItemCount(std::size_t i) const
+template <class T, class Allocator>
+std::size_t FlatVector2D<T, Allocator>::getItemCount(std::size_t i) const
 {
     if (!isInitialized()) {
         return 0;
@@ -1053,8 +1152,8 @@ std::size_t FlatVector2D<T>::getItemCount(std::size_t i) const
     \result The size of the storage space currently allocated for
     storing vectors items, expressed in terms of items.
 */
-template <class T>
-std::size_t FlatVector2D<T>::getItemCapacity() const
+template <class T, class Allocator>
+std::size_t FlatVector2D<T, Allocator>::getItemCapacity() const
 {
     return m_v.capacity();
 }
@@ -1064,20 +1163,34 @@ std::size_t FlatVector2D<T>::getItemCapacity() const
 
     \result The buffer size (in bytes) required to store the container.
 */
-template <class T>
-size_t FlatVector2D<T>::getBinarySize() const
+template <class T, class Allocator>
+size_t FlatVector2D<T, Allocator>::getBinarySize() const
 {
     return ((2 + m_index.size())*sizeof(size_t) + m_v.size() * sizeof(T));
 }
 
+/*!
+    Evaluates the memory allocated by the container.
+
+    The memory occupied by the container object itself and the memory
+    dynamically allocated by the items are not included.
+
+    \result The memory, expressed in bytes, allocated by the container.
+*/
+template <class T, class Allocator>
+std::size_t FlatVector2D<T, Allocator>::getMemoryUsage() const
+{
+    return (m_index.capacity() * sizeof(std::size_t) + m_v.capacity() * sizeof(T));
+}
+
 /*!
     Returns a constant pointer to the first item of the specified vector.
 
     \param i is the index of the vector
     \result A constant pointer to the first item of the specified vector.
 */
-template <class T>
-const T* FlatVector2D<T>::operator[](std::size_t i) const
+template <class T, class Allocator>
+const T* FlatVector2D<T, Allocator>::operator[](std::size_t i) const
 {
     assert(isIndexValid(i));
 
@@ -1095,8 +1208,8 @@ const T* FlatVector2D<T>::operator[](std::size_t i) const
     \param i is the index of the vector
     \result A pointer to the first item of the specified vector.
 */
-template <class T>
-T* FlatVector2D<T>::operator[](std::size_t i)
+template <class T, class Allocator>
+T* FlatVector2D<T, Allocator>::operator[](std::size_t i)
 {
     assert(isIndexValid(i));
 
@@ -1114,8 +1227,8 @@ T* FlatVector2D<T>::operator[](std::size_t i)
     \param i is the index of the vector
     \result true if the index is vaid, false otherwise.
 */
-template <class T>
-bool FlatVector2D<T>::isIndexValid(std::size_t i) const
+template <class T, class Allocator>
+bool FlatVector2D<T, Allocator>::isIndexValid(std::size_t i) const
 {
     return (i < size());
 }
@@ -1127,8 +1240,8 @@ bool FlatVector2D<T>::isIndexValid(std::size_t i) const
     \param j is the index of the item in the vector
     \result true if the indexes are vaid, false otherwise.
 */
-template <class T>
-bool FlatVector2D<T>::isIndexValid(std::size_t i, std::size_t j) const
+template <class T, class Allocator>
+bool FlatVector2D<T, Allocator>::isIndexValid(std::size_t i, std::size_t j) const
 {
     if (!isIndexValid(i)) {
         return false;
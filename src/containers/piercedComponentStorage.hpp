@@ -0,0 +1,184 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_COMPONENT_STORAGE_HPP__
+#define __BITPIT_PIERCED_COMPONENT_STORAGE_HPP__
+
+#include <type_traits>
+#include <vector>
+
+#include "bitpit_common.hpp"
+
+#include "piercedKernel.hpp"
+#include "piercedStorage.hpp"
+#include "piercedSync.hpp"
+
+namespace bitpit {
+
+/**
+* \ingroup containers
+*
+* \brief Pierced storage that stores each component of the fields in its own
+* aligned buffer.
+*
+* \details
+* PiercedStorage stores the fields of an element next to each other, this
+* storage stores instead each component in a separate buffer that follows
+* the raw positions of the kernel (structure-of-arrays layout). The buffers
+* are aligned to utils::memory::SIMD_ALIGNMENT bytes and can be handed
+* directly to vectorized loops or to BLAS routines.
+*
+* Positions that are not occupied by an element of the kernel (holes) are
+* filled with a neutral value, hence loops over all the raw positions of
+* the storage can ignore the holes. Journaled storages update their holes
+* when they are synchronized. As for the other storages, the values of
+* newly created elements are undefined until they are set.
+*
+* Usage: use <tt>PiercedComponentStorage<value_t, id_t></tt> to declare a
+* pierced component storage.
+*
+* \tparam value_t is the type of the elements stored in the storage, it
+* should be an arithmetic type
+* \tparam id_t is the type of the ids associated to the elements
+*/
+template<typename value_t, typename id_t = long>
+class PiercedComponentStorage : public PiercedStorageSyncSlave<id_t> {
+
+static_assert(std::is_arithmetic<value_t>::value && !std::is_same<value_t, bool>::value, "Arithmetic non-boolean type required for component storages.");
+
+public:
+    // Template typedef
+
+    /**
+    * Kernel template
+    */
+    template<typename PK_id_t>
+    using Kernel = typename PiercedStorageSyncSlave<id_t>::template Kernel<PK_id_t>;
+
+    // Typedefs
+
+    /*!
+    * Type of data stored in the container
+    */
+    typedef value_t value_type;
+
+    /*!
+    * Type of ids stored in the container
+    */
+    typedef typename Kernel<id_t>::id_type id_type;
+
+    /**
+    * Kernel
+    */
+    typedef Kernel<id_t> kernel_t;
+
+    /**
+    * Kernel type
+    */
+    typedef typename PiercedStorageSyncSlave<id_t>::KernelType KernelType;
+
+    /**
+    * Container used for storing a component
+    */
+    typedef std::vector<value_t, utils::memory::AlignedAllocator<value_t>> component_t;
+
+    // Constructors and initialization
+    PiercedComponentStorage();
+    PiercedComponentStorage(std::size_t nComponents, const value_t &holeValue = value_t(0));
+    PiercedComponentStorage(std::size_t nComponents, const PiercedKernel<id_t> *kernel, const value_t &holeValue = value_t(0));
+    PiercedComponentStorage(std::size_t nComponents, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode, const value_t &holeValue = value_t(0));
+    PiercedComponentStorage(const PiercedComponentStorage<value_t, id_t> &other);
+    PiercedComponentStorage(PiercedComponentStorage<value_t, id_t> &&other);
+
+    PiercedComponentStorage & operator=(const PiercedComponentStorage &other);
+    PiercedComponentStorage & operator=(PiercedComponentStorage &&other);
+
+    // Methods for accessing container properties
+    std::size_t getComponentCount() const;
+    std::size_t getMemoryUsage() const;
+    std::size_t rawSize() const;
+
+    const value_t & getHoleValue() const;
+    void setHoleValue(const value_t &holeValue);
+
+    // Methods that modify the container as a whole
+    void swap(PiercedComponentStorage &other) noexcept;
+    void fill(const value_t &value);
+    void fillHoles();
+
+    // Methods to access the components
+    value_t * rawComponentData(std::size_t k);
+    const value_t * rawComponentData(std::size_t k) const;
+
+    // Methods for editing the items using their id
+    value_t & at(id_t id, std::size_t k = 0);
+    const value_t & at(id_t id, std::size_t k = 0) const;
+
+    void copy(id_t id, value_t *values) const;
+    void set(id_t id, const value_t *values);
+
+    // Methods for editing the items using their position
+    value_t & rawAt(std::size_t pos, std::size_t k = 0);
+    const value_t & rawAt(std::size_t pos, std::size_t k = 0) const;
+
+    void rawCopy(std::size_t pos, value_t *values) const;
+    void rawSet(std::size_t pos, const value_t *values);
+
+    // Dump and restore
+    void restore(std::istream &stream);
+    void dump(std::ostream &stream) const;
+
+protected:
+    // Methods for synchronizing the storage
+    void _postSetStaticKernel() override;
+    void _postSetDynamicKernel() override;
+    void _postUnsetKernel(bool release = true) override;
+
+    void commitSyncAction(const PiercedSyncAction &action) override;
+
+    // Methods for updating the storage
+    void rawReserve(std::size_t n);
+    void rawShrinkToFit();
+    void rawClear(bool release);
+    void rawResize(std::size_t n);
+    void rawSwap(std::size_t pos_first, std::size_t pos_second);
+    void rawReorder(const std::vector<std::size_t> &permutations);
+    void rawMove(std::size_t sourcePos, std::size_t targetPos);
+    void rawGather(const std::vector<std::size_t> &moves, std::size_t keptSize, std::size_t size);
+    void rawInsertHole(std::size_t pos);
+    void rawAppendHole();
+    void rawSetHole(std::size_t pos);
+
+private:
+    std::vector<component_t> m_components;
+    value_t m_holeValue;
+
+};
+
+}
+
+// Templates
+#include "piercedComponentStorage.tpp"
+
+#endif
@@ -0,0 +1,889 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_COMPONENT_STORAGE_TPP__
+#define __BITPIT_PIERCED_COMPONENT_STORAGE_TPP__
+
+namespace bitpit {
+
+/**
+* Constructor.
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t>::PiercedComponentStorage()
+    : PiercedStorageSyncSlave<id_t>(), m_components(1), m_holeValue(0)
+{
+}
+
+/**
+* Constructor.
+*
+* \param nComponents is the number of components in the storage
+* \param holeValue is the value that will be assigned to the holes
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t>::PiercedComponentStorage(std::size_t nComponents, const value_t &holeValue)
+    : PiercedStorageSyncSlave<id_t>(), m_components(nComponents), m_holeValue(holeValue)
+{
+}
+
+/**
+* Constructor.
+*
+* \param nComponents is the number of components in the storage
+* \param kernel is the kernel that will be set
+* \param holeValue is the value that will be assigned to the holes
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t>::PiercedComponentStorage(std::size_t nComponents, const PiercedKernel<id_t> *kernel, const value_t &holeValue)
+    : PiercedStorageSyncSlave<id_t>(kernel), m_components(nComponents), m_holeValue(holeValue)
+{
+    // Base class constructor cannot call virtual functions
+    _postSetStaticKernel();
+}
+
+/**
+* Constructor.
+*
+* \param nComponents is the number of components in the storage
+* \param kernel is the kernel that will be set
+* \param syncMode is the synchronization mode that will be used for the storage
+* \param holeValue is the value that will be assigned to the holes
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t>::PiercedComponentStorage(std::size_t nComponents, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode, const value_t &holeValue)
+    : PiercedStorageSyncSlave<id_t>(kernel, syncMode), m_components(nComponents), m_holeValue(holeValue)
+{
+    // Base class constructor cannot call virtual functions
+    _postSetStaticKernel();
+    _postSetDynamicKernel();
+}
+
+/**
+* Constructor.
+*
+* \param other is another container of the same type (i.e., instantiated with
+* the same template parameters) whose content is copied in this container
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t>::PiercedComponentStorage(const PiercedComponentStorage<value_t, id_t> &other)
+    : PiercedStorageSyncSlave<id_t>(other),
+      m_components(other.m_components), m_holeValue(other.m_holeValue)
+{
+    // Base class constructor cannot call virtual functions
+    if (this->getKernel()) {
+        _postSetStaticKernel();
+
+        KernelType kernelType = this->getKernelType();
+        if (kernelType == this->KERNEL_DYNAMIC) {
+            _postSetDynamicKernel();
+        }
+    }
+}
+
+/**
+* Constructor.
+*
+* In the initializer list, the copy constructor of base class
+* PiercedStorageSyncSlave should be called. This prevents the
+* storage to be unregistered before having the chance to move
+* its contents (when a storage is unregistered its contents are
+* cleared). The other storage will be unregistered only after
+* its content is properly moved.
+*
+* \param other is another container of the same type (i.e., instantiated with
+* the same template parameters) whose content is moved in this container
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t>::PiercedComponentStorage(PiercedComponentStorage<value_t, id_t> &&other)
+    : PiercedStorageSyncSlave<id_t>(other),
+      m_components(std::move(other.m_components)), m_holeValue(other.m_holeValue)
+{
+    // Base class constructor cannot call virtual functions
+    if (this->getKernel()) {
+        _postSetStaticKernel();
+
+        KernelType kernelType = this->getKernelType();
+        if (kernelType == this->KERNEL_DYNAMIC) {
+            _postSetDynamicKernel();
+        }
+    }
+
+    // Explicitly reset the components of the other storage
+    other.m_components.clear();
+}
+
+/**
+* Copy assignment operator.
+*
+* \param other is another container of the same type (i.e., instantiated with
+* the same template parameters) whose content is copied in this container
+* \return A reference to the pierced storage.
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t> & PiercedComponentStorage<value_t, id_t>::operator=(const PiercedComponentStorage<value_t, id_t> &other)
+{
+    PiercedComponentStorage<value_t, id_t> temporary(other);
+    temporary.swap(*this);
+
+    return *this;
+}
+
+/**
+* Move assignment operator.
+*
+* \param other is another container of the same type (i.e., instantiated with
+* the same template parameters) whose content is moved in this container
+* \return A reference to the pierced storage.
+*/
+template<typename value_t, typename id_t>
+PiercedComponentStorage<value_t, id_t> & PiercedComponentStorage<value_t, id_t>::operator=(PiercedComponentStorage<value_t, id_t> &&other)
+{
+    PiercedComponentStorage<value_t, id_t> temporary(std::move(other));
+    temporary.swap(*this);
+
+    return *this;
+}
+
+/**
+* Gets the number of components in the storage.
+*
+* \result The number of components in the storage.
+*/
+template<typename value_t, typename id_t>
+std::size_t PiercedComponentStorage<value_t, id_t>::getComponentCount() const
+{
+    return m_components.size();
+}
+
+/**
+* Evaluates the memory allocated by the storage.
+*
+* The memory used by the storage includes the memory allocated for the
+* values of all the positions of the kernel, holes included. The memory
+* occupied by the storage object itself is not included.
+*
+* \result The memory, expressed in bytes, allocated by the storage.
+*/
+template<typename value_t, typename id_t>
+std::size_t PiercedComponentStorage<value_t, id_t>::getMemoryUsage() const
+{
+    std::size_t memory = m_components.capacity() * sizeof(component_t);
+    for (const component_t &component : m_components) {
+        memory += utils::getMemoryUsage(component);
+    }
+
+    return memory;
+}
+
+/**
+* Returns the number of raw positions in the storage.
+*
+* This is the number of values stored in each component buffer, holes
+* included. If the storage is synchronized with its kernel, this is also
+* the number of raw positions of the kernel.
+*
+* \result The number of raw positions in the storage.
+*/
+template<typename value_t, typename id_t>
+std::size_t PiercedComponentStorage<value_t, id_t>::rawSize() const
+{
+    if (m_components.empty()) {
+        return 0;
+    }
+
+    return m_components[0].size();
+}
+
+/**
+* Gets the value assigned to the holes.
+*
+* \result The value assigned to the holes.
+*/
+template<typename value_t, typename id_t>
+const value_t & PiercedComponentStorage<value_t, id_t>::getHoleValue() const
+{
+    return m_holeValue;
+}
+
+/**
+* Sets the value assigned to the holes.
+*
+* The value is immediately assigned to all the current holes of the storage.
+*
+* \param holeValue is the value that will be assigned to the holes
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::setHoleValue(const value_t &holeValue)
+{
+    m_holeValue = holeValue;
+
+    fillHoles();
+}
+
+/**
+* Exchanges the content of the storage by the content of x, which is another
+* storage object of the same type. Sizes may differ but the number of
+* components has to be the same.
+*
+* \param other is another storage of the same type (i.e., instantiated with the
+* same template parameters) whose content is swapped with that of this
+* storage.
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::swap(PiercedComponentStorage &other) noexcept
+{
+    // It is only possible to swap two storages with the same number of
+    // components. If this condition is not fulfilled we can not continue.
+    // However, we cannot throw an exception because the function is
+    // declared noexcept.
+    if (other.getComponentCount() != getComponentCount()) {
+        std::cout << "It is only possible to swap storages with the same number of components." << std::endl;
+        assert(false);
+        exit(EXIT_FAILURE);
+    }
+
+    PiercedStorageSyncSlave<id_t>::swap(other);
+    std::swap(other.m_components, m_components);
+    std::swap(other.m_holeValue, m_holeValue);
+}
+
+/**
+* Assigns the given value to all the elements in the storage.
+*
+* Holes are left untouched.
+*
+* \param value is the value to be assigned
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::fill(const value_t &value)
+{
+    for (component_t &component : m_components) {
+        std::fill(component.begin(), component.end(), value);
+    }
+
+    fillHoles();
+}
+
+/**
+* Assigns the hole value to all the holes of the storage.
+*
+* Holes are updated automatically while the storage is synchronized with
+* its kernel. This function is only needed if the storage has been modified
+* through raw access or if it is not synchronized with its kernel.
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::fillHoles()
+{
+    if (!this->m_kernel) {
+        return;
+    }
+
+    std::size_t nPositions = std::min(rawSize(), this->m_kernel->rawSize());
+    for (std::size_t pos = 0; pos < nPositions; ++pos) {
+        if (this->m_kernel->isPosEmpty(pos)) {
+            rawSetHole(pos);
+        }
+    }
+}
+
+/**
+* Gets a pointer to the buffer that stores the specified component.
+*
+* The buffer contains the values of the component for all the raw positions
+* of the kernel and its first element is aligned to
+* utils::memory::SIMD_ALIGNMENT bytes. Holes contain the hole value.
+*
+* \param k is the index of the component
+* \result A pointer to the buffer that stores the specified component.
+*/
+template<typename value_t, typename id_t>
+value_t * PiercedComponentStorage<value_t, id_t>::rawComponentData(std::size_t k)
+{
+    return m_components[k].data();
+}
+
+/**
+* Gets a constant pointer to the buffer that stores the specified component.
+*
+* The buffer contains the values of the component for all the raw positions
+* of the kernel and its first element is aligned to
+* utils::memory::SIMD_ALIGNMENT bytes. Holes contain the hole value.
+*
+* \param k is the index of the component
+* \result A constant pointer to the buffer that stores the specified
+* component.
+*/
+template<typename value_t, typename id_t>
+const value_t * PiercedComponentStorage<value_t, id_t>::rawComponentData(std::size_t k) const
+{
+    return m_components[k].data();
+}
+
+/**
+* Gets a reference to the specified component of the element with the
+* given id.
+*
+* \param id is the id of the element
+* \param k is the index of the component
+* \result A reference to the specified component of the element.
+*/
+template<typename value_t, typename id_t>
+value_t & PiercedComponentStorage<value_t, id_t>::at(id_t id, std::size_t k)
+{
+    return rawAt(this->m_kernel->getPos(id), k);
+}
+
+/**
+* Gets a constant reference to the specified component of the element with
+* the given id.
+*
+* \param id is the id of the element
+* \param k is the index of the component
+* \result A constant reference to the specified component of the element.
+*/
+template<typename value_t, typename id_t>
+const value_t & PiercedComponentStorage<value_t, id_t>::at(id_t id, std::size_t k) const
+{
+    return rawAt(this->m_kernel->getPos(id), k);
+}
+
+/**
+* Copies all the components of the element with the given id.
+*
+* \param id is the id of the element
+* \param[out] values on output will contain the components of the element
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::copy(id_t id, value_t *values) const
+{
+    rawCopy(this->m_kernel->getPos(id), values);
+}
+
+/**
+* Sets all the components of the element with the given id.
+*
+* \param id is the id of the element
+* \param values are the values that will be assigned to the components
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::set(id_t id, const value_t *values)
+{
+    rawSet(this->m_kernel->getPos(id), values);
+}
+
+/**
+* Gets a reference to the specified component of the element at the given
+* raw position.
+*
+* \param pos is the raw position of the element
+* \param k is the index of the component
+* \result A reference to the specified component of the element.
+*/
+template<typename value_t, typename id_t>
+value_t & PiercedComponentStorage<value_t, id_t>::rawAt(std::size_t pos, std::size_t k)
+{
+    return m_components[k][pos];
+}
+
+/**
+* Gets a constant reference to the specified component of the element at
+* the given raw position.
+*
+* \param pos is the raw position of the element
+* \param k is the index of the component
+* \result A constant reference to the specified component of the element.
+*/
+template<typename value_t, typename id_t>
+const value_t & PiercedComponentStorage<value_t, id_t>::rawAt(std::size_t pos, std::size_t k) const
+{
+    return m_components[k][pos];
+}
+
+/**
+* Copies all the components of the element at the given raw position.
+*
+* \param pos is the raw position of the element
+* \param[out] values on output will contain the components of the element
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawCopy(std::size_t pos, value_t *values) const
+{
+    std::size_t nComponents = getComponentCount();
+    for (std::size_t k = 0; k < nComponents; ++k) {
+        values[k] = m_components[k][pos];
+    }
+}
+
+/**
+* Sets all the components of the element at the given raw position.
+*
+* \param pos is the raw position of the element
+* \param values are the values that will be assigned to the components
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawSet(std::size_t pos, const value_t *values)
+{
+    std::size_t nComponents = getComponentCount();
+    for (std::size_t k = 0; k < nComponents; ++k) {
+        m_components[k][pos] = values[k];
+    }
+}
+
+/**
+* Internal function that will be called after setting a static kernel.
+*
+* The storage will NOT be synchronized with the kernel. Every change to the
+* kernel can potentially invalidate the link between kernel and storage.
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::_postSetStaticKernel()
+{
+    // Resize the storage
+    rawResize(this->m_kernel->rawSize());
+    rawShrinkToFit();
+
+    // Initialize the holes
+    fillHoles();
+}
+
+/**
+* Internal function that will be called after setting a dynamic kernel.
+*
+* The storage will dynamically synchronized with the kernel.
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::_postSetDynamicKernel()
+{
+    // Nothing to do
+}
+
+/**
+* Internal function that will be called after unsetting the kernel.
+*
+* \param release if it's true the memory hold by the container will
+* be released, otherwise the container will be cleared but its
+* memory will not be released
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::_postUnsetKernel(bool release)
+{
+    // Clear the storage
+    rawClear(release);
+}
+
+/**
+* Commit the specified synchronization action.
+*
+* Pierced positions and positions created by the action are assigned the
+* hole value. A TYPE_PIERCE_MULTIPLE action notifies that the holes of the
+* kernel have changed, when it is received the storage is synchronized with
+* the kernel and the holes can be evaluated from the kernel.
+*
+* \param action is the synchronization action that will be commited
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::commitSyncAction(const PiercedSyncAction &action)
+{
+    switch (action.type) {
+
+    case PiercedSyncAction::TYPE_CLEAR:
+    {
+        rawClear(true);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_RESERVE:
+    {
+        rawReserve(action.info[PiercedSyncAction::INFO_SIZE]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_RESIZE:
+    case PiercedSyncAction::TYPE_APPEND_MULTIPLE:
+    {
+        rawResize(action.info[PiercedSyncAction::INFO_SIZE]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_SHRINK_TO_FIT:
+    {
+        rawShrinkToFit();
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_REORDER:
+    {
+        if (action.data && action.data->size() > 0) {
+            rawReorder(*action.data);
+        }
+        rawResize(action.info[PiercedSyncAction::INFO_SIZE]);
+        rawShrinkToFit();
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_APPEND:
+    {
+        rawAppendHole();
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_MOVE_MULTIPLE:
+    {
+        rawGather(*action.data, action.info[PiercedSyncAction::INFO_POS], action.info[PiercedSyncAction::INFO_SIZE]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_INSERT:
+    {
+        rawInsertHole(action.info[PiercedSyncAction::INFO_POS]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_OVERWRITE:
+    case PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE:
+    {
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_MOVE_APPEND:
+    {
+        // If the moved element was the last one, the kernel may have been
+        // shrunk before appending the element, hence the element may end up
+        // in a position that is already in the storage.
+        std::size_t sourcePos = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t targetPos = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        if (targetPos >= rawSize()) {
+            rawAppendHole();
+        }
+
+        if (sourcePos != targetPos) {
+            rawMove(sourcePos, targetPos);
+            rawSetHole(sourcePos);
+        }
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_MOVE_INSERT:
+    {
+        std::size_t sourcePos = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t targetPos = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        rawInsertHole(targetPos);
+
+        // Elements after the inserted one have been shifted
+        if (sourcePos >= targetPos) {
+            ++sourcePos;
+        }
+
+        rawMove(sourcePos, targetPos);
+        rawSetHole(sourcePos);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_MOVE_OVERWRITE:
+    {
+        std::size_t sourcePos = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t targetPos = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        if (sourcePos != targetPos) {
+            rawMove(sourcePos, targetPos);
+            rawSetHole(sourcePos);
+        }
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_PIERCE:
+    {
+        rawSetHole(action.info[PiercedSyncAction::INFO_POS]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_PIERCE_MULTIPLE:
+    {
+        fillHoles();
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_SWAP:
+    {
+        rawSwap(action.info[PiercedSyncAction::INFO_POS_FIRST], action.info[PiercedSyncAction::INFO_POS_SECOND]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_NOOP:
+    {
+        break;
+    }
+
+    default:
+    {
+        throw std::runtime_error("Undefined synchronization action.");
+    }
+
+    }
+}
+
+/**
+* Requests that the storage capacity be at least enough to contain n elements.
+*
+* \param n is the minimum capacity requested for the storage, expressed
+* in number of elements
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawReserve(std::size_t n)
+{
+    for (component_t &component : m_components) {
+        component.reserve(n);
+    }
+}
+
+/**
+* Requests the storage to reduce its capacity to fit its size.
+*
+* The request is non-binding, and the function can leave the storage with a
+* capacity greater than its size.
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawShrinkToFit()
+{
+    for (component_t &component : m_components) {
+        component.shrink_to_fit();
+    }
+}
+
+/**
+* Clears the contents of the storage.
+*
+* \param release if it's true the memory hold by the container will
+* be released, otherwise the container will be cleared but its
+* memory will not be relased
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawClear(bool release)
+{
+    for (component_t &component : m_components) {
+        if (release) {
+            component_t().swap(component);
+        } else {
+            component.clear();
+        }
+    }
+}
+
+/**
+* Resizes the storage so that it contains n elements.
+*
+* New elements are assigned the hole value.
+*
+* \param n is the new storage size, expressed in number of elements
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawResize(std::size_t n)
+{
+    for (component_t &component : m_components) {
+        component.resize(n, m_holeValue);
+    }
+}
+
+/**
+* Swaps two elements.
+*
+* \param pos_first is the position of the first element that will be swapped
+* \param pos_second is the position of the second element that will be swapped
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawSwap(std::size_t pos_first, std::size_t pos_second)
+{
+    for (component_t &component : m_components) {
+        std::swap(component[pos_first], component[pos_second]);
+    }
+}
+
+/**
+* Reorder the storage according to the specified permutations.
+*
+* Each component is gathered into a new buffer, this is faster than an
+* in-place reorder for the small values held by the storage. Components
+* whose buffer exceeds utils::getReorderMemoryLimit() are reordered in
+* place.
+*
+* \param permutations are the permutations that wil be applied
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawReorder(const std::vector<std::size_t> &permutations)
+{
+    std::size_t storageRawSize = rawSize();
+    assert(permutations.size() == storageRawSize);
+
+    for (component_t &component : m_components) {
+        utils::permuteVector(permutations, component, storageRawSize);
+    }
+}
+
+/**
+* Moves all the components of an element to another position.
+*
+* \param sourcePos is the position of the element that will be moved
+* \param targetPos is the position the element will be moved to
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawMove(std::size_t sourcePos, std::size_t targetPos)
+{
+    for (component_t &component : m_components) {
+        component[targetPos] = component[sourcePos];
+    }
+}
+
+/**
+* Moves the elements of the storage in a single pass.
+*
+* See PiercedStorage::rawGather for a description of the arguments. Elements
+* that are reset by the moves are assigned the hole value.
+*
+* \param moves are the moves that will be applied
+* \param keptSize is the number of elements preserved by the moves, if it
+* is equal to the maximum value of std::size_t, all elements are preserved
+* \param size is the final size of the storage, if it is equal to the
+* maximum value of std::size_t, the size of the storage will not be changed
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawGather(const std::vector<std::size_t> &moves, std::size_t keptSize, std::size_t size)
+{
+    const std::size_t UNDEFINED_POS = std::numeric_limits<std::size_t>::max();
+
+    std::size_t nMoves = moves.size() / 2;
+
+    // Evaluate the final size of the storage
+    std::size_t initialSize = rawSize();
+
+    std::size_t finalSize = initialSize;
+    if (keptSize != UNDEFINED_POS && keptSize < finalSize) {
+        finalSize = keptSize;
+    }
+
+    // Gather the components
+    //
+    // Components are processed one at a time, this keeps the values that
+    // are moved in cache.
+    std::vector<value_t> movedValues(nMoves);
+    for (component_t &component : m_components) {
+        for (std::size_t i = 0; i < nMoves; ++i) {
+            std::size_t source = moves[2 * i + 1];
+            if (source != UNDEFINED_POS) {
+                movedValues[i] = component[source];
+            } else {
+                movedValues[i] = m_holeValue;
+            }
+        }
+
+        component.resize(finalSize);
+        if (size != UNDEFINED_POS) {
+            component.resize(size, m_holeValue);
+        }
+
+        for (std::size_t i = 0; i < nMoves; ++i) {
+            component[moves[2 * i]] = movedValues[i];
+        }
+    }
+}
+
+/**
+* Inserts an element at the specified position, the element is assigned the
+* hole value.
+*
+* \param pos is the position where the new element will be inserted
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawInsertHole(std::size_t pos)
+{
+    for (component_t &component : m_components) {
+        component.insert(component.begin() + pos, m_holeValue);
+    }
+}
+
+/**
+* Adds a new element at the end of the storage, the element is assigned the
+* hole value.
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawAppendHole()
+{
+    for (component_t &component : m_components) {
+        component.push_back(m_holeValue);
+    }
+}
+
+/**
+* Assigns the hole value to all the components of the element at the
+* specified position.
+*
+* \param pos is the position of the element
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::rawSetHole(std::size_t pos)
+{
+    for (component_t &component : m_components) {
+        component[pos] = m_holeValue;
+    }
+}
+
+/**
+* Restore the storage.
+*
+* \param stream is the stream data should be read from
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::restore(std::istream &stream)
+{
+    // Size
+    std::size_t nElements;
+    utils::binary::read(stream, nElements);
+    rawResize(nElements);
+
+    // Components
+    for (component_t &component : m_components) {
+        utils::binary::read(stream, component.data(), nElements * sizeof(value_t));
+    }
+}
+
+/**
+* Dump the storage.
+*
+* \param stream is the stream data should be written to
+*/
+template<typename value_t, typename id_t>
+void PiercedComponentStorage<value_t, id_t>::dump(std::ostream &stream) const
+{
+    // Size
+    std::size_t nElements = rawSize();
+    utils::binary::write(stream, nElements);
+
+    // Components
+    for (const component_t &component : m_components) {
+        utils::binary::write(stream, component.data(), nElements * sizeof(value_t));
+    }
+}
+
+}
+
+#endif
@@ -28,13 +28,13 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
-#include <unordered_map>
 #include <type_traits>
 #include <vector>
 
 #include "bitpit_common.hpp"
 
 #include "piercedSync.hpp"
+#include "piercedKernelIndex.hpp"
 #include "piercedKernelIterator.hpp"
 #include "piercedKernelRange.hpp"
 
@@ -100,6 +100,17 @@ protected:
 * found, the search is extended to regular holes. If, among the holes, there
 * is no suitable position, a new element is added in the container.
 *
+* Pending holes are flushed only by the functions that modify the kernel,
+* constant functions never update the internal state of the kernel: when
+* iterating over a position that is a pending hole, the iterator scans the
+* following positions until it reaches a non-empty element. Therefore, any
+* number of threads can concurrently call the constant functions of the
+* kernel (e.g., find, count, iteration over the elements or over the ranges
+* returned by split) and create or destroy storages associated with the
+* kernel, as long as no thread modifies the kernel at the same time. Calling
+* flush before starting the threads ensures that the iterators will not
+* need to scan the pending holes (see isIteratorSlow).
+*
 * \tparam id_t The type of the ids to associate to the elements
 */
 template<typename id_t = long>
@@ -109,7 +120,7 @@ static_assert(std::is_integral<id_t>::value, "Signed integer required for id.");
 static_assert(std::numeric_limits<id_t>::is_signed, "Signed integer required for id.");
 
 // Friendships
-template<typename PSI_value_t, typename PSI_id_t, typename PSI_value_no_cv_t>
+template<typename PSI_value_t, typename PSI_id_t, typename PSI_allocator_t, typename PSI_value_no_cv_t>
 friend class PiercedStorageIterator;
 
 template<typename PKI_id_t>
@@ -121,9 +132,12 @@ friend class PiercedKernelRange;
 template<typename BPS_id_t>
 friend class PiercedStorageSyncSlave;
 
-template<typename PS_value_t, typename PS_id_t>
+template<typename PS_value_t, typename PS_id_t, typename PS_allocator_t>
 friend class PiercedStorage;
 
+template<typename PCS_value_t, typename PCS_id_t>
+friend class PiercedComponentStorage;
+
 public:
     /**
     * Type of ids stored in the kernel
@@ -196,7 +210,8 @@ public:
             TYPE_UNDEFINED = PiercedSyncAction::TYPE_UNDEFINED,
             TYPE_OVERWRITE = PiercedSyncAction::TYPE_OVERWRITE,
             TYPE_INSERT    = PiercedSyncAction::TYPE_INSERT,
-            TYPE_APPEND    = PiercedSyncAction::TYPE_APPEND
+            TYPE_APPEND    = PiercedSyncAction::TYPE_APPEND,
+            TYPE_APPEND_MULTIPLE = PiercedSyncAction::TYPE_APPEND_MULTIPLE
         };
 
         FillAction(FillActionType type)
@@ -355,6 +370,12 @@ public:
     SortAction sort();
     SortAction sortAfter(id_t referenceId, bool inclusive);
     SortAction sortBefore(id_t referenceId, bool inclusive);
+    template<typename Compare>
+    SortAction sort(Compare comp);
+    template<typename Compare>
+    SortAction sortAfter(id_t referenceId, bool inclusive, Compare comp);
+    template<typename Compare>
+    SortAction sortBefore(id_t referenceId, bool inclusive, Compare comp);
     SqueezeAction squeeze();
     ShrinkToFitAction shrinkToFit();
 
@@ -366,10 +387,12 @@ public:
     bool contiguous() const;
     void dump() const;
     bool empty() const;
-    bool isIteratorSlow();
+    bool isIteratorSlow() const;
     std::size_t maxSize() const;
     std::size_t size() const;
     std::size_t capacity() const;
+    std::size_t getMemoryUsage() const;
+    typename PiercedKernelIndex<id_t>::IndexMode getIndexMode() const;
 
     // Methods that extract information about the elements of the kernel
     bool contains(id_t id) const;
@@ -380,6 +403,9 @@ public:
     std::vector<id_t> getIds(bool ordered = true) const;
     id_t getSizeMarker(std::size_t targetSize, const id_t &fallback = -1);
 
+    // Methods for splitting the kernel into ranges
+    std::vector<const_range> split(std::size_t nChunks) const;
+
     // Iterators
     const_iterator find(const id_t &id) const noexcept;
 
@@ -401,6 +427,7 @@ public:
     FillAction fillAfter(id_t referenceId, id_t id);
     FillAction fillBefore(id_t referenceId, id_t id);
     FillAction fillAppend(id_t id);
+    FillAction fillAppendRange(std::size_t nIds, const id_t *ids);
     FillAction fillHole(std::size_t hole, id_t id);
     FillAction fillInsert(std::size_t pos, id_t id);
 
@@ -451,11 +478,15 @@ protected:
     std::size_t getFirstUsedPos() const;
     std::size_t getLastUsedPos() const;
 
+    std::vector<std::size_t> evalChunkBoundaries(std::size_t nChunks) const;
+
     // Methods that modify the kernel as a whole
     ClearAction _clear(bool release = true);
     ReserveAction _reserve(std::size_t n);
     ResizeAction _resize(std::size_t n);
     SortAction _sort(std::size_t begin, std::size_t end);
+    template<typename PositionCompare>
+    SortAction _sort(std::size_t begin, std::size_t end, PositionCompare comp);
     SqueezeAction _squeeze();
     ShrinkToFitAction _shrinkToFit();
 
@@ -464,37 +495,6 @@ protected:
     std::vector<const PiercedStorageSyncSlave<id_t> *> getStorages() const;
 
 private:
-    /**
-    * Hasher for the id map.
-    *
-    * Since the id are uniques, the hasher can be a function that
-    * takes the id and cast it to a std::size_t.
-    *
-    * The hasher is defined as a struct, because a struct can be
-    * passed as an object into metafunctions (meaning that the type
-    * deduction for the template paramenters can take place, and
-    * also meaning that inlining is easier for the compiler). A bare
-    * function would have to be passed as a function pointer.
-    * To transform a function template into a function pointer,
-    * the template would have to be manually instantiated (with a
-    * perhaps unknown type argument).
-    */
-    struct PiercedHasher {
-        /**
-        * Function call operator that casts the specified
-        * value to a std::size_t.
-        *
-        * \tparam U type of the value
-        * \param value is the value to be casted
-        * \result Returns the value casted to a std::size_t.
-        */
-        template<typename U>
-        constexpr std::size_t operator()(U&& value) const noexcept
-        {
-            return static_cast<std::size_t>(std::forward<U>(value));
-        }
-    };
-
     /**
     * Compares the id of the elements in the specified position.
     *
@@ -530,6 +530,29 @@ private:
         }
     };
 
+    /**
+    * Compares the elements in the specified positions using a user-defined
+    * comparison function that receives in input the ids of the elements.
+    *
+    * The positions that are compared should not be holes.
+    */
+    template<typename Compare>
+    struct idCompare
+    {
+        const std::vector<id_t> &m_ids;
+        Compare m_comp;
+
+        idCompare(const std::vector<id_t> &ids, Compare comp)
+            : m_ids(ids), m_comp(comp)
+        {
+        }
+
+        inline bool operator() (std::size_t pos_x, std::size_t pos_y)
+        {
+            return m_comp(m_ids[pos_x], m_ids[pos_y]);
+        }
+    };
+
     /**
     * Maximum number of pending deletes before the changes are flushed.
     */
@@ -541,10 +564,10 @@ private:
     std::vector<id_t> m_ids;
 
     /**
-    * Map that links the id of the elements and their position inside the
+    * Index that links the id of the elements and their position inside the
     * internal vector.
     */
-    std::unordered_map<id_t, std::size_t, PiercedHasher> m_pos;
+    PiercedKernelIndex<id_t> m_pos;
 
     /**
     * Position of the first element in the internal vector.
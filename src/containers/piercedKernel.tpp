@@ -115,10 +115,9 @@ typename PiercedKernel<id_t>::ClearAction PiercedKernel<id_t>::_clear(bool relea
 {
     // Clear positions
     m_ids.clear();
-    m_pos.clear();
+    m_pos.clear(release);
     if (release) {
         std::vector<id_t>().swap(m_ids);
-        std::unordered_map<id_t, std::size_t, PiercedHasher>().swap(m_pos);
     }
 
     // Reset begin and end
@@ -356,6 +355,87 @@ typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::sortBefore(id_t re
     return syncAction;
 }
 
+/**
+* Sorts the kernel using the specified comparison function.
+*
+* \param comp is the comparison function, it will receive in input the ids
+* of the two elements to compare and should return true if the first element
+* should be placed before the second one
+*/
+template<typename id_t>
+template<typename Compare>
+typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::sort(Compare comp)
+{
+    SortAction syncAction = _sort(m_begin_pos, m_end_pos, idCompare<Compare>(m_ids, comp));
+
+    // Update the storage
+    processSyncAction(syncAction);
+
+    return syncAction;
+}
+
+/**
+* Sorts the kernel after the element with the reference id using the
+* specified comparison function.
+*
+* \param referenceId is the id of the element after which the kernel will
+* be sorted
+* \param inclusive if true the reference element will be sorted, otherwise
+* the sorting will stop at the element following the reference
+* \param comp is the comparison function, it will receive in input the ids
+* of the two elements to compare and should return true if the first element
+* should be placed before the second one
+*/
+template<typename id_t>
+template<typename Compare>
+typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::sortAfter(id_t referenceId, bool inclusive, Compare comp)
+{
+    // Get the reference position
+    std::size_t referencePos = getPos(referenceId);
+    if (!inclusive) {
+        referencePos++;
+    }
+
+    // Sort the kernel
+    SortAction syncAction = _sort(referencePos, m_end_pos, idCompare<Compare>(m_ids, comp));
+
+    // Update the storage
+    processSyncAction(syncAction);
+
+    return syncAction;
+}
+
+/**
+* Sorts the kernel before the element with the reference id using the
+* specified comparison function.
+*
+* \param referenceId is the id of the element before which the kernel will
+* be sorted
+* \param inclusive if true the reference element will be sorted, otherwise
+* the sorting will stop at the element preceding the reference
+* \param comp is the comparison function, it will receive in input the ids
+* of the two elements to compare and should return true if the first element
+* should be placed before the second one
+*/
+template<typename id_t>
+template<typename Compare>
+typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::sortBefore(id_t referenceId, bool inclusive, Compare comp)
+{
+    // Get the reference position
+    std::size_t referencePos = getPos(referenceId);
+    if (inclusive) {
+        referencePos++;
+    }
+
+    // Sort the kernel
+    SortAction syncAction = _sort(m_begin_pos, referencePos, idCompare<Compare>(m_ids, comp));
+
+    // Update the storage
+    processSyncAction(syncAction);
+
+    return syncAction;
+}
+
 /**
 * Sorts the elements of the kernel in ascending id order.
 *
@@ -366,6 +446,26 @@ typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::sortBefore(id_t re
 */
 template<typename id_t>
 typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::_sort(std::size_t beginPos, std::size_t endPos)
+{
+    return _sort(beginPos, endPos, idLess(m_ids));
+}
+
+/**
+* Sorts the elements of the kernel using the specified comparison function.
+*
+* The kernel is squeezed before being sorted, hence the comparison function
+* will only be called on positions that contain an element.
+*
+* The function will NOT process the sync action.
+*
+* \param beginPos is the first position that will be sorted
+* \param endPos is the position past the last element that will be sorted
+* \param comp is the comparison function, it will receive in input the
+* positions of the two elements to compare
+*/
+template<typename id_t>
+template<typename PositionCompare>
+typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::_sort(std::size_t beginPos, std::size_t endPos, PositionCompare comp)
 {
     // Squeeze the kernel
     //
@@ -399,7 +499,7 @@ typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::_sort(std::size_t
         sortPermutations[i] = i;
     }
 
-    std::sort(sortPermutations.begin() + beginPos, sortPermutations.begin() + endPos, idLess(m_ids));
+    utils::threads::parallelSort(sortPermutations.begin() + beginPos, sortPermutations.begin() + endPos, comp);
 
     // Create the sync action
     SortAction syncAction;
@@ -416,14 +516,12 @@ typename PiercedKernel<id_t>::SortAction PiercedKernel<id_t>::_sort(std::size_t
 
     // Sort the ids
     //
-    // NOTE: the reorder function will destroy the permutation vector
-    utils::reorderVector<id_t>(sortPermutations, m_ids, updatedKernelRawSize);
-
-    // Update the positions
-    m_pos.clear();
-    for (std::size_t i = 0; i < updatedKernelRawSize; ++i) {
-        m_pos[m_ids[i]] = i;
-    }
+    // Only the ids inside the sort range are moved, hence only the positions
+    // of those ids need to be updated. The kernel has just been squeezed,
+    // therefore the ids are all in the position index and the positions can
+    // be updated without altering the structure of the index.
+    utils::permuteVector(sortPermutations, m_ids, endPos);
+    m_pos.update(m_ids.data() + beginPos, beginPos, endPos);
 
     // Return the permutations
     return syncAction;
@@ -508,18 +606,23 @@ typename PiercedKernel<id_t>::SqueezeAction PiercedKernel<id_t>::_squeeze()
                 continue;
             }
 
-            id_t id = m_ids[pos];
-            std::size_t updatedPos = pos - offset;
-
-            setPosId(updatedPos, id);
-            setPosEmptyId(pos, pos + 1);
-            permutations[updatedPos] = pos;
+            permutations[pos - offset] = pos;
         }
 
         for (std::size_t pos = m_end_pos; pos < rawSize(); ++pos) {
             permutations[pos] = pos;
         }
 
+        // Compact the ids
+        //
+        // The ids are compacted using the same permutation that will be sent
+        // to the storages, holes are moved after the last element and will be
+        // removed when the kernel is shrunk. The ids of the moved elements are
+        // all in the position index, hence their positions can be updated
+        // without altering the structure of the index.
+        utils::permuteVector(permutations, m_ids, m_end_pos);
+        m_pos.update(m_ids.data() + firstPosToUpdate, firstPosToUpdate, kernelSize);
+
         // Clear the holes
         holesClear(true);
 
@@ -533,6 +636,13 @@ typename PiercedKernel<id_t>::SqueezeAction PiercedKernel<id_t>::_squeeze()
     // Shrink to fit
     _shrinkToFit();
 
+    // Choose the most suitable mode for the position index
+    //
+    // After the squeeze the kernel contains no holes, the ids it contains
+    // will not change until new elements are inserted, this is a good time
+    // to decide if the ids are dense enough to be indexed directly.
+    m_pos.optimize();
+
     return syncAction;
 }
 
@@ -602,7 +712,7 @@ void PiercedKernel<id_t>::swap(PiercedKernel &other) noexcept
     std::swap(other.m_end_pos, m_end_pos);
     std::swap(other.m_dirty_begin_pos, m_dirty_begin_pos);
     std::swap(other.m_ids, m_ids);
-    std::swap(other.m_pos, m_pos);
+    other.m_pos.swap(m_pos);
     std::swap(other.m_holes, m_holes);
     std::swap(other.m_holes_regular_begin, m_holes_regular_begin);
     std::swap(other.m_holes_regular_end, m_holes_regular_end);
@@ -667,9 +777,9 @@ void PiercedKernel<id_t>::dump() const
     std::cout << std::endl;
     std::cout << " Poistion map: " << std::endl;
     if (size() > 0) {
-        for (auto itr = m_pos.cbegin(); itr != m_pos.cend(); ++itr) {
-            std::cout << itr->first << " -> " << itr->second << std::endl;
-        }
+        m_pos.forEach([](id_t id, std::size_t pos) {
+            std::cout << id << " -> " << pos << std::endl;
+        });
     } else {
         std::cout << "None" << std::endl;
     }
@@ -684,15 +794,13 @@ template<typename id_t>
 void PiercedKernel<id_t>::checkIntegrity() const
 {
     // Check if the elements and their position match
-    for (const auto &entry : m_pos) {
-        id_t id = entry.first;
-        std::size_t pos = entry.second;
+    m_pos.forEach([this](id_t id, std::size_t pos) {
         if (m_ids[pos] != id) {
             std::cout << " Position " << pos << " should contain the element with id " << id << std::endl;
             std::cout << " but it contains the element with id " << m_ids[pos] << std::endl;
             throw std::runtime_error("Integrity check error");
         }
-    }
+    });
 
     for (std::size_t pos = m_begin_pos; pos < m_end_pos; ++pos) {
         id_t id = m_ids[pos];
@@ -792,7 +900,7 @@ bool PiercedKernel<id_t>::empty() const
 * the iterator, false otherwise.
 */
 template<typename id_t>
-bool PiercedKernel<id_t>::isIteratorSlow()
+bool PiercedKernel<id_t>::isIteratorSlow() const
 {
     return (m_dirty_begin_pos < m_end_pos);
 }
@@ -852,6 +960,46 @@ std::size_t PiercedKernel<id_t>::capacity() const
     return m_ids.capacity();
 }
 
+/**
+* Evaluates the memory allocated by the kernel.
+*
+* The memory used by the kernel includes the memory used for storing the
+* ids (holes included), the map between ids and positions and the list of
+* holes. When the map is stored as a hash table, its memory is an estimate,
+* because the memory allocated by an unordered map cannot be accessed
+* directly. The memory occupied by the kernel object itself is not included.
+*
+* \result The memory, expressed in bytes, allocated by the kernel.
+*/
+template<typename id_t>
+std::size_t PiercedKernel<id_t>::getMemoryUsage() const
+{
+    std::size_t memoryUsage = 0;
+    memoryUsage += utils::getMemoryUsage(m_ids);
+    memoryUsage += m_pos.getMemoryUsage();
+    memoryUsage += utils::getMemoryUsage(m_holes);
+
+    return memoryUsage;
+}
+
+/**
+* Gets the mode of the index that links the ids of the elements to their
+* positions.
+*
+* When the ids are dense, the positions are stored in a flat array indexed
+* by the id, otherwise they are stored in a hash map. The mode is chosen
+* automatically when the kernel is squeezed or sorted, moreover the index
+* switches to the hash map as soon as an id that is too sparse is inserted.
+*
+* \result The mode of the index that links the ids of the elements to their
+* positions.
+*/
+template<typename id_t>
+typename PiercedKernelIndex<id_t>::IndexMode PiercedKernel<id_t>::getIndexMode() const
+{
+    return m_pos.getMode();
+}
+
 /**
 * Checks if the kernel contains the specified id.
 *
@@ -1068,6 +1216,41 @@ id_t PiercedKernel<id_t>::getSizeMarker(std::size_t targetSize, const id_t &fall
     return m_ids[markerPos];
 }
 
+/**
+* Splits the kernel into the specified number of ranges.
+*
+* The kernel is split by raw position: each range covers a contiguous portion
+* of the raw positions of the kernel. Ranges are disjoint and, taken together,
+* they contain all the elements of the kernel. Since the ranges are evaluated
+* using raw positions, the number of elements in each range may not be the
+* same. Empty ranges are not returned, hence the number of ranges may be less
+* than the requested number of chunks.
+*
+* Ranges can be processed concurrently by different threads, as long as the
+* kernel is not modified while the ranges are in use.
+*
+* \param nChunks is the requested number of ranges
+* \result The ranges the kernel has been split into.
+*/
+template<typename id_t>
+std::vector<typename PiercedKernel<id_t>::const_range> PiercedKernel<id_t>::split(std::size_t nChunks) const
+{
+    std::vector<std::size_t> boundaries = evalChunkBoundaries(nChunks);
+
+    std::vector<const_range> chunks;
+    if (boundaries.size() < 2) {
+        return chunks;
+    }
+
+    std::size_t nActualChunks = boundaries.size() - 1;
+    chunks.reserve(nActualChunks);
+    for (std::size_t k = 0; k < nActualChunks; ++k) {
+        chunks.emplace_back(rawFind(boundaries[k]), rawFind(boundaries[k + 1]));
+    }
+
+    return chunks;
+}
+
 /**
 * Gets a constant iterator pointing to the specified element.
 *
@@ -1077,9 +1260,9 @@ id_t PiercedKernel<id_t>::getSizeMarker(std::size_t targetSize, const id_t &fall
 template<typename id_t>
 typename PiercedKernel<id_t>::const_iterator PiercedKernel<id_t>::find(const id_t &id) const noexcept
 {
-    auto iterator = m_pos.find(id);
-    if (iterator != m_pos.end()) {
-        return rawFind(iterator->second);
+    std::size_t pos = m_pos.find(id);
+    if (pos != PiercedKernelIndex<id_t>::NOT_FOUND) {
+        return rawFind(pos);
     } else {
         return end();
     }
@@ -1192,6 +1375,52 @@ std::size_t PiercedKernel<id_t>::getLastUsedPos() const
     return m_end_pos - 1;
 }
 
+/**
+* Evaluates the raw positions that split the kernel into the specified
+* number of chunks.
+*
+* The raw positions of the kernel are split into contiguous portions of
+* (roughly) the same size. The first position of each portion is then moved
+* forward to the first non-empty position. Portions that don't contain any
+* element are discarded.
+*
+* \param nChunks is the requested number of chunks
+* \result The boundaries of the chunks. The k-th chunk starts at the k-th
+* boundary and ends before the (k+1)-th boundary. The last boundary is the
+* end position of the kernel. If the kernel is empty, no boundaries are
+* returned.
+*/
+template<typename id_t>
+std::vector<std::size_t> PiercedKernel<id_t>::evalChunkBoundaries(std::size_t nChunks) const
+{
+    std::vector<std::size_t> boundaries;
+    if (empty() || nChunks == 0) {
+        return boundaries;
+    }
+
+    std::size_t span = m_end_pos - m_begin_pos;
+    nChunks = std::min(nChunks, span);
+
+    boundaries.reserve(nChunks + 1);
+    boundaries.push_back(m_begin_pos);
+    for (std::size_t k = 1; k < nChunks; ++k) {
+        std::size_t pos = m_begin_pos + (span * k) / nChunks;
+
+        // The last position of the kernel is never empty, hence there is
+        // always a non-empty position after an empty one.
+        if (isPosEmpty(pos)) {
+            pos = findNextUsedPos(pos);
+        }
+
+        if (pos > boundaries.back()) {
+            boundaries.push_back(pos);
+        }
+    }
+    boundaries.push_back(m_end_pos);
+
+    return boundaries;
+}
+
 
 /**
 * Fills a position and assigns to it the specified id.
@@ -1376,7 +1605,7 @@ typename PiercedKernel<id_t>::FillAction PiercedKernel<id_t>::fillAppend(id_t id
     setEndPos(rawSize());
 
     // Update the id map
-    m_pos[id] = m_end_pos - 1;
+    m_pos.set(id, m_end_pos - 1);
 
     // Update the storage
     FillAction fillAction(FillAction::TYPE_APPEND);
@@ -1387,6 +1616,68 @@ typename PiercedKernel<id_t>::FillAction PiercedKernel<id_t>::fillAppend(id_t id
     return fillAction;
 }
 
+/**
+* Fills multiple positions and assigns to them the specified ids.
+*
+* The new positions are created at the end of the kernel, following the
+* order of the ids. Storages are synchronized using a single action, hence
+* they will be resized only once. If one of the ids is not valid, the
+* kernel is not modified and an exception is thrown.
+*
+* \param nIds is the number of ids that will be added
+* \param ids are the ids that will be associated to the positions
+* \result The synchronization action associated with the fill. The action
+* contains the position of the first element that has been added and the
+* raw size of the kernel after the fill.
+*/
+template<typename id_t>
+typename PiercedKernel<id_t>::FillAction PiercedKernel<id_t>::fillAppendRange(std::size_t nIds, const id_t *ids)
+{
+    // Check if the ids are valid
+    for (std::size_t k = 0; k < nIds; ++k) {
+        validateId(ids[k]);
+    }
+
+    // Add the ids
+    std::size_t previousRawSize = rawSize();
+    std::size_t previousEndPos  = m_end_pos;
+    std::size_t previousSize    = m_pos.size();
+
+    m_ids.insert(m_ids.end(), ids, ids + nIds);
+
+    // Update last used position
+    setEndPos(rawSize());
+
+    // Update the id map
+    for (std::size_t k = 0; k < nIds; ++k) {
+        m_pos.set(ids[k], previousRawSize + k);
+    }
+
+    // Handle duplicate ids
+    //
+    // If the range contains duplicate ids, the number of elements in the
+    // id map will be lower than expected. The ids that have been added
+    // were not in the kernel, hence the changes can be easily reverted.
+    if (m_pos.size() != (previousSize + nIds)) {
+        for (std::size_t k = 0; k < nIds; ++k) {
+            m_pos.erase(ids[k]);
+        }
+        m_ids.resize(previousRawSize);
+        setEndPos(previousEndPos);
+
+        throw std::out_of_range("Duplicate id");
+    }
+
+    // Update the storage
+    FillAction fillAction(FillAction::TYPE_APPEND_MULTIPLE);
+    fillAction.info[PiercedSyncAction::INFO_POS]  = previousRawSize;
+    fillAction.info[PiercedSyncAction::INFO_SIZE] = rawSize();
+    processSyncAction(fillAction);
+
+    // Return the fill action
+    return fillAction;
+}
+
 /**
 * Fills the specified hole with the given id.
 *
@@ -1509,10 +1800,10 @@ typename PiercedKernel<id_t>::FillAction PiercedKernel<id_t>::fillInsert(std::si
     for (std::size_t i = pos + 1; i < m_end_pos; ++i) {
         id_t id_i = m_ids[i];
         if (id_i >= 0) {
-            m_pos[id_i] = i;
+            m_pos.set(id_i, i);
         }
     }
-    m_pos[id] = pos;
+    m_pos.set(id, pos);
 
     // Update the regular holes
     if (m_holes_regular_begin != m_holes_regular_end) {
@@ -1568,8 +1859,13 @@ typename PiercedKernel<id_t>::MoveAction PiercedKernel<id_t>::moveAfter(id_t ref
     }
 
     // Pierce the position
-    std::size_t initialPos = getPos(id);
+    //
+    // If the element is the last one, piercing its position shrinks the
+    // kernel.
+    std::size_t initialPos     = getPos(id);
+    std::size_t initialRawSize = rawSize();
     pierce(initialPos, flush);
+    bool shrunk = (rawSize() < initialRawSize);
 
     // Insert the element in the updated position
     FillAction fillAction = fillAfter(referenceId, id);
@@ -1607,6 +1903,13 @@ typename PiercedKernel<id_t>::MoveAction PiercedKernel<id_t>::moveAfter(id_t ref
     moveAction.info[PiercedSyncAction::INFO_POS_SECOND] = fillAction.info[PiercedSyncAction::INFO_POS];
     processSyncAction(moveAction);
 
+    // Shrink the storage
+    if (shrunk) {
+        ResizeAction resizeAction(ResizeAction::TYPE_RESIZE);
+        resizeAction.info[PiercedSyncAction::INFO_SIZE] = rawSize();
+        processSyncAction(resizeAction);
+    }
+
     // Return the move action
     return moveAction;
 }
@@ -1632,8 +1935,13 @@ typename PiercedKernel<id_t>::MoveAction PiercedKernel<id_t>::moveBefore(id_t re
     }
 
     // Pierce the position
-    std::size_t initialPos = getPos(id);
+    //
+    // If the element is the last one, piercing its position shrinks the
+    // kernel.
+    std::size_t initialPos     = getPos(id);
+    std::size_t initialRawSize = rawSize();
     pierce(initialPos, flush);
+    bool shrunk = (rawSize() < initialRawSize);
 
     // Insert the element in the updated position
     FillAction fillAction = fillBefore(referenceId, id);
@@ -1671,6 +1979,13 @@ typename PiercedKernel<id_t>::MoveAction PiercedKernel<id_t>::moveBefore(id_t re
     moveAction.info[PiercedSyncAction::INFO_POS_SECOND] = fillAction.info[PiercedSyncAction::INFO_POS];
     processSyncAction(moveAction);
 
+    // Shrink the storage
+    if (shrunk) {
+        ResizeAction resizeAction(ResizeAction::TYPE_RESIZE);
+        resizeAction.info[PiercedSyncAction::INFO_SIZE] = rawSize();
+        processSyncAction(resizeAction);
+    }
+
     // Return the move action
     return moveAction;
 }
@@ -2261,7 +2576,7 @@ template<typename id_t>
 void PiercedKernel<id_t>::setPosId(std::size_t pos, id_t id)
 {
     m_ids[pos] = id;
-    m_pos[id]  = pos;
+    m_pos.set(id, pos);
 }
 
 /**
@@ -2326,7 +2641,8 @@ template<typename id_t>
 void PiercedKernel<id_t>::swapPosIds(std::size_t pos_1, id_t id_1, std::size_t pos_2, id_t id_2)
 {
     std::swap(m_ids[pos_1], m_ids[pos_2]);
-    std::swap(m_pos[id_1], m_pos[id_2]);
+    m_pos.set(id_1, pos_2);
+    m_pos.set(id_2, pos_1);
 }
 
 /**
@@ -2431,7 +2747,7 @@ void PiercedKernel<id_t>::restore(std::istream &stream)
         std::size_t pos;
         utils::binary::read(stream, pos);
 
-        m_pos.insert({id, pos});
+        m_pos.set(id, pos);
     }
 
     // Postions data
@@ -2482,10 +2798,10 @@ void PiercedKernel<id_t>::dump(std::ostream &stream) const
     // Ids data
     std::size_t nIds = m_pos.size();
     utils::binary::write(stream, nIds);
-    for (const auto &entry : m_pos) {
-        utils::binary::write(stream, entry.first);
-        utils::binary::write(stream, entry.second);
-    }
+    m_pos.forEach([&stream](id_t id, std::size_t pos) {
+        utils::binary::write(stream, id);
+        utils::binary::write(stream, pos);
+    });
 
     // Postions data
     std::size_t nPositions = m_ids.size();
@@ -0,0 +1,184 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_KERNEL_INDEX_HPP__
+#define __BITPIT_PIERCED_KERNEL_INDEX_HPP__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bitpit_common.hpp"
+
+namespace bitpit {
+
+/**
+* \ingroup containers
+*
+* \brief Index that links the ids of the elements of a pierced kernel to
+* their positions.
+*
+* \details
+* The index can work in two modes. When the ids are dense, the position of
+* the elements are stored in a flat array indexed by the id (direct mode),
+* hence looking up an id costs a single memory access. When the ids are
+* sparse, the positions are stored in a hash map (hashed mode).
+*
+* Ids generated by an index generator are usually dense, for this reason
+* an empty index starts in direct mode. The index falls back to the hashed
+* mode as soon as an id that would make the flat array too sparse is added.
+* The mode is re-evaluated by the function optimize(), that is called by
+* the kernel when it is squeezed or sorted.
+*
+* \tparam id_t The type of the ids
+*/
+template<typename id_t = long>
+class PiercedKernelIndex {
+
+public:
+    /**
+    * Modes of the index
+    */
+    enum IndexMode {
+        MODE_HASHED,
+        MODE_DIRECT
+    };
+
+    /**
+    * Position returned when an id is not in the index.
+    */
+    static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+    /**
+    * Maximum ratio between the size of the flat array and the number of ids
+    * for which the direct mode is used.
+    *
+    * An entry of the flat array takes a single std::size_t, whereas every
+    * id stored in the hash map needs a node and a bucket (i.e., at least
+    * four times that size), hence within this ratio the direct mode doesn't
+    * use more memory than the hashed mode.
+    */
+    static constexpr std::size_t DIRECT_MAX_SPARSITY = 4;
+
+    /**
+    * Size of the flat array below which the direct mode is always used.
+    */
+    static constexpr std::size_t DIRECT_MIN_SIZE = 1024;
+
+    PiercedKernelIndex();
+
+    IndexMode getMode() const;
+    void optimize();
+
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t count(id_t id) const;
+
+    std::size_t find(id_t id) const noexcept;
+    std::size_t at(id_t id) const;
+
+    void set(id_t id, std::size_t pos);
+    void update(const id_t *ids, std::size_t beginPos, std::size_t endPos);
+    void erase(id_t id);
+
+    void clear(bool release = false);
+    void reserve(std::size_t n);
+    void swap(PiercedKernelIndex &other) noexcept;
+
+    std::size_t getMemoryUsage() const;
+
+    template<typename Function>
+    void forEach(Function function) const;
+
+private:
+    /**
+    * Hasher for the id map.
+    *
+    * Since the id are uniques, the hasher can be a function that
+    * takes the id and cast it to a std::size_t.
+    *
+    * The hasher is defined as a struct, because a struct can be
+    * passed as an object into metafunctions (meaning that the type
+    * deduction for the template paramenters can take place, and
+    * also meaning that inlining is easier for the compiler). A bare
+    * function would have to be passed as a function pointer.
+    * To transform a function template into a function pointer,
+    * the template would have to be manually instantiated (with a
+    * perhaps unknown type argument).
+    */
+    struct PiercedHasher {
+        /**
+        * Function call operator that casts the specified
+        * value to a std::size_t.
+        *
+        * \tparam U type of the value
+        * \param value is the value to be casted
+        * \result Returns the value casted to a std::size_t.
+        */
+        template<typename U>
+        constexpr std::size_t operator()(U&& value) const noexcept
+        {
+            return static_cast<std::size_t>(std::forward<U>(value));
+        }
+    };
+
+    /**
+    * Mode of the index.
+    */
+    IndexMode m_mode;
+
+    /**
+    * Flat array that contains the position of the elements, it is used
+    * only in direct mode.
+    */
+    std::vector<std::size_t> m_direct;
+
+    /**
+    * Number of ids stored in the flat array.
+    */
+    std::size_t m_directCount;
+
+    /**
+    * Map that links the id of the elements and their position, it is used
+    * only in hashed mode.
+    */
+    std::unordered_map<id_t, std::size_t, PiercedHasher> m_hashed;
+
+    static bool isDirectSuitable(id_t maxId, std::size_t nIds);
+
+    void setMode(IndexMode mode, id_t maxId);
+
+};
+
+}
+
+// Include the implementation
+#include "piercedKernelIndex.tpp"
+
+#endif
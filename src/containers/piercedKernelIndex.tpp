@@ -0,0 +1,431 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_KERNEL_INDEX_TPP__
+#define __BITPIT_PIERCED_KERNEL_INDEX_TPP__
+
+namespace bitpit {
+
+/**
+* Constructor.
+*
+* An empty index is in direct mode.
+*/
+template<typename id_t>
+PiercedKernelIndex<id_t>::PiercedKernelIndex()
+    : m_mode(MODE_DIRECT),
+      m_directCount(0)
+{
+}
+
+/**
+* Gets the mode of the index.
+*
+* \result The mode of the index.
+*/
+template<typename id_t>
+typename PiercedKernelIndex<id_t>::IndexMode PiercedKernelIndex<id_t>::getMode() const
+{
+    return m_mode;
+}
+
+/**
+* Chooses the most suitable mode for the ids currently stored in the index
+* and reduces the memory used by the index to fit its size.
+*
+* The direct mode is chosen if the ids are dense enough, otherwise the
+* hashed mode is chosen.
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::optimize()
+{
+    // Evaluate the maximum id
+    id_t maxId = -1;
+    if (m_mode == MODE_DIRECT) {
+        for (std::size_t i = m_direct.size(); i > 0; --i) {
+            if (m_direct[i - 1] != NOT_FOUND) {
+                maxId = static_cast<id_t>(i - 1);
+                break;
+            }
+        }
+    } else {
+        for (const auto &entry : m_hashed) {
+            maxId = std::max(maxId, entry.first);
+        }
+    }
+
+    // Update the mode
+    if (isDirectSuitable(maxId, size())) {
+        setMode(MODE_DIRECT, maxId);
+    } else {
+        setMode(MODE_HASHED, maxId);
+    }
+
+    // Shrink to fit
+    if (m_mode == MODE_DIRECT) {
+        m_direct.resize(static_cast<std::size_t>(maxId + 1));
+        m_direct.shrink_to_fit();
+    }
+}
+
+/**
+* Checks if the index is empty.
+*
+* \result Returns true if the index contains no ids, false otherwise.
+*/
+template<typename id_t>
+bool PiercedKernelIndex<id_t>::empty() const
+{
+    return (size() == 0);
+}
+
+/**
+* Gets the number of ids stored in the index.
+*
+* \result The number of ids stored in the index.
+*/
+template<typename id_t>
+std::size_t PiercedKernelIndex<id_t>::size() const
+{
+    if (m_mode == MODE_DIRECT) {
+        return m_directCount;
+    } else {
+        return m_hashed.size();
+    }
+}
+
+/**
+* Counts the ids in the index equal to the specified one.
+*
+* \param id is the id to search for
+* \result The number of ids in the index equal to the specified one, since
+* the index does not allow duplicate ids, the result is either 1 or 0.
+*/
+template<typename id_t>
+std::size_t PiercedKernelIndex<id_t>::count(id_t id) const
+{
+    return (find(id) != NOT_FOUND) ? 1 : 0;
+}
+
+/**
+* Gets the position associated with the specified id.
+*
+* \param id is the id to search for
+* \result The position associated with the specified id, if the id is not
+* in the index NOT_FOUND is returned.
+*/
+template<typename id_t>
+std::size_t PiercedKernelIndex<id_t>::find(id_t id) const noexcept
+{
+    if (m_mode == MODE_DIRECT) {
+        // Negative ids are mapped past the end of the array
+        std::size_t index = static_cast<std::size_t>(id);
+        if (index < m_direct.size()) {
+            return m_direct[index];
+        }
+
+        return NOT_FOUND;
+    } else {
+        auto itr = m_hashed.find(id);
+        if (itr != m_hashed.end()) {
+            return itr->second;
+        }
+
+        return NOT_FOUND;
+    }
+}
+
+/**
+* Gets the position associated with the specified id.
+*
+* If the id is not in the index an exception is thrown.
+*
+* \param id is the id to search for
+* \result The position associated with the specified id.
+*/
+template<typename id_t>
+std::size_t PiercedKernelIndex<id_t>::at(id_t id) const
+{
+    std::size_t pos = find(id);
+    if (pos == NOT_FOUND) {
+        throw std::out_of_range("The index doesn't contain the requested id.");
+    }
+
+    return pos;
+}
+
+/**
+* Sets the position associated with the specified id.
+*
+* If the id is not in the index, it will be added. When the index is in
+* direct mode and the id would make the flat array too sparse, the index
+* is switched to hashed mode.
+*
+* \param id is the id
+* \param pos is the position that will be associated with the id
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::set(id_t id, std::size_t pos)
+{
+    if (m_mode == MODE_DIRECT) {
+        std::size_t index = static_cast<std::size_t>(id);
+        if (index >= m_direct.size()) {
+            if (id >= 0 && isDirectSuitable(id, m_directCount + 1)) {
+                m_direct.resize(index + 1, NOT_FOUND);
+            } else {
+                setMode(MODE_HASHED, -1);
+            }
+        }
+
+        if (m_mode == MODE_DIRECT) {
+            std::size_t &entry = m_direct[index];
+            if (entry == NOT_FOUND) {
+                ++m_directCount;
+            }
+            entry = pos;
+
+            return;
+        }
+    }
+
+    m_hashed[id] = pos;
+}
+
+/**
+* Updates the positions associated with a range of ids.
+*
+* After the update, the id ids[k] will be associated with the position
+* (beginPos + k). All the ids should already be in the index, hence the
+* structure of the index is not modified and the positions can be updated
+* concurrently by the threads available to the process.
+*
+* \param ids are the ids whose positions will be updated
+* \param beginPos is the position associated with the first id
+* \param endPos is the position past the one associated with the last id
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::update(const id_t *ids, std::size_t beginPos, std::size_t endPos)
+{
+    static const std::size_t MIN_CHUNK_SIZE = 16384;
+
+    if (endPos <= beginPos) {
+        return;
+    }
+
+    std::size_t nIds    = endPos - beginPos;
+    std::size_t nChunks = std::max(std::min(static_cast<std::size_t>(utils::threads::getThreadCount()), nIds / MIN_CHUNK_SIZE), std::size_t(1));
+    utils::threads::parallelFor(nChunks, [this, ids, beginPos, nIds, nChunks](std::size_t chunk) {
+        std::size_t chunkBegin = (nIds * chunk) / nChunks;
+        std::size_t chunkEnd   = (nIds * (chunk + 1)) / nChunks;
+        if (m_mode == MODE_DIRECT) {
+            for (std::size_t k = chunkBegin; k < chunkEnd; ++k) {
+                assert(static_cast<std::size_t>(ids[k]) < m_direct.size());
+                m_direct[static_cast<std::size_t>(ids[k])] = beginPos + k;
+            }
+        } else {
+            for (std::size_t k = chunkBegin; k < chunkEnd; ++k) {
+                auto itr = m_hashed.find(ids[k]);
+                assert(itr != m_hashed.end());
+                itr->second = beginPos + k;
+            }
+        }
+    });
+}
+
+/**
+* Removes the specified id from the index.
+*
+* The mode of the index is not changed.
+*
+* \param id is the id that will be removed
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::erase(id_t id)
+{
+    if (m_mode == MODE_DIRECT) {
+        std::size_t index = static_cast<std::size_t>(id);
+        if (index < m_direct.size() && m_direct[index] != NOT_FOUND) {
+            m_direct[index] = NOT_FOUND;
+            --m_directCount;
+        }
+    } else {
+        m_hashed.erase(id);
+    }
+}
+
+/**
+* Removes all the ids from the index.
+*
+* After being cleared, the index is in direct mode.
+*
+* \param release if it's true the memory hold by the index will be released
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::clear(bool release)
+{
+    m_direct.clear();
+    if (release) {
+        std::vector<std::size_t>().swap(m_direct);
+    }
+    m_directCount = 0;
+
+    std::unordered_map<id_t, std::size_t, PiercedHasher>().swap(m_hashed);
+
+    m_mode = MODE_DIRECT;
+}
+
+/**
+* Requests that the capacity of the index is enough to contain the
+* specified number of ids.
+*
+* \param n is the minimum capacity requested for the index
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::reserve(std::size_t n)
+{
+    if (m_mode == MODE_DIRECT) {
+        m_direct.reserve(n);
+    } else {
+        m_hashed.reserve(n);
+    }
+}
+
+/**
+* Swaps the contents.
+*
+* \param other is another index
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::swap(PiercedKernelIndex &other) noexcept
+{
+    std::swap(other.m_mode, m_mode);
+    std::swap(other.m_direct, m_direct);
+    std::swap(other.m_directCount, m_directCount);
+    std::swap(other.m_hashed, m_hashed);
+}
+
+/**
+* Computes the memory used by the index.
+*
+* \result The memory, expressed in bytes, used by the index.
+*/
+template<typename id_t>
+std::size_t PiercedKernelIndex<id_t>::getMemoryUsage() const
+{
+    std::size_t memoryUsage = 0;
+    memoryUsage += utils::getMemoryUsage(m_direct);
+    memoryUsage += utils::getMemoryUsage(m_hashed);
+
+    return memoryUsage;
+}
+
+/**
+* Calls the specified function for every id stored in the index.
+*
+* The order in which the ids are visited is unspecified.
+*
+* \param function is the function that will be called, it will receive in
+* input the id and its position
+*/
+template<typename id_t>
+template<typename Function>
+void PiercedKernelIndex<id_t>::forEach(Function function) const
+{
+    if (m_mode == MODE_DIRECT) {
+        std::size_t directSize = m_direct.size();
+        for (std::size_t i = 0; i < directSize; ++i) {
+            std::size_t pos = m_direct[i];
+            if (pos != NOT_FOUND) {
+                function(static_cast<id_t>(i), pos);
+            }
+        }
+    } else {
+        for (const auto &entry : m_hashed) {
+            function(entry.first, entry.second);
+        }
+    }
+}
+
+/**
+* Checks if the direct mode is suitable for storing the specified ids.
+*
+* \param maxId is the maximum id that will be stored, a negative value
+* means that there are no ids
+* \param nIds is the number of ids that will be stored
+* \result Returns true if the direct mode is suitable for storing the
+* specified ids, false otherwise.
+*/
+template<typename id_t>
+bool PiercedKernelIndex<id_t>::isDirectSuitable(id_t maxId, std::size_t nIds)
+{
+    if (maxId < 0) {
+        return true;
+    }
+
+    std::size_t directSize = static_cast<std::size_t>(maxId) + 1;
+
+    return (directSize <= std::max(DIRECT_MAX_SPARSITY * nIds, DIRECT_MIN_SIZE));
+}
+
+/**
+* Sets the mode of the index, converting the stored ids.
+*
+* \param mode is the mode that will be set
+* \param maxId is the maximum id stored in the index, it is only needed
+* when switching to direct mode
+*/
+template<typename id_t>
+void PiercedKernelIndex<id_t>::setMode(IndexMode mode, id_t maxId)
+{
+    if (mode == m_mode) {
+        return;
+    }
+
+    if (mode == MODE_DIRECT) {
+        std::vector<std::size_t> direct(static_cast<std::size_t>(maxId + 1), NOT_FOUND);
+        for (const auto &entry : m_hashed) {
+            direct[static_cast<std::size_t>(entry.first)] = entry.second;
+        }
+
+        m_direct.swap(direct);
+        m_directCount = m_hashed.size();
+        std::unordered_map<id_t, std::size_t, PiercedHasher>().swap(m_hashed);
+    } else {
+        std::unordered_map<id_t, std::size_t, PiercedHasher> hashed;
+        hashed.reserve(m_directCount);
+        forEach([&hashed](id_t id, std::size_t pos) {
+            hashed.insert({id, pos});
+        });
+
+        m_hashed.swap(hashed);
+        std::vector<std::size_t>().swap(m_direct);
+        m_directCount = 0;
+    }
+
+    m_mode = mode;
+}
+
+}
+
+#endif
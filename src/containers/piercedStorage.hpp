@@ -25,6 +25,8 @@
 #ifndef __BITPIT_PIERCED_STORAGE_HPP__
 #define __BITPIT_PIERCED_STORAGE_HPP__
 
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
 #include "piercedStorageRange.hpp"
@@ -32,10 +34,10 @@
 #include "piercedKernel.hpp"
 #include "piercedSync.hpp"
 
-#define __PS_REFERENCE__       typename PiercedStorage<value_t, id_t>::reference
-#define __PS_CONST_REFERENCE__ typename PiercedStorage<value_t, id_t>::const_reference
-#define __PS_POINTER__         typename PiercedStorage<value_t, id_t>::pointer
-#define __PS_CONST_POINTER__   typename PiercedStorage<value_t, id_t>::const_pointer
+#define __PS_REFERENCE__       typename PiercedStorage<value_t, id_t, allocator_t>::reference
+#define __PS_CONST_REFERENCE__ typename PiercedStorage<value_t, id_t, allocator_t>::const_reference
+#define __PS_POINTER__         typename PiercedStorage<value_t, id_t, allocator_t>::pointer
+#define __PS_CONST_POINTER__   typename PiercedStorage<value_t, id_t, allocator_t>::const_pointer
 
 namespace bitpit {
 
@@ -136,17 +138,24 @@ protected:
 * \brief Metafunction for generating a pierced storage.
 *
 * \details
-* Usage: use <tt>PiercedStorage<value_t, id_t></tt> to declare a pierced
+* Usage: use <tt>PiercedStorage<value_t, id_t, allocator_t></tt> to declare a pierced
 * storage.
 *
+* Constant functions of the storage can be called concurrently by any number
+* of threads, as long as neither the storage nor its kernel are modified at
+* the same time. Different threads can also modify the values of different
+* elements, with the exception of storages of booleans, whose values may be
+* packed in the same memory location.
+*
 * \tparam value_t is the type of the elements stored in the storage
 * \tparam id_t is the type of the ids associated to the elements
+* \tparam allocator_t is the allocator used for the elements
 */
-template<typename value_t, typename id_t = long>
+template<typename value_t, typename id_t = long, typename allocator_t = std::allocator<value_t>>
 class PiercedStorage : public PiercedStorageSyncSlave<id_t> {
 
 // Friendships
-template<typename PI_value_t, typename PI_id_t, typename PI_value_no_cv_t>
+template<typename PI_value_t, typename PI_id_t, typename PI_allocator_t, typename PI_value_no_cv_t>
 friend class PiercedStorageIterator;
 
 private:
@@ -255,7 +264,7 @@ public:
     /**
     * Container
     */
-    typedef std::vector<value_t> container_t;
+    typedef std::vector<value_t, allocator_t> container_t;
 
     /**
     * Reference
@@ -280,32 +289,32 @@ public:
     /**
     * Iterator
     */
-    typedef PiercedStorageIterator<value_t, id_t> iterator;
+    typedef PiercedStorageIterator<value_t, id_t, allocator_t> iterator;
 
     /**
     * Constant iterator
     */
-    typedef PiercedStorageIterator<const value_t, id_t> const_iterator;
+    typedef PiercedStorageIterator<const value_t, id_t, allocator_t> const_iterator;
 
     /**
     * Raw iterator
     */
-    typedef typename std::vector<value_t>::iterator raw_iterator;
+    typedef typename container_t::iterator raw_iterator;
 
     /**
     * Raw constant iterator
     */
-    typedef typename std::vector<value_t>::const_iterator raw_const_iterator;
+    typedef typename container_t::const_iterator raw_const_iterator;
 
     /**
     * Range
     */
-    typedef PiercedStorageRange<value_t, id_t> range;
+    typedef PiercedStorageRange<value_t, id_t, allocator_t> range;
 
     /**
     * Constant range
     */
-    typedef PiercedStorageRange<const value_t, id_t> const_range;
+    typedef PiercedStorageRange<const value_t, id_t, allocator_t> const_range;
 
     /**
     * Checks if the storage has the 'restore' capability
@@ -338,25 +347,26 @@ public:
     * This is needed for being compliant with MSVC.
     */
     template <typename... Args>
-    using EnableIfHasInitialize = typename std::enable_if<PiercedStorage<value_t, id_t>::template has_initialize<Args...>()>::type;
+    using EnableIfHasInitialize = typename std::enable_if<PiercedStorage<value_t, id_t, allocator_t>::template has_initialize<Args...>()>::type;
 
     // Constructors and initialization
     PiercedStorage();
     PiercedStorage(std::size_t nFields);
     PiercedStorage(std::size_t nFields, const PiercedKernel<id_t> *kernel);
     PiercedStorage(std::size_t nFields, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode);
-    PiercedStorage(const PiercedStorage<value_t, id_t> &other);
-    PiercedStorage(const PiercedStorage<value_t, id_t> &other, const PiercedKernel<id_t> *kernel);
-    PiercedStorage(const PiercedStorage<value_t, id_t> &other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode);
-    PiercedStorage(PiercedStorage<value_t, id_t> &&other);
-    PiercedStorage(PiercedStorage<value_t, id_t> &&other, const PiercedKernel<id_t> *kernel);
-    PiercedStorage(PiercedStorage<value_t, id_t> &&other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode);
+    PiercedStorage(const PiercedStorage<value_t, id_t, allocator_t> &other);
+    PiercedStorage(const PiercedStorage<value_t, id_t, allocator_t> &other, const PiercedKernel<id_t> *kernel);
+    PiercedStorage(const PiercedStorage<value_t, id_t, allocator_t> &other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode);
+    PiercedStorage(PiercedStorage<value_t, id_t, allocator_t> &&other);
+    PiercedStorage(PiercedStorage<value_t, id_t, allocator_t> &&other, const PiercedKernel<id_t> *kernel);
+    PiercedStorage(PiercedStorage<value_t, id_t, allocator_t> &&other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode);
 
     PiercedStorage & operator=(const PiercedStorage &other);
     PiercedStorage & operator=(PiercedStorage &&other);
 
     // Methods for accessing container properties
     std::size_t getFieldCount() const;
+    std::size_t getMemoryUsage() const;
 
     // Methods that modify the container as a whole
     void swap(PiercedStorage &other) noexcept;
@@ -405,6 +415,19 @@ public:
     void rawSet(std::size_t pos, const value_t *values);
     void rawSet(std::size_t pos, std::size_t nFields, std::size_t offset, const value_t *values);
 
+    // Methods for packing and unpacking the items using their position
+    std::size_t getPackedSize(std::size_t nItems) const;
+
+    template<typename T = value_t, typename std::enable_if<!std::is_same<T, bool>::value>::type * = nullptr>
+    void rawPack(std::size_t nItems, const std::size_t *positions, char *buffer) const;
+    template<typename T = value_t, typename std::enable_if<std::is_same<T, bool>::value>::type * = nullptr>
+    void rawPack(std::size_t nItems, const std::size_t *positions, char *buffer) const;
+
+    template<typename T = value_t, typename std::enable_if<!std::is_same<T, bool>::value>::type * = nullptr>
+    void rawUnpack(std::size_t nItems, const std::size_t *positions, const char *buffer);
+    template<typename T = value_t, typename std::enable_if<std::is_same<T, bool>::value>::type * = nullptr>
+    void rawUnpack(std::size_t nItems, const std::size_t *positions, const char *buffer);
+
     // Iterators
     iterator find(const id_t &id) noexcept;
     const_iterator find(const id_t &id) const noexcept;
@@ -426,6 +449,10 @@ public:
     raw_const_iterator rawCbegin() const noexcept;
     raw_const_iterator rawCend() const noexcept;
 
+    // Methods for splitting the storage into ranges
+    std::vector<range> split(std::size_t nChunks);
+    std::vector<const_range> split(std::size_t nChunks) const;
+
     // Dump and restore
     template<typename T = value_t, typename std::enable_if<std::is_pod<T>::value || PiercedStorage<T, id_t>::has_restore()>::type * = nullptr>
     void restore(std::istream &stream);
@@ -457,6 +484,8 @@ protected:
     template<typename T = value_t, typename std::enable_if<std::is_same<T, bool>::value>::type * = nullptr>
     void rawSwap(std::size_t pos_first, std::size_t pos_second);
     void rawReorder(const std::vector<std::size_t> &permutations);
+    void rawMove(std::size_t sourcePos, std::size_t targetPos);
+    void rawGather(const std::vector<std::size_t> &moves, std::size_t keptSize, std::size_t size);
 
     void rawResize(std::size_t n, const value_t &value = value_t());
 
@@ -413,8 +413,8 @@ void PiercedStorageSyncSlave<id_t>::swap(PiercedStorageSyncSlave<id_t> &other) n
 /**
 *   Constructor.
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage()
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage()
     : PiercedStorageSyncSlave<id_t>(), m_nFields(1)
 {
 }
@@ -424,8 +424,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage()
 *
 * \param nFields is the number of fields in the storage
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(std::size_t nFields)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(std::size_t nFields)
     : PiercedStorageSyncSlave<id_t>(), m_nFields(nFields)
 {
 }
@@ -436,8 +436,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(std::size_t nFields)
 * \param nFields is the number of fields in the storage
 * \param kernel is the kernel that will be set
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(std::size_t nFields, const PiercedKernel<id_t> *kernel)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(std::size_t nFields, const PiercedKernel<id_t> *kernel)
     : PiercedStorageSyncSlave<id_t>(kernel), m_nFields(nFields)
 {
     // Base class constructor cannot call virtual functions
@@ -451,8 +451,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(std::size_t nFields, const Pierced
 * \param kernel is the kernel that will be set
 * \param syncMode is the synchronization mode that will be used for the storage
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(std::size_t nFields, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(std::size_t nFields, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
     : PiercedStorageSyncSlave<id_t>(kernel, syncMode), m_nFields(nFields)
 {
     // Base class constructor cannot call virtual functions
@@ -466,8 +466,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(std::size_t nFields, const Pierced
 * \param other is another container of the same type (i.e., instantiated with
 * the same template parameters) whose content is copied in this container
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage<value_t, id_t> &other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(const PiercedStorage<value_t, id_t, allocator_t> &other)
     : PiercedStorageSyncSlave<id_t>(other),
       m_nFields(other.m_nFields), m_fields(other.m_fields)
 {
@@ -492,8 +492,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage<value_t, id_t
 * the same template parameters) whose content is copied in this container
 * \param kernel is the kernel that will be set
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage<value_t, id_t> &other, const PiercedKernel<id_t> *kernel)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(const PiercedStorage<value_t, id_t, allocator_t> &other, const PiercedKernel<id_t> *kernel)
     : PiercedStorageSyncSlave<id_t>(other, kernel),
       m_nFields(other.m_nFields), m_fields(other.m_fields)
 {
@@ -514,8 +514,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage<value_t, id_t
 * \param kernel is the kernel that will be set
 * \param syncMode is the synchronization mode that will be used for the storage
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage<value_t, id_t> &other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(const PiercedStorage<value_t, id_t, allocator_t> &other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
     : PiercedStorageSyncSlave<id_t>(other, kernel, syncMode),
       m_nFields(other.m_nFields), m_fields(other.m_fields)
 {
@@ -540,8 +540,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage<value_t, id_t
 * \param other is another container of the same type (i.e., instantiated with
 * the same template parameters) whose content is moved in this container
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(PiercedStorage<value_t, id_t> &&other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(PiercedStorage<value_t, id_t, allocator_t> &&other)
     : PiercedStorageSyncSlave<long>(other),
       m_nFields(std::move(other.m_nFields)), m_fields(std::move(other.m_fields))
 {
@@ -576,8 +576,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(PiercedStorage<value_t, id_t> &&ot
 * the same template parameters) whose content is moved in this container
 * \param kernel is the kernel that will be set
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(PiercedStorage<value_t, id_t> &&other, const PiercedKernel<id_t> *kernel)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(PiercedStorage<value_t, id_t, allocator_t> &&other, const PiercedKernel<id_t> *kernel)
     : PiercedStorageSyncSlave<long>(other, kernel),
       m_nFields(std::move(other.m_nFields)), m_fields(std::move(other.m_fields))
 {
@@ -608,8 +608,8 @@ PiercedStorage<value_t, id_t>::PiercedStorage(PiercedStorage<value_t, id_t> &&ot
 * \param kernel is the kernel that will be set
 * \param syncMode is the synchronization mode that will be used for the storage
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t>::PiercedStorage(PiercedStorage<value_t, id_t> &&other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage(PiercedStorage<value_t, id_t, allocator_t> &&other, const PiercedKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
     : PiercedStorageSyncSlave<long>(other, kernel, syncMode),
       m_nFields(std::move(other.m_nFields)), m_fields(std::move(other.m_fields))
 {
@@ -631,10 +631,10 @@ PiercedStorage<value_t, id_t>::PiercedStorage(PiercedStorage<value_t, id_t> &&ot
 * the same template parameters) whose content is copied in this container
 * \return A reference to the pierced storage.
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t> & PiercedStorage<value_t, id_t>::operator=(const PiercedStorage<value_t, id_t> &other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t> & PiercedStorage<value_t, id_t, allocator_t>::operator=(const PiercedStorage<value_t, id_t, allocator_t> &other)
 {
-    PiercedStorage<value_t, id_t> temporary(other, nullptr);
+    PiercedStorage<value_t, id_t, allocator_t> temporary(other, nullptr);
     temporary.swap(*this);
 
     return *this;
@@ -647,10 +647,10 @@ PiercedStorage<value_t, id_t> & PiercedStorage<value_t, id_t>::operator=(const P
 * the same template parameters) whose content is moved in this container
 * \return A reference to the pierced storage.
 */
-template<typename value_t, typename id_t>
-PiercedStorage<value_t, id_t> & PiercedStorage<value_t, id_t>::operator=(PiercedStorage<value_t, id_t> &&other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedStorage<value_t, id_t, allocator_t> & PiercedStorage<value_t, id_t, allocator_t>::operator=(PiercedStorage<value_t, id_t, allocator_t> &&other)
 {
-    PiercedStorage<value_t, id_t> temporary(std::move(other));
+    PiercedStorage<value_t, id_t, allocator_t> temporary(std::move(other));
     temporary.swap(*this);
 
     return *this;
@@ -661,12 +661,28 @@ PiercedStorage<value_t, id_t> & PiercedStorage<value_t, id_t>::operator=(Pierced
 *
 * \result The number of fields in the storage.
 */
-template<typename value_t, typename id_t>
-std::size_t PiercedStorage<value_t, id_t>::getFieldCount() const
+template<typename value_t, typename id_t, typename allocator_t>
+std::size_t PiercedStorage<value_t, id_t, allocator_t>::getFieldCount() const
 {
     return m_nFields;
 }
 
+/**
+* Evaluates the memory allocated by the storage.
+*
+* The memory used by the storage includes the memory allocated for the
+* values of all the positions of the kernel, holes included. The memory
+* occupied by the storage object itself and the memory dynamically
+* allocated by the values are not included.
+*
+* \result The memory, expressed in bytes, allocated by the storage.
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+std::size_t PiercedStorage<value_t, id_t, allocator_t>::getMemoryUsage() const
+{
+    return utils::getMemoryUsage(m_fields);
+}
+
 
 /**
 * Internal function that will be called after setting a static kernel.
@@ -676,8 +692,8 @@ std::size_t PiercedStorage<value_t, id_t>::getFieldCount() const
 *
 * \param kernel is the kernel that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::_postSetStaticKernel()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::_postSetStaticKernel()
 {
     // Resize the storage
     rawResize(this->m_kernel->rawSize());
@@ -689,8 +705,8 @@ void PiercedStorage<value_t, id_t>::_postSetStaticKernel()
 *
 * The storage will dynamically synchronized with the kernel.
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::_postSetDynamicKernel()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::_postSetDynamicKernel()
 {
     // Nothing to do
 }
@@ -702,8 +718,8 @@ void PiercedStorage<value_t, id_t>::_postSetDynamicKernel()
 * be released, otherwise the container will be cleared but its
 * memory will not be released
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::_postUnsetKernel(bool release)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::_postUnsetKernel(bool release)
 {
     // Clear the storage
     rawClear(release);
@@ -719,8 +735,8 @@ void PiercedStorage<value_t, id_t>::_postUnsetKernel(bool release)
 *
 * \result The number of raw positions in the storage.
 */
-template<typename value_t, typename id_t>
-std::size_t PiercedStorage<value_t, id_t>::rawSize() const
+template<typename value_t, typename id_t, typename allocator_t>
+std::size_t PiercedStorage<value_t, id_t, allocator_t>::rawSize() const
 {
     return (m_fields.size() / m_nFields);
 }
@@ -733,8 +749,8 @@ std::size_t PiercedStorage<value_t, id_t>::rawSize() const
 *
 * \param action is the synchronization action that will be commited
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::commitSyncAction(const PiercedSyncAction &action)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::commitSyncAction(const PiercedSyncAction &action)
 {
     switch (action.type) {
 
@@ -781,6 +797,20 @@ void PiercedStorage<value_t, id_t>::commitSyncAction(const PiercedSyncAction &ac
         break;
     }
 
+    case PiercedSyncAction::TYPE_APPEND_MULTIPLE:
+    {
+        // All the elements are appended at once, hence the storage can be
+        // resized directly to its final size.
+        rawResize(action.info[PiercedSyncAction::INFO_SIZE]);
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_MOVE_MULTIPLE:
+    {
+        rawGather(*action.data, action.info[PiercedSyncAction::INFO_POS], action.info[PiercedSyncAction::INFO_SIZE]);
+        break;
+    }
+
     case PiercedSyncAction::TYPE_INSERT:
     {
         // Since we may increase the sotrage by an element at the time calling
@@ -801,8 +831,20 @@ void PiercedStorage<value_t, id_t>::commitSyncAction(const PiercedSyncAction &ac
         // Since we may increase the sotrage by an element at the time calling
         // a reserve will hurt performance badly because this will prevent the
         // automatic reallocation of the storage.
-        rawPushBack(std::move(rawAt(action.info[PiercedSyncAction::INFO_POS_FIRST])));
-        rawEmreplace(action.info[PiercedSyncAction::INFO_POS_FIRST]);
+        //
+        // If the moved element was the last one, the kernel may have been
+        // shrunk before appending the element, hence the element may end up
+        // in a position that is already in the storage.
+        std::size_t sourcePos = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t targetPos = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        if (targetPos >= rawSize()) {
+            rawEmplaceBack();
+        }
+
+        if (sourcePos != targetPos) {
+            rawMove(sourcePos, targetPos);
+            rawEmreplace(sourcePos);
+        }
         break;
     }
 
@@ -811,15 +853,28 @@ void PiercedStorage<value_t, id_t>::commitSyncAction(const PiercedSyncAction &ac
         // Since we may increase the sotrage by an element at the time calling
         // a reserve will hurt performance badly because this will prevent the
         // automatic reallocation of the storage.
-        rawInsert(action.info[PiercedSyncAction::INFO_POS_SECOND], 1, std::move(rawAt(action.info[PiercedSyncAction::INFO_POS_FIRST])));
-        rawEmreplace(action.info[PiercedSyncAction::INFO_POS_FIRST]);
+        std::size_t sourcePos = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t targetPos = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        rawEmplace(targetPos);
+
+        // Elements after the inserted one have been shifted
+        if (sourcePos >= targetPos) {
+            ++sourcePos;
+        }
+
+        rawMove(sourcePos, targetPos);
+        rawEmreplace(sourcePos);
         break;
     }
 
     case PiercedSyncAction::TYPE_MOVE_OVERWRITE:
     {
-        rawSet(action.info[PiercedSyncAction::INFO_POS_SECOND], std::move(rawAt(action.info[PiercedSyncAction::INFO_POS_FIRST])));
-        rawEmreplace(action.info[PiercedSyncAction::INFO_POS_FIRST]);
+        std::size_t sourcePos = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t targetPos = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        if (sourcePos != targetPos) {
+            rawMove(sourcePos, targetPos);
+            rawEmreplace(sourcePos);
+        }
         break;
     }
 
@@ -856,8 +911,8 @@ void PiercedStorage<value_t, id_t>::commitSyncAction(const PiercedSyncAction &ac
 * \param n is the minimum capacity requested for the vector, expressed
 * in number of elements
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawReserve(std::size_t n)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawReserve(std::size_t n)
 {
     m_fields.reserve(m_nFields * n);
 }
@@ -871,8 +926,8 @@ void PiercedStorage<value_t, id_t>::rawReserve(std::size_t n)
 * This may cause a reallocation, but has no effect on the container size and
 * cannot alter its elements.
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawShrinkToFit()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawShrinkToFit()
 {
     m_fields.shrink_to_fit();
 }
@@ -884,11 +939,11 @@ void PiercedStorage<value_t, id_t>::rawShrinkToFit()
 * be released, otherwise the container will be cleared but its
 * memory will not be relased
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawClear(bool release)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawClear(bool release)
 {
     if (release) {
-        std::vector<value_t>().swap(m_fields);
+        container_t().swap(m_fields);
     } else {
         m_fields.clear();
     }
@@ -900,8 +955,8 @@ void PiercedStorage<value_t, id_t>::rawClear(bool release)
 * \param pos is the position of the first element that will be deleted
 * \param n is the number of elements that will be deleted
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawErase(std::size_t pos, std::size_t n)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawErase(std::size_t pos, std::size_t n)
 {
     auto itr_begin = m_fields.begin() + pos * m_nFields;
     auto itr_end   = itr_begin + n * m_nFields;
@@ -918,9 +973,9 @@ void PiercedStorage<value_t, id_t>::rawErase(std::size_t pos, std::size_t n)
 * \param pos_first is the position of the first element that will be swapped
 * \param pos_second is the position of the second element that will be swapped
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<!std::is_same<T, bool>::value>::type *>
-void PiercedStorage<value_t, id_t>::rawSwap(std::size_t pos_first, std::size_t pos_second)
+void PiercedStorage<value_t, id_t, allocator_t>::rawSwap(std::size_t pos_first, std::size_t pos_second)
 {
     std::size_t firstOffset  = pos_first * m_nFields;
     std::size_t secondOffset = pos_second * m_nFields;
@@ -937,9 +992,9 @@ void PiercedStorage<value_t, id_t>::rawSwap(std::size_t pos_first, std::size_t p
 * \param pos_first is the position of the first element that will be swapped
 * \param pos_second is the position of the second element that will be swapped
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_same<T, bool>::value>::type *>
-void PiercedStorage<value_t, id_t>::rawSwap(std::size_t pos_first, std::size_t pos_second)
+void PiercedStorage<value_t, id_t, allocator_t>::rawSwap(std::size_t pos_first, std::size_t pos_second)
 {
     std::size_t firstOffset  = pos_first * m_nFields;
     std::size_t secondOffset = pos_second * m_nFields;
@@ -963,24 +1018,102 @@ void PiercedStorage<value_t, id_t>::rawSwap(std::size_t pos_first, std::size_t p
 *
 * \param permutations are the permutations that wil be applied
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawReorder(const std::vector<std::size_t> &permutations)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawReorder(const std::vector<std::size_t> &permutations)
 {
     std::size_t storageRawSize = rawSize();
     assert(permutations.size() == storageRawSize);
 
-    // Evaluate the permutation of the fields
-    std::vector<std::size_t> fieldPermutations(storageRawSize * m_nFields);
-    for (std::size_t pos = 0; pos < storageRawSize; ++pos) {
-        std::size_t posOffset         = pos * m_nFields;
-        std::size_t permutationOffset = permutations[pos] * m_nFields;
+    // Sort the fields
+    //
+    // The fields of an element are permuted as a single block, the memory
+    // used by the permutation is bounded by utils::getReorderMemoryLimit().
+    utils::permuteVector(permutations, m_fields, storageRawSize, m_nFields);
+}
+
+/**
+* Moves all the fields of an element to another position.
+*
+* \param sourcePos is the position of the element that will be moved
+* \param targetPos is the position the element will be moved to
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawMove(std::size_t sourcePos, std::size_t targetPos)
+{
+    std::size_t sourceOffset = sourcePos * m_nFields;
+    std::size_t targetOffset = targetPos * m_nFields;
+    for (std::size_t k = 0; k < m_nFields; ++k) {
+        m_fields[targetOffset + k] = std::move(m_fields[sourceOffset + k]);
+    }
+}
+
+/**
+* Moves the elements of the storage in a single pass.
+*
+* Moves are specified as a list of pairs: the first value of the pair is
+* the position whose contents will be updated, the second value is the
+* position the updated contents will be taken from. Source positions refer
+* to the storage before the moves are applied. If the source position is
+* equal to the maximum value of std::size_t, the element will be reset.
+*
+* After extracting the moved elements, and before placing them in their
+* final positions, the storage is first shrunk to the specified kept size
+* and then resized to the specified final size. Hence, elements past the
+* kept size that are not updated by the moves will be reset.
+*
+* \param moves are the moves that will be applied
+* \param keptSize is the number of elements preserved by the moves, if it
+* is equal to the maximum value of std::size_t, all elements are preserved
+* \param size is the final size of the storage, if it is equal to the
+* maximum value of std::size_t, the size of the storage will not be changed
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawGather(const std::vector<std::size_t> &moves, std::size_t keptSize, std::size_t size)
+{
+    const std::size_t UNDEFINED_POS = std::numeric_limits<std::size_t>::max();
+
+    std::size_t nMoves = moves.size() / 2;
+
+    // Extract the elements that will be moved
+    container_t movedFields;
+    movedFields.reserve(nMoves * m_nFields);
+    for (std::size_t i = 0; i < nMoves; ++i) {
+        std::size_t source = moves[2 * i + 1];
+        if (source == UNDEFINED_POS) {
+            continue;
+        }
+
+        std::size_t sourceOffset = source * m_nFields;
         for (std::size_t k = 0; k < m_nFields; ++k) {
-            fieldPermutations[posOffset + k] = permutationOffset + k;
+            movedFields.push_back(std::move(m_fields[sourceOffset + k]));
         }
     }
 
-    // Sort the fields
-    utils::reorderVector<value_t>(fieldPermutations, m_fields, storageRawSize * m_nFields);
+    // Resize the storage
+    if (keptSize != UNDEFINED_POS && keptSize < rawSize()) {
+        rawResize(keptSize);
+    }
+
+    if (size != UNDEFINED_POS) {
+        rawResize(size);
+    }
+
+    // Place the moved elements
+    std::size_t movedOffset = 0;
+    for (std::size_t i = 0; i < nMoves; ++i) {
+        std::size_t pos    = moves[2 * i];
+        std::size_t source = moves[2 * i + 1];
+        if (source == UNDEFINED_POS) {
+            rawEmreplace(pos);
+            continue;
+        }
+
+        std::size_t posOffset = pos * m_nFields;
+        for (std::size_t k = 0; k < m_nFields; ++k) {
+            m_fields[posOffset + k] = std::move(movedFields[movedOffset + k]);
+        }
+        movedOffset += m_nFields;
+    }
 }
 
 /**
@@ -990,8 +1123,8 @@ void PiercedStorage<value_t, id_t>::rawReorder(const std::vector<std::size_t> &p
 * \param value is the value to be copied (or moved) to the newly created
 * elements
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawResize(std::size_t n, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawResize(std::size_t n, const value_t &value)
 {
     m_fields.resize(m_nFields * n, value);
 }
@@ -1002,9 +1135,9 @@ void PiercedStorage<value_t, id_t>::rawResize(std::size_t n, const value_t &valu
 * \param pos is the position of the element to initialize
 * \param args are the arguments forwarded to initialize the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args, typename PiercedStorage<value_t>::template EnableIfHasInitialize<Args...> * >
-void PiercedStorage<value_t, id_t>::rawInitialize(std::size_t pos, Args&&... args)
+void PiercedStorage<value_t, id_t, allocator_t>::rawInitialize(std::size_t pos, Args&&... args)
 {
     if (m_nFields == 0) {
         return;
@@ -1023,9 +1156,9 @@ void PiercedStorage<value_t, id_t>::rawInitialize(std::size_t pos, Args&&... arg
 * \param k is the index of the field to initialize
 * \param args are the arguments forwarded to initialize the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args, typename PiercedStorage<value_t>::template EnableIfHasInitialize<Args...> * >
-void PiercedStorage<value_t, id_t>::rawInitialize(std::size_t pos, std::size_t k, Args&&... args)
+void PiercedStorage<value_t, id_t, allocator_t>::rawInitialize(std::size_t pos, std::size_t k, Args&&... args)
 {
     rawAt(pos, k).initialize(std::forward<Args>(args)...);
 }
@@ -1037,8 +1170,8 @@ void PiercedStorage<value_t, id_t>::rawInitialize(std::size_t pos, std::size_t k
 * \param n is the number of new elements that will be inserted
 * \param value is the value to be copied (or moved) to the inserted elements
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawInsert(std::size_t pos, std::size_t n, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawInsert(std::size_t pos, std::size_t n, const value_t &value)
 {
     m_fields.insert(m_fields.begin() + pos * m_nFields, n * m_nFields, value);
 }
@@ -1048,8 +1181,8 @@ void PiercedStorage<value_t, id_t>::rawInsert(std::size_t pos, std::size_t n, co
 *
 * \param value is the value to be copied (or moved) to the inserted elements
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawPushBack(const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawPushBack(const value_t &value)
 {
     for (std::size_t k = 0; k < m_nFields; ++k) {
         m_fields.push_back(value);
@@ -1063,9 +1196,9 @@ void PiercedStorage<value_t, id_t>::rawPushBack(const value_t &value)
 * \param pos is the position where the new element will be inserted
 * \param args are the arguments forwarded to construct the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<!std::is_same<T, bool>::value>::type *, typename... Args>
-void PiercedStorage<value_t, id_t>::rawEmplace(std::size_t pos, Args&&... args)
+void PiercedStorage<value_t, id_t, allocator_t>::rawEmplace(std::size_t pos, Args&&... args)
 {
     if (m_nFields == 0) {
         return;
@@ -1084,9 +1217,9 @@ void PiercedStorage<value_t, id_t>::rawEmplace(std::size_t pos, Args&&... args)
 * \param pos is the position where the new element will be inserted
 * \param value is the value assigned to the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_same<T, bool>::value>::type *>
-void PiercedStorage<value_t, id_t>::rawEmplace(std::size_t pos, bool value)
+void PiercedStorage<value_t, id_t, allocator_t>::rawEmplace(std::size_t pos, bool value)
 {
     rawInsert(pos, 1, value);
 }
@@ -1098,9 +1231,9 @@ void PiercedStorage<value_t, id_t>::rawEmplace(std::size_t pos, bool value)
 *
 * \param args are the arguments forwarded to construct the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<!std::is_same<T, bool>::value>::type *, typename... Args>
-void PiercedStorage<value_t, id_t>::rawEmplaceBack(Args&&... args)
+void PiercedStorage<value_t, id_t, allocator_t>::rawEmplaceBack(Args&&... args)
 {
     if (m_nFields == 0) {
         return;
@@ -1119,9 +1252,9 @@ void PiercedStorage<value_t, id_t>::rawEmplaceBack(Args&&... args)
 *
 * \param value is the value assigned to the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_same<T, bool>::value>::type *>
-void PiercedStorage<value_t, id_t>::rawEmplaceBack(bool value)
+void PiercedStorage<value_t, id_t, allocator_t>::rawEmplaceBack(bool value)
 {
     rawPushBack(value);
 }
@@ -1134,9 +1267,9 @@ void PiercedStorage<value_t, id_t>::rawEmplaceBack(bool value)
 * \param pos is the position where the new element will be inserted
 * \param args are the arguments forwarded to construct the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-void PiercedStorage<value_t, id_t>::rawEmreplace(std::size_t pos, Args&&... args)
+void PiercedStorage<value_t, id_t, allocator_t>::rawEmreplace(std::size_t pos, Args&&... args)
 {
     if (m_nFields == 0) {
         return;
@@ -1162,8 +1295,8 @@ void PiercedStorage<value_t, id_t>::rawEmreplace(std::size_t pos, Args&&... args
 * same template parameters) whose content is swapped with that of this
 * storage.
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::swap(PiercedStorage &other) noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::swap(PiercedStorage &other) noexcept
 {
     // It is only possible to swap two storages with the same number of field.
     // If this condition is not fulfilled we can not continue. However, we
@@ -1184,8 +1317,8 @@ void PiercedStorage<value_t, id_t>::swap(PiercedStorage &other) noexcept
 *
 * \param value is the value to be assigned
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::fill(const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::fill(const value_t &value)
 {
     std::fill(m_fields.begin(), m_fields.end(), value);
 }
@@ -1197,8 +1330,8 @@ void PiercedStorage<value_t, id_t>::fill(const value_t &value)
 * \result A constant pointer to the memory array used internally by the
 * vector to store its owned elements.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_POINTER__ PiercedStorage<value_t, id_t>::data() const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_POINTER__ PiercedStorage<value_t, id_t, allocator_t>::data() const
 {
     return m_fields.data();
 }
@@ -1210,8 +1343,8 @@ __PS_CONST_POINTER__ PiercedStorage<value_t, id_t>::data() const
 * \result A pointer to the memory array used internally by the vector to
 * store its owned elements.
 */
-template<typename value_t, typename id_t>
-__PS_POINTER__ PiercedStorage<value_t, id_t>::data()
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_POINTER__ PiercedStorage<value_t, id_t, allocator_t>::data()
 {
     return m_fields.data();
 }
@@ -1223,8 +1356,8 @@ __PS_POINTER__ PiercedStorage<value_t, id_t>::data()
 * \param offset is the offset relative to the first field
 * \result A pointer to the data of the specfied item.
 */
-template<typename value_t, typename id_t>
-__PS_POINTER__ PiercedStorage<value_t, id_t>::data(id_t id, std::size_t offset)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_POINTER__ PiercedStorage<value_t, id_t, allocator_t>::data(id_t id, std::size_t offset)
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1238,8 +1371,8 @@ __PS_POINTER__ PiercedStorage<value_t, id_t>::data(id_t id, std::size_t offset)
 * \param offset is the offset relative to the first field
 * \result A constant pointer to the data of the specfied item.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_POINTER__ PiercedStorage<value_t, id_t>::data(id_t id, std::size_t offset) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_POINTER__ PiercedStorage<value_t, id_t, allocator_t>::data(id_t id, std::size_t offset) const
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1255,8 +1388,8 @@ __PS_CONST_POINTER__ PiercedStorage<value_t, id_t>::data(id_t id, std::size_t of
 * \result A constant pointer to the data of the item at the specified raw
 * position.
 */
-template<typename value_t, typename id_t>
-__PS_POINTER__ PiercedStorage<value_t, id_t>::rawData(std::size_t pos, std::size_t offset)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_POINTER__ PiercedStorage<value_t, id_t, allocator_t>::rawData(std::size_t pos, std::size_t offset)
 {
     return (data() + pos * m_nFields + offset);
 }
@@ -1270,8 +1403,8 @@ __PS_POINTER__ PiercedStorage<value_t, id_t>::rawData(std::size_t pos, std::size
 * \result A pointer to the data of the item at the specified raw
 * position.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_POINTER__ PiercedStorage<value_t, id_t>::rawData(std::size_t pos, std::size_t offset) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_POINTER__ PiercedStorage<value_t, id_t, allocator_t>::rawData(std::size_t pos, std::size_t offset) const
 {
     return (data() + pos * m_nFields + offset);
 }
@@ -1284,8 +1417,8 @@ __PS_CONST_POINTER__ PiercedStorage<value_t, id_t>::rawData(std::size_t pos, std
 * \param k is the index of the requested field
 * \result A reference to the first element of the container.
 */
-template<typename value_t, typename id_t>
-__PS_REFERENCE__ PiercedStorage<value_t, id_t>::front(std::size_t k)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::front(std::size_t k)
 {
     if (this->m_kernel->empty()) {
         throw std::out_of_range("Vector is empty");
@@ -1302,8 +1435,8 @@ __PS_REFERENCE__ PiercedStorage<value_t, id_t>::front(std::size_t k)
 * \param k is the index of the requested field
 * \result A constant reference to the first element of the container.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::front(std::size_t k) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::front(std::size_t k) const
 {
     if (this->m_kernel->empty()) {
         throw std::out_of_range("Vector is empty");
@@ -1320,8 +1453,8 @@ __PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::front(std::size_t k) const
 * \param k is the index of the requested field
 * \result A reference to the last element of the container.
 */
-template<typename value_t, typename id_t>
-__PS_REFERENCE__ PiercedStorage<value_t, id_t>::back(std::size_t k)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::back(std::size_t k)
 {
     if (this->m_kernel->empty()) {
         throw std::out_of_range("Vector is empty");
@@ -1338,8 +1471,8 @@ __PS_REFERENCE__ PiercedStorage<value_t, id_t>::back(std::size_t k)
 * \param k is the index of the requested field
 * \result A constant reference to the last element of the container.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::back(std::size_t k) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::back(std::size_t k) const
 {
     if (this->m_kernel->empty()) {
         throw std::out_of_range("Vector is empty");
@@ -1356,8 +1489,8 @@ __PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::back(std::size_t k) const
 * \param k is the index of the requested field
 * \result A reference to the requested field of the specfied item.
 */
-template<typename value_t, typename id_t>
-__PS_REFERENCE__ PiercedStorage<value_t, id_t>::at(id_t id, std::size_t k)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::at(id_t id, std::size_t k)
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1371,8 +1504,8 @@ __PS_REFERENCE__ PiercedStorage<value_t, id_t>::at(id_t id, std::size_t k)
 * \param k is the index of the requested field
 * \result A constant reference to the requested field of the specfied item.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::at(id_t id, std::size_t k) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::at(id_t id, std::size_t k) const
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1385,8 +1518,8 @@ __PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::at(id_t id, std::size_t k)
 * \param id is the id of the item
 * \result A reference to the requested field of the specfied item.
 */
-template<typename value_t, typename id_t>
-__PS_REFERENCE__ PiercedStorage<value_t, id_t>::operator[](id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::operator[](id_t id)
 {
     return at(id, 0);
 }
@@ -1397,8 +1530,8 @@ __PS_REFERENCE__ PiercedStorage<value_t, id_t>::operator[](id_t id)
 * \param id is the id of the item
 * \result A constant reference to the requested field of the specfied item.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::operator[](id_t id) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::operator[](id_t id) const
 {
     return at(id, 0);
 }
@@ -1409,8 +1542,8 @@ __PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::operator[](id_t id) const
 * \param id is the id of the item
 * \param values is a pointer to the destination
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::copy(id_t id, value_t *values) const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::copy(id_t id, value_t *values) const
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1425,8 +1558,8 @@ void PiercedStorage<value_t, id_t>::copy(id_t id, value_t *values) const
 * \param offset is the offset used for setting the fields
 * \param values is a pointer to the destination
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::copy(id_t id, std::size_t nFields, std::size_t offset, value_t *values) const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::copy(id_t id, std::size_t nFields, std::size_t offset, value_t *values) const
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1439,8 +1572,8 @@ void PiercedStorage<value_t, id_t>::copy(id_t id, std::size_t nFields, std::size
 * \param id is the id of the item
 * \param value is the value that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::set(id_t id, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::set(id_t id, const value_t &value)
 {
     for (std::size_t k = 0; k < m_nFields; ++k) {
         set(id, k, value);
@@ -1454,8 +1587,8 @@ void PiercedStorage<value_t, id_t>::set(id_t id, const value_t &value)
 * \param k is the index of the requested field
 * \param value is the value that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::set(id_t id, std::size_t k, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::set(id_t id, std::size_t k, const value_t &value)
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1468,8 +1601,8 @@ void PiercedStorage<value_t, id_t>::set(id_t id, std::size_t k, const value_t &v
 * \param id is the id of the item
 * \param values is a pointer to the values that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::set(id_t id, const value_t *values)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::set(id_t id, const value_t *values)
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1484,8 +1617,8 @@ void PiercedStorage<value_t, id_t>::set(id_t id, const value_t *values)
 * \param offset is the offset used for setting the fields
 * \param values is a pointer to the values that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::set(id_t id, std::size_t nFields, std::size_t offset, const value_t *values)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::set(id_t id, std::size_t nFields, std::size_t offset, const value_t *values)
 {
     std::size_t pos = this->m_kernel->getPos(id);
 
@@ -1501,8 +1634,8 @@ void PiercedStorage<value_t, id_t>::set(id_t id, std::size_t nFields, std::size_
 * \result A reference to the requested field of the item at the specified
 * raw position.
 */
-template<typename value_t, typename id_t>
-__PS_REFERENCE__ PiercedStorage<value_t, id_t>::rawAt(std::size_t pos, std::size_t k)
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::rawAt(std::size_t pos, std::size_t k)
 {
     return m_fields[pos * m_nFields + k];
 }
@@ -1516,8 +1649,8 @@ __PS_REFERENCE__ PiercedStorage<value_t, id_t>::rawAt(std::size_t pos, std::size
 * \result A constant reference to the requested field of the item at the
 * specified raw position.
 */
-template<typename value_t, typename id_t>
-__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::rawAt(std::size_t pos, std::size_t k) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t, allocator_t>::rawAt(std::size_t pos, std::size_t k) const
 {
     return m_fields[pos * m_nFields + k];
 }
@@ -1528,8 +1661,8 @@ __PS_CONST_REFERENCE__ PiercedStorage<value_t, id_t>::rawAt(std::size_t pos, std
 * \param pos is the raw position of the item
 * \param values is a pointer to the destination
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawCopy(std::size_t pos, value_t *values) const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawCopy(std::size_t pos, value_t *values) const
 {
     rawCopy(pos, getFieldCount(), 0, values);
 }
@@ -1542,8 +1675,8 @@ void PiercedStorage<value_t, id_t>::rawCopy(std::size_t pos, value_t *values) co
 * \param offset is the offset used for setting the fields
 * \param values is a pointer to the destination
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawCopy(std::size_t pos, std::size_t nFields, std::size_t offset, value_t *values) const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawCopy(std::size_t pos, std::size_t nFields, std::size_t offset, value_t *values) const
 {
     nFields = std::max(nFields, getFieldCount() - offset);
     for (std::size_t k = offset; k < (offset + nFields); ++k) {
@@ -1557,8 +1690,8 @@ void PiercedStorage<value_t, id_t>::rawCopy(std::size_t pos, std::size_t nFields
 * \param pos is the raw position of the item
 * \param value is the value that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawSet(std::size_t pos, const value_t &value)
 {
     for (std::size_t k = 0; k < m_nFields; ++k) {
         rawSet(pos, k, value);
@@ -1572,8 +1705,8 @@ void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, const value_t &value
 * \param k is the index of the requested field
 * \param value is the value that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, std::size_t k, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawSet(std::size_t pos, std::size_t k, const value_t &value)
 {
     m_fields[pos * m_nFields + k] = value;
 }
@@ -1584,8 +1717,8 @@ void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, std::size_t k, const
 * \param pos is the raw position of the item
 * \param values is a pointer to the values that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, const value_t *values)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawSet(std::size_t pos, const value_t *values)
 {
     rawSet(pos, getFieldCount(), 0, values);
 }
@@ -1598,8 +1731,8 @@ void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, const value_t *value
 * \param offset is the offset used for setting the fields
 * \param values is a pointer to the values that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, std::size_t nFields, std::size_t offset, const value_t *values)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::rawSet(std::size_t pos, std::size_t nFields, std::size_t offset, const value_t *values)
 {
     nFields = std::max(nFields, getFieldCount() - offset);
     for (std::size_t k = offset; k < (offset + nFields); ++k) {
@@ -1607,14 +1740,150 @@ void PiercedStorage<value_t, id_t>::rawSet(std::size_t pos, std::size_t nFields,
     }
 }
 
+/**
+* Gets the size, expressed in bytes, of the buffer needed to pack the
+* specified number of items.
+*
+* \param nItems is the number of items
+* \result The size, expressed in bytes, of the buffer needed to pack the
+* specified number of items.
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+std::size_t PiercedStorage<value_t, id_t, allocator_t>::getPackedSize(std::size_t nItems) const
+{
+    return nItems * m_nFields * sizeof(value_t);
+}
+
+/**
+* Packs the items at the specified raw positions into the given buffer.
+*
+* All the fields of the items are copied, one item after the other, in the
+* order the positions are listed. The layout of the packed data is the same
+* that would be obtained streaming the fields one by one, but runs of items
+* stored in consecutive positions are copied with a single memory copy.
+*
+* The buffer should be large enough to contain the packed items (see
+* getPackedSize()). There are no alignment requirements on the buffer.
+*
+* \param nItems is the number of items that will be packed
+* \param positions are the raw positions of the items
+* \param buffer is the buffer where the items will be packed
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename T, typename std::enable_if<!std::is_same<T, bool>::value>::type *>
+void PiercedStorage<value_t, id_t, allocator_t>::rawPack(std::size_t nItems, const std::size_t *positions, char *buffer) const
+{
+    static_assert(std::is_trivially_copyable<value_t>::value, "Only trivially copyable types can be packed.");
+
+    const std::size_t itemSize = getPackedSize(1);
+
+    std::size_t n = 0;
+    while (n < nItems) {
+        std::size_t runBegin = n;
+        std::size_t runPos   = positions[n];
+        do {
+            ++n;
+        } while (n < nItems && positions[n] == runPos + (n - runBegin));
+
+        std::size_t runSize = (n - runBegin) * itemSize;
+        std::memcpy(buffer, m_fields.data() + runPos * m_nFields, runSize);
+        buffer += runSize;
+    }
+}
+
+/**
+* Packs the items at the specified raw positions into the given buffer.
+*
+* All the fields of the items are copied, one item after the other, in the
+* order the positions are listed.
+*
+* The buffer should be large enough to contain the packed items (see
+* getPackedSize()).
+*
+* \param nItems is the number of items that will be packed
+* \param positions are the raw positions of the items
+* \param buffer is the buffer where the items will be packed
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename T, typename std::enable_if<std::is_same<T, bool>::value>::type *>
+void PiercedStorage<value_t, id_t, allocator_t>::rawPack(std::size_t nItems, const std::size_t *positions, char *buffer) const
+{
+    for (std::size_t n = 0; n < nItems; ++n) {
+        std::size_t offset = positions[n] * m_nFields;
+        for (std::size_t k = 0; k < m_nFields; ++k) {
+            bool value = m_fields[offset + k];
+            std::memcpy(buffer, &value, sizeof(bool));
+            buffer += sizeof(bool);
+        }
+    }
+}
+
+/**
+* Unpacks the items at the specified raw positions from the given buffer.
+*
+* The buffer should contain the items in the layout produced by rawPack().
+* Data is copied directly from the buffer into the storage, hence the buffer
+* can point to data that is still owned by a stream. There are no alignment
+* requirements on the buffer.
+*
+* \param nItems is the number of items that will be unpacked
+* \param positions are the raw positions of the items
+* \param buffer is the buffer that contains the packed items
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename T, typename std::enable_if<!std::is_same<T, bool>::value>::type *>
+void PiercedStorage<value_t, id_t, allocator_t>::rawUnpack(std::size_t nItems, const std::size_t *positions, const char *buffer)
+{
+    static_assert(std::is_trivially_copyable<value_t>::value, "Only trivially copyable types can be unpacked.");
+
+    const std::size_t itemSize = getPackedSize(1);
+
+    std::size_t n = 0;
+    while (n < nItems) {
+        std::size_t runBegin = n;
+        std::size_t runPos   = positions[n];
+        do {
+            ++n;
+        } while (n < nItems && positions[n] == runPos + (n - runBegin));
+
+        std::size_t runSize = (n - runBegin) * itemSize;
+        std::memcpy(m_fields.data() + runPos * m_nFields, buffer, runSize);
+        buffer += runSize;
+    }
+}
+
+/**
+* Unpacks the items at the specified raw positions from the given buffer.
+*
+* The buffer should contain the items in the layout produced by rawPack().
+*
+* \param nItems is the number of items that will be unpacked
+* \param positions are the raw positions of the items
+* \param buffer is the buffer that contains the packed items
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename T, typename std::enable_if<std::is_same<T, bool>::value>::type *>
+void PiercedStorage<value_t, id_t, allocator_t>::rawUnpack(std::size_t nItems, const std::size_t *positions, const char *buffer)
+{
+    for (std::size_t n = 0; n < nItems; ++n) {
+        std::size_t offset = positions[n] * m_nFields;
+        for (std::size_t k = 0; k < m_nFields; ++k) {
+            bool value;
+            std::memcpy(&value, buffer, sizeof(bool));
+            m_fields[offset + k] = value;
+            buffer += sizeof(bool);
+        }
+    }
+}
+
 /**
 * Gets an iterator pointing to the specified element.
 *
 * \param id is the id of the specified iterator.
 * \result An iterator pointing to the specified element.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::find(const id_t &id) noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::iterator PiercedStorage<value_t, id_t, allocator_t>::find(const id_t &id) noexcept
 {
     typename PiercedKernel<id_t>::const_iterator iterator = this->m_kernel->find(id);
 
@@ -1627,8 +1896,8 @@ typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::
 * \param id is the id of the specified iterator.
 * \result A constant iterator pointing to the specified element.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, id_t>::find(const id_t &id) const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::const_iterator PiercedStorage<value_t, id_t, allocator_t>::find(const id_t &id) const noexcept
 {
     typename PiercedKernel<id_t>::const_iterator iterator = this->m_kernel->find(id);
 
@@ -1641,8 +1910,8 @@ typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, i
 * \param pos is the requested position
 * \result An iterator pointing to the specified position.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::rawFind(std::size_t pos) noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::iterator PiercedStorage<value_t, id_t, allocator_t>::rawFind(std::size_t pos) noexcept
 {
     return iterator(this, pos);
 }
@@ -1653,19 +1922,77 @@ typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::
 * \param pos is the requested position
 * \result A constant iterator pointing to the specified position.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, id_t>::rawFind(std::size_t pos) const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::const_iterator PiercedStorage<value_t, id_t, allocator_t>::rawFind(std::size_t pos) const noexcept
 {
     return const_iterator(this, pos);
 }
 
+/**
+* Splits the storage into the specified number of ranges.
+*
+* Ranges are evaluated by the kernel, see PiercedKernel::split() for the
+* details. Ranges are disjoint, hence they can be processed concurrently by
+* different threads, as long as the storage and its kernel are not modified
+* while the ranges are in use.
+*
+* \param nChunks is the requested number of ranges
+* \result The ranges the storage has been split into.
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+std::vector<typename PiercedStorage<value_t, id_t, allocator_t>::range> PiercedStorage<value_t, id_t, allocator_t>::split(std::size_t nChunks)
+{
+    std::vector<std::size_t> boundaries = this->m_kernel->evalChunkBoundaries(nChunks);
+
+    std::vector<range> chunks;
+    if (boundaries.size() < 2) {
+        return chunks;
+    }
+
+    std::size_t nActualChunks = boundaries.size() - 1;
+    chunks.reserve(nActualChunks);
+    for (std::size_t k = 0; k < nActualChunks; ++k) {
+        chunks.emplace_back(rawFind(boundaries[k]), rawFind(boundaries[k + 1]));
+    }
+
+    return chunks;
+}
+
+/**
+* Splits the storage into the specified number of constant ranges.
+*
+* Ranges are evaluated by the kernel, see PiercedKernel::split() for the
+* details.
+*
+* \param nChunks is the requested number of ranges
+* \result The constant ranges the storage has been split into.
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+std::vector<typename PiercedStorage<value_t, id_t, allocator_t>::const_range> PiercedStorage<value_t, id_t, allocator_t>::split(std::size_t nChunks) const
+{
+    std::vector<std::size_t> boundaries = this->m_kernel->evalChunkBoundaries(nChunks);
+
+    std::vector<const_range> chunks;
+    if (boundaries.size() < 2) {
+        return chunks;
+    }
+
+    std::size_t nActualChunks = boundaries.size() - 1;
+    chunks.reserve(nActualChunks);
+    for (std::size_t k = 0; k < nActualChunks; ++k) {
+        chunks.emplace_back(rawFind(boundaries[k]), rawFind(boundaries[k + 1]));
+    }
+
+    return chunks;
+}
+
 /*!
 * Returns an iterator pointing to the first element in the vector.
 *
 * \result An iterator pointing to the first element in the vector.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::begin() noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::iterator PiercedStorage<value_t, id_t, allocator_t>::begin() noexcept
 {
     return rawFind(this->m_kernel->m_begin_pos);
 }
@@ -1675,8 +2002,8 @@ typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::
 *
 * \result An iterator referring to the past-the-end element in the vector.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::end() noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::iterator PiercedStorage<value_t, id_t, allocator_t>::end() noexcept
 {
     return rawFind(this->m_kernel->m_end_pos);
 }
@@ -1686,8 +2013,8 @@ typename PiercedStorage<value_t, id_t>::iterator PiercedStorage<value_t, id_t>::
 *
 * \result A constant iterator pointing to the first element in the vector.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, id_t>::begin() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::const_iterator PiercedStorage<value_t, id_t, allocator_t>::begin() const noexcept
 {
     return cbegin();
 }
@@ -1699,8 +2026,8 @@ typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, i
 * \result A constant iterator referring to the past-the-end element in the
 * vector.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, id_t>::end() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::const_iterator PiercedStorage<value_t, id_t, allocator_t>::end() const noexcept
 {
     return cend();
 }
@@ -1710,8 +2037,8 @@ typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, i
 *
 * \result A const_iterator pointing to the first element in the vector.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, id_t>::cbegin() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::const_iterator PiercedStorage<value_t, id_t, allocator_t>::cbegin() const noexcept
 {
     return rawFind(this->m_kernel->m_begin_pos);
 }
@@ -1722,8 +2049,8 @@ typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, i
 *
 * \result A const_iterator referring to the past-the-end element in the vector.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, id_t>::cend() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::const_iterator PiercedStorage<value_t, id_t, allocator_t>::cend() const noexcept
 {
     return rawFind(this->m_kernel->m_end_pos);
 }
@@ -1733,8 +2060,8 @@ typename PiercedStorage<value_t, id_t>::const_iterator PiercedStorage<value_t, i
 *
 * \result An iterator pointing to the first element in the raw container.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::raw_iterator PiercedStorage<value_t, id_t>::rawBegin() noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::raw_iterator PiercedStorage<value_t, id_t, allocator_t>::rawBegin() noexcept
 {
     return m_fields.begin();
 }
@@ -1746,8 +2073,8 @@ typename PiercedStorage<value_t, id_t>::raw_iterator PiercedStorage<value_t, id_
 * \result An iterator referring to the past-the-end element in the raw
 * container.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::raw_iterator PiercedStorage<value_t, id_t>::rawEnd() noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::raw_iterator PiercedStorage<value_t, id_t, allocator_t>::rawEnd() noexcept
 {
     return m_fields.end();
 }
@@ -1759,8 +2086,8 @@ typename PiercedStorage<value_t, id_t>::raw_iterator PiercedStorage<value_t, id_
 * \result A constant iterator pointing to the first element in the raw
 * container.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawBegin() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::raw_const_iterator PiercedStorage<value_t, id_t, allocator_t>::rawBegin() const noexcept
 {
     return rawCbegin();
 }
@@ -1772,8 +2099,8 @@ typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_
 * \result A constant iterator referring to the past-the-end element in the raw
 * container.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawEnd() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::raw_const_iterator PiercedStorage<value_t, id_t, allocator_t>::rawEnd() const noexcept
 {
     return rawCend();
 }
@@ -1783,8 +2110,8 @@ typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_
 *
 * \result A const_iterator pointing to the first element in the raw container.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawCbegin() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::raw_const_iterator PiercedStorage<value_t, id_t, allocator_t>::rawCbegin() const noexcept
 {
     return m_fields.cbegin();
 }
@@ -1796,8 +2123,8 @@ typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_
 * \result A const_iterator referring to the past-the-end element in raw
 * container.
 */
-template<typename value_t, typename id_t>
-typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawCend() const noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedStorage<value_t, id_t, allocator_t>::raw_const_iterator PiercedStorage<value_t, id_t, allocator_t>::rawCend() const noexcept
 {
     return m_fields.cend();
 }
@@ -1807,9 +2134,9 @@ typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_
 *
 * \param stream is the stream data should be read from
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_pod<T>::value || PiercedStorage<T, id_t>::has_restore()>::type *>
-void PiercedStorage<value_t, id_t>::restore(std::istream &stream)
+void PiercedStorage<value_t, id_t, allocator_t>::restore(std::istream &stream)
 {
     // Size
     std::size_t nElements;
@@ -1828,8 +2155,8 @@ void PiercedStorage<value_t, id_t>::restore(std::istream &stream)
 * \param stream is the stream data should be read from
 * \param value on output will contain the restored value
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::restoreField(std::istream &stream, std::vector<bool>::reference value)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::restoreField(std::istream &stream, std::vector<bool>::reference value)
 {
     bool bool_value;
     utils::binary::read(stream, bool_value);
@@ -1842,9 +2169,9 @@ void PiercedStorage<value_t, id_t>::restoreField(std::istream &stream, std::vect
 * \param stream is the stream data should be read from
 * \param value on output will contain the restored value
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<!PiercedStorage<T, id_t>::has_restore()>::type *>
-void PiercedStorage<value_t, id_t>::restoreField(std::istream &stream, value_t &value)
+void PiercedStorage<value_t, id_t, allocator_t>::restoreField(std::istream &stream, value_t &value)
 {
     utils::binary::read(stream, value);
 }
@@ -1856,9 +2183,9 @@ void PiercedStorage<value_t, id_t>::restoreField(std::istream &stream, value_t &
 * \param stream is the stream data should be read from
 * \param object on output will contain the restored object
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<PiercedStorage<T, id_t>::has_restore()>::type *>
-void PiercedStorage<value_t, id_t>::restoreField(std::istream &stream, value_t &object)
+void PiercedStorage<value_t, id_t, allocator_t>::restoreField(std::istream &stream, value_t &object)
 {
     object.restore(stream);
 }
@@ -1868,9 +2195,9 @@ void PiercedStorage<value_t, id_t>::restoreField(std::istream &stream, value_t &
 *
 * \param stream is the stream data should be written to
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_pod<T>::value || PiercedStorage<T, id_t>::has_dump()>::type *>
-void PiercedStorage<value_t, id_t>::dump(std::ostream &stream) const
+void PiercedStorage<value_t, id_t, allocator_t>::dump(std::ostream &stream) const
 {
     // Size
     utils::binary::write(stream, rawSize());
@@ -1887,8 +2214,8 @@ void PiercedStorage<value_t, id_t>::dump(std::ostream &stream) const
 * \param stream is the stream data should be written to
 * \param value is the value that will be dumped
 */
-template<typename value_t, typename id_t>
-void PiercedStorage<value_t, id_t>::dumpField(std::ostream &stream, std::vector<bool>::const_reference value) const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedStorage<value_t, id_t, allocator_t>::dumpField(std::ostream &stream, std::vector<bool>::const_reference value) const
 {
     bool bool_value = value;
     utils::binary::write(stream, bool_value);
@@ -1900,9 +2227,9 @@ void PiercedStorage<value_t, id_t>::dumpField(std::ostream &stream, std::vector<
 * \param stream is the stream data should be written to
 * \param value is the value that will be dumped
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<!PiercedStorage<T, id_t>::has_dump()>::type *>
-void PiercedStorage<value_t, id_t>::dumpField(std::ostream &stream, const value_t &value) const
+void PiercedStorage<value_t, id_t, allocator_t>::dumpField(std::ostream &stream, const value_t &value) const
 {
     utils::binary::write(stream, value);
 }
@@ -1913,9 +2240,9 @@ void PiercedStorage<value_t, id_t>::dumpField(std::ostream &stream, const value_
 * \param stream is the stream data should be written to
 * \param object is the object that will be dumped
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<PiercedStorage<T, id_t>::has_dump()>::type *>
-void PiercedStorage<value_t, id_t>::dumpField(std::ostream &stream, const value_t &object) const
+void PiercedStorage<value_t, id_t, allocator_t>::dumpField(std::ostream &stream, const value_t &object) const
 {
     object.dump(stream);
 }
@@ -30,12 +30,12 @@
 #include <limits>
 #include <type_traits>
 
-#define  __PSI_REFERENCE__ typename PiercedStorageIterator<value_t, id_t, value_no_cv_t>::reference
-#define  __PSI_POINTER__   typename PiercedStorageIterator<value_t, id_t, value_no_cv_t>::pointer
+#define  __PSI_REFERENCE__ typename PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::reference
+#define  __PSI_POINTER__   typename PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::pointer
 
 namespace bitpit{
 
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 class PiercedStorage;
 
 /**
@@ -45,24 +45,26 @@ class PiercedStorage;
 *
 * \tparam value_t is the type of elements in the storage
 * \tparam id_t is the type of ids associated to the elements
+* \tparam allocator_t is the allocator used by the storage
 */
 template<typename value_t, typename id_t = long,
+         typename allocator_t = std::allocator<typename std::remove_cv<value_t>::type>,
          typename value_no_cv_t = typename std::remove_cv<value_t>::type>
 class PiercedStorageIterator
     : protected PiercedKernelIterator<id_t>
 {
 
-friend class PiercedStorageIterator<typename std::add_const<value_t>::type, id_t, value_no_cv_t>;
+friend class PiercedStorageIterator<typename std::add_const<value_t>::type, id_t, allocator_t, value_no_cv_t>;
 
-template<typename PS_value_t, typename PS_id_t>
+template<typename PS_value_t, typename PS_id_t, typename PS_allocator_t>
 friend class PiercedStorage;
 
 private:
     /**
     * Storage.
     */
-    template<typename PS_value_t, typename PS_id_t>
-    using Storage = PiercedStorage<PS_value_t, PS_id_t>;
+    template<typename PS_value_t, typename PS_id_t, typename PS_allocator_t>
+    using Storage = PiercedStorage<PS_value_t, PS_id_t, PS_allocator_t>;
 
     /**
     * Storage type
@@ -72,8 +74,8 @@ private:
     */
     typedef
         typename std::conditional<std::is_const<value_t>::value,
-            const Storage<value_no_cv_t, id_t>,
-            Storage<value_no_cv_t, id_t>
+            const Storage<value_no_cv_t, id_t, allocator_t>,
+            Storage<value_no_cv_t, id_t, allocator_t>
         >::type
 
         storage_t;
@@ -104,8 +106,8 @@ public:
     */
     typedef
         typename std::conditional<std::is_const<value_t>::value,
-            typename Storage<value_no_cv_t, id_t>::const_pointer,
-            typename Storage<value_no_cv_t, id_t>::pointer
+            typename Storage<value_no_cv_t, id_t, allocator_t>::const_pointer,
+            typename Storage<value_no_cv_t, id_t, allocator_t>::pointer
         >::type
 
         pointer;
@@ -115,8 +117,8 @@ public:
     */
     typedef
         typename std::conditional<std::is_const<value_t>::value,
-            typename Storage<value_no_cv_t, id_t>::const_reference,
-            typename Storage<value_no_cv_t, id_t>::reference
+            typename Storage<value_no_cv_t, id_t, allocator_t>::const_reference,
+            typename Storage<value_no_cv_t, id_t, allocator_t>::reference
         >::type
 
         reference;
@@ -130,7 +132,7 @@ public:
     PiercedStorageIterator();
 
     template<typename other_value_t, typename std::enable_if<std::is_const<value_t>::value && !std::is_const<other_value_t>::value && std::is_same<other_value_t, typename std::remove_cv<value_t>::type>::value, int>::type = 0>
-    PiercedStorageIterator(const PiercedStorageIterator<other_value_t, id_t, value_no_cv_t> &other);
+    PiercedStorageIterator(const PiercedStorageIterator<other_value_t, id_t, allocator_t, value_no_cv_t> &other);
 
     // General methods
     void swap(PiercedStorageIterator& other) noexcept;
@@ -156,7 +158,7 @@ public:
     __PSI_POINTER__ operator->() const;
 
     template<typename other_value_t, typename std::enable_if<std::is_const<value_t>::value && !std::is_const<other_value_t>::value && std::is_same<other_value_t, typename std::remove_cv<value_t>::type>::value, int>::type = 0>
-    PiercedStorageIterator & operator=(const PiercedStorageIterator<other_value_t, id_t, value_no_cv_t> &other);
+    PiercedStorageIterator & operator=(const PiercedStorageIterator<other_value_t, id_t, allocator_t, value_no_cv_t> &other);
 
     /**
     * Two-way comparison.
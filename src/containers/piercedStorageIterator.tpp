@@ -30,8 +30,8 @@ namespace bitpit {
 /**
 * Creates a new uninitialized iterator
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator()
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageIterator()
     : PiercedKernelIterator<id_t>(), m_storage(nullptr)
 {
 }
@@ -42,9 +42,9 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator()
 
     \param other is the iterator that will be copied
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<value_t>::value && !std::is_const<other_value_t>::value && std::is_same<other_value_t, typename std::remove_cv<value_t>::type>::value, int>::type>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator(const PiercedStorageIterator<other_value_t, id_t, value_no_cv_t> &other)
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageIterator(const PiercedStorageIterator<other_value_t, id_t, allocator_t, value_no_cv_t> &other)
     : PiercedStorageIterator(other.m_storage, other.getRawIndex())
 {
 }
@@ -53,8 +53,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator(con
 * Creates a new iterator and initializes it with the position of the const
 * base iterator recevied in input.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator(storage_t *storage, std::size_t pos)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageIterator(storage_t *storage, std::size_t pos)
     : PiercedKernelIterator<id_t>(storage->getKernel(), pos), m_storage(storage)
 {
 }
@@ -63,8 +63,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator(sto
 * Creates a new iterator and initializes it with the position of the const
 * base iterator recevied in input.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator(storage_t *storage, const bitpit::PiercedKernelIterator<id_t> &iterator)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageIterator(storage_t *storage, const bitpit::PiercedKernelIterator<id_t> &iterator)
     : PiercedKernelIterator<id_t>(iterator), m_storage(storage)
 {
     assert(&(iterator.getKernel()) == &(storage->getKernel()));
@@ -76,8 +76,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::PiercedStorageIterator(sto
 *
 * \param other the iterator to exchange values with
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-void PiercedStorageIterator<value_t, id_t, value_no_cv_t>::swap(PiercedStorageIterator& other) noexcept
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+void PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::swap(PiercedStorageIterator& other) noexcept
 {
     PiercedKernelIterator<id_t>::swap();
 
@@ -89,8 +89,8 @@ void PiercedStorageIterator<value_t, id_t, value_no_cv_t>::swap(PiercedStorageIt
 *
 * \result A constant reference of the storage associated with the iterator.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-typename PiercedStorageIterator<value_t, id_t, value_no_cv_t>::storage_type & PiercedStorageIterator<value_t, id_t, value_no_cv_t>::getStorage() const
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+typename PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::storage_type & PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::getStorage() const
 {
     return *m_storage;
 }
@@ -100,8 +100,8 @@ typename PiercedStorageIterator<value_t, id_t, value_no_cv_t>::storage_type & Pi
 *
 * \result A constant reference to the kernel iterator.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-const PiercedKernelIterator<id_t> & PiercedStorageIterator<value_t, id_t, value_no_cv_t>::getKernelIterator() const
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+const PiercedKernelIterator<id_t> & PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::getKernelIterator() const
 {
     return static_cast<const PiercedKernelIterator<id_t> &>(*this);
 }
@@ -112,8 +112,8 @@ const PiercedKernelIterator<id_t> & PiercedStorageIterator<value_t, id_t, value_
 * \param k is the index of the requested field
 * \return The values of the current element.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-__PSI_REFERENCE__ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::getValue(std::size_t k) const
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+__PSI_REFERENCE__ PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::getValue(std::size_t k) const
 {
     if (*this == m_storage->getKernel().end()) {
         throw std::out_of_range("Iterator points to an invalid position.");
@@ -131,8 +131,8 @@ __PSI_REFERENCE__ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::getValue
 * container. Thus, calling this function if the iterator is already at
 * the end of the container results in undefined behavior.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t> & PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator++()
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t> & PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator++()
 {
     PiercedKernelIterator<id_t>::operator++();
 
@@ -146,8 +146,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t> & PiercedStorageIterator<va
 * container. Thus, calling this function if the iterator is already at
 * the end of the container results in undefined behavior.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t> PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator++(int)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t> PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator++(int)
 {
     std::size_t rawIndex = getRawIndex();
     PiercedStorageIterator tmp(m_storage, rawIndex);
@@ -164,8 +164,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t> PiercedStorageIterator<valu
 * container. Thus, calling this function if the iterator is already at
 * the begin of the container results in undefined behavior.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t> & PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator--()
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t> & PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator--()
 {
     PiercedKernelIterator<id_t>::operator--();
 
@@ -179,8 +179,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t> & PiercedStorageIterator<va
 * container. Thus, calling this function if the iterator is already at
 * the begin of the container results in undefined behavior.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t> PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator--(int)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t> PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator--(int)
 {
     std::size_t rawIndex = getRawIndex();
     PiercedStorageIterator tmp(m_storage, rawIndex);
@@ -195,8 +195,8 @@ PiercedStorageIterator<value_t, id_t, value_no_cv_t> PiercedStorageIterator<valu
 *
 * \result A reference to the element currently pointed to by the iterator.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-__PSI_REFERENCE__ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator*() const
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+__PSI_REFERENCE__ PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator*() const
 {
     std::size_t rawIndex = getRawIndex();
 
@@ -208,8 +208,8 @@ __PSI_REFERENCE__ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator
 *
 * \result A reference to the element currently pointed to by the iterator.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-__PSI_POINTER__ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator->() const
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+__PSI_POINTER__ PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator->() const
 {
     std::size_t rawIndex = getRawIndex();
 
@@ -222,9 +222,9 @@ __PSI_POINTER__ PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator->
 *
 * \param other is the iterator that will be copied
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<value_t>::value && !std::is_const<other_value_t>::value && std::is_same<other_value_t, typename std::remove_cv<value_t>::type>::value, int>::type>
-PiercedStorageIterator<value_t, id_t, value_no_cv_t> & PiercedStorageIterator<value_t, id_t, value_no_cv_t>::operator=(const PiercedStorageIterator<other_value_t, id_t, value_no_cv_t> &other)
+PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t> & PiercedStorageIterator<value_t, id_t, allocator_t, value_no_cv_t>::operator=(const PiercedStorageIterator<other_value_t, id_t, allocator_t, value_no_cv_t> &other)
 {
     PiercedKernelIterator<id_t>::operator=(other);
     m_storage = other.m_storage;
@@ -35,7 +35,7 @@ namespace bitpit {
 template<typename PKR_id_t>
 class PiercedKernelRange;
 
-template<typename PS_value_t, typename PS_id_t>
+template<typename PS_value_t, typename PS_id_t, typename PS_allocator_t>
 class PiercedStorage;
 
 /*!
@@ -43,21 +43,22 @@ class PiercedStorage;
     a PiercedStorage.
 */
 template<typename value_t, typename id_t = long,
+         typename allocator_t = std::allocator<typename std::remove_cv<value_t>::type>,
          typename value_no_cv_t = typename std::remove_cv<value_t>::type>
 class PiercedStorageRange : protected PiercedKernelRange<id_t>
 {
 
-friend class PiercedStorageRange<value_no_cv_t, id_t, value_no_cv_t>;
+friend class PiercedStorageRange<value_no_cv_t, id_t, allocator_t, value_no_cv_t>;
 
-template<typename PS_value_t, typename PS_id_t>
+template<typename PS_value_t, typename PS_id_t, typename PS_allocator_t>
 friend class PiercedStorage;
 
 private:
     /**
     * Storage.
     */
-    template<typename PS_value_t, typename PS_id_t>
-    using Storage = PiercedStorage<PS_value_t, PS_id_t>;
+    template<typename PS_value_t, typename PS_id_t, typename PS_allocator_t>
+    using Storage = PiercedStorage<PS_value_t, PS_id_t, PS_allocator_t>;
 
     /**
     * Storage type
@@ -67,8 +68,8 @@ private:
     */
     typedef
         typename std::conditional<std::is_const<value_t>::value,
-            const Storage<value_no_cv_t, id_t>,
-            Storage<value_no_cv_t, id_t>
+            const Storage<value_no_cv_t, id_t, allocator_t>,
+            Storage<value_no_cv_t, id_t, allocator_t>
         >::type
 
         storage_t;
@@ -146,8 +147,8 @@ public:
     /*!
         Two-way comparison.
     */
-    template<typename other_value_t, typename other_id_t = long>
-    bool operator==(const PiercedStorageRange<other_value_t, other_id_t> &rhs) const
+    template<typename other_value_t, typename other_id_t = long, typename other_allocator_t = std::allocator<typename std::remove_cv<other_value_t>::type>>
+    bool operator==(const PiercedStorageRange<other_value_t, other_id_t, other_allocator_t> &rhs) const
     {
         if (PiercedKernelRange<id_t>::operator!=(rhs)) {
             return false;
@@ -159,8 +160,8 @@ public:
     /*!
     * Two-way comparison.
     */
-    template<typename other_value_t, typename other_id_t = long>
-    bool operator!=(const PiercedStorageRange<other_value_t, other_id_t> &rhs) const
+    template<typename other_value_t, typename other_id_t = long, typename other_allocator_t = std::allocator<typename std::remove_cv<other_value_t>::type>>
+    bool operator!=(const PiercedStorageRange<other_value_t, other_id_t, other_allocator_t> &rhs) const
     {
         if (PiercedKernelRange<id_t>::operator!=(rhs)) {
             return true;
@@ -30,8 +30,8 @@ namespace bitpit {
 /*!
 * Constructor.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange()
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageRange()
     : PiercedKernelRange<id_t>(),
       m_begin(), m_end()
 {
@@ -42,8 +42,8 @@ PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange()
 *
 * \param storage is the storage that will be associated to the range
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange(storage_t *storage)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageRange(storage_t *storage)
 {
     initialize(storage);
 }
@@ -55,8 +55,8 @@ PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange(storage_t
 * \param first is the id of the first element in the range
 * \param last is the id of the last element in the range
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange(storage_t *storage, id_t first, id_t last)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageRange(storage_t *storage, id_t first, id_t last)
 {
     initialize(storage, first, last);
 }
@@ -67,8 +67,8 @@ PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange(storage_t
 * \param begin is the begin of the range
 * \param end is the end of the range
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange(const iterator &begin, const iterator &end)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::PiercedStorageRange(const iterator &begin, const iterator &end)
 {
     initialize(begin, end);
 }
@@ -78,8 +78,8 @@ PiercedStorageRange<value_t, id_t, value_no_cv_t>::PiercedStorageRange(const ite
 *
 * \param storage is the storage that will be associated to the range
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-void PiercedStorageRange<value_t, id_t, value_no_cv_t>::initialize(const storage_t *storage)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+void PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::initialize(const storage_t *storage)
 {
     PiercedKernelRange<id_t>::initialize(&(storage->getKernel()));
 
@@ -94,8 +94,8 @@ void PiercedStorageRange<value_t, id_t, value_no_cv_t>::initialize(const storage
 * \param first is the id of the first element in the range
 * \param last is the id of the last element in the range
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-void PiercedStorageRange<value_t, id_t, value_no_cv_t>::initialize(const storage_t *storage, id_t first, id_t last)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+void PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::initialize(const storage_t *storage, id_t first, id_t last)
 {
     PiercedKernelRange<id_t>::initialize(&(storage->getKernel()), first, last);
 
@@ -109,8 +109,8 @@ void PiercedStorageRange<value_t, id_t, value_no_cv_t>::initialize(const storage
 * \param begin is the begin of the range
 * \param end is the end of the range
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-void PiercedStorageRange<value_t, id_t, value_no_cv_t>::initialize(const iterator &begin, const iterator &end)
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+void PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::initialize(const iterator &begin, const iterator &end)
 {
     if (&(begin.getStorage()) != &(end.getStorage())) {
         throw std::runtime_error("The two iterators belong to different storages");
@@ -128,8 +128,8 @@ void PiercedStorageRange<value_t, id_t, value_no_cv_t>::initialize(const iterato
 *
 * \param other the iterator to exchange values with
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-void PiercedStorageRange<value_t, id_t, value_no_cv_t>::swap(PiercedStorageRange &other) noexcept
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+void PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::swap(PiercedStorageRange &other) noexcept
 {
     PiercedKernelRange<id_t>::swap(other);
 
@@ -142,8 +142,8 @@ void PiercedStorageRange<value_t, id_t, value_no_cv_t>::swap(PiercedStorageRange
 *
 * \result A constant reference to the kernel range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-const PiercedKernelRange<id_t> & PiercedStorageRange<value_t, id_t, value_no_cv_t>::getKernelRange() const
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+const PiercedKernelRange<id_t> & PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::getKernelRange() const
 {
     return static_cast<const PiercedKernelRange<id_t> &>(*this);
 }
@@ -153,10 +153,10 @@ const PiercedKernelRange<id_t> & PiercedStorageRange<value_t, id_t, value_no_cv_
 *
 * \result An iterator pointing to the first element in the range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
 template<typename U, typename U_no_cv,
          typename std::enable_if<std::is_same<U, U_no_cv>::value, int>::type>
-typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::iterator PiercedStorageRange<value_t, id_t, value_no_cv_t>::begin() noexcept
+typename PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::iterator PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::begin() noexcept
 {
     return m_begin;
 }
@@ -168,10 +168,10 @@ typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::iterator PiercedStor
 * \result A constant iterator pointing to the past-the-end element in the
 * range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
 template<typename U, typename U_no_cv,
          typename std::enable_if<std::is_same<U, U_no_cv>::value, int>::type>
-typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::iterator PiercedStorageRange<value_t, id_t, value_no_cv_t>::end() noexcept
+typename PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::iterator PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::end() noexcept
 {
     return m_end;
 }
@@ -181,8 +181,8 @@ typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::iterator PiercedStor
 *
 * \result A constant iterator pointing to the first element in the range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, value_no_cv_t>::begin() const noexcept
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+typename PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::begin() const noexcept
 {
     return m_begin;
 }
@@ -194,8 +194,8 @@ typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator Pierc
 * \result A constant iterator pointing to the past-the-end element in the
 * range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, value_no_cv_t>::end() const noexcept
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+typename PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::end() const noexcept
 {
     return m_end;
 }
@@ -205,8 +205,8 @@ typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator Pierc
 *
 * \result A constant iterator pointing to the first element in the range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, value_no_cv_t>::cbegin() const noexcept
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+typename PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::cbegin() const noexcept
 {
     return m_begin;
 }
@@ -218,8 +218,8 @@ typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator Pierc
 * \result A constant iterator pointing to the past-the-end element in the
 * range.
 */
-template<typename value_t, typename id_t, typename value_no_cv_t>
-typename PiercedStorageRange<value_t, id_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, value_no_cv_t>::cend() const noexcept
+template<typename value_t, typename id_t, typename allocator_t, typename value_no_cv_t>
+typename PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::const_iterator PiercedStorageRange<value_t, id_t, allocator_t, value_no_cv_t>::cend() const noexcept
 {
     return m_end;
 }
@@ -22,6 +22,9 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <cassert>
+
 #include "bitpit_common.hpp"
 
 #include "piercedSync.hpp"
@@ -211,7 +214,9 @@ void PiercedSyncSlave::swap(PiercedSyncSlave &other) noexcept
 * Constructor
 */
 PiercedSyncMaster::PiercedSyncMaster()
-    : m_syncEnabled(false)
+    : m_syncJournalSize(UNKNOWN_SIZE), m_syncJournalPierced(false),
+      m_syncMovesBaseSize(UNKNOWN_SIZE), m_syncMovesKeptSize(UNKNOWN_SIZE),
+      m_syncEnabled(false)
 {
     for (int k = SYNC_MODE_ITR_BEGIN; k != SYNC_MODE_ITR_END; ++k) {
         SyncMode mode = static_cast<SyncMode>(k);
@@ -219,6 +224,34 @@ PiercedSyncMaster::PiercedSyncMaster()
     }
 }
 
+/**
+* Copy constructor
+*
+* Slaves are not copied: slaves keep pointing to the master they have been
+* registered to, hence the new master starts with no registered slaves.
+*
+* \param other is another master whose settings will be copied
+*/
+PiercedSyncMaster::PiercedSyncMaster(const PiercedSyncMaster &other)
+    : PiercedSyncMaster()
+{
+    m_syncEnabled = other.m_syncEnabled;
+}
+
+/**
+* Move constructor
+*
+* Slaves are not moved: slaves keep pointing to the master they have been
+* registered to, hence the new master starts with no registered slaves.
+*
+* \param other is another master whose settings will be moved
+*/
+PiercedSyncMaster::PiercedSyncMaster(PiercedSyncMaster &&other)
+    : PiercedSyncMaster()
+{
+    m_syncEnabled = other.m_syncEnabled;
+}
+
 /**
 * Exchanges the content of the kernel by the content of x, which is another
 * kernel object of the same type. Sizes may differ.
@@ -236,6 +269,12 @@ void PiercedSyncMaster::swap(PiercedSyncMaster &other) noexcept
     std::swap(other.m_slaves, m_slaves);
     std::swap(other.m_syncGroups, m_syncGroups);
     std::swap(other.m_syncJournal, m_syncJournal);
+    std::swap(other.m_syncJournalSize, m_syncJournalSize);
+    std::swap(other.m_syncJournalPierced, m_syncJournalPierced);
+    std::swap(other.m_syncMoveSources, m_syncMoveSources);
+    std::swap(other.m_syncMovedPositions, m_syncMovedPositions);
+    std::swap(other.m_syncMovesBaseSize, m_syncMovesBaseSize);
+    std::swap(other.m_syncMovesKeptSize, m_syncMovesKeptSize);
 }
 
 /**
@@ -246,6 +285,8 @@ void PiercedSyncMaster::swap(PiercedSyncMaster &other) noexcept
 */
 void PiercedSyncMaster::registerSlave(PiercedSyncSlave *slave, SyncMode syncMode) const
 {
+    std::lock_guard<std::mutex> lock(m_slavesMutex);
+
     if (m_slaves.count(slave) > 0) {
         throw std::out_of_range("Slave is already registered");
     }
@@ -300,121 +341,403 @@ void PiercedSyncMaster::commitSyncAction(PiercedSyncSlave *slave, const PiercedS
 /**
 * Journal the specified synchronization action.
 *
+* Actions are coalesced while they are journaled, so that the cost of
+* synchronizing the journaled slaves depends on the size of the slaves
+* rather than on the number of actions performed by the master. Fills,
+* erases, swaps and moves only update a map that tracks where the final
+* contents of every changed position come from: all these actions will be
+* committed to the slaves as a single TYPE_MOVE_MULTIPLE action. Actions
+* that cannot be expressed through the map (e.g., insertions) are added
+* to the journal after the pending moves, consecutive reorders are merged
+* into a single permutation. Pierced positions are not tracked, if some
+* positions have been pierced, a single TYPE_PIERCE_MULTIPLE action will be
+* added at the end of the journal.
+*
 * \param action is the synchronization action that will be journaled
 */
 void PiercedSyncMaster::journalSyncAction(const PiercedSyncAction &action)
 {
-    // Get information about previous action
-    PiercedSyncAction *previousAction = nullptr;
-    if (!m_syncJournal.empty()) {
-        previousAction = &(m_syncJournal.back());
-    }
-
-    PiercedSyncAction::ActionType previousActionType = PiercedSyncAction::TYPE_UNDEFINED;
-    if (previousAction) {
-        previousActionType = previousAction->type;
-    }
-
-    // Journal current action
-    //
-    // If possible, current action will be merged with the previous one.
     switch (action.type) {
 
     case PiercedSyncAction::TYPE_CLEAR:
+    {
+        // Previous actions are superseded by the clear
         m_syncJournal.resize(1);
         m_syncJournal[0] = action;
+
+        setSyncJournalSize(0);
+        resetSyncMoves();
+        m_syncJournalPierced = false;
         break;
+    }
 
     case PiercedSyncAction::TYPE_APPEND:
-        if (previousActionType == PiercedSyncAction::TYPE_APPEND) {
-            previousAction->type = PiercedSyncAction::TYPE_RESIZE;
-            previousAction->info[PiercedSyncAction::INFO_SIZE] = action.info[PiercedSyncAction::INFO_POS] + 1;
-            previousAction->info[PiercedSyncAction::INFO_POS]  = std::numeric_limits<std::size_t>::max();
-        } else if (previousActionType == PiercedSyncAction::TYPE_RESIZE) {
-            previousAction->info[PiercedSyncAction::INFO_SIZE] = action.info[PiercedSyncAction::INFO_POS] + 1;
-        } else {
-            m_syncJournal.push_back(action);
+    {
+        std::size_t pos = action.info[PiercedSyncAction::INFO_POS];
+        if (m_syncJournalSize == UNKNOWN_SIZE) {
+            setSyncJournalSize(pos);
         }
+        assert(pos == m_syncJournalSize);
+
+        // Appended elements are reset by the moves, hence there is no need
+        // to add them to the map.
+        ++m_syncJournalSize;
         break;
+    }
+
+    case PiercedSyncAction::TYPE_APPEND_MULTIPLE:
+    {
+        std::size_t pos = action.info[PiercedSyncAction::INFO_POS];
+        if (m_syncJournalSize == UNKNOWN_SIZE) {
+            setSyncJournalSize(pos);
+        }
+        assert(pos == m_syncJournalSize);
+
+        m_syncJournalSize = action.info[PiercedSyncAction::INFO_SIZE];
+        break;
+    }
 
     case PiercedSyncAction::TYPE_RESIZE:
-        if (previousActionType == PiercedSyncAction::TYPE_APPEND) {
-            previousAction->type = PiercedSyncAction::TYPE_RESIZE;
-            previousAction->info[PiercedSyncAction::INFO_SIZE] = action.info[PiercedSyncAction::INFO_SIZE];
-            previousAction->info[PiercedSyncAction::INFO_POS]  = std::numeric_limits<std::size_t>::max();
-        } else if (previousActionType == PiercedSyncAction::TYPE_RESIZE) {
-            previousAction->info[PiercedSyncAction::INFO_SIZE] = action.info[PiercedSyncAction::INFO_SIZE];
-        } else {
-            m_syncJournal.push_back(action);
+    {
+        // Without knowing the current size of the slaves it's not possible
+        // to tell which positions are affected by the resize.
+        std::size_t size = action.info[PiercedSyncAction::INFO_SIZE];
+        if (m_syncJournalSize == UNKNOWN_SIZE) {
+            journalPlainSyncAction(action);
+            setSyncJournalSize(size);
+            resetSyncMoves();
+            break;
         }
+
+        // Positions past the new size are removed
+        if (size < m_syncJournalSize) {
+            std::size_t nMoveSources = std::min(m_syncJournalSize, m_syncMoveSources.size());
+            for (std::size_t pos = size; pos < nMoveSources; ++pos) {
+                if (m_syncMoveSources[pos] != UNCHANGED_POS) {
+                    m_syncMoveSources[pos] = UNKNOWN_SIZE;
+                }
+            }
+            m_syncMovesKeptSize = std::min(m_syncMovesKeptSize, size);
+        }
+
+        m_syncJournalSize = size;
         break;
+    }
 
-    case PiercedSyncAction::TYPE_PIERCE:
-        if (previousActionType == PiercedSyncAction::TYPE_PIERCE) {
-            previousAction->type = PiercedSyncAction::TYPE_PIERCE_MULTIPLE;
-            previousAction->data = std::unique_ptr<std::vector<std::size_t>>(new std::vector<std::size_t>(2));
-            (*(previousAction->data))[0] = previousAction->info[PiercedSyncAction::INFO_POS];
-            (*(previousAction->data))[1] = action.info[PiercedSyncAction::INFO_POS];
-            previousAction->info[PiercedSyncAction::INFO_POS]      = std::numeric_limits<std::size_t>::max();
-            previousAction->info[PiercedSyncAction::INFO_POS_NEXT] = std::numeric_limits<std::size_t>::max();
-        } else if (previousActionType == PiercedSyncAction::TYPE_PIERCE_MULTIPLE) {
-            previousAction->data->push_back(action.info[PiercedSyncAction::INFO_POS]);
-        } else {
-            m_syncJournal.push_back(action);
+    case PiercedSyncAction::TYPE_MOVE_OVERWRITE:
+    {
+        std::size_t posFirst  = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t posSecond = action.info[PiercedSyncAction::INFO_POS_SECOND];
+
+        if (posFirst != posSecond) {
+            setSyncMoveSource(posSecond, getSyncMoveSource(posFirst));
+            setSyncMoveSource(posFirst, UNKNOWN_SIZE);
+        }
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_MOVE_APPEND:
+    {
+        // The element may be appended in a position that is already in the
+        // slaves, without knowing the current size of the slaves it's not
+        // possible to tell if the slaves will be enlarged.
+        std::size_t posFirst  = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t posSecond = action.info[PiercedSyncAction::INFO_POS_SECOND];
+        if (m_syncJournalSize == UNKNOWN_SIZE) {
+            journalPlainSyncAction(action);
+            resetSyncMoves();
+            break;
+        }
+
+        if (posSecond >= m_syncJournalSize) {
+            m_syncJournalSize = posSecond + 1;
         }
+
+        if (posFirst != posSecond) {
+            setSyncMoveSource(posSecond, getSyncMoveSource(posFirst));
+            setSyncMoveSource(posFirst, UNKNOWN_SIZE);
+        }
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_SWAP:
+    {
+        std::size_t posFirst  = action.info[PiercedSyncAction::INFO_POS_FIRST];
+        std::size_t posSecond = action.info[PiercedSyncAction::INFO_POS_SECOND];
+
+        std::size_t sourceFirst  = getSyncMoveSource(posFirst);
+        std::size_t sourceSecond = getSyncMoveSource(posSecond);
+        setSyncMoveSource(posFirst, sourceSecond);
+        setSyncMoveSource(posSecond, sourceFirst);
         break;
+    }
 
+    case PiercedSyncAction::TYPE_PIERCE:
     case PiercedSyncAction::TYPE_PIERCE_MULTIPLE:
-        if (previousActionType == PiercedSyncAction::TYPE_PIERCE) {
-            previousAction->type = PiercedSyncAction::TYPE_PIERCE_MULTIPLE;
-            previousAction->data = std::unique_ptr<std::vector<std::size_t>>(new std::vector<std::size_t>(action.data->size() + 1));
-            (*(previousAction->data))[0] = previousAction->info[PiercedSyncAction::INFO_POS];
-            previousAction->data->insert(previousAction->data->begin() + 1, action.data->begin(), action.data->end());
-            previousAction->info[PiercedSyncAction::INFO_POS]      = std::numeric_limits<std::size_t>::max();
-            previousAction->info[PiercedSyncAction::INFO_POS_NEXT] = std::numeric_limits<std::size_t>::max();
-        } else if (previousActionType == PiercedSyncAction::TYPE_PIERCE_MULTIPLE) {
-            previousAction->data->insert(previousAction->data->begin(), action.data->begin(), action.data->end());
-        } else {
-            m_syncJournal.push_back(action);
-        }
+    {
+        // The contents of pierced positions are undefined, slaves that need
+        // to keep track of the holes will be notified with a single pierce
+        // action at the end of the journal.
+        m_syncJournalPierced = true;
         break;
+    }
 
     case PiercedSyncAction::TYPE_OVERWRITE:
-        if (previousActionType == PiercedSyncAction::TYPE_OVERWRITE) {
-            previousAction->type = PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE;
-            previousAction->data = std::unique_ptr<std::vector<std::size_t>>(new std::vector<std::size_t>(2));
-            (*(previousAction->data))[0] = previousAction->info[PiercedSyncAction::INFO_POS];
-            (*(previousAction->data))[1] = action.info[PiercedSyncAction::INFO_POS];
-            previousAction->info[PiercedSyncAction::INFO_POS] = std::numeric_limits<std::size_t>::max();
-        } else if (previousActionType == PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE) {
-            previousAction->data->push_back(action.info[PiercedSyncAction::INFO_POS]);
-        } else {
+    case PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE:
+    case PiercedSyncAction::TYPE_NOOP:
+    {
+        // The contents of overwritten positions are undefined, hence slaves
+        // don't need to be updated.
+        break;
+    }
+
+    case PiercedSyncAction::TYPE_REORDER:
+    {
+        flushSyncMoves();
+
+        // Merge the permutation with the one of the previous reorder
+        //
+        // Consecutive reorders can be merged as long as the first reorder
+        // doesn't enlarge the slaves, i.e., if all the elements reordered
+        // by the second one are defined by the first one.
+        PiercedSyncAction *previousAction = nullptr;
+        if (!m_syncJournal.empty() && m_syncJournal.back().type == PiercedSyncAction::TYPE_REORDER) {
+            previousAction = &(m_syncJournal.back());
+        }
+
+        bool merged = false;
+        if (previousAction && previousAction->data && !previousAction->data->empty()) {
+            std::vector<std::size_t> &previousPermutations = *(previousAction->data);
+            std::size_t previousPermutationsSize = previousPermutations.size();
+            std::size_t previousSize = previousAction->info[PiercedSyncAction::INFO_SIZE];
+
+            if (!action.data || action.data->empty()) {
+                previousAction->info[PiercedSyncAction::INFO_SIZE] = action.info[PiercedSyncAction::INFO_SIZE];
+                merged = true;
+            } else if (previousSize <= previousPermutationsSize && action.data->size() == previousSize) {
+                const std::vector<std::size_t> &permutations = *(action.data);
+
+                std::vector<std::size_t> mergedPermutations(previousPermutationsSize);
+                std::vector<bool> used(previousPermutationsSize, false);
+                for (std::size_t pos = 0; pos < previousSize; ++pos) {
+                    std::size_t source = previousPermutations[permutations[pos]];
+                    mergedPermutations[pos] = source;
+                    used[source] = true;
+                }
+
+                // Positions that will be removed by the resize receive the
+                // elements that have not been reordered.
+                std::size_t pos = previousSize;
+                for (std::size_t source = 0; source < previousPermutationsSize; ++source) {
+                    if (!used[source]) {
+                        mergedPermutations[pos++] = source;
+                    }
+                }
+
+                previousPermutations.swap(mergedPermutations);
+                previousAction->info[PiercedSyncAction::INFO_SIZE] = action.info[PiercedSyncAction::INFO_SIZE];
+                merged = true;
+            }
+        }
+
+        if (!merged) {
             m_syncJournal.push_back(action);
         }
+
+        setSyncJournalSize(action.info[PiercedSyncAction::INFO_SIZE]);
+        resetSyncMoves();
         break;
+    }
 
-    case PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE:
-        if (previousActionType == PiercedSyncAction::TYPE_OVERWRITE) {
-            previousAction->type = PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE;
-            previousAction->data = std::unique_ptr<std::vector<std::size_t>>(new std::vector<std::size_t>(action.data->size() + 1));
-            (*(previousAction->data))[0] = previousAction->info[PiercedSyncAction::INFO_POS];
-            previousAction->data->insert(previousAction->data->begin() + 1, action.data->begin(), action.data->end());
-            previousAction->info[PiercedSyncAction::INFO_POS] = std::numeric_limits<std::size_t>::max();
-        } else if (previousActionType == PiercedSyncAction::TYPE_OVERWRITE_MULTIPLE) {
-            previousAction->data->insert(previousAction->data->begin(), action.data->begin(), action.data->end());
-        } else {
-            m_syncJournal.push_back(action);
+    case PiercedSyncAction::TYPE_INSERT:
+    case PiercedSyncAction::TYPE_MOVE_INSERT:
+    {
+        journalPlainSyncAction(action);
+
+        if (m_syncJournalSize != UNKNOWN_SIZE) {
+            setSyncJournalSize(m_syncJournalSize + 1);
         }
+        resetSyncMoves();
         break;
+    }
 
-    case PiercedSyncAction::TYPE_NOOP:
+    case PiercedSyncAction::TYPE_RESERVE:
+    case PiercedSyncAction::TYPE_SHRINK_TO_FIT:
+    {
+        journalPlainSyncAction(action);
+        resetSyncMoves();
         break;
+    }
 
     default:
-        m_syncJournal.push_back(action);
+    {
+        journalPlainSyncAction(action);
+        setSyncJournalSize(UNKNOWN_SIZE);
+        resetSyncMoves();
         break;
+    }
+
+    }
+}
+
+/**
+* Add the specified synchronization action to the journal, after the moves
+* journaled so far.
+*
+* \param action is the synchronization action that will be added
+*/
+void PiercedSyncMaster::journalPlainSyncAction(const PiercedSyncAction &action)
+{
+    flushSyncMoves();
 
+    m_syncJournal.push_back(action);
+}
+
+/**
+* Set the size of the journaled slaves after committing all the journaled
+* actions.
+*
+* If the moves were journaled without knowing the size of the slaves, no
+* action has changed the size since the moves started being journaled,
+* hence the specified size is also the size of the slaves when the moves
+* started being journaled.
+*
+* \param size is the size of the journaled slaves
+*/
+void PiercedSyncMaster::setSyncJournalSize(std::size_t size)
+{
+    if (m_syncJournalSize == UNKNOWN_SIZE && m_syncMovesBaseSize == UNKNOWN_SIZE) {
+        m_syncMovesBaseSize = size;
+        m_syncMovesKeptSize = size;
+    }
+
+    m_syncJournalSize = size;
+}
+
+/**
+* Get the position that contained, when the moves started being journaled,
+* the element that is now in the specified position.
+*
+* \param pos is the position
+* \result The position that contained, when the moves started being
+* journaled, the element that is now in the specified position. If the
+* position contains an element that needs to be reset, UNKNOWN_SIZE is
+* returned.
+*/
+std::size_t PiercedSyncMaster::getSyncMoveSource(std::size_t pos) const
+{
+    if (pos < m_syncMoveSources.size() && m_syncMoveSources[pos] != UNCHANGED_POS) {
+        return m_syncMoveSources[pos];
+    } else if (m_syncMovesKeptSize == UNKNOWN_SIZE || pos < m_syncMovesKeptSize) {
+        return pos;
+    } else {
+        return UNKNOWN_SIZE;
+    }
+}
+
+/**
+* Set the position that contained, when the moves started being journaled,
+* the element that is now in the specified position.
+*
+* \param pos is the position
+* \param source is the position that contained, when the moves started
+* being journaled, the element that is now in the specified position, if
+* the element needs to be reset UNKNOWN_SIZE should be used
+*/
+void PiercedSyncMaster::setSyncMoveSource(std::size_t pos, std::size_t source)
+{
+    if (pos >= m_syncMoveSources.size()) {
+        m_syncMoveSources.resize(std::max(pos + 1, 2 * m_syncMoveSources.size()), UNCHANGED_POS);
+    }
+
+    std::size_t &currentSource = m_syncMoveSources[pos];
+    if (currentSource == UNCHANGED_POS) {
+        m_syncMovedPositions.push_back(pos);
+    }
+    currentSource = source;
+}
+
+/**
+* Check if there are journaled moves that have not yet been added to the
+* journal.
+*
+* \result Returns true if there are journaled moves that have not yet been
+* added to the journal, false otherwise.
+*/
+bool PiercedSyncMaster::hasSyncMoves() const
+{
+    if (!m_syncMovedPositions.empty()) {
+        return true;
+    }
+
+    if (m_syncMovesBaseSize == UNKNOWN_SIZE) {
+        return false;
+    }
+
+    return (m_syncMovesKeptSize != m_syncMovesBaseSize || m_syncJournalSize != m_syncMovesBaseSize);
+}
+
+/**
+* Build the synchronization action that applies the journaled moves.
+*
+* The data of the action contains, for each position whose contents have
+* changed, the position itself followed by the position the new contents
+* should be taken from (or by UNKNOWN_SIZE, if the contents have to be
+* reset). Before placing the moved elements, the slaves have to be resized
+* to the size stored in INFO_POS and then to the size stored in INFO_SIZE;
+* if a size is UNKNOWN_SIZE the corresponding resize is not needed.
+*
+* \result The synchronization action that applies the journaled moves.
+*/
+PiercedSyncAction PiercedSyncMaster::buildSyncMovesAction() const
+{
+    std::vector<std::size_t> moveData;
+    moveData.reserve(2 * m_syncMovedPositions.size());
+    for (std::size_t pos : m_syncMovedPositions) {
+        // Positions removed by a resize are skipped
+        if (m_syncJournalSize != UNKNOWN_SIZE && pos >= m_syncJournalSize) {
+            continue;
+        }
+
+        std::size_t source = m_syncMoveSources[pos];
+
+        moveData.push_back(pos);
+        moveData.push_back(source);
+    }
+
+    PiercedSyncAction action(PiercedSyncAction::TYPE_MOVE_MULTIPLE);
+    action.info[PiercedSyncAction::INFO_POS]  = m_syncMovesKeptSize;
+    action.info[PiercedSyncAction::INFO_SIZE] = m_syncJournalSize;
+    action.importData(std::move(moveData));
+
+    return action;
+}
+
+/**
+* Add to the journal the journaled moves.
+*/
+void PiercedSyncMaster::flushSyncMoves()
+{
+    if (hasSyncMoves()) {
+        m_syncJournal.push_back(buildSyncMovesAction());
     }
+
+    resetSyncMoves();
+}
+
+/**
+* Reset the journaled moves, new moves will be tracked starting from the
+* current state of the journaled slaves.
+*/
+void PiercedSyncMaster::resetSyncMoves()
+{
+    for (std::size_t pos : m_syncMovedPositions) {
+        m_syncMoveSources[pos] = UNCHANGED_POS;
+    }
+    m_syncMovedPositions.clear();
+
+    m_syncMovesBaseSize = m_syncJournalSize;
+    m_syncMovesKeptSize = m_syncJournalSize;
 }
 
 /**
@@ -424,13 +747,16 @@ void PiercedSyncMaster::journalSyncAction(const PiercedSyncAction &action)
 */
 void PiercedSyncMaster::unregisterSlave(const PiercedSyncSlave *slave) const
 {
+    std::lock_guard<std::mutex> lock(m_slavesMutex);
+
     // Check if the slave was actually registered
-    if (!isSlaveRegistered(slave)) {
+    auto slaveItr = m_slaves.find(const_cast<PiercedSyncSlave *>(slave));
+    if (slaveItr == m_slaves.end()) {
         return;
     }
 
     // Remove the slave from the synchronization group
-    SyncMode syncMode = getSlaveSyncMode(slave);
+    SyncMode syncMode = slaveItr->second;
     SyncGroup &syncGroup = m_syncGroups.at(syncMode);
     for (auto itr = syncGroup.begin(); itr != syncGroup.end(); ++itr) {
         PiercedSyncSlave *item = *itr;
@@ -441,7 +767,7 @@ void PiercedSyncMaster::unregisterSlave(const PiercedSyncSlave *slave) const
     }
 
     // Unregister the slave
-    m_slaves.erase(const_cast<PiercedSyncSlave *>(slave));
+    m_slaves.erase(slaveItr);
 }
 
 /**
@@ -451,6 +777,8 @@ void PiercedSyncMaster::unregisterSlave(const PiercedSyncSlave *slave) const
 */
 bool PiercedSyncMaster::isSlaveRegistered(const PiercedSyncSlave *slave) const
 {
+    std::lock_guard<std::mutex> lock(m_slavesMutex);
+
     return (m_slaves.count(const_cast<PiercedSyncSlave *>(slave)) > 0);
 }
 
@@ -462,6 +790,8 @@ bool PiercedSyncMaster::isSlaveRegistered(const PiercedSyncSlave *slave) const
 */
 PiercedSyncMaster::SyncMode PiercedSyncMaster::getSlaveSyncMode(const PiercedSyncSlave *slave) const
 {
+    std::lock_guard<std::mutex> lock(m_slavesMutex);
+
     return m_slaves.at(const_cast<PiercedSyncSlave *>(slave));
 }
 
@@ -480,7 +810,7 @@ bool PiercedSyncMaster::isSlaveSynced(const PiercedSyncSlave *slave) const
     if (syncMode == SYNC_MODE_CONCURRENT) {
         return true;
     } else if (syncMode == SYNC_MODE_JOURNALED) {
-        return m_syncJournal.empty();
+        return (m_syncJournal.empty() && !hasSyncMoves() && !m_syncJournalPierced);
     } else {
         return false;
     }
@@ -491,6 +821,18 @@ bool PiercedSyncMaster::isSlaveSynced(const PiercedSyncSlave *slave) const
 */
 void PiercedSyncMaster::sync()
 {
+    // Add pending moves to the journal
+    flushSyncMoves();
+
+    // Notify the slaves that the holes have changed
+    //
+    // The action should be the last one of the journal: slaves will commit
+    // it when they are already synchronized with the master.
+    if (m_syncJournalPierced) {
+        m_syncJournal.emplace_back(PiercedSyncAction::TYPE_PIERCE_MULTIPLE);
+        m_syncJournalPierced = false;
+    }
+
     // Only journaled slaved need to be synchronized
     for (PiercedSyncSlave *slave : m_syncGroups.at(SYNC_MODE_JOURNALED)) {
         for (const PiercedSyncAction &action : m_syncJournal) {
@@ -501,6 +843,9 @@ void PiercedSyncMaster::sync()
     // Clear the sync journal
     m_syncJournal.clear();
     m_syncJournal.shrink_to_fit();
+
+    std::vector<std::size_t>().swap(m_syncMoveSources);
+    std::vector<std::size_t>().swap(m_syncMovedPositions);
 }
 
 /**
@@ -510,13 +855,14 @@ void PiercedSyncMaster::sync()
 */
 bool PiercedSyncMaster::isSynced() const
 {
-    for (const PiercedSyncSlave *slave : m_syncGroups.at(SYNC_MODE_JOURNALED)) {
-        if (!isSlaveSynced(slave)) {
-            return false;
-        }
+    // Journaled slaves are all synchronized with the same journal, hence
+    // either all of them are synchronized or none of them is.
+    std::lock_guard<std::mutex> lock(m_slavesMutex);
+    if (m_syncGroups.at(SYNC_MODE_JOURNALED).empty()) {
+        return true;
     }
 
-    return true;
+    return (m_syncJournal.empty() && !hasSyncMoves() && !m_syncJournalPierced);
 }
 
 /**
@@ -554,6 +900,18 @@ void PiercedSyncMaster::restore(std::istream &stream)
     for (PiercedSyncAction &action : m_syncJournal) {
         action.restore(stream);
     }
+
+    // Pending moves are dumped as part of the journal
+    m_syncJournalSize = UNKNOWN_SIZE;
+    resetSyncMoves();
+
+    // The pierce action that notifies the slaves that the holes have changed
+    // should be the last one of the journal
+    m_syncJournalPierced = false;
+    if (!m_syncJournal.empty() && m_syncJournal.back().type == PiercedSyncAction::TYPE_PIERCE_MULTIPLE) {
+        m_syncJournal.pop_back();
+        m_syncJournalPierced = true;
+    }
 }
 
 /**
@@ -563,11 +921,28 @@ void PiercedSyncMaster::restore(std::istream &stream)
 */
 void PiercedSyncMaster::dump(std::ostream &stream) const
 {
+    bool hasMoves = hasSyncMoves();
+
     std::size_t journalSize = m_syncJournal.size();
+    if (hasMoves) {
+        ++journalSize;
+    }
+    if (m_syncJournalPierced) {
+        ++journalSize;
+    }
+
     utils::binary::write(stream, journalSize);
     for (const PiercedSyncAction &action : m_syncJournal) {
         action.dump(stream);
     }
+
+    if (hasMoves) {
+        buildSyncMovesAction().dump(stream);
+    }
+
+    if (m_syncJournalPierced) {
+        PiercedSyncAction(PiercedSyncAction::TYPE_PIERCE_MULTIPLE).dump(stream);
+    }
 }
 
 }
@@ -26,7 +26,9 @@
 #define __BITPIT_PIERCED_SYNC_HPP__
 
 #include <array>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -60,7 +62,9 @@ public:
         TYPE_MOVE_OVERWRITE,
         TYPE_SWAP,
         TYPE_PIERCE,
-        TYPE_PIERCE_MULTIPLE
+        TYPE_PIERCE_MULTIPLE,
+        TYPE_APPEND_MULTIPLE,
+        TYPE_MOVE_MULTIPLE
     };
 
     /**
@@ -124,6 +128,12 @@ protected:
 *
 * \brief Base class for defining an object that acts like a master in pierced
 * synchronization.
+*
+* \details
+* Slaves can be registered and unregistered through a constant reference to
+* the master. Registration is protected by a lock, hence different threads
+* can create or destroy slaves of the same master concurrently, as long as
+* the master itself is not modified.
 */
 class PiercedSyncMaster {
 
@@ -164,6 +174,8 @@ protected:
     mutable std::unordered_map<PiercedSyncSlave *, SyncMode> m_slaves;
 
     PiercedSyncMaster();
+    PiercedSyncMaster(const PiercedSyncMaster &other);
+    PiercedSyncMaster(PiercedSyncMaster &&other);
 
     void registerSlave(PiercedSyncSlave *slave, PiercedSyncMaster::SyncMode syncMode) const;
     void unregisterSlave(const PiercedSyncSlave *slave) const;
@@ -196,13 +208,71 @@ private:
     */
     std::vector<PiercedSyncAction> m_syncJournal;
 
+    /**
+    * Size of the journaled slaves after committing all the journaled
+    * actions, if the size is not known it is set to UNKNOWN_SIZE
+    */
+    std::size_t m_syncJournalSize;
+
+    /**
+    * Controls if some positions have been pierced since the last
+    * synchronization of the journaled slaves
+    */
+    bool m_syncJournalPierced;
+
+    /**
+    * Moves that have been journaled but not yet added to the journal.
+    *
+    * For each position whose contents have been changed, the array stores
+    * the position that contained the same element when the moves started
+    * being journaled (or UNKNOWN_SIZE, if the element needs to be reset).
+    * Positions whose contents have not been changed are set to
+    * UNCHANGED_POS.
+    */
+    std::vector<std::size_t> m_syncMoveSources;
+
+    /**
+    * Positions whose contents have been changed by the journaled moves
+    */
+    std::vector<std::size_t> m_syncMovedPositions;
+
+    /**
+    * Size of the journaled slaves when the moves started being journaled
+    */
+    std::size_t m_syncMovesBaseSize;
+
+    /**
+    * Number of elements that are preserved by the journaled moves, all
+    * the positions past this size that are not in the move map need to
+    * be reset
+    */
+    std::size_t m_syncMovesKeptSize;
+
     /**
     * Controls if the synchronization is enabled
     */
     mutable bool m_syncEnabled;
 
+    /**
+    * Mutex that protects the registration of the slaves
+    */
+    mutable std::mutex m_slavesMutex;
+
+    static constexpr std::size_t UNKNOWN_SIZE  = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t UNCHANGED_POS = std::numeric_limits<std::size_t>::max() - 1;
+
     void commitSyncAction(PiercedSyncSlave *slave, const PiercedSyncAction &action) const;
     void journalSyncAction(const PiercedSyncAction &action);
+    void journalPlainSyncAction(const PiercedSyncAction &action);
+
+    void setSyncJournalSize(std::size_t size);
+
+    std::size_t getSyncMoveSource(std::size_t pos) const;
+    void setSyncMoveSource(std::size_t pos, std::size_t source);
+    bool hasSyncMoves() const;
+    PiercedSyncAction buildSyncMovesAction() const;
+    void flushSyncMoves();
+    void resetSyncMoves();
 
 };
 
@@ -30,10 +30,10 @@
 #include "piercedVectorKernel.hpp"
 #include "piercedVectorStorage.hpp"
 
-#define __PV_REFERENCE__       typename PiercedVector<value_t, id_t>::reference
-#define __PV_CONST_REFERENCE__ typename PiercedVector<value_t, id_t>::const_reference
-#define __PV_POINTER__         typename PiercedVector<value_t, id_t>::pointer
-#define __PV_CONST_POINTER__   typename PiercedVector<value_t, id_t>::const_pointer
+#define __PV_REFERENCE__       typename PiercedVector<value_t, id_t, allocator_t>::reference
+#define __PV_CONST_REFERENCE__ typename PiercedVector<value_t, id_t, allocator_t>::const_reference
+#define __PV_POINTER__         typename PiercedVector<value_t, id_t, allocator_t>::pointer
+#define __PV_CONST_POINTER__   typename PiercedVector<value_t, id_t, allocator_t>::const_pointer
 
 namespace bitpit {
 
@@ -53,16 +53,21 @@ protected:
 * \brief Metafunction for generating a pierced vector.
 *
 * \details
-* Usage: use <tt>PiercedVector<value_t, id_t></tt> to declare a pierced
+* Usage: use <tt>PiercedVector<value_t, id_t, allocator_t></tt> to declare a pierced
 * vector.
 *
+* Constant functions of the vector can be called concurrently by any number
+* of threads, as long as no thread modifies the vector at the same time (see
+* PiercedKernel for the details).
+*
 * \tparam value_t is the type of the elements stored in the vector
 * \tparam id_t is the type of the ids associated to the elements
+* \tparam allocator_t is the allocator used for the elements
 */
-template<typename value_t, typename id_t = long>
+template<typename value_t, typename id_t = long, typename allocator_t = std::allocator<value_t>>
 class PiercedVector : public BasePiercedVector,
                       public PiercedVectorKernel<id_t>,
-                      public PiercedVectorStorage<value_t, id_t> {
+                      public PiercedVectorStorage<value_t, id_t, allocator_t> {
 
 protected:
     // According to Visual Studio 2022 documentation (see Compiler Error C2668), "if, in the
@@ -79,12 +84,12 @@ protected:
     using PiercedVectorKernel<id_t>::shrinkToFit;
     using PiercedVectorKernel<id_t>::swap;
 
-    using PiercedVectorStorage<value_t, id_t>::setStaticKernel;
-    using PiercedVectorStorage<value_t, id_t>::setDynamicKernel;
-    using PiercedVectorStorage<value_t, id_t>::unsetKernel;
-    using PiercedVectorStorage<value_t, id_t>::getKernel;
-    using PiercedVectorStorage<value_t, id_t>::getKernelType;
-    using PiercedVectorStorage<value_t, id_t>::getSyncMode;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::setStaticKernel;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::setDynamicKernel;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::unsetKernel;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::getKernel;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::getKernelType;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::getSyncMode;
 
 public:
     // Typedefs
@@ -102,46 +107,46 @@ public:
     /*!
     * Type of data stored in the container
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::value_type value_type;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::value_type value_type;
 
     /**
     * Iterator
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::iterator iterator;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::iterator iterator;
 
     /**
     * Constant iterator
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::const_iterator const_iterator;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::const_iterator const_iterator;
 
     /**
     * Raw iterator
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::raw_iterator raw_iterator;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::raw_iterator raw_iterator;
 
     /**
     * Raw constant iterator
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::raw_const_iterator raw_const_iterator;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::raw_const_iterator raw_const_iterator;
 
     /**
     * Range
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::range range;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::range range;
 
     /**
     * Constant range
     */
-    typedef typename PiercedVectorStorage<value_t, id_t>::const_range const_range;
+    typedef typename PiercedVectorStorage<value_t, id_t, allocator_t>::const_range const_range;
 
     // Contructors
     PiercedVector();
     PiercedVector(std::size_t n);
-    PiercedVector(const PiercedVector<value_t, id_t> &other);
-    PiercedVector(PiercedVector<value_t, id_t> &&other);
+    PiercedVector(const PiercedVector<value_t, id_t, allocator_t> &other);
+    PiercedVector(PiercedVector<value_t, id_t, allocator_t> &&other);
 
-    PiercedVector<value_t, id_t> & operator=(const PiercedVector<value_t, id_t> &other);
-    PiercedVector<value_t, id_t> & operator=(PiercedVector<value_t, id_t> &&other);
+    PiercedVector<value_t, id_t, allocator_t> & operator=(const PiercedVector<value_t, id_t, allocator_t> &other);
+    PiercedVector<value_t, id_t, allocator_t> & operator=(PiercedVector<value_t, id_t, allocator_t> &&other);
 
     // Methods that modify the contents of the container
     iterator reclaim(id_t id);
@@ -160,13 +165,15 @@ public:
 
     iterator pushBack(id_t id, const value_t &value);
 
-    template<typename... Args, typename PiercedStorage<value_t,id_t>::template EnableIfHasInitialize<Args...> * = nullptr>
+    void insertRange(std::size_t count, const id_t *ids, const value_t *values);
+
+    template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * = nullptr>
     iterator emreclaim(id_t id, Args&&... args);
-    template<typename... Args, typename PiercedStorage<value_t,id_t>::template EnableIfHasInitialize<Args...> * = nullptr>
+    template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * = nullptr>
     iterator emreclaimAfter(const id_t &referenceId, id_t id, Args&&... args);
-    template<typename... Args, typename PiercedStorage<value_t,id_t>::template EnableIfHasInitialize<Args...> * = nullptr>
+    template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * = nullptr>
     void emreclaimBack(id_t id, Args&&... args);
-    template<typename... Args, typename PiercedStorage<value_t,id_t>::template EnableIfHasInitialize<Args...> * = nullptr>
+    template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * = nullptr>
     iterator emreclaimBefore(const id_t &referenceId, id_t id, Args&&... args);
 
     template<typename... Args>
@@ -176,6 +183,8 @@ public:
     template<typename... Args>
     void emplaceBack(id_t id, Args&&... args);
     template<typename... Args>
+    void emplaceBackRange(std::size_t count, const id_t *ids, const Args&... args);
+    template<typename... Args>
     iterator emplaceBefore(const id_t &referenceId, id_t id, Args&&... args);
 
     template<typename... Args>
@@ -193,38 +202,48 @@ public:
     void sort();
     void sortAfter(id_t referenceId, bool inclusive);
     void sortBefore(id_t referenceId, bool inclusive);
+    template<typename Compare>
+    void sort(Compare comp);
+    template<typename Compare>
+    void sortAfter(id_t referenceId, bool inclusive, Compare comp);
+    template<typename Compare>
+    void sortBefore(id_t referenceId, bool inclusive, Compare comp);
     void squeeze();
     void shrinkToFit();
     void swap(PiercedVector &other) noexcept;
 
     // Methods that extract information about the container
     const PiercedVectorKernel<id_t> & getKernel() const;
-    const PiercedVectorStorage<value_t, id_t> & getStorage() const;
+    const PiercedVectorStorage<value_t, id_t, allocator_t> & getStorage() const;
+
+    std::size_t getMemoryUsage() const;
 
     void dump() const;
 
     // Methods that extract the contents of the container
-    using PiercedVectorStorage<value_t, id_t>::back;
-    using PiercedVectorStorage<value_t, id_t>::front;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::back;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::front;
 
-    using PiercedVectorStorage<value_t, id_t>::at;
-    using PiercedVectorStorage<value_t, id_t>::rawAt;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::at;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::rawAt;
 
-    using PiercedVectorStorage<value_t, id_t>::operator[];
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::operator[];
 
     // Iterators
-    using PiercedVectorStorage<value_t, id_t>::begin;
-    using PiercedVectorStorage<value_t, id_t>::end;
-    using PiercedVectorStorage<value_t, id_t>::cbegin;
-    using PiercedVectorStorage<value_t, id_t>::cend;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::begin;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::end;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::cbegin;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::cend;
+
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::rawBegin;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::rawEnd;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::rawCbegin;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::rawCend;
 
-    using PiercedVectorStorage<value_t, id_t>::rawBegin;
-    using PiercedVectorStorage<value_t, id_t>::rawEnd;
-    using PiercedVectorStorage<value_t, id_t>::rawCbegin;
-    using PiercedVectorStorage<value_t, id_t>::rawCend;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::find;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind;
 
-    using PiercedVectorStorage<value_t, id_t>::find;
-    using PiercedVectorStorage<value_t, id_t>::rawFind;
+    using PiercedVectorStorage<value_t, id_t, allocator_t>::split;
 
     // Dump and restore
     template<typename T = value_t, typename std::enable_if<std::is_pod<T>::value || PiercedVectorStorage<T, id_t>::has_restore()>::type * = nullptr>
@@ -251,7 +270,7 @@ private:
 
     iterator reclaimValue(const FillAction &action);
     iterator insertValue(const FillAction &action, const value_t &value);
-    template<typename... Args, typename PiercedStorage<value_t,id_t>::template EnableIfHasInitialize<Args...> * = nullptr>
+    template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * = nullptr>
     iterator emreclaimValue(const FillAction &action, Args&&... args);
     template<typename... Args>
     iterator emplaceValue(const FillAction &action, Args&&... args);
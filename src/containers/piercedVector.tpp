@@ -33,10 +33,10 @@ namespace bitpit {
 * For increase the performances, the synchronization of the internal storage
 * is handled outside the kernel.
 */
-template<typename value_t, typename id_t>
-PiercedVector<value_t, id_t>::PiercedVector()
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedVector<value_t, id_t, allocator_t>::PiercedVector()
     : PiercedVectorKernel<id_t>(),
-      PiercedVectorStorage<value_t, id_t>(1, this, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED)
+      PiercedVectorStorage<value_t, id_t, allocator_t>(1, this, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED)
 {
 }
 
@@ -49,10 +49,10 @@ PiercedVector<value_t, id_t>::PiercedVector()
 *
 * \param n the minimum capacity requested for the container
 */
-template<typename value_t, typename id_t>
-PiercedVector<value_t, id_t>::PiercedVector(std::size_t n)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedVector<value_t, id_t, allocator_t>::PiercedVector(std::size_t n)
     : PiercedVectorKernel<id_t>(n),
-      PiercedVectorStorage<value_t, id_t>(1, this, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED)
+      PiercedVectorStorage<value_t, id_t, allocator_t>(1, this, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED)
 {
 }
 
@@ -62,15 +62,11 @@ PiercedVector<value_t, id_t>::PiercedVector(std::size_t n)
 * \param other is another container of the same type (i.e., instantiated with
 * the same template parameters) whose content is copied in this container.
 */
-template<typename value_t, typename id_t>
-PiercedVector<value_t, id_t>::PiercedVector(const PiercedVector<value_t, id_t> &other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedVector<value_t, id_t, allocator_t>::PiercedVector(const PiercedVector<value_t, id_t, allocator_t> &other)
     : PiercedVectorKernel<id_t>(other),
-      PiercedVectorStorage<value_t, id_t>(other, this, other.getSyncMode())
+      PiercedVectorStorage<value_t, id_t, allocator_t>(other, this, other.getSyncMode())
 {
-    // Since we have copied the kernel, the list of registered slaves contains
-    // also the internal storage of other vector. We need to unregister that
-    // storage from the kernel.
-    this->unregisterSlave(&other);
 }
 
 /**
@@ -79,15 +75,11 @@ PiercedVector<value_t, id_t>::PiercedVector(const PiercedVector<value_t, id_t> &
 * \param other is another container of the same type (i.e., instantiated with
 * the same template parameters) whose content is copied in this container.
 */
-template<typename value_t, typename id_t>
-PiercedVector<value_t, id_t>::PiercedVector(PiercedVector<value_t, id_t> &&other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedVector<value_t, id_t, allocator_t>::PiercedVector(PiercedVector<value_t, id_t, allocator_t> &&other)
     : PiercedVectorKernel<id_t>(std::move(other)),
-      PiercedVectorStorage<value_t, id_t>(std::move(other), this, other.getSyncMode())
+      PiercedVectorStorage<value_t, id_t, allocator_t>(std::move(other), this, other.getSyncMode())
 {
-    // Since we have moved the kernel, the list of registered slaves contains
-    // also the internal storage of other vector. We need to unregister that
-    // storage from the kernel.
-    this->unregisterSlave(&other);
 }
 
 /**
@@ -96,10 +88,10 @@ PiercedVector<value_t, id_t>::PiercedVector(PiercedVector<value_t, id_t> &&other
 * \param other is another container of the same type (i.e., instantiated with
 * the same template parameters) whose content is copied in this container.
 */
-template<typename value_t, typename id_t>
-PiercedVector<value_t, id_t> & PiercedVector<value_t, id_t>::operator=(const PiercedVector<value_t, id_t> &other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedVector<value_t, id_t, allocator_t> & PiercedVector<value_t, id_t, allocator_t>::operator=(const PiercedVector<value_t, id_t, allocator_t> &other)
 {
-    PiercedVector<value_t, id_t> temporary(other);
+    PiercedVector<value_t, id_t, allocator_t> temporary(other);
     this->swap(temporary);
 
     return *this;
@@ -111,8 +103,8 @@ PiercedVector<value_t, id_t> & PiercedVector<value_t, id_t>::operator=(const Pie
 * \param other is another container of the same type (i.e., instantiated with
 * the same template parameters) whose content is moved in this container.
 */
-template<typename value_t, typename id_t>
-PiercedVector<value_t, id_t> & PiercedVector<value_t, id_t>::operator=(PiercedVector<value_t, id_t> &&other)
+template<typename value_t, typename id_t, typename allocator_t>
+PiercedVector<value_t, id_t, allocator_t> & PiercedVector<value_t, id_t, allocator_t>::operator=(PiercedVector<value_t, id_t, allocator_t> &&other)
 {
     this->swap(other);
 
@@ -129,8 +121,8 @@ PiercedVector<value_t, id_t> & PiercedVector<value_t, id_t>::operator=(PiercedVe
 *
 * \param id is the id that will be assigned to the element
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::reclaim(id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::reclaim(id_t id)
 {
     // Fill a position
     FillAction reclaimAction = PiercedVectorKernel<id_t>::fillHead(id);
@@ -155,8 +147,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
 * \param id is the id that will be assigned to the element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::reclaimAfter(const id_t &referenceId, id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::reclaimAfter(const id_t &referenceId, id_t id)
 {
     // Fill a position
     FillAction reclaimAction = PiercedVectorKernel<id_t>::fillAfter(referenceId, id);
@@ -176,8 +168,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
 *
 * \param id is the id that will be assigned to the element
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::reclaimBack(id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::reclaimBack(id_t id)
 {
     // Fill a position
     FillAction reclaimAction = PiercedVectorKernel<id_t>::fillAppend(id);
@@ -202,8 +194,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
 * \param id is the id that will be assigned to the element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::reclaimBefore(const id_t &referenceId, id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::reclaimBefore(const id_t &referenceId, id_t id)
 {
     // Fill a position
     FillAction reclaimAction = PiercedVectorKernel<id_t>::fillBefore(referenceId, id);
@@ -223,8 +215,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
 * until a flush is called
 * \result An iterator that points to the moved element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::moveBefore(const id_t &referenceId, id_t id, bool delayed)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::moveBefore(const id_t &referenceId, id_t id, bool delayed)
 {
     // Update the position of the element in the kernel
     MoveAction moveAction = PiercedVectorKernel<id_t>::moveBefore(referenceId, id, !delayed);
@@ -244,8 +236,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
 * until a flush is called
 * \result An iterator that points to the moved element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::moveAfter(const id_t &referenceId, id_t id, bool delayed)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::moveAfter(const id_t &referenceId, id_t id, bool delayed)
 {
     // Update the position of the element in the kernel
     MoveAction moveAction = PiercedVectorKernel<id_t>::moveAfter(referenceId, id, !delayed);
@@ -262,8 +254,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
 *             inserted elements.
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::insert(id_t id, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::insert(id_t id, const value_t &value)
 {
     // Fill a position
     FillAction insertAction = PiercedVectorKernel<id_t>::fillHead(id);
@@ -284,8 +276,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
 * inserted element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::insertAfter(const id_t &referenceId, id_t id, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::insertAfter(const id_t &referenceId, id_t id, const value_t &value)
 {
     // Fill a position
     FillAction insertAction = PiercedVectorKernel<id_t>::fillAfter(referenceId, id);
@@ -306,8 +298,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
 * inserted element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::insertBefore(const id_t &referenceId, id_t id, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::insertBefore(const id_t &referenceId, id_t id, const value_t &value)
 {
     // Fill a position
     FillAction insertAction = PiercedVectorKernel<id_t>::fillBefore(referenceId, id);
@@ -323,17 +315,17 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
 * \param value is the value to be moved to the inserted elements.
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::replace(id_t id, value_t &&value)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::replace(id_t id, value_t &&value)
 {
     // Position
     std::size_t pos = PiercedVectorKernel<id_t>::getPos(id);
 
     // Replace the value
-    PiercedVectorStorage<value_t, id_t>::rawSet(pos, std::move(value));
+    PiercedVectorStorage<value_t, id_t, allocator_t>::rawSet(pos, std::move(value));
 
     // Return the iterator that points to the element
-    return PiercedVectorStorage<value_t, id_t>::rawFind(pos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(pos);
 }
 
 /**
@@ -345,8 +337,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
 * \param value the value to be copied (or moved) to the new element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::pushBack(id_t id, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::pushBack(id_t id, const value_t &value)
 {
     // Fill a position
     FillAction insertAction = PiercedVectorKernel<id_t>::fillAppend(id);
@@ -355,6 +347,35 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::pu
     return insertValue(insertAction, value);
 }
 
+/**
+* Inserts multiple new elements at the end of the container, right after
+* its current last element.
+*
+* Elements are always appended to the container, i.e., holes will not be
+* used to store the new elements. Positions for all the elements are created
+* with a single kernel operation, hence the storages synchronized with the
+* container will be resized only once.
+*
+* \param count is the number of elements that will be inserted
+* \param ids are the ids that will be associated to the elements
+* \param values are the values of the elements
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::insertRange(std::size_t count, const id_t *ids, const value_t *values)
+{
+    // Fill the positions
+    FillAction insertAction = PiercedVectorKernel<id_t>::fillAppendRange(count, ids);
+
+    // Insert the new values
+    //
+    // The capacity of the storage follows the one of the kernel, this keeps
+    // the amortized cost of appending multiple ranges constant.
+    PiercedVectorStorage<value_t, id_t, allocator_t>::rawReserve(PiercedVectorKernel<id_t>::capacity());
+    for (std::size_t k = 0; k < count; ++k) {
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawPushBack(values[k]);
+    }
+}
+
 /**
 * The container is extended by inserting a new element. If the element can
 * reuse an existing position that position will be initialize using args
@@ -369,9 +390,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::pu
 * new element
 * \result An iterator that points to the the newly inserted element.
 */
-template<typename value_t, typename id_t>
-template<typename... Args, typename PiercedStorage<value_t, id_t>::template EnableIfHasInitialize<Args...> * >
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emreclaim(id_t id, Args&&... args)
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * >
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emreclaim(id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillHead(id);
@@ -397,9 +418,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param args are the arguments forwarded to construct the new element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-template<typename... Args, typename PiercedStorage<value_t, id_t>::template EnableIfHasInitialize<Args...> * >
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emreclaimAfter(const id_t &referenceId, id_t id, Args&&... args)
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * >
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emreclaimAfter(const id_t &referenceId, id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillAfter(referenceId, id);
@@ -421,9 +442,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param id is the id that will be associated to the element
 * \param args are the arguments forwarded to construct the new element
 */
-template<typename value_t, typename id_t>
-template<typename... Args, typename PiercedStorage<value_t, id_t>::template EnableIfHasInitialize<Args...> * >
-void PiercedVector<value_t, id_t>::emreclaimBack(id_t id, Args&&... args)
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * >
+void PiercedVector<value_t, id_t, allocator_t>::emreclaimBack(id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillAppend(id);
@@ -449,9 +470,9 @@ void PiercedVector<value_t, id_t>::emreclaimBack(id_t id, Args&&... args)
 * \param args are the arguments forwarded to construct the new element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
-template<typename... Args, typename PiercedStorage<value_t, id_t>::template EnableIfHasInitialize<Args...> * >
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emreclaimBefore(const id_t &referenceId, id_t id, Args&&... args)
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * >
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emreclaimBefore(const id_t &referenceId, id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillBefore(referenceId, id);
@@ -468,9 +489,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param args are the arguments forwarded to construct the new element
 * \result An iterator that points to the the newly inserted element.
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emplace(id_t id, Args&&... args)
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emplace(id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillHead(id);
@@ -490,9 +511,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param args are the arguments forwarded to construct the new element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emplaceAfter(const id_t &referenceId, id_t id, Args&&... args)
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emplaceAfter(const id_t &referenceId, id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillAfter(referenceId, id);
@@ -509,9 +530,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param id is the id that will be associated to the element
 * \param args are the arguments forwarded to construct the new element
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-void PiercedVector<value_t, id_t>::emplaceBack(id_t id, Args&&... args)
+void PiercedVector<value_t, id_t, allocator_t>::emplaceBack(id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillAppend(id);
@@ -520,6 +541,36 @@ void PiercedVector<value_t, id_t>::emplaceBack(id_t id, Args&&... args)
     emplaceValue(emplaceAction, std::forward<Args>(args)...);
 }
 
+/**
+* Inserts multiple new elements at the end of the container, right after
+* its current last element. The new elements are constructed in place
+* using args as the arguments for their construction.
+*
+* Positions for all the elements are created with a single kernel
+* operation, hence the storages synchronized with the container will
+* be resized only once.
+*
+* \param count is the number of elements that will be inserted
+* \param ids are the ids that will be associated to the elements
+* \param args are the arguments used to construct each new element
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename... Args>
+void PiercedVector<value_t, id_t, allocator_t>::emplaceBackRange(std::size_t count, const id_t *ids, const Args&... args)
+{
+    // Fill the positions
+    FillAction emplaceAction = PiercedVectorKernel<id_t>::fillAppendRange(count, ids);
+
+    // Create the new values in-place
+    //
+    // The capacity of the storage follows the one of the kernel, this keeps
+    // the amortized cost of appending multiple ranges constant.
+    PiercedVectorStorage<value_t, id_t, allocator_t>::rawReserve(PiercedVectorKernel<id_t>::capacity());
+    for (std::size_t k = 0; k < count; ++k) {
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplaceBack(args...);
+    }
+}
+
 /**
 * The container is extended by inserting a new element. This new
 * element is constructed in place using args as the arguments for
@@ -533,9 +584,9 @@ void PiercedVector<value_t, id_t>::emplaceBack(id_t id, Args&&... args)
 * \param args are the arguments forwarded to construct the new element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emplaceBefore(const id_t &referenceId, id_t id, Args&&... args)
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emplaceBefore(const id_t &referenceId, id_t id, Args&&... args)
 {
     // Fill a position
     FillAction emplaceAction = PiercedVectorKernel<id_t>::fillBefore(referenceId, id);
@@ -553,18 +604,18 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param args are the arguments forwarded to construct the new element
 * \result An iterator that points to the newly inserted element.
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emreplace(id_t id, Args&&... args)
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emreplace(id_t id, Args&&... args)
 {
     // Position
     std::size_t pos = PiercedVectorKernel<id_t>::getPos(id);
 
     // Replace the value
-    PiercedVectorStorage<value_t, id_t>::rawEmreplace(pos, std::forward<Args>(args)...);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmreplace(pos, std::forward<Args>(args)...);
 
     // Return the iterator that points to the element
-    return PiercedVectorStorage<value_t, id_t>::rawFind(pos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(pos);
 }
 
 /**
@@ -582,8 +633,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * the element erased by the function call. This is the container end if the
 * operation erased the last element in the sequence.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::erase(id_t id, bool delayed)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::erase(id_t id, bool delayed)
 {
     // Erase the position
     EraseAction eraseAction = PiercedVectorKernel<id_t>::erase(id, !delayed);
@@ -600,8 +651,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::er
 * id is changed to mark the position as empty and allow the
 * container to reuse that position.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::popBack()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::popBack()
 {
     // Erase the position
     EraseAction eraseAction = PiercedVectorKernel<id_t>::popBack();
@@ -616,8 +667,8 @@ void PiercedVector<value_t, id_t>::popBack()
 * \param id_first is the id of the first element to be swapped
 * \param id_second is the id of the second element to be swapped
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::swap(id_t id_first, id_t id_second)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::swap(id_t id_first, id_t id_second)
 {
     // Update the kernel
     SwapAction swapAction = PiercedVectorKernel<id_t>::swap(id_first, id_second);
@@ -634,14 +685,14 @@ void PiercedVector<value_t, id_t>::swap(id_t id_first, id_t id_second)
 * released, otherwise the container will be cleared but its memory will
 * not be relased
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::clear(bool release)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::clear(bool release)
 {
     // Update the kernel
     ClearAction clearAction = PiercedVectorKernel<id_t>::clear(release);
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(clearAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(clearAction);
 }
 
 /**
@@ -656,14 +707,14 @@ void PiercedVector<value_t, id_t>::clear(bool release)
 *
 * \param n the minimum capacity requested for the container
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::reserve(std::size_t n)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::reserve(std::size_t n)
 {
     // Update the kernel
     ReserveAction reserveAction = PiercedVectorKernel<id_t>::reserve(n);
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(reserveAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(reserveAction);
 }
 
 /**
@@ -683,27 +734,27 @@ void PiercedVector<value_t, id_t>::reserve(std::size_t n)
 *
 * \param n is the new container size, expressed in number of elements.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::resize(std::size_t n)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::resize(std::size_t n)
 {
     // Update the kernel
     ResizeAction resizeAction = PiercedVectorKernel<id_t>::resize(n);
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(resizeAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(resizeAction);
 }
 
 /**
 * Sorts the elements of the container in ascending id order.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::sort()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::sort()
 {
     // Update the kernel
     SortAction sortAction = PiercedVectorKernel<id_t>::sort();
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(sortAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(sortAction);
 }
 
 /**
@@ -715,14 +766,14 @@ void PiercedVector<value_t, id_t>::sort()
 * \param inclusive if true the reference element will be sorted, otherwise
 * the sorting will stop at the element following the reference
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::sortAfter(id_t referenceId, bool inclusive)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::sortAfter(id_t referenceId, bool inclusive)
 {
     // Update the kernel
     SortAction sortAction = PiercedVectorKernel<id_t>::sortAfter(referenceId, inclusive);
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(sortAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(sortAction);
 }
 
 /**
@@ -734,14 +785,79 @@ void PiercedVector<value_t, id_t>::sortAfter(id_t referenceId, bool inclusive)
 * \param inclusive if true the reference element will be sorted, otherwise
 * the sorting will stop at the element preceding the reference
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::sortBefore(id_t referenceId, bool inclusive)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::sortBefore(id_t referenceId, bool inclusive)
 {
     // Update the kernel
     SortAction sortAction = PiercedVectorKernel<id_t>::sortBefore(referenceId, inclusive);
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(sortAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(sortAction);
+}
+
+/**
+* Sorts the elements of the container using the specified comparison
+* function.
+*
+* \param comp is the comparison function, it will receive in input the ids
+* of the two elements to compare and should return true if the first element
+* should be placed before the second one
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename Compare>
+void PiercedVector<value_t, id_t, allocator_t>::sort(Compare comp)
+{
+    // Update the kernel
+    SortAction sortAction = PiercedVectorKernel<id_t>::sort(comp);
+
+    // Update the storage
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(sortAction);
+}
+
+/**
+* Sorts the container after the element with the reference id using the
+* specified comparison function.
+*
+* \param referenceId is the id of the element after which the container will
+* be sorted
+* \param inclusive if true the reference element will be sorted, otherwise
+* the sorting will stop at the element following the reference
+* \param comp is the comparison function, it will receive in input the ids
+* of the two elements to compare and should return true if the first element
+* should be placed before the second one
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename Compare>
+void PiercedVector<value_t, id_t, allocator_t>::sortAfter(id_t referenceId, bool inclusive, Compare comp)
+{
+    // Update the kernel
+    SortAction sortAction = PiercedVectorKernel<id_t>::sortAfter(referenceId, inclusive, comp);
+
+    // Update the storage
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(sortAction);
+}
+
+/**
+* Sorts the container before the element with the reference id using the
+* specified comparison function.
+*
+* \param referenceId is the id of the element before which the container will
+* be sorted
+* \param inclusive if true the reference element will be sorted, otherwise
+* the sorting will stop at the element preceding the reference
+* \param comp is the comparison function, it will receive in input the ids
+* of the two elements to compare and should return true if the first element
+* should be placed before the second one
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename Compare>
+void PiercedVector<value_t, id_t, allocator_t>::sortBefore(id_t referenceId, bool inclusive, Compare comp)
+{
+    // Update the kernel
+    SortAction sortAction = PiercedVectorKernel<id_t>::sortBefore(referenceId, inclusive, comp);
+
+    // Update the storage
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(sortAction);
 }
 
 /**
@@ -754,14 +870,14 @@ void PiercedVector<value_t, id_t>::sortBefore(id_t referenceId, bool inclusive)
 * This may cause a reallocation, but has no effect on the container size and
 * cannot alter its elements.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::squeeze()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::squeeze()
 {
     // Update the kernel
     SqueezeAction squeezeAction = PiercedVectorKernel<id_t>::squeeze();
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(squeezeAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(squeezeAction);
 }
 
 /**
@@ -774,14 +890,14 @@ void PiercedVector<value_t, id_t>::squeeze()
 * This may cause a reallocation, but has no effect on the container size and
 * cannot alter its elements not the holes.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::shrinkToFit()
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::shrinkToFit()
 {
     // Update the kernel
     ShrinkToFitAction shrinkToFitAction = PiercedVectorKernel<id_t>::shrinkToFit();
 
     // Update the storage
-    PiercedVectorStorage<value_t, id_t>::commitSyncAction(shrinkToFitAction);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::commitSyncAction(shrinkToFitAction);
 }
 
 /**
@@ -797,21 +913,21 @@ void PiercedVector<value_t, id_t>::shrinkToFit()
 * the same template parameters) whose content is swapped with that of
 * this container.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::swap(PiercedVector &other) noexcept
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::swap(PiercedVector &other) noexcept
 {
     // The swap will swap also the slave-master information. This is not what
     // we want, therefore the two pierced storage will be unregistered and the
     // registered again after the swap. When the kernel is unset the storage
     // can't be clear, otherwise its contents will be lost.
-    PiercedVectorStorage<value_t, id_t>::detachKernel();
-    other.PiercedVectorStorage<value_t, id_t>::detachKernel();
+    PiercedVectorStorage<value_t, id_t, allocator_t>::detachKernel();
+    other.PiercedVectorStorage<value_t, id_t, allocator_t>::detachKernel();
 
     // Swap kernel data
     PiercedVectorKernel<id_t>::swap(other);
 
     // Swap storage data
-    PiercedVectorStorage<value_t, id_t>::swap(other);
+    PiercedVectorStorage<value_t, id_t, allocator_t>::swap(other);
 
     // Re-register the storages
     //
@@ -820,8 +936,8 @@ void PiercedVector<value_t, id_t>::swap(PiercedVector &other) noexcept
     // neither of the two cases can happen, because the kernel has been
     // previously cleared and the kernel we are trying to set is not null.
     try {
-        PiercedVectorStorage<value_t, id_t>::setDynamicKernel(this, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED);
-        other.PiercedVectorStorage<value_t, id_t>::setDynamicKernel(&other, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::setDynamicKernel(this, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED);
+        other.PiercedVectorStorage<value_t, id_t, allocator_t>::setDynamicKernel(&other, PiercedVectorKernel<id_t>::SYNC_MODE_DISABLED);
     } catch (const std::exception &exception) {
         BITPIT_UNUSED(exception);
         assert(false && "Error while swapping the PiercedVector!");
@@ -835,8 +951,8 @@ void PiercedVector<value_t, id_t>::swap(PiercedVector &other) noexcept
 *
 * \result A constant reference to the kernel of the vector.
 */
-template<typename value_t, typename id_t>
-const PiercedVectorKernel<id_t> & PiercedVector<value_t, id_t>::getKernel() const
+template<typename value_t, typename id_t, typename allocator_t>
+const PiercedVectorKernel<id_t> & PiercedVector<value_t, id_t, allocator_t>::getKernel() const
 {
     return *this;
 }
@@ -846,17 +962,33 @@ const PiercedVectorKernel<id_t> & PiercedVector<value_t, id_t>::getKernel() cons
 *
 * \result A constant reference to the storage of the vector.
 */
-template<typename value_t, typename id_t>
-const PiercedVectorStorage<value_t, id_t> & PiercedVector<value_t, id_t>::getStorage() const
+template<typename value_t, typename id_t, typename allocator_t>
+const PiercedVectorStorage<value_t, id_t, allocator_t> & PiercedVector<value_t, id_t, allocator_t>::getStorage() const
 {
     return *this;
 }
 
+/**
+* Evaluates the memory allocated by the container.
+*
+* The memory used by the container includes the memory allocated by its
+* kernel and by its storage. The memory occupied by the container object
+* itself and the memory dynamically allocated by the elements are not
+* included.
+*
+* \result The memory, expressed in bytes, allocated by the container.
+*/
+template<typename value_t, typename id_t, typename allocator_t>
+std::size_t PiercedVector<value_t, id_t, allocator_t>::getMemoryUsage() const
+{
+    return (PiercedVectorKernel<id_t>::getMemoryUsage() + PiercedVectorStorage<value_t, id_t, allocator_t>::getMemoryUsage());
+}
+
 /**
 * Dumps to screen the internal data.
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::dump() const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::dump() const
 {
     PiercedVectorKernel<id_t>::dump();
 }
@@ -866,9 +998,9 @@ void PiercedVector<value_t, id_t>::dump() const
 *
 * \param stream is the stream data should be read from
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_pod<T>::value || PiercedVectorStorage<T, id_t>::has_restore()>::type *>
-void PiercedVector<value_t, id_t>::restore(std::istream &stream)
+void PiercedVector<value_t, id_t, allocator_t>::restore(std::istream &stream)
 {
     restoreKernel(stream);
 
@@ -880,9 +1012,9 @@ void PiercedVector<value_t, id_t>::restore(std::istream &stream)
 *
 * \param stream is the stream data should be written to
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename T, typename std::enable_if<std::is_pod<T>::value || PiercedVectorStorage<T, id_t>::has_dump()>::type *>
-void PiercedVector<value_t, id_t>::dump(std::ostream &stream) const
+void PiercedVector<value_t, id_t, allocator_t>::dump(std::ostream &stream) const
 {
     dumpKernel(stream);
 
@@ -894,12 +1026,12 @@ void PiercedVector<value_t, id_t>::dump(std::ostream &stream) const
 *
 * \param stream is the stream data should be read from
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::restoreKernel(std::istream &stream)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::restoreKernel(std::istream &stream)
 {
     PiercedVectorKernel<id_t>::restore(stream);
 
-    PiercedVectorStorage<value_t, id_t>::rawResize(PiercedVectorKernel<id_t>::rawSize());
+    PiercedVectorStorage<value_t, id_t, allocator_t>::rawResize(PiercedVectorKernel<id_t>::rawSize());
 }
 
 /**
@@ -907,8 +1039,8 @@ void PiercedVector<value_t, id_t>::restoreKernel(std::istream &stream)
 *
 * \param stream is the stream data should be written to
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::dumpKernel(std::ostream &stream) const
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::dumpKernel(std::ostream &stream) const
 {
     PiercedVectorKernel<id_t>::dump(stream);
 }
@@ -918,8 +1050,8 @@ void PiercedVector<value_t, id_t>::dumpKernel(std::ostream &stream) const
 *
 * \param action is the fill action that defines how to reclaim the element
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::reclaimValue(const FillAction &action)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::reclaimValue(const FillAction &action)
 {
     std::size_t pos = action.info[PiercedSyncAction::INFO_POS];
     switch (static_cast<typename FillAction::FillActionType>(action.type)) {
@@ -935,7 +1067,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawEmplace(pos);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplace(pos);
         break;
     }
 
@@ -944,7 +1076,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawEmplaceBack();
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplaceBack();
         pos = PiercedVectorKernel<id_t>::getLastUsedPos();
         break;
     }
@@ -958,7 +1090,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
     }
 
     // Return the iterator to the position where the element was inserted
-    return PiercedVectorStorage<value_t, id_t>::rawFind(pos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(pos);
 }
 
 /**
@@ -967,15 +1099,15 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::re
 * \param action is the fill action that defines how to insert the element
 * \param value is the value that will be assigned to the element
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::insertValue(const FillAction &action, const value_t &value)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::insertValue(const FillAction &action, const value_t &value)
 {
     std::size_t pos = action.info[PiercedSyncAction::INFO_POS];
     switch (static_cast<typename FillAction::FillActionType>(action.type)) {
 
     case FillAction::TYPE_OVERWRITE:
     {
-        PiercedVectorStorage<value_t, id_t>::rawSet(pos, value);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawSet(pos, value);
         break;
     }
 
@@ -984,7 +1116,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawInsert(pos, 1, value);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawInsert(pos, 1, value);
         break;
     }
 
@@ -993,7 +1125,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawPushBack(value);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawPushBack(value);
         pos = PiercedVectorKernel<id_t>::getLastUsedPos();
         break;
     }
@@ -1007,7 +1139,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
     }
 
     // Return the iterator to the position where the element was inserted
-    return PiercedVectorStorage<value_t, id_t>::rawFind(pos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(pos);
 }
 
 /**
@@ -1020,16 +1152,16 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::in
 * \param args are the arguments forwarded to the elements' construct when
 * synchronizing the action
 */
-template<typename value_t, typename id_t>
-template<typename... Args, typename PiercedStorage<value_t, id_t>::template EnableIfHasInitialize<Args...> * >
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emreclaimValue(const FillAction &action, Args&&... args)
+template<typename value_t, typename id_t, typename allocator_t>
+template<typename... Args, typename PiercedStorage<value_t, id_t, allocator_t>::template EnableIfHasInitialize<Args...> * >
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emreclaimValue(const FillAction &action, Args&&... args)
 {
     std::size_t pos = action.info[PiercedSyncAction::INFO_POS];
     switch (static_cast<typename FillAction::FillActionType>(action.type)) {
 
     case FillAction::TYPE_OVERWRITE:
     {
-        PiercedVectorStorage<value_t, id_t>::rawInitialize(pos, std::forward<Args>(args)...);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawInitialize(pos, std::forward<Args>(args)...);
         break;
     }
 
@@ -1038,7 +1170,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawEmplace(pos, std::forward<Args>(args)...);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplace(pos, std::forward<Args>(args)...);
         break;
     }
 
@@ -1047,7 +1179,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawEmplaceBack(std::forward<Args>(args)...);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplaceBack(std::forward<Args>(args)...);
         pos = PiercedVectorKernel<id_t>::getLastUsedPos();
         break;
     }
@@ -1061,7 +1193,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
     }
 
     // Return the iterator to the position where the element was inserted
-    return PiercedVectorStorage<value_t, id_t>::rawFind(pos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(pos);
 }
 
 /**
@@ -1071,16 +1203,16 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param args are the arguments forwarded to the elements' construct when
 * synchronizing the action
 */
-template<typename value_t, typename id_t>
+template<typename value_t, typename id_t, typename allocator_t>
 template<typename... Args>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emplaceValue(const FillAction &action, Args&&... args)
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::emplaceValue(const FillAction &action, Args&&... args)
 {
     std::size_t pos = action.info[PiercedSyncAction::INFO_POS];
     switch (static_cast<typename FillAction::FillActionType>(action.type)) {
 
     case FillAction::TYPE_OVERWRITE:
     {
-        PiercedVectorStorage<value_t, id_t>::rawEmreplace(pos, std::forward<Args>(args)...);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmreplace(pos, std::forward<Args>(args)...);
         break;
     }
 
@@ -1089,7 +1221,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawEmplace(pos, std::forward<Args>(args)...);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplace(pos, std::forward<Args>(args)...);
         break;
     }
 
@@ -1098,7 +1230,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawEmplaceBack(std::forward<Args>(args)...);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplaceBack(std::forward<Args>(args)...);
         pos = PiercedVectorKernel<id_t>::getLastUsedPos();
         break;
     }
@@ -1112,7 +1244,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
     }
 
     // Return the iterator to the position where the element was inserted
-    return PiercedVectorStorage<value_t, id_t>::rawFind(pos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(pos);
 }
 
 /**
@@ -1121,16 +1253,15 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::em
 * \param action is the move action that defines how to move the element
 * \result An iterator pointing to the new position of the element.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::moveValue(const MoveAction &action)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::moveValue(const MoveAction &action)
 {
-    std::size_t posNew = action.info[PiercedSyncAction::INFO_POS_FIRST];
-    std::size_t posOld = action.info[PiercedSyncAction::INFO_POS_SECOND];
+    std::size_t posOld = action.info[PiercedSyncAction::INFO_POS_FIRST];
+    std::size_t posNew = action.info[PiercedSyncAction::INFO_POS_SECOND];
     switch (static_cast<typename MoveAction::MoveActionType>(action.type)) {
 
     case MoveAction::TYPE_OVERWRITE:
     {
-        PiercedVectorStorage<value_t, id_t>::rawSet(posNew, std::move(PiercedVectorStorage<value_t, id_t>::rawAt(posOld)));
         break;
     }
 
@@ -1139,7 +1270,12 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawInsert(posNew, 1, std::move(PiercedVectorStorage<value_t, id_t>::rawAt(posOld)));
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplace(posNew);
+
+        // Elements after the inserted one have been shifted
+        if (posOld >= posNew) {
+            ++posOld;
+        }
         break;
     }
 
@@ -1148,8 +1284,9 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
         // Since we are increasing the sotrage by an element at the time
         // calling a reserve will hurt performance badly because this will
         // prevent the automatic reallocation of the storage.
-        PiercedVectorStorage<value_t, id_t>::rawPushBack(std::move(PiercedVectorStorage<value_t, id_t>::rawAt(posOld)));
-        posNew = PiercedVectorKernel<id_t>::getLastUsedPos();
+        if (posNew >= PiercedVectorStorage<value_t, id_t, allocator_t>::rawSize()) {
+            PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmplaceBack();
+        }
         break;
     }
 
@@ -1161,11 +1298,20 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
 
     }
 
-    // Clear the old position
-    PiercedVectorStorage<value_t, id_t>::rawEmreplace(posOld);
+    // Move the element and clear the old position
+    if (posOld != posNew) {
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawMove(posOld, posNew);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawEmreplace(posOld);
+    }
+
+    // Moving the last element shrinks the kernel
+    std::size_t kernelRawSize = PiercedVectorKernel<id_t>::rawSize();
+    if (PiercedVectorStorage<value_t, id_t, allocator_t>::rawSize() > kernelRawSize) {
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawResize(kernelRawSize);
+    }
 
     // Return the iterator to the new position
-    return PiercedVectorStorage<value_t, id_t>::rawFind(posNew);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(posNew);
 }
 
 /**
@@ -1176,8 +1322,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
 * \result An iterator pointing to the new location of the element that
 * followed the last element erased.
 */
-template<typename value_t, typename id_t>
-typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::eraseValue(const EraseAction &action)
+template<typename value_t, typename id_t, typename allocator_t>
+typename PiercedVector<value_t, id_t, allocator_t>::iterator PiercedVector<value_t, id_t, allocator_t>::eraseValue(const EraseAction &action)
 {
     switch (static_cast<typename EraseAction::EraseActionType>(action.type)) {
 
@@ -1191,7 +1337,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::er
     case EraseAction::TYPE_SHRINK:
     {
         std::size_t rawSize = action.info[PiercedSyncAction::INFO_SIZE];
-        PiercedVectorStorage<value_t, id_t>::rawResize(rawSize);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawResize(rawSize);
         break;
     }
 
@@ -1206,7 +1352,7 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::er
     // Return the iterator to the next element
     std::size_t nextPos = action.info[PiercedSyncAction::INFO_POS_NEXT];
 
-    return PiercedVectorStorage<value_t, id_t>::rawFind(nextPos);
+    return PiercedVectorStorage<value_t, id_t, allocator_t>::rawFind(nextPos);
 }
 
 /**
@@ -1214,8 +1360,8 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::er
 *
 * \param action is the swap action that defines how to swap the element
 */
-template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::swapValues(const SwapAction &action)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVector<value_t, id_t, allocator_t>::swapValues(const SwapAction &action)
 {
     switch (static_cast<typename SwapAction::SwapActionType>(action.type)) {
 
@@ -1223,7 +1369,7 @@ void PiercedVector<value_t, id_t>::swapValues(const SwapAction &action)
     {
         std::size_t posFirst  = action.info[PiercedSyncAction::INFO_POS_FIRST];
         std::size_t posSecond = action.info[PiercedSyncAction::INFO_POS_SECOND];
-        PiercedVectorStorage<value_t, id_t>::rawSwap(posFirst, posSecond);
+        PiercedVectorStorage<value_t, id_t, allocator_t>::rawSwap(posFirst, posSecond);
         break;
     }
 
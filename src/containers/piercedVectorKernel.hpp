@@ -69,6 +69,7 @@ protected:
     using PiercedKernel<id_t>::fillAfter;
     using PiercedKernel<id_t>::fillBefore;
     using PiercedKernel<id_t>::fillAppend;
+    using PiercedKernel<id_t>::fillAppendRange;
     using PiercedKernel<id_t>::fillHole;
     using PiercedKernel<id_t>::fillInsert;
 
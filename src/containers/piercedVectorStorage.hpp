@@ -30,10 +30,10 @@
 #include "piercedStorage.hpp"
 #include "piercedVectorKernel.hpp"
 
-#define __PVS_REFERENCE__       typename PiercedVectorStorage<value_t, id_t>::reference
-#define __PVS_CONST_REFERENCE__ typename PiercedVectorStorage<value_t, id_t>::const_reference
-#define __PVS_POINTER__         typename PiercedVectorStorage<value_t, id_t>::pointer
-#define __PVS_CONST_POINTER__   typename PiercedVectorStorage<value_t, id_t>::const_pointer
+#define __PVS_REFERENCE__       typename PiercedVectorStorage<value_t, id_t, allocator_t>::reference
+#define __PVS_CONST_REFERENCE__ typename PiercedVectorStorage<value_t, id_t, allocator_t>::const_reference
+#define __PVS_POINTER__         typename PiercedVectorStorage<value_t, id_t, allocator_t>::pointer
+#define __PVS_CONST_POINTER__   typename PiercedVectorStorage<value_t, id_t, allocator_t>::const_pointer
 
 namespace bitpit {
 
@@ -52,16 +52,16 @@ protected:
 *
 * \brief Kernel of the pierced vector.
 */
-template<typename value_t, typename id_t = long>
+template<typename value_t, typename id_t = long, typename allocator_t = std::allocator<value_t>>
 class PiercedVectorStorage : public BasePiercedVectorStorage,
-                             public PiercedStorage<value_t, id_t> {
+                             public PiercedStorage<value_t, id_t, allocator_t> {
 
 public:
     // Contructors
-    using PiercedStorage<value_t, id_t>::PiercedStorage;
+    using PiercedStorage<value_t, id_t, allocator_t>::PiercedStorage;
 
     // Methods that extract the contents of the container
-    using PiercedStorage<value_t, id_t>::data;
+    using PiercedStorage<value_t, id_t, allocator_t>::data;
 
     __PVS_REFERENCE__ back();
     __PVS_CONST_REFERENCE__ back() const;
@@ -78,31 +78,33 @@ public:
     __PVS_CONST_REFERENCE__ operator[](id_t id) const;
     __PVS_REFERENCE__ operator[](id_t id);
 
-    using PiercedStorage<value_t, id_t>::find;
+    using PiercedStorage<value_t, id_t, allocator_t>::find;
 
-    using PiercedStorage<value_t, id_t>::rawFind;
+    using PiercedStorage<value_t, id_t, allocator_t>::rawFind;
 
     // Iterators
-    using PiercedStorage<value_t, id_t>::begin;
-    using PiercedStorage<value_t, id_t>::end;
-    using PiercedStorage<value_t, id_t>::cbegin;
-    using PiercedStorage<value_t, id_t>::cend;
+    using PiercedStorage<value_t, id_t, allocator_t>::begin;
+    using PiercedStorage<value_t, id_t, allocator_t>::end;
+    using PiercedStorage<value_t, id_t, allocator_t>::cbegin;
+    using PiercedStorage<value_t, id_t, allocator_t>::cend;
 
-    using PiercedStorage<value_t, id_t>::rawBegin;
-    using PiercedStorage<value_t, id_t>::rawEnd;
-    using PiercedStorage<value_t, id_t>::rawCbegin;
-    using PiercedStorage<value_t, id_t>::rawCend;
+    using PiercedStorage<value_t, id_t, allocator_t>::rawBegin;
+    using PiercedStorage<value_t, id_t, allocator_t>::rawEnd;
+    using PiercedStorage<value_t, id_t, allocator_t>::rawCbegin;
+    using PiercedStorage<value_t, id_t, allocator_t>::rawCend;
+
+    using PiercedStorage<value_t, id_t, allocator_t>::split;
 
     // Methods for handing the synchronization
-    using PiercedStorage<value_t, id_t>::unsetKernel;
+    using PiercedStorage<value_t, id_t, allocator_t>::unsetKernel;
 
     void setStaticKernel(const PiercedVectorKernel<id_t> *kernel);
     void setDynamicKernel(const PiercedVectorKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode);
     const PiercedVectorKernel<id_t> * getKernel() const;
 
     // Dump and restore
-    using PiercedStorage<value_t, id_t>::dump;
-    using PiercedStorage<value_t, id_t>::restore;
+    using PiercedStorage<value_t, id_t, allocator_t>::dump;
+    using PiercedStorage<value_t, id_t, allocator_t>::restore;
 
 };
 
@@ -34,10 +34,10 @@ namespace bitpit {
 *
 * \result A reference to the first element of the container.
 */
-template<typename value_t, typename id_t>
-__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::front()
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::front()
 {
-    return PiercedStorage<value_t, id_t>::front(0);
+    return PiercedStorage<value_t, id_t, allocator_t>::front(0);
 }
 
 /**
@@ -47,10 +47,10 @@ __PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::front()
 *
 * \result A constant reference to the first element of the container.
 */
-template<typename value_t, typename id_t>
-__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::front() const
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::front() const
 {
-    return PiercedStorage<value_t, id_t>::front(0);
+    return PiercedStorage<value_t, id_t, allocator_t>::front(0);
 }
 
 /**
@@ -60,10 +60,10 @@ __PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::front() const
 *
 * \result A reference to the last element of the container.
 */
-template<typename value_t, typename id_t>
-__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::back()
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::back()
 {
-    return PiercedStorage<value_t, id_t>::back(0);
+    return PiercedStorage<value_t, id_t, allocator_t>::back(0);
 }
 
 /**
@@ -73,10 +73,10 @@ __PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::back()
 *
 * \result A constant reference to the last element of the container.
 */
-template<typename value_t, typename id_t>
-__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::back() const
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::back() const
 {
-    return PiercedStorage<value_t, id_t>::back(0);
+    return PiercedStorage<value_t, id_t, allocator_t>::back(0);
 }
 
 /**
@@ -87,10 +87,10 @@ __PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::back() const
 * \param id is the id of the element
 * \result A reference to the element with the specified id.
 */
-template<typename value_t, typename id_t>
-__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::at(id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::at(id_t id)
 {
-    return PiercedStorage<value_t, id_t>::at(id, 0);
+    return PiercedStorage<value_t, id_t, allocator_t>::at(id, 0);
 }
 
 /**
@@ -101,10 +101,10 @@ __PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::at(id_t id)
 * \param id is the id of the element
 * \result A constant reference to the element with the specified id.
 */
-template<typename value_t, typename id_t>
-__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::at(id_t id) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::at(id_t id) const
 {
-    return PiercedStorage<value_t, id_t>::at(id, 0);
+    return PiercedStorage<value_t, id_t, allocator_t>::at(id, 0);
 }
 
 /**
@@ -113,10 +113,10 @@ __PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::at(id_t id) const
 * \param pos the position of the element
 * \result A reference to the element in the specified position.
 */
-template<typename value_t, typename id_t>
-__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::rawAt(std::size_t pos)
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::rawAt(std::size_t pos)
 {
-    return PiercedStorage<value_t, id_t>::rawAt(pos, 0);
+    return PiercedStorage<value_t, id_t, allocator_t>::rawAt(pos, 0);
 }
 
 /**
@@ -125,10 +125,10 @@ __PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::rawAt(std::size_t pos)
 * \param pos the position of the element
 * \result A constant reference to the element in the specified position.
 */
-template<typename value_t, typename id_t>
-__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::rawAt(std::size_t pos) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::rawAt(std::size_t pos) const
 {
-    return PiercedStorage<value_t, id_t>::rawAt(pos, 0);
+    return PiercedStorage<value_t, id_t, allocator_t>::rawAt(pos, 0);
 }
 
 /**
@@ -139,10 +139,10 @@ __PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::rawAt(std::size_t p
 * \param id is the id of the element
 * \result A constant reference to the element with the specified id.
 */
-template<typename value_t, typename id_t>
-__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::operator[](id_t id) const
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::operator[](id_t id) const
 {
-    return PiercedStorage<value_t, id_t>::at(id, 0);
+    return PiercedStorage<value_t, id_t, allocator_t>::at(id, 0);
 }
 
 /**
@@ -153,10 +153,10 @@ __PVS_CONST_REFERENCE__ PiercedVectorStorage<value_t, id_t>::operator[](id_t id)
 * \param id is the id of the element
 * \result A reference to the element with the specified id.
 */
-template<typename value_t, typename id_t>
-__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::operator[](id_t id)
+template<typename value_t, typename id_t, typename allocator_t>
+__PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t, allocator_t>::operator[](id_t id)
 {
-    return PiercedStorage<value_t, id_t>::at(id, 0);
+    return PiercedStorage<value_t, id_t, allocator_t>::at(id, 0);
 }
 
 /**
@@ -167,10 +167,10 @@ __PVS_REFERENCE__ PiercedVectorStorage<value_t, id_t>::operator[](id_t id)
 *
 * \param kernel is the kernel that will be set
 */
-template<typename value_t, typename id_t>
-void PiercedVectorStorage<value_t, id_t>::setStaticKernel(const PiercedVectorKernel<id_t> *kernel)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVectorStorage<value_t, id_t, allocator_t>::setStaticKernel(const PiercedVectorKernel<id_t> *kernel)
 {
-    PiercedStorage<value_t, id_t>::setStaticKernel(kernel);
+    PiercedStorage<value_t, id_t, allocator_t>::setStaticKernel(kernel);
 }
 
 /**
@@ -181,10 +181,10 @@ void PiercedVectorStorage<value_t, id_t>::setStaticKernel(const PiercedVectorKer
 * \param kernel is the kernel that will be set
 * \param syncMode is the synchronization mode that will be used for the storage
 */
-template<typename value_t, typename id_t>
-void PiercedVectorStorage<value_t, id_t>::setDynamicKernel(const PiercedVectorKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
+template<typename value_t, typename id_t, typename allocator_t>
+void PiercedVectorStorage<value_t, id_t, allocator_t>::setDynamicKernel(const PiercedVectorKernel<id_t> *kernel, PiercedSyncMaster::SyncMode syncMode)
 {
-    PiercedStorage<value_t, id_t>::setDynamicKernel(kernel, syncMode);
+    PiercedStorage<value_t, id_t, allocator_t>::setDynamicKernel(kernel, syncMode);
 }
 
 /**
@@ -192,10 +192,10 @@ void PiercedVectorStorage<value_t, id_t>::setDynamicKernel(const PiercedVectorKe
 *
 * \result A constant reference to the kernel of the storage.
 */
-template<typename value_t, typename id_t>
-const PiercedVectorKernel<id_t> * PiercedVectorStorage<value_t, id_t>::getKernel() const
+template<typename value_t, typename id_t, typename allocator_t>
+const PiercedVectorKernel<id_t> * PiercedVectorStorage<value_t, id_t, allocator_t>::getKernel() const
 {
-    return PiercedStorage<value_t, id_t>::getKernel();
+    return PiercedStorage<value_t, id_t, allocator_t>::getKernel();
 }
 
 }
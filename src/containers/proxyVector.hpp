@@ -38,14 +38,14 @@
 #define  __PXI_REFERENCE__ typename ProxyVectorIterator<value_t, container_t>::reference
 #define  __PXI_POINTER__   typename ProxyVectorIterator<value_t, container_t>::pointer
 
-#define __PXV_REFERENCE__             typename ProxyVector<value_t, thread_safe>::reference
-#define __PXV_CONST_REFERENCE__       typename ProxyVector<value_t, thread_safe>::const_reference
-#define __PXV_POINTER__               typename ProxyVector<value_t, thread_safe>::pointer
-#define __PXV_CONST_POINTER__         typename ProxyVector<value_t, thread_safe>::const_pointer
-#define __PXV_STORAGE_POINTER__       typename ProxyVector<value_t, thread_safe>::storage_pointer
-#define __PXV_STORAGE_CONST_POINTER__ typename ProxyVector<value_t, thread_safe>::storage_const_pointer
-#define __PXV_ITERATOR__              typename ProxyVector<value_t, thread_safe>::iterator
-#define __PXV_CONST_ITERATOR__        typename ProxyVector<value_t, thread_safe>::const_iterator
+#define __PXV_REFERENCE__             typename ProxyVector<value_t, thread_safe, allocator_t>::reference
+#define __PXV_CONST_REFERENCE__       typename ProxyVector<value_t, thread_safe, allocator_t>::const_reference
+#define __PXV_POINTER__               typename ProxyVector<value_t, thread_safe, allocator_t>::pointer
+#define __PXV_CONST_POINTER__         typename ProxyVector<value_t, thread_safe, allocator_t>::const_pointer
+#define __PXV_STORAGE_POINTER__       typename ProxyVector<value_t, thread_safe, allocator_t>::storage_pointer
+#define __PXV_STORAGE_CONST_POINTER__ typename ProxyVector<value_t, thread_safe, allocator_t>::storage_const_pointer
+#define __PXV_ITERATOR__              typename ProxyVector<value_t, thread_safe, allocator_t>::iterator
+#define __PXV_CONST_ITERATOR__        typename ProxyVector<value_t, thread_safe, allocator_t>::const_iterator
 
 #include <cassert>
 #include <memory>
@@ -55,7 +55,7 @@
 
 namespace bitpit {
 
-template<typename PXV_value_t, bool PXV_thread_safe>
+template<typename PXV_value_t, bool PXV_thread_safe, typename PXV_allocator_t>
 class ProxyVector;
 
 /*!
@@ -69,7 +69,7 @@ template<typename value_t, typename container_t>
 class ProxyVectorIterator
 {
 
-template<typename PXV_value_t, bool PXV_thread_safe>
+template<typename PXV_value_t, bool PXV_thread_safe, typename PXV_allocator_t>
 friend class ProxyVector;
 
 friend class ProxyVectorIterator<typename std::add_const<value_t>::type, container_t>;
@@ -189,7 +189,7 @@ template<typename value_t, typename pointer_t = value_t *, typename const_pointe
 class ProxyVectorDummyStorage : public ProxyVectorStorageInterface<pointer_t, const_pointer_t>
 {
 
-template<typename PXV_value_t, bool PXV_thread_safe>
+template<typename PXV_value_t, bool PXV_thread_safe, typename PXV_allocator_t>
 friend class ProxyVector;
 
 public:
@@ -219,12 +219,14 @@ protected:
     @tparam container_t defines the type of container where the data is stored
     @tparam thread_safe controls if it is safe to use the container in
     a multi-threaded code
+    @tparam allocator_t is the allocator used for the elements stored
+    inside the container
 */
 template<typename value_t, typename container_t, bool thread_safe>
 class ProxyVectorStorage : public ProxyVectorStorageInterface<typename container_t::pointer, typename container_t::const_pointer>
 {
 
-template<typename PXV_value_t, bool PXV_thread_safe>
+template<typename PXV_value_t, bool PXV_thread_safe, typename PXV_allocator_t>
 friend class ProxyVector;
 
 public:
@@ -260,7 +262,7 @@ private:
     static const int MEMORY_POOL_VECTOR_COUNT = 10;
     static const int MEMORY_POOL_MAX_CAPACITY = 128;
 
-    static std::vector<std::unique_ptr<container_t>> m_containerPool;
+    static thread_local std::vector<std::unique_ptr<container_t>> m_containerPool;
 
     std::unique_ptr<container_t> createContainer(std::size_t size, bool allowEmpty);
     std::unique_ptr<container_t> createContainer(const std::unique_ptr<container_t> &source, bool allowEmpty);
@@ -286,8 +288,11 @@ private:
     @tparam value_t is the type of the objects handled by the ProxyVector
     @tparam thread_safe controls if it is safe to use the container in
     a multi-threaded code
+    @tparam allocator_t is the allocator used for the elements stored
+    inside the container
 */
-template<typename value_t, bool thread_safe = false>
+template<typename value_t, bool thread_safe = false,
+         typename allocator_t = std::allocator<typename std::remove_cv<value_t>::type>>
 class ProxyVector
 {
 
@@ -298,7 +303,7 @@ public:
     /*!
         Container type
      */
-    typedef std::vector<value_no_cv_t> container_type;
+    typedef std::vector<value_no_cv_t, allocator_t> container_type;
 
     /*!
         Type of data stored in the container
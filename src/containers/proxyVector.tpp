@@ -262,9 +262,13 @@ void ProxyVectorDummyStorage<value_t, pointer_t, const_pointer_t>::resize(std::s
 
 /*!
     Memory pool
+
+    Each thread has its own pool, this allows to use non thread-safe proxy
+    vectors concurrently from different threads, as long as every thread
+    works on its own vectors.
 */
 template<typename value_t, typename container_t, bool thread_safe>
-std::vector<std::unique_ptr<container_t>> ProxyVectorStorage<value_t, container_t, thread_safe>::m_containerPool = std::vector<std::unique_ptr<container_t>>();
+thread_local std::vector<std::unique_ptr<container_t>> ProxyVectorStorage<value_t, container_t, thread_safe>::m_containerPool = std::vector<std::unique_ptr<container_t>>();
 
 /*!
     Create a data container.
@@ -529,8 +533,8 @@ void ProxyVectorStorage<value_t, container_t, thread_safe>::resize(std::size_t s
 /*!
     Constructor
 */
-template<typename value_t, bool thread_safe>
-ProxyVector<value_t, thread_safe>::ProxyVector()
+template<typename value_t, bool thread_safe, typename allocator_t>
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector()
     : m_size(0), m_data(nullptr)
 {
 }
@@ -547,10 +551,10 @@ ProxyVector<value_t, thread_safe>::ProxyVector()
 
     \param size is the number elements contained in the data
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<other_value_t>::value, int>::type>
-ProxyVector<value_t, thread_safe>::ProxyVector(std::size_t size)
-    : ProxyVector<value_t, thread_safe>(INTERNAL_STORAGE, size, size)
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(std::size_t size)
+    : ProxyVector<value_t, thread_safe, allocator_t>(INTERNAL_STORAGE, size, size)
 {
 }
 
@@ -570,10 +574,10 @@ ProxyVector<value_t, thread_safe>::ProxyVector(std::size_t size)
     the size of the data, if a smaller capacity is specified the storage will
     be resized using data size
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<other_value_t>::value, int>::type>
-ProxyVector<value_t, thread_safe>::ProxyVector(std::size_t size, std::size_t capacity)
-    : ProxyVector<value_t, thread_safe>::ProxyVector(INTERNAL_STORAGE, size, capacity)
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(std::size_t size, std::size_t capacity)
+    : ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(INTERNAL_STORAGE, size, capacity)
 {
 }
 
@@ -590,10 +594,10 @@ ProxyVector<value_t, thread_safe>::ProxyVector(std::size_t size, std::size_t cap
     \param data a pointer to the data
     \param size is the number elements contained in the data
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<other_value_t>::value, int>::type>
-ProxyVector<value_t, thread_safe>::ProxyVector(__PXV_POINTER__ data, std::size_t size)
-    : ProxyVector<value_t, thread_safe>::ProxyVector(data, size, (data != INTERNAL_STORAGE) ? 0 : size)
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(__PXV_POINTER__ data, std::size_t size)
+    : ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(data, size, (data != INTERNAL_STORAGE) ? 0 : size)
 {
 }
 
@@ -614,9 +618,9 @@ ProxyVector<value_t, thread_safe>::ProxyVector(__PXV_POINTER__ data, std::size_t
     the size of the data, if a smaller capacity is specified the storage will
     be resized using data size
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<other_value_t>::value, int>::type>
-ProxyVector<value_t, thread_safe>::ProxyVector(__PXV_POINTER__ data, std::size_t size, std::size_t capacity)
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(__PXV_POINTER__ data, std::size_t size, std::size_t capacity)
     : m_storage(capacity), m_size(size), m_data((data != INTERNAL_STORAGE) ? data : m_storage.data())
 {
 }
@@ -632,9 +636,9 @@ ProxyVector<value_t, thread_safe>::ProxyVector(__PXV_POINTER__ data, std::size_t
     \param data a pointer to the data
     \param size is the number elements contained in the data
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-ProxyVector<value_t, thread_safe>::ProxyVector(__PXV_POINTER__ data, std::size_t size)
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(__PXV_POINTER__ data, std::size_t size)
     : m_storage(0), m_size(size), m_data(data)
 {
     assert(data != INTERNAL_STORAGE);
@@ -645,8 +649,8 @@ ProxyVector<value_t, thread_safe>::ProxyVector(__PXV_POINTER__ data, std::size_t
 
     \param other is another container whose content is copied in this container
 */
-template<typename value_t, bool thread_safe>
-ProxyVector<value_t, thread_safe>::ProxyVector(const ProxyVector &other)
+template<typename value_t, bool thread_safe, typename allocator_t>
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(const ProxyVector &other)
     : m_storage(other.m_storage), m_size(other.m_size), m_data(other.storedData() ? m_storage.data() : other.m_data)
 {
 }
@@ -662,8 +666,8 @@ ProxyVector<value_t, thread_safe>::ProxyVector(const ProxyVector &other)
 
     \param other is another container whose content is moved in this container
 */
-template<typename value_t, bool thread_safe>
-ProxyVector<value_t, thread_safe>::ProxyVector(ProxyVector &&other)
+template<typename value_t, bool thread_safe, typename allocator_t>
+ProxyVector<value_t, thread_safe, allocator_t>::ProxyVector(ProxyVector &&other)
     : m_storage(std::move(other.m_storage)), m_size(std::move(other.m_size)), m_data(std::move(other.m_data))
 {
 }
@@ -676,8 +680,8 @@ ProxyVector<value_t, thread_safe>::ProxyVector(ProxyVector &&other)
 
     \param other is another container whose content is copied in this container
 */
-template<typename value_t, bool thread_safe>
-ProxyVector<value_t, thread_safe> & ProxyVector<value_t, thread_safe>::operator=(const ProxyVector &other)
+template<typename value_t, bool thread_safe, typename allocator_t>
+ProxyVector<value_t, thread_safe, allocator_t> & ProxyVector<value_t, thread_safe, allocator_t>::operator=(const ProxyVector &other)
 {
     if (this != &other) {
         ProxyVector temporary(other);
@@ -701,8 +705,8 @@ ProxyVector<value_t, thread_safe> & ProxyVector<value_t, thread_safe>::operator=
 
     \param other is another container whose content is moved in this container
 */
-template<typename value_t, bool thread_safe>
-ProxyVector<value_t, thread_safe> & ProxyVector<value_t, thread_safe>::operator=(ProxyVector &&other)
+template<typename value_t, bool thread_safe, typename allocator_t>
+ProxyVector<value_t, thread_safe, allocator_t> & ProxyVector<value_t, thread_safe, allocator_t>::operator=(ProxyVector &&other)
 {
     if (this != &other) {
         ProxyVector temporary(std::move(other));
@@ -727,9 +731,9 @@ ProxyVector<value_t, thread_safe> & ProxyVector<value_t, thread_safe>::operator=
     storage
     \param size is the number elements contained in the data
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<other_value_t>::value, int>::type>
-void ProxyVector<value_t, thread_safe>::set(__PXV_POINTER__ data, std::size_t size)
+void ProxyVector<value_t, thread_safe, allocator_t>::set(__PXV_POINTER__ data, std::size_t size)
 {
     std::size_t capacity;
     if (data != INTERNAL_STORAGE) {
@@ -759,9 +763,9 @@ void ProxyVector<value_t, thread_safe>::set(__PXV_POINTER__ data, std::size_t si
     the size of the data, if a smaller capacity is specified the storage
     will be resize using data size
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<std::is_const<other_value_t>::value, int>::type>
-void ProxyVector<value_t, thread_safe>::set(__PXV_POINTER__ data, std::size_t size, std::size_t capacity)
+void ProxyVector<value_t, thread_safe, allocator_t>::set(__PXV_POINTER__ data, std::size_t size, std::size_t capacity)
 {
     m_storage.resize(std::max(size, capacity));
 
@@ -790,9 +794,9 @@ void ProxyVector<value_t, thread_safe>::set(__PXV_POINTER__ data, std::size_t si
     not allowed
     \param size is the number elements contained in the data
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-void ProxyVector<value_t, thread_safe>::set(__PXV_POINTER__ data, std::size_t size)
+void ProxyVector<value_t, thread_safe, allocator_t>::set(__PXV_POINTER__ data, std::size_t size)
 {
     assert(data != INTERNAL_STORAGE);
 
@@ -810,8 +814,8 @@ void ProxyVector<value_t, thread_safe>::set(__PXV_POINTER__ data, std::size_t si
 
     \result A a direct pointer to the memory of the internal storage.
 */
-template<typename value_t, bool thread_safe>
-__PXV_STORAGE_POINTER__ ProxyVector<value_t, thread_safe>::storedData() noexcept
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_STORAGE_POINTER__ ProxyVector<value_t, thread_safe, allocator_t>::storedData() noexcept
 {
     __PXV_STORAGE_POINTER__ internalData = m_storage.data();
     if (!internalData) {
@@ -831,8 +835,8 @@ __PXV_STORAGE_POINTER__ ProxyVector<value_t, thread_safe>::storedData() noexcept
 
     \result A a direct pointer to the memory of the internal storage.
 */
-template<typename value_t, bool thread_safe>
-__PXV_STORAGE_CONST_POINTER__ ProxyVector<value_t, thread_safe>::storedData() const noexcept
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_STORAGE_CONST_POINTER__ ProxyVector<value_t, thread_safe, allocator_t>::storedData() const noexcept
 {
     __PXV_STORAGE_CONST_POINTER__ internalData = m_storage.data();
     if (!internalData) {
@@ -857,9 +861,9 @@ __PXV_STORAGE_CONST_POINTER__ ProxyVector<value_t, thread_safe>::storedData() co
     \result A direct reference to the container associated with the internal
     storage.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename U, typename std::enable_if<std::is_const<U>::value, int>::type>
-typename ProxyVector<value_t, thread_safe>::container_type * ProxyVector<value_t, thread_safe>::storedDataContainer(bool forceCreation)
+typename ProxyVector<value_t, thread_safe, allocator_t>::container_type * ProxyVector<value_t, thread_safe, allocator_t>::storedDataContainer(bool forceCreation)
 {
     return m_storage.container(forceCreation);
 }
@@ -877,9 +881,9 @@ typename ProxyVector<value_t, thread_safe>::container_type * ProxyVector<value_t
     \result A constant direct reference to the container associated with the
     internal storage.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename U, typename std::enable_if<std::is_const<U>::value, int>::type>
-const typename ProxyVector<value_t, thread_safe>::container_type * ProxyVector<value_t, thread_safe>::storedDataContainer(bool forceCreation) const
+const typename ProxyVector<value_t, thread_safe, allocator_t>::container_type * ProxyVector<value_t, thread_safe, allocator_t>::storedDataContainer(bool forceCreation) const
 {
     return m_storage.container(forceCreation);
 }
@@ -889,8 +893,8 @@ const typename ProxyVector<value_t, thread_safe>::container_type * ProxyVector<v
 
     \param other is another container of the same type
 */
-template<typename value_t, bool thread_safe>
-void ProxyVector<value_t, thread_safe>::swap(ProxyVector &other)
+template<typename value_t, bool thread_safe, typename allocator_t>
+void ProxyVector<value_t, thread_safe, allocator_t>::swap(ProxyVector &other)
 {
     std::swap(m_size, other.m_size);
     std::swap(m_data, other.m_data);
@@ -903,8 +907,8 @@ void ProxyVector<value_t, thread_safe>::swap(ProxyVector &other)
 
     \result true if the containers are equal, false otherwise.
 */
-template<typename value_t, bool thread_safe>
-bool ProxyVector<value_t, thread_safe>::operator==(const ProxyVector& other) const
+template<typename value_t, bool thread_safe, typename allocator_t>
+bool ProxyVector<value_t, thread_safe, allocator_t>::operator==(const ProxyVector& other) const
 {
     if (m_size != other.m_size) {
         return false;
@@ -930,8 +934,8 @@ bool ProxyVector<value_t, thread_safe>::operator==(const ProxyVector& other) con
 
     \result true if the container size is 0, false otherwise.
 */
-template<typename value_t, bool thread_safe>
-bool ProxyVector<value_t, thread_safe>::empty() const
+template<typename value_t, bool thread_safe, typename allocator_t>
+bool ProxyVector<value_t, thread_safe, allocator_t>::empty() const
 {
     return size() == 0;
 }
@@ -941,8 +945,8 @@ bool ProxyVector<value_t, thread_safe>::empty() const
 
     \result The number of elements in the container.
 */
-template<typename value_t, bool thread_safe>
-std::size_t ProxyVector<value_t, thread_safe>::size() const
+template<typename value_t, bool thread_safe, typename allocator_t>
+std::size_t ProxyVector<value_t, thread_safe, allocator_t>::size() const
 {
     return m_size;
 }
@@ -952,9 +956,9 @@ std::size_t ProxyVector<value_t, thread_safe>::size() const
 
     \result A direct pointer to the memory where the elments are stored.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_POINTER__ ProxyVector<value_t, thread_safe>::data() noexcept
+__PXV_POINTER__ ProxyVector<value_t, thread_safe, allocator_t>::data() noexcept
 {
     return m_data;
 }
@@ -966,8 +970,8 @@ __PXV_POINTER__ ProxyVector<value_t, thread_safe>::data() noexcept
     \result A direct constant pointer to the memory where the elments are
     stored.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_POINTER__ ProxyVector<value_t, thread_safe>::data() const noexcept
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_POINTER__ ProxyVector<value_t, thread_safe, allocator_t>::data() const noexcept
 {
     return m_data;
 }
@@ -978,9 +982,9 @@ __PXV_CONST_POINTER__ ProxyVector<value_t, thread_safe>::data() const noexcept
     \param n is the position of the requested element
     \result A reference to the specified element.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::operator[](std::size_t n)
+__PXV_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::operator[](std::size_t n)
 {
     return m_data[n];
 }
@@ -991,8 +995,8 @@ __PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::operator[](std::size_t n)
     \param n is the position of the requested element
     \result A constant reference to the specified element.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::operator[](std::size_t n) const
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::operator[](std::size_t n) const
 {
     return m_data[n];
 }
@@ -1003,9 +1007,9 @@ __PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::operator[](std::size_
     \param n is the position of the requested element
     \result A reference to the specified element.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::at(std::size_t n)
+__PXV_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::at(std::size_t n)
 {
     return m_data[n];
 }
@@ -1016,8 +1020,8 @@ __PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::at(std::size_t n)
     \param n is the position of the requested element
     \result A constant reference to the specified element.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::at(std::size_t n) const
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::at(std::size_t n) const
 {
     return m_data[n];
 }
@@ -1027,9 +1031,9 @@ __PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::at(std::size_t n) con
 
     \result A reference to the first element in the container.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::front()
+__PXV_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::front()
 {
     return m_data[0];
 }
@@ -1039,8 +1043,8 @@ __PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::front()
 
     \result A constant reference to the first element in the container.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::front() const
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::front() const
 {
     return m_data[0];
 }
@@ -1050,9 +1054,9 @@ __PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::front() const
 
     \result A reference to the last element in the container.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::back()
+__PXV_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::back()
 {
     return m_data[m_size - 1];
 }
@@ -1062,8 +1066,8 @@ __PXV_REFERENCE__ ProxyVector<value_t, thread_safe>::back()
 
     \result A constant reference to the last element in the container.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::back() const
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe, allocator_t>::back() const
 {
     return m_data[m_size - 1];
 }
@@ -1073,9 +1077,9 @@ __PXV_CONST_REFERENCE__ ProxyVector<value_t, thread_safe>::back() const
 
     \result An iterator pointing to the first element in the container.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_ITERATOR__ ProxyVector<value_t, thread_safe>::begin()
+__PXV_ITERATOR__ ProxyVector<value_t, thread_safe, allocator_t>::begin()
 {
     return iterator(m_data);
 }
@@ -1085,8 +1089,8 @@ __PXV_ITERATOR__ ProxyVector<value_t, thread_safe>::begin()
 
     \result A constant iterator pointing to the first element in the container.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe>::begin() const
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe, allocator_t>::begin() const
 {
     return const_iterator(m_data);
 }
@@ -1096,9 +1100,9 @@ __PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe>::begin() const
 
     \result An iterator referring to the past-the-end element in the container.
 */
-template<typename value_t, bool thread_safe>
+template<typename value_t, bool thread_safe, typename allocator_t>
 template<typename other_value_t, typename std::enable_if<!std::is_const<other_value_t>::value, int>::type>
-__PXV_ITERATOR__ ProxyVector<value_t, thread_safe>::end()
+__PXV_ITERATOR__ ProxyVector<value_t, thread_safe, allocator_t>::end()
 {
     return iterator(m_data + m_size);
 }
@@ -1110,8 +1114,8 @@ __PXV_ITERATOR__ ProxyVector<value_t, thread_safe>::end()
     \result A constant iterator referring to the past-the-end element in the
     container.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe>::end() const
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe, allocator_t>::end() const
 {
     return const_iterator(m_data + m_size);
 }
@@ -1121,8 +1125,8 @@ __PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe>::end() const
 
     \result A constant iterator pointing to the first element in the container.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe>::cbegin()
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe, allocator_t>::cbegin()
 {
     return const_iterator(m_data);
 }
@@ -1135,8 +1139,8 @@ git gui
     \result A constant iterator referring to the past-the-end element in the
     container.
 */
-template<typename value_t, bool thread_safe>
-__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe>::cend()
+template<typename value_t, bool thread_safe, typename allocator_t>
+__PXV_CONST_ITERATOR__ ProxyVector<value_t, thread_safe, allocator_t>::cend()
 {
     return const_iterator(m_data + m_size);
 }
@@ -68,6 +68,8 @@ public:
 
     virtual bool isVolatile() const = 0;
 
+    virtual std::size_t getMemoryUsage() const = 0;
+
     virtual void dump(std::ostream &stream) = 0;
     virtual void restore(std::istream &stream) = 0;
 
@@ -294,6 +296,8 @@ public:
 
     bool isVolatile() const override;
 
+    std::size_t getMemoryUsage() const override;
+
     void dump(std::ostream &stream) override;
     void restore(std::istream &stream) override;
 
@@ -346,6 +350,8 @@ public:
 
     bool isVolatile() const override;
 
+    std::size_t getMemoryUsage() const override;
+
     void dump(std::ostream &stream) override;
     void restore(std::istream &stream) override;
 
@@ -400,6 +406,8 @@ public:
 
     bool isVolatile() const override;
 
+    std::size_t getMemoryUsage() const override;
+
     void dump(std::ostream &stream) override;
     void restore(std::istream &stream) override;
 
@@ -451,9 +459,16 @@ public:
 
     bool isVolatile() const override;
 
+    std::size_t getMemoryUsage() const override;
+
     void dump(std::ostream &stream) override;
     void restore(std::istream &stream) override;
 
+#if BITPIT_ENABLE_MPI
+    void writeBuffer(const std::vector<key_t> &keys, SendBuffer &buffer) const override;
+    void readBuffer(const std::vector<key_t> &keys, RecvBuffer &buffer) override;
+#endif
+
 protected:
     key_t getKey(const const_iterator &itr) const override;
     reference getValue(const iterator &itr) const override;
@@ -662,6 +677,8 @@ public:
 
     void clear();
 
+    std::size_t getMemoryUsage() const;
+
 protected:
     Caches m_caches; //!< Caches owned by the collection
 
@@ -542,6 +542,19 @@ bool LevelSetContainerCache<key_t, std::unordered_map<key_t, value_t>>::isVolati
     return false;
 }
 
+/*!
+ * Evaluate the memory used by the cache.
+ *
+ * The memory occupied by the cache object itself is not included.
+ *
+ * \result The memory, expressed in bytes, used by the cache.
+ */
+template<typename key_t, typename value_t>
+std::size_t LevelSetContainerCache<key_t, std::unordered_map<key_t, value_t>>::getMemoryUsage() const
+{
+    return utils::getMemoryUsage(Base::m_container);
+}
+
 /*!
  * Write the cache to the specified stream.
  *
@@ -823,6 +836,19 @@ bool LevelSetContainerCache<key_t, std::vector<value_t>>::isVolatile() const
     return false;
 }
 
+/*!
+ * Evaluate the memory used by the cache.
+ *
+ * The memory occupied by the cache object itself is not included.
+ *
+ * \result The memory, expressed in bytes, used by the cache.
+ */
+template<typename key_t, typename value_t>
+std::size_t LevelSetContainerCache<key_t, std::vector<value_t>>::getMemoryUsage() const
+{
+    return utils::getMemoryUsage(Base::m_container) + utils::getMemoryUsage(m_isCached);
+}
+
 /*!
  * Write the cache to the specified stream.
  *
@@ -1064,6 +1090,19 @@ bool LevelSetContainerCache<key_t, PiercedVector<value_t, key_t>>::isVolatile()
     return false;
 }
 
+/*!
+ * Evaluate the memory used by the cache.
+ *
+ * The memory occupied by the cache object itself is not included.
+ *
+ * \result The memory, expressed in bytes, used by the cache.
+ */
+template<typename key_t, typename value_t>
+std::size_t LevelSetContainerCache<key_t, PiercedVector<value_t, key_t>>::getMemoryUsage() const
+{
+    return Base::m_container.getMemoryUsage();
+}
+
 /*!
  * Write the cache to the specified stream.
  *
@@ -1327,6 +1366,19 @@ bool LevelSetContainerCache<key_t, PiercedStorage<value_t, key_t>>::isVolatile()
     return (Base::m_container.getSyncMode() != PiercedSyncMaster::SyncMode::SYNC_MODE_DISABLED);
 }
 
+/*!
+ * Evaluate the memory used by the cache.
+ *
+ * The memory occupied by the cache object itself is not included.
+ *
+ * \result The memory, expressed in bytes, used by the cache.
+ */
+template<typename key_t, typename value_t>
+std::size_t LevelSetContainerCache<key_t, PiercedStorage<value_t, key_t>>::getMemoryUsage() const
+{
+    return Base::m_container.getMemoryUsage() + m_isCached.getMemoryUsage();
+}
+
 /*!
  * Write the cache to the specified stream.
  *
@@ -1351,6 +1403,68 @@ void LevelSetContainerCache<key_t, PiercedStorage<value_t, key_t>>::restore(std:
     m_isCached.restore(stream);
 }
 
+#if BITPIT_ENABLE_MPI
+/*!
+ * Write the specified entries to the given buffer.
+ *
+ * The flags that tell which entries are cached are written first, one byte for each key, and
+ * they are followed by the values of the cached entries. Values are packed directly from the
+ * storage into the buffer, hence the buffer should be read using the same type of cache.
+ *
+ * \param[in] keys is the list of keys whose data need to be send
+ * \param[in,out] buffer is the buffer to write to
+ */
+template<typename key_t, typename value_t>
+void LevelSetContainerCache<key_t, PiercedStorage<value_t, key_t>>::writeBuffer(const std::vector<key_t> &keys, SendBuffer &buffer) const
+{
+    std::size_t nKeys = keys.size();
+
+    std::vector<std::size_t> cachedRawIds;
+    cachedRawIds.reserve(nKeys);
+
+    char *cachedFlags = buffer.writeInPlace(nKeys);
+    for (std::size_t n = 0; n < nKeys; ++n) {
+        std::size_t rawId = Base::m_container.find(keys[n]).getRawIndex();
+        if (m_isCached.rawAt(rawId)) {
+            cachedFlags[n] = 1;
+            cachedRawIds.push_back(rawId);
+        } else {
+            cachedFlags[n] = 0;
+        }
+    }
+
+    buffer.write(Base::m_container, cachedRawIds.size(), cachedRawIds.data());
+}
+
+/*!
+ * Read the specified entries from the given buffer.
+ *
+ * The buffer should have been written by the same type of cache.
+ *
+ * \param keys is the list of keys whose data need to be received
+ * @param[in,out] buffer is the buffer to read from
+ */
+template<typename key_t, typename value_t>
+void LevelSetContainerCache<key_t, PiercedStorage<value_t, key_t>>::readBuffer(const std::vector<key_t> &keys, RecvBuffer &buffer)
+{
+    std::size_t nKeys = keys.size();
+
+    std::vector<std::size_t> cachedRawIds;
+    cachedRawIds.reserve(nKeys);
+
+    const char *cachedFlags = buffer.readInPlace(nKeys);
+    for (std::size_t n = 0; n < nKeys; ++n) {
+        if (cachedFlags[n] == 1) {
+            std::size_t rawId = Base::m_container.find(keys[n]).getRawIndex();
+            m_isCached.rawAt(rawId) = true;
+            cachedRawIds.push_back(rawId);
+        }
+    }
+
+    buffer.read(Base::m_container, cachedRawIds.size(), cachedRawIds.data());
+}
+#endif
+
 /*!
  * Get the key associated to the iterator.
  *
@@ -1832,6 +1946,26 @@ void LevelSetCacheCollection<key_t>::clear()
     m_caches.shrink_to_fit();
 }
 
+/*!
+ * Evaluate the memory used by the caches of the collection.
+ *
+ * Only the caches that have already been created are taken into account.
+ *
+ * \result The memory, expressed in bytes, used by the caches of the collection.
+ */
+template<typename key_t>
+std::size_t LevelSetCacheCollection<key_t>::getMemoryUsage() const
+{
+    std::size_t memoryUsage = utils::getMemoryUsage(m_caches);
+    for (const Item &item : m_caches) {
+        if (item.hasCache()) {
+            memoryUsage += item.getCache(false)->getMemoryUsage();
+        }
+    }
+
+    return memoryUsage;
+}
+
 /*!
  * Get a reference to the cache item with the specified index.
  *
@@ -1063,6 +1063,22 @@ unsigned int Cell::getBinarySize() const
     return (Element::getBinarySize() + m_interfaces.getBinarySize() + m_adjacencies.getBinarySize());
 }
 
+/*!
+	Evaluates the memory dynamically allocated by the cell.
+
+	The memory includes the connectivity owned by the cell and the storage
+	owned by its adjacencies and interfaces. Data stored in the arenas of
+	the patch and the memory occupied by the cell object itself are not
+	included.
+
+	\result The memory, expressed in bytes, dynamically allocated by the
+	cell.
+*/
+std::size_t Cell::getMemoryUsage() const
+{
+	return (Element::getMemoryUsage() + m_interfaces.getMemoryUsage() + m_adjacencies.getMemoryUsage());
+}
+
 // Explicit instantiation of the Cell containers
 template class PiercedVector<Cell>;
 
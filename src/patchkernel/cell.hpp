@@ -30,6 +30,7 @@
 #include "bitpit_containers.hpp"
 
 #include "element.hpp"
+#include "element_arena.hpp"
 
 namespace bitpit {
 
@@ -105,13 +106,14 @@ public:
 	void display(std::ostream &out, unsigned short int indent) const;
 
 	unsigned int getBinarySize() const;
+	std::size_t getMemoryUsage() const;
 
 protected:
 	void setInterior(bool interior);
 
 private:
-	bitpit::FlatVector2D<long> m_interfaces;
-	bitpit::FlatVector2D<long> m_adjacencies;
+	ArenaFlatVector2D m_interfaces;
+	ArenaFlatVector2D m_adjacencies;
 
 	bool m_interior;
 
@@ -31,6 +31,7 @@
 #include "bitpit_operators.hpp"
 
 #include "element.hpp"
+#include "element_arena.hpp"
 
 namespace bitpit {
 
@@ -60,7 +61,7 @@ IBinaryStream& operator>>(IBinaryStream &buffer, Element &element)
 	}
 
 	// Set connectivity
-	buffer.read(reinterpret_cast<char *>(element.m_connect.get()), connectSize * sizeof(long));
+	buffer.read(reinterpret_cast<char *>(element.getConnect()), connectSize * sizeof(long));
 
 	// Set PID
 	int pid;
@@ -88,7 +89,7 @@ OBinaryStream& operator<<(OBinaryStream  &buffer, const Element &element)
 		buffer << connectSize;
 	}
 
-	buffer.write(reinterpret_cast<const char *>(element.m_connect.get()), connectSize * sizeof(long));
+	buffer.write(reinterpret_cast<const char *>(element.getConnect()), connectSize * sizeof(long));
 
 	buffer << element.getPID();
 
@@ -323,6 +324,7 @@ const long Element::NULL_ID = std::numeric_limits<long>::min();
 	Default constructor.
 */
 Element::Element()
+	: m_connectArena(nullptr), m_connectArenaOffset(0)
 {
 	_initialize(NULL_ID, ElementType::UNDEFINED);
 }
@@ -336,6 +338,7 @@ Element::Element()
 	if the element is not associated to a reference element
 */
 Element::Element(long id, ElementType type, int connectSize)
+	: m_connectArena(nullptr), m_connectArenaOffset(0)
 {
 	_initialize(id, type, connectSize);
 }
@@ -349,6 +352,7 @@ Element::Element(long id, ElementType type, int connectSize)
 	the connectivity of the element
 */
 Element::Element(long id, ElementType type, std::unique_ptr<long[]> &&connectStorage)
+	: m_connectArena(nullptr), m_connectArenaOffset(0)
 {
 	_initialize(id, type, std::move(connectStorage));
 }
@@ -359,9 +363,12 @@ Element::Element(long id, ElementType type, std::unique_ptr<long[]> &&connectSto
 	\param other is another element whose content is copied in this element
 */
 Element::Element(const Element &other)
+	: m_connectArena(nullptr), m_connectArenaOffset(0)
 {
+	const long *otherConnect = other.getConnect();
+
 	int connectSize;
-	if (other.m_connect) {
+	if (otherConnect) {
 		connectSize = other.getConnectSize();
 	} else {
 		connectSize = 0;
@@ -371,8 +378,8 @@ Element::Element(const Element &other)
 
 	m_pid = other.m_pid;
 
-	if (other.m_connect) {
-		std::copy(other.m_connect.get(), other.m_connect.get() + connectSize, m_connect.get());
+	if (otherConnect) {
+		std::copy(otherConnect, otherConnect + connectSize, getConnect());
 	}
 }
 
@@ -402,6 +409,8 @@ void Element::swap(Element &other) noexcept
 	std::swap(other.m_type, m_type);
 	std::swap(other.m_pid, m_pid);
 	std::swap(other.m_connect, m_connect);
+	std::swap(other.m_connectArena, m_connectArena);
+	std::swap(other.m_connectArenaOffset, m_connectArenaOffset);
 }
 
 /*!
@@ -591,6 +600,31 @@ int Element::getPID() const
 void Element::setConnect(std::unique_ptr<long[]> &&connect)
 {
 	m_connect = std::move(connect);
+	m_connectArena = nullptr;
+}
+
+/*!
+	Sets a vertex connectivity stored in an arena.
+
+	The element references its connectivity through an offset inside the
+	arena, the storage of the connectivity is owned by the arena and the
+	connectivity owned by the element, if any, is released. It's up to the
+	caller to guarantee that the arena remains valid during the lifetime
+	of the element (or until a new connectivity is set). Arenas are used by
+	the patches to store the connectivity of their elements in a contiguous
+	memory area.
+
+	When the element is copied, the copy will own a new storage that
+	contains a copy of the connectivity.
+
+	\param arena is the arena that contains the connectivity
+	\param offset is the offset of the connectivity inside the arena
+*/
+void Element::setArenaConnect(ElementArena *arena, std::size_t offset)
+{
+	m_connect.reset(nullptr);
+	m_connectArena = arena;
+	m_connectArenaOffset = offset;
 }
 
 /*!
@@ -599,6 +633,18 @@ void Element::setConnect(std::unique_ptr<long[]> &&connect)
 void Element::unsetConnect()
 {
 	m_connect.reset(nullptr);
+	m_connectArena = nullptr;
+}
+
+/*!
+	Checks if the vertex connectivity of the element is stored in an arena.
+
+	\result Returns true if the vertex connectivity of the element is
+	stored in an arena, false otherwise.
+*/
+bool Element::hasArenaConnect() const
+{
+	return (m_connectArena != nullptr);
 }
 
 /*!
@@ -608,6 +654,10 @@ void Element::unsetConnect()
 */
 const long * Element::getConnect() const
 {
+	if (m_connectArena) {
+		return m_connectArena->data(m_connectArenaOffset);
+	}
+
 	return m_connect.get();
 }
 
@@ -618,6 +668,10 @@ const long * Element::getConnect() const
 */
 long * Element::getConnect()
 {
+	if (m_connectArena) {
+		return m_connectArena->data(m_connectArenaOffset);
+	}
+
 	return m_connect.get();
 }
 
@@ -2151,6 +2205,25 @@ unsigned int Element::getBinarySize() const
 	return binarySize;
 }
 
+/*!
+	Evaluates the memory dynamically allocated by the element.
+
+	The memory occupied by the element object itself is not included. If
+	the connectivity is stored in an arena, its memory is owned by the
+	arena and is not included.
+
+	\result The memory, expressed in bytes, dynamically allocated by the
+	element.
+*/
+std::size_t Element::getMemoryUsage() const
+{
+	if (!m_connect) {
+		return 0;
+	}
+
+	return getConnectSize() * sizeof(long);
+}
+
 // Explicit instantiation of the Element containers
 template class PiercedVector<Element>;
 
@@ -38,6 +38,8 @@
 
 namespace bitpit {
 
+class ElementArena;
+
 class Element;
 
 IBinaryStream & operator>>(IBinaryStream &buf, Element& element);
@@ -117,7 +119,9 @@ public:
 	bool isThreeDimensional() const;
 	
 	void setConnect(std::unique_ptr<long[]> &&connect);
+	void setArenaConnect(ElementArena *arena, std::size_t offset);
 	void unsetConnect();
+	bool hasArenaConnect() const;
 	int getConnectSize() const;
 	const long * getConnect() const;
 	long * getConnect();
@@ -168,6 +172,7 @@ public:
 	double evalPointDistance(const std::array<double, 3> &point, const std::array<double, 3> *coordinates) const;
 
 	unsigned int getBinarySize() const;
+	std::size_t getMemoryUsage() const;
 
 private:
 	class Tesselation {
@@ -209,6 +214,9 @@ private:
 
 	std::unique_ptr<long[]> m_connect;
 
+	ElementArena *m_connectArena;
+	std::size_t m_connectArenaOffset;
+
 	void _initialize(long id, ElementType type = ElementType::UNDEFINED, int connectSize = 0);
 	void _initialize(long id, ElementType type, std::unique_ptr<long[]> &&connectStorage);
 
@@ -0,0 +1,770 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cassert>
+
+#include "element_arena.hpp"
+
+namespace bitpit {
+
+/*!
+	\class ElementArena
+	\ingroup patchelements
+
+	\brief The ElementArena class defines a contiguous storage for element
+	data.
+
+	An arena stores the data of many elements (for example, their
+	connectivity) in a single contiguous memory area. Elements reference
+	their data through an offset inside the arena, hence the arena can
+	be reallocated without invalidating the references of the elements.
+	Pointers to the values of the arena are instead invalidated when the
+	arena is reallocated.
+
+	Data is appended at the end of the arena. Data that is no longer used
+	is not removed from the arena, the owner of the arena is responsible
+	for compacting it. The arena also keeps track of the amount of data
+	that has not been stored in the arena because there was no room for
+	it (pending data), this information can be used by the owner to
+	decide when to compact the arena.
+*/
+
+/*!
+	Default constructor.
+*/
+ElementArena::ElementArena()
+	: m_nPendingValues(0)
+{
+}
+
+/*!
+	Gets the number of values stored in the arena.
+
+	\result The number of values stored in the arena.
+*/
+std::size_t ElementArena::size() const
+{
+	return m_values.size();
+}
+
+/*!
+	Gets the number of values the arena can store without being
+	reallocated.
+
+	\result The number of values the arena can store without being
+	reallocated.
+*/
+std::size_t ElementArena::capacity() const
+{
+	return m_values.capacity();
+}
+
+/*!
+	Checks if the specified number of values can be appended to the arena
+	without reallocating it.
+
+	\param nValues is the number of values
+	\result Returns true if the specified number of values can be appended
+	to the arena without reallocating it, false otherwise.
+*/
+bool ElementArena::hasRoom(std::size_t nValues) const
+{
+	return (m_values.capacity() - m_values.size() >= nValues);
+}
+
+/*!
+	Requests that the arena capacity be at least enough to contain the
+	specified number of values.
+
+	\param nValues is the number of values
+*/
+void ElementArena::reserve(std::size_t nValues)
+{
+	m_values.reserve(nValues);
+}
+
+/*!
+	Gets the number of values that are waiting to be stored in the arena.
+
+	\result The number of values that are waiting to be stored in the arena.
+*/
+std::size_t ElementArena::getPendingSize() const
+{
+	return m_nPendingValues;
+}
+
+/*!
+	Adds the specified number of values to the values that are waiting to
+	be stored in the arena.
+
+	\param nValues is the number of values
+*/
+void ElementArena::addPending(std::size_t nValues)
+{
+	m_nPendingValues += nValues;
+}
+
+/*!
+	Gets a pointer to the values stored at the specified offset.
+
+	\param offset is the offset
+	\result A pointer to the values stored at the specified offset.
+*/
+long * ElementArena::data(std::size_t offset)
+{
+	assert(offset <= m_values.size());
+
+	return (m_values.data() + offset);
+}
+
+/*!
+	Gets a constant pointer to the values stored at the specified offset.
+
+	\param offset is the offset
+	\result A constant pointer to the values stored at the specified offset.
+*/
+const long * ElementArena::data(std::size_t offset) const
+{
+	assert(offset <= m_values.size());
+
+	return (m_values.data() + offset);
+}
+
+/*!
+	Appends the specified number of values to the arena.
+
+	The arena will be reallocated if it doesn't have enough room for the
+	new values.
+
+	\param nValues is the number of values
+	\result The offset of the appended values.
+*/
+std::size_t ElementArena::allocate(std::size_t nValues)
+{
+	std::size_t offset = m_values.size();
+	m_values.resize(offset + nValues);
+
+	return offset;
+}
+
+/*!
+	Appends a copy of the specified values to the arena.
+
+	The arena will be reallocated if it doesn't have enough room for the
+	new values.
+
+	\param values are the values
+	\param nValues is the number of values
+	\result The offset of the appended values.
+*/
+std::size_t ElementArena::store(const long *values, std::size_t nValues)
+{
+	std::size_t offset = allocate(nValues);
+	std::copy(values, values + nValues, m_values.data() + offset);
+
+	return offset;
+}
+
+/*!
+	Replaces the contents of the arena.
+
+	Pending values are assumed to be part of the new contents.
+
+	\param values are the new contents of the arena
+*/
+void ElementArena::assign(std::vector<long> &&values)
+{
+	m_values.swap(values);
+	m_nPendingValues = 0;
+}
+
+/*!
+	Removes all the values from the arena.
+
+	\param release if it's true the memory hold by the arena will be
+	released, otherwise the arena will be cleared but its memory will
+	not be released
+*/
+void ElementArena::clear(bool release)
+{
+	if (release) {
+		std::vector<long>().swap(m_values);
+	} else {
+		m_values.clear();
+	}
+
+	m_nPendingValues = 0;
+}
+
+/*!
+	Evaluates the memory allocated by the arena.
+
+	\result The memory, expressed in bytes, allocated by the arena.
+*/
+std::size_t ElementArena::getMemoryUsage() const
+{
+	return (m_values.capacity() * sizeof(long));
+}
+
+/*!
+	Input stream operator for class ArenaFlatVector2D.
+
+	The contents are always read into the storage owned by the vector.
+
+	\param[in] buffer is the input stream
+	\param[in] vector is the vector to be streamed
+	\result Returns the same input stream received in input.
+*/
+IBinaryStream& operator>>(IBinaryStream &buffer, ArenaFlatVector2D &vector)
+{
+	vector.m_arena = nullptr;
+	buffer >> vector.m_storage;
+
+	return buffer;
+}
+
+/*!
+	Output stream operator for class ArenaFlatVector2D.
+
+	The contents are written using the same format of FlatVector2D.
+
+	\param[in] buffer is the output stream
+	\param[in] vector is the vector to be streamed
+	\result Returns the same output stream received in input.
+*/
+OBinaryStream& operator<<(OBinaryStream &buffer, const ArenaFlatVector2D &vector)
+{
+	if (vector.isStoredInArena()) {
+		ArenaFlatVector2D ownedVector(vector);
+		buffer << ownedVector.m_storage;
+	} else {
+		buffer << vector.m_storage;
+	}
+
+	return buffer;
+}
+
+/*!
+	\class ArenaFlatVector2D
+	\ingroup patchelements
+
+	\brief The ArenaFlatVector2D class defines a two-dimensional vector of
+	ids whose contents may be stored in an element arena.
+
+	The contents of the vector are either stored in a FlatVector2D owned
+	by the vector or in a record of an element arena. A record contains
+	the number of sub-vectors, the offsets of the sub-vectors and the
+	items of the sub-vectors.
+
+	Operations that don't change the size of the vector (e.g., reading the
+	items or setting the value of an existing item) work directly on the
+	record. Operations that change the size of the vector move the contents
+	of the record into the owned storage before altering them, the record
+	becomes unused and will be removed when the arena is compacted.
+
+	Copies of the vector always own their contents.
+*/
+
+/*!
+	Creates a new vector.
+
+	\param storage is the storage that will be owned by the vector
+*/
+ArenaFlatVector2D::ArenaFlatVector2D(FlatVector2D<long> &&storage)
+	: m_storage(std::move(storage)),
+	  m_arena(nullptr), m_arenaOffset(0)
+{
+}
+
+/*!
+	Copy constructor.
+
+	The copy will own a storage that contains a copy of the contents of
+	the other vector.
+
+	\param other is another vector whose content is copied in this vector
+*/
+ArenaFlatVector2D::ArenaFlatVector2D(const ArenaFlatVector2D &other)
+	: m_storage(other.m_storage),
+	  m_arena(other.m_arena), m_arenaOffset(other.m_arenaOffset)
+{
+	releaseArena();
+}
+
+/*!
+	Move constructor.
+
+	\param other is another vector whose content is moved in this vector
+*/
+ArenaFlatVector2D::ArenaFlatVector2D(ArenaFlatVector2D &&other) noexcept
+	: m_storage(std::move(other.m_storage)),
+	  m_arena(other.m_arena), m_arenaOffset(other.m_arenaOffset)
+{
+	other.m_arena = nullptr;
+}
+
+/*!
+	Copy-assignment operator.
+
+	\param other is another vector whose content is copied in this vector
+*/
+ArenaFlatVector2D & ArenaFlatVector2D::operator=(const ArenaFlatVector2D &other)
+{
+	ArenaFlatVector2D tmp(other);
+	swap(tmp);
+
+	return *this;
+}
+
+/*!
+	Move-assignment operator.
+
+	\param other is another vector whose content is moved in this vector
+*/
+ArenaFlatVector2D & ArenaFlatVector2D::operator=(ArenaFlatVector2D &&other) noexcept
+{
+	m_storage     = std::move(other.m_storage);
+	m_arena       = other.m_arena;
+	m_arenaOffset = other.m_arenaOffset;
+
+	other.m_arena = nullptr;
+
+	return *this;
+}
+
+/*!
+	Exchanges the content of the vector by the content the specified other
+	vector.
+
+	\param other is another vector whose content is swapped with that of
+	this vector
+*/
+void ArenaFlatVector2D::swap(ArenaFlatVector2D &other) noexcept
+{
+	m_storage.swap(other.m_storage);
+	std::swap(m_arena, other.m_arena);
+	std::swap(m_arenaOffset, other.m_arenaOffset);
+}
+
+/*!
+	Exchanges the content of the vector by the content the specified
+	FlatVector2D.
+
+	\param other is a FlatVector2D whose content is swapped with that of
+	this vector
+*/
+void ArenaFlatVector2D::swap(FlatVector2D<long> &other)
+{
+	releaseArena();
+	m_storage.swap(other);
+}
+
+/*!
+	Initializes the vector.
+
+	\param nVectors is the number of vectors
+	\param size is the size of the vectors
+	\param value is the value that will be use to initialize the items of
+	the vectors
+*/
+void ArenaFlatVector2D::initialize(std::size_t nVectors, std::size_t size, long value)
+{
+	m_arena = nullptr;
+	m_storage.initialize(nVectors, size, value);
+}
+
+/*!
+	Initializes the vector.
+
+	\param vector2D is the vector that will be used to initialize the
+	vector
+*/
+void ArenaFlatVector2D::initialize(const std::vector<std::vector<long>> &vector2D)
+{
+	m_arena = nullptr;
+	m_storage.initialize(vector2D);
+}
+
+/*!
+	Destroys the vector.
+
+	After calling this function the vector will be non-functional until it
+	is re-initialized.
+*/
+void ArenaFlatVector2D::destroy()
+{
+	m_arena = nullptr;
+	m_storage.destroy();
+}
+
+/*!
+	Checks if the vector contains no sub-vectors.
+
+	\result Returns true if the vector contains no sub-vectors, false
+	otherwise.
+*/
+bool ArenaFlatVector2D::empty() const
+{
+	return (size() == 0);
+}
+
+/*!
+	Gets the number of sub-vectors.
+
+	\result The number of sub-vectors.
+*/
+std::size_t ArenaFlatVector2D::size() const
+{
+	if (m_arena) {
+		return static_cast<std::size_t>(getArenaRecord()[0]);
+	}
+
+	return m_storage.size();
+}
+
+/*!
+	Sets the value of the specified item.
+
+	\param i is the index of the sub-vector
+	\param j is the index of the item inside the sub-vector
+	\param value is the value that will be set
+*/
+void ArenaFlatVector2D::setItem(std::size_t i, std::size_t j, long value)
+{
+	if (m_arena) {
+		*(get(i) + j) = value;
+		return;
+	}
+
+	m_storage.setItem(i, j, value);
+}
+
+/*!
+	Appends an item to the specified sub-vector.
+
+	\param i is the index of the sub-vector
+	\param value is the value that will be appended
+*/
+void ArenaFlatVector2D::pushBackItem(std::size_t i, long value)
+{
+	releaseArena();
+	m_storage.pushBackItem(i, value);
+}
+
+/*!
+	Erases the specified item.
+
+	\param i is the index of the sub-vector
+	\param j is the index of the item inside the sub-vector
+*/
+void ArenaFlatVector2D::eraseItem(std::size_t i, std::size_t j)
+{
+	releaseArena();
+	m_storage.eraseItem(i, j);
+}
+
+/*!
+	Gets the total number of items.
+
+	\result The total number of items.
+*/
+std::size_t ArenaFlatVector2D::getItemCount() const
+{
+	if (m_arena) {
+		const long *record = getArenaRecord();
+		std::size_t nVectors = static_cast<std::size_t>(record[0]);
+
+		return static_cast<std::size_t>(record[1 + nVectors]);
+	}
+
+	return m_storage.getItemCount();
+}
+
+/*!
+	Gets the number of items of the specified sub-vector.
+
+	\param i is the index of the sub-vector
+	\result The number of items of the specified sub-vector.
+*/
+std::size_t ArenaFlatVector2D::getItemCount(std::size_t i) const
+{
+	if (m_arena) {
+		const long *record = getArenaRecord();
+
+		return static_cast<std::size_t>(record[2 + i] - record[1 + i]);
+	}
+
+	return m_storage.getItemCount(i);
+}
+
+/*!
+	Gets the value of the specified item.
+
+	\param i is the index of the sub-vector
+	\param j is the index of the item inside the sub-vector
+	\result The value of the specified item.
+*/
+long ArenaFlatVector2D::getItem(std::size_t i, std::size_t j) const
+{
+	if (m_arena) {
+		return *(get(i) + j);
+	}
+
+	return m_storage.getItem(i, j);
+}
+
+/*!
+	Gets a constant pointer to the first item of the specified sub-vector.
+
+	\param i is the index of the sub-vector
+	\result A constant pointer to the first item of the specified
+	sub-vector.
+*/
+const long * ArenaFlatVector2D::get(std::size_t i) const
+{
+	if (m_arena) {
+		const long *record = getArenaRecord();
+		std::size_t nVectors = static_cast<std::size_t>(record[0]);
+		assert(i < nVectors);
+
+		return (record + 2 + nVectors + record[1 + i]);
+	}
+
+	return m_storage.get(i);
+}
+
+/*!
+	Gets a pointer to the first item of the specified sub-vector.
+
+	\param i is the index of the sub-vector
+	\result A pointer to the first item of the specified sub-vector.
+*/
+long * ArenaFlatVector2D::get(std::size_t i)
+{
+	if (m_arena) {
+		long *record = getArenaRecord();
+		std::size_t nVectors = static_cast<std::size_t>(record[0]);
+		assert(i < nVectors);
+
+		return (record + 2 + nVectors + record[1 + i]);
+	}
+
+	return m_storage.get(i);
+}
+
+/*!
+	Checks if the contents of the vector are stored in an arena.
+
+	\result Returns true if the contents of the vector are stored in an
+	arena, false otherwise.
+*/
+bool ArenaFlatVector2D::isStoredInArena() const
+{
+	return (m_arena != nullptr);
+}
+
+/*!
+	Gets the size of the arena record needed to store the contents of the
+	vector.
+
+	Vectors that are not initialized or that contain no sub-vectors are
+	never stored in an arena, for those vectors the size of the record is
+	zero.
+
+	\result The size of the arena record needed to store the contents of
+	the vector.
+*/
+std::size_t ArenaFlatVector2D::getArenaSize() const
+{
+	if (!m_arena && !m_storage.isInitialized()) {
+		return 0;
+	}
+
+	std::size_t nVectors = size();
+	if (nVectors == 0) {
+		return 0;
+	}
+
+	return (2 + nVectors + getItemCount());
+}
+
+/*!
+	Writes the contents of the vector into the specified arena record.
+
+	The record should be large enough to contain the contents of the vector
+	(see getArenaSize).
+
+	\param[out] record is the record
+*/
+void ArenaFlatVector2D::writeArenaRecord(long *record) const
+{
+	std::size_t nVectors = size();
+	std::size_t nItems   = getItemCount();
+
+	if (m_arena) {
+		const long *currentRecord = getArenaRecord();
+		std::copy(currentRecord, currentRecord + 2 + nVectors + nItems, record);
+		return;
+	}
+
+	record[0] = static_cast<long>(nVectors);
+
+	const std::size_t *indices = m_storage.indices();
+	for (std::size_t i = 0; i <= nVectors; ++i) {
+		record[1 + i] = static_cast<long>(indices[i]);
+	}
+
+	const long *items = m_storage.data();
+	std::copy(items, items + nItems, record + 2 + nVectors);
+}
+
+/*!
+	Sets the arena record that contains the contents of the vector.
+
+	The storage owned by the vector is released. The record should already
+	contain the contents of the vector (see writeArenaRecord).
+
+	\param arena is the arena
+	\param offset is the offset of the record inside the arena
+*/
+void ArenaFlatVector2D::setArena(ElementArena *arena, std::size_t offset)
+{
+	m_arena       = arena;
+	m_arenaOffset = offset;
+
+	m_storage.destroy();
+}
+
+/*!
+	Stores the contents of the vector in the specified arena.
+
+	If the arena has enough room, the contents are appended at the end of
+	the arena. Otherwise, the vector keeps its own storage and the size of
+	its contents is added to the pending values of the arena. The arena is
+	never reallocated by this function.
+
+	\param arena is the arena
+*/
+void ArenaFlatVector2D::storeInArena(ElementArena *arena)
+{
+	if (m_arena == arena) {
+		return;
+	}
+
+	std::size_t recordSize = getArenaSize();
+	if (recordSize == 0) {
+		return;
+	}
+
+	if (!arena->hasRoom(recordSize)) {
+		arena->addPending(recordSize);
+		return;
+	}
+
+	std::size_t offset = arena->allocate(recordSize);
+	writeArenaRecord(arena->data(offset));
+	setArena(arena, offset);
+}
+
+/*!
+	Moves the contents of the vector out of the arena.
+
+	After calling this function the vector will own a storage that contains
+	its contents.
+*/
+void ArenaFlatVector2D::releaseArena()
+{
+	if (!m_arena) {
+		return;
+	}
+
+	const long *record = getArenaRecord();
+	std::size_t nVectors = static_cast<std::size_t>(record[0]);
+
+	std::vector<std::size_t> sizes(nVectors);
+	for (std::size_t i = 0; i < nVectors; ++i) {
+		sizes[i] = static_cast<std::size_t>(record[2 + i] - record[1 + i]);
+	}
+
+	const long *items = record + 2 + nVectors;
+	std::size_t nItems = static_cast<std::size_t>(record[1 + nVectors]);
+
+	m_storage.initialize(nVectors, sizes.data(), 0L);
+	std::copy(items, items + nItems, m_storage.data());
+	m_arena = nullptr;
+}
+
+/*!
+	Gets the size of the buffer required to communicate the vector.
+
+	\result Returns the buffer size (in bytes).
+*/
+std::size_t ArenaFlatVector2D::getBinarySize() const
+{
+	if (m_arena) {
+		return ((2 + size() + 1) * sizeof(std::size_t) + getItemCount() * sizeof(long));
+	}
+
+	return m_storage.getBinarySize();
+}
+
+/*!
+	Evaluates the memory allocated by the vector.
+
+	The memory of the arena record is owned by the arena and is not
+	included.
+
+	\result The memory, expressed in bytes, allocated by the vector.
+*/
+std::size_t ArenaFlatVector2D::getMemoryUsage() const
+{
+	return m_storage.getMemoryUsage();
+}
+
+/*!
+	Gets a constant pointer to the arena record of the vector.
+
+	\result A constant pointer to the arena record of the vector.
+*/
+const long * ArenaFlatVector2D::getArenaRecord() const
+{
+	assert(m_arena);
+
+	return m_arena->data(m_arenaOffset);
+}
+
+/*!
+	Gets a pointer to the arena record of the vector.
+
+	\result A pointer to the arena record of the vector.
+*/
+long * ArenaFlatVector2D::getArenaRecord()
+{
+	assert(m_arena);
+
+	return m_arena->data(m_arenaOffset);
+}
+
+}
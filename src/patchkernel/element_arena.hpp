@@ -0,0 +1,125 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_ELEMENT_ARENA_HPP__
+#define __BITPIT_ELEMENT_ARENA_HPP__
+
+#include <cstddef>
+#include <vector>
+
+#include "bitpit_containers.hpp"
+
+namespace bitpit {
+
+class ArenaFlatVector2D;
+
+IBinaryStream & operator>>(IBinaryStream &buffer, ArenaFlatVector2D &vector);
+OBinaryStream & operator<<(OBinaryStream &buffer, const ArenaFlatVector2D &vector);
+
+class ElementArena {
+
+public:
+	ElementArena();
+
+	std::size_t size() const;
+	std::size_t capacity() const;
+	bool hasRoom(std::size_t nValues) const;
+	void reserve(std::size_t nValues);
+
+	std::size_t getPendingSize() const;
+	void addPending(std::size_t nValues);
+
+	long * data(std::size_t offset);
+	const long * data(std::size_t offset) const;
+
+	std::size_t allocate(std::size_t nValues);
+	std::size_t store(const long *values, std::size_t nValues);
+	void assign(std::vector<long> &&values);
+	void clear(bool release = true);
+
+	std::size_t getMemoryUsage() const;
+
+private:
+	std::vector<long> m_values;
+	std::size_t m_nPendingValues;
+
+};
+
+class ArenaFlatVector2D {
+
+friend OBinaryStream& (operator<<) (OBinaryStream& buffer, const ArenaFlatVector2D& vector);
+friend IBinaryStream& (operator>>) (IBinaryStream& buffer, ArenaFlatVector2D& vector);
+
+public:
+	ArenaFlatVector2D(FlatVector2D<long> &&storage = FlatVector2D<long>(false));
+	ArenaFlatVector2D(const ArenaFlatVector2D &other);
+	ArenaFlatVector2D(ArenaFlatVector2D &&other) noexcept;
+
+	ArenaFlatVector2D & operator=(const ArenaFlatVector2D &other);
+	ArenaFlatVector2D & operator=(ArenaFlatVector2D &&other) noexcept;
+
+	void swap(ArenaFlatVector2D &other) noexcept;
+	void swap(FlatVector2D<long> &other);
+
+	void initialize(std::size_t nVectors, std::size_t size, long value = 0);
+	void initialize(const std::vector<std::vector<long>> &vector2D);
+	void destroy();
+
+	bool empty() const;
+	std::size_t size() const;
+
+	void setItem(std::size_t i, std::size_t j, long value);
+	void pushBackItem(std::size_t i, long value);
+	void eraseItem(std::size_t i, std::size_t j);
+
+	std::size_t getItemCount() const;
+	std::size_t getItemCount(std::size_t i) const;
+	long getItem(std::size_t i, std::size_t j) const;
+	const long * get(std::size_t i) const;
+	long * get(std::size_t i);
+
+	bool isStoredInArena() const;
+	std::size_t getArenaSize() const;
+	void writeArenaRecord(long *record) const;
+	void setArena(ElementArena *arena, std::size_t offset);
+	void storeInArena(ElementArena *arena);
+	void releaseArena();
+
+	std::size_t getBinarySize() const;
+	std::size_t getMemoryUsage() const;
+
+private:
+	FlatVector2D<long> m_storage;
+
+	ElementArena *m_arena;
+	std::size_t m_arenaOffset;
+
+	const long * getArenaRecord() const;
+	long * getArenaRecord();
+
+};
+
+}
+
+#endif
@@ -22,7 +22,12 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <numeric>
 #include <sstream>
+#include <tuple>
 #include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
@@ -243,6 +248,16 @@ PatchKernel::PatchKernel(const PatchKernel &other)
       m_boxMaxCounter(other.m_boxMaxCounter),
       m_adjacenciesBuildStrategy(other.m_adjacenciesBuildStrategy),
       m_interfacesBuildStrategy(other.m_interfacesBuildStrategy),
+      m_connectivityStorageMode(other.m_connectivityStorageMode),
+      m_geometryCacheEnabled(other.m_geometryCacheEnabled),
+      m_geometryCacheStale(other.m_geometryCacheStale),
+      m_geometryCacheUpToDate(other.m_geometryCacheUpToDate),
+      m_geometryCacheDirtyInterfaces(other.m_geometryCacheDirtyInterfaces),
+      m_vertexIncidenceEnabled(other.m_vertexIncidenceEnabled),
+      m_vertexIncidenceStale(other.m_vertexIncidenceStale),
+      m_vertexIncidenceCells(other.m_vertexIncidenceCells),
+      m_vertexIncidenceWaste(other.m_vertexIncidenceWaste),
+      m_pointLocatorRevision(other.m_pointLocatorRevision),
       m_adaptionMode(other.m_adaptionMode),
       m_adaptionStatus(other.m_adaptionStatus),
       m_dimension(other.m_dimension),
@@ -280,6 +295,38 @@ PatchKernel::PatchKernel(const PatchKernel &other)
 	importInterfaceIndexGenerator(other);
 	importCellIndexGenerator(other);
 
+	// Store the connectivity in the patch
+	//
+	// Copied elements own their connectivity, when connectivity is stored
+	// in the patch, the connectivity of the copied elements has to be moved
+	// into the arenas of this patch.
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		storeConnectivityInPatch();
+	}
+
+	// Copy the geometry cache
+	//
+	// Storages are bound to the containers of the patch they belong to,
+	// hence the cached values are copied into storages bound to the
+	// containers of this patch.
+	m_cellGeometryCache.reserve(other.m_cellGeometryCache.size());
+	for (const auto &field : other.m_cellGeometryCache) {
+		m_cellGeometryCache.emplace_back(new PiercedStorage<double, long>(*field, &m_cells, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+	}
+
+	m_interfaceGeometryCache.reserve(other.m_interfaceGeometryCache.size());
+	for (const auto &field : other.m_interfaceGeometryCache) {
+		m_interfaceGeometryCache.emplace_back(new PiercedStorage<double, long>(*field, &m_interfaces, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+	}
+
+	// Copy the vertex incidence
+	//
+	// The rows are bound to the vertices of the patch they belong to, hence
+	// they are copied into a storage bound to the vertices of this patch.
+	if (other.m_vertexIncidenceRows) {
+		m_vertexIncidenceRows = std::unique_ptr<PiercedStorage<std::size_t, long>>(new PiercedStorage<std::size_t, long>(*(other.m_vertexIncidenceRows), &m_vertices, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+	}
+
 	// Register the patch
 	patch::manager().registerPatch(this);
 
@@ -329,6 +376,20 @@ PatchKernel::PatchKernel(PatchKernel &&other)
       m_boxMaxCounter(std::move(other.m_boxMaxCounter)),
       m_adjacenciesBuildStrategy(std::move(other.m_adjacenciesBuildStrategy)),
       m_interfacesBuildStrategy(std::move(other.m_interfacesBuildStrategy)),
+      m_connectivityStorageMode(std::move(other.m_connectivityStorageMode)),
+      m_cellConnectArena(std::move(other.m_cellConnectArena)),
+      m_cellAdjacenciesArena(std::move(other.m_cellAdjacenciesArena)),
+      m_cellInterfacesArena(std::move(other.m_cellInterfacesArena)),
+      m_interfaceConnectArena(std::move(other.m_interfaceConnectArena)),
+      m_geometryCacheEnabled(std::move(other.m_geometryCacheEnabled)),
+      m_geometryCacheStale(std::move(other.m_geometryCacheStale)),
+      m_geometryCacheUpToDate(std::move(other.m_geometryCacheUpToDate)),
+      m_geometryCacheDirtyInterfaces(std::move(other.m_geometryCacheDirtyInterfaces)),
+      m_vertexIncidenceEnabled(std::move(other.m_vertexIncidenceEnabled)),
+      m_vertexIncidenceStale(std::move(other.m_vertexIncidenceStale)),
+      m_vertexIncidenceCells(std::move(other.m_vertexIncidenceCells)),
+      m_vertexIncidenceWaste(std::move(other.m_vertexIncidenceWaste)),
+      m_pointLocatorRevision(std::move(other.m_pointLocatorRevision)),
       m_adaptionMode(std::move(other.m_adaptionMode)),
       m_adaptionStatus(std::move(other.m_adaptionStatus)),
       m_id(std::move(other.m_id)),
@@ -369,6 +430,44 @@ PatchKernel::PatchKernel(PatchKernel &&other)
 	// pointer to the other object with pointer to this object.
 	replaceVTKStreamer(&other, this);
 
+	// Move the geometry cache
+	//
+	// Storages are bound to the containers of the patch they belong to,
+	// hence the cached values are moved into storages bound to the
+	// containers of this patch.
+	m_cellGeometryCache.reserve(other.m_cellGeometryCache.size());
+	for (auto &field : other.m_cellGeometryCache) {
+		m_cellGeometryCache.emplace_back(new PiercedStorage<double, long>(std::move(*field), &m_cells, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+	}
+	other.m_cellGeometryCache.clear();
+
+	m_interfaceGeometryCache.reserve(other.m_interfaceGeometryCache.size());
+	for (auto &field : other.m_interfaceGeometryCache) {
+		m_interfaceGeometryCache.emplace_back(new PiercedStorage<double, long>(std::move(*field), &m_interfaces, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+	}
+	other.m_interfaceGeometryCache.clear();
+
+	other.m_geometryCacheEnabled  = false;
+	other.m_geometryCacheStale    = false;
+	other.m_geometryCacheUpToDate = false;
+
+	// Arenas have been moved, the other patch stores the connectivity in
+	// its elements
+	other.m_connectivityStorageMode = CONNECTIVITY_STORAGE_ELEMENT;
+
+	// Move the vertex incidence
+	//
+	// The rows are bound to the vertices of the patch they belong to, hence
+	// they are moved into a storage bound to the vertices of this patch.
+	if (other.m_vertexIncidenceRows) {
+		m_vertexIncidenceRows = std::unique_ptr<PiercedStorage<std::size_t, long>>(new PiercedStorage<std::size_t, long>(std::move(*(other.m_vertexIncidenceRows)), &m_vertices, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+		other.m_vertexIncidenceRows.reset();
+	}
+
+	other.m_vertexIncidenceEnabled = false;
+	other.m_vertexIncidenceStale   = false;
+	other.m_vertexIncidenceWaste   = 0;
+
 #if BITPIT_ENABLE_MPI==1
 	// Handle the communication
 	std::swap(m_communicator, other.m_communicator);
@@ -382,6 +481,26 @@ PatchKernel::PatchKernel(PatchKernel &&other)
 */
 PatchKernel & PatchKernel::operator=(PatchKernel &&other)
 {
+	// Destroy the geometry caches
+	//
+	// Storages are bound to the containers of the patch they belong to and
+	// moving the containers would also move the bindings. The geometry
+	// cache of this patch will be re-created and re-evaluated.
+	std::size_t nCellGeometryCacheFields      = other.m_cellGeometryCache.size();
+	std::size_t nInterfaceGeometryCacheFields = other.m_interfaceGeometryCache.size();
+
+	m_cellGeometryCache.clear();
+	m_interfaceGeometryCache.clear();
+	other.m_cellGeometryCache.clear();
+	other.m_interfaceGeometryCache.clear();
+
+	// Destroy the vertex incidence
+	//
+	// The rows are bound to the vertices of the patch they belong to, the
+	// vertex incidence of this patch will be re-created and rebuilt.
+	m_vertexIncidenceRows.reset();
+	other.m_vertexIncidenceRows.reset();
+
 	VTKBaseStreamer::operator=(std::move(other));
 	m_vertices = std::move(other.m_vertices);
 	m_cells = std::move(other.m_cells);
@@ -418,6 +537,20 @@ PatchKernel & PatchKernel::operator=(PatchKernel &&other)
 	m_boxMaxCounter = std::move(other.m_boxMaxCounter);
 	m_adjacenciesBuildStrategy = std::move(other.m_adjacenciesBuildStrategy);
 	m_interfacesBuildStrategy = std::move(other.m_interfacesBuildStrategy);
+	m_connectivityStorageMode = std::move(other.m_connectivityStorageMode);
+	m_cellConnectArena = std::move(other.m_cellConnectArena);
+	m_cellAdjacenciesArena = std::move(other.m_cellAdjacenciesArena);
+	m_cellInterfacesArena = std::move(other.m_cellInterfacesArena);
+	m_interfaceConnectArena = std::move(other.m_interfaceConnectArena);
+	m_geometryCacheEnabled = std::move(other.m_geometryCacheEnabled);
+	m_geometryCacheStale = std::move(other.m_geometryCacheStale);
+	m_geometryCacheUpToDate = std::move(other.m_geometryCacheUpToDate);
+	m_geometryCacheDirtyInterfaces = std::move(other.m_geometryCacheDirtyInterfaces);
+	m_vertexIncidenceEnabled = std::move(other.m_vertexIncidenceEnabled);
+	m_vertexIncidenceStale = std::move(other.m_vertexIncidenceStale);
+	m_vertexIncidenceCells = std::move(other.m_vertexIncidenceCells);
+	m_vertexIncidenceWaste = std::move(other.m_vertexIncidenceWaste);
+	m_pointLocatorRevision = std::move(other.m_pointLocatorRevision);
 	m_adaptionMode = std::move(other.m_adaptionMode);
 	m_adaptionStatus = std::move(other.m_adaptionStatus);
 	m_id = std::move(other.m_id);
@@ -459,6 +592,40 @@ PatchKernel & PatchKernel::operator=(PatchKernel &&other)
 	// pointer to the other object with pointer to this object.
 	replaceVTKStreamer(&other, this);
 
+	// Re-create the geometry cache
+	if (m_geometryCacheEnabled) {
+		m_cellGeometryCache.resize(nCellGeometryCacheFields);
+		for (std::size_t n = 0; n < nCellGeometryCacheFields; ++n) {
+			m_cellGeometryCache[n] = std::unique_ptr<PiercedStorage<double, long>>(new PiercedStorage<double, long>(1, &m_cells, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+		}
+
+		m_interfaceGeometryCache.resize(nInterfaceGeometryCacheFields);
+		for (std::size_t n = 0; n < nInterfaceGeometryCacheFields; ++n) {
+			m_interfaceGeometryCache[n] = std::unique_ptr<PiercedStorage<double, long>>(new PiercedStorage<double, long>(1, &m_interfaces, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+		}
+
+		setGeometryCacheStale();
+	}
+
+	other.m_geometryCacheEnabled  = false;
+	other.m_geometryCacheStale    = false;
+	other.m_geometryCacheUpToDate = false;
+
+	// Arenas have been moved, the other patch stores the connectivity in
+	// its elements
+	other.m_connectivityStorageMode = CONNECTIVITY_STORAGE_ELEMENT;
+
+	// Re-create the vertex incidence
+	if (m_vertexIncidenceEnabled) {
+		m_vertexIncidenceRows = std::unique_ptr<PiercedStorage<std::size_t, long>>(new PiercedStorage<std::size_t, long>(3, &m_vertices, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+
+		setVertexIncidenceStale();
+	}
+
+	other.m_vertexIncidenceEnabled = false;
+	other.m_vertexIncidenceStale   = false;
+	other.m_vertexIncidenceWaste   = 0;
+
 #if BITPIT_ENABLE_MPI==1
 	// Handle the communication
 	std::swap(m_communicator, other.m_communicator);
@@ -521,6 +688,22 @@ void PatchKernel::initialize()
 	// Set interfaces build strategy
 	setInterfacesBuildStrategy(INTERFACES_NONE);
 
+	// Connectivity is stored in the elements
+	m_connectivityStorageMode = CONNECTIVITY_STORAGE_ELEMENT;
+
+	// Geometry cache is disabled
+	m_geometryCacheEnabled  = false;
+	m_geometryCacheStale    = false;
+	m_geometryCacheUpToDate = false;
+
+	// Vertex incidence is disabled
+	m_vertexIncidenceEnabled = false;
+	m_vertexIncidenceStale   = false;
+	m_vertexIncidenceWaste   = 0;
+
+	// Point locator revision
+	m_pointLocatorRevision = 0;
+
 	// Set the adaption as clean
 	setAdaptionStatus(ADAPTION_CLEAN);
 
@@ -844,6 +1027,23 @@ void PatchKernel::finalizeAlterations(bool squeezeStorage)
 	// Flush cell data structures
 	m_cells.flush();
 
+	// Move pending cell connectivity into the arena
+	//
+	// The capacity reserved for the next alterations is equal to the size
+	// of the connectivity that didn't fit in the arena during the current
+	// alterations, but it is never smaller than half the size of the arena.
+	// Growing the arena geometrically bounds the number of compactions when
+	// the patch is altered in many small steps.
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH && m_cellConnectArena->getPendingSize() > 0) {
+		compactCellConnectArena(getArenaGrowth(*m_cellConnectArena));
+	}
+
+	// Update vertex incidence
+	bool vertexIncidenceDirty = isVertexIncidenceDirty();
+	if (vertexIncidenceDirty) {
+		updateVertexIncidence();
+	}
+
 	// Update adjacencies
 	bool adjacenciesDirty = areAdjacenciesDirty();
 	if (adjacenciesDirty) {
@@ -859,6 +1059,16 @@ void PatchKernel::finalizeAlterations(bool squeezeStorage)
 	// Flush interfaces data structures
 	m_interfaces.flush();
 
+	// Move pending interface connectivity into the arena
+	//
+	// The arena grows geometrically, as the cell connectivity arena does.
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH && m_interfaceConnectArena->getPendingSize() > 0) {
+		compactInterfaceConnectArena(getArenaGrowth(*m_interfaceConnectArena));
+	}
+
+	// Update geometry cache
+	updateGeometryCache();
+
 #if BITPIT_ENABLE_MPI==1
 	// Update partitioning information
 	bool partitioningInfoDirty = arePartitioningInfoDirty();
@@ -986,6 +1196,12 @@ void PatchKernel::resetVertices()
 	for (auto &cell : m_cells) {
 		cell.unsetConnect();
 	}
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		m_cellConnectArena->clear();
+	}
+
+	// Cells no longer have a connectivity, the vertex incidence is not valid
+	setVertexIncidenceStale();
 }
 
 /*!
@@ -994,6 +1210,11 @@ void PatchKernel::resetVertices()
 void PatchKernel::resetCells()
 {
 	m_cells.clear();
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		m_cellConnectArena->clear();
+		m_cellAdjacenciesArena->clear();
+		m_cellInterfacesArena->clear();
+	}
 	if (m_cellIdGenerator) {
 		m_cellIdGenerator->reset();
 	}
@@ -1019,6 +1240,15 @@ void PatchKernel::resetCells()
 	}
 
 	m_alteredCells.clear();
+
+	if (isVertexIncidenceEnabled()) {
+		m_vertexIncidenceRows->fill(0);
+		std::vector<long>().swap(m_vertexIncidenceCells);
+		m_vertexIncidenceWaste = 0;
+		m_vertexIncidenceStale = false;
+	}
+
+	_resetPointLocator();
 }
 
 /*!
@@ -1042,6 +1272,9 @@ void PatchKernel::resetInterfaces()
 
 	// Clear list of altered interfaces
 	m_alteredInterfaces.clear();
+
+	// Interfaces will be re-created, their cached geometry is no more valid
+	setGeometryCacheStale();
 }
 
 /*!
@@ -1060,6 +1293,11 @@ void PatchKernel::_resetInterfaces(bool release)
 	}
 
 	m_interfaces.clear(release);
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		m_cellInterfacesArena->clear(release);
+		m_interfaceConnectArena->clear(release);
+	}
+
 	if (m_interfaceIdGenerator) {
 		m_interfaceIdGenerator->reset();
 	}
@@ -1387,6 +1625,14 @@ bool PatchKernel::isDirty(bool global) const
 		assert(isDirty || m_alteredInterfaces.empty());
 	}
 
+	if (!isDirty) {
+		isDirty |= isGeometryCacheDirty(false);
+	}
+
+	if (!isDirty) {
+		isDirty |= isVertexIncidenceDirty(false);
+	}
+
 	if (!isDirty) {
 		isDirty |= (getAdaptionStatus(false) == ADAPTION_DIRTY);
 	}
@@ -1395,6 +1641,11 @@ bool PatchKernel::isDirty(bool global) const
 		isDirty |= isBoundingBoxDirty(false);
 	}
 
+	if (!isDirty && m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		isDirty |= (m_cellConnectArena->getPendingSize() > 0);
+		isDirty |= (m_interfaceConnectArena->getPendingSize() > 0);
+	}
+
 #if BITPIT_ENABLE_MPI==1
 	if (!isDirty) {
 		isDirty |= arePartitioningInfoDirty(false);
@@ -2276,17 +2527,49 @@ std::vector<long> PatchKernel::collapseCoincidentVertices()
 			keepAdjacenciesUpToDate = false;
 		}
 
-		for (Cell &cell : m_cells) {
-			// Renumber cell vertices
-			int nRenumberedVertices = cell.renumberVertices(vertexMap);
+		if (isVertexIncidenceUsable()) {
+			// Only the cells that contain a collapsed vertex need to be
+			// renumbered, those cells are known from the vertex incidence.
+			std::vector<long> renumberedCellIds;
+			for (const auto &entry : vertexMap) {
+				long vertexId = entry.first;
+				int nIncidentCells = getVertexIncidentCellCount(vertexId);
+				const long *incidentCells = getVertexIncidentCells(vertexId);
+				renumberedCellIds.insert(renumberedCellIds.end(), incidentCells, incidentCells + nIncidentCells);
+			}
+
+			std::sort(renumberedCellIds.begin(), renumberedCellIds.end());
+			renumberedCellIds.erase(std::unique(renumberedCellIds.begin(), renumberedCellIds.end()), renumberedCellIds.end());
 
-			// Mark adjacencies are dirty
-			//
-			// If some vertices have been renumbered, the adjacencies of the cells
-			// are now dirty.
-			if ((adjacenciesBuildStrategy != ADJACENCIES_NONE) && (nRenumberedVertices > 0)) {
-				setCellAlterationFlags(cell.getId(), FLAG_ADJACENCIES_DIRTY);
+			for (long cellId : renumberedCellIds) {
+				// Renumber cell vertices
+				Cell &cell = m_cells.at(cellId);
+				removeCellVertexIncidences(cell);
+				cell.renumberVertices(vertexMap);
+				addCellVertexIncidences(cell);
+
+				// Mark adjacencies are dirty
+				if (adjacenciesBuildStrategy != ADJACENCIES_NONE) {
+					setCellAlterationFlags(cellId, FLAG_ADJACENCIES_DIRTY);
+				}
 			}
+		} else {
+			for (Cell &cell : m_cells) {
+				// Renumber cell vertices
+				int nRenumberedVertices = cell.renumberVertices(vertexMap);
+
+				// Mark adjacencies are dirty
+				//
+				// If some vertices have been renumbered, the adjacencies of the cells
+				// are now dirty.
+				if ((adjacenciesBuildStrategy != ADJACENCIES_NONE) && (nRenumberedVertices > 0)) {
+					setCellAlterationFlags(cell.getId(), FLAG_ADJACENCIES_DIRTY);
+				}
+			}
+
+			// Cell connectivity has been modified, the vertex incidence is no
+			// more valid
+			setVertexIncidenceStale();
 		}
 
 		if (keepAdjacenciesUpToDate) {
@@ -2969,6 +3252,9 @@ PatchKernel::CellIterator PatchKernel::_addInternalCell(ElementType type, std::u
 	}
 	m_nInternalCells++;
 
+	// Update the storage of the connectivity
+	updateCellConnectStorage(*iterator);
+
 	// Update the id of the last internal cell
 	if (m_lastInternalCellId < 0) {
 		m_lastInternalCellId = id;
@@ -3004,8 +3290,20 @@ void PatchKernel::setAddedCellAlterationFlags(long id)
 	if (getInterfacesBuildStrategy() != INTERFACES_NONE) {
 		flags |= FLAG_INTERFACES_DIRTY;
 	}
+	if (isGeometryCacheEnabled()) {
+		flags |= FLAG_GEOMETRY_DIRTY;
+	}
 
 	setCellAlterationFlags(id, flags);
+
+	// Cached geometry is no more up-to-date
+	invalidateGeometryCache();
+
+	// Update vertex incidence
+	addCellVertexIncidences(m_cells.at(id));
+
+	// Point locator is no more valid
+	invalidatePointLocator();
 }
 
 #if BITPIT_ENABLE_MPI==0
@@ -3066,6 +3364,9 @@ void PatchKernel::_restoreInternalCell(const CellIterator &iterator, ElementType
 	cell.initialize(cellId, type, std::move(connectStorage), true, storeInterfaces, storeAdjacencies);
 	m_nInternalCells++;
 
+	// Update the storage of the connectivity
+	updateCellConnectStorage(cell);
+
 	// Set the alteration flags of the cell
 	setRestoredCellAlterationFlags(cellId);
 }
@@ -3084,8 +3385,20 @@ void PatchKernel::setRestoredCellAlterationFlags(long id)
 	if (getInterfacesBuildStrategy() != INTERFACES_NONE) {
 		flags |= FLAG_INTERFACES_DIRTY;
 	}
+	if (isGeometryCacheEnabled()) {
+		flags |= FLAG_GEOMETRY_DIRTY;
+	}
 
 	setCellAlterationFlags(id, flags);
+
+	// Cached geometry is no more up-to-date
+	invalidateGeometryCache();
+
+	// Update vertex incidence
+	addCellVertexIncidences(m_cells.at(id));
+
+	// Point locator is no more valid
+	invalidatePointLocator();
 }
 
 /*!
@@ -3126,6 +3439,7 @@ void PatchKernel::_deleteInternalCell(long id)
 	setDeletedCellAlterationFlags(id);
 
 	// Delete cell
+	unsetCellArenaStorage(m_cells[id]);
 	m_cells.erase(id, true);
 	m_nInternalCells--;
 	if (id == m_lastInternalCellId) {
@@ -3149,6 +3463,15 @@ void PatchKernel::setDeletedCellAlterationFlags(long id)
 {
 	const Cell &cell = getCell(id);
 
+	// Update vertex incidence
+	removeCellVertexIncidences(cell);
+
+	// Point locator is no more valid
+	invalidatePointLocator();
+
+	// Cached geometry of the interfaces is no more up-to-date
+	invalidateGeometryCache();
+
 	// Set the alteration flags of the cell
 	resetCellAlterationFlags(id, FLAG_DELETED);
 
@@ -3872,6 +4195,10 @@ void PatchKernel::findCellVertexNeighs(long id, int vertex, std::vector<long> *n
 
 	This implementation can NOT handle hanging nodes.
 
+	If the vertex incidence is available, the search only visits the cells
+	that contain the vertex, hence there is no need to check which faces of
+	the visited cells own the vertex.
+
 	\param id is the id of the cell
 	\param vertex is a local vertex of the cell
 	\param blackList is a list of cells that are excluded from the search.
@@ -3887,6 +4214,63 @@ void PatchKernel::_findCellVertexNeighs(long id, int vertex, const std::vector<l
 	const Cell &cell = getCell(id);
 	long vertexId = cell.getVertexId(vertex);
 
+	// Use the vertex incidence
+	//
+	// The neighbours are the cells that contain the vertex and that can be
+	// reached from the specified cell moving through face adjacencies.
+	if (isVertexIncidenceUsable()) {
+		int nIncidentCells = getVertexIncidentCellCount(vertexId);
+		const long *incidentCellsBegin = getVertexIncidentCells(vertexId);
+		const long *incidentCellsEnd   = incidentCellsBegin + nIncidentCells;
+
+		std::vector<bool> alreadyProcessed(nIncidentCells, false);
+		alreadyProcessed[std::lower_bound(incidentCellsBegin, incidentCellsEnd, id) - incidentCellsBegin] = true;
+
+		std::vector<long> scanQueue;
+		scanQueue.reserve(nIncidentCells);
+		scanQueue.push_back(id);
+
+		while (!scanQueue.empty()) {
+			// Pop a cell to process
+			long scanCellId = scanQueue.back();
+			const Cell &scanCell = getCell(scanCellId);
+			scanQueue.pop_back();
+
+			// Loop through the adjacencies
+			int nScanCellAdjacencies = scanCell.getAdjacencyCount();
+			const long *scanCellAdjacencies = scanCell.getAdjacencies();
+			for (int k = 0; k < nScanCellAdjacencies; ++k) {
+				long neighId = scanCellAdjacencies[k];
+				if (neighId < 0) {
+					continue;
+				}
+
+				// Discard neighbours that don't contain the vertex or that
+				// have already been processed
+				const long *neighItr = std::lower_bound(incidentCellsBegin, incidentCellsEnd, neighId);
+				if (neighItr == incidentCellsEnd || *neighItr != neighId) {
+					continue;
+				}
+
+				std::size_t neighIndex = static_cast<std::size_t>(neighItr - incidentCellsBegin);
+				if (alreadyProcessed[neighIndex]) {
+					continue;
+				}
+				alreadyProcessed[neighIndex] = true;
+
+				// Update list of vertex neighbours
+				if (!blackList || utils::findInOrderedVector<long>(neighId, *blackList) == blackList->end()) {
+					utils::addToOrderedVector<long>(neighId, *neighs);
+				}
+
+				// Update scan list
+				scanQueue.push_back(neighId);
+			}
+		}
+
+		return;
+	}
+
 	// Since we are processing a small number of cells it's more efficient to
 	// store the list of already processed cells in a vector instead of using
 	// a set or an unordered_set. To speed-up the lookup, the vector is kept
@@ -4121,7 +4505,10 @@ std::vector<long> PatchKernel::findVertexOneRing(long vertexId) const
 /*!
  * Find the cells that share the specified vertex.
  *
- * This function doesn't support coincident vertices with different ids.
+ * If the vertex incidence is available, the one-ring is read directly from
+ * the incidence. Otherwise, the one-ring is found starting from a cell that
+ * contains the vertex and moving through face adjacencies; in this case,
+ * coincident vertices with different ids are not supported.
  *
  * \param vertexId is the index of the vertex
  * \param[in,out] ring is the vector were the one-ring of the specified vertex
@@ -4130,6 +4517,21 @@ std::vector<long> PatchKernel::findVertexOneRing(long vertexId) const
  */
 void PatchKernel::findVertexOneRing(long vertexId, std::vector<long> *ring) const
 {
+    // Use the vertex incidence
+    if (isVertexIncidenceUsable()) {
+        int nIncidentCells = getVertexIncidentCellCount(vertexId);
+        const long *incidentCells = getVertexIncidentCells(vertexId);
+        if (ring->empty()) {
+            ring->assign(incidentCells, incidentCells + nIncidentCells);
+        } else {
+            for (int i = 0; i < nIncidentCells; ++i) {
+                utils::addToOrderedVector<long>(incidentCells[i], *ring);
+            }
+        }
+
+        return;
+    }
+
     // Find local id of the vertex
     //
     // Coincident vertices with different ids are not supported, this case is
@@ -4561,6 +4963,9 @@ PatchKernel::InterfaceIterator PatchKernel::_addInterface(ElementType type,
 	// Create the interface
 	PiercedVector<Interface>::iterator iterator = m_interfaces.emreclaim(id, id, type, std::move(connectStorage));
 
+	// Update the storage of the connectivity
+	updateInterfaceConnectStorage(*iterator);
+
 	// Set the alteration flags
 	setAddedInterfaceAlterationFlags(id);
 
@@ -4577,7 +4982,13 @@ PatchKernel::InterfaceIterator PatchKernel::_addInterface(ElementType type,
 */
 void PatchKernel::setAddedInterfaceAlterationFlags(long id)
 {
-	BITPIT_UNUSED(id);
+	// Cached geometry of the interface has to be evaluated
+	if (isGeometryCacheEnabled()) {
+		m_geometryCacheDirtyInterfaces.push_back(id);
+	}
+
+	// Cached geometry is no more up-to-date
+	invalidateGeometryCache();
 }
 
 /*!
@@ -4636,6 +5047,9 @@ void PatchKernel::_restoreInterface(const InterfaceIterator &iterator, ElementTy
 	Interface &interface = *iterator;
 	interface.initialize(interfaceId, type, std::move(connectStorage));
 
+	// Update the storage of the connectivity
+	updateInterfaceConnectStorage(interface);
+
 	// Set the alteration flags
 	setRestoredInterfaceAlterationFlags(interfaceId);
 }
@@ -4647,7 +5061,13 @@ void PatchKernel::_restoreInterface(const InterfaceIterator &iterator, ElementTy
 */
 void PatchKernel::setRestoredInterfaceAlterationFlags(long id)
 {
-	BITPIT_UNUSED(id);
+	// Cached geometry of the interface has to be evaluated
+	if (isGeometryCacheEnabled()) {
+		m_geometryCacheDirtyInterfaces.push_back(id);
+	}
+
+	// Cached geometry is no more up-to-date
+	invalidateGeometryCache();
 }
 
 /*!
@@ -4677,6 +5097,7 @@ void PatchKernel::_deleteInterface(long id)
 	setDeletedInterfaceAlterationFlags(id);
 
 	// Delete interface
+	unsetInterfaceArenaStorage(m_interfaces[id]);
 	m_interfaces.erase(id, true);
 
 	// Interface id is no longer used
@@ -4876,10 +5297,19 @@ long PatchKernel::countBorderFaces() const
 /*!
  *  Write the vertices to the specified stream.
  *
+ *  If the stream is a mapped archive, vertex data is written in the sections
+ *  of the archive.
+ *
  *  \param stream is the stream to write to
  */
 void PatchKernel::dumpVertices(std::ostream &stream) const
 {
+	// Dump vertices to the sections of mapped archives
+	if (OMappedArchive *archive = dynamic_cast<OMappedArchive *>(&stream)) {
+		dumpMappedVertices(*archive);
+		return;
+	}
+
 	// Dump kernel
 	m_vertices.dumpKernel(stream);
 
@@ -4912,10 +5342,19 @@ void PatchKernel::dumpVertices(std::ostream &stream) const
 /*!
  *  Restore the vertices from the specified stream.
  *
+ *  If the stream is a mapped archive, vertex data is read from the sections
+ *  of the archive.
+ *
  *  \param stream is the stream to read from
  */
 void PatchKernel::restoreVertices(std::istream &stream)
 {
+	// Restore vertices from the sections of mapped archives
+	if (IMappedArchive *archive = dynamic_cast<IMappedArchive *>(&stream)) {
+		restoreMappedVertices(*archive);
+		return;
+	}
+
 	// Restore kernel
 	m_vertices.restoreKernel(stream);
 
@@ -4967,10 +5406,19 @@ void PatchKernel::restoreVertices(std::istream &stream)
 /*!
  *  Write the cells to the specified stream.
  *
+ *  If the stream is a mapped archive, cell data is written in the sections
+ *  of the archive.
+ *
  *  \param stream is the stream to write to
  */
 void PatchKernel::dumpCells(std::ostream &stream) const
 {
+	// Dump cells to the sections of mapped archives
+	if (OMappedArchive *archive = dynamic_cast<OMappedArchive *>(&stream)) {
+		dumpMappedCells(*archive);
+		return;
+	}
+
 	// Dump kernel
 	m_cells.dumpKernel(stream);
 
@@ -5013,10 +5461,19 @@ void PatchKernel::dumpCells(std::ostream &stream) const
 /*!
  *  Restore the cells from the specified stream.
  *
+ *  If the stream is a mapped archive, cell data is read from the sections
+ *  of the archive.
+ *
  *  \param stream is the stream to read from
  */
 void PatchKernel::restoreCells(std::istream &stream)
 {
+	// Restore cells from the sections of mapped archives
+	if (IMappedArchive *archive = dynamic_cast<IMappedArchive *>(&stream)) {
+		restoreMappedCells(*archive);
+		return;
+	}
+
 	// Restore kernel
 	m_cells.restoreKernel(stream);
 
@@ -5088,6 +5545,9 @@ void PatchKernel::restoreCells(std::istream &stream)
 /*!
  *  Write the interfaces to the specified stream.
  *
+ *  If the stream is a mapped archive, interface data is written in the
+ *  sections of the archive.
+ *
  *  \param stream is the stream to write to
  */
 void PatchKernel::dumpInterfaces(std::ostream &stream) const
@@ -5097,6 +5557,12 @@ void PatchKernel::dumpInterfaces(std::ostream &stream) const
 		return;
 	}
 
+	// Dump interfaces to the sections of mapped archives
+	if (OMappedArchive *archive = dynamic_cast<OMappedArchive *>(&stream)) {
+		dumpMappedInterfaces(*archive);
+		return;
+	}
+
 	// Dump kernel
 	m_interfaces.dumpKernel(stream);
 
@@ -5120,6 +5586,9 @@ void PatchKernel::dumpInterfaces(std::ostream &stream) const
 /*!
  *  Restore the interfaces from the specified stream.
  *
+ *  If the stream is a mapped archive, interface data is read from the
+ *  sections of the archive.
+ *
  *  \param stream is the stream to read from
  */
 void PatchKernel::restoreInterfaces(std::istream &stream)
@@ -5129,6 +5598,12 @@ void PatchKernel::restoreInterfaces(std::istream &stream)
 		return;
 	}
 
+	// Restore interfaces from the sections of mapped archives
+	if (IMappedArchive *archive = dynamic_cast<IMappedArchive *>(&stream)) {
+		restoreMappedInterfaces(*archive);
+		return;
+	}
+
 	// Interfaces need up-to-date adjacencies
 	updateAdjacencies();
 
@@ -5174,105 +5649,689 @@ void PatchKernel::restoreInterfaces(std::istream &stream)
 	unsetCellAlterationFlags(FLAG_INTERFACES_DIRTY);
 	m_alteredInterfaces.clear();
 
+	// Update the storage of the cell interfaces
+	updateCellInterfacesStorage();
+
 	// Restore previous adaption mode
 	setAdaptionMode(previousAdaptionMode);
 }
 
 /*!
-	Prepares the patch for performing the adaption.
-
-	Default implementation is a no-op function.
-
-	\param trackAdaption if set to true the function will return the changes
-	that will be performed in the alter step
-	\result If the adaption is tracked, returns a vector of adaption::Info that
-	can be used to discover what changes will be performed in the alter step,
-	otherwise an empty vector will be returned.
-*/
-std::vector<adaption::Info> PatchKernel::_adaptionPrepare(bool trackAdaption)
+ *  Write the vertices to the sections of the specified mapped archive.
+ *
+ *  Vertices are written following the order in which they are stored
+ *  in the patch. Ids, owners and coordinates are written in separate
+ *  sections, the keys of the sections are written in the metadata of
+ *  the archive.
+ *
+ *  \param archive is the archive to write to
+ */
+void PatchKernel::dumpMappedVertices(OMappedArchive &archive) const
 {
-	BITPIT_UNUSED(trackAdaption);
-
-	return std::vector<adaption::Info>();
-}
+	// Section keys
+	uint32_t idsKey    = static_cast<uint32_t>(archive.getSectionCount());
+	uint32_t ownersKey = idsKey + 1;
+	uint32_t coordsKey = idsKey + 2;
 
-/*!
-	Alter the patch performing the adaption.
+	utils::binary::write(archive, static_cast<std::size_t>(m_vertices.size()));
+	utils::binary::write(archive, idsKey);
+	utils::binary::write(archive, ownersKey);
+	utils::binary::write(archive, coordsKey);
 
-	Default implementation is a no-op function.
+	// Dump vertices
+	archive.writeSection<long>(idsKey, m_vertices.cbegin(), m_vertices.cend(), [](const Vertex &vertex) {
+		return vertex.getId();
+	});
 
-	\param trackAdaption if set to true the function will return the changes
-	done to the patch during the adaption
-	\result If the adaption is tracked, returns a vector of adaption::Info
-	with all the changes done to the patch during the adaption, otherwise an
-	empty vector will be returned.
-*/
-std::vector<adaption::Info> PatchKernel::_adaptionAlter(bool trackAdaption)
-{
-	BITPIT_UNUSED(trackAdaption);
+	archive.writeSection<int>(ownersKey, m_vertices.cbegin(), m_vertices.cend(), [this](const Vertex &vertex) {
+#if BITPIT_ENABLE_MPI==1
+		return getVertexOwner(vertex.getId());
+#else
+		BITPIT_UNUSED(vertex);
+		return 0;
+#endif
+	});
 
-	assert(false && "The patch needs to implement _adaptionAlter");
+	archive.writeSection<std::array<double, 3>>(coordsKey, m_vertices.cbegin(), m_vertices.cend(), [](const Vertex &vertex) {
+		return vertex.getCoords();
+	});
 
-	return std::vector<adaption::Info>();
+	// Dump ghost/internal subdivision
+#if BITPIT_ENABLE_MPI==1
+	utils::binary::write(archive, m_firstGhostVertexId);
+	utils::binary::write(archive, m_lastInternalVertexId);
+#else
+	utils::binary::write(archive, Vertex::NULL_ID);
+	utils::binary::write(archive, Vertex::NULL_ID);
+#endif
 }
 
 /*!
-	Cleanup patch data structured after the adaption.
-
-	Default implementation is a no-op function.
-*/
-void PatchKernel::_adaptionCleanup()
+ *  Restore the vertices from the sections of the specified mapped archive.
+ *
+ *  Vertex data is read directly from the memory mapping of the archive,
+ *  once the vertices are restored the memory associated with the sections
+ *  is released.
+ *
+ *  \param archive is the archive to read from
+ */
+void PatchKernel::restoreMappedVertices(IMappedArchive &archive)
 {
-}
+	// Section keys
+	std::size_t nVertices;
+	utils::binary::read(archive, nVertices);
 
-/*!
-	Marks a cell for refinement.
+	uint32_t idsKey;
+	uint32_t ownersKey;
+	uint32_t coordsKey;
+	utils::binary::read(archive, idsKey);
+	utils::binary::read(archive, ownersKey);
+	utils::binary::read(archive, coordsKey);
 
-	Default implementation is a no-op function.
+	// Access vertex data
+	std::size_t nIds;
+	const long *ids = archive.getSection<long>(idsKey, &nIds);
 
-	\param id the cell to be refined
-	\result Returns true if the marker was properly set, false otherwise.
-*/
-bool PatchKernel::_markCellForRefinement(long id)
-{
-	BITPIT_UNUSED(id);
+	std::size_t nOwners;
+	const int *owners = archive.getSection<int>(ownersKey, &nOwners);
 
-	return false;
-}
+	std::size_t nCoords;
+	const std::array<double, 3> *coords = archive.getSection<std::array<double, 3>>(coordsKey, &nCoords);
 
-/*!
-	Marks a cell for coarsening.
+	if (nIds != nVertices || nOwners != nVertices || nCoords != nVertices) {
+		throw std::runtime_error("The vertex sections of the archive are not consistent.");
+	}
 
-	Default implementation is a no-op function.
+#if BITPIT_ENABLE_MPI==0
+	BITPIT_UNUSED(owners);
+#endif
 
-	\param id the cell to be refined
-	\result Returns true if the marker was properly set, false otherwise.
-*/
-bool PatchKernel::_markCellForCoarsening(long id)
-{
-	BITPIT_UNUSED(id);
+	// Enable manual adaption
+	AdaptionMode previousAdaptionMode = getAdaptionMode();
+	setAdaptionMode(ADAPTION_MANUAL);
 
-	return false;
-}
+	// Restore vertices
+	//
+	// Vertices are appended to the kernel in a single operation following
+	// the order in which they were stored, the kernel of the restored patch
+	// will not contain holes.
+	m_vertices.emplaceBackRange(nVertices, ids);
+	for (std::size_t i = 0; i < nVertices; ++i) {
+		long id = ids[i];
 
-/*!
-	Resets the adaption marker of the specified cell.
+#if BITPIT_ENABLE_MPI==1
+		restoreVertex(coords[i], owners[i], id);
+#else
+		restoreVertex(coords[i], id);
+#endif
+	}
 
-	Default implementation is a no-op function.
+	archive.releaseSection(idsKey);
+	archive.releaseSection(ownersKey);
+	archive.releaseSection(coordsKey);
 
-	\param id the cell to be refined
-	\result Returns true if the marker was properly reset, false otherwise.
-*/
-bool PatchKernel::_resetCellAdaptionMarker(long id)
-{
-	BITPIT_UNUSED(id);
+	// Restore ghost/internal subdivision
+#if BITPIT_ENABLE_MPI==1
+	utils::binary::read(archive, m_firstGhostVertexId);
+	utils::binary::read(archive, m_lastInternalVertexId);
+#else
+	long dummyFirstGhostVertexId;
+	long dummyLastInternalVertexId;
+	utils::binary::read(archive, dummyFirstGhostVertexId);
+	utils::binary::read(archive, dummyLastInternalVertexId);
+#endif
 
-	return false;
+	// Restore previous adaption mode
+	setAdaptionMode(previousAdaptionMode);
 }
 
 /*!
-	Returns the adaption marker of the specified cell.
-
+ *  Write the cells to the sections of the specified mapped archive.
+ *
+ *  Cells are written following the order in which they are stored in the
+ *  patch. Connectivity is written in compressed sparse row format, i.e.,
+ *  a section contains the connectivity of all the cells and another section
+ *  contains the offsets of the connectivity of each cell. The keys of the
+ *  sections are written in the metadata of the archive.
+ *
+ *  \param archive is the archive to write to
+ */
+void PatchKernel::dumpMappedCells(OMappedArchive &archive) const
+{
+	// Section keys
+	uint32_t idsKey            = static_cast<uint32_t>(archive.getSectionCount());
+	uint32_t pidsKey           = idsKey + 1;
+	uint32_t typesKey          = idsKey + 2;
+	uint32_t ownersKey         = idsKey + 3;
+	uint32_t haloLayersKey     = idsKey + 4;
+	uint32_t connectOffsetsKey = idsKey + 5;
+	uint32_t connectKey        = idsKey + 6;
+
+	bool hasAdjacencies = (getAdjacenciesBuildStrategy() != ADJACENCIES_NONE) && !areAdjacenciesDirty();
+	uint32_t adjacencyCountsKey = idsKey + 7;
+	uint32_t adjacenciesKey     = idsKey + 8;
+
+	utils::binary::write(archive, static_cast<std::size_t>(m_cells.size()));
+	utils::binary::write(archive, idsKey);
+	utils::binary::write(archive, pidsKey);
+	utils::binary::write(archive, typesKey);
+	utils::binary::write(archive, ownersKey);
+	utils::binary::write(archive, haloLayersKey);
+	utils::binary::write(archive, connectOffsetsKey);
+	utils::binary::write(archive, connectKey);
+	utils::binary::write(archive, hasAdjacencies);
+	utils::binary::write(archive, adjacencyCountsKey);
+	utils::binary::write(archive, adjacenciesKey);
+
+	// Dump cells
+	archive.writeSection<long>(idsKey, m_cells.cbegin(), m_cells.cend(), [](const Cell &cell) {
+		return cell.getId();
+	});
+
+	archive.writeSection<int>(pidsKey, m_cells.cbegin(), m_cells.cend(), [](const Cell &cell) {
+		return cell.getPID();
+	});
+
+	archive.writeSection<ElementType>(typesKey, m_cells.cbegin(), m_cells.cend(), [](const Cell &cell) {
+		return cell.getType();
+	});
+
+	archive.writeSection<int>(ownersKey, m_cells.cbegin(), m_cells.cend(), [this](const Cell &cell) {
+#if BITPIT_ENABLE_MPI==1
+		return getCellOwner(cell.getId());
+#else
+		BITPIT_UNUSED(cell);
+		return 0;
+#endif
+	});
+
+	archive.writeSection<int>(haloLayersKey, m_cells.cbegin(), m_cells.cend(), [this](const Cell &cell) {
+#if BITPIT_ENABLE_MPI==1
+		return getCellHaloLayer(cell.getId());
+#else
+		BITPIT_UNUSED(cell);
+		return 0;
+#endif
+	});
+
+	std::size_t connectOffset = 0;
+	archive.beginSection(connectOffsetsKey, sizeof(std::size_t));
+	archive.writeSectionData(&connectOffset, 1);
+	archive.writeSectionData<std::size_t>(m_cells.cbegin(), m_cells.cend(), [&connectOffset](const Cell &cell) {
+		connectOffset += cell.getConnectSize();
+		return connectOffset;
+	});
+	archive.endSection();
+
+	archive.beginSection(connectKey, sizeof(long));
+	for (const Cell &cell : m_cells) {
+		archive.writeSectionData(cell.getConnect(), cell.getConnectSize());
+	}
+	archive.endSection();
+
+	// Dump adjacencies
+	//
+	// Adjacencies are written only if they are up-to-date, for each face of
+	// each cell the number of adjacencies is written in a section and the
+	// adjacencies themselves are written in another section.
+	if (hasAdjacencies) {
+		archive.beginSection(adjacencyCountsKey, sizeof(std::size_t));
+		for (const Cell &cell : m_cells) {
+			int nCellFaces = cell.getFaceCount();
+			for (int face = 0; face < nCellFaces; ++face) {
+				std::size_t nFaceAdjacencies = cell.getAdjacencyCount(face);
+				archive.writeSectionData(&nFaceAdjacencies, 1);
+			}
+		}
+		archive.endSection();
+
+		archive.beginSection(adjacenciesKey, sizeof(long));
+		for (const Cell &cell : m_cells) {
+			archive.writeSectionData(cell.getAdjacencies(), cell.getAdjacencyCount());
+		}
+		archive.endSection();
+	}
+
+	// Dump ghost/internal subdivision
+#if BITPIT_ENABLE_MPI==1
+	utils::binary::write(archive, m_firstGhostCellId);
+	utils::binary::write(archive, m_lastInternalCellId);
+#else
+	utils::binary::write(archive, Cell::NULL_ID);
+	utils::binary::write(archive, Cell::NULL_ID);
+#endif
+}
+
+/*!
+ *  Restore the cells from the sections of the specified mapped archive.
+ *
+ *  Cell data is read directly from the memory mapping of the archive, once
+ *  the cells are restored the memory associated with the sections is
+ *  released.
+ *
+ *  \param archive is the archive to read from
+ */
+void PatchKernel::restoreMappedCells(IMappedArchive &archive)
+{
+	// Section keys
+	std::size_t nCells;
+	utils::binary::read(archive, nCells);
+
+	uint32_t idsKey;
+	uint32_t pidsKey;
+	uint32_t typesKey;
+	uint32_t ownersKey;
+	uint32_t haloLayersKey;
+	uint32_t connectOffsetsKey;
+	uint32_t connectKey;
+	utils::binary::read(archive, idsKey);
+	utils::binary::read(archive, pidsKey);
+	utils::binary::read(archive, typesKey);
+	utils::binary::read(archive, ownersKey);
+	utils::binary::read(archive, haloLayersKey);
+	utils::binary::read(archive, connectOffsetsKey);
+	utils::binary::read(archive, connectKey);
+
+	bool hasAdjacencies;
+	uint32_t adjacencyCountsKey;
+	uint32_t adjacenciesKey;
+	utils::binary::read(archive, hasAdjacencies);
+	utils::binary::read(archive, adjacencyCountsKey);
+	utils::binary::read(archive, adjacenciesKey);
+
+	// Access cell data
+	std::size_t nIds;
+	const long *ids = archive.getSection<long>(idsKey, &nIds);
+
+	std::size_t nPIDs;
+	const int *pids = archive.getSection<int>(pidsKey, &nPIDs);
+
+	std::size_t nTypes;
+	const ElementType *types = archive.getSection<ElementType>(typesKey, &nTypes);
+
+	std::size_t nOwners;
+	const int *owners = archive.getSection<int>(ownersKey, &nOwners);
+
+	std::size_t nHaloLayers;
+	const int *haloLayers = archive.getSection<int>(haloLayersKey, &nHaloLayers);
+
+	std::size_t nConnectOffsets;
+	const std::size_t *connectOffsets = archive.getSection<std::size_t>(connectOffsetsKey, &nConnectOffsets);
+
+	std::size_t nConnect;
+	const long *connect = archive.getSection<long>(connectKey, &nConnect);
+
+	if (nIds != nCells || nPIDs != nCells || nTypes != nCells || nOwners != nCells || nHaloLayers != nCells ||
+	        nConnectOffsets != (nCells + 1) || connectOffsets[nCells] != nConnect) {
+		throw std::runtime_error("The cell sections of the archive are not consistent.");
+	}
+
+	// Access adjacency data
+	//
+	// Adjacencies are restored only if the patch is building them, otherwise
+	// stored adjacencies are ignored.
+	bool restoreAdjacencies = hasAdjacencies && (getAdjacenciesBuildStrategy() != ADJACENCIES_NONE);
+
+	std::size_t nAdjacencyCounts = 0;
+	const std::size_t *adjacencyCounts = nullptr;
+	std::size_t nAdjacencies = 0;
+	const long *adjacencies = nullptr;
+	if (restoreAdjacencies) {
+		adjacencyCounts = archive.getSection<std::size_t>(adjacencyCountsKey, &nAdjacencyCounts);
+		adjacencies     = archive.getSection<long>(adjacenciesKey, &nAdjacencies);
+	}
+
+#if BITPIT_ENABLE_MPI==0
+	BITPIT_UNUSED(owners);
+	BITPIT_UNUSED(haloLayers);
+#endif
+
+	// Enable manual adaption
+	AdaptionMode previousAdaptionMode = getAdaptionMode();
+	setAdaptionMode(ADAPTION_MANUAL);
+
+	// Reserve space for the connectivity
+	//
+	// When the connectivity is stored in the patch, the space needed by all
+	// the restored cells is reserved up front, this way the connectivity of
+	// all the cells is stored directly in the arena. Adding cells never
+	// reallocates the arena: if there is not enough space, the arena is
+	// compacted reserving the needed space.
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH && !m_cellConnectArena->hasRoom(nConnect)) {
+		compactCellConnectArena(nConnect);
+	}
+
+	// Restore cells
+	//
+	// Cells are appended to the kernel in a single operation following the
+	// order in which they were stored, the kernel of the restored patch will
+	// not contain holes.
+	std::size_t adjacencyCountsOffset = 0;
+	std::size_t adjacenciesOffset = 0;
+
+	m_cells.emplaceBackRange(nCells, ids);
+	for (std::size_t i = 0; i < nCells; ++i) {
+		long id = ids[i];
+
+		std::size_t cellConnectBegin = connectOffsets[i];
+		std::size_t cellConnectEnd   = connectOffsets[i + 1];
+		std::unique_ptr<long[]> cellConnect = std::unique_ptr<long[]>(new long[cellConnectEnd - cellConnectBegin]);
+		std::copy(connect + cellConnectBegin, connect + cellConnectEnd, cellConnect.get());
+
+		CellIterator iterator;
+#if BITPIT_ENABLE_MPI==1
+		iterator = restoreCell(types[i], std::move(cellConnect), owners[i], haloLayers[i], id);
+#else
+		iterator = restoreCell(types[i], std::move(cellConnect), id);
+#endif
+		iterator->setPID(pids[i]);
+
+		if (restoreAdjacencies) {
+			int nCellFaces = iterator->getFaceCount();
+			if (adjacencyCountsOffset + nCellFaces > nAdjacencyCounts) {
+				throw std::runtime_error("The adjacency sections of the archive are not consistent.");
+			}
+
+			const std::size_t *cellAdjacencyCounts = adjacencyCounts + adjacencyCountsOffset;
+			std::size_t nCellAdjacencies = std::accumulate(cellAdjacencyCounts, cellAdjacencyCounts + nCellFaces, std::size_t(0));
+			if (adjacenciesOffset + nCellAdjacencies > nAdjacencies) {
+				throw std::runtime_error("The adjacency sections of the archive are not consistent.");
+			}
+
+			FlatVector2D<long> cellAdjacencies(nCellFaces, cellAdjacencyCounts, Cell::NULL_ID);
+			std::copy(adjacencies + adjacenciesOffset, adjacencies + adjacenciesOffset + nCellAdjacencies, cellAdjacencies.data());
+			iterator->setAdjacencies(std::move(cellAdjacencies));
+
+			adjacencyCountsOffset += nCellFaces;
+			adjacenciesOffset     += nCellAdjacencies;
+		}
+	}
+
+	if (restoreAdjacencies) {
+		// Restored adjacencies are up-to-date
+		unsetCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
+
+		// Update the storage of the adjacencies
+		updateCellAdjacenciesStorage();
+
+		archive.releaseSection(adjacencyCountsKey);
+		archive.releaseSection(adjacenciesKey);
+	}
+
+	archive.releaseSection(idsKey);
+	archive.releaseSection(pidsKey);
+	archive.releaseSection(typesKey);
+	archive.releaseSection(ownersKey);
+	archive.releaseSection(haloLayersKey);
+	archive.releaseSection(connectOffsetsKey);
+	archive.releaseSection(connectKey);
+
+	// Restore ghost/internal subdivision
+#if BITPIT_ENABLE_MPI==1
+	utils::binary::read(archive, m_firstGhostCellId);
+	utils::binary::read(archive, m_lastInternalCellId);
+#else
+	long dummyFirstGhostCellId;
+	long dummyLastInternalCellId;
+	utils::binary::read(archive, dummyFirstGhostCellId);
+	utils::binary::read(archive, dummyLastInternalCellId);
+#endif
+
+	// Update adjacencies
+	updateAdjacencies();
+
+	// Restore previous adaption mode
+	setAdaptionMode(previousAdaptionMode);
+}
+
+/*!
+ *  Write the interfaces to the sections of the specified mapped archive.
+ *
+ *  Interfaces are written following the order in which they are stored in
+ *  the patch. The keys of the sections are written in the metadata of the
+ *  archive.
+ *
+ *  \param archive is the archive to write to
+ */
+void PatchKernel::dumpMappedInterfaces(OMappedArchive &archive) const
+{
+	// Section keys
+	uint32_t idsKey        = static_cast<uint32_t>(archive.getSectionCount());
+	uint32_t ownersKey     = idsKey + 1;
+	uint32_t ownerFacesKey = idsKey + 2;
+	uint32_t neighsKey     = idsKey + 3;
+	uint32_t neighFacesKey = idsKey + 4;
+	uint32_t pidsKey       = idsKey + 5;
+
+	utils::binary::write(archive, static_cast<std::size_t>(m_interfaces.size()));
+	utils::binary::write(archive, idsKey);
+	utils::binary::write(archive, ownersKey);
+	utils::binary::write(archive, ownerFacesKey);
+	utils::binary::write(archive, neighsKey);
+	utils::binary::write(archive, neighFacesKey);
+	utils::binary::write(archive, pidsKey);
+
+	// Dump interfaces
+	archive.writeSection<long>(idsKey, m_interfaces.cbegin(), m_interfaces.cend(), [](const Interface &interface) {
+		return interface.getId();
+	});
+
+	archive.writeSection<long>(ownersKey, m_interfaces.cbegin(), m_interfaces.cend(), [](const Interface &interface) {
+		return interface.getOwner();
+	});
+
+	archive.writeSection<int>(ownerFacesKey, m_interfaces.cbegin(), m_interfaces.cend(), [](const Interface &interface) {
+		return interface.getOwnerFace();
+	});
+
+	archive.writeSection<long>(neighsKey, m_interfaces.cbegin(), m_interfaces.cend(), [](const Interface &interface) {
+		return interface.getNeigh();
+	});
+
+	archive.writeSection<int>(neighFacesKey, m_interfaces.cbegin(), m_interfaces.cend(), [](const Interface &interface) {
+		return (interface.getNeigh() >= 0) ? interface.getNeighFace() : -1;
+	});
+
+	archive.writeSection<int>(pidsKey, m_interfaces.cbegin(), m_interfaces.cend(), [](const Interface &interface) {
+		return interface.getPID();
+	});
+}
+
+/*!
+ *  Restore the interfaces from the sections of the specified mapped archive.
+ *
+ *  Interface data is read directly from the memory mapping of the archive,
+ *  once the interfaces are restored the memory associated with the sections
+ *  is released.
+ *
+ *  \param archive is the archive to read from
+ */
+void PatchKernel::restoreMappedInterfaces(IMappedArchive &archive)
+{
+	// Section keys
+	std::size_t nInterfaces;
+	utils::binary::read(archive, nInterfaces);
+
+	uint32_t idsKey;
+	uint32_t ownersKey;
+	uint32_t ownerFacesKey;
+	uint32_t neighsKey;
+	uint32_t neighFacesKey;
+	uint32_t pidsKey;
+	utils::binary::read(archive, idsKey);
+	utils::binary::read(archive, ownersKey);
+	utils::binary::read(archive, ownerFacesKey);
+	utils::binary::read(archive, neighsKey);
+	utils::binary::read(archive, neighFacesKey);
+	utils::binary::read(archive, pidsKey);
+
+	// Access interface data
+	std::size_t nIds;
+	const long *ids = archive.getSection<long>(idsKey, &nIds);
+
+	std::size_t nOwners;
+	const long *owners = archive.getSection<long>(ownersKey, &nOwners);
+
+	std::size_t nOwnerFaces;
+	const int *ownerFaces = archive.getSection<int>(ownerFacesKey, &nOwnerFaces);
+
+	std::size_t nNeighs;
+	const long *neighs = archive.getSection<long>(neighsKey, &nNeighs);
+
+	std::size_t nNeighFaces;
+	const int *neighFaces = archive.getSection<int>(neighFacesKey, &nNeighFaces);
+
+	std::size_t nPIDs;
+	const int *pids = archive.getSection<int>(pidsKey, &nPIDs);
+
+	if (nIds != nInterfaces || nOwners != nInterfaces || nOwnerFaces != nInterfaces ||
+	        nNeighs != nInterfaces || nNeighFaces != nInterfaces || nPIDs != nInterfaces) {
+		throw std::runtime_error("The interface sections of the archive are not consistent.");
+	}
+
+	// Interfaces need up-to-date adjacencies
+	updateAdjacencies();
+
+	// Enable manual adaption
+	AdaptionMode previousAdaptionMode = getAdaptionMode();
+	setAdaptionMode(ADAPTION_MANUAL);
+
+	// Restore interfaces
+	//
+	// Interfaces are appended to the kernel in a single operation following
+	// the order in which they were stored, the kernel of the restored patch
+	// will not contain holes.
+	m_interfaces.emplaceBackRange(nInterfaces, ids);
+	for (std::size_t i = 0; i < nInterfaces; ++i) {
+		long interfaceId = ids[i];
+
+		Cell *owner = &(m_cells.at(owners[i]));
+
+		long neighId = neighs[i];
+		Cell *neigh;
+		if (neighId >= 0) {
+			neigh = &(m_cells.at(neighId));
+		} else {
+			neigh = nullptr;
+		}
+
+		InterfaceIterator interfaceIterator = buildCellInterface(owner, ownerFaces[i], neigh, neighFaces[i], interfaceId);
+		interfaceIterator->setPID(pids[i]);
+	}
+
+	archive.releaseSection(idsKey);
+	archive.releaseSection(ownersKey);
+	archive.releaseSection(ownerFacesKey);
+	archive.releaseSection(neighsKey);
+	archive.releaseSection(neighFacesKey);
+	archive.releaseSection(pidsKey);
+
+	// Interfaces are now updated
+	unsetCellAlterationFlags(FLAG_INTERFACES_DIRTY);
+	m_alteredInterfaces.clear();
+
+	// Update the storage of the cell interfaces
+	updateCellInterfacesStorage();
+
+	// Restore previous adaption mode
+	setAdaptionMode(previousAdaptionMode);
+}
+
+/*!
+	Prepares the patch for performing the adaption.
+
+	Default implementation is a no-op function.
+
+	\param trackAdaption if set to true the function will return the changes
+	that will be performed in the alter step
+	\result If the adaption is tracked, returns a vector of adaption::Info that
+	can be used to discover what changes will be performed in the alter step,
+	otherwise an empty vector will be returned.
+*/
+std::vector<adaption::Info> PatchKernel::_adaptionPrepare(bool trackAdaption)
+{
+	BITPIT_UNUSED(trackAdaption);
+
+	return std::vector<adaption::Info>();
+}
+
+/*!
+	Alter the patch performing the adaption.
+
+	Default implementation is a no-op function.
+
+	\param trackAdaption if set to true the function will return the changes
+	done to the patch during the adaption
+	\result If the adaption is tracked, returns a vector of adaption::Info
+	with all the changes done to the patch during the adaption, otherwise an
+	empty vector will be returned.
+*/
+std::vector<adaption::Info> PatchKernel::_adaptionAlter(bool trackAdaption)
+{
+	BITPIT_UNUSED(trackAdaption);
+
+	assert(false && "The patch needs to implement _adaptionAlter");
+
+	return std::vector<adaption::Info>();
+}
+
+/*!
+	Cleanup patch data structured after the adaption.
+
+	Default implementation is a no-op function.
+*/
+void PatchKernel::_adaptionCleanup()
+{
+}
+
+/*!
+	Marks a cell for refinement.
+
+	Default implementation is a no-op function.
+
+	\param id the cell to be refined
+	\result Returns true if the marker was properly set, false otherwise.
+*/
+bool PatchKernel::_markCellForRefinement(long id)
+{
+	BITPIT_UNUSED(id);
+
+	return false;
+}
+
+/*!
+	Marks a cell for coarsening.
+
+	Default implementation is a no-op function.
+
+	\param id the cell to be refined
+	\result Returns true if the marker was properly set, false otherwise.
+*/
+bool PatchKernel::_markCellForCoarsening(long id)
+{
+	BITPIT_UNUSED(id);
+
+	return false;
+}
+
+/*!
+	Resets the adaption marker of the specified cell.
+
+	Default implementation is a no-op function.
+
+	\param id the cell to be refined
+	\result Returns true if the marker was properly reset, false otherwise.
+*/
+bool PatchKernel::_resetCellAdaptionMarker(long id)
+{
+	BITPIT_UNUSED(id);
+
+	return false;
+}
+
+/*!
+	Returns the adaption marker of the specified cell.
+
 	Default implementation always return an undefined marker.
 
 	\param id is the id of the cell
@@ -5359,6 +6418,9 @@ bool PatchKernel::sortCells()
 	// Synchronize storage
 	m_cells.sync();
 
+	// Point locator is no more valid
+	_resetPointLocator();
+
 	return true;
 }
 
@@ -5379,24 +6441,366 @@ bool PatchKernel::sortInterfaces()
 }
 
 /*!
-	Sorts internal storage for cells, vertices and interfaces in
-	ascending id order.
-*/
-bool PatchKernel::sort()
-{
-	bool status = sortVertices();
-	status |= sortCells();
-	status |= sortInterfaces();
+	Reorders the storage of cells, vertices and interfaces to improve the
+	spatial locality of the data.
 
-	return status;
-}
+	Cells are placed in the storage following the specified ordering, this
+	way cells that are close together in space will also be close together
+	in memory. Vertices and interfaces are then placed in the order in which
+	they are first encountered when the cells are visited in their new order.
+	Vertices and interfaces that don't belong to any cell are placed after
+	the others, sorted in ascending id order. Internal and ghost items are
+	reordered separately. Storages synchronized with the items of the patch
+	will follow the new order.
 
-/*!
-	Requests the patch to compact the vertex data structure and reduce
-	its capacity to fit its size.
+	Optionally, after the storage has been reordered, items can also be
+	renumbered consecutively, so that the order of their ids reflects the
+	order of the storage. Renumbering is not supported for partitioned
+	patches.
 
-	The request is non-binding, and after the function call the vertex
-	data structure can still occupy more memory than it actually needs.
+	\param ordering is the ordering that will be used for cells
+	\param renumber if set to true, vertices, cells and interfaces will be
+	renumbered consecutively starting from zero
+	\param trackReorder if set to true, the changes to the ids of cells and
+	interfaces will be tracked. Since the ids of vertices cannot be tracked,
+	they are not reported
+	\result Returns a vector of adaption::Info that can be used to track
+	the changes to the ids of the cells and interfaces. Each cell or
+	interface whose id has changed is reported using an adaption::Info of
+	type TYPE_RENUMBERING. If the ids were not changed, the vector is empty.
+*/
+std::vector<adaption::Info> PatchKernel::reorder(SpatialOrdering ordering, bool renumber, bool trackReorder)
+{
+	std::vector<adaption::Info> reorderInfo;
+	if (getAdaptionMode() != ADAPTION_MANUAL) {
+		return reorderInfo;
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	if (renumber && isPartitioned()) {
+		throw std::runtime_error("Renumbering of partitioned patches is not supported.");
+	}
+#endif
+
+	// Adjacencies are needed to evaluate the reverse Cuthill-McKee ordering
+	bool temporaryAdjacencies = false;
+	if (ordering == SPATIAL_ORDERING_RCM) {
+		if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+			initializeAdjacencies();
+			temporaryAdjacencies = true;
+		} else {
+			updateAdjacencies();
+		}
+	}
+
+	// Evaluate cell order
+	//
+	// Internal cells and ghost cells are ordered separately.
+	std::vector<long> cellOrder;
+	cellOrder.reserve(getCellCount());
+
+	std::vector<long> rangeIds;
+	rangeIds.reserve(getInternalCellCount());
+	for (CellConstIterator itr = internalCellConstBegin(); itr != internalCellConstEnd(); ++itr) {
+		rangeIds.push_back(itr.getId());
+	}
+
+	std::vector<long> rangeOrder = evalSpatialCellOrder(ordering, rangeIds);
+	cellOrder.insert(cellOrder.end(), rangeOrder.begin(), rangeOrder.end());
+
+#if BITPIT_ENABLE_MPI==1
+	rangeIds.clear();
+	for (CellConstIterator itr = ghostCellConstBegin(); itr != ghostCellConstEnd(); ++itr) {
+		rangeIds.push_back(itr.getId());
+	}
+
+	rangeOrder = evalSpatialCellOrder(ordering, rangeIds);
+	cellOrder.insert(cellOrder.end(), rangeOrder.begin(), rangeOrder.end());
+#endif
+
+	if (temporaryAdjacencies) {
+		destroyAdjacencies();
+	}
+
+	// Evaluate vertex and interface ranks
+	std::unordered_map<long, std::size_t> cellRanks;
+	std::unordered_map<long, std::size_t> vertexRanks;
+	std::unordered_map<long, std::size_t> interfaceRanks;
+
+	cellRanks.reserve(cellOrder.size());
+	vertexRanks.reserve(getVertexCount());
+	interfaceRanks.reserve(getInterfaceCount());
+	for (long cellId : cellOrder) {
+		cellRanks.insert({cellId, cellRanks.size()});
+
+		const Cell &cell = m_cells.at(cellId);
+		for (long vertexId : cell.getVertexIds()) {
+			vertexRanks.insert({vertexId, vertexRanks.size()});
+		}
+
+		int nCellInterfaces = cell.getInterfaceCount();
+		const long *cellInterfaces = cell.getInterfaces();
+		for (int k = 0; k < nCellInterfaces; ++k) {
+			interfaceRanks.insert({cellInterfaces[k], interfaceRanks.size()});
+		}
+	}
+
+	// Reorder the storage
+	auto rankLess = [](const std::unordered_map<long, std::size_t> &ranks) {
+		return [&ranks](long id_1, long id_2) {
+			auto rankItr_1 = ranks.find(id_1);
+			auto rankItr_2 = ranks.find(id_2);
+
+			std::size_t rank_1 = (rankItr_1 != ranks.end()) ? rankItr_1->second : std::numeric_limits<std::size_t>::max();
+			std::size_t rank_2 = (rankItr_2 != ranks.end()) ? rankItr_2->second : std::numeric_limits<std::size_t>::max();
+			if (rank_1 != rank_2) {
+				return (rank_1 < rank_2);
+			}
+
+			return (id_1 < id_2);
+		};
+	};
+
+	auto vertexLess = rankLess(vertexRanks);
+	if (m_nInternalVertices > 0) {
+		m_vertices.sortBefore(m_lastInternalVertexId, true, vertexLess);
+		updateLastInternalVertexId();
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	if (m_nGhostVertices > 0) {
+		m_vertices.sortAfter(m_firstGhostVertexId, true, vertexLess);
+		updateFirstGhostVertexId();
+	}
+#endif
+
+	m_vertices.sync();
+
+	auto cellLess = rankLess(cellRanks);
+	if (m_nInternalCells > 0) {
+		m_cells.sortBefore(m_lastInternalCellId, true, cellLess);
+		updateLastInternalCellId();
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	if (m_nGhostCells > 0) {
+		m_cells.sortAfter(m_firstGhostCellId, true, cellLess);
+		updateFirstGhostCellId();
+	}
+#endif
+
+	m_cells.sync();
+
+	m_interfaces.sort(rankLess(interfaceRanks));
+	m_interfaces.sync();
+
+	// Arenas should follow the new cell order
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		compactCellArenas();
+	}
+
+	// Point locator is no more valid
+	_resetPointLocator();
+
+	// Renumber the items
+	if (renumber) {
+		if (trackReorder) {
+			long cellCounter = 0;
+			for (const Cell &cell : m_cells) {
+				long previousId = cell.getId();
+				long currentId  = cellCounter++;
+				if (previousId == currentId) {
+					continue;
+				}
+
+				reorderInfo.emplace_back(adaption::TYPE_RENUMBERING, adaption::ENTITY_CELL);
+				reorderInfo.back().previous.push_back(previousId);
+				reorderInfo.back().current.push_back(currentId);
+			}
+
+			long interfaceCounter = 0;
+			for (const Interface &interface : m_interfaces) {
+				long previousId = interface.getId();
+				long currentId  = interfaceCounter++;
+				if (previousId == currentId) {
+					continue;
+				}
+
+				reorderInfo.emplace_back(adaption::TYPE_RENUMBERING, adaption::ENTITY_INTERFACE);
+				reorderInfo.back().previous.push_back(previousId);
+				reorderInfo.back().current.push_back(currentId);
+			}
+		}
+
+		consecutiveRenumber(0, 0, 0);
+	}
+
+	return reorderInfo;
+}
+
+/*!
+	Evaluates the spatial order of the specified cells.
+
+	When the reverse Cuthill-McKee ordering is requested, only adjacencies
+	between the specified cells are considered and the adjacencies of the
+	patch should be up-to-date. Each connected component of the adjacency
+	graph is visited in breadth-first order starting from a cell with the
+	minimum number of neighbours, neighbours are visited in increasing
+	number of neighbours. The resulting order is then reversed.
+
+	\param ordering is the ordering that will be evaluated
+	\param cellIds are the ids of the cells
+	\result The ids of the specified cells, sorted according to the
+	requested ordering.
+*/
+std::vector<long> PatchKernel::evalSpatialCellOrder(SpatialOrdering ordering, const std::vector<long> &cellIds) const
+{
+	std::size_t nCells = cellIds.size();
+
+	std::vector<long> cellOrder;
+	cellOrder.reserve(nCells);
+
+	switch (ordering) {
+
+	case SPATIAL_ORDERING_HILBERT:
+	case SPATIAL_ORDERING_MORTON:
+	{
+		// Evaluate cell centroids
+		std::vector<std::array<double, 3>> centroids(nCells);
+
+		static const std::size_t CHUNK_SIZE = 1024;
+		std::size_t nChunks = (nCells + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+			std::size_t chunkBegin = chunk * CHUNK_SIZE;
+			std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nCells);
+			for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+				centroids[i] = evalCellCentroid(cellIds[i]);
+			}
+		});
+
+		// Sort the cells along the curve
+		std::vector<std::size_t> order;
+		if (ordering == SPATIAL_ORDERING_HILBERT) {
+			utils::sfc::computeHilbertOrder(nCells, centroids.data(), &order);
+		} else {
+			utils::sfc::computeMortonOrder(nCells, centroids.data(), &order);
+		}
+
+		for (std::size_t i : order) {
+			cellOrder.push_back(cellIds[i]);
+		}
+
+		break;
+	}
+
+	case SPATIAL_ORDERING_RCM:
+	{
+		// Evaluate the degree of the cells
+		std::unordered_map<long, std::size_t> cellIndexes;
+		cellIndexes.reserve(nCells);
+		for (std::size_t i = 0; i < nCells; ++i) {
+			cellIndexes.insert({cellIds[i], i});
+		}
+
+		std::vector<int> degrees(nCells, 0);
+		for (std::size_t i = 0; i < nCells; ++i) {
+			const Cell &cell = m_cells.at(cellIds[i]);
+			int nCellAdjacencies = cell.getAdjacencyCount();
+			const long *cellAdjacencies = cell.getAdjacencies();
+			for (int k = 0; k < nCellAdjacencies; ++k) {
+				if (cellIndexes.count(cellAdjacencies[k]) > 0) {
+					++degrees[i];
+				}
+			}
+		}
+
+		auto degreeLess = [&degrees](std::size_t i, std::size_t j) {
+			if (degrees[i] != degrees[j]) {
+				return (degrees[i] < degrees[j]);
+			}
+
+			return (i < j);
+		};
+
+		// Candidate starting cells are processed in increasing degree order
+		std::vector<std::size_t> seeds(nCells);
+		std::iota(seeds.begin(), seeds.end(), 0);
+		std::sort(seeds.begin(), seeds.end(), degreeLess);
+
+		// Visit the connected components in breadth-first order
+		//
+		// The output list is also used as the queue of the visit.
+		std::vector<bool> visited(nCells, false);
+		std::vector<std::size_t> neighs;
+		for (std::size_t seed : seeds) {
+			if (visited[seed]) {
+				continue;
+			}
+
+			visited[seed] = true;
+			cellOrder.push_back(cellIds[seed]);
+			for (std::size_t head = cellOrder.size() - 1; head < cellOrder.size(); ++head) {
+				const Cell &cell = m_cells.at(cellOrder[head]);
+				int nCellAdjacencies = cell.getAdjacencyCount();
+				const long *cellAdjacencies = cell.getAdjacencies();
+
+				neighs.clear();
+				for (int k = 0; k < nCellAdjacencies; ++k) {
+					auto indexItr = cellIndexes.find(cellAdjacencies[k]);
+					if (indexItr == cellIndexes.end()) {
+						continue;
+					}
+
+					std::size_t neighIndex = indexItr->second;
+					if (visited[neighIndex]) {
+						continue;
+					}
+
+					visited[neighIndex] = true;
+					neighs.push_back(neighIndex);
+				}
+
+				std::sort(neighs.begin(), neighs.end(), degreeLess);
+				for (std::size_t neighIndex : neighs) {
+					cellOrder.push_back(cellIds[neighIndex]);
+				}
+			}
+		}
+
+		std::reverse(cellOrder.begin(), cellOrder.end());
+
+		break;
+	}
+
+	default:
+	{
+		throw std::runtime_error("Unsupported spatial ordering.");
+	}
+
+	}
+
+	return cellOrder;
+}
+
+/*!
+	Sorts internal storage for cells, vertices and interfaces in
+	ascending id order.
+*/
+bool PatchKernel::sort()
+{
+	bool status = sortVertices();
+	status |= sortCells();
+	status |= sortInterfaces();
+
+	return status;
+}
+
+/*!
+	Requests the patch to compact the vertex data structure and reduce
+	its capacity to fit its size.
+
+	The request is non-binding, and after the function call the vertex
+	data structure can still occupy more memory than it actually needs.
 */
 bool PatchKernel::squeezeVertices()
 {
@@ -5428,6 +6832,12 @@ bool PatchKernel::squeezeCells()
 
 	m_cells.sync();
 
+	_resetPointLocator();
+
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		compactCellArenas();
+	}
+
 	return true;
 }
 
@@ -5448,6 +6858,10 @@ bool PatchKernel::squeezeInterfaces()
 
 	m_interfaces.sync();
 
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		compactInterfaceConnectArena();
+	}
+
 	return true;
 }
 
@@ -5486,11 +6900,18 @@ bool PatchKernel::squeeze()
 /*!
 	Evaluates the centroid of the specified cell.
 
+	If the geometry cache is enabled and up-to-date, the cached centroid
+	is returned.
+
 	\param id is the id of the cell
 	\result The centroid of the specified cell.
 */
 std::array<double, 3> PatchKernel::evalCellCentroid(long id) const
 {
+	if (isGeometryCacheUpToDate()) {
+		return getCachedCellCentroid(id);
+	}
+
 	const Cell &cell = getCell(id);
 
 	return evalElementCentroid(cell);
@@ -5853,707 +7274,2280 @@ long PatchKernel::locatePoint(double x, double y, double z) const
 }
 
 /*!
- * Check whether the face "face_A" on cell "cell_A" is the same as the face
- * "face_B" on cell "cell_B".
- * 
- * \param[in] cell_A is the first cell
- * \param[in] face_A is the face on the first cell
- * \param[in] cell_B is the the second cell
- * \param[in] face_B is the face on the second cell
- * \result Returns true if the two faces are the same.
+	Locates the cells that contain the specified points.
+
+	Points are processed following their order along a space-filling curve,
+	this way points that are close together are located one after the other
+	and the data accessed while locating a point is likely to be reused for
+	locating the following one.
+
+	\param[in] nPoints is the number of points
+	\param[in] points are the points to be checked
+	\param[out] ids on output will contain the ids of the cells that contain
+	the points. If a point is not inside the patch, the related id will be
+	set to the id of the null element
 */
-bool PatchKernel::isSameFace(const Cell &cell_A, int face_A, const Cell &cell_B, int face_B) const
+void PatchKernel::locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const
 {
-	if (cell_A.getFaceType(face_A) != cell_B.getFaceType(face_B)) {
-		return false;
-	}
-
-	int nFaceVertices = cell_A.getFaceVertexCount(face_A);
+	std::vector<std::size_t> order;
+	utils::sfc::computeMortonOrder(nPoints, points, &order);
 
-	std::vector<long> faceVertexIds_A(nFaceVertices);
-	std::vector<long> faceVertexIds_B(nFaceVertices);
-	for (int k = 0; k < nFaceVertices; ++k) {
-		faceVertexIds_A[k] = cell_A.getFaceVertexId(face_A, k);
-		faceVertexIds_B[k] = cell_B.getFaceVertexId(face_B, k);
+	for (std::size_t i : order) {
+		ids[i] = locatePoint(points[i]);
 	}
-
-	std::sort(faceVertexIds_A.begin(), faceVertexIds_A.end());
-	std::sort(faceVertexIds_B.begin(), faceVertexIds_B.end());
-
-	return (faceVertexIds_A == faceVertexIds_B);
 }
 
 /*!
-	Returns the current adjacencies build strategy.
+	Evaluates the memory used by the patch.
 
-	\return The current adjacencies build strategy.
+	See getMemoryUsageBreakdown() for the details about how the memory is
+	evaluated.
+
+	\result The memory, expressed in bytes, used by the patch.
 */
-PatchKernel::AdjacenciesBuildStrategy PatchKernel::getAdjacenciesBuildStrategy() const
+std::size_t PatchKernel::getMemoryUsage() const
 {
-	return m_adjacenciesBuildStrategy;
+	std::size_t memoryUsage = 0;
+	for (const auto &entry : getMemoryUsageBreakdown()) {
+		memoryUsage += entry.second;
+	}
+
+	return memoryUsage;
 }
 
 /*!
-	Set the current adjacencies build strategy.
+	Evaluates the memory used by the components of the patch.
 
-	\param status is the adjacencies build strategy that will be set
-*/
-void PatchKernel::setAdjacenciesBuildStrategy(AdjacenciesBuildStrategy status)
-{
-	m_adjacenciesBuildStrategy = status;
-}
+	The memory of a component includes the memory allocated by its
+	containers, including the space reserved for holes and for future
+	insertions, and the memory dynamically allocated by the items stored
+	in the containers (e.g., connectivity, adjacencies and interfaces of
+	the cells). The memory allocated by hash tables cannot be accessed
+	directly and is estimated. The memory occupied by the patch object
+	itself is not included.
 
-/*!
-	Checks if the adjacencies are dirty.
+	All the components are listed, even if they don't use any memory, this
+	way patches of the same type always return the same list of components.
 
-	\param global if set to true, the dirty status will be evaluated globally
-	across all the partitions
-	\result Returns true if the adjacencies are dirty, false otherwise.
+	\result The memory, expressed in bytes, used by the components of the
+	patch.
 */
-bool PatchKernel::areAdjacenciesDirty(bool global) const
+std::map<std::string, std::size_t> PatchKernel::getMemoryUsageBreakdown() const
 {
-	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
-		return false;
+	std::map<std::string, std::size_t> breakdown;
+
+	// Vertices
+	breakdown["vertices"] = m_vertices.getMemoryUsage();
+
+	// Cells
+	std::size_t cellMemory = m_cells.getMemoryUsage();
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		cellMemory += m_cellConnectArena->getMemoryUsage();
+		cellMemory += m_cellAdjacenciesArena->getMemoryUsage();
+		cellMemory += m_cellInterfacesArena->getMemoryUsage();
+	}
+	for (const Cell &cell : m_cells) {
+		cellMemory += cell.getMemoryUsage();
 	}
 
-	bool areDirty = false;
-	for (const auto &entry : m_alteredCells) {
-		AlterationFlags cellAlterationFlags = entry.second;
-		if (testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
-			areDirty = true;
-			break;
+	breakdown["cells"] = cellMemory;
+
+	// Interfaces
+	std::size_t interfaceMemory = m_interfaces.getMemoryUsage();
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		interfaceMemory += m_interfaceConnectArena->getMemoryUsage();
+	}
+	for (const Interface &interface : m_interfaces) {
+		interfaceMemory += interface.getMemoryUsage();
+	}
+
+	breakdown["interfaces"] = interfaceMemory;
+
+	// Alteration flags
+	breakdown["alteration flags"] = utils::getMemoryUsage(m_alteredCells) + utils::getMemoryUsage(m_alteredInterfaces);
+
+	// Geometry cache
+	std::size_t geometryCacheMemory = 0;
+	for (const std::unique_ptr<PiercedStorage<double, long>> &cache : m_cellGeometryCache) {
+		if (cache) {
+			geometryCacheMemory += cache->getMemoryUsage();
+		}
+	}
+
+	for (const std::unique_ptr<PiercedStorage<double, long>> &cache : m_interfaceGeometryCache) {
+		if (cache) {
+			geometryCacheMemory += cache->getMemoryUsage();
 		}
 	}
 
+	breakdown["geometry cache"] = geometryCacheMemory;
+
+	// Vertex incidence
+	std::size_t vertexIncidenceMemory = utils::getMemoryUsage(m_vertexIncidenceCells);
+	if (m_vertexIncidenceRows) {
+		vertexIncidenceMemory += m_vertexIncidenceRows->getMemoryUsage();
+	}
+
+	breakdown["vertex incidence"] = vertexIncidenceMemory;
+
+	// VTK
+	breakdown["vtk"] = m_vtkVertexMap.getMemoryUsage();
+
 #if BITPIT_ENABLE_MPI==1
-	if (global && isPartitioned()) {
-		const auto &communicator = getCommunicator();
-		MPI_Allreduce(MPI_IN_PLACE, &areDirty, 1, MPI_C_BOOL, MPI_LOR, communicator);
+	// Ghost exchange information
+	std::size_t ghostMemory = 0;
+	ghostMemory += utils::getMemoryUsage(m_ghostVertexInfo);
+	ghostMemory += utils::getMemoryUsage(m_ghostCellInfo);
+	ghostMemory += utils::getMemoryUsage(m_partitioningOutgoings);
+	ghostMemory += utils::getMemoryUsage(m_partitioningGlobalExchanges);
+	for (const std::unordered_map<int, std::vector<long>> *exchangeData : {&m_ghostVertexExchangeTargets, &m_ghostVertexExchangeSources,
+	                                                                      &m_ghostCellExchangeTargets, &m_ghostCellExchangeSources}) {
+		ghostMemory += utils::getMemoryUsage(*exchangeData);
+		for (const auto &entry : *exchangeData) {
+			ghostMemory += utils::getMemoryUsage(entry.second);
+		}
 	}
-#else
-	BITPIT_UNUSED(global);
+
+	breakdown["ghost exchange"] = ghostMemory;
 #endif
 
-	return areDirty;
+	// Components defined by the specific patch
+	_getMemoryUsageBreakdown(&breakdown);
+
+	return breakdown;
 }
 
 /*!
-	Fill adjacencies info for each cell.
+	Internal function to evaluate the memory used by the components defined
+	by the specific patch.
 
-	If adjacencies are already built, all adjacencies will be deleted and
-	they will be re-generated from scratch.
+	Patches that allocate additional data structures should override this
+	function and add their components to the breakdown. All the components
+	should be added, even if they don't use any memory.
+
+	The default implementation does nothing.
+
+	\param[in,out] breakdown on output will contain also the memory used by
+	the components defined by the specific patch
 */
-void PatchKernel::buildAdjacencies()
+void PatchKernel::_getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const
 {
-    initializeAdjacencies(ADJACENCIES_AUTOMATIC);
+	BITPIT_UNUSED(breakdown);
 }
 
 /*!
-	Initialize the adjacencies using the specified build strategy.
+	Internal function to reset the data structures used for locating points.
 
-	If the current strategy doesn't match the requested strategy, all
-	adjacencies will be deleted and they will be re-generated from scratch.
+	The function is called when the patch is altered in bulk in a way that
+	invalidates the data structures used for locating points (for example,
+	cells are reset, cell storage is sorted or squeezed, or the patch is
+	transformed). Patches that keep such data structures should override
+	this function and release them, the data structures can then be
+	re-created when a point needs to be located.
 
-	\param strategy is the build strategy that will be used
+	Alterations that involve a single cell (i.e., cells are added, restored
+	or deleted) don't call this function, they only update the revision
+	returned by getPointLocatorRevision(). Patches should check the revision
+	before using the data structures and re-create them if the revision has
+	changed since they were built.
+
+	The default implementation does nothing.
 */
-void PatchKernel::initializeAdjacencies(AdjacenciesBuildStrategy strategy)
+void PatchKernel::_resetPointLocator()
 {
-	// Get current build stategy
-	AdjacenciesBuildStrategy currentStrategy = getAdjacenciesBuildStrategy();
+}
 
-	// Early return if we don't need adjacencies
-	if (strategy == ADJACENCIES_NONE) {
-		if (currentStrategy != ADJACENCIES_NONE) {
-			destroyAdjacencies();
-		}
+/*!
+	Gets the revision of the cells used by the data structures for
+	locating points.
+
+	The revision changes every time a cell is added, restored or deleted.
+	Data structures built for a different revision are no longer valid.
+
+	\result The revision of the cells used by the data structures for
+	locating points.
+*/
+std::size_t PatchKernel::getPointLocatorRevision() const
+{
+	return m_pointLocatorRevision;
+}
+
+/*!
+	Invalidates the data structures used for locating points.
+
+	This function is called for every cell that is added, restored or
+	deleted, hence it only updates the revision of the cells used by the
+	point locator. The data structures will be re-created the next time
+	a point needs to be located.
+*/
+void PatchKernel::invalidatePointLocator()
+{
+	++m_pointLocatorRevision;
+}
 
+/*!
+	Gets the mode used for storing the connectivity of cells and interfaces.
+
+	\result The mode used for storing the connectivity of cells and
+	interfaces.
+*/
+PatchKernel::ConnectivityStorageMode PatchKernel::getConnectivityStorageMode() const
+{
+	return m_connectivityStorageMode;
+}
+
+/*!
+	Sets the mode used for storing the connectivity of cells and interfaces.
+
+	By default, each element owns the storage of its connectivity and each
+	cell owns the storage of its adjacencies and of its interfaces, this
+	means that every element performs separate memory allocations. When
+	the connectivity is stored in the patch, the patch owns contiguous
+	memory areas (the arenas) for the connectivity of the cells, for the
+	adjacencies of the cells, for the interfaces of the cells and for the
+	connectivity of the interfaces. Elements will then reference their
+	data through an offset inside the arenas. Storing the connectivity in
+	the patch reduces the number of memory allocations and improves data
+	locality when traversing the elements.
+
+	When an element is added to the patch, its connectivity is appended
+	to the arena. Adding an element never reallocates the arena: if the
+	arena has not enough capacity, the element keeps its own storage until
+	the arena is compacted. The same happens to the adjacencies and to the
+	interfaces of the cells when they are updated. Altering the number of
+	adjacencies or interfaces of a cell moves them out of the arena. Data
+	of deleted elements is not removed from the arenas until the arenas
+	are compacted. Arenas are compacted when the alterations of the patch
+	are finalized (i.e., when the patch is updated) and when the patch is
+	squeezed or sorted. Data will then be stored following the order of
+	the elements inside the patch. Since elements store offsets, they are
+	not affected by the compaction, however pointers to element data
+	obtained before the compaction are invalidated.
+
+	Elements copied out of the patch will own a copy of their data.
+
+	\param mode is the mode used for storing the connectivity of cells
+	and interfaces
+*/
+void PatchKernel::setConnectivityStorageMode(ConnectivityStorageMode mode)
+{
+	if (mode == m_connectivityStorageMode) {
 		return;
 	}
 
-	// Update the build strategy
-	if (currentStrategy != strategy) {
-		setAdjacenciesBuildStrategy(strategy);
+	if (mode == CONNECTIVITY_STORAGE_PATCH) {
+		storeConnectivityInPatch();
+	} else {
+		storeConnectivityInElements();
 	}
 
-	// Reset adjacencies
-	resetAdjacencies();
+	m_connectivityStorageMode = mode;
+}
 
-	// Update the adjacencies
-	updateAdjacencies();
+/*!
+	Moves the connectivity, the adjacencies and the interfaces of the
+	elements into the arenas of the patch.
+
+	Arenas are created if they don't exist.
+*/
+void PatchKernel::storeConnectivityInPatch()
+{
+	if (!m_cellConnectArena) {
+		m_cellConnectArena = std::unique_ptr<ElementArena>(new ElementArena());
+	}
+
+	if (!m_cellAdjacenciesArena) {
+		m_cellAdjacenciesArena = std::unique_ptr<ElementArena>(new ElementArena());
+	}
+
+	if (!m_cellInterfacesArena) {
+		m_cellInterfacesArena = std::unique_ptr<ElementArena>(new ElementArena());
+	}
+
+	if (!m_interfaceConnectArena) {
+		m_interfaceConnectArena = std::unique_ptr<ElementArena>(new ElementArena());
+	}
+
+	compactCellArenas();
+	compactInterfaceConnectArena();
 }
 
 /*!
-	Update the adjacencies of the patch.
+	Moves the connectivity, the adjacencies and the interfaces of the
+	elements out of the arenas of the patch.
 
-	\param forcedUpdated if set to true, bounding box information will be
-	updated also if they are not marked as dirty
+	After calling this function, each element will own its data and the
+	arenas will be destroyed.
 */
-void PatchKernel::updateAdjacencies(bool forcedUpdated)
+void PatchKernel::storeConnectivityInElements()
 {
-	// Early return if adjacencies are not built
-	AdjacenciesBuildStrategy currentStrategy = getAdjacenciesBuildStrategy();
-	if (currentStrategy == ADJACENCIES_NONE) {
+	releaseConnectArena(m_cells);
+	releaseCellNeighbourhoodArena(&Cell::m_adjacencies);
+	releaseCellNeighbourhoodArena(&Cell::m_interfaces);
+	releaseConnectArena(m_interfaces);
+
+	m_cellConnectArena.reset();
+	m_cellAdjacenciesArena.reset();
+	m_cellInterfacesArena.reset();
+	m_interfaceConnectArena.reset();
+}
+
+/*!
+	Updates the storage of the connectivity of the specified cell.
+
+	If the connectivity is stored in the patch, the connectivity of the
+	cell will be moved into the cell connectivity arena.
+
+	\param cell is the cell
+*/
+void PatchKernel::updateCellConnectStorage(Cell &cell)
+{
+	if (m_connectivityStorageMode != CONNECTIVITY_STORAGE_PATCH) {
 		return;
 	}
 
-	// Check if the adjacencies are dirty
-	bool adjacenciesDirty = areAdjacenciesDirty();
-	if (!adjacenciesDirty && !forcedUpdated) {
+	storeConnectInArena(cell, m_cellConnectArena.get());
+}
+
+/*!
+	Updates the storage of the connectivity of the specified interface.
+
+	If the connectivity is stored in the patch, the connectivity of the
+	interface will be moved into the interface connectivity arena.
+
+	\param interface is the interface
+*/
+void PatchKernel::updateInterfaceConnectStorage(Interface &interface)
+{
+	if (m_connectivityStorageMode != CONNECTIVITY_STORAGE_PATCH) {
 		return;
 	}
 
-	// Update adjacencies
-	if (adjacenciesDirty) {
-		// Prune stale adjacencies
-		pruneStaleAdjacencies();
+	storeConnectInArena(interface, m_interfaceConnectArena.get());
+}
 
-		// Update adjacencies
-		_updateAdjacencies();
+/*!
+	Detaches the specified cell from the arenas of the patch.
 
-		// Adjacencies are now updated
-		unsetCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
-	} else {
-		initializeAdjacencies(currentStrategy);
+	Deleted cells are kept by the container until their position is reused,
+	since the arenas may be compacted in the meantime, deleted cells should
+	not reference the arenas. Storage owned by the cell is not released.
+
+	\param cell is the cell
+*/
+void PatchKernel::unsetCellArenaStorage(Cell &cell)
+{
+	if (m_connectivityStorageMode != CONNECTIVITY_STORAGE_PATCH) {
+		return;
+	}
+
+	if (cell.hasArenaConnect()) {
+		cell.unsetConnect();
+	}
+
+	if (cell.m_adjacencies.isStoredInArena()) {
+		cell.m_adjacencies.destroy();
+	}
+
+	if (cell.m_interfaces.isStoredInArena()) {
+		cell.m_interfaces.destroy();
 	}
 }
 
 /*!
-	Destroy the adjacencies.
+	Detaches the specified interface from the arenas of the patch.
 
-	After deleting the adjacencies, this function changes the build strategy
-	to "None".
+	Deleted interfaces are kept by the container until their position is
+	reused, since the arenas may be compacted in the meantime, deleted
+	interfaces should not reference the arenas. Storage owned by the
+	interface is not released.
+
+	\param interface is the interface
 */
-void PatchKernel::destroyAdjacencies()
+void PatchKernel::unsetInterfaceArenaStorage(Interface &interface)
 {
-	// Early return if no adjacencies have been built
-	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+	if (m_connectivityStorageMode != CONNECTIVITY_STORAGE_PATCH) {
 		return;
 	}
 
-	// Destroy the adjacencies
-	_resetAdjacencies(true);
+	if (interface.hasArenaConnect()) {
+		interface.unsetConnect();
+	}
+}
 
-	// Clear list of cells with dirty adjacencies
-	unsetCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
+/*!
+	Updates the storage of the adjacencies of the cells.
 
-	// Set adjacencies status
-	setAdjacenciesBuildStrategy(ADJACENCIES_NONE);
+	If the connectivity is stored in the patch, the adjacencies that are
+	owned by the cells will be moved into the cell adjacencies arena.
+*/
+void PatchKernel::updateCellAdjacenciesStorage()
+{
+	if (m_connectivityStorageMode != CONNECTIVITY_STORAGE_PATCH) {
+		return;
+	}
+
+	storeCellNeighbourhoodInArena(&Cell::m_adjacencies, m_cellAdjacenciesArena.get());
 }
 
 /*!
-	Reset the adjacencies.
+	Updates the storage of the interfaces of the cells.
 
-	This function doesn't change the build strategy, it only resets the
-	existing adjacencies.
+	If the connectivity is stored in the patch, the interfaces that are
+	owned by the cells will be moved into the cell interfaces arena.
 */
-void PatchKernel::resetAdjacencies()
+void PatchKernel::updateCellInterfacesStorage()
 {
-	// Early return if no adjacencies have been built
-	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+	if (m_connectivityStorageMode != CONNECTIVITY_STORAGE_PATCH) {
 		return;
 	}
 
-	// Reset adjacencies
-	_resetAdjacencies(false);
+	storeCellNeighbourhoodInArena(&Cell::m_interfaces, m_cellInterfacesArena.get());
+}
 
-	// All cells have now dirty adjacencies
-	setCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
+/*!
+	Compacts all the arenas that contain cell data.
+*/
+void PatchKernel::compactCellArenas()
+{
+	compactCellConnectArena();
+	compactCellAdjacenciesArena();
+	compactCellInterfacesArena();
 }
 
 /*!
-	Internal function to reset the adjacencies.
+	Compacts the cell connectivity arena.
 
-	This function doesn't change the alteration flags.
+	The connectivity of all the cells, including the connectivity that is
+	waiting to be moved into the arena, is stored contiguously following
+	the order of the cells inside the patch. Pointers to the connectivity
+	of the cells obtained before the compaction are invalidated.
 
-	\param release if it's true the memory hold by the adjacencies will be
-	released, otherwise the adjacencies will be reset but their memory will
-	not be relased
+	\param extraCapacity is the additional capacity that will be reserved
+	in the arena
 */
-void PatchKernel::_resetAdjacencies(bool release)
+void PatchKernel::compactCellConnectArena(std::size_t extraCapacity)
 {
-	for (Cell &cell : m_cells) {
-		cell.resetAdjacencies(!release);
-	}
+	compactConnectArena(m_cells, m_cellConnectArena.get(), extraCapacity);
 }
 
 /*!
-	Prune stale adjacencies.
+	Compacts the cell adjacencies arena.
 
-	The list of cells to process and the list of stale adjacencies are filled
-	during cell deletion.
+	The adjacencies of all the cells, including the adjacencies that are
+	waiting to be moved into the arena, are stored contiguously following
+	the order of the cells inside the patch. Pointers to the adjacencies
+	of the cells obtained before the compaction are invalidated.
+
+	\param extraCapacity is the additional capacity that will be reserved
+	in the arena
 */
-void PatchKernel::pruneStaleAdjacencies()
+void PatchKernel::compactCellAdjacenciesArena(std::size_t extraCapacity)
 {
-	// Early return if adjacencies are not built
-	AdjacenciesBuildStrategy currentStrategy = getAdjacenciesBuildStrategy();
-	if (currentStrategy == ADJACENCIES_NONE) {
-		return;
-	}
+	compactCellNeighbourhoodArena(&Cell::m_adjacencies, m_cellAdjacenciesArena.get(), extraCapacity);
+}
 
-	// Remove stale adjacencies
-	for (const auto &entry : m_alteredCells) {
-		AlterationFlags cellAlterationFlags = entry.second;
-		if (!testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
-			continue;
-		}
+/*!
+	Compacts the cell interfaces arena.
 
-		long cellId = entry.first;
-		Cell &cell = m_cells.at(cellId);
-		if (cell.getAdjacencyCount() == 0) {
-			continue;
-		}
+	The interfaces of all the cells, including the interfaces that are
+	waiting to be moved into the arena, are stored contiguously following
+	the order of the cells inside the patch. Pointers to the interfaces
+	of the cells obtained before the compaction are invalidated.
 
-		int nCellFaces = cell.getFaceCount();
-		for (int face = nCellFaces - 1; face >= 0; --face) {
-			long *faceAdjacencies = cell.getAdjacencies(face);
-			int nFaceAdjacencies = cell.getAdjacencyCount(face);
-			for (int i = nFaceAdjacencies - 1; i >= 0; --i) {
-				long adjacency = faceAdjacencies[i];
-				if (!testCellAlterationFlags(adjacency, FLAG_DELETED)) {
-					continue;
-				}
+	\param extraCapacity is the additional capacity that will be reserved
+	in the arena
+*/
+void PatchKernel::compactCellInterfacesArena(std::size_t extraCapacity)
+{
+	compactCellNeighbourhoodArena(&Cell::m_interfaces, m_cellInterfacesArena.get(), extraCapacity);
+}
 
-				cell.deleteAdjacency(face, i);
-			}
-		}
-	}
+/*!
+	Compacts the interface connectivity arena.
+
+	The connectivity of all the interfaces, including the connectivity
+	that is waiting to be moved into the arena, is stored contiguously
+	following the order of the interfaces inside the patch. Pointers to
+	the connectivity of the interfaces obtained before the compaction are
+	invalidated.
+
+	\param extraCapacity is the additional capacity that will be reserved
+	in the arena
+*/
+void PatchKernel::compactInterfaceConnectArena(std::size_t extraCapacity)
+{
+	compactConnectArena(m_interfaces, m_interfaceConnectArena.get(), extraCapacity);
 }
 
 /*!
-	Internal function to update the adjacencies of the patch.
+	Stores the specified neighbourhood (adjacencies or interfaces) of the
+	cells in the specified arena.
 
-	In addition to the cells whose adjacencies are marked as dirty, also the
-	adjacencies of their neighbours will be updated.
+	Neighbourhoods that don't fit in the arena are left in the storage of
+	the cells and they are added to the pending values of the arena. If
+	there are pending values, the arena is compacted reserving some extra
+	capacity for future updates.
 
-	This implementation can NOT handle hanging nodes.
+	\param neighbourhood is the neighbourhood that will be stored
+	\param arena is the arena
 */
-void PatchKernel::_updateAdjacencies()
+void PatchKernel::storeCellNeighbourhoodInArena(ArenaFlatVector2D Cell::*neighbourhood, ElementArena *arena)
 {
-	int dimension = getDimension();
+	for (Cell &cell : m_cells) {
+		(cell.*neighbourhood).storeInArena(arena);
+	}
 
-	// Check if multiple adjacencies are allowed
-	//
-	// On a three-dimensional patch each internal face is shared between two,
-	// and only two, half-faces. On lower dimension patches one internal face
-	// may be shared among multiple half-faces (this happens with non-manifold
-	// patches).
-	bool multipleMatchesAllowed = (dimension < 3);
+	if (arena->getPendingSize() > 0) {
+		compactCellNeighbourhoodArena(neighbourhood, arena, getArenaGrowth(*arena));
+	}
+}
 
-	// Define matching windings
-	//
-	// If faces can be shared only between two half-faces, there is a one-to-one
-	// correspondence between the half-faces. Give one half-faces, its matching
-	// can be found looking for an half-faces with the same vertices but with
-	// reverse vertex winding order.
-	//
-	// If faces can be shared among more than two half-faces, it's not anymore
-	// possible to define a unique winding order for the vertices of the faces.
-	// There is no more a one-to-one correspondence between pairs of half-face.
-	// In this case, when looking for half-face correspondence, it is necessary
-	// to look for half-faces with reverse vertex winding order and also for
-	// half-faces with the same vertex winding order.
-	std::vector<CellHalfFace::Winding> matchingWindings;
-	matchingWindings.push_back(CellHalfFace::WINDING_REVERSE);
-	if (multipleMatchesAllowed) {
-		matchingWindings.push_back(CellHalfFace::WINDING_NATURAL);
+/*!
+	Compacts the arena that contains the specified neighbourhood
+	(adjacencies or interfaces) of the cells.
+
+	\param neighbourhood is the neighbourhood that will be stored
+	\param arena is the arena
+	\param extraCapacity is the additional capacity that will be reserved
+	in the arena
+*/
+void PatchKernel::compactCellNeighbourhoodArena(ArenaFlatVector2D Cell::*neighbourhood, ElementArena *arena, std::size_t extraCapacity)
+{
+	std::size_t arenaSize = 0;
+	for (const Cell &cell : m_cells) {
+		arenaSize += (cell.*neighbourhood).getArenaSize();
 	}
 
-	// Count cells with dirty adjacencies
-	long nDirtyAdjacenciesCells = 0;
-	for (const auto &entry : m_alteredCells) {
-		AlterationFlags cellAlterationFlags = entry.second;
-		if (!testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
+	std::vector<long> values;
+	values.reserve(arenaSize + extraCapacity);
+	for (Cell &cell : m_cells) {
+		ArenaFlatVector2D &cellNeighbourhood = cell.*neighbourhood;
+
+		std::size_t recordSize = cellNeighbourhood.getArenaSize();
+		if (recordSize == 0) {
 			continue;
 		}
 
-		++nDirtyAdjacenciesCells;
+		std::size_t offset = values.size();
+		values.resize(offset + recordSize);
+		cellNeighbourhood.writeArenaRecord(values.data() + offset);
+		cellNeighbourhood.setArena(arena, offset);
 	}
 
-	// Get the vertices of cells with dirty adjacencies
-	//
-	// The list is only needed if multiple matches are allowed and there are
-	// cells whose adjacencies don't need to be updated.
-	std::unique_ptr<PiercedStorage<bool, long>> dirtyAdjacenciesVertices;
+	arena->assign(std::move(values));
+}
+
+/*!
+	Moves the specified neighbourhood (adjacencies or interfaces) of the
+	cells out of the arena.
+
+	\param neighbourhood is the neighbourhood that will be released
+*/
+void PatchKernel::releaseCellNeighbourhoodArena(ArenaFlatVector2D Cell::*neighbourhood)
+{
+	for (Cell &cell : m_cells) {
+		(cell.*neighbourhood).releaseArena();
+	}
+}
+
+/*!
+	Evaluates the extra capacity that should be reserved when compacting
+	the specified arena.
+
+	The growth is geometric, this way the cost of the compactions is
+	amortized when elements are added incrementally.
+
+	\param arena is the arena
+	\result The extra capacity that should be reserved when compacting
+	the specified arena.
+*/
+std::size_t PatchKernel::getArenaGrowth(const ElementArena &arena)
+{
+	return std::max(arena.getPendingSize(), arena.size() / 2);
+}
+
+/*!
+ * Check whether the face "face_A" on cell "cell_A" is the same as the face
+ * "face_B" on cell "cell_B".
+ * 
+ * \param[in] cell_A is the first cell
+ * \param[in] face_A is the face on the first cell
+ * \param[in] cell_B is the the second cell
+ * \param[in] face_B is the face on the second cell
+ * \result Returns true if the two faces are the same.
+*/
+bool PatchKernel::isSameFace(const Cell &cell_A, int face_A, const Cell &cell_B, int face_B) const
+{
+	if (cell_A.getFaceType(face_A) != cell_B.getFaceType(face_B)) {
+		return false;
+	}
+
+	int nFaceVertices = cell_A.getFaceVertexCount(face_A);
+
+	std::vector<long> faceVertexIds_A(nFaceVertices);
+	std::vector<long> faceVertexIds_B(nFaceVertices);
+	for (int k = 0; k < nFaceVertices; ++k) {
+		faceVertexIds_A[k] = cell_A.getFaceVertexId(face_A, k);
+		faceVertexIds_B[k] = cell_B.getFaceVertexId(face_B, k);
+	}
+
+	std::sort(faceVertexIds_A.begin(), faceVertexIds_A.end());
+	std::sort(faceVertexIds_B.begin(), faceVertexIds_B.end());
+
+	return (faceVertexIds_A == faceVertexIds_B);
+}
+
+/*!
+	Returns the current adjacencies build strategy.
+
+	\return The current adjacencies build strategy.
+*/
+PatchKernel::AdjacenciesBuildStrategy PatchKernel::getAdjacenciesBuildStrategy() const
+{
+	return m_adjacenciesBuildStrategy;
+}
+
+/*!
+	Set the current adjacencies build strategy.
+
+	\param status is the adjacencies build strategy that will be set
+*/
+void PatchKernel::setAdjacenciesBuildStrategy(AdjacenciesBuildStrategy status)
+{
+	m_adjacenciesBuildStrategy = status;
+}
+
+/*!
+	Checks if the adjacencies are dirty.
+
+	\param global if set to true, the dirty status will be evaluated globally
+	across all the partitions
+	\result Returns true if the adjacencies are dirty, false otherwise.
+*/
+bool PatchKernel::areAdjacenciesDirty(bool global) const
+{
+	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+		return false;
+	}
+
+	bool areDirty = false;
+	for (const auto &entry : m_alteredCells) {
+		AlterationFlags cellAlterationFlags = entry.second;
+		if (testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
+			areDirty = true;
+			break;
+		}
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	if (global && isPartitioned()) {
+		const auto &communicator = getCommunicator();
+		MPI_Allreduce(MPI_IN_PLACE, &areDirty, 1, MPI_C_BOOL, MPI_LOR, communicator);
+	}
+#else
+	BITPIT_UNUSED(global);
+#endif
+
+	return areDirty;
+}
+
+/*!
+	Fill adjacencies info for each cell.
+
+	If adjacencies are already built, all adjacencies will be deleted and
+	they will be re-generated from scratch.
+*/
+void PatchKernel::buildAdjacencies()
+{
+    initializeAdjacencies(ADJACENCIES_AUTOMATIC);
+}
+
+/*!
+	Initialize the adjacencies using the specified build strategy.
+
+	If the current strategy doesn't match the requested strategy, all
+	adjacencies will be deleted and they will be re-generated from scratch.
+
+	Using the automatic strategy, matching faces are identified inserting
+	the faces into a hash table, one face at a time. Using the sorted
+	strategy, a key is evaluated concurrently for all the faces and the
+	faces are then sorted by key, matching faces will be next to each
+	other in the sorted list. The sorted strategy scales with the number
+	of threads available (see utils::threads) and it is usually faster
+	when building the adjacencies of a large number of cells. Patches that
+	don't use the generic algorithm for evaluating the adjacencies (e.g.,
+	Cartesian and octree patches) handle both strategies in the same way.
+
+	\param strategy is the build strategy that will be used
+*/
+void PatchKernel::initializeAdjacencies(AdjacenciesBuildStrategy strategy)
+{
+	// Get current build stategy
+	AdjacenciesBuildStrategy currentStrategy = getAdjacenciesBuildStrategy();
+
+	// Early return if we don't need adjacencies
+	if (strategy == ADJACENCIES_NONE) {
+		if (currentStrategy != ADJACENCIES_NONE) {
+			destroyAdjacencies();
+		}
+
+		return;
+	}
+
+	// Update the build strategy
+	if (currentStrategy != strategy) {
+		setAdjacenciesBuildStrategy(strategy);
+	}
+
+	// Reset adjacencies
+	resetAdjacencies();
+
+	// Update the adjacencies
+	updateAdjacencies();
+}
+
+/*!
+	Update the adjacencies of the patch.
+
+	\param forcedUpdated if set to true, bounding box information will be
+	updated also if they are not marked as dirty
+*/
+void PatchKernel::updateAdjacencies(bool forcedUpdated)
+{
+	// Early return if adjacencies are not built
+	AdjacenciesBuildStrategy currentStrategy = getAdjacenciesBuildStrategy();
+	if (currentStrategy == ADJACENCIES_NONE) {
+		return;
+	}
+
+	// Check if the adjacencies are dirty
+	bool adjacenciesDirty = areAdjacenciesDirty();
+	if (!adjacenciesDirty && !forcedUpdated) {
+		return;
+	}
+
+	// Update adjacencies
+	if (adjacenciesDirty) {
+		// Prune stale adjacencies
+		pruneStaleAdjacencies();
+
+		// Update adjacencies
+		_updateAdjacencies();
+
+		// Adjacencies are now updated
+		unsetCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
+
+		// Update the storage of the adjacencies
+		updateCellAdjacenciesStorage();
+	} else {
+		initializeAdjacencies(currentStrategy);
+	}
+}
+
+/*!
+	Destroy the adjacencies.
+
+	After deleting the adjacencies, this function changes the build strategy
+	to "None".
+*/
+void PatchKernel::destroyAdjacencies()
+{
+	// Early return if no adjacencies have been built
+	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+		return;
+	}
+
+	// Destroy the adjacencies
+	_resetAdjacencies(true);
+
+	// Clear list of cells with dirty adjacencies
+	unsetCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
+
+	// Set adjacencies status
+	setAdjacenciesBuildStrategy(ADJACENCIES_NONE);
+}
+
+/*!
+	Reset the adjacencies.
+
+	This function doesn't change the build strategy, it only resets the
+	existing adjacencies.
+*/
+void PatchKernel::resetAdjacencies()
+{
+	// Early return if no adjacencies have been built
+	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+		return;
+	}
+
+	// Reset adjacencies
+	_resetAdjacencies(false);
+
+	// All cells have now dirty adjacencies
+	setCellAlterationFlags(FLAG_ADJACENCIES_DIRTY);
+}
+
+/*!
+	Internal function to reset the adjacencies.
+
+	This function doesn't change the alteration flags.
+
+	\param release if it's true the memory hold by the adjacencies will be
+	released, otherwise the adjacencies will be reset but their memory will
+	not be relased
+*/
+void PatchKernel::_resetAdjacencies(bool release)
+{
+	for (Cell &cell : m_cells) {
+		cell.resetAdjacencies(!release);
+	}
+
+	if (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH) {
+		m_cellAdjacenciesArena->clear(release);
+	}
+}
+
+/*!
+	Prune stale adjacencies.
+
+	The list of cells to process and the list of stale adjacencies are filled
+	during cell deletion.
+*/
+void PatchKernel::pruneStaleAdjacencies()
+{
+	// Early return if adjacencies are not built
+	AdjacenciesBuildStrategy currentStrategy = getAdjacenciesBuildStrategy();
+	if (currentStrategy == ADJACENCIES_NONE) {
+		return;
+	}
+
+	// Remove stale adjacencies
+	for (const auto &entry : m_alteredCells) {
+		AlterationFlags cellAlterationFlags = entry.second;
+		if (!testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
+			continue;
+		}
+
+		long cellId = entry.first;
+		Cell &cell = m_cells.at(cellId);
+		if (cell.getAdjacencyCount() == 0) {
+			continue;
+		}
+
+		int nCellFaces = cell.getFaceCount();
+		for (int face = nCellFaces - 1; face >= 0; --face) {
+			long *faceAdjacencies = cell.getAdjacencies(face);
+			int nFaceAdjacencies = cell.getAdjacencyCount(face);
+			for (int i = nFaceAdjacencies - 1; i >= 0; --i) {
+				long adjacency = faceAdjacencies[i];
+				if (!testCellAlterationFlags(adjacency, FLAG_DELETED)) {
+					continue;
+				}
+
+				cell.deleteAdjacency(face, i);
+			}
+		}
+	}
+}
+
+/*!
+	Internal function to update the adjacencies of the patch.
+
+	In addition to the cells whose adjacencies are marked as dirty, also the
+	adjacencies of their neighbours will be updated.
+
+	This implementation can NOT handle hanging nodes.
+*/
+void PatchKernel::_updateAdjacencies()
+{
+	int dimension = getDimension();
+
+	// Check if multiple adjacencies are allowed
+	//
+	// On a three-dimensional patch each internal face is shared between two,
+	// and only two, half-faces. On lower dimension patches one internal face
+	// may be shared among multiple half-faces (this happens with non-manifold
+	// patches).
+	bool multipleMatchesAllowed = (dimension < 3);
+
+	// Define matching windings
+	//
+	// If faces can be shared only between two half-faces, there is a one-to-one
+	// correspondence between the half-faces. Give one half-faces, its matching
+	// can be found looking for an half-faces with the same vertices but with
+	// reverse vertex winding order.
+	//
+	// If faces can be shared among more than two half-faces, it's not anymore
+	// possible to define a unique winding order for the vertices of the faces.
+	// There is no more a one-to-one correspondence between pairs of half-face.
+	// In this case, when looking for half-face correspondence, it is necessary
+	// to look for half-faces with reverse vertex winding order and also for
+	// half-faces with the same vertex winding order.
+	std::vector<CellHalfFace::Winding> matchingWindings;
+	matchingWindings.push_back(CellHalfFace::WINDING_REVERSE);
+	if (multipleMatchesAllowed) {
+		matchingWindings.push_back(CellHalfFace::WINDING_NATURAL);
+	}
+
+	// Count cells with dirty adjacencies
+	long nDirtyAdjacenciesCells = 0;
+	for (const auto &entry : m_alteredCells) {
+		AlterationFlags cellAlterationFlags = entry.second;
+		if (!testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
+			continue;
+		}
+
+		++nDirtyAdjacenciesCells;
+	}
+
+	// Get the vertices of cells with dirty adjacencies
+	//
+	// The list is only needed if multiple matches are allowed and there are
+	// cells whose adjacencies don't need to be updated.
+	std::unique_ptr<PiercedStorage<bool, long>> dirtyAdjacenciesVertices;
 	if (multipleMatchesAllowed && (nDirtyAdjacenciesCells != getCellCount())) {
 		dirtyAdjacenciesVertices = std::unique_ptr<PiercedStorage<bool, long>>(new PiercedStorage<bool, long>(1, &m_vertices));
 		dirtyAdjacenciesVertices->fill(false);
 		for (const auto &entry : m_alteredCells) {
 			AlterationFlags cellAlterationFlags = entry.second;
-			if (!testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
-				continue;
+			if (!testAlterationFlags(cellAlterationFlags, FLAG_ADJACENCIES_DIRTY)) {
+				continue;
+			}
+
+			long cellId = entry.first;
+			const Cell &cell = m_cells.at(cellId);
+			ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+			for (long vertexId : cellVertexIds) {
+				dirtyAdjacenciesVertices->at(vertexId) = true;
+			}
+		}
+	}
+
+	// List the cells that needs to be processed
+	//
+	// The list should contain the cells whose adjacencies need to be updated
+	// and their neighbours candidates.
+	//
+	// Cells whose adjacencies needs to be updated are cells having the dirty
+	// adjaceny flag set.
+	//
+	// Neighbours candidates are all border cells and, if multiple matches are
+	// allowed, cells that share vertices with a cell with dirty adjacencies.
+	std::vector<Cell *> processList;
+	processList.reserve(nDirtyAdjacenciesCells);
+
+	std::size_t nMaxHalfFaces = 0;
+	for (Cell &cell : m_cells) {
+		// Get cell information
+		long cellId = cell.getId();
+		int nCellFaces = cell.getFaceCount();
+
+		// Add cells with dirty adjacencies
+		if (testCellAlterationFlags(cellId, FLAG_ADJACENCIES_DIRTY)) {
+			nMaxHalfFaces += nCellFaces;
+			processList.push_back(&cell);
+			continue;
+		}
+
+		// Add border cells
+		bool isBorderCell = false;
+		for (int face = 0; face < nCellFaces; face++) {
+			if (cell.isFaceBorder(face)) {
+				isBorderCell = true;
+				continue;
+			}
+		}
+
+		if (isBorderCell) {
+			nMaxHalfFaces += nCellFaces;
+			processList.push_back(&cell);
+			continue;
+		}
+
+		// Add cell that share vertices with a cell with dirty adjacencies
+		//
+		// For performace reasons, the check is a bit rough. All cells that
+		// share a number of vertices at least equal to the dimension af the
+		// patch will be added to the process list. This will add also cells
+		// that are not neighbour candidates, but it's faster to add some false
+		// positives, rather trying to filter them out.
+		if (multipleMatchesAllowed) {
+			ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+
+			int nCelldirtyAdjacenciesVertices = 0;
+			bool futureNeighbourCandidate = false;
+			for (long vertexId : cellVertexIds) {
+				if (dirtyAdjacenciesVertices->at(vertexId)) {
+					++nCelldirtyAdjacenciesVertices;
+					if (nCelldirtyAdjacenciesVertices >= dimension) {
+						futureNeighbourCandidate = true;
+						break;
+					}
+				}
+			}
+
+			if (futureNeighbourCandidate) {
+				nMaxHalfFaces += nCellFaces;
+				processList.push_back(&cell);
+			}
+		}
+	}
+
+	// Create the adjacencies
+	if (getAdjacenciesBuildStrategy() == ADJACENCIES_SORTED) {
+		matchSortedHalfFaces(processList, matchingWindings, multipleMatchesAllowed);
+		return;
+	}
+
+	std::unordered_set<CellHalfFace, CellHalfFace::Hasher> halfFaces;
+	halfFaces.reserve(static_cast<std::size_t>(0.5 * nMaxHalfFaces));
+
+	std::vector<std::pair<Cell *, int>> matchingAdjacencies;
+	for (Cell *cell : processList) {
+		long cellId = cell->getId();
+		const int nCellFaces = cell->getFaceCount();
+		bool areCellAdjacenciesDirty = testCellAlterationFlags(cellId, FLAG_ADJACENCIES_DIRTY);
+		for (int face = 0; face < nCellFaces; face++) {
+			// Generate the half-face
+			CellHalfFace halfFace(*cell, face);
+
+			// Find matching half-face
+			auto matchingHalfFaceItr = halfFaces.end();
+			for (CellHalfFace::Winding winding : matchingWindings) {
+				// Set winding order
+				halfFace.setWinding(winding);
+
+				// Search for matching half-face
+				matchingHalfFaceItr = halfFaces.find(halfFace);
+				if (matchingHalfFaceItr != halfFaces.end()) {
+					break;
+				}
+			}
+
+			// Early return if no matching half-face has been found
+			//
+			// If no matching half-face has been found, we need to add the
+			// current half-face to the list because it may match the face
+			// of a cell that will be processed later.
+			if (matchingHalfFaceItr == halfFaces.end()) {
+				halfFace.setWinding(CellHalfFace::WINDING_NATURAL);
+				halfFaces.insert(std::move(halfFace));
+				continue;
+			}
+
+			// Get matching half-face information
+			const CellHalfFace &matchingHalfFace = *matchingHalfFaceItr;
+			Cell &matchingCell  = matchingHalfFace.getCell();
+			long matchingCellId = matchingCell.getId();
+			long matchingFace   = matchingHalfFace.getFace();
+
+			// Only process cells with dirty adjacencies
+			//
+			// In order to limit the half faces that need to be stored, we are
+			// processing at the same time cells with dirty adjacencies and
+			// their neighbour candidates. This means we will also find matches
+			// between faces of cell whose adjacensies are already up-to-date.
+			bool areMatchingCellAdjacenciesDirty = testCellAlterationFlags(matchingCellId, FLAG_ADJACENCIES_DIRTY);
+			if (!areCellAdjacenciesDirty && !areMatchingCellAdjacenciesDirty) {
+				continue;
+			}
+
+			// Identifty matching adjacencies
+			//
+			// If multiple matches are allowed, in addition to the entry
+			// related to the matching half face, we also need to add the
+			// entries associated to the adjacencies already identified
+			// for the half face.
+			matchingAdjacencies.clear();
+			matchingAdjacencies.emplace_back(std::make_pair<Cell *, int>(&matchingCell, matchingFace));
+			if (multipleMatchesAllowed) {
+				const int nMachingFaceNeighs = matchingCell.getAdjacencyCount(matchingFace);
+				const long *machingFaceNeighs = matchingCell.getAdjacencies(matchingFace);
+				for (int k = 0; k < nMachingFaceNeighs; ++k) {
+					long neighId = machingFaceNeighs[k];
+					if (neighId == cellId) {
+						continue;
+					}
+
+					Cell &neigh = m_cells.at(neighId);
+					int neighFace = findAdjoinNeighFace(matchingCell, matchingFace, neigh);
+					matchingAdjacencies.emplace_back(std::make_pair<Cell *, int>(&neigh, std::move(neighFace)));
+				}
+			} else {
+				// When cell adjacencies are makred dirty this means that some
+				// adjacencies are dirty not that all adjacencies are dirty.
+				// The matchin cell may have no adjaceny associated to the
+				// matching face or a signle adjacency that should match
+				// the current cell.
+				assert(matchingCell.getAdjacencyCount(matchingFace) == 0 || (matchingCell.getAdjacencyCount(matchingFace) == 1 && (*(matchingCell.getAdjacencies(matchingFace)) == cellId)));
+			}
+
+			// Create adjacencies
+			for (const std::pair<Cell *, int> &matchingAdjacency : matchingAdjacencies) {
+				Cell *adjacentCell = matchingAdjacency.first;
+				long adjacentCellId = adjacentCell->getId();
+				int adjacentFace = matchingAdjacency.second;
+
+				cell->pushAdjacency(face, adjacentCellId);
+				adjacentCell->pushAdjacency(adjacentFace, cellId);
+			}
+
+			// Remove the matching half-face from the list
+			//
+			// If multiple matches are allowed, we need to keep the half
+			// face, because that entry may match the face of a cell that
+			// will be processed later.
+			if (!multipleMatchesAllowed) {
+				halfFaces.erase(matchingHalfFaceItr);
+			}
+		}
+	}
+}
+
+/*!
+	Creates the adjacencies among the cells of the process list sorting
+	their half-faces.
+
+	A key that doesn't depend on the winding order of the vertices is
+	evaluated concurrently for all the half-faces of the cells in the
+	process list. Half-faces are then sorted by key: since matching
+	half-faces have the same key, they will be next to each other in the
+	sorted list. Finally, half-faces with the same key are compared to
+	identify the matching ones (different half-faces may have the same key
+	when there is a hash collision).
+
+	Only adjacencies that involve at least a cell with dirty adjacencies
+	are created.
+
+	\param processList is the list of cells that will be processed, it
+	should contain the cells whose adjacencies need to be updated and
+	their neighbour candidates
+	\param matchingWindings are the windings used for identifying matching
+	half-faces
+	\param multipleMatchesAllowed controls if a face can be shared among
+	more than two half-faces
+*/
+void PatchKernel::matchSortedHalfFaces(const std::vector<Cell *> &processList,
+                                       const std::vector<CellHalfFace::Winding> &matchingWindings,
+                                       bool multipleMatchesAllowed)
+{
+	struct HalfFaceEntry {
+		std::size_t key;
+		std::size_t cellIndex;
+		int face;
+
+		bool operator<(const HalfFaceEntry &other) const
+		{
+			return std::tie(key, cellIndex, face) < std::tie(other.key, other.cellIndex, other.face);
+		}
+	};
+
+	// Evaluate the offsets of the half-faces of each cell
+	std::size_t nProcessedCells = processList.size();
+
+	std::vector<std::size_t> halfFaceOffsets(nProcessedCells + 1);
+	std::vector<bool> dirtyAdjacencies(nProcessedCells);
+	halfFaceOffsets[0] = 0;
+	for (std::size_t i = 0; i < nProcessedCells; ++i) {
+		const Cell *cell = processList[i];
+		halfFaceOffsets[i + 1] = halfFaceOffsets[i] + cell->getFaceCount();
+		dirtyAdjacencies[i] = testCellAlterationFlags(cell->getId(), FLAG_ADJACENCIES_DIRTY);
+	}
+
+	// Evaluate the keys of the half-faces
+	//
+	// The key is the smallest between the hashes evaluated using the natural
+	// and the reverse winding order, hence the key doesn't depend on the
+	// winding order of the vertices.
+	std::size_t nHalfFaces = halfFaceOffsets.back();
+	std::vector<HalfFaceEntry> halfFaceEntries(nHalfFaces);
+
+	static const std::size_t CHUNK_SIZE = 1024;
+	std::size_t nChunks = (nProcessedCells + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+		CellHalfFace::Hasher hasher;
+
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nProcessedCells);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			Cell &cell = *(processList[i]);
+			const int nCellFaces = cell.getFaceCount();
+			for (int face = 0; face < nCellFaces; ++face) {
+				CellHalfFace halfFace(cell, face);
+				std::size_t naturalHash = hasher(halfFace);
+				halfFace.setWinding(CellHalfFace::WINDING_REVERSE);
+				std::size_t reverseHash = hasher(halfFace);
+
+				HalfFaceEntry &entry = halfFaceEntries[halfFaceOffsets[i] + face];
+				entry.key       = std::min(naturalHash, reverseHash);
+				entry.cellIndex = i;
+				entry.face      = face;
+			}
+		}
+	});
+
+	// Sort the half-faces
+	utils::threads::parallelSort(halfFaceEntries.begin(), halfFaceEntries.end());
+
+	// Create the adjacencies
+	//
+	// Half-faces with the same key are grouped together. Within each group,
+	// all the pairs of matching half-faces are identified. Adjacencies are
+	// created only if at least one of the involved cells has dirty
+	// adjacencies. If multiple matches are not allowed, each half-face can
+	// only match a single other half-face.
+	std::vector<bool> matched;
+	std::size_t groupBegin = 0;
+	while (groupBegin < nHalfFaces) {
+		std::size_t groupKey = halfFaceEntries[groupBegin].key;
+		std::size_t groupEnd = groupBegin + 1;
+		while (groupEnd < nHalfFaces && halfFaceEntries[groupEnd].key == groupKey) {
+			++groupEnd;
+		}
+
+		std::size_t groupSize = groupEnd - groupBegin;
+		if (groupSize > 1) {
+			matched.assign(groupSize, false);
+			for (std::size_t n = 0; n < groupSize; ++n) {
+				if (matched[n] && !multipleMatchesAllowed) {
+					continue;
+				}
+
+				const HalfFaceEntry &entry = halfFaceEntries[groupBegin + n];
+				Cell &cell = *(processList[entry.cellIndex]);
+				CellHalfFace halfFace(cell, entry.face);
+
+				for (std::size_t m = n + 1; m < groupSize; ++m) {
+					if (matched[m] && !multipleMatchesAllowed) {
+						continue;
+					}
+
+					const HalfFaceEntry &otherEntry = halfFaceEntries[groupBegin + m];
+					Cell &otherCell = *(processList[otherEntry.cellIndex]);
+					CellHalfFace otherHalfFace(otherCell, otherEntry.face);
+
+					bool isMatching = false;
+					for (CellHalfFace::Winding winding : matchingWindings) {
+						otherHalfFace.setWinding(winding);
+						if (halfFace == otherHalfFace) {
+							isMatching = true;
+							break;
+						}
+					}
+
+					if (!isMatching) {
+						continue;
+					}
+
+					if (dirtyAdjacencies[entry.cellIndex] || dirtyAdjacencies[otherEntry.cellIndex]) {
+						cell.pushAdjacency(entry.face, otherCell.getId());
+						otherCell.pushAdjacency(otherEntry.face, cell.getId());
+					}
+
+					matched[n] = true;
+					matched[m] = true;
+					if (!multipleMatchesAllowed) {
+						break;
+					}
+				}
+			}
+		}
+
+		groupBegin = groupEnd;
+	}
+}
+
+/*!
+	Returns the current interfaces build strategy.
+
+	\return The current interfaces build strategy.
+*/
+PatchKernel::InterfacesBuildStrategy PatchKernel::getInterfacesBuildStrategy() const
+{
+	return m_interfacesBuildStrategy;
+}
+
+/*!
+	Set the current interfaces build strategy.
+
+	\param status is the interfaces build strategy that will be set
+*/
+void PatchKernel::setInterfacesBuildStrategy(InterfacesBuildStrategy status)
+{
+	if (status == INTERFACES_AUTOMATIC) {
+		if (!isInterfaceAutoIndexingEnabled()) {
+			throw std::runtime_error("Automatic build strategy requires auto-indexing.");
+		}
+	}
+
+	m_interfacesBuildStrategy = status;
+}
+
+/*!
+	Checks if the interfaces are dirty.
+
+	\param global if set to true, the dirty status will be evaluated globally
+	across all the partitions
+	\result Returns true if the interfaces are dirty, false otherwise.
+*/
+bool PatchKernel::areInterfacesDirty(bool global) const
+{
+	if (getInterfacesBuildStrategy() == INTERFACES_NONE) {
+		return false;
+	}
+
+	bool areDirty = !m_alteredInterfaces.empty();
+	if (!areDirty) {
+		for (const auto &entry : m_alteredCells) {
+			AlterationFlags cellAlterationFlags = entry.second;
+			if (testAlterationFlags(cellAlterationFlags, FLAG_INTERFACES_DIRTY)) {
+				areDirty = true;
+				break;
+			}
+		}
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	if (global && isPartitioned()) {
+		const auto &communicator = getCommunicator();
+		MPI_Allreduce(MPI_IN_PLACE, &areDirty, 1, MPI_C_BOOL, MPI_LOR, communicator);
+	}
+#else
+	BITPIT_UNUSED(global);
+#endif
+
+	return areDirty;
+}
+
+/*!
+	Build interfaces among the cells.
+
+	If interfaces are already built, all interfaces will be deleted and
+	they will be re-generated from scratch.
+*/
+void PatchKernel::buildInterfaces()
+{
+    initializeInterfaces(INTERFACES_AUTOMATIC);
+}
+
+/*!
+	Initialize the interfaces using the specified build strategy.
+
+	If the current strategy doesn't match the requested strategy, all
+	interfaces will be deleted and they will be re-generated from scratch.
+
+	Adjacencies are a mandatory requirement for building interfaces, if the
+	adjacencies are not yet initialized an exception is thrown.
+
+	\param strategy is the build strategy that will be used
+*/
+void PatchKernel::initializeInterfaces(InterfacesBuildStrategy strategy)
+{
+	// Interfaces need adjacencies
+	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
+		throw std::runtime_error ("Adjacencies are mandatory for building the interfaces.");
+	}
+
+	// Get current build stategy
+	InterfacesBuildStrategy currentStrategy = getInterfacesBuildStrategy();
+
+	// Early return if we don't need interfaces
+	if (strategy == INTERFACES_NONE) {
+		if (currentStrategy != INTERFACES_NONE) {
+			destroyInterfaces();
+		}
+
+		return;
+	}
+
+	// Update the build strategy
+	if (currentStrategy != strategy) {
+		setInterfacesBuildStrategy(strategy);
+	}
+
+	// Reset interfaces
+	resetInterfaces();
+
+	// Update the interfaces
+	updateInterfaces();
+}
+
+/*!
+	Update the interfaces of the patch.
+
+	\param forcedUpdated if set to true, bounding box information will be
+	updated also if they are not marked as dirty
+*/
+void PatchKernel::updateInterfaces(bool forcedUpdated)
+{
+	// Early return if interfaces are not built
+	InterfacesBuildStrategy currentStrategy = getInterfacesBuildStrategy();
+	if (currentStrategy == INTERFACES_NONE) {
+		return;
+	}
+
+	// Check if the interfaces are dirty
+	bool interfacesDirty = areInterfacesDirty();
+	if (!interfacesDirty && !forcedUpdated) {
+		return;
+	}
+
+	// Interfaces need up-to-date adjacencies
+	assert(getAdjacenciesBuildStrategy() != ADJACENCIES_NONE);
+	updateAdjacencies();
+
+	// Update interfaces
+	if (interfacesDirty) {
+		// Enable manual adaption
+		AdaptionMode previousAdaptionMode = getAdaptionMode();
+		setAdaptionMode(ADAPTION_MANUAL);
+
+		// Prune stale interfaces
+		pruneStaleInterfaces();
+
+		// Update interfaces
+		_updateInterfaces();
+
+		// Interfaces are now updated
+		unsetCellAlterationFlags(FLAG_INTERFACES_DIRTY);
+		m_alteredInterfaces.clear();
+
+		// Update the storage of the cell interfaces
+		updateCellInterfacesStorage();
+
+		// Restore previous adaption mode
+		setAdaptionMode(previousAdaptionMode);
+	} else {
+		initializeInterfaces(currentStrategy);
+	}
+}
+
+/*!
+	Destroy the interfaces.
+
+	After deleting the interfaces, this function changes the build strategy
+	to "None".
+*/
+void PatchKernel::destroyInterfaces()
+{
+	// Early return if no interfaces have been built
+	if (getInterfacesBuildStrategy() == INTERFACES_NONE) {
+		return;
+	}
+
+	// Destroy the interfaces
+	_resetInterfaces(true);
+
+	// Clear list of cells with dirty interfaces
+	unsetCellAlterationFlags(FLAG_INTERFACES_DIRTY);
+
+	// Clear list of altered interfaces
+	m_alteredInterfaces.clear();
+
+	// Set interface build strategy
+	setInterfacesBuildStrategy(INTERFACES_NONE);
+}
+
+/*!
+	Checks if the geometry cache is enabled.
+
+	\result Returns true if the geometry cache is enabled, false otherwise.
+*/
+bool PatchKernel::isGeometryCacheEnabled() const
+{
+	return m_geometryCacheEnabled;
+}
+
+/*!
+	Checks if the geometry cache is dirty.
+
+	The cache is dirty if it contains entries that have to be re-evaluated,
+	for example because cells have been added to the patch or because the
+	patch has been transformed.
+
+	\param global if set to true, the dirty status will be evaluated globally
+	across all the partitions
+	\result Returns true if the geometry cache is dirty, false otherwise.
+*/
+bool PatchKernel::isGeometryCacheDirty(bool global) const
+{
+	if (!isGeometryCacheEnabled()) {
+		return false;
+	}
+
+	bool isDirty = m_geometryCacheStale || !m_geometryCacheDirtyInterfaces.empty();
+	if (!isDirty) {
+		for (const auto &entry : m_alteredCells) {
+			AlterationFlags cellAlterationFlags = entry.second;
+			if (testAlterationFlags(cellAlterationFlags, FLAG_GEOMETRY_DIRTY) || testAlterationFlags(cellAlterationFlags, FLAG_DANGLING)) {
+				isDirty = true;
+				break;
 			}
+		}
+	}
 
-			long cellId = entry.first;
-			const Cell &cell = m_cells.at(cellId);
-			ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
-			for (long vertexId : cellVertexIds) {
-				dirtyAdjacenciesVertices->at(vertexId) = true;
-			}
+#if BITPIT_ENABLE_MPI==1
+	if (global && isPartitioned()) {
+		const auto &communicator = getCommunicator();
+		MPI_Allreduce(MPI_IN_PLACE, &isDirty, 1, MPI_C_BOOL, MPI_LOR, communicator);
+	}
+#else
+	BITPIT_UNUSED(global);
+#endif
+
+	return isDirty;
+}
+
+/*!
+	Initializes the geometry cache.
+
+	The geometry cache stores geometrical information of cells and interfaces
+	(for example, the centroids of the cells). Each geometrical quantity is
+	stored in a separate storage, one storage for each component, hence the
+	values of a component for all cells are contiguous in memory.
+
+	Once initialized, the cache is kept up-to-date during the update of the
+	patch: only the entries of the elements that have been altered are
+	re-evaluated. While the cache is up-to-date, the functions that evaluate
+	the cached quantities (e.g., evalCellCentroid) return the cached values.
+	The cache cannot track changes to the coordinates of the vertices
+	performed directly on the vertices, after such changes the cache should
+	be updated explicitly forcing the update.
+
+	If the cache is already initialized, all its entries will be re-evaluated.
+*/
+void PatchKernel::initializeGeometryCache()
+{
+	// Create the storages
+	if (!isGeometryCacheEnabled()) {
+		std::size_t nCellFields = getCellGeometryCacheFieldCount();
+		m_cellGeometryCache.resize(nCellFields);
+		for (std::size_t n = 0; n < nCellFields; ++n) {
+			m_cellGeometryCache[n] = std::unique_ptr<PiercedStorage<double, long>>(new PiercedStorage<double, long>(1, &m_cells, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
 		}
+
+		std::size_t nInterfaceFields = getInterfaceGeometryCacheFieldCount();
+		m_interfaceGeometryCache.resize(nInterfaceFields);
+		for (std::size_t n = 0; n < nInterfaceFields; ++n) {
+			m_interfaceGeometryCache[n] = std::unique_ptr<PiercedStorage<double, long>>(new PiercedStorage<double, long>(1, &m_interfaces, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+		}
+
+		m_geometryCacheEnabled = true;
 	}
 
-	// List the cells that needs to be processed
-	//
-	// The list should contain the cells whose adjacencies need to be updated
-	// and their neighbours candidates.
-	//
-	// Cells whose adjacencies needs to be updated are cells having the dirty
-	// adjaceny flag set.
-	//
-	// Neighbours candidates are all border cells and, if multiple matches are
-	// allowed, cells that share vertices with a cell with dirty adjacencies.
-	std::vector<Cell *> processList;
-	processList.reserve(nDirtyAdjacenciesCells);
+	// Evaluate the cache
+	updateGeometryCache(true);
+}
 
-	std::size_t nMaxHalfFaces = 0;
-	for (Cell &cell : m_cells) {
-		// Get cell information
-		long cellId = cell.getId();
-		int nCellFaces = cell.getFaceCount();
+/*!
+	Updates the geometry cache.
 
-		// Add cells with dirty adjacencies
-		if (testCellAlterationFlags(cellId, FLAG_ADJACENCIES_DIRTY)) {
-			nMaxHalfFaces += nCellFaces;
-			processList.push_back(&cell);
-			continue;
+	Only the entries of the elements that have been altered will be
+	re-evaluated: cells that have been added or restored, interfaces
+	of those cells or of cells that were adjacent to deleted cells and
+	interfaces that have been added or restored (for example, because
+	the interfaces have been built after enabling the cache).
+
+	\param forcedUpdated if set to true, all the entries of the cache will be
+	re-evaluated, also if the cache is not marked as dirty
+*/
+void PatchKernel::updateGeometryCache(bool forcedUpdated)
+{
+	// Early return if the cache is not enabled
+	if (!isGeometryCacheEnabled()) {
+		return;
+	}
+
+	// Check if the cache is dirty
+	bool geometryCacheDirty = isGeometryCacheDirty();
+	if (!geometryCacheDirty && !forcedUpdated) {
+		m_geometryCacheUpToDate = true;
+		return;
+	}
+
+	// Entries will be re-evaluated, the functions that evaluate geometrical
+	// quantities should not use the cached values.
+	m_geometryCacheUpToDate = false;
+
+	// Interfaces need to be up-to-date
+	updateInterfaces();
+
+	// Identify the elements to update
+	std::vector<long> cellIds;
+	std::vector<long> interfaceIds;
+	if (forcedUpdated || m_geometryCacheStale) {
+		cellIds.reserve(m_cells.size());
+		for (const Cell &cell : m_cells) {
+			cellIds.push_back(cell.getId());
 		}
 
-		// Add border cells
-		bool isBorderCell = false;
-		for (int face = 0; face < nCellFaces; face++) {
-			if (cell.isFaceBorder(face)) {
-				isBorderCell = true;
+		interfaceIds.reserve(m_interfaces.size());
+		for (const Interface &interface : m_interfaces) {
+			interfaceIds.push_back(interface.getId());
+		}
+	} else {
+		for (const auto &entry : m_alteredCells) {
+			AlterationFlags cellAlterationFlags = entry.second;
+			if (testAlterationFlags(cellAlterationFlags, FLAG_DELETED)) {
 				continue;
 			}
+
+			bool cellGeometryDirty = testAlterationFlags(cellAlterationFlags, FLAG_GEOMETRY_DIRTY);
+			bool cellDangling      = testAlterationFlags(cellAlterationFlags, FLAG_DANGLING);
+			if (!cellGeometryDirty && !cellDangling) {
+				continue;
+			}
+
+			long cellId = entry.first;
+			if (cellGeometryDirty) {
+				cellIds.push_back(cellId);
+			}
+
+			const Cell &cell = m_cells.at(cellId);
+			const int nCellInterfaces = cell.getInterfaceCount();
+			const long *cellInterfaces = cell.getInterfaces();
+			interfaceIds.insert(interfaceIds.end(), cellInterfaces, cellInterfaces + nCellInterfaces);
 		}
 
-		if (isBorderCell) {
-			nMaxHalfFaces += nCellFaces;
-			processList.push_back(&cell);
-			continue;
+		for (long interfaceId : m_geometryCacheDirtyInterfaces) {
+			if (m_interfaces.exists(interfaceId)) {
+				interfaceIds.push_back(interfaceId);
+			}
 		}
 
-		// Add cell that share vertices with a cell with dirty adjacencies
-		//
-		// For performace reasons, the check is a bit rough. All cells that
-		// share a number of vertices at least equal to the dimension af the
-		// patch will be added to the process list. This will add also cells
-		// that are not neighbour candidates, but it's faster to add some false
-		// positives, rather trying to filter them out.
-		if (multipleMatchesAllowed) {
-			ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+		std::sort(interfaceIds.begin(), interfaceIds.end());
+		interfaceIds.erase(std::unique(interfaceIds.begin(), interfaceIds.end()), interfaceIds.end());
+	}
 
-			int nCelldirtyAdjacenciesVertices = 0;
-			bool futureNeighbourCandidate = false;
-			for (long vertexId : cellVertexIds) {
-				if (dirtyAdjacenciesVertices->at(vertexId)) {
-					++nCelldirtyAdjacenciesVertices;
-					if (nCelldirtyAdjacenciesVertices >= dimension) {
-						futureNeighbourCandidate = true;
-						break;
-					}
-				}
-			}
+	// Update the cache
+	_updateGeometryCache(cellIds, interfaceIds);
+
+	// The cache is now updated
+	unsetCellAlterationFlags(FLAG_GEOMETRY_DIRTY);
+	std::vector<long>().swap(m_geometryCacheDirtyInterfaces);
+	m_geometryCacheStale    = false;
+	m_geometryCacheUpToDate = true;
+}
+
+/*!
+	Destroys the geometry cache.
+*/
+void PatchKernel::destroyGeometryCache()
+{
+	// Early return if the cache is not enabled
+	if (!isGeometryCacheEnabled()) {
+		return;
+	}
+
+	// Destroy the storages
+	std::vector<std::unique_ptr<PiercedStorage<double, long>>>().swap(m_cellGeometryCache);
+	std::vector<std::unique_ptr<PiercedStorage<double, long>>>().swap(m_interfaceGeometryCache);
+
+	// Clear the alteration flags
+	unsetCellAlterationFlags(FLAG_GEOMETRY_DIRTY);
+	std::vector<long>().swap(m_geometryCacheDirtyInterfaces);
+
+	// The cache is now disabled
+	m_geometryCacheEnabled  = false;
+	m_geometryCacheStale    = false;
+	m_geometryCacheUpToDate = false;
+}
+
+/*!
+	Gets the centroid of the specified cell.
+
+	If the geometry cache is enabled the cached centroid is returned,
+	otherwise the centroid is evaluated.
+
+	\param id is the id of the cell
+	\result The centroid of the specified cell.
+*/
+std::array<double, 3> PatchKernel::getCachedCellCentroid(long id) const
+{
+	if (!isGeometryCacheEnabled()) {
+		return evalCellCentroid(id);
+	}
+
+	std::size_t rawIndex = m_cells.getRawIndex(id);
+
+	std::array<double, 3> centroid;
+	for (int d = 0; d < 3; ++d) {
+		centroid[d] = getCellGeometryCacheField(GEOMETRY_CACHE_CELL_CENTROID + d).rawAt(rawIndex);
+	}
+
+	return centroid;
+}
+
+/*!
+	Gets the storage that contains the cached values of the specified
+	component of the cell centroids.
+
+	The geometry cache should be enabled, otherwise an exception is thrown.
+
+	\param component is the requested component
+	\result The storage that contains the cached values of the specified
+	component of the cell centroids.
+*/
+const PiercedStorage<double, long> & PatchKernel::getCellCentroidCache(int component) const
+{
+	assert(component >= 0 && component < 3);
+
+	return getCellGeometryCacheField(GEOMETRY_CACHE_CELL_CENTROID + component);
+}
+
+/*!
+	Marks the whole geometry cache as stale.
+
+	All the entries of a stale cache will be re-evaluated during the next
+	update.
+*/
+void PatchKernel::setGeometryCacheStale()
+{
+	if (!isGeometryCacheEnabled()) {
+		return;
+	}
+
+	m_geometryCacheStale    = true;
+	m_geometryCacheUpToDate = false;
+}
+
+/*!
+	Checks if all the entries of the geometry cache are up-to-date.
+
+	When the cache is up-to-date, the functions that evaluate geometrical
+	quantities may return the cached values instead of evaluating them.
+
+	\result Returns true if the geometry cache is enabled and all its entries
+	are up-to-date, false otherwise.
+*/
+bool PatchKernel::isGeometryCacheUpToDate() const
+{
+	return m_geometryCacheUpToDate;
+}
 
-			if (futureNeighbourCandidate) {
-				nMaxHalfFaces += nCellFaces;
-				processList.push_back(&cell);
-			}
-		}
-	}
+/*!
+	Marks the geometry cache as no more up-to-date.
 
-	// Create the adjacencies
-	std::unordered_set<CellHalfFace, CellHalfFace::Hasher> halfFaces;
-	halfFaces.reserve(static_cast<std::size_t>(0.5 * nMaxHalfFaces));
+	Entries of the cache that need to be re-evaluated are tracked by the
+	alteration flags, this function only prevents the evaluation functions
+	from returning cached values until the cache is updated.
+*/
+void PatchKernel::invalidateGeometryCache()
+{
+	m_geometryCacheUpToDate = false;
+}
 
-	std::vector<std::pair<Cell *, int>> matchingAdjacencies;
-	for (Cell *cell : processList) {
-		long cellId = cell->getId();
-		const int nCellFaces = cell->getFaceCount();
-		bool areCellAdjacenciesDirty = testCellAlterationFlags(cellId, FLAG_ADJACENCIES_DIRTY);
-		for (int face = 0; face < nCellFaces; face++) {
-			// Generate the half-face
-			CellHalfFace halfFace(*cell, face);
+/*!
+	Gets the number of fields stored in the cell geometry cache.
 
-			// Find matching half-face
-			auto matchingHalfFaceItr = halfFaces.end();
-			for (CellHalfFace::Winding winding : matchingWindings) {
-				// Set winding order
-				halfFace.setWinding(winding);
+	\result The number of fields stored in the cell geometry cache.
+*/
+std::size_t PatchKernel::getCellGeometryCacheFieldCount() const
+{
+	return (GEOMETRY_CACHE_CELL_CENTROID + 3);
+}
 
-				// Search for matching half-face
-				matchingHalfFaceItr = halfFaces.find(halfFace);
-				if (matchingHalfFaceItr != halfFaces.end()) {
-					break;
-				}
-			}
+/*!
+	Gets the number of fields stored in the interface geometry cache.
 
-			// Early return if no matching half-face has been found
-			//
-			// If no matching half-face has been found, we need to add the
-			// current half-face to the list because it may match the face
-			// of a cell that will be processed later.
-			if (matchingHalfFaceItr == halfFaces.end()) {
-				halfFace.setWinding(CellHalfFace::WINDING_NATURAL);
-				halfFaces.insert(std::move(halfFace));
-				continue;
-			}
+	\result The number of fields stored in the interface geometry cache.
+*/
+std::size_t PatchKernel::getInterfaceGeometryCacheFieldCount() const
+{
+	return 0;
+}
 
-			// Get matching half-face information
-			const CellHalfFace &matchingHalfFace = *matchingHalfFaceItr;
-			Cell &matchingCell  = matchingHalfFace.getCell();
-			long matchingCellId = matchingCell.getId();
-			long matchingFace   = matchingHalfFace.getFace();
+/*!
+	Gets the storage of the specified field of the cell geometry cache.
 
-			// Only process cells with dirty adjacencies
-			//
-			// In order to limit the half faces that need to be stored, we are
-			// processing at the same time cells with dirty adjacencies and
-			// their neighbour candidates. This means we will also find matches
-			// between faces of cell whose adjacensies are already up-to-date.
-			bool areMatchingCellAdjacenciesDirty = testCellAlterationFlags(matchingCellId, FLAG_ADJACENCIES_DIRTY);
-			if (!areCellAdjacenciesDirty && !areMatchingCellAdjacenciesDirty) {
-				continue;
-			}
+	The geometry cache should be enabled, otherwise an exception is thrown.
 
-			// Identifty matching adjacencies
-			//
-			// If multiple matches are allowed, in addition to the entry
-			// related to the matching half face, we also need to add the
-			// entries associated to the adjacencies already identified
-			// for the half face.
-			matchingAdjacencies.clear();
-			matchingAdjacencies.emplace_back(std::make_pair<Cell *, int>(&matchingCell, matchingFace));
-			if (multipleMatchesAllowed) {
-				const int nMachingFaceNeighs = matchingCell.getAdjacencyCount(matchingFace);
-				const long *machingFaceNeighs = matchingCell.getAdjacencies(matchingFace);
-				for (int k = 0; k < nMachingFaceNeighs; ++k) {
-					long neighId = machingFaceNeighs[k];
-					if (neighId == cellId) {
-						continue;
-					}
+	\param field is the field
+	\result The storage of the specified field of the cell geometry cache.
+*/
+PiercedStorage<double, long> & PatchKernel::getCellGeometryCacheField(std::size_t field)
+{
+	if (!isGeometryCacheEnabled()) {
+		throw std::runtime_error("The geometry cache is not enabled.");
+	}
 
-					Cell &neigh = m_cells.at(neighId);
-					int neighFace = findAdjoinNeighFace(matchingCell, matchingFace, neigh);
-					matchingAdjacencies.emplace_back(std::make_pair<Cell *, int>(&neigh, std::move(neighFace)));
-				}
-			} else {
-				// When cell adjacencies are makred dirty this means that some
-				// adjacencies are dirty not that all adjacencies are dirty.
-				// The matchin cell may have no adjaceny associated to the
-				// matching face or a signle adjacency that should match
-				// the current cell.
-				assert(matchingCell.getAdjacencyCount(matchingFace) == 0 || (matchingCell.getAdjacencyCount(matchingFace) == 1 && (*(matchingCell.getAdjacencies(matchingFace)) == cellId)));
-			}
+	return *(m_cellGeometryCache[field]);
+}
 
-			// Create adjacencies
-			for (const std::pair<Cell *, int> &matchingAdjacency : matchingAdjacencies) {
-				Cell *adjacentCell = matchingAdjacency.first;
-				long adjacentCellId = adjacentCell->getId();
-				int adjacentFace = matchingAdjacency.second;
+/*!
+	Gets a constant reference to the storage of the specified field of the
+	cell geometry cache.
 
-				cell->pushAdjacency(face, adjacentCellId);
-				adjacentCell->pushAdjacency(adjacentFace, cellId);
-			}
+	The geometry cache should be enabled, otherwise an exception is thrown.
 
-			// Remove the matching half-face from the list
-			//
-			// If multiple matches are allowed, we need to keep the half
-			// face, because that entry may match the face of a cell that
-			// will be processed later.
-			if (!multipleMatchesAllowed) {
-				halfFaces.erase(matchingHalfFaceItr);
-			}
-		}
+	\param field is the field
+	\result A constant reference to the storage of the specified field of
+	the cell geometry cache.
+*/
+const PiercedStorage<double, long> & PatchKernel::getCellGeometryCacheField(std::size_t field) const
+{
+	if (!isGeometryCacheEnabled()) {
+		throw std::runtime_error("The geometry cache is not enabled.");
 	}
+
+	return *(m_cellGeometryCache[field]);
 }
 
 /*!
-	Returns the current interfaces build strategy.
+	Gets the storage of the specified field of the interface geometry cache.
 
-	\return The current interfaces build strategy.
+	The geometry cache should be enabled, otherwise an exception is thrown.
+
+	\param field is the field
+	\result The storage of the specified field of the interface geometry
+	cache.
 */
-PatchKernel::InterfacesBuildStrategy PatchKernel::getInterfacesBuildStrategy() const
+PiercedStorage<double, long> & PatchKernel::getInterfaceGeometryCacheField(std::size_t field)
 {
-	return m_interfacesBuildStrategy;
+	if (!isGeometryCacheEnabled()) {
+		throw std::runtime_error("The geometry cache is not enabled.");
+	}
+
+	return *(m_interfaceGeometryCache[field]);
 }
 
 /*!
-	Set the current interfaces build strategy.
+	Gets a constant reference to the storage of the specified field of the
+	interface geometry cache.
 
-	\param status is the interfaces build strategy that will be set
+	The geometry cache should be enabled, otherwise an exception is thrown.
+
+	\param field is the field
+	\result A constant reference to the storage of the specified field of
+	the interface geometry cache.
 */
-void PatchKernel::setInterfacesBuildStrategy(InterfacesBuildStrategy status)
+const PiercedStorage<double, long> & PatchKernel::getInterfaceGeometryCacheField(std::size_t field) const
 {
-	if (status == INTERFACES_AUTOMATIC) {
-		if (!isInterfaceAutoIndexingEnabled()) {
-			throw std::runtime_error("Automatic build strategy requires auto-indexing.");
-		}
+	if (!isGeometryCacheEnabled()) {
+		throw std::runtime_error("The geometry cache is not enabled.");
 	}
 
-	m_interfacesBuildStrategy = status;
+	return *(m_interfaceGeometryCache[field]);
 }
 
 /*!
-	Checks if the interfaces are dirty.
+	Internal function to update the geometry cache.
+
+	Entries are evaluated concurrently, hence the functions that evaluate
+	the geometrical quantities should be thread-safe.
+
+	\param cellIds are the ids of the cells whose entries will be updated
+	\param interfaceIds are the ids of the interfaces whose entries will be
+	updated
+*/
+void PatchKernel::_updateGeometryCache(const std::vector<long> &cellIds, const std::vector<long> &interfaceIds)
+{
+	BITPIT_UNUSED(interfaceIds);
+
+	std::array<PiercedStorage<double, long> *, 3> centroidCache;
+	for (int d = 0; d < 3; ++d) {
+		centroidCache[d] = &(getCellGeometryCacheField(GEOMETRY_CACHE_CELL_CENTROID + d));
+	}
+
+	static const std::size_t CHUNK_SIZE = 1024;
+	std::size_t nCells  = cellIds.size();
+	std::size_t nChunks = (nCells + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nCells);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			long cellId = cellIds[i];
+			std::size_t rawIndex = m_cells.getRawIndex(cellId);
+
+			std::array<double, 3> centroid = evalCellCentroid(cellId);
+			for (int d = 0; d < 3; ++d) {
+				centroidCache[d]->rawAt(rawIndex) = centroid[d];
+			}
+		}
+	});
+}
+
+/*!
+	Checks if the vertex incidence is enabled.
+
+	\result Returns true if the vertex incidence is enabled, false otherwise.
+*/
+bool PatchKernel::isVertexIncidenceEnabled() const
+{
+	return m_vertexIncidenceEnabled;
+}
+
+/*!
+	Checks if the vertex incidence is dirty.
+
+	The incidence is dirty if it has to be rebuilt, for example because the
+	ids of the cells have been renumbered, or if the storage of the incident
+	cells contains too many unused entries and needs to be compacted.
 
 	\param global if set to true, the dirty status will be evaluated globally
 	across all the partitions
-	\result Returns true if the interfaces are dirty, false otherwise.
+	\result Returns true if the vertex incidence is dirty, false otherwise.
 */
-bool PatchKernel::areInterfacesDirty(bool global) const
+bool PatchKernel::isVertexIncidenceDirty(bool global) const
 {
-	if (getInterfacesBuildStrategy() == INTERFACES_NONE) {
+	if (!isVertexIncidenceEnabled()) {
 		return false;
 	}
 
-	bool areDirty = !m_alteredInterfaces.empty();
-	if (!areDirty) {
-		for (const auto &entry : m_alteredCells) {
-			AlterationFlags cellAlterationFlags = entry.second;
-			if (testAlterationFlags(cellAlterationFlags, FLAG_INTERFACES_DIRTY)) {
-				areDirty = true;
-				break;
-			}
-		}
+	bool isDirty = m_vertexIncidenceStale;
+	if (!isDirty) {
+		isDirty = (m_vertexIncidenceWaste > m_vertexIncidenceCells.size() / 2);
 	}
 
 #if BITPIT_ENABLE_MPI==1
 	if (global && isPartitioned()) {
 		const auto &communicator = getCommunicator();
-		MPI_Allreduce(MPI_IN_PLACE, &areDirty, 1, MPI_C_BOOL, MPI_LOR, communicator);
+		MPI_Allreduce(MPI_IN_PLACE, &isDirty, 1, MPI_C_BOOL, MPI_LOR, communicator);
 	}
 #else
 	BITPIT_UNUSED(global);
 #endif
 
-	return areDirty;
+	return isDirty;
 }
 
 /*!
-	Build interfaces among the cells.
+	Initializes the vertex incidence.
 
-	If interfaces are already built, all interfaces will be deleted and
-	they will be re-generated from scratch.
+	The vertex incidence stores, for each vertex, the list of the cells that
+	contain the vertex. The lists are stored in compressed row format: the
+	ids of the incident cells are stored in a single contiguous array and,
+	for each vertex, the patch keeps the position of its row inside that
+	array, the number of incident cells and the number of entries reserved
+	for the row. The cells of a row are sorted by ascending id.
+
+	Once initialized, the incidence is kept up-to-date while cells are
+	added to or deleted from the patch: only the rows of the vertices of
+	those cells are modified. Rows that run out of space are moved at the
+	end of the array, the space they leave behind is reclaimed during the
+	update of the patch. While the incidence is available, it is used by
+	the queries that look for the cells that share a vertex (for example,
+	findVertexOneRing and findCellVertexNeighs).
+
+	If the incidence is already initialized, it will be rebuilt.
 */
-void PatchKernel::buildInterfaces()
+void PatchKernel::initializeVertexIncidence()
 {
-    initializeInterfaces(INTERFACES_AUTOMATIC);
+	// Create the storage
+	if (!isVertexIncidenceEnabled()) {
+		m_vertexIncidenceRows = std::unique_ptr<PiercedStorage<std::size_t, long>>(new PiercedStorage<std::size_t, long>(3, &m_vertices, PiercedSyncMaster::SYNC_MODE_CONCURRENT));
+
+		m_vertexIncidenceEnabled = true;
+	}
+
+	// Build the incidence
+	updateVertexIncidence(true);
 }
 
 /*!
-	Initialize the interfaces using the specified build strategy.
-
-	If the current strategy doesn't match the requested strategy, all
-	interfaces will be deleted and they will be re-generated from scratch.
+	Updates the vertex incidence.
 
-	Adjacencies are a mandatory requirement for building interfaces, if the
-	adjacencies are not yet initialized an exception is thrown.
+	The incidence is kept up-to-date while cells are added or deleted, it
+	only needs to be rebuilt if it is dirty. The incidence is rebuilt in a
+	single pass over the cells: the incident cells of each vertex are first
+	counted and then stored in their rows. Both steps are performed
+	concurrently.
 
-	\param strategy is the build strategy that will be used
+	\param forcedUpdated if set to true, the incidence will be rebuilt, also
+	if it is not marked as dirty
 */
-void PatchKernel::initializeInterfaces(InterfacesBuildStrategy strategy)
+void PatchKernel::updateVertexIncidence(bool forcedUpdated)
 {
-	// Interfaces need adjacencies
-	if (getAdjacenciesBuildStrategy() == ADJACENCIES_NONE) {
-		throw std::runtime_error ("Adjacencies are mandatory for building the interfaces.");
+	// Early return if the incidence is not enabled
+	if (!isVertexIncidenceEnabled()) {
+		return;
 	}
 
-	// Get current build stategy
-	InterfacesBuildStrategy currentStrategy = getInterfacesBuildStrategy();
+	// Check if the incidence is dirty
+	bool vertexIncidenceDirty = isVertexIncidenceDirty();
+	if (!vertexIncidenceDirty && !forcedUpdated) {
+		return;
+	}
 
-	// Early return if we don't need interfaces
-	if (strategy == INTERFACES_NONE) {
-		if (currentStrategy != INTERFACES_NONE) {
-			destroyInterfaces();
+	// Reset the rows
+	//
+	// Rows are indexed using the raw index of the vertices. Rows associated
+	// with the holes of the vertex container are reset as well, that's
+	// because vertices created in those positions will reuse the rows.
+	PiercedStorage<std::size_t, long> &rows = *m_vertexIncidenceRows;
+	rows.fill(0);
+
+	std::size_t nRows = 0;
+	for (VertexConstIterator vertexItr = m_vertices.cbegin(); vertexItr != m_vertices.cend(); ++vertexItr) {
+		nRows = std::max(vertexItr.getRawIndex() + 1, nRows);
+	}
+
+	// Count the incident cells of each vertex
+
+	std::vector<std::atomic<std::size_t>> rowCounters(nRows);
+	parallelForCells([this, &rowCounters](const Cell &cell) {
+		ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+		for (long vertexId : cellVertexIds) {
+			std::size_t vertexRawIndex = m_vertices.getRawIndex(vertexId);
+			rowCounters[vertexRawIndex].fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	// Evaluate the position of the rows
+	std::size_t nIncidences = 0;
+	for (std::size_t i = 0; i < nRows; ++i) {
+		std::size_t rowCount = rowCounters[i].load(std::memory_order_relaxed);
+		rows.rawAt(i, VERTEX_INCIDENCE_ROW_OFFSET)   = nIncidences;
+		rows.rawAt(i, VERTEX_INCIDENCE_ROW_COUNT)    = rowCount;
+		rows.rawAt(i, VERTEX_INCIDENCE_ROW_CAPACITY) = rowCount;
+
+		nIncidences += rowCount;
+	}
+
+	// Fill the rows
+	//
+	// The counters are consumed to find the position of the cells inside
+	// the rows.
+	std::vector<long>(nIncidences, Cell::NULL_ID).swap(m_vertexIncidenceCells);
+	parallelForCells([this, &rows, &rowCounters](const Cell &cell) {
+		long cellId = cell.getId();
+		ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+		for (long vertexId : cellVertexIds) {
+			std::size_t vertexRawIndex = m_vertices.getRawIndex(vertexId);
+			std::size_t rowPosition = rowCounters[vertexRawIndex].fetch_sub(1, std::memory_order_relaxed) - 1;
+			m_vertexIncidenceCells[rows.rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_OFFSET) + rowPosition] = cellId;
+		}
+	});
+
+	// Sort the rows
+	static const std::size_t CHUNK_SIZE = 1024;
+	std::size_t nChunks = (nRows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nRows);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			std::size_t rowCount = rows.rawAt(i, VERTEX_INCIDENCE_ROW_COUNT);
+			if (rowCount <= 1) {
+				continue;
+			}
+
+			auto rowBegin = m_vertexIncidenceCells.begin() + rows.rawAt(i, VERTEX_INCIDENCE_ROW_OFFSET);
+			std::sort(rowBegin, rowBegin + rowCount);
 		}
+	});
+
+	// The incidence is now updated
+	m_vertexIncidenceWaste = 0;
+	m_vertexIncidenceStale = false;
+}
+
+/*!
+	Destroys the vertex incidence.
+*/
+void PatchKernel::destroyVertexIncidence()
+{
+	// Early return if the incidence is not enabled
+	if (!isVertexIncidenceEnabled()) {
+		return;
+	}
+
+	// Destroy the storages
+	m_vertexIncidenceRows.reset();
+	std::vector<long>().swap(m_vertexIncidenceCells);
+
+	// The incidence is now disabled
+	m_vertexIncidenceEnabled = false;
+	m_vertexIncidenceStale   = false;
+	m_vertexIncidenceWaste   = 0;
+}
+
+/*!
+	Gets the number of cells that contain the specified vertex.
+
+	The vertex incidence should be enabled and up-to-date, otherwise an
+	exception is thrown.
+
+	\param vertexId is the id of the vertex
+	\result The number of cells that contain the specified vertex.
+*/
+int PatchKernel::getVertexIncidentCellCount(long vertexId) const
+{
+	if (!isVertexIncidenceUsable()) {
+		throw std::runtime_error("The vertex incidence is not enabled or it is not up-to-date.");
+	}
+
+	std::size_t vertexRawIndex = m_vertices.getRawIndex(vertexId);
+
+	return static_cast<int>(m_vertexIncidenceRows->rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_COUNT));
+}
+
+/*!
+	Gets the ids of the cells that contain the specified vertex.
+
+	The ids are sorted in ascending order. The returned pointer is only
+	valid until the next modification of the patch.
+
+	The vertex incidence should be enabled and up-to-date, otherwise an
+	exception is thrown.
+
+	\param vertexId is the id of the vertex
+	\result The ids of the cells that contain the specified vertex.
+*/
+const long * PatchKernel::getVertexIncidentCells(long vertexId) const
+{
+	if (!isVertexIncidenceUsable()) {
+		throw std::runtime_error("The vertex incidence is not enabled or it is not up-to-date.");
+	}
+
+	std::size_t vertexRawIndex = m_vertices.getRawIndex(vertexId);
+
+	return m_vertexIncidenceCells.data() + m_vertexIncidenceRows->rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_OFFSET);
+}
+
+/*!
+	Marks the vertex incidence as stale.
 
+	A stale incidence is no longer maintained while the patch is modified
+	and it will be rebuilt during the next update.
+*/
+void PatchKernel::setVertexIncidenceStale()
+{
+	if (!isVertexIncidenceEnabled()) {
 		return;
 	}
 
-	// Update the build strategy
-	if (currentStrategy != strategy) {
-		setInterfacesBuildStrategy(strategy);
-	}
+	m_vertexIncidenceStale = true;
+}
 
-	// Reset interfaces
-	resetInterfaces();
+/*!
+	Checks if the vertex incidence can be used for answering the queries.
 
-	// Update the interfaces
-	updateInterfaces();
+	\result Returns true if the vertex incidence is enabled and it is not
+	stale, false otherwise.
+*/
+bool PatchKernel::isVertexIncidenceUsable() const
+{
+	return (m_vertexIncidenceEnabled && !m_vertexIncidenceStale);
 }
 
 /*!
-	Update the interfaces of the patch.
+	Adds the specified cell to the rows of its vertices.
 
-	\param forcedUpdated if set to true, bounding box information will be
-	updated also if they are not marked as dirty
+	If the vertex incidence cannot be used, nothing is done.
+
+	\param cell is the cell
 */
-void PatchKernel::updateInterfaces(bool forcedUpdated)
+void PatchKernel::addCellVertexIncidences(const Cell &cell)
 {
-	// Early return if interfaces are not built
-	InterfacesBuildStrategy currentStrategy = getInterfacesBuildStrategy();
-	if (currentStrategy == INTERFACES_NONE) {
+	if (!isVertexIncidenceUsable()) {
 		return;
 	}
 
-	// Check if the interfaces are dirty
-	bool interfacesDirty = areInterfacesDirty();
-	if (!interfacesDirty && !forcedUpdated) {
-		return;
-	}
+	long cellId = cell.getId();
+	ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+	for (long vertexId : cellVertexIds) {
+		VertexIterator vertexItr = m_vertices.find(vertexId);
+		if (vertexItr == m_vertices.end()) {
+			setVertexIncidenceStale();
+			return;
+		}
 
-	// Interfaces need up-to-date adjacencies
-	assert(getAdjacenciesBuildStrategy() != ADJACENCIES_NONE);
-	updateAdjacencies();
+		addVertexIncidence(vertexItr.getRawIndex(), cellId);
+	}
+}
 
-	// Update interfaces
-	if (interfacesDirty) {
-		// Enable manual adaption
-		AdaptionMode previousAdaptionMode = getAdaptionMode();
-		setAdaptionMode(ADAPTION_MANUAL);
+/*!
+	Removes the specified cell from the rows of its vertices.
 
-		// Prune stale interfaces
-		pruneStaleInterfaces();
+	If the vertex incidence cannot be used, nothing is done.
 
-		// Update interfaces
-		_updateInterfaces();
+	\param cell is the cell
+*/
+void PatchKernel::removeCellVertexIncidences(const Cell &cell)
+{
+	if (!isVertexIncidenceUsable()) {
+		return;
+	}
 
-		// Interfaces are now updated
-		unsetCellAlterationFlags(FLAG_INTERFACES_DIRTY);
-		m_alteredInterfaces.clear();
+	long cellId = cell.getId();
+	ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+	for (long vertexId : cellVertexIds) {
+		VertexIterator vertexItr = m_vertices.find(vertexId);
+		if (vertexItr == m_vertices.end()) {
+			setVertexIncidenceStale();
+			return;
+		}
 
-		// Restore previous adaption mode
-		setAdaptionMode(previousAdaptionMode);
-	} else {
-		initializeInterfaces(currentStrategy);
+		removeVertexIncidence(vertexItr.getRawIndex(), cellId);
 	}
 }
 
 /*!
-	Destroy the interfaces.
+	Adds the specified cell to the row of the given vertex.
 
-	After deleting the interfaces, this function changes the build strategy
-	to "None".
+	If the row has no room for the cell, the row is moved at the end of the
+	storage and its capacity is doubled.
+
+	\param vertexRawIndex is the raw index of the vertex
+	\param cellId is the id of the cell
 */
-void PatchKernel::destroyInterfaces()
+void PatchKernel::addVertexIncidence(std::size_t vertexRawIndex, long cellId)
 {
-	// Early return if no interfaces have been built
-	if (getInterfacesBuildStrategy() == INTERFACES_NONE) {
+	static const std::size_t MIN_ROW_CAPACITY = 4;
+
+	PiercedStorage<std::size_t, long> &rows = *m_vertexIncidenceRows;
+	std::size_t &rowOffset   = rows.rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_OFFSET);
+	std::size_t &rowCount    = rows.rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_COUNT);
+	std::size_t &rowCapacity = rows.rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_CAPACITY);
+
+	// Move the row at the end of the storage
+	if (rowCount == rowCapacity) {
+		std::size_t grownOffset   = m_vertexIncidenceCells.size();
+		std::size_t grownCapacity = std::max(2 * rowCapacity, MIN_ROW_CAPACITY);
+		m_vertexIncidenceCells.resize(grownOffset + grownCapacity, Cell::NULL_ID);
+		std::copy_n(m_vertexIncidenceCells.begin() + rowOffset, rowCount, m_vertexIncidenceCells.begin() + grownOffset);
+
+		m_vertexIncidenceWaste += rowCapacity;
+
+		rowOffset   = grownOffset;
+		rowCapacity = grownCapacity;
+	}
+
+	// Add the cell keeping the row sorted
+	auto rowBegin = m_vertexIncidenceCells.begin() + rowOffset;
+	auto rowEnd   = rowBegin + rowCount;
+	auto cellItr  = std::lower_bound(rowBegin, rowEnd, cellId);
+	if (cellItr != rowEnd && *cellItr == cellId) {
 		return;
 	}
 
-	// Destroy the interfaces
-	_resetInterfaces(true);
+	std::copy_backward(cellItr, rowEnd, rowEnd + 1);
+	*cellItr = cellId;
+	++rowCount;
+}
 
-	// Clear list of cells with dirty interfaces
-	unsetCellAlterationFlags(FLAG_INTERFACES_DIRTY);
+/*!
+	Removes the specified cell from the row of the given vertex.
 
-	// Clear list of altered interfaces
-	m_alteredInterfaces.clear();
+	\param vertexRawIndex is the raw index of the vertex
+	\param cellId is the id of the cell
+*/
+void PatchKernel::removeVertexIncidence(std::size_t vertexRawIndex, long cellId)
+{
+	PiercedStorage<std::size_t, long> &rows = *m_vertexIncidenceRows;
+	std::size_t rowOffset = rows.rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_OFFSET);
+	std::size_t &rowCount = rows.rawAt(vertexRawIndex, VERTEX_INCIDENCE_ROW_COUNT);
 
-	// Set interface build strategy
-	setInterfacesBuildStrategy(INTERFACES_NONE);
+	auto rowBegin = m_vertexIncidenceCells.begin() + rowOffset;
+	auto rowEnd   = rowBegin + rowCount;
+	auto cellItr  = std::lower_bound(rowBegin, rowEnd, cellId);
+	if (cellItr == rowEnd || *cellItr != cellId) {
+		return;
+	}
+
+	std::copy(cellItr + 1, rowEnd, cellItr);
+	--rowCount;
 }
 
 /*!
@@ -6632,6 +9626,13 @@ void PatchKernel::_updateInterfaces()
 	//
 	// On border faces of internal cells we need to build an interface, also
 	// if there are no adjacencies.
+	//
+	// When the interfaces are built from scratch, all the interfaces are
+	// created in bulk.
+	if (buildInterfacesInBulk()) {
+		return;
+	}
+
 	for (const auto &entry : m_alteredCells) {
 		AlterationFlags cellAlterationFlags = entry.second;
 		if (!testAlterationFlags(cellAlterationFlags, FLAG_INTERFACES_DIRTY)) {
@@ -6671,6 +9672,248 @@ void PatchKernel::_updateInterfaces()
 	}
 }
 
+/*!
+	Builds all the interfaces of the patch in bulk.
+
+	The bulk build can only be used when the patch contains no interfaces,
+	the interfaces of all the cells are dirty and interface ids can be
+	generated automatically. First, the number of interfaces that will be
+	created is evaluated and the storage of the interfaces and the ids of
+	the interfaces are reserved in one go. Then, the connectivity of the
+	interfaces and the owner/neighbour information are filled concurrently.
+
+	Each pair of adjacent cells shares a single interface, the interface is
+	created while processing the cell with the lowest id. Owner and
+	neighbour of the interfaces are chosen using the same rules used by
+	buildCellInterface(). Since the interfaces of a face are stored in the
+	same order of the adjacencies of that face, there is no need to change
+	the order of the adjacencies.
+
+	\result Returns true if the interfaces have been built, false if the
+	bulk build cannot be used.
+*/
+bool PatchKernel::buildInterfacesInBulk()
+{
+	struct InterfaceTask {
+		Cell *owner;
+		int ownerFace;
+		int ownerSlot;
+		Cell *neigh;
+		int neighFace;
+		int neighSlot;
+		ElementType type;
+		int connectSize;
+		Interface *interface;
+	};
+
+	// Check if the interfaces can be built in bulk
+	if (!m_interfaceIdGenerator || !m_interfaces.empty()) {
+		return false;
+	}
+
+	std::vector<Cell *> processList;
+	processList.reserve(m_cells.size());
+	for (Cell &cell : m_cells) {
+		if (!testCellAlterationFlags(cell.getId(), FLAG_INTERFACES_DIRTY)) {
+			return false;
+		}
+
+		processList.push_back(&cell);
+	}
+
+	std::size_t nProcessedCells = processList.size();
+	if (nProcessedCells == 0) {
+		return true;
+	}
+
+	// Initialize the interface storage of the cells and count the interfaces
+	//
+	// Border faces need an interface, also if there are no adjacencies.
+	static const std::size_t CHUNK_SIZE = 1024;
+	std::size_t nChunks = (nProcessedCells + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+	std::vector<std::size_t> taskOffsets(nProcessedCells + 1);
+	taskOffsets[0] = 0;
+	utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+		std::vector<std::size_t> faceInterfaceCounts;
+
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nProcessedCells);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			Cell &cell = *(processList[i]);
+			long cellId = cell.getId();
+			const int nCellFaces = cell.getFaceCount();
+
+			std::size_t nCreatedInterfaces = 0;
+			faceInterfaceCounts.resize(nCellFaces);
+			for (int face = 0; face < nCellFaces; ++face) {
+				int nFaceAdjacencies = cell.getAdjacencyCount(face);
+				if (nFaceAdjacencies == 0) {
+					faceInterfaceCounts[face] = 1;
+					++nCreatedInterfaces;
+					continue;
+				}
+
+				faceInterfaceCounts[face] = nFaceAdjacencies;
+				const long *faceAdjacencies = cell.getAdjacencies(face);
+				for (int k = 0; k < nFaceAdjacencies; ++k) {
+					if (cellId < faceAdjacencies[k]) {
+						++nCreatedInterfaces;
+					}
+				}
+			}
+
+			if (nCellFaces > 0) {
+				cell.setInterfaces(FlatVector2D<long>(nCellFaces, faceInterfaceCounts.data(), Element::NULL_ID));
+			}
+
+			taskOffsets[i + 1] = nCreatedInterfaces;
+		}
+	});
+
+	for (std::size_t i = 0; i < nProcessedCells; ++i) {
+		taskOffsets[i + 1] += taskOffsets[i];
+	}
+
+	// Identify owner and neighbour of the interfaces
+	std::size_t nInterfaces = taskOffsets.back();
+	std::vector<InterfaceTask> tasks(nInterfaces);
+	utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+		CellFuzzyPositionLess cellFuzzyLess(*this);
+
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nProcessedCells);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			Cell &cell = *(processList[i]);
+			long cellId = cell.getId();
+			const int nCellFaces = cell.getFaceCount();
+
+			std::size_t n = taskOffsets[i];
+			for (int face = 0; face < nCellFaces; ++face) {
+				int nFaceAdjacencies = cell.getAdjacencyCount(face);
+				if (nFaceAdjacencies == 0) {
+					InterfaceTask &task = tasks[n++];
+					task.owner     = &cell;
+					task.ownerFace = face;
+					task.ownerSlot = 0;
+					task.neigh     = nullptr;
+					task.neighFace = -1;
+					task.neighSlot = -1;
+					task.type        = cell.getFaceType(face);
+					task.connectSize = static_cast<int>(cell.getFaceConnect(face).size());
+					continue;
+				}
+
+				const long *faceAdjacencies = cell.getAdjacencies(face);
+				for (int k = 0; k < nFaceAdjacencies; ++k) {
+					long neighId = faceAdjacencies[k];
+					if (cellId > neighId) {
+						continue;
+					}
+
+					Cell &neigh = m_cells.at(neighId);
+					int neighFace = findAdjoinNeighFace(cell, face, neigh);
+					assert(neighFace >= 0);
+					int neighSlot = neigh.findAdjacency(neighFace, cellId);
+					assert(neighSlot >= 0);
+
+					bool cellOwnsInterface = true;
+					if (nFaceAdjacencies > 1) {
+						cellOwnsInterface = false;
+					} else if (neigh.getAdjacencyCount(neighFace) == 1) {
+						cellOwnsInterface = cellFuzzyLess(cellId, neighId);
+					}
+
+					InterfaceTask &task = tasks[n++];
+					if (cellOwnsInterface) {
+						task.owner     = &cell;
+						task.ownerFace = face;
+						task.ownerSlot = k;
+						task.neigh     = &neigh;
+						task.neighFace = neighFace;
+						task.neighSlot = neighSlot;
+					} else {
+						task.owner     = &neigh;
+						task.ownerFace = neighFace;
+						task.ownerSlot = neighSlot;
+						task.neigh     = &cell;
+						task.neighFace = face;
+						task.neighSlot = k;
+					}
+					task.type        = task.owner->getFaceType(task.ownerFace);
+					task.connectSize = static_cast<int>(task.owner->getFaceConnect(task.ownerFace).size());
+				}
+			}
+		}
+	});
+
+	// Create the interfaces
+	//
+	// Interfaces are created sequentially, but their storage is reserved
+	// in advance. If the connectivity is stored in the patch, the arena is
+	// given room for the connectivity of all the interfaces and no
+	// connectivity storage is allocated for the single interfaces.
+	bool storeConnectInPatch = (m_connectivityStorageMode == CONNECTIVITY_STORAGE_PATCH);
+
+	m_interfaces.reserve(nInterfaces);
+	if (storeConnectInPatch) {
+		std::size_t arenaSize = 0;
+		for (const InterfaceTask &task : tasks) {
+			arenaSize += task.connectSize;
+		}
+
+		if (!m_interfaceConnectArena->hasRoom(arenaSize)) {
+			compactInterfaceConnectArena(arenaSize);
+		}
+	}
+
+	for (InterfaceTask &task : tasks) {
+		long interfaceId = m_interfaceIdGenerator->generate();
+
+		PiercedVector<Interface>::iterator iterator;
+		if (storeConnectInPatch) {
+			iterator = m_interfaces.emreclaim(interfaceId, interfaceId, task.type, std::unique_ptr<long[]>(nullptr));
+			iterator->setArenaConnect(m_interfaceConnectArena.get(), m_interfaceConnectArena->allocate(task.connectSize));
+		} else {
+			iterator = m_interfaces.emreclaim(interfaceId, interfaceId, task.type, task.connectSize);
+		}
+
+		setAddedInterfaceAlterationFlags(interfaceId);
+
+		task.interface = &(*iterator);
+	}
+
+	// Fill interface and cell data
+	//
+	// Each task writes the connectivity and the owner/neighbour data of its
+	// own interface and the interface slots associated with its own pair of
+	// cells, hence tasks can be processed concurrently.
+	static const std::size_t TASK_CHUNK_SIZE = 4096;
+	std::size_t nTaskChunks = (nInterfaces + TASK_CHUNK_SIZE - 1) / TASK_CHUNK_SIZE;
+	utils::threads::parallelFor(nTaskChunks, [&](std::size_t chunk) {
+		std::size_t chunkBegin = chunk * TASK_CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + TASK_CHUNK_SIZE, nInterfaces);
+		for (std::size_t n = chunkBegin; n < chunkEnd; ++n) {
+			const InterfaceTask &task = tasks[n];
+			Interface &interface = *(task.interface);
+			long interfaceId = interface.getId();
+
+			ConstProxyVector<long> faceConnect = task.owner->getFaceConnect(task.ownerFace);
+			long *interfaceConnect = interface.getConnect();
+			std::copy(faceConnect.begin(), faceConnect.end(), interfaceConnect);
+
+			interface.setOwner(task.owner->getId(), task.ownerFace);
+			task.owner->getInterfaces(task.ownerFace)[task.ownerSlot] = interfaceId;
+			if (task.neigh) {
+				interface.setNeigh(task.neigh->getId(), task.neighFace);
+				task.neigh->getInterfaces(task.neighFace)[task.neighSlot] = interfaceId;
+			}
+		}
+	});
+
+	return true;
+}
+
 /*!
 	Given two cells, build the interface between them.
 
@@ -7510,6 +10753,12 @@ void PatchKernel::translate(const std::array<double, 3> &translation)
 		m_boxMinPoint += translation;
 		m_boxMaxPoint += translation;
 	}
+
+	// The cached geometry is no more valid
+	setGeometryCacheStale();
+
+	// Point locator is no more valid
+	_resetPointLocator();
 }
 
 /*!
@@ -7565,6 +10814,12 @@ void PatchKernel::rotate(const std::array<double, 3> &n0, const std::array<doubl
 			}
 		}
 	}
+
+	// The cached geometry is no more valid
+	setGeometryCacheStale();
+
+	// Point locator is no more valid
+	_resetPointLocator();
 }
 
 /*!
@@ -7617,6 +10872,12 @@ void PatchKernel::scale(const std::array<double, 3> &scaling, const std::array<d
 			m_boxMaxPoint[k] = center[k] + scaling[k] * (m_boxMaxPoint[k] - center[k]);
 		}
 	}
+
+	// The cached geometry is no more valid
+	setGeometryCacheStale();
+
+	// Point locator is no more valid
+	_resetPointLocator();
 }
 
 /*!
@@ -7833,6 +11094,86 @@ void PatchKernel::displayTopologyStats(std::ostream &out, unsigned int padding)
         //out << indent<< "  # free vertices   " << countDoubleCells()   << std::endl;
 }
 
+/*!
+	Display the memory used by the patch.
+
+	When the patch is partitioned, the function is a collective operation:
+	it should be called by all the processes of the patch communicator and
+	it will also display the maximum memory used by a single process and
+	the memory used by the whole patch.
+
+	\param[in,out] out output stream
+	\param[in] padding (default = 0) number of leading spaces for
+	formatted output
+*/
+void PatchKernel::displayMemoryStats(std::ostream &out, unsigned int padding) const
+{
+	std::string indent = std::string(padding, ' ');
+
+	auto formatMemory = [](std::size_t memory) {
+		std::ostringstream stream;
+		stream << std::fixed << std::setprecision(3) << std::setw(12) << (memory / (1024. * 1024.)) << " MiB";
+
+		return stream.str();
+	};
+
+	std::map<std::string, std::size_t> breakdown = getMemoryUsageBreakdown();
+
+	std::size_t nameWidth = 0;
+	for (const auto &entry : breakdown) {
+		nameWidth = std::max(nameWidth, entry.first.size());
+	}
+
+	std::size_t totalMemory = 0;
+	for (const auto &entry : breakdown) {
+		totalMemory += entry.second;
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	if (isPartitioned()) {
+		std::vector<uint64_t> maxMemories;
+		maxMemories.reserve(breakdown.size() + 1);
+		for (const auto &entry : breakdown) {
+			maxMemories.push_back(entry.second);
+		}
+		maxMemories.push_back(totalMemory);
+		MPI_Allreduce(MPI_IN_PLACE, maxMemories.data(), static_cast<int>(maxMemories.size()), MPI_UINT64_T, MPI_MAX, getCommunicator());
+
+		std::map<std::string, std::size_t> globalBreakdown = getGlobalMemoryUsageBreakdown();
+
+		std::size_t globalTotalMemory = 0;
+		for (const auto &entry : globalBreakdown) {
+			globalTotalMemory += entry.second;
+		}
+
+		out << indent << "Memory ----------------------------------" << std::endl;
+		out << indent << "  " << std::left << std::setw(nameWidth) << "component" << std::right;
+		out << std::setw(17) << "local" << std::setw(17) << "max" << std::setw(17) << "global" << std::endl;
+
+		std::size_t k = 0;
+		for (const auto &entry : breakdown) {
+			out << indent << "  " << std::left << std::setw(nameWidth) << entry.first << std::right;
+			out << formatMemory(entry.second) << formatMemory(maxMemories[k]) << formatMemory(globalBreakdown.at(entry.first)) << std::endl;
+			++k;
+		}
+
+		out << indent << "  " << std::left << std::setw(nameWidth) << "total" << std::right;
+		out << formatMemory(totalMemory) << formatMemory(maxMemories.back()) << formatMemory(globalTotalMemory) << std::endl;
+
+		return;
+	}
+#endif
+
+	out << indent << "Memory ----------------------------------" << std::endl;
+	for (const auto &entry : breakdown) {
+		out << indent << "  " << std::left << std::setw(nameWidth) << entry.first << std::right;
+		out << formatMemory(entry.second) << std::endl;
+	}
+
+	out << indent << "  " << std::left << std::setw(nameWidth) << "total" << std::right;
+	out << formatMemory(totalMemory) << std::endl;
+}
+
 /*!
 	Display all the vertices currently stored within the patch.
 
@@ -8235,6 +11576,9 @@ void PatchKernel::consecutiveRenumberCells(long offset)
 		createCellIndexGenerator(true);
 	}
 
+	// Rebuild the vertex incidence
+	updateVertexIncidence(true);
+
 #if BITPIT_ENABLE_MPI==1
 	// Update partitioning information
 	if (isPartitioned()) {
@@ -8518,6 +11862,87 @@ void PatchKernel::restore(std::istream &stream, bool reregister)
 	}
 }
 
+/*!
+ *  Write the patch to a checkpoint archive.
+ *
+ *  Checkpoint archives are memory-mappable binary archives: vertex, cell
+ *  and interface data is stored in contiguous aligned sections, whereas
+ *  the remaining information is stored in the metadata of the archive.
+ *  Names of checkpoint archives follow the same rules used for binary
+ *  archives, hence, for partitioned patches, each process should write
+ *  its own block.
+ *
+ *  Dumping a patch that is not up-to-date is not supported. If the patch is
+ *  not up-to-date, it will be automatically updated before dump it.
+ *
+ *  \param name is the name of the archive
+ *  \param block is the parallel block the archive belongs to, a negative
+ *  value mean that the archive is serial
+ *  \result Return true if the patch was successfully dumped, false otherwise.
+ */
+bool PatchKernel::dumpCheckpoint(const std::string &name, int block)
+{
+	// Update the patch
+	update();
+
+	// Dump the patch
+	const PatchKernel *constPatch = this;
+	return constPatch->dumpCheckpoint(name, block);
+}
+
+/*!
+ *  Write the patch to a checkpoint archive.
+ *
+ *  Checkpoint archives are memory-mappable binary archives: vertex, cell
+ *  and interface data is stored in contiguous aligned sections, whereas
+ *  the remaining information is stored in the metadata of the archive.
+ *  Names of checkpoint archives follow the same rules used for binary
+ *  archives, hence, for partitioned patches, each process should write
+ *  its own block.
+ *
+ *  Dumping a patch that is not up-to-date is not supported. If the patch is
+ *  not up-to-date and compilation of assertions is enabled, the function will
+ *  assert, whereas if compilation of assertions is not enabled, the function
+ *  is a no-op.
+ *
+ *  \param name is the name of the archive
+ *  \param block is the parallel block the archive belongs to, a negative
+ *  value mean that the archive is serial
+ *  \result Return true if the patch was successfully dumped, false otherwise.
+ */
+bool PatchKernel::dumpCheckpoint(const std::string &name, int block) const
+{
+	OMappedArchive archive(name, getDumpVersion(), block);
+	bool dumped = dump(archive);
+	archive.close();
+
+	return dumped;
+}
+
+/*!
+ *  Restore the patch from a checkpoint archive.
+ *
+ *  The archive is mapped in memory and vertex, cell and interface data is
+ *  loaded directly from the mapping, without intermediate buffers. Memory
+ *  pages of the archive are released as soon as the corresponding data
+ *  has been loaded.
+ *
+ *  \param name is the name of the archive
+ *  \param block is the parallel block the archive belongs to, a negative
+ *  value mean that the archive is serial
+ *  \param reregister is true the patch will be unregistered and then
+ *  registered again using the id found in the archive
+ */
+void PatchKernel::restoreCheckpoint(const std::string &name, int block, bool reregister)
+{
+	IMappedArchive archive(name, block);
+	if (!archive.checkVersion(getDumpVersion())) {
+		throw std::runtime_error ("The version of the checkpoint does not match the required version");
+	}
+
+	restore(archive, reregister);
+}
+
 /*!
  *  Merge the specified adaption info.
  *
@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <deque>
 #include <iostream>
+#include <map>
 #include <memory>
 #if BITPIT_ENABLE_MPI==1
 #	include <mpi.h>
@@ -46,6 +47,7 @@
 #include "adaption.hpp"
 #include "cell.hpp"
 #include "compiler.hpp"
+#include "element_arena.hpp"
 #include "interface.hpp"
 #include "vertex.hpp"
 
@@ -318,7 +320,16 @@ public:
 	*/
 	enum AdjacenciesBuildStrategy {
 		ADJACENCIES_NONE = -1,
-		ADJACENCIES_AUTOMATIC
+		ADJACENCIES_AUTOMATIC,
+		ADJACENCIES_SORTED
+	};
+
+	/*!
+		Connectivity storage mode
+	*/
+	enum ConnectivityStorageMode {
+		CONNECTIVITY_STORAGE_ELEMENT = 0,
+		CONNECTIVITY_STORAGE_PATCH
 	};
 
 	/*!
@@ -329,6 +340,18 @@ public:
 		INTERFACES_AUTOMATIC
 	};
 
+	/*!
+		Spatial ordering
+	*/
+	enum SpatialOrdering {
+		SPATIAL_ORDERING_HILBERT, //! Cells are ordered along the Hilbert curve
+		                          //! that passes through their centroids
+		SPATIAL_ORDERING_MORTON, //! Cells are ordered along the Morton curve
+		                         //! that passes through their centroids
+		SPATIAL_ORDERING_RCM, //! Cells are ordered using the reverse Cuthill-McKee
+		                      //! algorithm applied to the cell adjacency graph
+	};
+
 	/*!
 		Adaption mode
 	*/
@@ -637,6 +660,7 @@ public:
 	bool sortVertices();
 	bool sortCells();
 	bool sortInterfaces();
+	std::vector<adaption::Info> reorder(SpatialOrdering ordering, bool renumber = false, bool trackReorder = true);
 
 	bool squeeze();
 	bool squeezeVertices();
@@ -645,6 +669,10 @@ public:
 
 	long locatePoint(double x, double y, double z) const;
 	virtual long locatePoint(const std::array<double, 3> &point) const = 0;
+	virtual void locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const;
+
+	ConnectivityStorageMode getConnectivityStorageMode() const;
+	void setConnectivityStorageMode(ConnectivityStorageMode mode);
 
 	AdjacenciesBuildStrategy getAdjacenciesBuildStrategy() const;
 	bool areAdjacenciesDirty(bool global = false) const;
@@ -660,6 +688,22 @@ public:
 	void updateInterfaces(bool forcedUpdated = false);
 	void destroyInterfaces();
 
+	bool isGeometryCacheEnabled() const;
+	bool isGeometryCacheDirty(bool global = false) const;
+	void initializeGeometryCache();
+	void updateGeometryCache(bool forcedUpdated = false);
+	void destroyGeometryCache();
+	std::array<double, 3> getCachedCellCentroid(long id) const;
+	const PiercedStorage<double, long> & getCellCentroidCache(int component) const;
+
+	bool isVertexIncidenceEnabled() const;
+	bool isVertexIncidenceDirty(bool global = false) const;
+	void initializeVertexIncidence();
+	void updateVertexIncidence(bool forcedUpdated = false);
+	void destroyVertexIncidence();
+	int getVertexIncidentCellCount(long vertexId) const;
+	const long * getVertexIncidentCells(long vertexId) const;
+
 	void getBoundingBox(std::array<double, 3> &minPoint, std::array<double, 3> &maxPoint) const;
 	void getBoundingBox(bool global, std::array<double, 3> &minPoint, std::array<double, 3> &maxPoint) const;
 	bool isBoundingBoxDirty(bool global = false) const;
@@ -681,7 +725,15 @@ public:
 	void resetTol();
 	bool isTolCustomized() const;
 
+	std::size_t getMemoryUsage() const;
+	std::map<std::string, std::size_t> getMemoryUsageBreakdown() const;
+#if BITPIT_ENABLE_MPI==1
+	std::size_t getGlobalMemoryUsage() const;
+	std::map<std::string, std::size_t> getGlobalMemoryUsageBreakdown() const;
+#endif
+
 	void displayTopologyStats(std::ostream &out, unsigned int padding = 0) const;
+	void displayMemoryStats(std::ostream &out, unsigned int padding = 0) const;
 	void displayVertices(std::ostream &out, unsigned int padding = 0) const;
 	void displayCells(std::ostream &out, unsigned int padding = 0) const;
 	void displayInterfaces(std::ostream &out, unsigned int padding = 0) const;
@@ -703,6 +755,10 @@ public:
 	bool dump(std::ostream &stream) const;
 	void restore(std::istream &stream, bool reregister = false);
 
+	bool dumpCheckpoint(const std::string &name, int block = -1);
+	bool dumpCheckpoint(const std::string &name, int block = -1) const;
+	void restoreCheckpoint(const std::string &name, int block = -1, bool reregister = false);
+
 	void consecutiveRenumberVertices(long offset = 0);
 	void consecutiveRenumberCells(long offset = 0);
 	void consecutiveRenumberInterfaces(long offset = 0);
@@ -783,6 +839,19 @@ public:
 	template<typename Selector, typename Function, typename SeedContainer>
 	void processCellsFaceNeighbours(const SeedContainer &seedIds, int nLayers, Selector isSelected, Function function) const;
 
+	template<typename Function>
+	void parallelForVertices(Function function);
+	template<typename Function>
+	void parallelForVertices(Function function) const;
+	template<typename Function>
+	void parallelForCells(Function function);
+	template<typename Function>
+	void parallelForCells(Function function) const;
+	template<typename Function>
+	void parallelForInterfaces(Function function);
+	template<typename Function>
+	void parallelForInterfaces(Function function) const;
+
 	std::array<double, 3> evalElementCentroid(const Element &element) const;
 	void evalElementBoundingBox(const Element &element, std::array<double,3> *minPoint, std::array<double,3> *maxPoint) const;
 	BITPIT_DEPRECATED(ConstProxyVector<std::array<double BITPIT_COMMA 3>> getElementVertexCoordinates(const Element &element) const);
@@ -802,6 +871,13 @@ protected:
 	const static AlterationFlags FLAG_ADJACENCIES_DIRTY = (1u << 1);
 	const static AlterationFlags FLAG_INTERFACES_DIRTY  = (1u << 2);
 	const static AlterationFlags FLAG_DANGLING          = (1u << 3);
+	const static AlterationFlags FLAG_GEOMETRY_DIRTY    = (1u << 4);
+
+	const static std::size_t GEOMETRY_CACHE_CELL_CENTROID = 0;
+
+	const static std::size_t VERTEX_INCIDENCE_ROW_OFFSET   = 0;
+	const static std::size_t VERTEX_INCIDENCE_ROW_COUNT    = 1;
+	const static std::size_t VERTEX_INCIDENCE_ROW_CAPACITY = 2;
 
 	PiercedVector<Vertex> m_vertices;
 	PiercedVector<Cell> m_cells;
@@ -874,6 +950,8 @@ protected:
 	void updateFirstGhostCellId();
 #endif
 
+	std::vector<long> evalSpatialCellOrder(SpatialOrdering ordering, const std::vector<long> &cellIds) const;
+
 	std::unordered_map<long, std::vector<long>> binGroupVertices(const PiercedVector<Vertex> &vertices, int nBins);
 	std::unordered_map<long, std::vector<long>> binGroupVertices(int nBins);
 
@@ -882,12 +960,30 @@ protected:
 	void pruneStaleAdjacencies();
 	virtual void _resetAdjacencies(bool release);
 	virtual void _updateAdjacencies();
+	void matchSortedHalfFaces(const std::vector<Cell *> &processList, const std::vector<CellHalfFace::Winding> &matchingWindings, bool multipleMatchesAllowed);
 
 	void setInterfacesBuildStrategy(InterfacesBuildStrategy status);
 	void pruneStaleInterfaces();
 	virtual void _resetInterfaces(bool release);
 	virtual void _updateInterfaces();
 
+	void setGeometryCacheStale();
+	bool isGeometryCacheUpToDate() const;
+	virtual std::size_t getCellGeometryCacheFieldCount() const;
+	virtual std::size_t getInterfaceGeometryCacheFieldCount() const;
+	PiercedStorage<double, long> & getCellGeometryCacheField(std::size_t field);
+	const PiercedStorage<double, long> & getCellGeometryCacheField(std::size_t field) const;
+	PiercedStorage<double, long> & getInterfaceGeometryCacheField(std::size_t field);
+	const PiercedStorage<double, long> & getInterfaceGeometryCacheField(std::size_t field) const;
+	virtual void _updateGeometryCache(const std::vector<long> &cellIds, const std::vector<long> &interfaceIds);
+
+	void setVertexIncidenceStale();
+	bool isVertexIncidenceUsable() const;
+	void addCellVertexIncidences(const Cell &cell);
+	void removeCellVertexIncidences(const Cell &cell);
+	void addVertexIncidence(std::size_t vertexRawIndex, long cellId);
+	void removeVertexIncidence(std::size_t vertexRawIndex, long cellId);
+
 	bool testCellAlterationFlags(long id, AlterationFlags flags) const;
 	AlterationFlags getCellAlterationFlags(long id) const;
 	void resetCellAlterationFlags(long id, AlterationFlags flags = FLAG_NONE);
@@ -920,6 +1016,11 @@ protected:
 	virtual void _setTol(double tolerance);
 	virtual void _resetTol();
 
+	virtual void _resetPointLocator();
+	std::size_t getPointLocatorRevision() const;
+
+	virtual void _getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const;
+
 	virtual int _getDumpVersion() const = 0;
 	virtual void _dump(std::ostream &stream) const = 0;
 	virtual void _restore(std::istream &stream) = 0;
@@ -961,6 +1062,9 @@ protected:
 	template<typename item_t, typename id_t = long>
 	void mappedItemRenumbering(PiercedVector<item_t, id_t> &container, const std::unordered_map<id_t, id_t> &renumberMap);
 
+	template<typename container_t, typename Function>
+	static void parallelForItems(container_t &container, Function function);
+
 	virtual int findAdjoinNeighFace(const Cell &cell, int cellFace, const Cell &neigh) const;
 	virtual bool isSameFace(const Cell &cell_A, int face_A, const Cell &cell_B, int face_B) const;
 
@@ -1013,6 +1117,27 @@ private:
 
 	InterfacesBuildStrategy m_interfacesBuildStrategy;
 
+	ConnectivityStorageMode m_connectivityStorageMode;
+	std::unique_ptr<ElementArena> m_cellConnectArena;
+	std::unique_ptr<ElementArena> m_cellAdjacenciesArena;
+	std::unique_ptr<ElementArena> m_cellInterfacesArena;
+	std::unique_ptr<ElementArena> m_interfaceConnectArena;
+
+	bool m_geometryCacheEnabled;
+	bool m_geometryCacheStale;
+	bool m_geometryCacheUpToDate;
+	std::vector<long> m_geometryCacheDirtyInterfaces;
+	std::vector<std::unique_ptr<PiercedStorage<double, long>>> m_cellGeometryCache;
+	std::vector<std::unique_ptr<PiercedStorage<double, long>>> m_interfaceGeometryCache;
+
+	bool m_vertexIncidenceEnabled;
+	bool m_vertexIncidenceStale;
+	std::unique_ptr<PiercedStorage<std::size_t, long>> m_vertexIncidenceRows;
+	std::vector<long> m_vertexIncidenceCells;
+	std::size_t m_vertexIncidenceWaste;
+
+	std::size_t m_pointLocatorRevision;
+
 	AdaptionMode m_adaptionMode;
 	AdaptionStatus m_adaptionStatus;
 
@@ -1098,7 +1223,41 @@ private:
 
 	void finalizeAlterations(bool squeezeStorage = false);
 
+	void invalidatePointLocator();
+
+	void invalidateGeometryCache();
+
+	void storeConnectivityInPatch();
+	void storeConnectivityInElements();
+
+	void updateCellConnectStorage(Cell &cell);
+	void updateInterfaceConnectStorage(Interface &interface);
+	void unsetCellArenaStorage(Cell &cell);
+	void unsetInterfaceArenaStorage(Interface &interface);
+	void updateCellAdjacenciesStorage();
+	void updateCellInterfacesStorage();
+
+	void compactCellArenas();
+	void compactCellConnectArena(std::size_t extraCapacity = 0);
+	void compactCellAdjacenciesArena(std::size_t extraCapacity = 0);
+	void compactCellInterfacesArena(std::size_t extraCapacity = 0);
+	void compactInterfaceConnectArena(std::size_t extraCapacity = 0);
+
+	template<typename item_t>
+	static void storeConnectInArena(item_t &item, ElementArena *arena);
+	template<typename item_t>
+	static void compactConnectArena(PiercedVector<item_t, long> &items, ElementArena *arena, std::size_t extraCapacity = 0);
+	template<typename item_t>
+	static void releaseConnectArena(PiercedVector<item_t, long> &items);
+
+	void storeCellNeighbourhoodInArena(ArenaFlatVector2D Cell::*neighbourhood, ElementArena *arena);
+	void compactCellNeighbourhoodArena(ArenaFlatVector2D Cell::*neighbourhood, ElementArena *arena, std::size_t extraCapacity = 0);
+	void releaseCellNeighbourhoodArena(ArenaFlatVector2D Cell::*neighbourhood);
+
+	static std::size_t getArenaGrowth(const ElementArena &arena);
+
 	InterfaceIterator buildCellInterface(Cell *cell_1, int face_1, Cell *cell_2, int face_2, long interfaceId = Element::NULL_ID);
+	bool buildInterfacesInBulk();
 
 	void _setId(int id);
 
@@ -1134,6 +1293,15 @@ private:
 	void createInterfaceIndexGenerator(bool populate);
 	void importInterfaceIndexGenerator(const PatchKernel &source);
 
+	void dumpMappedVertices(OMappedArchive &archive) const;
+	void restoreMappedVertices(IMappedArchive &archive);
+
+	void dumpMappedCells(OMappedArchive &archive) const;
+	void restoreMappedCells(IMappedArchive &archive);
+
+	void dumpMappedInterfaces(OMappedArchive &archive) const;
+	void restoreMappedInterfaces(IMappedArchive &archive);
+
 	VertexIterator _addInternalVertex(const std::array<double, 3> &coords, long id);
 
 	void _restoreInternalVertex(const VertexIterator &iterator, const std::array<double, 3> &coords);
@@ -25,6 +25,7 @@
 #ifndef __BITPIT_PATCH_KERNEL_TPP__
 #define __BITPIT_PATCH_KERNEL_TPP__
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace bitpit {
@@ -679,6 +680,247 @@ void PatchKernel::processCellsFaceNeighbours(const SeedContainer &seedIds, int n
 	}
 }
 
+/*!
+	Applies the specified function to all the vertices of the patch.
+
+	Vertices are split into chunks that are processed concurrently using the
+	threading backend selected through the utilities in utils::threads. The
+	function will receive in input a reference to the vertex to be processed.
+	The function may be called concurrently from different threads, hence it
+	should only modify the vertex it receives. The patch should not be
+	modified (i.e., vertices should not be added or deleted) while the
+	vertices are being processed.
+
+	\param function is the function that will be applied to the vertices
+*/
+template<typename Function>
+void PatchKernel::parallelForVertices(Function function)
+{
+	parallelForItems(m_vertices, function);
+}
+
+/*!
+	Applies the specified function to all the vertices of the patch.
+
+	See the non-constant version of this function for the details.
+
+	\param function is the function that will be applied to the vertices,
+	it will receive in input a constant reference to the vertex
+*/
+template<typename Function>
+void PatchKernel::parallelForVertices(Function function) const
+{
+	parallelForItems(m_vertices, function);
+}
+
+/*!
+	Applies the specified function to all the cells of the patch.
+
+	Cells are split into chunks that are processed concurrently using the
+	threading backend selected through the utilities in utils::threads. The
+	function will receive in input a reference to the cell to be processed.
+	The function may be called concurrently from different threads, hence it
+	should only modify the cell it receives. The patch should not be modified
+	(i.e., cells should not be added or deleted) while the cells are being
+	processed.
+
+	\param function is the function that will be applied to the cells
+*/
+template<typename Function>
+void PatchKernel::parallelForCells(Function function)
+{
+	parallelForItems(m_cells, function);
+}
+
+/*!
+	Applies the specified function to all the cells of the patch.
+
+	See the non-constant version of this function for the details.
+
+	\param function is the function that will be applied to the cells, it
+	will receive in input a constant reference to the cell
+*/
+template<typename Function>
+void PatchKernel::parallelForCells(Function function) const
+{
+	parallelForItems(m_cells, function);
+}
+
+/*!
+	Applies the specified function to all the interfaces of the patch.
+
+	Interfaces are split into chunks that are processed concurrently using
+	the threading backend selected through the utilities in utils::threads.
+	The function will receive in input a reference to the interface to be
+	processed. The function may be called concurrently from different threads,
+	hence it should only modify the interface it receives. The patch should
+	not be modified (i.e., interfaces should not be added or deleted) while
+	the interfaces are being processed.
+
+	\param function is the function that will be applied to the interfaces
+*/
+template<typename Function>
+void PatchKernel::parallelForInterfaces(Function function)
+{
+	parallelForItems(m_interfaces, function);
+}
+
+/*!
+	Applies the specified function to all the interfaces of the patch.
+
+	See the non-constant version of this function for the details.
+
+	\param function is the function that will be applied to the interfaces,
+	it will receive in input a constant reference to the interface
+*/
+template<typename Function>
+void PatchKernel::parallelForInterfaces(Function function) const
+{
+	parallelForItems(m_interfaces, function);
+}
+
+/*!
+	Applies the specified function to all the items of the given container.
+
+	The container is split into a number of chunks larger than the number of
+	threads, this allows to balance the load among the threads also when the
+	items are not evenly distributed among the raw positions of the container
+	or when the cost of processing the items is not uniform.
+
+	\param container is the container
+	\param function is the function that will be applied to the items
+*/
+template<typename container_t, typename Function>
+void PatchKernel::parallelForItems(container_t &container, Function function)
+{
+	// Small containers are processed by the calling thread
+	static const std::size_t MIN_CHUNK_SIZE = 256;
+
+	std::size_t nThreads = static_cast<std::size_t>(utils::threads::getThreadCount());
+	std::size_t nMaxChunks = std::max(container.size() / MIN_CHUNK_SIZE, std::size_t(1));
+	std::size_t nChunks = std::min(4 * nThreads, nMaxChunks);
+	if (nChunks <= 1) {
+		for (auto &item : container) {
+			function(item);
+		}
+
+		return;
+	}
+
+	// Process the chunks
+	auto chunks = container.split(nChunks);
+	utils::threads::parallelFor(chunks.size(), [&chunks, &function](std::size_t k) {
+		for (auto &item : chunks[k]) {
+			function(item);
+		}
+	});
+}
+
+/*!
+	Stores the connectivity of the specified item in the given arena.
+
+	If the arena has enough capacity, the connectivity is appended at the
+	end of the arena. Otherwise, the item keeps its own connectivity storage
+	and the size of its connectivity is added to the pending values of the
+	arena. The arena is never reallocated by this function, hence pointers
+	to the connectivity of the other items remain valid. Pending connectivity
+	will be moved into the arena the next time the arena is compacted.
+
+	\param item is the item
+	\param arena is the arena
+*/
+template<typename item_t>
+void PatchKernel::storeConnectInArena(item_t &item, ElementArena *arena)
+{
+	const long *connect = item.getConnect();
+	if (!connect) {
+		return;
+	}
+
+	// Defer the storage if there is not enough space
+	std::size_t connectSize = static_cast<std::size_t>(item.getConnectSize());
+	if (!arena->hasRoom(connectSize)) {
+		arena->addPending(connectSize);
+		return;
+	}
+
+	// Append the connectivity
+	std::size_t offset = arena->store(connect, connectSize);
+	item.setArenaConnect(arena, offset);
+}
+
+/*!
+	Compacts the given connectivity arena.
+
+	The connectivity of all the items of the container is copied into a
+	new storage, following the order of the items inside the container,
+	and the new storage replaces the contents of the arena. Items will then
+	reference their connectivity through its offset inside the arena. The
+	connectivity of items that own their storage is moved into the arena as
+	well.
+
+	\param items is the container
+	\param arena is the arena
+	\param extraCapacity is the additional capacity that will be reserved
+	in the arena
+*/
+template<typename item_t>
+void PatchKernel::compactConnectArena(PiercedVector<item_t, long> &items, ElementArena *arena, std::size_t extraCapacity)
+{
+	// Evaluate the size of the arena
+	std::size_t arenaSize = 0;
+	for (const item_t &item : items) {
+		if (item.getConnect()) {
+			arenaSize += item.getConnectSize();
+		}
+	}
+
+	// Fill the new storage
+	//
+	// Items that are already stored in the arena keep reading their
+	// connectivity from the current contents of the arena until the
+	// contents are replaced.
+	std::vector<long> compactedValues;
+	compactedValues.reserve(arenaSize + extraCapacity);
+	for (item_t &item : items) {
+		const long *connect = item.getConnect();
+		if (!connect) {
+			continue;
+		}
+
+		std::size_t offset = compactedValues.size();
+		compactedValues.insert(compactedValues.end(), connect, connect + item.getConnectSize());
+		item.setArenaConnect(arena, offset);
+	}
+
+	// Replace the contents of the arena
+	arena->assign(std::move(compactedValues));
+}
+
+/*!
+	Releases the given connectivity arena.
+
+	Each item stored in the arena will receive a storage that contains a
+	copy of its connectivity.
+
+	\param items is the container
+*/
+template<typename item_t>
+void PatchKernel::releaseConnectArena(PiercedVector<item_t, long> &items)
+{
+	for (item_t &item : items) {
+		if (!item.hasArenaConnect()) {
+			continue;
+		}
+
+		const long *connect = item.getConnect();
+		std::size_t connectSize = static_cast<std::size_t>(item.getConnectSize());
+		std::unique_ptr<long[]> connectStorage = std::unique_ptr<long[]>(new long[connectSize]);
+		std::copy(connect, connect + connectSize, connectStorage.get());
+		item.setConnect(std::move(connectStorage));
+	}
+}
+
 }
 
 #endif
@@ -1075,6 +1075,9 @@ PatchKernel::CellIterator PatchKernel::_addGhostCell(ElementType type, std::uniq
 	}
 	m_nGhostCells++;
 
+	// Update the storage of the connectivity
+	updateCellConnectStorage(*iterator);
+
 	// Update the id of the first ghost cell
 	if (m_firstGhostCellId < 0) {
 		m_firstGhostCellId = id;
@@ -1163,6 +1166,9 @@ void PatchKernel::_restoreGhostCell(const CellIterator &iterator, ElementType ty
 	cell.initialize(iterator.getId(), type, std::move(connectStorage), false, storeInterfaces, storeAdjacencies);
 	m_nGhostCells++;
 
+	// Update the storage of the connectivity
+	updateCellConnectStorage(cell);
+
 	// Set ghost information
 	setGhostCellInfo(cellId, owner, haloLayer);
 
@@ -1184,6 +1190,7 @@ void PatchKernel::_deleteGhostCell(long id)
 	setDeletedCellAlterationFlags(id);
 
 	// Delete cell
+	unsetCellArenaStorage(m_cells[id]);
 	m_cells.erase(id, true);
 	m_nGhostCells--;
 	if (id == m_firstGhostCellId) {
@@ -1727,6 +1734,58 @@ void PatchKernel::setPartitioningMode(PartitioningMode mode)
 	m_partitioningMode = mode;
 }
 
+/*!
+	Evaluates the memory used by all the partitions of the patch.
+
+	If the patch is partitioned, this is a collective operation and should
+	be called by all the processes of the patch communicator.
+
+	\result The memory, expressed in bytes, used by all the partitions of
+	the patch.
+*/
+std::size_t PatchKernel::getGlobalMemoryUsage() const
+{
+	uint64_t memoryUsage = getMemoryUsage();
+	if (isPartitioned()) {
+		MPI_Allreduce(MPI_IN_PLACE, &memoryUsage, 1, MPI_UINT64_T, MPI_SUM, getCommunicator());
+	}
+
+	return memoryUsage;
+}
+
+/*!
+	Evaluates the memory used by the components of all the partitions of
+	the patch.
+
+	If the patch is partitioned, this is a collective operation and should
+	be called by all the processes of the patch communicator.
+
+	\result The memory, expressed in bytes, used by the components of all
+	the partitions of the patch.
+*/
+std::map<std::string, std::size_t> PatchKernel::getGlobalMemoryUsageBreakdown() const
+{
+	std::map<std::string, std::size_t> breakdown = getMemoryUsageBreakdown();
+	if (!isPartitioned()) {
+		return breakdown;
+	}
+
+	std::vector<uint64_t> memoryUsages;
+	memoryUsages.reserve(breakdown.size());
+	for (const auto &entry : breakdown) {
+		memoryUsages.push_back(entry.second);
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, memoryUsages.data(), static_cast<int>(memoryUsages.size()), MPI_UINT64_T, MPI_SUM, getCommunicator());
+
+	std::size_t k = 0;
+	for (auto &entry : breakdown) {
+		entry.second = memoryUsages[k++];
+	}
+
+	return breakdown;
+}
+
 /*!
 	Returns the current partitioning status.
 
@@ -3752,7 +3811,7 @@ std::vector<adaption::Info> PatchKernel::_partitioningAlter_receiveCells(const s
     }
 
     // Update adjacencies
-    if (getAdjacenciesBuildStrategy() == ADJACENCIES_AUTOMATIC) {
+    if (getAdjacenciesBuildStrategy() != ADJACENCIES_NONE) {
         updateAdjacencies();
     }
 
@@ -1077,6 +1077,31 @@ std::size_t PatchSkdTree::getLeafMaxCellCount() const
 *
 */
 void PatchSkdTree::build(std::size_t leafThreshold, bool squeezeStorage)
+{
+    build(leafThreshold, squeezeStorage, true);
+}
+
+/*!
+* Build the tree.
+*
+* If the patch is partitioned, the information about the partitions are
+* needed only by the searches that involve the cells of all the processes.
+* Building those information requires collective communications, hence,
+* when they are requested, all the processes should build the tree. If the
+* tree is only used for searching the cells of the current process, the
+* partition information can be skipped and the tree can be built by each
+* process independently.
+*
+* \param leafThreshold is the maximum number of "characteristic positions"
+* a node can contain to be considered a leaf
+* \param[in] squeezeStorage if set to true tree data structures will be
+* squeezed after the build
+* \param[in] buildPartitionInfo if set to true and the patch is partitioned,
+* the information about the partitions will be built. Searches that involve
+* the cells of all the processes are available only if this information has
+* been built
+*/
+void PatchSkdTree::build(std::size_t leafThreshold, bool squeezeStorage, bool buildPartitionInfo)
 {
     const PatchKernel &patch = m_patchInfo.getPatch();
 
@@ -1147,7 +1172,7 @@ void PatchSkdTree::build(std::size_t leafThreshold, bool squeezeStorage)
 
 #if BITPIT_ENABLE_MPI
     // Set partition information
-    if (patch.isPartitioned()){
+    if (buildPartitionInfo && patch.isPartitioned()){
         // Set communicator
         setCommunicator(patch.getCommunicator());
 
@@ -1157,6 +1182,8 @@ void PatchSkdTree::build(std::size_t leafThreshold, bool squeezeStorage)
         m_rank        = 0;
         m_nProcessors = 1;
     }
+#else
+    BITPIT_UNUSED(buildPartitionInfo);
 #endif
 }
 
@@ -1220,6 +1247,31 @@ std::size_t PatchSkdTree::getLeafCount() const
       return m_nLeafs;
 }
 
+/*!
+* Evaluates the memory used by the tree.
+*
+* The memory includes the nodes, the list of cells sorted by leaf and,
+* if it is currently allocated, the cache of cell bounding boxes. The
+* memory occupied by the tree object itself is not included.
+*
+* \result The memory, expressed in bytes, used by the tree.
+*/
+std::size_t PatchSkdTree::getMemoryUsage() const
+{
+    std::size_t memoryUsage = 0;
+    memoryUsage += utils::getMemoryUsage(m_nodes);
+    memoryUsage += utils::getMemoryUsage(m_cellRawIds);
+    if (m_patchInfo.m_cellBoxes) {
+        memoryUsage += m_patchInfo.m_cellBoxes->getMemoryUsage();
+    }
+
+#if BITPIT_ENABLE_MPI
+    memoryUsage += utils::getMemoryUsage(m_partitionBoxes);
+#endif
+
+    return memoryUsage;
+}
+
 /*!
 * Get a constant reference to the specified node.
 *
@@ -177,6 +177,7 @@ public:
     virtual ~PatchSkdTree() = default;
 
     void build(std::size_t leaftThreshold = 1, bool squeezeStorage = false);
+    void build(std::size_t leaftThreshold, bool squeezeStorage, bool buildPartitionInfo);
     void clear(bool release = false);
 
     const PatchKernel & getPatch() const;
@@ -187,6 +188,8 @@ public:
     std::size_t getNodeCount() const;
     std::size_t getLeafCount() const;
 
+    std::size_t getMemoryUsage() const;
+
     const SkdNode & getNode(std::size_t nodeId) const;
 
     std::size_t evalMaxDepth(std::size_t rootId = 0) const;
@@ -613,6 +613,74 @@ long SurfaceSkdTree::findPointClosestCells(const std::array<double, 3> &point, d
     return nDistanceEvaluations;
 }
 
+/*!
+* Locates the cell that contains the specified point.
+*
+* A point is contained in a surface cell if its distance from the cell is
+* less than the tolerance of the patch.
+*
+* \param[in] point is the point
+* \result Returns the id of the cell that contains the point. If the point
+* is not contained in any of the cells of the tree, the function returns
+* the id of the null element.
+*/
+long SurfaceSkdTree::locatePoint(const std::array<double, 3> &point) const
+{
+    double tolerance = getPatch().getTol();
+
+    long id;
+    double distance = tolerance;
+    findPointClosestCell(point, tolerance, &id, &distance);
+    if (distance > tolerance) {
+        return Cell::NULL_ID;
+    }
+
+    return id;
+}
+
+/*!
+* Locates the cells that contain the specified points.
+*
+* Points are processed following their order along a space-filling curve,
+* this way points that are close together are located one after the other
+* and the nodes of the tree visited while locating a point are likely to be
+* reused for locating the following one. If lookups are thread-safe, points
+* are located concurrently.
+*
+* \param[in] nPoints is the number of points
+* \param[in] points are the points
+* \param[out] ids on output will contain the ids of the cells that contain
+* the points. If a point is not contained in any of the cells of the tree,
+* the related id will be set to the id of the null element
+*/
+void SurfaceSkdTree::locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const
+{
+    static const std::size_t CHUNK_SIZE = 256;
+
+    // Sort the points along a space-filling curve
+    std::vector<std::size_t> order;
+    utils::sfc::computeMortonOrder(nPoints, points, &order);
+
+    // Locate the points
+    if (!areLookupsThreadSafe()) {
+        for (std::size_t i : order) {
+            ids[i] = locatePoint(points[i]);
+        }
+
+        return;
+    }
+
+    std::size_t nChunks = (order.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+        std::size_t chunkBegin = chunk * CHUNK_SIZE;
+        std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, order.size());
+        for (std::size_t k = chunkBegin; k < chunkEnd; ++k) {
+            std::size_t i = order[k];
+            ids[i] = locatePoint(points[i]);
+        }
+    });
+}
+
 /*!
 * Given the specified point find the closest candidate cells contained
 * in the tree and estimate the minimum distances between each of those
@@ -61,6 +61,9 @@ public:
     long findPointClosestCells(const std::array<double, 3> &point, double maxDistance, std::vector<long> &ids, double *distance) const;
     long findPointClosestCells(const std::array<double, 3> &point, double maxDistance, bool interorOnly, std::vector<long> &ids,  double *distance) const;
 
+    long locatePoint(const std::array<double, 3> &point) const;
+    void locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const;
+
 #if BITPIT_ENABLE_MPI
     long findPointClosestGlobalCell(int nPoints, const std::array<double, 3> *points, long *ids, int *ranks, double *distances) const;
     long findPointClosestGlobalCell(int nPoints, const std::array<double, 3> *points, double maxDistance, long *ids, int *ranks, double *distances) const;
@@ -22,6 +22,8 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include "bitpit_common.hpp"
+
 #include "volume_kernel.hpp"
 
 namespace bitpit {
@@ -313,4 +315,186 @@ int VolumeKernel::getFaceOrderedLocalVertex(const Cell &cell, int face, std::siz
     }
 }
 
+/*!
+	Gets the volume of the specified cell.
+
+	If the geometry cache is enabled the cached volume is returned,
+	otherwise the volume is evaluated.
+
+	\param id is the id of the cell
+	\result The volume of the specified cell.
+*/
+double VolumeKernel::getCachedCellVolume(long id) const
+{
+	if (!isGeometryCacheEnabled()) {
+		return evalCellVolume(id);
+	}
+
+	return getCellGeometryCacheField(GEOMETRY_CACHE_CELL_VOLUME).at(id);
+}
+
+/*!
+	Gets the area of the specified interface.
+
+	If the geometry cache is enabled the cached area is returned,
+	otherwise the area is evaluated.
+
+	\param id is the id of the interface
+	\result The area of the specified interface.
+*/
+double VolumeKernel::getCachedInterfaceArea(long id) const
+{
+	if (!isGeometryCacheEnabled()) {
+		return evalInterfaceArea(id);
+	}
+
+	return getInterfaceGeometryCacheField(GEOMETRY_CACHE_INTERFACE_AREA).at(id);
+}
+
+/*!
+	Gets the normal of the specified interface.
+
+	If the geometry cache is enabled the cached normal is returned,
+	otherwise the normal is evaluated.
+
+	\param id is the id of the interface
+	\result The normal of the specified interface.
+*/
+std::array<double, 3> VolumeKernel::getCachedInterfaceNormal(long id) const
+{
+	if (!isGeometryCacheEnabled()) {
+		return evalInterfaceNormal(id);
+	}
+
+	std::size_t rawIndex = getInterfaces().getRawIndex(id);
+
+	std::array<double, 3> normal;
+	for (int d = 0; d < 3; ++d) {
+		normal[d] = getInterfaceGeometryCacheField(GEOMETRY_CACHE_INTERFACE_NORMAL + d).rawAt(rawIndex);
+	}
+
+	return normal;
+}
+
+/*!
+	Gets the storage that contains the cached values of the cell volumes.
+
+	The geometry cache should be enabled, otherwise an exception is thrown.
+
+	\result The storage that contains the cached values of the cell volumes.
+*/
+const PiercedStorage<double, long> & VolumeKernel::getCellVolumeCache() const
+{
+	return getCellGeometryCacheField(GEOMETRY_CACHE_CELL_VOLUME);
+}
+
+/*!
+	Gets the storage that contains the cached values of the interface areas.
+
+	The geometry cache should be enabled, otherwise an exception is thrown.
+
+	\result The storage that contains the cached values of the interface
+	areas.
+*/
+const PiercedStorage<double, long> & VolumeKernel::getInterfaceAreaCache() const
+{
+	return getInterfaceGeometryCacheField(GEOMETRY_CACHE_INTERFACE_AREA);
+}
+
+/*!
+	Gets the storage that contains the cached values of the specified
+	component of the interface normals.
+
+	The geometry cache should be enabled, otherwise an exception is thrown.
+
+	\param component is the requested component
+	\result The storage that contains the cached values of the specified
+	component of the interface normals.
+*/
+const PiercedStorage<double, long> & VolumeKernel::getInterfaceNormalCache(int component) const
+{
+	assert(component >= 0 && component < 3);
+
+	return getInterfaceGeometryCacheField(GEOMETRY_CACHE_INTERFACE_NORMAL + component);
+}
+
+/*!
+	Gets the number of fields stored in the cell geometry cache.
+
+	\result The number of fields stored in the cell geometry cache.
+*/
+std::size_t VolumeKernel::getCellGeometryCacheFieldCount() const
+{
+	return (GEOMETRY_CACHE_CELL_VOLUME + 1);
+}
+
+/*!
+	Gets the number of fields stored in the interface geometry cache.
+
+	\result The number of fields stored in the interface geometry cache.
+*/
+std::size_t VolumeKernel::getInterfaceGeometryCacheFieldCount() const
+{
+	return (GEOMETRY_CACHE_INTERFACE_NORMAL + 3);
+}
+
+/*!
+	Internal function to update the geometry cache.
+
+	Entries are evaluated concurrently, hence the functions that evaluate
+	the geometrical quantities should be thread-safe.
+
+	\param cellIds are the ids of the cells whose entries will be updated
+	\param interfaceIds are the ids of the interfaces whose entries will be
+	updated
+*/
+void VolumeKernel::_updateGeometryCache(const std::vector<long> &cellIds, const std::vector<long> &interfaceIds)
+{
+	static const std::size_t CHUNK_SIZE = 1024;
+
+	// Update the quantities defined by the base class
+	PatchKernel::_updateGeometryCache(cellIds, interfaceIds);
+
+	// Update cell volumes
+	const PiercedVector<Cell, long> &cells = getCells();
+	PiercedStorage<double, long> &volumeCache = getCellGeometryCacheField(GEOMETRY_CACHE_CELL_VOLUME);
+
+	std::size_t nCells = cellIds.size();
+	std::size_t nCellChunks = (nCells + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	utils::threads::parallelFor(nCellChunks, [&](std::size_t chunk) {
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nCells);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			long cellId = cellIds[i];
+			volumeCache.rawAt(cells.getRawIndex(cellId)) = evalCellVolume(cellId);
+		}
+	});
+
+	// Update interface areas and normals
+	const PiercedVector<Interface, long> &interfaces = getInterfaces();
+	PiercedStorage<double, long> &areaCache = getInterfaceGeometryCacheField(GEOMETRY_CACHE_INTERFACE_AREA);
+	std::array<PiercedStorage<double, long> *, 3> normalCache;
+	for (int d = 0; d < 3; ++d) {
+		normalCache[d] = &(getInterfaceGeometryCacheField(GEOMETRY_CACHE_INTERFACE_NORMAL + d));
+	}
+
+	std::size_t nInterfaces = interfaceIds.size();
+	std::size_t nInterfaceChunks = (nInterfaces + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	utils::threads::parallelFor(nInterfaceChunks, [&](std::size_t chunk) {
+		std::size_t chunkBegin = chunk * CHUNK_SIZE;
+		std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nInterfaces);
+		for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+			long interfaceId = interfaceIds[i];
+			std::size_t rawIndex = interfaces.getRawIndex(interfaceId);
+
+			areaCache.rawAt(rawIndex) = evalInterfaceArea(interfaceId);
+
+			std::array<double, 3> normal = evalInterfaceNormal(interfaceId);
+			for (int d = 0; d < 3; ++d) {
+				normalCache[d]->rawAt(rawIndex) = normal[d];
+			}
+		}
+	});
+}
+
 }
@@ -54,7 +54,19 @@ public:
 	bool areFaceVerticesOrdered(const Cell &cell, int face) const;
 	int getFaceOrderedLocalVertex(const Cell &cell, int face, std::size_t n) const;
 
+	double getCachedCellVolume(long id) const;
+	double getCachedInterfaceArea(long id) const;
+	std::array<double, 3> getCachedInterfaceNormal(long id) const;
+
+	const PiercedStorage<double, long> & getCellVolumeCache() const;
+	const PiercedStorage<double, long> & getInterfaceAreaCache() const;
+	const PiercedStorage<double, long> & getInterfaceNormalCache(int component) const;
+
 protected:
+	const static std::size_t GEOMETRY_CACHE_CELL_VOLUME       = GEOMETRY_CACHE_CELL_CENTROID + 3;
+	const static std::size_t GEOMETRY_CACHE_INTERFACE_AREA    = 0;
+	const static std::size_t GEOMETRY_CACHE_INTERFACE_NORMAL  = GEOMETRY_CACHE_INTERFACE_AREA + 1;
+
 #if BITPIT_ENABLE_MPI==1
 	VolumeKernel(MPI_Comm communicator, std::size_t haloSize, AdaptionMode adaptionMode, PartitioningMode partitioningMode);
 	VolumeKernel(int dimension, MPI_Comm communicator, std::size_t haloSize, AdaptionMode adaptionMode, PartitioningMode partitioningMode);
@@ -65,6 +77,10 @@ protected:
 	VolumeKernel(int id, int dimension, AdaptionMode adaptionMode);
 #endif
 
+	std::size_t getCellGeometryCacheFieldCount() const override;
+	std::size_t getInterfaceGeometryCacheFieldCount() const override;
+	void _updateGeometryCache(const std::vector<long> &cellIds, const std::vector<long> &interfaceIds) override;
+
 };
 
 }
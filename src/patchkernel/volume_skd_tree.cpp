@@ -22,6 +22,8 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include "bitpit_common.hpp"
+
 #include "volume_skd_tree.hpp"
 
 namespace bitpit {
@@ -44,4 +46,114 @@ VolumeSkdTree::VolumeSkdTree(const VolumeKernel *patch, bool interiorCellsOnly)
 {
 }
 
+/*!
+* Locates the cell that contains the specified point.
+*
+* Only the nodes whose bounding box contains the point are visited, the
+* cells of those nodes are checked using the point-in-cell test of the
+* patch.
+*
+* \param[in] point is the point
+* \result Returns the id of the cell that contains the point. If the point
+* is not contained in any of the cells of the tree, the function returns
+* the id of the null element.
+*/
+long VolumeSkdTree::locatePoint(const std::array<double, 3> &point) const
+{
+    std::vector<std::size_t> nodeStack;
+
+    return locatePoint(point, &nodeStack);
+}
+
+/*!
+* Locates the cells that contain the specified points.
+*
+* Points are processed following their order along a space-filling curve,
+* this way points that are close together are located one after the other
+* and the nodes of the tree visited while locating a point are likely to be
+* reused for locating the following one. Points are located concurrently,
+* hence the point-in-cell test of the patch should be thread-safe.
+*
+* \param[in] nPoints is the number of points
+* \param[in] points are the points
+* \param[out] ids on output will contain the ids of the cells that contain
+* the points. If a point is not contained in any of the cells of the tree,
+* the related id will be set to the id of the null element
+*/
+void VolumeSkdTree::locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const
+{
+    static const std::size_t CHUNK_SIZE = 256;
+
+    // Sort the points along a space-filling curve
+    std::vector<std::size_t> order;
+    utils::sfc::computeMortonOrder(nPoints, points, &order);
+
+    // Locate the points
+    std::size_t nChunks = (order.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    utils::threads::parallelFor(nChunks, [&](std::size_t chunk) {
+        std::vector<std::size_t> nodeStack;
+
+        std::size_t chunkBegin = chunk * CHUNK_SIZE;
+        std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, order.size());
+        for (std::size_t k = chunkBegin; k < chunkEnd; ++k) {
+            std::size_t i = order[k];
+            ids[i] = locatePoint(points[i], &nodeStack);
+        }
+    });
+}
+
+/*!
+* Locates the cell that contains the specified point.
+*
+* \param[in] point is the point
+* \param[in,out] nodeStack is a storage that will be used for the stack
+* of the nodes to be visited
+* \result Returns the id of the cell that contains the point. If the point
+* is not contained in any of the cells of the tree, the function returns
+* the id of the null element.
+*/
+long VolumeSkdTree::locatePoint(const std::array<double, 3> &point, std::vector<std::size_t> *nodeStack) const
+{
+    // Early return if the tree is empty
+    if (m_nodes.empty()) {
+        return Cell::NULL_ID;
+    }
+
+    // Tolerance for the checks
+    const VolumeKernel &patch = static_cast<const VolumeKernel &>(getPatch());
+    double tolerance = patch.getTol();
+
+    // Visit the nodes whose bounding box contains the point
+    nodeStack->clear();
+    nodeStack->push_back(0);
+    while (!nodeStack->empty()) {
+        std::size_t nodeId = nodeStack->back();
+        nodeStack->pop_back();
+
+        const SkdNode &node = m_nodes[nodeId];
+        if (!node.boxContainsPoint(point, tolerance)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            std::size_t nNodeCells = node.getCellCount();
+            for (std::size_t n = 0; n < nNodeCells; ++n) {
+                long cellId = node.getCell(n);
+                if (patch.isPointInside(cellId, point)) {
+                    return cellId;
+                }
+            }
+        } else {
+            for (int i = SkdNode::CHILD_BEGIN; i != SkdNode::CHILD_END; ++i) {
+                std::size_t childId = node.getChildId(static_cast<SkdNode::ChildLocation>(i));
+                if (childId != SkdNode::NULL_ID) {
+                    nodeStack->push_back(childId);
+                }
+            }
+        }
+    }
+
+    return Cell::NULL_ID;
+}
+
 }
@@ -35,6 +35,12 @@ class VolumeSkdTree : public PatchSkdTree {
 public:
     VolumeSkdTree(const VolumeKernel *patch, bool interiorCellsOnly = false);
 
+    long locatePoint(const std::array<double, 3> &point) const;
+    void locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const;
+
+private:
+    long locatePoint(const std::array<double, 3> &point, std::vector<std::size_t> *nodeStack) const;
+
 };
 
 }
@@ -53,13 +53,15 @@ namespace bitpit {
 	cells halo
 */
 SurfUnstructured::SurfUnstructured(MPI_Comm communicator, std::size_t haloSize)
-	: SurfaceKernel(communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED)
+	: SurfaceKernel(communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED),
+	  m_pointLocatorRevision(0)
 #else
 /*!
 	Creates an uninitialized serial patch.
 */
 SurfUnstructured::SurfUnstructured()
-	: SurfaceKernel(ADAPTION_MANUAL)
+	: SurfaceKernel(ADAPTION_MANUAL),
+	  m_pointLocatorRevision(0)
 #endif
 {
 }
@@ -108,7 +110,8 @@ SurfUnstructured::SurfUnstructured(int dimension)
 	cells halo
 */
 SurfUnstructured::SurfUnstructured(int id, int dimension, MPI_Comm communicator, std::size_t haloSize)
-	: SurfaceKernel(id, dimension, communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED)
+	: SurfaceKernel(id, dimension, communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED),
+	  m_pointLocatorRevision(0)
 #else
 /*!
 	Creates a patch.
@@ -117,7 +120,8 @@ SurfUnstructured::SurfUnstructured(int id, int dimension, MPI_Comm communicator,
 	\param dimension is the dimension of the patch
 */
 SurfUnstructured::SurfUnstructured(int id, int dimension)
-	: SurfaceKernel(id, dimension, ADAPTION_MANUAL)
+	: SurfaceKernel(id, dimension, ADAPTION_MANUAL),
+	  m_pointLocatorRevision(0)
 #endif
 {
 }
@@ -136,7 +140,8 @@ SurfUnstructured::SurfUnstructured(int id, int dimension)
 	cells halo
 */
 SurfUnstructured::SurfUnstructured(std::istream &stream, MPI_Comm communicator, std::size_t haloSize)
-	: SurfaceKernel(communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED)
+	: SurfaceKernel(communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED),
+	  m_pointLocatorRevision(0)
 #else
 /*!
 	Creates a patch restoring the patch saved in the specified stream.
@@ -144,13 +149,61 @@ SurfUnstructured::SurfUnstructured(std::istream &stream, MPI_Comm communicator,
 	\param stream is the stream to read from
 */
 SurfUnstructured::SurfUnstructured(std::istream &stream)
-	: SurfaceKernel(ADAPTION_MANUAL)
+	: SurfaceKernel(ADAPTION_MANUAL),
+	  m_pointLocatorRevision(0)
 #endif
 {
 	// Restore the patch
 	restore(stream);
 }
 
+/*!
+	Copy constructor.
+
+	The data structures used for locating points are not copied, they will
+	be re-created when needed.
+
+	\param other is another patch whose content is copied into this
+*/
+SurfUnstructured::SurfUnstructured(const SurfUnstructured &other)
+	: SurfaceKernel(other),
+	  m_pointLocatorRevision(0)
+{
+}
+
+/*!
+	Move constructor.
+
+	The data structures used for locating points are not moved, they will
+	be re-created when needed.
+
+	\param other is another patch whose content is moved into this
+*/
+SurfUnstructured::SurfUnstructured(SurfUnstructured &&other)
+	: SurfaceKernel(std::move(other)),
+	  m_pointLocatorRevision(0)
+{
+	other._resetPointLocator();
+}
+
+/*!
+	Move assignment operator.
+
+	The data structures used for locating points are not moved, they will
+	be re-created when needed.
+
+	\param other is another patch whose content is moved into this
+*/
+SurfUnstructured & SurfUnstructured::operator=(SurfUnstructured &&other)
+{
+	SurfaceKernel::operator=(std::move(other));
+
+	_resetPointLocator();
+	other._resetPointLocator();
+
+	return *this;
+}
+
 /*!
 	Creates a clone of the pach.
 
@@ -210,10 +263,9 @@ void SurfUnstructured::_restore(std::istream &stream)
 /*!
  * Locates the cell the contains the point.
  *
- * If the point is not inside the patch, the function returns the id of the
- * null element.
- *
- * NOTE: this function is not implemented yet.
+ * A point is contained in a cell if its distance from the cell is less than
+ * the tolerance of the patch. If the point is not inside the patch, the
+ * function returns the id of the null element.
  *
  * \param[in] point is the point to be checked
  * \result Returns the linear id of the cell the contains the point. If the
@@ -222,11 +274,74 @@ void SurfUnstructured::_restore(std::istream &stream)
  */
 long SurfUnstructured::locatePoint(const std::array<double, 3> &point) const
 {
-	BITPIT_UNUSED(point);
+	return getPointLocator().locatePoint(point);
+}
+
+/*!
+ * Locates the cells that contain the specified points.
+ *
+ * Points are sorted along a space-filling curve and located concurrently.
+ *
+ * \param[in] nPoints is the number of points
+ * \param[in] points are the points to be checked
+ * \param[out] ids on output will contain the ids of the cells that contain
+ * the points. If a point is not inside the patch, the related id will be
+ * set to the id of the null element
+ */
+void SurfUnstructured::locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const
+{
+	getPointLocator().locatePoints(nPoints, points, ids);
+}
+
+/*!
+ * Gets the tree used for locating points.
+ *
+ * The tree is built the first time it is requested and it is kept until
+ * the patch is altered (cells are added or deleted, cell storage is sorted
+ * or squeezed, or the patch is transformed). Changes to the coordinates of
+ * the vertices performed directly on the vertices are not tracked.
+ *
+ * The tree only contains the cells of the current process and it is built
+ * without the information about the partitions, hence building the tree
+ * doesn't involve collective communications and each process can locate
+ * points independently.
+ *
+ * \result The tree used for locating points.
+ */
+const SurfaceSkdTree & SurfUnstructured::getPointLocator() const
+{
+	std::lock_guard<std::mutex> lock(m_pointLocatorMutex);
+	if (!m_pointLocator || m_pointLocatorRevision != getPointLocatorRevision()) {
+		std::unique_ptr<SurfaceSkdTree> pointLocator(new SurfaceSkdTree(this));
+		pointLocator->enableThreadSafeLookups(true);
+		pointLocator->build(1, false, false);
+		m_pointLocator = std::move(pointLocator);
+		m_pointLocatorRevision = getPointLocatorRevision();
+	}
+
+	return *m_pointLocator;
+}
 
-	throw std::runtime_error ("The function 'locatePoint' is not implemented yet");
+/*!
+ * Internal function to reset the data structures used for locating points.
+ */
+void SurfUnstructured::_resetPointLocator()
+{
+	std::lock_guard<std::mutex> lock(m_pointLocatorMutex);
+	m_pointLocator.reset();
+}
 
-	return Cell::NULL_ID;
+/*!
+ * Internal function to evaluate the memory used by the components defined
+ * by the patch.
+ *
+ * \param[in,out] breakdown on output will contain also the memory used by
+ * the point locator
+ */
+void SurfUnstructured::_getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const
+{
+	std::lock_guard<std::mutex> lock(m_pointLocatorMutex);
+	(*breakdown)["point locator"] = m_pointLocator ? m_pointLocator->getMemoryUsage() : 0;
 }
 
 //TODO: Aggiungere un metodo in SurfUnstructured per aggiungere più vertici.
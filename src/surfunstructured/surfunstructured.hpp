@@ -26,6 +26,8 @@
 #define __BITPIT_SURFUNSTRUCTURED_HPP__
 
 #include <array>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "bitpit_patchkernel.hpp"
@@ -50,6 +52,10 @@ public:
     SurfUnstructured(int id, int dimension);
     SurfUnstructured(std::istream &stream);
 #endif
+    SurfUnstructured(const SurfUnstructured &other);
+    SurfUnstructured(SurfUnstructured &&other);
+
+    SurfUnstructured & operator=(SurfUnstructured &&other);
 
     // Clone
     std::unique_ptr<PatchKernel> clone() const override;
@@ -59,6 +65,7 @@ public:
 
     // Search algorithms
     long locatePoint(const std::array<double, 3> &point) const override;
+    void locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const override;
 
     // Evaluations
     void extractEdgeNetwork(LineUnstructured &net);
@@ -83,6 +90,17 @@ protected:
     int exportSTLSingle(const std::string &name, bool isBinary);
     int exportSTLMulti(const std::string &name, std::unordered_map<int, std::string> *PIDNames = nullptr);
 
+    void _resetPointLocator() override;
+
+    void _getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const override;
+
+    const SurfaceSkdTree & getPointLocator() const;
+
+private:
+    mutable std::unique_ptr<SurfaceSkdTree> m_pointLocator;
+    mutable std::size_t m_pointLocatorRevision;
+    mutable std::mutex m_pointLocatorMutex;
+
 };
 
 }
@@ -2220,6 +2220,28 @@ void VolOctree::_resetTol()
 	VolumeKernel::_setTol(tolerance);
 }
 
+/*!
+ * Evaluate the memory used by the octree and by the maps between cells and
+ * octants.
+ *
+ * \param[in,out] breakdown on output will contain also the memory used by
+ * the octree and by the octant maps
+ */
+void VolOctree::_getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const
+{
+	(*breakdown)["octree"] = m_tree ? m_tree->getMemoryUsage() : 0;
+
+	std::size_t octantMapsMemory = 0;
+	octantMapsMemory += utils::getMemoryUsage(m_cellToOctant);
+	octantMapsMemory += utils::getMemoryUsage(m_cellToGhost);
+	octantMapsMemory += utils::getMemoryUsage(m_octantToCell);
+	octantMapsMemory += utils::getMemoryUsage(m_ghostToCell);
+	if (m_partitioningOctantWeights) {
+		octantMapsMemory += utils::getMemoryUsage(*m_partitioningOctantWeights);
+	}
+	(*breakdown)["octant maps"] = octantMapsMemory;
+}
+
 /*!
  *  Get the version associated to the binary dumps.
  *
@@ -148,6 +148,8 @@ protected:
 	void _dump(std::ostream &stream) const override;
 	void _restore(std::istream &stream) override;
 
+	void _getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const override;
+
 	long _getCellNativeIndex(long id) const override;
 
 	void _findCellNeighs(long id, const std::vector<long> *blackList, std::vector<long> *neighs) const override;
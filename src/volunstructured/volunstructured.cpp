@@ -22,6 +22,9 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include <map>
+
+#include "bitpit_CG.hpp"
 #include "bitpit_common.hpp"
 
 #include "volunstructured.hpp"
@@ -54,13 +57,15 @@ namespace bitpit {
 	cells halo
 */
 VolUnstructured::VolUnstructured(MPI_Comm communicator, std::size_t haloSize)
-	: VolumeKernel(communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED)
+	: VolumeKernel(communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED),
+	  m_pointLocatorRevision(0)
 #else
 /*!
 	Creates an uninitialized serial patch.
 */
 VolUnstructured::VolUnstructured()
-	: VolumeKernel(ADAPTION_MANUAL)
+	: VolumeKernel(ADAPTION_MANUAL),
+	  m_pointLocatorRevision(0)
 #endif
 {
 }
@@ -111,7 +116,8 @@ VolUnstructured::VolUnstructured(int dimension)
 	cells halo
 */
 VolUnstructured::VolUnstructured(int id, int dimension, MPI_Comm communicator, std::size_t haloSize)
-	: VolumeKernel(id, dimension, communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED)
+	: VolumeKernel(id, dimension, communicator, haloSize, ADAPTION_MANUAL, PARTITIONING_ENABLED),
+	  m_pointLocatorRevision(0)
 #else
 /*!
 	Creates a patch.
@@ -120,11 +126,59 @@ VolUnstructured::VolUnstructured(int id, int dimension, MPI_Comm communicator, s
 	\param dimension is the dimension of the patch
 */
 VolUnstructured::VolUnstructured(int id, int dimension)
-	: VolumeKernel(id, dimension, ADAPTION_MANUAL)
+	: VolumeKernel(id, dimension, ADAPTION_MANUAL),
+	  m_pointLocatorRevision(0)
 #endif
 {
 }
 
+/*!
+	Copy constructor.
+
+	The data structures used for locating points are not copied, they will
+	be re-created when needed.
+
+	\param other is another patch whose content is copied into this
+*/
+VolUnstructured::VolUnstructured(const VolUnstructured &other)
+	: VolumeKernel(other),
+	  m_pointLocatorRevision(0)
+{
+}
+
+/*!
+	Move constructor.
+
+	The data structures used for locating points are not moved, they will
+	be re-created when needed.
+
+	\param other is another patch whose content is moved into this
+*/
+VolUnstructured::VolUnstructured(VolUnstructured &&other)
+	: VolumeKernel(std::move(other)),
+	  m_pointLocatorRevision(0)
+{
+	other._resetPointLocator();
+}
+
+/*!
+	Move assignment operator.
+
+	The data structures used for locating points are not moved, they will
+	be re-created when needed.
+
+	\param other is another patch whose content is moved into this
+*/
+VolUnstructured & VolUnstructured::operator=(VolUnstructured &&other)
+{
+	VolumeKernel::operator=(std::move(other));
+
+	_resetPointLocator();
+	other._resetPointLocator();
+
+	return *this;
+}
+
 /*!
 	Creates a clone of the pach.
 
@@ -138,11 +192,18 @@ std::unique_ptr<PatchKernel> VolUnstructured::clone() const
 /*!
 	Evaluates the volume of the specified cell.
 
+	If the geometry cache is enabled and up-to-date, the cached volume is
+	returned.
+
 	\param id is the id of the cell
 	\result The volume of the specified cell.
 */
 double VolUnstructured::evalCellVolume(long id) const
 {
+	if (isGeometryCacheUpToDate()) {
+		return getCachedCellVolume(id);
+	}
+
 	const Cell &cell = getCell(id);
 
 	ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
@@ -178,11 +239,18 @@ double VolUnstructured::evalCellSize(long id) const
 /*!
 	Evaluates the area of the specified interface.
 
+	If the geometry cache is enabled and up-to-date, the cached area is
+	returned.
+
 	\param id is the id of the interface
 	\result The area of the specified interface.
 */
 double VolUnstructured::evalInterfaceArea(long id) const
 {
+	if (isGeometryCacheUpToDate()) {
+		return getCachedInterfaceArea(id);
+	}
+
 	const Interface &interface = getInterface(id);
 
 	ConstProxyVector<long> interfaceVertexIds = interface.getVertexIds();
@@ -200,11 +268,18 @@ double VolUnstructured::evalInterfaceArea(long id) const
 /*!
 	Evaluates the normal of the specified interface.
 
+	If the geometry cache is enabled and up-to-date, the cached normal is
+	returned.
+
 	\param id is the id of the interface
 	\result The normal of the specified interface.
 */
 std::array<double, 3> VolUnstructured::evalInterfaceNormal(long id) const
 {
+	if (isGeometryCacheUpToDate()) {
+		return getCachedInterfaceNormal(id);
+	}
+
 	const Interface &interface = getInterface(id);
 
 	ConstProxyVector<long> interfaceVertexIds = interface.getVertexIds();
@@ -230,6 +305,120 @@ std::array<double, 3> VolUnstructured::evalInterfaceNormal(long id) const
 	return interface.evalNormal(vertexCoordinates, orientation);
 }
 
+/*!
+	Internal function to update the geometry cache.
+
+	Cells are processed in batches of cells of the same type. For each batch
+	the reference element is looked up only once and, for each cell, the
+	coordinates of the vertices are gathered only once to evaluate both the
+	centroid and the volume. Polygons and polyhedra, and cells whose
+	dimension doesn't match the dimension of the patch, are evaluated one
+	by one through the generic evaluation functions.
+
+	Entries are evaluated concurrently.
+
+	\param cellIds are the ids of the cells whose entries will be updated
+	\param interfaceIds are the ids of the interfaces whose entries will be
+	updated
+*/
+void VolUnstructured::_updateGeometryCache(const std::vector<long> &cellIds, const std::vector<long> &interfaceIds)
+{
+	static const std::size_t CHUNK_SIZE = 1024;
+
+	// Update interface quantities
+	VolumeKernel::_updateGeometryCache(std::vector<long>(), interfaceIds);
+
+	// Group cells by type
+	const PiercedVector<Cell, long> &cells = getCells();
+
+	std::map<ElementType, std::vector<long>> batches;
+	for (long cellId : cellIds) {
+		batches[cells.at(cellId).getType()].push_back(cellId);
+	}
+
+	// Update cell quantities
+	std::array<PiercedStorage<double, long> *, 3> centroidCache;
+	for (int d = 0; d < 3; ++d) {
+		centroidCache[d] = &(getCellGeometryCacheField(GEOMETRY_CACHE_CELL_CENTROID + d));
+	}
+
+	PiercedStorage<double, long> &volumeCache = getCellGeometryCacheField(GEOMETRY_CACHE_CELL_VOLUME);
+
+	int patchDimension = getDimension();
+	for (const auto &batchEntry : batches) {
+		ElementType batchType = batchEntry.first;
+		const std::vector<long> &batchCellIds = batchEntry.second;
+
+		std::size_t nBatchCells = batchCellIds.size();
+		std::size_t nBatchChunks = (nBatchCells + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+		// Generic evaluation
+		bool isReferenceType = ReferenceElementInfo::hasInfo(batchType);
+		if (!isReferenceType || ReferenceElementInfo::getInfo(batchType).dimension != patchDimension) {
+			utils::threads::parallelFor(nBatchChunks, [&](std::size_t chunk) {
+				std::size_t chunkBegin = chunk * CHUNK_SIZE;
+				std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nBatchCells);
+				for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+					long cellId = batchCellIds[i];
+					std::size_t rawIndex = cells.getRawIndex(cellId);
+
+					std::array<double, 3> centroid = evalCellCentroid(cellId);
+					for (int d = 0; d < 3; ++d) {
+						centroidCache[d]->rawAt(rawIndex) = centroid[d];
+					}
+
+					volumeCache.rawAt(rawIndex) = evalCellVolume(cellId);
+				}
+			});
+
+			continue;
+		}
+
+		// Evaluation for reference elements
+		const ReferenceElementInfo &referenceInfo = ReferenceElementInfo::getInfo(batchType);
+		const int nCellVertices = referenceInfo.nVertices;
+
+		const Reference3DElementInfo *referenceInfo3D = nullptr;
+		const Reference2DElementInfo *referenceInfo2D = nullptr;
+		if (patchDimension == 3) {
+			referenceInfo3D = static_cast<const Reference3DElementInfo *>(&referenceInfo);
+		} else {
+			referenceInfo2D = static_cast<const Reference2DElementInfo *>(&referenceInfo);
+		}
+
+		utils::threads::parallelFor(nBatchChunks, [&](std::size_t chunk) {
+			std::array<std::array<double, 3>, ReferenceElementInfo::MAX_ELEM_VERTICES> vertexCoordinates;
+
+			std::size_t chunkBegin = chunk * CHUNK_SIZE;
+			std::size_t chunkEnd   = std::min(chunkBegin + CHUNK_SIZE, nBatchCells);
+			for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+				long cellId = batchCellIds[i];
+				std::size_t rawIndex = cells.getRawIndex(cellId);
+				const Cell &cell = cells.rawAt(rawIndex);
+
+				getVertexCoords(nCellVertices, cell.getConnect(), vertexCoordinates.data());
+
+				std::array<double, 3> centroid = vertexCoordinates[0];
+				for (int n = 1; n < nCellVertices; ++n) {
+					for (int d = 0; d < 3; ++d) {
+						centroid[d] += vertexCoordinates[n][d];
+					}
+				}
+
+				for (int d = 0; d < 3; ++d) {
+					centroidCache[d]->rawAt(rawIndex) = centroid[d] / nCellVertices;
+				}
+
+				if (referenceInfo3D) {
+					volumeCache.rawAt(rawIndex) = referenceInfo3D->evalVolume(vertexCoordinates.data());
+				} else {
+					volumeCache.rawAt(rawIndex) = referenceInfo2D->evalArea(vertexCoordinates.data());
+				}
+			}
+		});
+	}
+}
+
 /*!
  *  Get the version associated to the binary dumps.
  *
@@ -284,11 +473,7 @@ void VolUnstructured::_restore(std::istream &stream)
  */
 bool VolUnstructured::isPointInside(const std::array<double, 3> &point) const
 {
-	BITPIT_UNUSED(point);
-
-	throw std::runtime_error ("The function 'isPointInside' is not implemented yet");
-
-	return false;
+	return (locatePoint(point) != Cell::NULL_ID);
 }
 
 /*!
@@ -300,14 +485,111 @@ bool VolUnstructured::isPointInside(const std::array<double, 3> &point) const
  */
 bool VolUnstructured::isPointInside(long id, const std::array<double, 3> &point) const
 {
-	BITPIT_UNUSED(id);
-	BITPIT_UNUSED(point);
+	double tolerance = getTol();
+
+	// Check if the point is inside the bounding box of the cell
+	std::array<double, 3> boxMin;
+	std::array<double, 3> boxMax;
+	evalCellBoundingBox(id, &boxMin, &boxMax);
+	if (!CGElem::intersectPointBox(point, boxMin, boxMax, 3, tolerance)) {
+		return false;
+	}
+
+	// Check if the point is inside one of the simplices the cell can be
+	// decomposed into
+	//
+	// Each simplex is defined by the centroid of the cell and by a simplex
+	// of the decomposition of one of its faces. Faces are decomposed in a
+	// fan of triangles that share the first vertex of the face, hence their
+	// vertices have to be visited in cyclic order. Vertices of pixels are
+	// not stored in cyclic order, therefore their third and fourth vertices
+	// have to be swapped.
+	static const std::array<std::size_t, 4> PIXEL_CYCLIC_ORDER = {{0, 1, 3, 2}};
 
-	throw std::runtime_error ("The function 'isPointInside' is not implemented yet");
+	const Cell &cell = getCell(id);
+	std::array<double, 3> centroid = evalCellCentroid(id);
+	int dimension = getDimension();
+
+	int nCellFaces = cell.getFaceCount();
+	for (int face = 0; face < nCellFaces; ++face) {
+		ConstProxyVector<long> faceVertexIds = cell.getFaceVertexIds(face);
+		std::size_t nFaceVertices = faceVertexIds.size();
+		bool isPixelFace = (cell.getFaceType(face) == ElementType::PIXEL);
+
+		const std::array<double, 3> &anchorCoords = getVertexCoords(faceVertexIds[0]);
+		if (dimension == 2) {
+			const std::array<double, 3> &otherCoords = getVertexCoords(faceVertexIds[nFaceVertices - 1]);
+			if (CGElem::intersectPointTriangle(point, centroid, anchorCoords, otherCoords, tolerance)) {
+				return true;
+			}
+		} else {
+			std::array<std::array<double, 3>, 4> tetrahedronCoords;
+			tetrahedronCoords[0] = centroid;
+			tetrahedronCoords[1] = anchorCoords;
+			for (std::size_t k = 1; k < nFaceVertices - 1; ++k) {
+				std::size_t i = isPixelFace ? PIXEL_CYCLIC_ORDER[k] : k;
+				std::size_t j = isPixelFace ? PIXEL_CYCLIC_ORDER[k + 1] : k + 1;
+
+				tetrahedronCoords[2] = getVertexCoords(faceVertexIds[i]);
+				tetrahedronCoords[3] = getVertexCoords(faceVertexIds[j]);
+				if (isPointInsideTetrahedron(point, tetrahedronCoords)) {
+					return true;
+				}
+			}
+		}
+	}
 
 	return false;
 }
 
+/*!
+	Checks if the specified point is inside a tetrahedron.
+
+	The point is considered inside the tetrahedron if it is not farther
+	than the tolerance of the patch from the tetrahedron. Degenerate
+	tetrahedra don't contain any point.
+
+	\param[in] point is the point to be checked
+	\param[in] vertexCoords are the coordinates of the vertices of the
+	tetrahedron
+	\result Returns true if the point is inside the tetrahedron, false
+	otherwise.
+ */
+bool VolUnstructured::isPointInsideTetrahedron(const std::array<double, 3> &point, const std::array<std::array<double, 3>, 4> &vertexCoords) const
+{
+	double tolerance = getTol();
+
+	for (int k = 0; k < 4; ++k) {
+		const std::array<double, 3> &opposite = vertexCoords[k];
+		const std::array<double, 3> &A = vertexCoords[(k + 1) % 4];
+		const std::array<double, 3> &B = vertexCoords[(k + 2) % 4];
+		const std::array<double, 3> &C = vertexCoords[(k + 3) % 4];
+
+		// Normal of the face opposite to the vertex, pointing towards the
+		// inside of the tetrahedron
+		std::array<double, 3> normal = crossProduct(B - A, C - A);
+		double normalMagnitude = norm2(normal);
+		if (normalMagnitude <= 0.) {
+			return false;
+		}
+		normal /= normalMagnitude;
+
+		double oppositeDistance = dotProduct(normal, opposite - A);
+		if (oppositeDistance < 0.) {
+			normal = -1. * normal;
+		} else if (oppositeDistance == 0.) {
+			return false;
+		}
+
+		// Signed distance of the point from the face
+		if (dotProduct(normal, point - A) < - tolerance) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /*!
  * Locates the cell the contains the point.
  *
@@ -321,11 +603,73 @@ bool VolUnstructured::isPointInside(long id, const std::array<double, 3> &point)
  */
 long VolUnstructured::locatePoint(const std::array<double, 3> &point) const
 {
-	BITPIT_UNUSED(point);
+	return getPointLocator().locatePoint(point);
+}
+
+/*!
+ * Locates the cells that contain the specified points.
+ *
+ * Points are sorted along a space-filling curve and located concurrently.
+ *
+ * \param[in] nPoints is the number of points
+ * \param[in] points are the points to be checked
+ * \param[out] ids on output will contain the ids of the cells that contain
+ * the points. If a point is not inside the patch, the related id will be
+ * set to the id of the null element
+ */
+void VolUnstructured::locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const
+{
+	getPointLocator().locatePoints(nPoints, points, ids);
+}
 
-	throw std::runtime_error ("The function 'locatePoint' is not implemented yet");
+/*!
+ * Gets the tree used for locating points.
+ *
+ * The tree is built the first time it is requested and it is kept until
+ * the patch is altered (cells are added or deleted, cell storage is sorted
+ * or squeezed, or the patch is transformed). Changes to the coordinates of
+ * the vertices performed directly on the vertices are not tracked.
+ *
+ * The tree only contains the cells of the current process and it is built
+ * without the information about the partitions, hence building the tree
+ * doesn't involve collective communications and each process can locate
+ * points independently.
+ *
+ * \result The tree used for locating points.
+ */
+const VolumeSkdTree & VolUnstructured::getPointLocator() const
+{
+	std::lock_guard<std::mutex> lock(m_pointLocatorMutex);
+	if (!m_pointLocator || m_pointLocatorRevision != getPointLocatorRevision()) {
+		std::unique_ptr<VolumeSkdTree> pointLocator(new VolumeSkdTree(this));
+		pointLocator->build(1, false, false);
+		m_pointLocator = std::move(pointLocator);
+		m_pointLocatorRevision = getPointLocatorRevision();
+	}
 
-	return Cell::NULL_ID;
+	return *m_pointLocator;
+}
+
+/*!
+ * Internal function to reset the data structures used for locating points.
+ */
+void VolUnstructured::_resetPointLocator()
+{
+	std::lock_guard<std::mutex> lock(m_pointLocatorMutex);
+	m_pointLocator.reset();
+}
+
+/*!
+ * Internal function to evaluate the memory used by the components defined
+ * by the patch.
+ *
+ * \param[in,out] breakdown on output will contain also the memory used by
+ * the point locator
+ */
+void VolUnstructured::_getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const
+{
+	std::lock_guard<std::mutex> lock(m_pointLocatorMutex);
+	(*breakdown)["point locator"] = m_pointLocator ? m_pointLocator->getMemoryUsage() : 0;
 }
 
 #if BITPIT_ENABLE_MPI==1
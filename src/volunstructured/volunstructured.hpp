@@ -28,6 +28,9 @@
 #include <array>
 #include <vector>
 
+#include <memory>
+#include <mutex>
+
 #include "bitpit_patchkernel.hpp"
 
 namespace bitpit {
@@ -47,6 +50,10 @@ public:
 	VolUnstructured(int dimension);
 	VolUnstructured(int id, int dimension);
 #endif
+	VolUnstructured(const VolUnstructured &other);
+	VolUnstructured(VolUnstructured &&other);
+
+	VolUnstructured & operator=(VolUnstructured &&other);
 
 	std::unique_ptr<PatchKernel> clone() const override;
 
@@ -61,8 +68,17 @@ public:
 	bool isPointInside(const std::array<double, 3> &point) const override;
 	bool isPointInside(long id, const std::array<double, 3> &point) const override;
 	long locatePoint(const std::array<double, 3> &point) const override;
+	void locatePoints(int nPoints, const std::array<double, 3> *points, long *ids) const override;
 
 protected:
+	void _resetPointLocator() override;
+
+	void _updateGeometryCache(const std::vector<long> &cellIds, const std::vector<long> &interfaceIds) override;
+
+	void _getMemoryUsageBreakdown(std::map<std::string, std::size_t> *breakdown) const override;
+
+	const VolumeSkdTree & getPointLocator() const;
+
 	int _getDumpVersion() const override;
 	void _dump(std::ostream &stream) const override;
 	void _restore(std::istream &stream) override;
@@ -72,6 +88,11 @@ protected:
 #endif
 
 private:
+	mutable std::unique_ptr<VolumeSkdTree> m_pointLocator;
+	mutable std::size_t m_pointLocatorRevision;
+	mutable std::mutex m_pointLocatorMutex;
+
+	bool isPointInsideTetrahedron(const std::array<double, 3> &point, const std::array<std::array<double, 3>, 4> &vertexCoords) const;
 
 };
 
@@ -0,0 +1,238 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "helpers/benchmark.hpp"
+
+#include "bitpit_PABLO.hpp"
+
+using namespace bitpit;
+
+/*!
+* Refine the tree globally up to the specified level.
+*
+* \param level is the level that will be reached
+* \param tree is the tree
+*/
+void refineGlobally(int level, ParaTree *tree)
+{
+    for (int i = 0; i < level; ++i) {
+        tree->adaptGlobalRefine();
+    }
+}
+
+/*!
+* Mark for refinement the octants whose center lies within a sphere.
+*
+* \param tree is the tree
+*/
+void markSphere(ParaTree *tree)
+{
+    const std::array<double, 3> SPHERE_CENTER = {{0.5, 0.5, 0.5}};
+    const double SPHERE_RADIUS = 0.25;
+
+    uint32_t nOctants = tree->getNumOctants();
+    for (uint32_t n = 0; n < nOctants; ++n) {
+        std::array<double, 3> center = tree->getCenter(n);
+
+        double distance = 0.;
+        for (int d = 0; d < 3; ++d) {
+            distance += (center[d] - SPHERE_CENTER[d]) * (center[d] - SPHERE_CENTER[d]);
+        }
+
+        if (distance <= SPHERE_RADIUS * SPHERE_RADIUS) {
+            tree->setMarker(n, 1);
+        }
+    }
+}
+
+/*!
+* Run ParaTree benchmarks.
+*
+* \param suite is the benchmark suite
+*/
+void runParaTreeBenchmarks(BenchmarkSuite &suite)
+{
+    // The finest uniform level has at least the requested number of octants
+    const uint64_t N_OCTANTS = suite.scale(262144);
+
+    int level = 1;
+    while ((uint64_t(1) << (3 * level)) < N_OCTANTS) {
+        ++level;
+    }
+
+    const uint64_t nFinestOctants = (uint64_t(1) << (3 * level));
+
+    suite.run("paratree_adapt_global_refine", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level - 1, &tree);
+
+        timer.start();
+        tree.adaptGlobalRefine();
+        timer.stop();
+    });
+
+    suite.run("paratree_adapt_markers", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level, &tree);
+        markSphere(&tree);
+
+        timer.start();
+        tree.adapt();
+        timer.stop();
+    });
+
+    suite.run("paratree_adapt_balance21", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level - 1, &tree);
+        markSphere(&tree);
+        tree.adapt();
+
+        // Refining the sphere again requires 2:1 balancing of the octants
+        // around its surface
+        markSphere(&tree);
+
+        timer.start();
+        tree.adapt();
+        timer.stop();
+    });
+
+    suite.run("paratree_adapt_global_coarse", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level, &tree);
+
+        timer.start();
+        tree.adaptGlobalCoarse();
+        timer.stop();
+    });
+
+    suite.run("paratree_compute_connectivity", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level, &tree);
+
+        timer.start();
+        tree.computeConnectivity();
+        timer.stop();
+    });
+
+    suite.run("paratree_find_face_neighbours", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level - 1, &tree);
+        markSphere(&tree);
+        tree.adapt();
+
+        std::vector<uint32_t> neighbours;
+        std::vector<bool> isGhost;
+
+        timer.start();
+        uint32_t nOctants = tree.getNumOctants();
+        for (uint32_t n = 0; n < nOctants; ++n) {
+            for (uint8_t face = 0; face < 6; ++face) {
+                tree.findNeighbours(n, face, 1, neighbours, isGhost);
+            }
+        }
+        timer.stop();
+    });
+
+    suite.run("paratree_compute_face_neighbour_table", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level - 1, &tree);
+        markSphere(&tree);
+        tree.adapt();
+
+        ParaTree::NeighbourTable table;
+
+        timer.start();
+        tree.computeNeighbourTable(1, &table);
+        timer.stop();
+    });
+
+#if BITPIT_ENABLE_MPI==1
+    suite.run("paratree_load_balance_uniform", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level, &tree);
+
+        timer.start();
+        tree.loadBalance();
+        timer.stop();
+    });
+
+    suite.run("paratree_load_balance_adapted", nFinestOctants, [level](BenchmarkTimer &timer) {
+        ParaTree tree(3);
+        refineGlobally(level, &tree);
+        tree.loadBalance();
+        markSphere(&tree);
+        tree.adapt();
+
+        timer.start();
+        tree.loadBalance();
+        timer.stop();
+    });
+#endif
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+
+    int nProcs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    int nProcs = 1;
+    int rank   = 0;
+#endif
+
+    // Initialize the loggers
+    //
+    // Only warnings are written to the console, this avoids mixing log
+    // messages with the results written on the standard output.
+    log::manager().initialize(log::MODE_COMBINE, true, nProcs, rank);
+    log::manager().create(ParaTree::DEFAULT_LOG_FILE, false, nProcs, rank);
+    log::manager().setConsoleVerbosity(log::LEVEL_WARNING);
+
+    // Run the benchmarks
+    int status = 0;
+    try {
+        BenchmarkSuite suite("PABLO", argc, argv);
+
+        runParaTreeBenchmarks(suite);
+
+        suite.write();
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        status = 1;
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+
+    return status;
+}
@@ -0,0 +1,189 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <random>
+#include <vector>
+
+#include "helpers/benchmark.hpp"
+
+#include "bitpit_PABLO.hpp"
+
+using namespace bitpit;
+
+/*!
+* Get the name of a Morton kernel.
+*
+* \param kernel is the kernel
+* \result The name of the kernel.
+*/
+std::string getKernelName(PABLO::MortonKernel kernel)
+{
+    switch (kernel) {
+
+    case PABLO::MORTON_KERNEL_MAGIC_BITS:
+        return "magic_bits";
+
+    case PABLO::MORTON_KERNEL_AVX2:
+        return "avx2";
+
+    case PABLO::MORTON_KERNEL_BMI2:
+        return "bmi2";
+
+    default:
+        return "unknown";
+
+    }
+}
+
+/*!
+* Run Morton encoding and decoding benchmarks.
+*
+* Each kernel supported by the processor is benchmarked, together with the
+* scalar functions used when processing one octant at a time.
+*
+* \param suite is the benchmark suite
+*/
+void runMortonBenchmarks(BenchmarkSuite &suite)
+{
+    const std::size_t N_VALUES = suite.scale(4194304);
+
+    // Generate random coordinates
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<uint32_t> distribution(0, (uint32_t(1) << 21) - 1);
+
+    std::vector<uint32_t> x(N_VALUES);
+    std::vector<uint32_t> y(N_VALUES);
+    std::vector<uint32_t> z(N_VALUES);
+    for (std::size_t i = 0; i < N_VALUES; ++i) {
+        x[i] = distribution(generator);
+        y[i] = distribution(generator);
+        z[i] = distribution(generator);
+    }
+
+    std::vector<uint64_t> mortons(N_VALUES);
+    PABLO::computeMortons3D(PABLO::MORTON_KERNEL_MAGIC_BITS, N_VALUES, x.data(), y.data(), z.data(), mortons.data());
+
+    std::vector<uint64_t> encoded(N_VALUES);
+    std::vector<uint32_t> decodedX(N_VALUES);
+    std::vector<uint32_t> decodedY(N_VALUES);
+    std::vector<uint32_t> decodedZ(N_VALUES);
+
+    // Scalar functions
+    suite.run("morton_encode_3d_scalar", N_VALUES, [&](BenchmarkTimer &timer) {
+        timer.start();
+        for (std::size_t i = 0; i < N_VALUES; ++i) {
+            encoded[i] = PABLO::computeMorton(3, x[i], y[i], z[i]);
+        }
+        timer.stop();
+    });
+
+    suite.run("morton_decode_3d_scalar", N_VALUES, [&](BenchmarkTimer &timer) {
+        timer.start();
+        for (std::size_t i = 0; i < N_VALUES; ++i) {
+            decodedX[i] = PABLO::computeCoordinate(3, mortons[i], 0);
+            decodedY[i] = PABLO::computeCoordinate(3, mortons[i], 1);
+            decodedZ[i] = PABLO::computeCoordinate(3, mortons[i], 2);
+        }
+        timer.stop();
+    });
+
+    // Batched kernels
+    std::vector<PABLO::MortonKernel> kernels = {PABLO::MORTON_KERNEL_MAGIC_BITS, PABLO::MORTON_KERNEL_AVX2, PABLO::MORTON_KERNEL_BMI2};
+    for (PABLO::MortonKernel kernel : kernels) {
+        if (!PABLO::isMortonKernelSupported(kernel)) {
+            continue;
+        }
+
+        std::string kernelName = getKernelName(kernel);
+
+        suite.run("morton_encode_3d_" + kernelName, N_VALUES, [&](BenchmarkTimer &timer) {
+            timer.start();
+            PABLO::computeMortons3D(kernel, N_VALUES, x.data(), y.data(), z.data(), encoded.data());
+            timer.stop();
+        });
+
+        suite.run("morton_decode_3d_" + kernelName, N_VALUES, [&](BenchmarkTimer &timer) {
+            timer.start();
+            PABLO::computeCoordinates3D(kernel, N_VALUES, mortons.data(), decodedX.data(), decodedY.data(), decodedZ.data());
+            timer.stop();
+        });
+
+        suite.run("morton_encode_2d_" + kernelName, N_VALUES, [&](BenchmarkTimer &timer) {
+            timer.start();
+            PABLO::computeMortons2D(kernel, N_VALUES, x.data(), y.data(), encoded.data());
+            timer.stop();
+        });
+
+        suite.run("morton_decode_2d_" + kernelName, N_VALUES, [&](BenchmarkTimer &timer) {
+            timer.start();
+            PABLO::computeCoordinates2D(kernel, N_VALUES, mortons.data(), decodedX.data(), decodedY.data());
+            timer.stop();
+        });
+    }
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+
+    int nProcs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    int nProcs = 1;
+    int rank   = 0;
+#endif
+
+    // Initialize the loggers
+    //
+    // Only warnings are written to the console, this avoids mixing log
+    // messages with the results written on the standard output.
+    log::manager().initialize(log::MODE_COMBINE, true, nProcs, rank);
+    log::manager().setConsoleVerbosity(log::LEVEL_WARNING);
+
+    // Run the benchmarks
+    int status = 0;
+    try {
+        BenchmarkSuite suite("PABLO_morton", argc, argv);
+
+        runMortonBenchmarks(suite);
+
+        suite.write();
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        status = 1;
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+
+    return status;
+}
@@ -0,0 +1,274 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "helpers/benchmark.hpp"
+
+#include "bitpit_containers.hpp"
+
+#include <numeric>
+#include <random>
+
+using namespace bitpit;
+
+/*!
+* Variable used to prevent the compiler from optimizing away the results
+* of the benchmarks.
+*/
+volatile double sink;
+
+/*!
+* Generate the ids of the elements in random order.
+*
+* \param nElements is the number of elements
+* \result The ids of the elements.
+*/
+std::vector<long> generateShuffledIds(std::size_t nElements)
+{
+    std::vector<long> ids(nElements);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    std::mt19937 generator(1);
+    std::shuffle(ids.begin(), ids.end(), generator);
+
+    return ids;
+}
+
+/*!
+* Fill a container with the specified number of elements.
+*
+* \param nElements is the number of elements
+* \param container is the container that will be filled
+*/
+void fillContainer(std::size_t nElements, PiercedVector<double> &container)
+{
+    for (std::size_t k = 0; k < nElements; ++k) {
+        container.insert(static_cast<long>(k), static_cast<double>(k));
+    }
+}
+
+/*!
+* Run PiercedVector benchmarks.
+*
+* \param suite is the benchmark suite
+*/
+void runPiercedVectorBenchmarks(BenchmarkSuite &suite)
+{
+    const std::size_t N_ELEMENTS = suite.scale(1000000);
+
+    std::vector<long> shuffledIds = generateShuffledIds(N_ELEMENTS);
+
+    suite.run("pierced_vector_insert", N_ELEMENTS, [N_ELEMENTS](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+
+        timer.start();
+        fillContainer(N_ELEMENTS, container);
+        timer.stop();
+    });
+
+    suite.run("pierced_vector_erase", N_ELEMENTS / 2, [N_ELEMENTS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        fillContainer(N_ELEMENTS, container);
+
+        timer.start();
+        for (std::size_t k = 0; k < N_ELEMENTS / 2; ++k) {
+            container.erase(shuffledIds[k]);
+        }
+        timer.stop();
+    });
+
+    suite.run("pierced_vector_at", N_ELEMENTS, [N_ELEMENTS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        fillContainer(N_ELEMENTS, container);
+
+        timer.start();
+        double sum = 0.;
+        for (long id : shuffledIds) {
+            sum += container.at(id);
+        }
+        timer.stop();
+
+        sink = sum;
+    });
+
+    suite.run("pierced_vector_iterate", N_ELEMENTS / 2, [N_ELEMENTS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        fillContainer(N_ELEMENTS, container);
+        for (std::size_t k = 0; k < N_ELEMENTS / 2; ++k) {
+            container.erase(shuffledIds[k]);
+        }
+
+        timer.start();
+        double sum = 0.;
+        for (double value : container) {
+            sum += value;
+        }
+        timer.stop();
+
+        sink = sum;
+    });
+}
+
+/*!
+* Run PiercedStorage benchmarks.
+*
+* \param suite is the benchmark suite
+*/
+void runPiercedStorageBenchmarks(BenchmarkSuite &suite)
+{
+    const std::size_t N_ELEMENTS = suite.scale(1000000);
+    const std::size_t N_FIELDS   = 3;
+
+    std::vector<long> shuffledIds = generateShuffledIds(N_ELEMENTS);
+
+    suite.run("pierced_storage_sync_concurrent", N_ELEMENTS + N_ELEMENTS / 2, [N_ELEMENTS, N_FIELDS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        PiercedStorage<double> storage(N_FIELDS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+        PiercedStorage<int> flags(1, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+
+        timer.start();
+        fillContainer(N_ELEMENTS, container);
+        for (std::size_t k = 0; k < N_ELEMENTS / 2; ++k) {
+            container.erase(shuffledIds[k]);
+        }
+        timer.stop();
+    });
+
+    suite.run("pierced_storage_sync_journaled", N_ELEMENTS + N_ELEMENTS / 2, [N_ELEMENTS, N_FIELDS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        PiercedStorage<double> storage(N_FIELDS, &container, PiercedSyncMaster::SYNC_MODE_JOURNALED);
+        PiercedStorage<int> flags(1, &container, PiercedSyncMaster::SYNC_MODE_JOURNALED);
+
+        timer.start();
+        fillContainer(N_ELEMENTS, container);
+        for (std::size_t k = 0; k < N_ELEMENTS / 2; ++k) {
+            container.erase(shuffledIds[k]);
+        }
+        container.sync();
+        timer.stop();
+    });
+
+    suite.run("pierced_storage_squeeze", N_ELEMENTS / 2, [N_ELEMENTS, N_FIELDS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        PiercedStorage<double> storage(N_FIELDS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+        PiercedStorage<int> flags(1, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+
+        fillContainer(N_ELEMENTS, container);
+        for (std::size_t k = 0; k < N_ELEMENTS / 2; ++k) {
+            container.erase(shuffledIds[k]);
+        }
+
+        timer.start();
+        container.squeeze();
+        timer.stop();
+    });
+
+    suite.run("pierced_storage_sort", N_ELEMENTS, [N_ELEMENTS, N_FIELDS, &shuffledIds](BenchmarkTimer &timer) {
+        PiercedVector<double> container;
+        PiercedStorage<double> storage(N_FIELDS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+        PiercedStorage<int> flags(1, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+
+        for (long id : shuffledIds) {
+            container.insert(id, static_cast<double>(id));
+        }
+
+        timer.start();
+        container.sort();
+        timer.stop();
+    });
+}
+
+/*!
+* Run FlatVector2D benchmarks.
+*
+* \param suite is the benchmark suite
+*/
+void runFlatVector2DBenchmarks(BenchmarkSuite &suite)
+{
+    const std::size_t N_VECTORS = suite.scale(1000000);
+
+    auto countItems = [](std::size_t i) -> std::size_t {
+        return (4 + i % 4);
+    };
+
+    std::size_t nItems = 0;
+    for (std::size_t i = 0; i < N_VECTORS; ++i) {
+        nItems += countItems(i);
+    }
+
+    suite.run("flat_vector_2d_push_back", nItems, [N_VECTORS, &countItems](BenchmarkTimer &timer) {
+        FlatVector2D<long> vector;
+
+        timer.start();
+        for (std::size_t i = 0; i < N_VECTORS; ++i) {
+            vector.pushBack();
+            for (std::size_t j = 0; j < countItems(i); ++j) {
+                vector.pushBackItem(static_cast<long>(i + j));
+            }
+        }
+        timer.stop();
+    });
+
+    suite.run("flat_vector_2d_build", nItems, [N_VECTORS, &countItems](BenchmarkTimer &timer) {
+        FlatVector2D<long> vector(false);
+
+        timer.start();
+        vector.build(N_VECTORS, countItems, [&countItems](std::size_t i, long *items) {
+            for (std::size_t j = 0; j < countItems(i); ++j) {
+                items[j] = static_cast<long>(i + j);
+            }
+        });
+        timer.stop();
+    });
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#endif
+
+    // Run the benchmarks
+    int status = 0;
+    try {
+        BenchmarkSuite suite("containers", argc, argv);
+
+        runPiercedVectorBenchmarks(suite);
+        runPiercedStorageBenchmarks(suite);
+        runFlatVector2DBenchmarks(suite);
+
+        suite.write();
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        status = 1;
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+
+    return status;
+}
@@ -0,0 +1,312 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_TEST_HELPERS_BENCHMARK__
+#define __BITPIT_TEST_HELPERS_BENCHMARK__
+
+/*!
+ * \file benchmark.hpp
+ *
+ * \brief Infrastruture needed for running benchmarks.
+ *
+ * A benchmark program creates a BenchmarkSuite, runs its benchmarks through
+ * the suite and then writes the results. Every benchmark is repeated several
+ * times and, for each repetition, only the sections enclosed between calls
+ * to BenchmarkTimer::start() and BenchmarkTimer::stop() are timed.
+ *
+ * The results are written in JSON format, either to the standard output or
+ * to the file specified on the command line. The following command line
+ * arguments are recognized:
+ *
+ *  --output <file>          file where the results will be written
+ *  --repetitions <count>    number of repetitions of each benchmark
+ *  --scale <factor>         factor the size of the problems is multiplied by
+ */
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bitpit_common.hpp"
+
+/*!
+ * \brief Timer used for measuring the sections of a benchmark.
+ *
+ * The timer accumulates the time elapsed between each call to start() and
+ * the subsequent call to stop().
+ */
+class BenchmarkTimer {
+
+public:
+    /*!
+     * Starts timing a section.
+     */
+    void start()
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    /*!
+     * Stops timing a section.
+     */
+    void stop()
+    {
+        m_elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    /*!
+     * Gets the time elapsed in the timed sections.
+     *
+     * \result The time, expressed in seconds, elapsed in the timed sections.
+     */
+    double getElapsed() const
+    {
+        return m_elapsed;
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    double m_elapsed = 0.;
+
+};
+
+/*!
+ * \brief Collection of benchmarks whose results are written together.
+ */
+class BenchmarkSuite {
+
+public:
+    /*!
+     * Function that runs a benchmark, it receives the timer that should be
+     * used for timing the sections of the benchmark.
+     */
+    typedef std::function<void(BenchmarkTimer &timer)> BenchmarkFunction;
+
+    /*!
+     * Constructor.
+     *
+     * \param name is the name of the suite
+     * \param argc is the argument count of the command line arguments
+     * \param argv is the argument vector of the command line arguments
+     */
+    BenchmarkSuite(const std::string &name, int argc, char *argv[])
+        : m_name(name), m_nRepetitions(5), m_scale(1.)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for the argument " + argument);
+            }
+
+            if (argument == "--output") {
+                m_outputPath = argv[++i];
+            } else if (argument == "--repetitions") {
+                m_nRepetitions = std::max(std::stoi(argv[++i]), 1);
+            } else if (argument == "--scale") {
+                m_scale = std::stod(argv[++i]);
+            } else {
+                throw std::runtime_error("Unknown argument " + argument);
+            }
+        }
+    }
+
+    /*!
+     * Scales the size of a problem by the factor specified on the command
+     * line.
+     *
+     * \param size is the size of the problem
+     * \result The scaled size of the problem.
+     */
+    std::size_t scale(std::size_t size) const
+    {
+        return std::max(static_cast<std::size_t>(m_scale * static_cast<double>(size)), std::size_t(1));
+    }
+
+    /*!
+     * Runs a benchmark.
+     *
+     * The benchmark is repeated the requested number of times. When running
+     * on multiple processes, the time of a repetition is the maximum time
+     * among the processes.
+     *
+     * \param name is the name of the benchmark
+     * \param nItems is the number of items processed by a repetition of
+     * the benchmark, it is used for evaluating the throughput
+     * \param function is the function that runs the benchmark
+     */
+    void run(const std::string &name, std::size_t nItems, const BenchmarkFunction &function)
+    {
+        std::vector<double> times(m_nRepetitions);
+        for (int n = 0; n < m_nRepetitions; ++n) {
+            BenchmarkTimer timer;
+            function(timer);
+
+            times[n] = timer.getElapsed();
+#if BITPIT_ENABLE_MPI==1
+            MPI_Allreduce(MPI_IN_PLACE, &(times[n]), 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+        }
+
+        Result result;
+        result.name    = name;
+        result.nItems  = nItems;
+        result.minTime = *std::min_element(times.begin(), times.end());
+        result.maxTime = *std::max_element(times.begin(), times.end());
+        result.avgTime = 0.;
+        for (double time : times) {
+            result.avgTime += time;
+        }
+        result.avgTime /= m_nRepetitions;
+
+        m_results.push_back(result);
+
+        if (isWriter()) {
+            std::cerr << "  " << name << ": " << result.minTime << " s" << std::endl;
+        }
+    }
+
+    /*!
+     * Writes the results of the benchmarks.
+     */
+    void write() const
+    {
+        if (!isWriter()) {
+            return;
+        }
+
+        if (m_outputPath.empty()) {
+            write(std::cout);
+        } else {
+            std::ofstream stream(m_outputPath);
+            if (!stream.good()) {
+                throw std::runtime_error("Unable to open the file " + m_outputPath);
+            }
+            write(stream);
+        }
+    }
+
+private:
+    /*!
+     * Results of a benchmark.
+     */
+    struct Result {
+        std::string name;
+        std::size_t nItems;
+        double minTime;
+        double avgTime;
+        double maxTime;
+    };
+
+    std::string m_name;
+    std::string m_outputPath;
+    int m_nRepetitions;
+    double m_scale;
+    std::vector<Result> m_results;
+
+    /*!
+     * Checks if the current process should write the results.
+     *
+     * \result Returns true if the current process should write the results,
+     * false otherwise.
+     */
+    static bool isWriter()
+    {
+#if BITPIT_ENABLE_MPI==1
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+        return (rank == 0);
+#else
+        return true;
+#endif
+    }
+
+    /*!
+     * Gets the number of processes the benchmarks run on.
+     *
+     * \result The number of processes the benchmarks run on.
+     */
+    static int getProcessCount()
+    {
+#if BITPIT_ENABLE_MPI==1
+        int nProcesses;
+        MPI_Comm_size(MPI_COMM_WORLD, &nProcesses);
+
+        return nProcesses;
+#else
+        return 1;
+#endif
+    }
+
+    /*!
+     * Writes the results of the benchmarks to the specified stream.
+     *
+     * \param stream is the stream the results will be written to
+     */
+    void write(std::ostream &stream) const
+    {
+        std::time_t now = std::time(nullptr);
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        stream.precision(9);
+        stream << "{" << std::endl;
+        stream << "  \"suite\": \"" << m_name << "\"," << std::endl;
+        stream << "  \"timestamp\": \"" << timestamp << "\"," << std::endl;
+        stream << "  \"processes\": " << getProcessCount() << "," << std::endl;
+        stream << "  \"threads\": " << bitpit::utils::threads::getThreadCount() << "," << std::endl;
+        stream << "  \"repetitions\": " << m_nRepetitions << "," << std::endl;
+        stream << "  \"scale\": " << m_scale << "," << std::endl;
+        stream << "  \"benchmarks\": [" << std::endl;
+        for (std::size_t k = 0; k < m_results.size(); ++k) {
+            const Result &result = m_results[k];
+            double throughput = (result.minTime > 0.) ? static_cast<double>(result.nItems) / result.minTime : 0.;
+
+            stream << "    {";
+            stream << "\"name\": \"" << result.name << "\", ";
+            stream << "\"items\": " << result.nItems << ", ";
+            stream << "\"min_time\": " << result.minTime << ", ";
+            stream << "\"avg_time\": " << result.avgTime << ", ";
+            stream << "\"max_time\": " << result.maxTime << ", ";
+            stream << "\"items_per_second\": " << throughput;
+            stream << "}" << ((k + 1 < m_results.size()) ? "," : "") << std::endl;
+        }
+        stream << "  ]" << std::endl;
+        stream << "}" << std::endl;
+    }
+
+};
+
+#endif
@@ -0,0 +1,175 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "helpers/benchmark.hpp"
+
+#include "bitpit_levelset.hpp"
+#include "bitpit_surfunstructured.hpp"
+#include "bitpit_volcartesian.hpp"
+
+#include <cmath>
+#include <memory>
+
+using namespace bitpit;
+
+/*!
+* Generate a segmentation that describes a circle.
+*
+* \param nSegments is the number of segments of the segmentation
+* \result The generated segmentation.
+*/
+std::unique_ptr<SurfUnstructured> generateSegmentation(long nSegments)
+{
+    const double RADIUS = 1.;
+    const double dtheta = 2. * BITPIT_PI / ((double) nSegments);
+
+#if BITPIT_ENABLE_MPI==1
+    std::unique_ptr<SurfUnstructured> segmentation(new SurfUnstructured(0, 1, MPI_COMM_NULL));
+#else
+    std::unique_ptr<SurfUnstructured> segmentation(new SurfUnstructured(0, 1));
+#endif
+
+    for (long i = 0; i < nSegments; ++i) {
+        double theta = i * dtheta;
+        segmentation->addVertex({{RADIUS * std::cos(theta), RADIUS * std::sin(theta), 0.}}, i);
+    }
+
+    for (long i = 0; i < nSegments; ++i) {
+        segmentation->addCell(ElementType::LINE, std::vector<long>({{i, (i + 1) % nSegments}}), i);
+    }
+
+    segmentation->initializeAdjacencies();
+
+    return segmentation;
+}
+
+/*!
+* Generate a Cartesian mesh around the segmentation.
+*
+* \param nCellsPerDirection is the number of cells along each direction
+* \param segmentation is the segmentation
+* \result The generated mesh.
+*/
+std::unique_ptr<VolCartesian> generateMesh(int nCellsPerDirection, const SurfUnstructured &segmentation)
+{
+    std::array<double, 3> meshMin, meshMax;
+    segmentation.getBoundingBox(meshMin, meshMax);
+
+    std::array<double, 3> delta = meshMax - meshMin;
+    meshMin -= 0.1 * delta;
+    meshMax += 0.1 * delta;
+    delta = meshMax - meshMin;
+
+    std::array<int, 3> nCells = {{nCellsPerDirection, nCellsPerDirection, 0}};
+
+    std::unique_ptr<VolCartesian> mesh(new VolCartesian(2, meshMin, delta, nCells));
+    mesh->initializeAdjacencies();
+    mesh->update();
+
+    return mesh;
+}
+
+/*!
+* Run levelset cache benchmarks.
+*
+* \param suite is the benchmark suite
+*/
+void runCacheBenchmarks(BenchmarkSuite &suite)
+{
+    const int nCellsPerDirection = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(suite.scale(65536)))));
+    const long nSegments = 4 * nCellsPerDirection;
+
+    std::unique_ptr<SurfUnstructured> segmentation = generateSegmentation(nSegments);
+    std::unique_ptr<VolCartesian> mesh = generateMesh(nCellsPerDirection, *segmentation);
+    const std::size_t nCells = mesh->getCellCount();
+
+    const int OBJECT_ID = 0;
+
+    LevelSet levelset;
+    levelset.setMesh(mesh.get());
+    levelset.addObject(segmentation.get(), BITPIT_PI, OBJECT_ID);
+
+    LevelSetObject &object = levelset.getObject(OBJECT_ID);
+
+    const std::vector<std::pair<std::string, LevelSetCacheMode>> cacheModes = {
+        {"full", LevelSetCacheMode::FULL},
+        {"narrow_band", LevelSetCacheMode::NARROW_BAND}
+    };
+
+    const std::vector<std::pair<std::string, LevelSetField>> fields = {
+        {"value", LevelSetField::VALUE},
+        {"gradient", LevelSetField::GRADIENT}
+    };
+
+    for (const auto &cacheMode : cacheModes) {
+        for (const auto &field : fields) {
+            std::string name = "levelset_cache_fill_" + cacheMode.first + "_" + field.first;
+            suite.run(name, nCells, [&object, &cacheMode, &field](BenchmarkTimer &timer) {
+                object.disableFieldCellCache(field.second);
+
+                timer.start();
+                object.enableFieldCellCache(field.second, cacheMode.second);
+                timer.stop();
+            });
+
+            object.disableFieldCellCache(field.second);
+        }
+    }
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#endif
+
+    // Initialize the logger
+    //
+    // Only warnings are written to the console, this avoids mixing log
+    // messages with the results written on the standard output.
+    log::manager().initialize(log::MODE_COMBINE);
+    log::cout().setConsoleVerbosity(log::LEVEL_WARNING);
+
+    // Run the benchmarks
+    int status = 0;
+    try {
+        BenchmarkSuite suite("levelset", argc, argv);
+
+        runCacheBenchmarks(suite);
+
+        suite.write();
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        status = 1;
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+
+    return status;
+}
@@ -0,0 +1,240 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "helpers/benchmark.hpp"
+
+#include "bitpit_volunstructured.hpp"
+
+#include <memory>
+
+using namespace bitpit;
+
+/*!
+* Create an empty three-dimensional unstructured patch.
+*
+* \result The newly created patch.
+*/
+std::unique_ptr<VolUnstructured> createPatch()
+{
+#if BITPIT_ENABLE_MPI==1
+    std::unique_ptr<VolUnstructured> patch(new VolUnstructured(0, 3, MPI_COMM_NULL));
+#else
+    std::unique_ptr<VolUnstructured> patch(new VolUnstructured(0, 3));
+#endif
+    patch->setVertexAutoIndexing(false);
+
+    return patch;
+}
+
+/*!
+* Add to the patch the vertices of a structured grid of hexahedra.
+*
+* \param nCellsPerDirection is the number of cells along each direction
+* \param patch is the patch
+*/
+void addGridVertices(long nCellsPerDirection, VolUnstructured *patch)
+{
+    const long nVerticesPerDirection = nCellsPerDirection + 1;
+    const double spacing = 1. / nCellsPerDirection;
+
+    patch->reserveVertices(nVerticesPerDirection * nVerticesPerDirection * nVerticesPerDirection);
+    for (long k = 0; k < nVerticesPerDirection; ++k) {
+        for (long j = 0; j < nVerticesPerDirection; ++j) {
+            for (long i = 0; i < nVerticesPerDirection; ++i) {
+                long id = i + nVerticesPerDirection * (j + nVerticesPerDirection * k);
+                patch->addVertex({{i * spacing, j * spacing, k * spacing}}, id);
+            }
+        }
+    }
+}
+
+/*!
+* Evaluate the connectivity of the cells of a structured grid of hexahedra.
+*
+* \param nCellsPerDirection is the number of cells along each direction
+* \result The connectivity of the cells.
+*/
+std::vector<std::vector<long>> evalGridConnectivities(long nCellsPerDirection)
+{
+    const long nVerticesPerDirection = nCellsPerDirection + 1;
+
+    auto getVertexId = [nVerticesPerDirection](long i, long j, long k) -> long {
+        return i + nVerticesPerDirection * (j + nVerticesPerDirection * k);
+    };
+
+    std::vector<std::vector<long>> connectivities;
+    connectivities.reserve(nCellsPerDirection * nCellsPerDirection * nCellsPerDirection);
+    for (long k = 0; k < nCellsPerDirection; ++k) {
+        for (long j = 0; j < nCellsPerDirection; ++j) {
+            for (long i = 0; i < nCellsPerDirection; ++i) {
+                connectivities.push_back({
+                    getVertexId(i,     j,     k    ), getVertexId(i + 1, j,     k    ),
+                    getVertexId(i + 1, j + 1, k    ), getVertexId(i,     j + 1, k    ),
+                    getVertexId(i,     j,     k + 1), getVertexId(i + 1, j,     k + 1),
+                    getVertexId(i + 1, j + 1, k + 1), getVertexId(i,     j + 1, k + 1)
+                });
+            }
+        }
+    }
+
+    return connectivities;
+}
+
+/*!
+* Add to the patch the cells of a structured grid of hexahedra.
+*
+* \param connectivities are the connectivities of the cells
+* \param patch is the patch
+*/
+void addGridCells(const std::vector<std::vector<long>> &connectivities, VolUnstructured *patch)
+{
+    patch->reserveCells(connectivities.size());
+    for (std::size_t n = 0; n < connectivities.size(); ++n) {
+        patch->addCell(ElementType::HEXAHEDRON, connectivities[n], static_cast<long>(n));
+    }
+}
+
+/*!
+* Run patch benchmarks.
+*
+* \param suite is the benchmark suite
+*/
+void runPatchBenchmarks(BenchmarkSuite &suite)
+{
+    long nCellsPerDirection = 1;
+    while (nCellsPerDirection * nCellsPerDirection * nCellsPerDirection < static_cast<long>(suite.scale(125000))) {
+        ++nCellsPerDirection;
+    }
+
+    const std::vector<std::vector<long>> connectivities = evalGridConnectivities(nCellsPerDirection);
+    const std::size_t nCells = connectivities.size();
+
+    // Cells that will be deleted and re-inserted by the update benchmarks
+    const std::size_t UPDATE_STRIDE = 10;
+    const std::size_t nUpdatedCells = (nCells + UPDATE_STRIDE - 1) / UPDATE_STRIDE;
+
+    auto renewCells = [&connectivities, UPDATE_STRIDE](VolUnstructured *patch) {
+        for (std::size_t n = 0; n < connectivities.size(); n += UPDATE_STRIDE) {
+            patch->deleteCell(static_cast<long>(n));
+        }
+
+        for (std::size_t n = 0; n < connectivities.size(); n += UPDATE_STRIDE) {
+            patch->addCell(ElementType::HEXAHEDRON, connectivities[n], static_cast<long>(n));
+        }
+    };
+
+    suite.run("patch_add_cell", nCells, [nCellsPerDirection, &connectivities](BenchmarkTimer &timer) {
+        std::unique_ptr<VolUnstructured> patch = createPatch();
+        addGridVertices(nCellsPerDirection, patch.get());
+
+        timer.start();
+        addGridCells(connectivities, patch.get());
+        timer.stop();
+    });
+
+    suite.run("patch_initialize_adjacencies", nCells, [nCellsPerDirection, &connectivities](BenchmarkTimer &timer) {
+        std::unique_ptr<VolUnstructured> patch = createPatch();
+        addGridVertices(nCellsPerDirection, patch.get());
+        addGridCells(connectivities, patch.get());
+
+        timer.start();
+        patch->initializeAdjacencies();
+        timer.stop();
+    });
+
+    suite.run("patch_update_adjacencies", nUpdatedCells, [nCellsPerDirection, &connectivities, &renewCells](BenchmarkTimer &timer) {
+        std::unique_ptr<VolUnstructured> patch = createPatch();
+        addGridVertices(nCellsPerDirection, patch.get());
+        addGridCells(connectivities, patch.get());
+        patch->initializeAdjacencies();
+
+        renewCells(patch.get());
+
+        timer.start();
+        patch->updateAdjacencies();
+        timer.stop();
+    });
+
+    suite.run("patch_initialize_interfaces", nCells, [nCellsPerDirection, &connectivities](BenchmarkTimer &timer) {
+        std::unique_ptr<VolUnstructured> patch = createPatch();
+        addGridVertices(nCellsPerDirection, patch.get());
+        addGridCells(connectivities, patch.get());
+        patch->initializeAdjacencies();
+
+        timer.start();
+        patch->initializeInterfaces();
+        timer.stop();
+    });
+
+    suite.run("patch_update_interfaces", nUpdatedCells, [nCellsPerDirection, &connectivities, &renewCells](BenchmarkTimer &timer) {
+        std::unique_ptr<VolUnstructured> patch = createPatch();
+        addGridVertices(nCellsPerDirection, patch.get());
+        addGridCells(connectivities, patch.get());
+        patch->initializeAdjacencies();
+        patch->initializeInterfaces();
+
+        renewCells(patch.get());
+        patch->updateAdjacencies();
+
+        timer.start();
+        patch->updateInterfaces();
+        timer.stop();
+    });
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#endif
+
+    // Initialize the logger
+    //
+    // Only warnings are written to the console, this avoids mixing log
+    // messages with the results written on the standard output.
+    log::manager().initialize(log::MODE_COMBINE);
+    log::cout().setConsoleVerbosity(log::LEVEL_WARNING);
+
+    // Run the benchmarks
+    int status = 0;
+    try {
+        BenchmarkSuite suite("volunstructured", argc, argv);
+
+        runPatchBenchmarks(suite);
+
+        suite.write();
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        status = 1;
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+
+    return status;
+}
@@ -0,0 +1,216 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_PABLO.hpp"
+
+using namespace bitpit;
+
+/*!
+* Subtest 001
+*
+* Testing that all the Morton kernels supported by the processor give the
+* same results of the "magic bits" algorithm.
+*/
+int subtest_001()
+{
+    const std::size_t N_VALUES = 1027;
+
+    std::array<PABLO::MortonKernel, 3> kernels = {{PABLO::MORTON_KERNEL_MAGIC_BITS, PABLO::MORTON_KERNEL_AVX2, PABLO::MORTON_KERNEL_BMI2}};
+
+    log::cout() << " Default kernel: " << PABLO::getDefaultMortonKernel() << std::endl;
+
+    // Generate random coordinates
+    //
+    // Coordinates are limited to the bits that can be stored in the Morton
+    // number, the first and the last values are the extremes of the range.
+    std::mt19937 generator(1);
+
+    std::array<std::vector<uint32_t>, 3> coords3D;
+    std::array<std::vector<uint32_t>, 2> coords2D;
+    for (int d = 0; d < 3; ++d) {
+        std::uniform_int_distribution<uint32_t> distribution(0, (uint32_t(1) << 21) - 1);
+
+        coords3D[d].resize(N_VALUES);
+        for (std::size_t i = 0; i < N_VALUES; ++i) {
+            coords3D[d][i] = distribution(generator);
+        }
+        coords3D[d].front() = 0;
+        coords3D[d].back()  = (uint32_t(1) << 21) - 1;
+    }
+
+    for (int d = 0; d < 2; ++d) {
+        std::uniform_int_distribution<uint32_t> distribution(0, std::numeric_limits<uint32_t>::max());
+
+        coords2D[d].resize(N_VALUES);
+        for (std::size_t i = 0; i < N_VALUES; ++i) {
+            coords2D[d][i] = distribution(generator);
+        }
+        coords2D[d].front() = 0;
+        coords2D[d].back()  = std::numeric_limits<uint32_t>::max();
+    }
+
+    // Compute reference values
+    std::vector<uint64_t> expectedMortons3D(N_VALUES);
+    std::vector<uint64_t> expectedMortons2D(N_VALUES);
+    for (std::size_t i = 0; i < N_VALUES; ++i) {
+        expectedMortons3D[i] = PABLO::computeMorton3DMagicBits(coords3D[0][i], coords3D[1][i], coords3D[2][i]);
+        expectedMortons2D[i] = PABLO::computeMorton2DMagicBits(coords2D[0][i], coords2D[1][i]);
+
+        for (int d = 0; d < 3; ++d) {
+            if (PABLO::computeCoordinate3DMagicBits(expectedMortons3D[i], d) != coords3D[d][i]) {
+                log::cout() << " Reference 3D decoding failed for value " << i << std::endl;
+                return 1;
+            }
+        }
+
+        for (int d = 0; d < 2; ++d) {
+            if (PABLO::computeCoordinate2DMagicBits(expectedMortons2D[i], d) != coords2D[d][i]) {
+                log::cout() << " Reference 2D decoding failed for value " << i << std::endl;
+                return 1;
+            }
+        }
+
+        if (PABLO::computeMorton3D(coords3D[0][i], coords3D[1][i], coords3D[2][i]) != expectedMortons3D[i]) {
+            log::cout() << " Scalar 3D encoding failed for value " << i << std::endl;
+            return 1;
+        }
+
+        if (PABLO::computeMorton2D(coords2D[0][i], coords2D[1][i]) != expectedMortons2D[i]) {
+            log::cout() << " Scalar 2D encoding failed for value " << i << std::endl;
+            return 1;
+        }
+    }
+
+    // Check the kernels
+    //
+    // Arrays are processed starting from different offsets, this exercises
+    // the handling of the values that don't fill a full vector register.
+    for (PABLO::MortonKernel kernel : kernels) {
+        if (!PABLO::isMortonKernelSupported(kernel)) {
+            log::cout() << " Kernel " << kernel << " is not supported by the processor" << std::endl;
+            continue;
+        }
+
+        log::cout() << " Checking kernel " << kernel << std::endl;
+
+        for (std::size_t offset = 0; offset < 4; ++offset) {
+            std::size_t n = N_VALUES - offset;
+
+            std::vector<uint64_t> mortons(n);
+            std::array<std::vector<uint32_t>, 3> decoded;
+            for (int d = 0; d < 3; ++d) {
+                decoded[d].resize(n);
+            }
+
+            PABLO::computeMortons3D(kernel, n, coords3D[0].data() + offset, coords3D[1].data() + offset, coords3D[2].data() + offset, mortons.data());
+            PABLO::computeCoordinates3D(kernel, n, mortons.data(), decoded[0].data(), decoded[1].data(), decoded[2].data());
+            for (std::size_t i = 0; i < n; ++i) {
+                if (mortons[i] != expectedMortons3D[offset + i]) {
+                    log::cout() << " 3D encoding failed for value " << (offset + i) << std::endl;
+                    return 1;
+                }
+
+                for (int d = 0; d < 3; ++d) {
+                    if (decoded[d][i] != coords3D[d][offset + i]) {
+                        log::cout() << " 3D decoding failed for value " << (offset + i) << std::endl;
+                        return 1;
+                    }
+                }
+            }
+
+            PABLO::computeMortons2D(kernel, n, coords2D[0].data() + offset, coords2D[1].data() + offset, mortons.data());
+            PABLO::computeCoordinates2D(kernel, n, mortons.data(), decoded[0].data(), decoded[1].data());
+            for (std::size_t i = 0; i < n; ++i) {
+                if (mortons[i] != expectedMortons2D[offset + i]) {
+                    log::cout() << " 2D encoding failed for value " << (offset + i) << std::endl;
+                    return 1;
+                }
+
+                for (int d = 0; d < 2; ++d) {
+                    if (decoded[d][i] != coords2D[d][offset + i]) {
+                        log::cout() << " 2D decoding failed for value " << (offset + i) << std::endl;
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    int nProcs;
+    int rank;
+#if BITPIT_ENABLE_MPI==1
+    MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    nProcs = 1;
+    rank   = 0;
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_SEPARATE, false, nProcs, rank);
+    log::cout() << log::fileVerbosity(log::LEVEL_INFO);
+    log::cout() << log::disableConsole();
+
+    // Run the subtests
+    log::cout() << "Testing Morton encoding and decoding kernels" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
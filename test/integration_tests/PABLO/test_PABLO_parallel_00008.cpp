@@ -0,0 +1,267 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_common.hpp"
+#include "bitpit_PABLO.hpp"
+
+#include <mpi.h>
+
+#include <vector>
+
+using namespace bitpit;
+
+/*!
+* Evaluate the weights of the local octants.
+*
+* Weights are small integers, this way their sums are not affected by
+* round-off errors.
+*
+* \param tree is the tree
+* \result The weights of the local octants.
+*/
+std::vector<double> evalWeights(const ParaTree &tree)
+{
+    uint32_t nOctants = tree.getNumOctants();
+
+    std::vector<double> weights(nOctants);
+    for (uint32_t n = 0; n < nOctants; ++n) {
+        weights[n] = (tree.getCenter(n)[0] < 0.5) ? 1. : 3.;
+    }
+
+    return weights;
+}
+
+/*!
+* Evaluate the expected partition of the tree.
+*
+* The weights of all the octants are gathered and the boundary between the
+* i-th and the (i+1)-th process is placed right after the first octant whose
+* cumulative weight reaches (i+1)/nProcs of the global weight.
+*
+* \param tree is the tree
+* \param weights are the weights of the local octants
+* \result The expected global index of the last octant of each process.
+*/
+std::vector<uint64_t> evalExpectedPartition(const ParaTree &tree, const std::vector<double> &weights)
+{
+    int nProcs = tree.getNproc();
+
+    std::vector<double> globalWeights;
+    if (tree.getSerial()) {
+        globalWeights = weights;
+    } else {
+        int nOctants = tree.getNumOctants();
+        std::vector<int> counts(nProcs);
+        MPI_Allgather(&nOctants, 1, MPI_INT, counts.data(), 1, MPI_INT, tree.getComm());
+
+        std::vector<int> displacements(nProcs, 0);
+        for (int i = 1; i < nProcs; ++i) {
+            displacements[i] = displacements[i - 1] + counts[i - 1];
+        }
+
+        globalWeights.resize(tree.getGlobalNumOctants());
+        MPI_Allgatherv(weights.data(), nOctants, MPI_DOUBLE, globalWeights.data(), counts.data(), displacements.data(), MPI_DOUBLE, tree.getComm());
+    }
+
+    double globalWeight = 0.;
+    for (double weight : globalWeights) {
+        globalWeight += weight;
+    }
+
+    std::vector<uint64_t> partition(nProcs, globalWeights.size() - 1);
+    double cumulativeWeight = 0.;
+    int boundary = 0;
+    for (std::size_t n = 0; n < globalWeights.size(); ++n) {
+        cumulativeWeight += globalWeights[n];
+        while (boundary < nProcs - 1 && cumulativeWeight >= globalWeight * (boundary + 1) / nProcs) {
+            partition[boundary] = n;
+            ++boundary;
+        }
+    }
+
+    return partition;
+}
+
+/*!
+* Check if the partition of the tree matches the expected one.
+*
+* \param tree is the tree
+* \param expectedPartition is the expected partition
+* \result Returns true if the partition matches the expected one, false
+* otherwise.
+*/
+bool checkPartition(const ParaTree &tree, const std::vector<uint64_t> &expectedPartition)
+{
+    const std::vector<uint64_t> &partition = tree.getPartitionRangeGlobalIdx();
+    for (int i = 0; i < tree.getNproc(); ++i) {
+        log::cout() << "  Last octant of process " << i << " ... " << partition[i] << " (expected " << expectedPartition[i] << ")" << std::endl;
+        if (partition[i] != expectedPartition[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+* Subtest 001
+*
+* Testing weighted load balance of a two-dimensional tree.
+*/
+int subtest_001()
+{
+    // Create the tree
+    ParaTree tree(2);
+
+    for (int k = 0; k < 5; ++k) {
+        tree.adaptGlobalRefine();
+    }
+
+    // Weighted partitioning of a serial tree
+    log::cout() << "Weighted partitioning of a serial tree" << std::endl;
+
+    std::vector<double> weights = evalWeights(tree);
+    std::vector<uint64_t> expectedPartition = evalExpectedPartition(tree, weights);
+
+    tree.loadBalance(&weights);
+    if (!checkPartition(tree, expectedPartition)) {
+        log::cout() << "Wrong partition of the serial tree" << std::endl;
+        return 1;
+    }
+
+    // Refine part of the tree
+    for (uint32_t n = 0; n < tree.getNumOctants(); ++n) {
+        if (tree.getCenter(n)[1] < 0.3) {
+            tree.setMarker(n, 1);
+        }
+    }
+    tree.adapt();
+
+    // Weighted partitioning of a distributed tree
+    log::cout() << "Weighted partitioning of a distributed tree" << std::endl;
+
+    weights = evalWeights(tree);
+    expectedPartition = evalExpectedPartition(tree, weights);
+
+    tree.loadBalance(&weights);
+    if (!checkPartition(tree, expectedPartition)) {
+        log::cout() << "Wrong partition of the distributed tree" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Testing weighted load balance of a two-dimensional tree keeping the families
+* compact.
+*/
+int subtest_002()
+{
+    // Create the tree
+    ParaTree tree(2);
+
+    for (int k = 0; k < 5; ++k) {
+        tree.adaptGlobalRefine();
+    }
+
+    tree.loadBalance();
+
+    for (uint32_t n = 0; n < tree.getNumOctants(); ++n) {
+        if (tree.getCenter(n)[1] < 0.3) {
+            tree.setMarker(n, 1);
+        }
+    }
+    tree.adapt();
+
+    // Weighted partitioning keeping the families compact
+    log::cout() << "Weighted partitioning keeping the families compact" << std::endl;
+
+    uint64_t nGlobalOctants = tree.getGlobalNumOctants();
+
+    std::vector<double> weights = evalWeights(tree);
+    uint8_t levels = 2;
+    tree.loadBalance(levels, &weights);
+
+    if (tree.getGlobalNumOctants() != nGlobalOctants) {
+        log::cout() << "Wrong number of octants after the partitioning" << std::endl;
+        return 1;
+    }
+
+    // The first octant of each process should be the first octant of a family
+    int familyLevel = std::max(tree.getMaxDepth() - levels, 1);
+    uint32_t familySize = uint32_t(1) << (tree.getMaxLevel() - familyLevel);
+    if (tree.getRank() > 0 && tree.getNumOctants() > 0) {
+        const Octant *octant = tree.getOctant(0);
+        for (int d = 0; d < 2; ++d) {
+            if (octant->getLogicalCoordinates(d) % familySize != 0) {
+                log::cout() << "The family of the first octant is not compact" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+    MPI_Init(&argc,&argv);
+
+    int nProcs;
+    int rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Initialize the logger
+    bitpit::log::manager().initialize(bitpit::log::MODE_SEPARATE, false, nProcs, rank);
+    bitpit::log::cout() << log::fileVerbosity(bitpit::log::LEVEL_INFO);
+    bitpit::log::cout() << log::disableConsole();
+
+    // Run the subtests
+    log::cout() << "Testing weighted load balance" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+    MPI_Finalize();
+}
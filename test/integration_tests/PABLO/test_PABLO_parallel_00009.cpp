@@ -0,0 +1,261 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_common.hpp"
+#include "bitpit_PABLO.hpp"
+
+#include <mpi.h>
+
+#include <vector>
+
+using namespace bitpit;
+
+/*!
+* Driver for handling user data during load balance.
+*/
+class UserDataLB : public bitpit::DataLBInterface<UserDataLB> {
+
+public:
+    std::vector<double> &data;
+    std::vector<double> &ghostdata;
+
+    size_t size(const uint32_t e) const
+    {
+        BITPIT_UNUSED(e);
+
+        return fixedSize();
+    }
+
+    size_t fixedSize() const
+    {
+        return sizeof(double);
+    }
+
+    void move(const uint32_t from, const uint32_t to)
+    {
+        data[to] = data[from];
+    }
+
+    template<class Buffer>
+    void gather(Buffer & buff, const uint32_t e)
+    {
+        buff << data[e];
+    }
+
+    template<class Buffer>
+    void scatter(Buffer & buff, const uint32_t e)
+    {
+        buff >> data[e];
+    }
+
+    void assign(uint32_t stride, uint32_t length)
+    {
+        for(uint32_t i=0; i<length; i++)
+        data[i] = data[i+stride];
+    }
+    void resize(uint32_t newSize)
+    {
+        data.resize(newSize);
+    }
+    void resizeGhost(uint32_t newSize)
+    {
+        ghostdata.resize(newSize);
+    }
+    void shrink() {}
+
+    UserDataLB(std::vector<double>& data_, std::vector<double>& ghostdata_)
+        : data(data_), ghostdata(ghostdata_)
+    {}
+
+    ~UserDataLB(){}
+};
+
+/*!
+* Evaluate the global number of octants that will be sent to other processes.
+*
+* \param tree is the tree
+* \param ranges are the load balance ranges
+* \result The global number of octants that will be sent to other processes.
+*/
+uint64_t evalSentOctants(const ParaTree &tree, const ParaTree::LoadBalanceRanges &ranges)
+{
+    uint64_t nSentOctants = 0;
+    for (const auto &entry : ranges.sendRanges) {
+        if (entry.first == tree.getRank()) {
+            continue;
+        }
+
+        nSentOctants += entry.second[1] - entry.second[0];
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &nSentOctants, 1, MPI_UINT64_T, MPI_SUM, tree.getComm());
+
+    return nSentOctants;
+}
+
+/*!
+* Subtest 001
+*
+* Testing diffusive load balance of a two-dimensional tree.
+*/
+int subtest_001()
+{
+    const double TOLERANCE = 0.05;
+
+    // Create the tree
+    ParaTree tree(2);
+
+    for (int k = 0; k < 5; ++k) {
+        tree.adaptGlobalRefine();
+    }
+
+    tree.loadBalance();
+
+    // Small imbalance
+    //
+    // The imbalance is below the tolerance, no octants should be migrated.
+    log::cout() << "Diffusive load balance with an imbalance below the tolerance" << std::endl;
+
+    if (tree.getRank() == 0) {
+        tree.setMarker((uint32_t) 0, 1);
+    }
+    tree.adapt();
+
+    uint64_t nExpectedMigrations = tree.evalDiffusiveLoadBalanceMigration(TOLERANCE, nullptr);
+    uint64_t nRegularMigrations = evalSentOctants(tree, tree.evalLoadBalanceRanges(static_cast<dvector *>(nullptr)));
+    log::cout() << "  Expected migrations ....... " << nExpectedMigrations << std::endl;
+    log::cout() << "  Regular migrations ........ " << nRegularMigrations << std::endl;
+    if (nExpectedMigrations != 0 || nRegularMigrations == 0) {
+        log::cout() << "Wrong number of migrations" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint64_t> initialPartition = tree.getPartitionRangeGlobalIdx();
+    tree.loadBalanceDiffusive(TOLERANCE);
+    if (tree.getPartitionRangeGlobalIdx() != initialPartition) {
+        log::cout() << "The partition should not be modified" << std::endl;
+        return 1;
+    }
+
+    // Large imbalance
+    //
+    // The imbalance is above the tolerance, octants should be exchanged only
+    // between neighbouring processes.
+    log::cout() << "Diffusive load balance with an imbalance above the tolerance" << std::endl;
+
+    for (uint32_t n = 0; n < tree.getNumOctants(); ++n) {
+        darray3 center = tree.getCenter(n);
+        if (center[0] < 0.25 && center[1] < 0.25) {
+            tree.setMarker(n, 1);
+        }
+    }
+    tree.adapt();
+
+    nExpectedMigrations = tree.evalDiffusiveLoadBalanceMigration(TOLERANCE, nullptr);
+    log::cout() << "  Expected migrations ....... " << nExpectedMigrations << std::endl;
+    if (nExpectedMigrations == 0) {
+        log::cout() << "Wrong number of migrations" << std::endl;
+        return 1;
+    }
+
+    ParaTree::LoadBalanceRanges ranges = tree.evalDiffusiveLoadBalanceRanges(TOLERANCE, nullptr);
+    for (const auto &entry : ranges.sendRanges) {
+        if (std::abs(entry.first - tree.getRank()) > 1) {
+            log::cout() << "Octants should be sent only to neighbouring processes" << std::endl;
+            return 1;
+        }
+    }
+
+    uint64_t nSentOctants = evalSentOctants(tree, ranges);
+    log::cout() << "  Sent octants .............. " << nSentOctants << std::endl;
+    if (nSentOctants != nExpectedMigrations) {
+        log::cout() << "Wrong number of sent octants" << std::endl;
+        return 1;
+    }
+
+    // Load balance with data
+    std::vector<double> data(tree.getNumOctants());
+    std::vector<double> ghostData;
+    for (uint32_t n = 0; n < tree.getNumOctants(); ++n) {
+        data[n] = tree.getCenter(n)[0];
+    }
+
+    UserDataLB dataLB(data, ghostData);
+    tree.loadBalanceDiffusive(dataLB, TOLERANCE);
+
+    for (uint32_t n = 0; n < tree.getNumOctants(); ++n) {
+        if (data[n] != tree.getCenter(n)[0]) {
+            log::cout() << "Wrong data after the load balance" << std::endl;
+            return 1;
+        }
+    }
+
+    // Check the balance
+    double averageOctants = double(tree.getGlobalNumOctants()) / tree.getNproc();
+    const std::vector<uint64_t> &partition = tree.getPartitionRangeGlobalIdx();
+    for (int p = 0; p < tree.getNproc(); ++p) {
+        uint64_t nProcessOctants = partition[p] + 1 - ((p > 0) ? partition[p - 1] + 1 : 0);
+        log::cout() << "  Octants on process " << p << " ...... " << nProcessOctants << std::endl;
+        if (nProcessOctants > (1. + TOLERANCE) * averageOctants + 1.) {
+            log::cout() << "The tree is not balanced" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+    MPI_Init(&argc,&argv);
+
+    int nProcs;
+    int rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Initialize the logger
+    bitpit::log::manager().initialize(bitpit::log::MODE_SEPARATE, false, nProcs, rank);
+    bitpit::log::cout() << log::fileVerbosity(bitpit::log::LEVEL_INFO);
+    bitpit::log::cout() << log::disableConsole();
+
+    // Run the subtests
+    log::cout() << "Testing diffusive load balance" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+    MPI_Finalize();
+}
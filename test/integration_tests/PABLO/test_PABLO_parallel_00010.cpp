@@ -0,0 +1,192 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_common.hpp"
+#include "bitpit_PABLO.hpp"
+
+#include <mpi.h>
+
+#include <vector>
+
+using namespace bitpit;
+
+/*!
+* Check the neighbour table of the specified codimension against the
+* neighbours found by searching the neighbours of every octant.
+*
+* \param tree is the tree
+* \param codim is the codimension of the entities
+* \result Returns zero if the table is correct, a non-zero value otherwise.
+*/
+int checkNeighbourTable(const ParaTree &tree, uint8_t codim)
+{
+    ParaTree::NeighbourTable table;
+    tree.computeNeighbourTable(codim, &table);
+
+    uint32_t nOctants = tree.getNumOctants();
+    uint32_t nGhosts  = tree.getNumGhosts();
+    if (table.nOctants != nOctants || table.nGhosts != nGhosts) {
+        log::cout() << "  Wrong number of octants in the table of codimension " << int(codim) << std::endl;
+        return 1;
+    }
+
+    std::size_t nExpectedRows = (static_cast<std::size_t>(nOctants) + nGhosts) * table.nEntities;
+    if (table.offsets.size() != nExpectedRows + 1 || table.offsets.back() != table.neighbours.size() || table.neighbours.size() != table.ghostFlags.size()) {
+        log::cout() << "  Wrong size of the table of codimension " << int(codim) << std::endl;
+        return 1;
+    }
+
+    std::vector<uint32_t> neighbours;
+    std::vector<bool> isghost;
+    for (int ghost = 0; ghost < 2; ++ghost) {
+        uint32_t nTableOctants = (ghost == 0) ? nOctants : nGhosts;
+        for (uint32_t idx = 0; idx < nTableOctants; ++idx) {
+            for (uint8_t entity = 0; entity < table.nEntities; ++entity) {
+                if (ghost == 0) {
+                    tree.findNeighbours(idx, entity, codim, neighbours, isghost);
+                } else {
+                    tree.findGhostNeighbours(idx, entity, codim, neighbours, isghost);
+                }
+
+                std::size_t row = table.getRow(idx, entity, (ghost != 0));
+                std::size_t nTableNeighbours = table.getNeighbourCount(idx, entity, (ghost != 0));
+                if (nTableNeighbours != neighbours.size()) {
+                    log::cout() << "  Wrong number of neighbours for entity " << int(entity) << " of octant " << idx << " (ghost = " << ghost << ")" << std::endl;
+                    return 1;
+                }
+
+                const uint32_t *tableNeighbours = table.getNeighbours(idx, entity, (ghost != 0));
+                for (std::size_t k = 0; k < nTableNeighbours; ++k) {
+                    if (tableNeighbours[k] != neighbours[k] || table.ghostFlags[table.offsets[row] + k] != isghost[k]) {
+                        log::cout() << "  Wrong neighbour for entity " << int(entity) << " of octant " << idx << " (ghost = " << ghost << ")" << std::endl;
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    log::cout() << "  Table of codimension " << int(codim) << " contains " << table.neighbours.size() << " neighbours" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Build an adapted, partitioned tree.
+*
+* The tree is periodic along the x direction and it is refined inside a
+* sphere, this way neighbours of different sizes, periodic neighbours and
+* ghost neighbours are all present.
+*
+* \param dim is the dimension of the tree
+* \param tree is the tree
+*/
+void buildTree(uint8_t dim, ParaTree *tree)
+{
+    tree->setPeriodic(0);
+
+    for (int i = 0; i < ((dim == 3) ? 3 : 5); ++i) {
+        tree->adaptGlobalRefine();
+    }
+    tree->loadBalance();
+
+    for (int k = 0; k < 2; ++k) {
+        uint32_t nOctants = tree->getNumOctants();
+        for (uint32_t n = 0; n < nOctants; ++n) {
+            std::array<double, 3> center = tree->getCenter(n);
+
+            double distance = 0.;
+            for (int d = 0; d < dim; ++d) {
+                distance += (center[d] - 0.4) * (center[d] - 0.4);
+            }
+
+            if (distance < 0.04) {
+                tree->setMarker(n, 1);
+            }
+        }
+        tree->adapt();
+    }
+    tree->loadBalance();
+}
+
+/*!
+* Subtest 001
+*
+* Testing neighbour tables of 2D and 3D trees, using multiple threads.
+*/
+int subtest_001()
+{
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    for (uint8_t dim = 2; dim <= 3; ++dim) {
+        log::cout() << " Checking neighbour tables of a " << int(dim) << "D tree" << std::endl;
+
+        ParaTree tree(dim);
+        buildTree(dim, &tree);
+
+        for (uint8_t codim = 1; codim <= dim; ++codim) {
+            int status = checkNeighbourTable(tree, codim);
+            if (status != 0) {
+                return status;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+    MPI_Init(&argc,&argv);
+
+    int nProcs;
+    int rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Initialize the logger
+    bitpit::log::manager().initialize(bitpit::log::MODE_SEPARATE, false, nProcs, rank);
+    bitpit::log::cout() << log::fileVerbosity(bitpit::log::LEVEL_INFO);
+    bitpit::log::cout() << log::disableConsole();
+
+    // Run the subtests
+    log::cout() << "Testing neighbour tables" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+    MPI_Finalize();
+}
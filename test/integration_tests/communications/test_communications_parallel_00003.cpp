@@ -0,0 +1,187 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_communications.hpp"
+#include "bitpit_containers.hpp"
+
+using namespace bitpit;
+
+/*!
+ * Auxiliary function to evaluate the value of the fields exchanged
+ */
+double getFieldValue(int rank, long id, std::size_t k)
+{
+	return (1000. * rank + 10. * id + k);
+}
+
+/*!
+ * Test for exchanging the items of pierced storages.
+ *
+ * Every process sends to all the other processes some of the items of its
+ * storages. Items are packed directly into the send buffers and unpacked
+ * directly from the receive buffers.
+ *
+ * \param rank is the rank of the process
+ * \param nProcs is the number of processes
+ */
+int subtest_001(int rank, int nProcs)
+{
+	const long N_ELEMENTS = 1000;
+	const std::size_t N_FIELDS = 2;
+
+	DataCommunicator dataCommunicator(MPI_COMM_WORLD);
+
+	// Create the storages
+	//
+	// Elements are inserted in reverse order on odd ranks, this way the
+	// raw positions of the elements are different on different ranks.
+	log::cout() << "Creating storages" << std::endl;
+
+	PiercedVector<long> container;
+	PiercedStorage<double> storage(N_FIELDS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+	PiercedStorage<bool> flags(1, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+	for (long n = 0; n < N_ELEMENTS; ++n) {
+		long id = (rank % 2 == 0) ? n : (N_ELEMENTS - n - 1);
+		container.insert(id, id);
+		for (std::size_t k = 0; k < N_FIELDS; ++k) {
+			storage.at(id, k) = getFieldValue(rank, id, k);
+		}
+		flags.at(id) = (id % 2 == 0);
+	}
+
+	// Elements exchanged with each process
+	//
+	// Each process receives from all other processes the elements whose
+	// id, modulo the number of processes, is equal to its rank.
+	auto getExchangePositions = [&container, nProcs](int exchangeRank) {
+		std::vector<std::size_t> positions;
+		for (long id = exchangeRank; id < N_ELEMENTS; id += nProcs) {
+			positions.push_back(container.getRawIndex(id));
+		}
+
+		return positions;
+	};
+
+	// Create the sends
+	log::cout() << "Sending data" << std::endl;
+
+	for (int i = 0; i < nProcs; ++i) {
+		if (i == rank) {
+			continue;
+		}
+
+		dataCommunicator.setSend(i, 0);
+	}
+
+	for (int i = 0; i < nProcs; ++i) {
+		if (i == rank) {
+			continue;
+		}
+
+		std::vector<std::size_t> positions = getExchangePositions(i);
+
+		SendBuffer &sendBuffer = dataCommunicator.getSendBuffer(i);
+		sendBuffer.write(storage, positions.size(), positions.data());
+		sendBuffer.write(flags, positions.size(), positions.data());
+		sendBuffer.squeeze();
+	}
+
+	dataCommunicator.discoverRecvs();
+	dataCommunicator.startAllRecvs();
+	dataCommunicator.startAllSends();
+
+	// Receive data
+	std::vector<std::size_t> recvPositions = getExchangePositions(rank);
+
+	int nCompletedRecvs = 0;
+	while (nCompletedRecvs < dataCommunicator.getRecvCount()) {
+		int srcRank = dataCommunicator.waitAnyRecv();
+		log::cout() << "Receiving data from " << srcRank << std::endl;
+
+		RecvBuffer &recvBuffer = dataCommunicator.getRecvBuffer(srcRank);
+		recvBuffer.read(storage, recvPositions.size(), recvPositions.data());
+		recvBuffer.read(flags, recvPositions.size(), recvPositions.data());
+
+		for (long id = rank; id < N_ELEMENTS; id += nProcs) {
+			for (std::size_t k = 0; k < N_FIELDS; ++k) {
+				double expectedValue = getFieldValue(srcRank, id, k);
+				if (storage.at(id, k) != expectedValue) {
+					log::cout() << "Wrong data value." << std::endl;
+					log::cout() << "   Current data value : " << storage.at(id, k) << std::endl;
+					log::cout() << "   Expected data value: " << expectedValue << std::endl;
+					MPI_Abort(MPI_COMM_WORLD, 2);
+				}
+			}
+
+			if (flags.at(id) != (id % 2 == 0)) {
+				log::cout() << "Wrong flag value." << std::endl;
+				MPI_Abort(MPI_COMM_WORLD, 2);
+			}
+		}
+
+		++nCompletedRecvs;
+	}
+
+	// Wait all sends
+	dataCommunicator.waitAllSends();
+
+	// Done
+	return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	// Initialize the logger
+	int nProcs;
+	int	rank;
+	MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	log::manager().initialize(log::MODE_COMBINE, true, nProcs, rank);
+	log::cout().setDefaultVisibility(log::VISIBILITY_GLOBAL);
+
+	// Run the subtests
+	log::cout() << "Testing exchange of pierced storage items" << std::endl;
+
+	int status;
+	try {
+		status = subtest_001(rank, nProcs);
+		if (status != 0) {
+			return status;
+		}
+	} catch (const std::exception &exception) {
+		log::cout() << exception.what();
+		exit(1);
+	}
+
+	MPI_Finalize();
+}
@@ -0,0 +1,261 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using namespace bitpit;
+
+typedef PiercedKernelIndex<long> PositionIndex;
+
+/*!
+* Check if the contents of the container match the expected ones.
+*
+* \param container is the container
+* \param nElements is the number of expected elements
+* \param idStride is the stride between the ids of the expected elements
+*/
+void checkContents(const PiercedVector<double> &container, long nElements, long idStride)
+{
+    container.checkIntegrity();
+
+    if (container.size() != static_cast<std::size_t>(nElements)) {
+        throw std::runtime_error("Size of container doesn't match expected value");
+    }
+
+    for (long k = 0; k < nElements; ++k) {
+        long id = k * idStride;
+        if (!container.exists(id) || container.at(id) != static_cast<double>(id)) {
+            throw std::runtime_error("Contents of container don't match expected values");
+        }
+    }
+
+    if (container.exists(- 1) || container.exists(nElements * idStride)) {
+        throw std::runtime_error("Container contains unexpected elements");
+    }
+}
+
+/*!
+* Subtest 001
+*
+* Testing the modes of the position index.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing the modes of the position index" << std::endl;
+
+    const long N_ELEMENTS = 10000;
+    const long SPARSE_STRIDE = 16;
+
+    // Dense ids are indexed directly
+    std::cout << "Creating container with dense ids..." << std::endl;
+
+    PiercedVector<double> container;
+    for (long id = 0; id < N_ELEMENTS; ++id) {
+        container.insert(id, static_cast<double>(id));
+    }
+
+    std::cout << "  Index mode ...... " << container.getKernel().getIndexMode() << std::endl;
+    if (container.getKernel().getIndexMode() != PositionIndex::MODE_DIRECT) {
+        throw std::runtime_error("Dense ids should be indexed directly");
+    }
+    checkContents(container, N_ELEMENTS, 1);
+
+    // A sparse id switches the index to hashed mode
+    std::cout << "Inserting a sparse id..." << std::endl;
+
+    long sparseId = 1000 * N_ELEMENTS;
+    container.insert(sparseId, static_cast<double>(sparseId));
+
+    std::cout << "  Index mode ...... " << container.getKernel().getIndexMode() << std::endl;
+    if (container.getKernel().getIndexMode() != PositionIndex::MODE_HASHED) {
+        throw std::runtime_error("Sparse ids should be indexed using a hash map");
+    }
+    if (container.at(sparseId) != static_cast<double>(sparseId)) {
+        throw std::runtime_error("Contents of container don't match expected values");
+    }
+
+    // After removing the sparse id, the squeeze switches the index back to direct mode
+    std::cout << "Removing the sparse id and squeezing the container..." << std::endl;
+
+    container.erase(sparseId);
+    container.squeeze();
+
+    std::cout << "  Index mode ...... " << container.getKernel().getIndexMode() << std::endl;
+    if (container.getKernel().getIndexMode() != PositionIndex::MODE_DIRECT) {
+        throw std::runtime_error("Dense ids should be indexed directly after the squeeze");
+    }
+    checkContents(container, N_ELEMENTS, 1);
+
+    // Erasing most of the elements makes the ids sparse, the sort switches
+    // the index to hashed mode
+    std::cout << "Erasing elements and sorting the container..." << std::endl;
+
+    for (long id = 0; id < N_ELEMENTS; ++id) {
+        if (id % SPARSE_STRIDE != 0) {
+            container.erase(id);
+        }
+    }
+    container.sort();
+
+    std::cout << "  Index mode ...... " << container.getKernel().getIndexMode() << std::endl;
+    if (container.getKernel().getIndexMode() != PositionIndex::MODE_HASHED) {
+        throw std::runtime_error("Sparse ids should be indexed using a hash map after the sort");
+    }
+    checkContents(container, N_ELEMENTS / SPARSE_STRIDE, SPARSE_STRIDE);
+
+    // Dump and restore preserve the contents
+    std::cout << "Dumping and restoring the container..." << std::endl;
+
+    std::stringstream buffer;
+    container.dump(buffer);
+
+    PiercedVector<double> restoredContainer;
+    restoredContainer.restore(buffer);
+    checkContents(restoredContainer, N_ELEMENTS / SPARSE_STRIDE, SPARSE_STRIDE);
+
+    // Clearing the container resets the index to direct mode
+    std::cout << "Clearing the container..." << std::endl;
+
+    container.clear();
+
+    std::cout << "  Index mode ...... " << container.getKernel().getIndexMode() << std::endl;
+    if (container.getKernel().getIndexMode() != PositionIndex::MODE_DIRECT) {
+        throw std::runtime_error("An empty index should be in direct mode");
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Comparing the random-access throughput of the index modes.
+*/
+int subtest_002()
+{
+    std::cout << std::endl;
+    std::cout << "Comparing the random-access throughput of the index modes" << std::endl;
+
+    const long N_ELEMENTS = 1000000;
+    const long N_LOOKUPS  = 10000000;
+    const long SPARSE_STRIDE = 16;
+
+    // Generate the sequence of lookups
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<long> distribution(0, N_ELEMENTS - 1);
+
+    std::vector<long> lookups(N_LOOKUPS);
+    for (long &lookup : lookups) {
+        lookup = distribution(generator);
+    }
+
+    // Evaluate the throughput
+    for (long idStride : {1L, SPARSE_STRIDE}) {
+        PiercedVector<double> container;
+        container.reserve(N_ELEMENTS);
+        for (long k = 0; k < N_ELEMENTS; ++k) {
+            long id = k * idStride;
+            container.insert(id, static_cast<double>(id));
+        }
+        container.squeeze();
+
+        PositionIndex::IndexMode mode = container.getKernel().getIndexMode();
+        if ((idStride == 1) != (mode == PositionIndex::MODE_DIRECT)) {
+            throw std::runtime_error("Unexpected index mode");
+        }
+
+        double sum = 0.;
+        auto start = std::chrono::steady_clock::now();
+        for (long lookup : lookups) {
+            sum += container.at(lookup * idStride);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double elapsed = std::chrono::duration<double>(end - start).count();
+        std::string modeName = (mode == PositionIndex::MODE_DIRECT) ? "direct" : "hashed";
+        std::cout << "  Index mode " << modeName << " ...... " << (N_LOOKUPS / elapsed / 1.e6) << " Mlookups/s";
+        std::cout << " (" << container.getKernel().getMemoryUsage() << " bytes used by the kernel)" << std::endl;
+
+        double expectedSum = 0.;
+        for (long lookup : lookups) {
+            expectedSum += static_cast<double>(lookup * idStride);
+        }
+
+        if (sum != expectedSum) {
+            throw std::runtime_error("Contents of container don't match expected values");
+        }
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing PiercedKernel position index" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
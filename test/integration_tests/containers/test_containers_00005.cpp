@@ -0,0 +1,207 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <numeric>
+#include <stdexcept>
+
+using namespace bitpit;
+
+/*!
+* Storage that counts the synchronization actions it receives.
+*/
+class CountingStorage : public PiercedStorage<double, long> {
+
+public:
+    using PiercedStorage<double, long>::PiercedStorage;
+
+    std::size_t nCommittedActions = 0;
+
+protected:
+    void commitSyncAction(const PiercedSyncAction &action) override
+    {
+        ++nCommittedActions;
+        PiercedStorage<double, long>::commitSyncAction(action);
+    }
+
+};
+
+/*!
+* Subtest 001
+*
+* Testing bulk insertion of elements.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing bulk insertion of elements" << std::endl;
+
+    const std::size_t N_ELEMENTS = 1000;
+
+    // Create the container and the synchronized storages
+    std::cout << "Creating container..." << std::endl;
+
+    PiercedVector<double> container;
+    container.insert(0, 0.);
+    container.insert(1, 1.);
+    container.insert(2, 2.);
+    container.erase(1);
+
+    CountingStorage concurrentStorage(2, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    PiercedStorage<double, long> journaledStorage(1, &container, PiercedSyncMaster::SYNC_MODE_JOURNALED);
+
+    // Insert the elements
+    std::cout << "Inserting elements..." << std::endl;
+
+    std::vector<long> ids(N_ELEMENTS);
+    std::iota(ids.begin(), ids.end(), 10);
+
+    std::vector<double> values(N_ELEMENTS);
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        values[k] = static_cast<double>(ids[k]);
+    }
+
+    std::size_t nPreviousActions = concurrentStorage.nCommittedActions;
+    container.insertRange(N_ELEMENTS / 2, ids.data(), values.data());
+    container.emplaceBackRange(N_ELEMENTS / 2, ids.data() + N_ELEMENTS / 2, - 1.);
+    std::size_t nActions = concurrentStorage.nCommittedActions - nPreviousActions;
+
+    std::cout << "  Size of container ............. " << container.size() << std::endl;
+    std::cout << "  Synchronization actions ....... " << nActions << std::endl;
+
+    container.checkIntegrity();
+    if (container.size() != N_ELEMENTS + 2) {
+        throw std::runtime_error("Size of container doesn't match expected value");
+    }
+
+    if (nActions != 2) {
+        throw std::runtime_error("Storage should receive one synchronization action for each range");
+    }
+
+    // Holes are not used by bulk insertion
+    if (container.rawIndex(ids.front()) != 3) {
+        throw std::runtime_error("Elements should be appended after the last element");
+    }
+
+    // Check the contents of the container
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        double expectedValue = (k < N_ELEMENTS / 2) ? values[k] : - 1.;
+        if (container.at(ids[k]) != expectedValue) {
+            throw std::runtime_error("Contents of container don't match expected values");
+        }
+    }
+
+    if (container.at(0) != 0. || container.at(2) != 2.) {
+        throw std::runtime_error("Contents of container don't match expected values");
+    }
+
+    // Check the storages
+    std::cout << "Checking storages..." << std::endl;
+
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        concurrentStorage.at(ids[k], 0) = values[k];
+        concurrentStorage.at(ids[k], 1) = - values[k];
+    }
+
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        if (concurrentStorage.at(ids[k], 0) != values[k] || concurrentStorage.at(ids[k], 1) != - values[k]) {
+            throw std::runtime_error("Contents of concurrent storage don't match expected values");
+        }
+    }
+
+    container.sync();
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        journaledStorage.at(ids[k]) = values[k];
+    }
+
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        if (journaledStorage.at(ids[k]) != values[k]) {
+            throw std::runtime_error("Contents of journaled storage don't match expected values");
+        }
+    }
+
+    // Invalid ranges leave the container untouched
+    std::cout << "Inserting invalid ranges..." << std::endl;
+
+    std::vector<std::vector<long>> invalidRanges = {{5000, 5001, 5000}, {6000, 0}, {7000, - 1}};
+    for (const std::vector<long> &invalidIds : invalidRanges) {
+        std::vector<double> invalidValues(invalidIds.size(), 0.);
+
+        bool exceptionThrown = false;
+        try {
+            container.insertRange(invalidIds.size(), invalidIds.data(), invalidValues.data());
+        } catch (const std::out_of_range &exception) {
+            exceptionThrown = true;
+        }
+
+        if (!exceptionThrown) {
+            throw std::runtime_error("Inserting an invalid range should throw an exception");
+        }
+
+        container.checkIntegrity();
+        if (container.size() != N_ELEMENTS + 2 || container.exists(invalidIds.front())) {
+            throw std::runtime_error("Inserting an invalid range should not modify the container");
+        }
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing PiercedVector bulk insertion" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,336 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+using namespace bitpit;
+
+/*!
+* Storage that counts the synchronization actions it receives.
+*/
+class CountingStorage : public PiercedStorage<long, long> {
+
+public:
+    using PiercedStorage<long, long>::PiercedStorage;
+
+    std::size_t nCommittedActions = 0;
+
+protected:
+    void commitSyncAction(const PiercedSyncAction &action) override
+    {
+        ++nCommittedActions;
+        PiercedStorage<long, long>::commitSyncAction(action);
+    }
+
+};
+
+/*!
+* Check the contents of the container and of the storages.
+*
+* Elements created after the values of the storages have been set may
+* contain any value, the other elements should contain their id in the
+* first field and the opposite of their id in the second field.
+*
+* \param container is the container the storages are synchronized with
+* \param concurrentStorage is the storage synchronized concurrently
+* \param journaledStorage is the journaled storage
+* \param firstNewId is the first id of the elements created after the values
+* of the storages have been set
+*/
+void checkStorages(const PiercedVector<long> &container, const PiercedStorage<long, long> &concurrentStorage,
+                   const PiercedStorage<long, long> &journaledStorage, long firstNewId)
+{
+    container.checkIntegrity();
+
+    for (long id : container.getIds()) {
+        if (container.at(id) != id) {
+            throw std::runtime_error("Contents of container don't match expected values");
+        }
+
+        for (std::size_t k = 0; k < 2; ++k) {
+            if (journaledStorage.at(id, k) != concurrentStorage.at(id, k)) {
+                throw std::runtime_error("Contents of journaled storage don't match the contents of concurrent storage");
+            }
+        }
+
+        if (id < firstNewId) {
+            if (concurrentStorage.at(id, 0) != id || concurrentStorage.at(id, 1) != - id) {
+                throw std::runtime_error("Contents of storages don't match expected values");
+            }
+        }
+    }
+}
+
+/*!
+* Set the values of the storages.
+*
+* \param container is the container the storages are synchronized with
+* \param storages are the storages
+*/
+void setStorageValues(const PiercedVector<long> &container, const std::vector<PiercedStorage<long, long> *> &storages)
+{
+    for (long id : container.getIds()) {
+        for (PiercedStorage<long, long> *storage : storages) {
+            storage->at(id, 0) = id;
+            storage->at(id, 1) = - id;
+        }
+    }
+}
+
+/*!
+* Subtest 001
+*
+* Testing the coalesced journal against random modifications.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing the coalesced journal against random modifications" << std::endl;
+
+    const int N_BATCHES = 200;
+    const int N_BATCH_OPERATIONS = 50;
+
+    PiercedVector<long> container;
+    for (long id = 0; id < 100; ++id) {
+        container.emplace(id, id);
+    }
+
+    PiercedStorage<long, long> concurrentStorage(2, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    PiercedStorage<long, long> journaledStorage(2, &container, PiercedSyncMaster::SYNC_MODE_JOURNALED);
+    setStorageValues(container, {&concurrentStorage, &journaledStorage});
+
+    std::mt19937 generator(1);
+    long nextId = 100;
+    for (int batch = 0; batch < N_BATCHES; ++batch) {
+        long firstNewId = nextId;
+        for (int n = 0; n < N_BATCH_OPERATIONS; ++n) {
+            std::vector<long> ids = container.getIds();
+            long randomId = -1;
+            long otherId  = -1;
+            if (ids.size() >= 2) {
+                randomId = ids[generator() % ids.size()];
+                otherId  = ids[generator() % ids.size()];
+            }
+
+            int operation = generator() % 16;
+            if (ids.size() < 10) {
+                operation = 0;
+            }
+
+            switch (operation) {
+
+            case 0:
+            case 1:
+            case 2:
+                container.emplace(nextId, nextId);
+                ++nextId;
+                break;
+
+            case 3:
+                container.emplaceBack(nextId, nextId);
+                ++nextId;
+                break;
+
+            case 4:
+                container.insertAfter(randomId, nextId, nextId);
+                ++nextId;
+                break;
+
+            case 5:
+                container.insertBefore(randomId, nextId, nextId);
+                ++nextId;
+                break;
+
+            case 6:
+            case 7:
+            case 8:
+                container.erase(randomId);
+                break;
+
+            case 9:
+                container.popBack();
+                break;
+
+            case 10:
+                if (randomId != otherId) {
+                    container.swap(randomId, otherId);
+                }
+                break;
+
+            case 11:
+                if (randomId != otherId) {
+                    container.moveAfter(randomId, otherId);
+                }
+                break;
+
+            case 12:
+                if (randomId != otherId) {
+                    container.moveBefore(randomId, otherId);
+                }
+                break;
+
+            case 13:
+            {
+                std::vector<long> rangeIds = {nextId, nextId + 1, nextId + 2};
+                container.insertRange(rangeIds.size(), rangeIds.data(), rangeIds.data());
+                nextId += 3;
+                break;
+            }
+
+            case 14:
+                container.squeeze();
+                break;
+
+            case 15:
+                if (generator() % 2 == 0) {
+                    container.sort();
+                } else {
+                    container.resize(container.size() - 5);
+                }
+                break;
+
+            }
+        }
+
+        // Synchronize the journaled storage and check the contents
+        container.sync();
+        checkStorages(container, concurrentStorage, journaledStorage, firstNewId);
+
+        setStorageValues(container, {&concurrentStorage, &journaledStorage});
+    }
+
+    std::cout << "  Size of container ............. " << container.size() << std::endl;
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Testing the synchronization of journaled storages after a large number of
+* modifications.
+*/
+int subtest_002()
+{
+    std::cout << std::endl;
+    std::cout << "Testing the synchronization after a large number of modifications" << std::endl;
+
+    const long N_ELEMENTS = 1000000;
+
+    PiercedVector<long> container;
+    container.reserve(N_ELEMENTS);
+    for (long id = 0; id < N_ELEMENTS; ++id) {
+        container.emplaceBack(id, id);
+    }
+
+    PiercedStorage<long, long> concurrentStorage(2, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    CountingStorage journaledStorage(2, &container, PiercedSyncMaster::SYNC_MODE_JOURNALED);
+    setStorageValues(container, {&concurrentStorage, &journaledStorage});
+
+    // Interleaved erases, fills, swaps and appends, as done when a patch
+    // is adapted
+    std::cout << "Modifying container..." << std::endl;
+
+    long nextId = N_ELEMENTS;
+    for (long id = 0; id < N_ELEMENTS; id += 2) {
+        container.erase(id);
+        container.emplace(nextId, nextId);
+        ++nextId;
+        if (id % 8 == 0) {
+            container.emplace(nextId, nextId);
+            ++nextId;
+        }
+        if (id % 6 == 0) {
+            container.swap(id + 1, nextId - 1);
+        }
+    }
+
+    // Synchronize the journaled storage
+    std::cout << "Synchronizing journaled storage..." << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    container.sync();
+    auto end = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "  Committed actions ............. " << journaledStorage.nCommittedActions << std::endl;
+    std::cout << "  Synchronization time .......... " << elapsed << " s" << std::endl;
+
+    // Moves are coalesced into a single action, an additional action
+    // notifies that the holes have changed
+    if (journaledStorage.nCommittedActions != 2) {
+        throw std::runtime_error("Journaled actions should be coalesced into a single action");
+    }
+
+    checkStorages(container, concurrentStorage, journaledStorage, N_ELEMENTS);
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing PiercedStorage journaled synchronization" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,335 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using namespace bitpit;
+
+const std::size_t N_COMPONENTS = 3;
+const double HOLE_VALUE = -1.;
+
+/*!
+* Evaluate the expected value of a component of an element.
+*
+* \param id is the id of the element
+* \param k is the index of the component
+* \result The expected value of the component.
+*/
+double evalComponentValue(long id, std::size_t k)
+{
+    return static_cast<double>(10 * id + static_cast<long>(k));
+}
+
+/*!
+* Check the contents of a component storage.
+*
+* All the components of the holes should contain the hole value, elements
+* created after the values of the storage have been set may contain any
+* value.
+*
+* \param container is the container the storage is synchronized with
+* \param storage is the storage that will be checked
+* \param firstNewId is the first id of the elements created after the values
+* of the storage have been set
+*/
+void checkStorage(const PiercedVector<long> &container, const PiercedComponentStorage<double, long> &storage, long firstNewId)
+{
+    std::size_t rawSize = storage.rawSize();
+    std::vector<bool> isHole(rawSize, true);
+    for (long id : container.getIds()) {
+        std::size_t pos = container.rawIndex(id);
+        if (pos >= rawSize) {
+            throw std::runtime_error("Size of storage doesn't match the size of the container");
+        }
+        isHole[pos] = false;
+
+        if (id >= firstNewId) {
+            continue;
+        }
+
+        for (std::size_t k = 0; k < N_COMPONENTS; ++k) {
+            if (storage.at(id, k) != evalComponentValue(id, k)) {
+                throw std::runtime_error("Contents of storage don't match expected values");
+            }
+        }
+    }
+
+    if (rawSize > 0 && isHole.back()) {
+        throw std::runtime_error("Size of storage doesn't match the size of the container");
+    }
+
+    for (std::size_t k = 0; k < N_COMPONENTS; ++k) {
+        const double *componentData = storage.rawComponentData(k);
+        if (rawSize > 0 && !utils::memory::isAligned(componentData, utils::memory::SIMD_ALIGNMENT)) {
+            throw std::runtime_error("Component buffer is not aligned");
+        }
+
+        for (std::size_t pos = 0; pos < rawSize; ++pos) {
+            if (isHole[pos] && componentData[pos] != HOLE_VALUE) {
+                throw std::runtime_error("Holes don't contain the hole value");
+            }
+        }
+    }
+}
+
+/*!
+* Set the values of the storages.
+*
+* \param container is the container the storages are synchronized with
+* \param storages are the storages
+*/
+void setStorageValues(const PiercedVector<long> &container, const std::vector<PiercedComponentStorage<double, long> *> &storages)
+{
+    std::array<double, N_COMPONENTS> values;
+    for (long id : container.getIds()) {
+        for (std::size_t k = 0; k < N_COMPONENTS; ++k) {
+            values[k] = evalComponentValue(id, k);
+        }
+
+        for (PiercedComponentStorage<double, long> *storage : storages) {
+            storage->set(id, values.data());
+        }
+    }
+}
+
+/*!
+* Subtest 001
+*
+* Testing component storages against random modifications.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing component storages against random modifications" << std::endl;
+
+    const int N_BATCHES = 100;
+    const int N_BATCH_OPERATIONS = 50;
+
+    PiercedVector<long> container;
+    for (long id = 0; id < 100; ++id) {
+        container.emplace(id, id);
+    }
+
+    PiercedComponentStorage<double, long> concurrentStorage(N_COMPONENTS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT, HOLE_VALUE);
+    PiercedComponentStorage<double, long> journaledStorage(N_COMPONENTS, &container, PiercedSyncMaster::SYNC_MODE_JOURNALED, HOLE_VALUE);
+    setStorageValues(container, {&concurrentStorage, &journaledStorage});
+
+    std::mt19937 generator(1);
+    long nextId = 100;
+    for (int batch = 0; batch < N_BATCHES; ++batch) {
+        long firstNewId = nextId;
+        for (int n = 0; n < N_BATCH_OPERATIONS; ++n) {
+            std::vector<long> ids = container.getIds();
+            long randomId = ids[generator() % ids.size()];
+            long otherId  = ids[generator() % ids.size()];
+
+            int operation = generator() % 14;
+            if (ids.size() < 10) {
+                operation = 0;
+            }
+
+            switch (operation) {
+
+            case 0:
+            case 1:
+            case 2:
+                container.emplace(nextId, nextId);
+                ++nextId;
+                break;
+
+            case 3:
+                container.emplaceBack(nextId, nextId);
+                ++nextId;
+                break;
+
+            case 4:
+                container.insertAfter(randomId, nextId, nextId);
+                ++nextId;
+                break;
+
+            case 5:
+            case 6:
+            case 7:
+                container.erase(randomId);
+                break;
+
+            case 8:
+                container.popBack();
+                break;
+
+            case 9:
+                if (randomId != otherId) {
+                    container.swap(randomId, otherId);
+                }
+                break;
+
+            case 10:
+                if (randomId != otherId) {
+                    container.moveAfter(randomId, otherId);
+                }
+                break;
+
+            case 11:
+                if (randomId != otherId) {
+                    container.moveBefore(randomId, otherId);
+                }
+                break;
+
+            case 12:
+                container.squeeze();
+                break;
+
+            case 13:
+                container.sort();
+                break;
+
+            }
+        }
+
+        // Synchronize the journaled storage and check the contents
+        container.sync();
+        checkStorage(container, concurrentStorage, firstNewId);
+        checkStorage(container, journaledStorage, firstNewId);
+
+        setStorageValues(container, {&concurrentStorage, &journaledStorage});
+    }
+
+    std::cout << "  Size of container ............. " << container.size() << std::endl;
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Testing vectorized loops over the components.
+*/
+int subtest_002()
+{
+    std::cout << std::endl;
+    std::cout << "Testing vectorized loops over the components" << std::endl;
+
+    PiercedVector<long> container;
+    for (long id = 0; id < 1000; ++id) {
+        container.emplaceBack(id, id);
+    }
+
+    for (long id = 0; id < 1000; id += 3) {
+        container.erase(id);
+    }
+
+    PiercedComponentStorage<double, long> storage(N_COMPONENTS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT, HOLE_VALUE);
+    setStorageValues(container, {&storage});
+
+    // Use a neutral value for the holes and evaluate the sum of the
+    // components looping over the raw buffers
+    storage.setHoleValue(0.);
+
+    std::size_t rawSize = storage.rawSize();
+    for (std::size_t k = 0; k < N_COMPONENTS; ++k) {
+        const double *componentData = storage.rawComponentData(k);
+
+        double sum = 0.;
+        for (std::size_t pos = 0; pos < rawSize; ++pos) {
+            sum += componentData[pos];
+        }
+
+        double expectedSum = 0.;
+        for (long id : container.getIds()) {
+            expectedSum += evalComponentValue(id, k);
+        }
+
+        std::cout << "  Sum of component " << k << " .......... " << sum << std::endl;
+        if (sum != expectedSum) {
+            throw std::runtime_error("Sum of the components doesn't match expected value");
+        }
+    }
+
+    // Dump and restore the storage
+    std::stringstream buffer;
+    storage.dump(buffer);
+
+    PiercedComponentStorage<double, long> restoredStorage(N_COMPONENTS, 0.);
+    restoredStorage.restore(buffer);
+    if (restoredStorage.rawSize() != rawSize) {
+        throw std::runtime_error("Size of the restored storage doesn't match expected value");
+    }
+
+    for (std::size_t k = 0; k < N_COMPONENTS; ++k) {
+        for (std::size_t pos = 0; pos < rawSize; ++pos) {
+            if (restoredStorage.rawAt(pos, k) != storage.rawAt(pos, k)) {
+                throw std::runtime_error("Contents of the restored storage don't match expected values");
+            }
+        }
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing PiercedComponentStorage" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,268 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+using namespace bitpit;
+
+const std::size_t N_ELEMENTS = 100000;
+
+/*!
+* Evaluate the expected value of a field of an element.
+*
+* \param id is the id of the element
+* \param k is the index of the field
+* \result The expected value of the field.
+*/
+double evalFieldValue(long id, std::size_t k)
+{
+    return static_cast<double>(10 * id + static_cast<long>(k));
+}
+
+/*!
+* Check if the container contains holes.
+*
+* \param container is the container
+* \result Returns true if the container contains no holes, false otherwise.
+*/
+bool isCompact(const PiercedVector<long> &container)
+{
+    std::size_t expectedPos = 0;
+    for (auto itr = container.cbegin(); itr != container.cend(); ++itr) {
+        if (container.rawIndex(itr.getId()) != expectedPos) {
+            return false;
+        }
+        ++expectedPos;
+    }
+
+    return true;
+}
+
+/*!
+* Check the contents of the storages synchronized with the container.
+*
+* \param container is the container
+* \param storage is the storage with multiple fields
+* \param flagStorage is the storage of booleans
+* \param componentStorage is the component storage
+*/
+void checkStorages(const PiercedVector<long> &container, const PiercedStorage<double> &storage,
+                   const PiercedStorage<bool> &flagStorage, const PiercedComponentStorage<double> &componentStorage)
+{
+    container.checkIntegrity();
+
+    for (auto itr = container.cbegin(); itr != container.cend(); ++itr) {
+        long id = itr.getId();
+        if (*itr != id) {
+            throw std::runtime_error("Contents of container don't match expected values");
+        }
+
+        for (std::size_t k = 0; k < storage.getFieldCount(); ++k) {
+            if (storage.at(id, k) != evalFieldValue(id, k)) {
+                throw std::runtime_error("Contents of storage don't match expected values");
+            }
+        }
+
+        if (flagStorage.at(id) != (id % 3 == 0)) {
+            throw std::runtime_error("Contents of boolean storage don't match expected values");
+        }
+
+        for (std::size_t k = 0; k < componentStorage.getComponentCount(); ++k) {
+            if (componentStorage.at(id, k) != evalFieldValue(id, k)) {
+                throw std::runtime_error("Contents of component storage don't match expected values");
+            }
+        }
+    }
+}
+
+/*!
+* Subtest 001
+*
+* Testing squeeze and sort of a container with synchronized storages.
+*
+* \param reorderMemoryLimit is the maximum amount of temporary memory that
+* can be used for reordering the storages
+*/
+int subtest_001(std::size_t reorderMemoryLimit)
+{
+    std::cout << std::endl;
+    std::cout << "Testing squeeze and sort with a reorder memory limit of " << reorderMemoryLimit << " bytes" << std::endl;
+
+    utils::setReorderMemoryLimit(reorderMemoryLimit);
+
+    // Create the container and the synchronized storages
+    std::cout << "Creating container..." << std::endl;
+
+    std::mt19937 generator(1);
+
+    std::vector<long> ids(N_ELEMENTS);
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        ids[k] = static_cast<long>(k);
+    }
+    std::shuffle(ids.begin(), ids.end(), generator);
+
+    PiercedVector<long> container;
+    PiercedStorage<double> storage(2, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    PiercedStorage<bool> flagStorage(1, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    PiercedComponentStorage<double> componentStorage(3, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+
+    for (long id : ids) {
+        container.insert(id, id);
+        storage.at(id, 0) = evalFieldValue(id, 0);
+        storage.at(id, 1) = evalFieldValue(id, 1);
+        flagStorage.at(id) = (id % 3 == 0);
+        for (std::size_t k = 0; k < componentStorage.getComponentCount(); ++k) {
+            componentStorage.at(id, k) = evalFieldValue(id, k);
+        }
+    }
+
+    // Erase some elements
+    std::cout << "Erasing elements..." << std::endl;
+
+    std::bernoulli_distribution eraseDistribution(0.3);
+    for (long id : ids) {
+        if (eraseDistribution(generator)) {
+            container.erase(id);
+        }
+    }
+
+    std::size_t nElements = container.size();
+
+    // Squeeze the container
+    std::cout << "Squeezing container..." << std::endl;
+
+    container.squeeze();
+    if (container.size() != nElements || !isCompact(container)) {
+        throw std::runtime_error("Squeezed container should not contain holes");
+    }
+
+    checkStorages(container, storage, flagStorage, componentStorage);
+
+    // Sort the second half of the container
+    std::cout << "Sorting the second half of the container..." << std::endl;
+
+    std::vector<long> unsortedIds;
+    for (auto itr = container.cbegin(); itr != container.cend(); ++itr) {
+        unsortedIds.push_back(itr.getId());
+    }
+
+    long referenceId = unsortedIds[nElements / 2];
+    container.sortAfter(referenceId, true);
+
+    std::size_t pos = 0;
+    long previousId = -1;
+    for (auto itr = container.cbegin(); itr != container.cend(); ++itr) {
+        long id = itr.getId();
+        if (pos < nElements / 2) {
+            if (id != unsortedIds[pos]) {
+                throw std::runtime_error("Elements before the reference element should not be moved");
+            }
+        } else {
+            if (id <= previousId) {
+                throw std::runtime_error("Elements after the reference element are not sorted");
+            }
+            previousId = id;
+        }
+        ++pos;
+    }
+
+    checkStorages(container, storage, flagStorage, componentStorage);
+
+    // Erase more elements and sort the whole container
+    std::cout << "Sorting the container..." << std::endl;
+
+    for (long id : ids) {
+        if (container.exists(id) && eraseDistribution(generator)) {
+            container.erase(id);
+        }
+    }
+
+    nElements = container.size();
+    container.sort();
+    if (container.size() != nElements || !isCompact(container)) {
+        throw std::runtime_error("Sorted container should not contain holes");
+    }
+
+    previousId = -1;
+    for (auto itr = container.cbegin(); itr != container.cend(); ++itr) {
+        if (itr.getId() <= previousId) {
+            throw std::runtime_error("Elements of the container are not sorted");
+        }
+        previousId = itr.getId();
+    }
+
+    checkStorages(container, storage, flagStorage, componentStorage);
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Reorder the containers using multiple threads
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    // Run the subtests
+    std::cout << "Testing squeeze and sort of PiercedVector with synchronized storages" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001(utils::getReorderMemoryLimit());
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_001(1024);
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,188 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <stdexcept>
+
+using namespace bitpit;
+
+/*!
+* Evaluate the number of items of a vector.
+*
+* \param i is the index of the vector
+* \result The number of items of the vector.
+*/
+std::size_t evalItemCount(std::size_t i)
+{
+    return (i % 7);
+}
+
+/*!
+* Evaluate the value of an item.
+*
+* \param i is the index of the vector
+* \param j is the index of the item
+* \result The value of the item.
+*/
+long evalItemValue(std::size_t i, std::size_t j)
+{
+    return static_cast<long>(10 * i + j);
+}
+
+/*!
+* Check the contents of a container.
+*
+* \param nVectors is the expected number of vectors
+* \param vector is the container that will be checked
+*/
+void checkContainer(std::size_t nVectors, const FlatVector2D<long> &vector)
+{
+    if (vector.size() != nVectors) {
+        throw std::runtime_error("Size of container doesn't match expected value");
+    }
+
+    std::size_t nItems = 0;
+    for (std::size_t i = 0; i < nVectors; ++i) {
+        if (vector.indices(i)[0] != nItems) {
+            throw std::runtime_error("Index of container doesn't match expected value");
+        }
+
+        std::size_t nVectorItems = vector.getItemCount(i);
+        if (nVectorItems != evalItemCount(i)) {
+            throw std::runtime_error("Size of vector doesn't match expected value");
+        }
+
+        for (std::size_t j = 0; j < nVectorItems; ++j) {
+            if (vector.getItem(i, j) != evalItemValue(i, j)) {
+                throw std::runtime_error("Contents of container don't match expected values");
+            }
+        }
+
+        nItems += nVectorItems;
+    }
+
+    if (vector.getItemCount() != nItems) {
+        throw std::runtime_error("Number of items doesn't match expected value");
+    }
+}
+
+/*!
+* Subtest 001
+*
+* Testing two-pass construction of FlatVector2D.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing two-pass construction of FlatVector2D" << std::endl;
+
+    const std::size_t N_VECTORS = 100000;
+
+    // Build the container filling the items through the pointer
+    std::cout << "Building container..." << std::endl;
+
+    FlatVector2D<long> vector(false);
+    vector.build(N_VECTORS,
+        [](std::size_t i) { return evalItemCount(i); },
+        [](std::size_t i, long *items) {
+            for (std::size_t j = 0; j < evalItemCount(i); ++j) {
+                items[j] = evalItemValue(i, j);
+            }
+        }
+    );
+
+    checkContainer(N_VECTORS, vector);
+
+    // Rebuild the container filling the items through the container
+    std::cout << "Rebuilding container..." << std::endl;
+
+    vector.build(N_VECTORS / 2,
+        [](std::size_t i) { return evalItemCount(i); },
+        [&vector](std::size_t i, long *items) {
+            BITPIT_UNUSED(items);
+
+            std::size_t offset = vector.indices(i)[0];
+            for (std::size_t j = 0; j < evalItemCount(i); ++j) {
+                vector.rawSetItem(offset + j, evalItemValue(i, j));
+            }
+        }
+    );
+
+    checkContainer(N_VECTORS / 2, vector);
+
+    // Build an empty container
+    std::cout << "Building empty container..." << std::endl;
+
+    FlatVector2D<long> emptyVector(false);
+    emptyVector.build(0,
+        [](std::size_t i) { return evalItemCount(i); },
+        [](std::size_t i, long *items) { BITPIT_UNUSED(i); BITPIT_UNUSED(items); }
+    );
+
+    checkContainer(0, emptyVector);
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Build the containers using multiple threads
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    // Run the subtests
+    std::cout << "Testing FlatVector2D construction" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,213 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <stdexcept>
+#include <type_traits>
+
+using namespace bitpit;
+
+/*!
+* Sample stored in the containers.
+*/
+struct Sample {
+    double value;
+    long tag;
+};
+
+/*!
+* Allocator that stores samples in huge pages.
+*/
+typedef utils::memory::HugePageAllocator<Sample> SampleAllocator;
+
+/*!
+* Subtest 001
+*
+* Testing containers that store their objects in huge pages.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing containers that store their objects in huge pages" << std::endl;
+
+    const std::size_t N_ELEMENTS = 2 * utils::memory::HUGE_PAGE_SIZE / sizeof(Sample);
+
+    // Check the allocators used by the containers
+    static_assert(std::is_same<PiercedStorage<Sample, long, SampleAllocator>::container_t::allocator_type, SampleAllocator>::value,
+                  "Pierced storage should use the specified allocator");
+    static_assert(std::is_same<ProxyVector<Sample, false, SampleAllocator>::container_type::allocator_type, SampleAllocator>::value,
+                  "Proxy vector should use the specified allocator");
+    static_assert(std::is_same<PiercedStorage<Sample>::container_t::allocator_type, std::allocator<Sample>>::value,
+                  "Pierced storage should use the standard allocator by default");
+    static_assert(std::is_same<ProxyVector<Sample>::container_type::allocator_type, std::allocator<Sample>>::value,
+                  "Proxy vector should use the standard allocator by default");
+
+    // Fill a pierced vector and a synchronized storage
+    std::cout << "Filling pierced containers..." << std::endl;
+
+    PiercedVector<Sample, long, SampleAllocator> container;
+    PiercedStorage<Sample> storage(1, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    container.reserve(N_ELEMENTS);
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        long id = static_cast<long>(k);
+        container.emplace(id, Sample{static_cast<double>(k), id});
+        storage.at(id) = Sample{- static_cast<double>(k), id};
+    }
+
+    if (!utils::memory::isAligned(container.data(), utils::memory::HUGE_PAGE_SIZE)) {
+        throw std::runtime_error("Large buffers should be aligned to the size of a huge page");
+    }
+
+    for (long id = 0; id < static_cast<long>(N_ELEMENTS); id += 2) {
+        container.erase(id);
+    }
+    container.squeeze();
+
+    for (auto itr = container.cbegin(); itr != container.cend(); ++itr) {
+        long id = itr.getId();
+        if (itr->tag != id || itr->value != static_cast<double>(id)) {
+            throw std::runtime_error("Contents of container don't match expected values");
+        }
+
+        if (storage.at(id).tag != id || storage.at(id).value != - static_cast<double>(id)) {
+            throw std::runtime_error("Contents of storage don't match expected values");
+        }
+    }
+
+    // Fill a proxy vector
+    std::cout << "Filling proxy vector..." << std::endl;
+
+    ProxyVector<const Sample, false, SampleAllocator> proxy(N_ELEMENTS);
+    Sample *proxyData = proxy.storedData();
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        proxyData[k] = Sample{static_cast<double>(k), static_cast<long>(k)};
+    }
+
+    if (!utils::memory::isAligned(proxy.data(), utils::memory::HUGE_PAGE_SIZE)) {
+        throw std::runtime_error("Large buffers should be aligned to the size of a huge page");
+    }
+
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        if (proxy[k].tag != static_cast<long>(k)) {
+            throw std::runtime_error("Contents of proxy vector don't match expected values");
+        }
+    }
+
+    // Build a flat vector stored in huge pages
+    std::cout << "Building flat vector..." << std::endl;
+
+    FlatVector2D<long, utils::memory::HugePageAllocator<long>> flatVector(false);
+    flatVector.build(N_ELEMENTS,
+        [](std::size_t i) { return (i % 3 + 1); },
+        [](std::size_t i, long *items) {
+            for (std::size_t j = 0; j < (i % 3 + 1); ++j) {
+                items[j] = static_cast<long>(i + j);
+            }
+        }
+    );
+
+    if (!utils::memory::isAligned(flatVector.data(), utils::memory::HUGE_PAGE_SIZE)) {
+        throw std::runtime_error("Large buffers should be aligned to the size of a huge page");
+    }
+
+    for (std::size_t i = 0; i < N_ELEMENTS; ++i) {
+        for (std::size_t j = 0; j < flatVector.getItemCount(i); ++j) {
+            if (flatVector.getItem(i, j) != static_cast<long>(i + j)) {
+                throw std::runtime_error("Contents of flat vector don't match expected values");
+            }
+        }
+    }
+
+    // Initialize a buffer using multiple threads
+    std::cout << "Initializing buffer..." << std::endl;
+
+    std::vector<double, utils::memory::DefaultInitAllocator<double>> buffer;
+    buffer.resize(N_ELEMENTS);
+    utils::memory::firstTouch(buffer.data(), buffer.size(), 1.);
+    for (double value : buffer) {
+        if (value != 1.) {
+            throw std::runtime_error("Contents of buffer don't match expected values");
+        }
+    }
+
+    if (!utils::memory::isAligned(buffer.data(), utils::memory::HUGE_PAGE_SIZE)) {
+        throw std::runtime_error("Large buffers should be aligned to the size of a huge page");
+    }
+
+    // Resize a small vector, reusing its storage
+    std::cout << "Resizing small vector..." << std::endl;
+
+    std::vector<long, utils::memory::HugePageAllocator<long>> smallVector(16, 7);
+    smallVector.clear();
+    smallVector.resize(16);
+    for (long value : smallVector) {
+        if (value != 0) {
+            throw std::runtime_error("Elements added by a resize should be value-initialized");
+        }
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the buffers using multiple threads
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    // Run the subtests
+    std::cout << "Testing containers allocators" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
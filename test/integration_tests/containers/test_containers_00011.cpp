@@ -0,0 +1,195 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <stdexcept>
+
+using namespace bitpit;
+
+/*!
+* Subtest 001
+*
+* Testing packing and unpacking of storage items into binary streams.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing packing and unpacking of storage items" << std::endl;
+
+    const std::size_t N_ELEMENTS = 1000;
+    const std::size_t N_FIELDS   = 3;
+
+    // Fill the containers
+    std::cout << "Filling source containers..." << std::endl;
+
+    PiercedVector<long> sourceContainer;
+    PiercedStorage<double> sourceStorage(N_FIELDS, &sourceContainer, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    PiercedStorage<bool> sourceFlags(1, &sourceContainer, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        long id = static_cast<long>(k);
+        sourceContainer.insert(id, id);
+        for (std::size_t i = 0; i < N_FIELDS; ++i) {
+            sourceStorage.at(id, i) = 10. * k + i;
+        }
+        sourceFlags.at(id) = (k % 3 == 0);
+    }
+
+    // Items to be packed, both runs of consecutive items and scattered items
+    std::vector<std::size_t> sourcePositions;
+    for (std::size_t k = 100; k < 200; ++k) {
+        sourcePositions.push_back(sourceContainer.getRawIndex(static_cast<long>(k)));
+    }
+    for (std::size_t k = 900; k > 500; k -= 7) {
+        sourcePositions.push_back(sourceContainer.getRawIndex(static_cast<long>(k)));
+    }
+
+    const std::size_t nPackedItems = sourcePositions.size();
+
+    // Pack the items
+    std::cout << "Packing items..." << std::endl;
+
+    OBinaryStream packedStream;
+    packedStream << nPackedItems;
+    sourceStorage.rawPack(nPackedItems, sourcePositions.data(), packedStream.writeInPlace(sourceStorage.getPackedSize(nPackedItems)));
+    sourceFlags.rawPack(nPackedItems, sourcePositions.data(), packedStream.writeInPlace(sourceFlags.getPackedSize(nPackedItems)));
+
+    // Streaming the fields one by one should give the same data
+    OBinaryStream streamedStream;
+    streamedStream << nPackedItems;
+    for (std::size_t pos : sourcePositions) {
+        for (std::size_t i = 0; i < N_FIELDS; ++i) {
+            streamedStream << sourceStorage.rawAt(pos, i);
+        }
+    }
+    for (std::size_t pos : sourcePositions) {
+        streamedStream << static_cast<bool>(sourceFlags.rawAt(pos));
+    }
+
+    std::cout << "  Size of packed data ........... " << packedStream.tellg() << std::endl;
+
+    if (packedStream.tellg() != streamedStream.tellg()) {
+        throw std::runtime_error("Size of packed data doesn't match the size of streamed data");
+    }
+
+    for (std::size_t n = 0; n < static_cast<std::size_t>(packedStream.tellg()); ++n) {
+        if (packedStream.data()[n] != streamedStream.data()[n]) {
+            throw std::runtime_error("Packed data doesn't match streamed data");
+        }
+    }
+
+    // Unpack the items in a container with a different layout
+    std::cout << "Unpacking items..." << std::endl;
+
+    PiercedVector<long> targetContainer;
+    PiercedStorage<double> targetStorage(N_FIELDS, &targetContainer, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    PiercedStorage<bool> targetFlags(1, &targetContainer, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    for (std::size_t k = 0; k < N_ELEMENTS; ++k) {
+        long id = static_cast<long>(N_ELEMENTS - k - 1);
+        targetContainer.insert(id, id);
+        targetFlags.at(id) = false;
+    }
+
+    IBinaryStream unpackStream(packedStream.data(), packedStream.tellg());
+
+    std::size_t nUnpackedItems;
+    unpackStream >> nUnpackedItems;
+
+    std::vector<std::size_t> targetPositions;
+    for (std::size_t pos : sourcePositions) {
+        long id = sourceContainer.rawFind(pos).getId();
+        targetPositions.push_back(targetContainer.getRawIndex(id));
+    }
+
+    targetStorage.rawUnpack(nUnpackedItems, targetPositions.data(), unpackStream.readInPlace(targetStorage.getPackedSize(nUnpackedItems)));
+    targetFlags.rawUnpack(nUnpackedItems, targetPositions.data(), unpackStream.readInPlace(targetFlags.getPackedSize(nUnpackedItems)));
+
+    if (!unpackStream.eof()) {
+        throw std::runtime_error("Unpacking should consume all the data of the stream");
+    }
+
+    for (std::size_t n = 0; n < nUnpackedItems; ++n) {
+        long id = sourceContainer.rawFind(sourcePositions[n]).getId();
+        for (std::size_t i = 0; i < N_FIELDS; ++i) {
+            if (targetStorage.at(id, i) != sourceStorage.at(id, i)) {
+                throw std::runtime_error("Unpacked values don't match expected values");
+            }
+        }
+
+        if (targetFlags.at(id) != sourceFlags.at(id)) {
+            throw std::runtime_error("Unpacked flags don't match expected values");
+        }
+    }
+
+    // Reading past the end of the stream is not allowed
+    bool exceptionThrown = false;
+    try {
+        unpackStream.readInPlace(1);
+    } catch (const std::runtime_error &exception) {
+        exceptionThrown = true;
+    }
+
+    if (!exceptionThrown) {
+        throw std::runtime_error("Reading past the end of the stream should throw an exception");
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing packing of PiercedStorage items" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
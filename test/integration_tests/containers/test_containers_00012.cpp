@@ -0,0 +1,202 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace bitpit;
+
+/*!
+* Subtest 001
+*
+* Testing concurrent read access to pierced vectors and storages.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing concurrent read access" << std::endl;
+
+    const long N_ELEMENTS = 20000;
+    const std::size_t N_FIELDS = 2;
+    const std::size_t N_TASKS = 64;
+    const int N_THREADS = 8;
+
+    // Fill the containers
+    //
+    // Some elements are deleted and the kernel is not flushed, this way the
+    // iterators will have to skip the holes.
+    std::cout << "Filling containers..." << std::endl;
+
+    PiercedVector<long> container;
+    PiercedStorage<double> storage(N_FIELDS, &container, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    for (long id = 0; id < N_ELEMENTS; ++id) {
+        container.insert(id, id);
+        for (std::size_t k = 0; k < N_FIELDS; ++k) {
+            storage.at(id, k) = 10. * id + k;
+        }
+    }
+
+    long nElements = 0;
+    long expectedSum = 0;
+    for (long id = 0; id < N_ELEMENTS; ++id) {
+        if (id % 7 == 3) {
+            container.erase(id);
+        } else {
+            ++nElements;
+            expectedSum += id;
+        }
+    }
+
+    bool isIteratorSlow = container.getKernel().isIteratorSlow();
+    std::cout << "  Iterator is slow .............. " << isIteratorSlow << std::endl;
+
+    // Query the containers concurrently
+    std::cout << "Querying containers concurrently..." << std::endl;
+
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(N_THREADS);
+
+    const PiercedVector<long> &constContainer = container;
+    const PiercedStorage<double> &constStorage = storage;
+    const PiercedKernel<long> &kernel = container.getKernel();
+
+    std::atomic<int> nErrors(0);
+    utils::threads::parallelFor(N_TASKS, [&](std::size_t task) {
+        // Lookups
+        for (long id = static_cast<long>(task); id < N_ELEMENTS; id += 3) {
+            bool expectedExists = (id % 7 != 3);
+            if (constContainer.exists(id) != expectedExists || (kernel.count(id) > 0) != expectedExists) {
+                ++nErrors;
+                continue;
+            }
+
+            if (!expectedExists) {
+                if (constContainer.find(id) != constContainer.cend()) {
+                    ++nErrors;
+                }
+                continue;
+            }
+
+            if (*(constContainer.find(id)) != id || constContainer.at(id) != id) {
+                ++nErrors;
+            }
+
+            std::size_t rawIndex = kernel.getRawIndex(id);
+            if (constStorage.rawAt(rawIndex, 1) != 10. * id + 1) {
+                ++nErrors;
+            }
+        }
+
+        // Iteration over the whole container
+        long nIterated = 0;
+        long sum = 0;
+        for (auto itr = constContainer.cbegin(); itr != constContainer.cend(); ++itr) {
+            ++nIterated;
+            sum += *itr;
+            if (constStorage.at(itr.getId(), 0) != 10. * itr.getId()) {
+                ++nErrors;
+            }
+        }
+
+        if (nIterated != nElements || sum != expectedSum) {
+            ++nErrors;
+        }
+
+        // Iteration over the ranges
+        long nRangeIterated = 0;
+        for (const auto &range : constStorage.split(task % 5 + 1)) {
+            for (auto itr = range.cbegin(); itr != range.cend(); ++itr) {
+                ++nRangeIterated;
+            }
+        }
+
+        if (nRangeIterated != nElements) {
+            ++nErrors;
+        }
+
+        // Creation of storages associated with the container
+        PiercedStorage<long> localStorage(1, &kernel, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+        for (long id : kernel.getIds(false)) {
+            localStorage.at(id) = id;
+        }
+
+        for (long id = static_cast<long>(task); id < N_ELEMENTS; id += 11) {
+            if (id % 7 != 3 && localStorage.at(id) != id) {
+                ++nErrors;
+            }
+        }
+    });
+
+    std::cout << "  Number of errors .............. " << nErrors << std::endl;
+
+    if (nErrors > 0) {
+        throw std::runtime_error("Concurrent queries returned wrong results");
+    }
+
+    // The containers should not have been modified
+    if (container.getKernel().isIteratorSlow() != isIteratorSlow) {
+        throw std::runtime_error("Concurrent queries modified the container");
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing concurrent read access to pierced containers" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
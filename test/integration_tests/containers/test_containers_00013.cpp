@@ -0,0 +1,255 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include "bitpit_containers.hpp"
+
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include <memory>
+#include <stdexcept>
+
+using namespace bitpit;
+
+/*!
+* Checks that the storage is synchronized with the specified kernel.
+*
+* \param kernel is the kernel
+* \param storage is the storage
+*/
+void checkStorageSync(const PiercedKernel<long> &kernel, const PiercedStorage<long> &storage)
+{
+    if (storage.getKernel() != &kernel) {
+        throw std::runtime_error("Storage is not bound to the expected kernel");
+    }
+
+    for (long id : kernel.getIds(false)) {
+        if (storage.at(id) != 10 * id) {
+            throw std::runtime_error("Storage contains wrong values");
+        }
+    }
+}
+
+/*!
+* Subtest 001
+*
+* Testing that copying a vector doesn't copy the storages registered to it.
+*/
+int subtest_001()
+{
+    std::cout << std::endl;
+    std::cout << "Testing vector copy" << std::endl;
+
+    PiercedVector<long> vector;
+    PiercedStorage<long> storage(1, &vector, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    for (long id = 0; id < 10; ++id) {
+        vector.emplace(id, id);
+        storage.at(id) = 10 * id;
+    }
+
+    // Create a copy, alter it and destroy it
+    //
+    // The storage is registered only to the original vector, altering or
+    // destroying the copy should not affect the storage.
+    {
+        PiercedVector<long> vectorCopy(vector);
+        if (vectorCopy.size() != vector.size()) {
+            throw std::runtime_error("Copied vector has a wrong size");
+        }
+
+        for (long id = 100; id < 200; ++id) {
+            vectorCopy.emplace(id, id);
+        }
+        vectorCopy.erase(5);
+        vectorCopy.squeeze();
+    }
+
+    checkStorageSync(vector.getKernel(), storage);
+
+    // The storage should still follow the original vector
+    for (long id = 10; id < 20; ++id) {
+        vector.emplace(id, id);
+        storage.at(id) = 10 * id;
+    }
+
+    checkStorageSync(vector.getKernel(), storage);
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Testing that moving a vector doesn't move the storages registered to it.
+*/
+int subtest_002()
+{
+    std::cout << std::endl;
+    std::cout << "Testing vector move" << std::endl;
+
+    std::unique_ptr<PiercedVector<long>> vector(new PiercedVector<long>());
+    PiercedStorage<long> storage(1, vector.get(), PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    for (long id = 0; id < 10; ++id) {
+        vector->emplace(id, id);
+        storage.at(id) = 10 * id;
+    }
+
+    // Move the vector
+    //
+    // Storages keep pointing to the kernel they have been registered to.
+    std::unique_ptr<PiercedVector<long>> movedVector(new PiercedVector<long>(std::move(*vector)));
+    if (movedVector->size() != 10) {
+        throw std::runtime_error("Moved vector has a wrong size");
+    }
+
+    for (long id = 100; id < 200; ++id) {
+        movedVector->emplace(id, id);
+    }
+
+    if (storage.getKernel() != &(vector->getKernel())) {
+        throw std::runtime_error("Storage has been moved to the new vector");
+    }
+
+    // Destroying the moved vector should not detach the storage
+    movedVector.reset();
+    if (storage.getKernel() != &(vector->getKernel())) {
+        throw std::runtime_error("Storage has been detached by the moved vector");
+    }
+
+    // Destroying the original vector detaches the storage
+    vector.reset();
+    if (storage.getKernel()) {
+        throw std::runtime_error("Storage has not been detached by its vector");
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 003
+*
+* Testing copy and move of pierced vectors that are copies of other vectors.
+*/
+int subtest_003()
+{
+    std::cout << std::endl;
+    std::cout << "Testing chained vector copy and move" << std::endl;
+
+    PiercedVector<long> vector;
+    PiercedStorage<long> storage(1, &vector, PiercedSyncMaster::SYNC_MODE_CONCURRENT);
+    for (long id = 0; id < 10; ++id) {
+        vector.emplace(id, id);
+        storage.at(id) = 10 * id;
+    }
+
+    // Copy and destroy the copy
+    {
+        PiercedVector<long> vectorCopy(vector);
+        vectorCopy.emplace(100, 100);
+        vectorCopy.erase(3);
+        if (vectorCopy.size() != 10 || vectorCopy.at(100) != 100) {
+            throw std::runtime_error("Copied vector has wrong contents");
+        }
+
+        // Further copies and moves should not be affected by the storages
+        // of the original vector.
+        PiercedVector<long> vectorMove(std::move(vectorCopy));
+        vectorMove.emplace(200, 200);
+        if (vectorMove.size() != 11 || vectorMove.at(200) != 200) {
+            throw std::runtime_error("Moved vector has wrong contents");
+        }
+    }
+
+    if (vector.size() != 10 || !vector.exists(3) || vector.exists(100)) {
+        throw std::runtime_error("Original vector has been modified");
+    }
+
+    checkStorageSync(vector.getKernel(), storage);
+
+    // The original vector and its storage should still work together
+    for (long id = 10; id < 20; ++id) {
+        vector.emplace(id, id);
+        storage.at(id) = 10 * id;
+    }
+    vector.erase(5);
+    vector.squeeze();
+
+    checkStorageSync(vector.getKernel(), storage);
+    for (long id : vector.getIds()) {
+        if (vector.at(id) != id) {
+            throw std::runtime_error("Original vector contains wrong values");
+        }
+    }
+
+    std::cout << "Test completed." << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Run the subtests
+    std::cout << "Testing copy and move of pierced synchronization masters" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_003();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        std::cout << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
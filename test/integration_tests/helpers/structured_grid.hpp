@@ -0,0 +1,176 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_TEST_HELPERS_STRUCTURED_GRID__
+#define __BITPIT_TEST_HELPERS_STRUCTURED_GRID__
+
+/*!
+ * \file structured_grid.hpp
+ *
+ * \brief Creation of structured grids inside unstructured patches.
+ *
+ * The grid covers the unit square (or the unit cube, for three-dimensional
+ * patches) and has the same number of cells along each direction. Both
+ * vertices and cells are numbered using their position in the grid, hence
+ * the ids of the cells that contain a given point can be evaluated without
+ * looking at the patch.
+ */
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "bitpit_patchkernel.hpp"
+
+/*!
+ * Evaluates the id of the specified vertex of a structured grid.
+ *
+ * \param n is the number of cells along each direction
+ * \param i is the index of the vertex along the x direction
+ * \param j is the index of the vertex along the y direction
+ * \param k is the index of the vertex along the z direction
+ * \result The id of the specified vertex.
+ */
+inline long getStructuredGridVertexId(int n, int i, int j, int k)
+{
+    return long(i + (n + 1) * (j + (n + 1) * k));
+}
+
+/*!
+ * Evaluates the id of the specified cell of a structured grid.
+ *
+ * \param n is the number of cells along each direction
+ * \param i is the index of the cell along the x direction
+ * \param j is the index of the cell along the y direction
+ * \param k is the index of the cell along the z direction
+ * \result The id of the specified cell.
+ */
+inline long getStructuredGridCellId(int n, int i, int j, int k)
+{
+    return long(i + n * (j + n * k));
+}
+
+/*!
+ * Creates a structured grid stored in an unstructured patch.
+ *
+ * The dimension of the grid is the dimension of the patch, two-dimensional
+ * grids lie on the z = 0 plane. Cells can be hexahedra or voxels in three
+ * dimensions and quadrilaterals or pixels in two dimensions.
+ *
+ * \param n is the number of cells along each direction
+ * \param cellType is the type of the cells
+ * \param patch is the patch that will be filled
+ */
+inline void createStructuredGrid(int n, bitpit::ElementType cellType, bitpit::PatchKernel *patch)
+{
+    using bitpit::ElementType;
+
+    int dimension = patch->getDimension();
+    int nz = (dimension == 3) ? n : 0;
+
+    double h = 1. / n;
+    for (int k = 0; k <= nz; ++k) {
+        for (int j = 0; j <= n; ++j) {
+            for (int i = 0; i <= n; ++i) {
+                patch->addVertex({{i * h, j * h, k * h}}, getStructuredGridVertexId(n, i, j, k));
+            }
+        }
+    }
+
+    auto vertexId = [n](int i, int j, int k) {
+        return getStructuredGridVertexId(n, i, j, k);
+    };
+
+    for (int k = 0; k < std::max(nz, 1); ++k) {
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                std::vector<long> connect;
+                switch (cellType) {
+
+                case ElementType::HEXAHEDRON:
+                    connect = {{
+                        vertexId(i,     j,     k), vertexId(i + 1, j,     k),
+                        vertexId(i + 1, j + 1, k), vertexId(i,     j + 1, k),
+                        vertexId(i,     j,     k + 1), vertexId(i + 1, j,     k + 1),
+                        vertexId(i + 1, j + 1, k + 1), vertexId(i,     j + 1, k + 1)
+                    }};
+                    break;
+
+                case ElementType::VOXEL:
+                    connect = {{
+                        vertexId(i,     j,     k), vertexId(i + 1, j,     k),
+                        vertexId(i,     j + 1, k), vertexId(i + 1, j + 1, k),
+                        vertexId(i,     j,     k + 1), vertexId(i + 1, j,     k + 1),
+                        vertexId(i,     j + 1, k + 1), vertexId(i + 1, j + 1, k + 1)
+                    }};
+                    break;
+
+                case ElementType::QUAD:
+                    connect = {{
+                        vertexId(i,     j,     0), vertexId(i + 1, j,     0),
+                        vertexId(i + 1, j + 1, 0), vertexId(i,     j + 1, 0)
+                    }};
+                    break;
+
+                case ElementType::PIXEL:
+                    connect = {{
+                        vertexId(i,     j,     0), vertexId(i + 1, j,     0),
+                        vertexId(i,     j + 1, 0), vertexId(i + 1, j + 1, 0)
+                    }};
+                    break;
+
+                default:
+                    throw std::runtime_error("Cell type not supported by structured grids.");
+
+                }
+
+                patch->addCell(cellType, connect, getStructuredGridCellId(n, i, j, k));
+            }
+        }
+    }
+}
+
+/*!
+ * Creates a structured grid stored in an unstructured patch.
+ *
+ * Cells are hexahedra for three-dimensional patches and quadrilaterals for
+ * two-dimensional patches.
+ *
+ * \param n is the number of cells along each direction
+ * \param patch is the patch that will be filled
+ */
+inline void createStructuredGrid(int n, bitpit::PatchKernel *patch)
+{
+    bitpit::ElementType cellType;
+    if (patch->getDimension() == 3) {
+        cellType = bitpit::ElementType::HEXAHEDRON;
+    } else {
+        cellType = bitpit::ElementType::QUAD;
+    }
+
+    createStructuredGrid(n, cellType, patch);
+}
+
+#endif
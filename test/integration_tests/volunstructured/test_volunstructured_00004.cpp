@@ -0,0 +1,245 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Checks the parallel iteration over the items of a patch using the
+* specified threading backend.
+*
+* \param patch is the patch
+* \param backend is the threading backend
+* \param nThreads is the number of threads
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkParallelFor(VolUnstructured &patch, utils::threads::Backend backend, int nThreads)
+{
+    utils::threads::setBackend(backend);
+    utils::threads::setThreadCount(nThreads);
+
+    log::cout() << std::endl;
+    log::cout() << " Backend " << backend << " with " << utils::threads::getThreadCount() << " threads..." << std::endl;
+
+    // Cells
+    PiercedStorage<std::array<double, 3>, long> centroids(1, &patch.getCells());
+    std::atomic<long> nProcessedCells(0);
+
+    const VolUnstructured &constPatch = patch;
+    constPatch.parallelForCells([&patch, &centroids, &nProcessedCells](const Cell &cell) {
+        long cellId = cell.getId();
+        centroids[cellId] = patch.evalCellCentroid(cellId);
+        ++nProcessedCells;
+    });
+
+    if (nProcessedCells != patch.getCellCount()) {
+        log::cout() << "   Not all the cells have been processed!" << std::endl;
+        return 1;
+    }
+
+    for (const Cell &cell : patch.getCells()) {
+        long cellId = cell.getId();
+        std::array<double, 3> expectedCentroid = patch.evalCellCentroid(cellId);
+        if (!utils::DoubleFloatingEqual()(norm2(centroids[cellId] - expectedCentroid), 0.)) {
+            log::cout() << "   Centroid of cell " << cellId << " doesn't match the expected value!" << std::endl;
+            return 1;
+        }
+    }
+
+    log::cout() << "   Cell centroids evaluated correctly" << std::endl;
+
+    // Vertices
+    std::array<double, 3> offset = {{1., 2., 3.}};
+    patch.parallelForVertices([&offset](Vertex &vertex) {
+        vertex.translate(offset);
+    });
+    patch.parallelForVertices([&offset](Vertex &vertex) {
+        vertex.translate(- 1. * offset);
+    });
+
+    std::atomic<long> nProcessedVertices(0);
+    std::atomic<long> nMovedVertices(0);
+    constPatch.parallelForVertices([&nProcessedVertices, &nMovedVertices](const Vertex &vertex) {
+        const std::array<double, 3> &coords = vertex.getCoords();
+        for (int d = 0; d < 3; ++d) {
+            if (coords[d] < -1e-12 || coords[d] > 1. + 1e-12) {
+                ++nMovedVertices;
+                break;
+            }
+        }
+        ++nProcessedVertices;
+    });
+
+    if (nProcessedVertices != patch.getVertexCount()) {
+        log::cout() << "   Not all the vertices have been processed!" << std::endl;
+        return 1;
+    } else if (nMovedVertices != 0) {
+        log::cout() << "   Vertices have not been updated correctly!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << "   Vertices updated correctly" << std::endl;
+
+    // Interfaces
+    std::atomic<long> nBorderInterfaces(0);
+    constPatch.parallelForInterfaces([&nBorderInterfaces](const Interface &interface) {
+        if (interface.isBorder()) {
+            ++nBorderInterfaces;
+        }
+    });
+
+    long expectedBorderInterfaces = 0;
+    for (const Interface &interface : patch.getInterfaces()) {
+        if (interface.isBorder()) {
+            ++expectedBorderInterfaces;
+        }
+    }
+
+    if (nBorderInterfaces != expectedBorderInterfaces) {
+        log::cout() << "   Border interfaces don't match the expected value!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << "   Interfaces processed correctly" << std::endl;
+
+    // Exceptions thrown by the function are propagated to the caller
+    bool exceptionCaught = false;
+    try {
+        constPatch.parallelForCells([](const Cell &cell) {
+            if (cell.getId() == 100) {
+                throw std::runtime_error("Test exception");
+            }
+        });
+    } catch (const std::runtime_error &exception) {
+        BITPIT_UNUSED(exception);
+        exceptionCaught = true;
+    }
+
+    if (!exceptionCaught) {
+        log::cout() << "   Exception has not been propagated!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << "   Exceptions propagated correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing parallel iteration over the items of a 3D unstructured patch.
+*/
+int subtest_001()
+{
+    // Create the patch
+    log::cout() << std::endl;
+    log::cout() << "Creating 3D patch..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(3, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(3);
+#endif
+    createStructuredGrid(24, &patch);
+
+    // Delete some cells, in order to have holes in the containers
+    std::vector<long> deletedCells;
+    for (long cellId = 0; cellId < patch.getCellCount(); cellId += 7) {
+        deletedCells.push_back(cellId);
+    }
+    patch.deleteCells(deletedCells);
+
+    patch.initializeAdjacencies();
+    patch.initializeInterfaces();
+
+    log::cout() << " Number of cells: " << patch.getCellCount() << std::endl;
+
+    // Check the backends
+    int status;
+
+    status = checkParallelFor(patch, utils::threads::BACKEND_SERIAL, 1);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkParallelFor(patch, utils::threads::BACKEND_THREAD_POOL, 4);
+    if (status != 0) {
+        return status;
+    }
+
+    if (utils::threads::isBackendAvailable(utils::threads::BACKEND_OPENMP)) {
+        status = checkParallelFor(patch, utils::threads::BACKEND_OPENMP, 4);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing parallel iteration over patch items" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
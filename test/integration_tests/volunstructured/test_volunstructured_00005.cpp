@@ -0,0 +1,493 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Checks if the connectivity of the cells of the patch matches the
+* specified reference connectivity.
+*
+* \param patch is the patch
+* \param expectedConnects is the reference connectivity
+* \param inArena controls if the connectivity is expected to be stored
+* in the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkConnectivity(const VolUnstructured &patch, const std::unordered_map<long, std::vector<long>> &expectedConnects, bool inArena)
+{
+    if (patch.getCellCount() != (long) expectedConnects.size()) {
+        log::cout() << "   Number of cells doesn't match the expected value!" << std::endl;
+        return 1;
+    }
+
+    for (const Cell &cell : patch.getCells()) {
+        if (cell.hasArenaConnect() != inArena) {
+            log::cout() << "   Storage of cell " << cell.getId() << " connectivity doesn't match the expected one!" << std::endl;
+            return 1;
+        }
+
+        const std::vector<long> &expectedConnect = expectedConnects.at(cell.getId());
+        if (cell.getConnectSize() != (int) expectedConnect.size()) {
+            log::cout() << "   Connectivity size of cell " << cell.getId() << " doesn't match the expected value!" << std::endl;
+            return 1;
+        }
+
+        const long *connect = cell.getConnect();
+        for (int k = 0; k < cell.getConnectSize(); ++k) {
+            if (connect[k] != expectedConnect[k]) {
+                log::cout() << "   Connectivity of cell " << cell.getId() << " doesn't match the expected value!" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Checks if the adjacencies and the interfaces of the cells of the patch
+* match those of the specified reference patch.
+*
+* \param patch is the patch
+* \param reference is the reference patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkNeighbourhood(const VolUnstructured &patch, const VolUnstructured &reference)
+{
+    if (patch.getCellCount() != reference.getCellCount()) {
+        log::cout() << "   Number of cells doesn't match the expected value!" << std::endl;
+        return 1;
+    }
+
+    if (patch.getInterfaceCount() != reference.getInterfaceCount()) {
+        log::cout() << "   Number of interfaces doesn't match the expected value!" << std::endl;
+        return 1;
+    }
+
+    for (const Cell &cell : patch.getCells()) {
+        long cellId = cell.getId();
+        const Cell &referenceCell = reference.getCell(cellId);
+
+        int nCellFaces = cell.getFaceCount();
+        for (int face = 0; face < nCellFaces; ++face) {
+            int nFaceAdjacencies = cell.getAdjacencyCount(face);
+            if (nFaceAdjacencies != referenceCell.getAdjacencyCount(face)) {
+                log::cout() << "   Number of adjacencies of cell " << cellId << " doesn't match the expected value!" << std::endl;
+                return 1;
+            }
+
+            for (int k = 0; k < nFaceAdjacencies; ++k) {
+                if (cell.getAdjacency(face, k) != referenceCell.getAdjacency(face, k)) {
+                    log::cout() << "   Adjacencies of cell " << cellId << " don't match the expected value!" << std::endl;
+                    return 1;
+                }
+            }
+
+            int nFaceInterfaces = cell.getInterfaceCount(face);
+            if (nFaceInterfaces != referenceCell.getInterfaceCount(face)) {
+                log::cout() << "   Number of interfaces of cell " << cellId << " doesn't match the expected value!" << std::endl;
+                return 1;
+            }
+
+            for (int k = 0; k < nFaceInterfaces; ++k) {
+                if (cell.getInterface(face, k) != referenceCell.getInterface(face, k)) {
+                    log::cout() << "   Interfaces of cell " << cellId << " don't match the expected value!" << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    for (const Interface &interface : patch.getInterfaces()) {
+        long interfaceId = interface.getId();
+        const Interface &referenceInterface = reference.getInterface(interfaceId);
+        if (interface.getOwner() != referenceInterface.getOwner() || interface.getNeigh() != referenceInterface.getNeigh()) {
+            log::cout() << "   Cells of interface " << interfaceId << " don't match the expected value!" << std::endl;
+            return 1;
+        }
+
+        const long *connect = interface.getConnect();
+        const long *referenceConnect = referenceInterface.getConnect();
+        for (int k = 0; k < interface.getConnectSize(); ++k) {
+            if (connect[k] != referenceConnect[k]) {
+                log::cout() << "   Connectivity of interface " << interfaceId << " doesn't match the expected value!" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Checks if the adjacencies and the interfaces of the cells of the patch
+* are stored in contiguous memory areas.
+*
+* Each cell stores, along with its items, the number of its faces and the
+* offsets of the items of its faces. All the data should be contained in
+* a memory area whose size is not larger than the size of that data.
+*
+* \param patch is the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkNeighbourhoodContiguity(const VolUnstructured &patch)
+{
+    const long *adjacenciesBegin = nullptr;
+    const long *adjacenciesEnd   = nullptr;
+    std::size_t adjacenciesSize  = 0;
+
+    const long *interfacesBegin = nullptr;
+    const long *interfacesEnd   = nullptr;
+    std::size_t interfacesSize  = 0;
+
+    for (const Cell &cell : patch.getCells()) {
+        int nCellFaces = cell.getFaceCount();
+
+        const long *adjacencies = cell.getAdjacencies();
+        int nAdjacencies = cell.getAdjacencyCount();
+        if (!adjacenciesBegin || adjacencies < adjacenciesBegin) {
+            adjacenciesBegin = adjacencies;
+        }
+        if (!adjacenciesEnd || adjacencies + nAdjacencies > adjacenciesEnd) {
+            adjacenciesEnd = adjacencies + nAdjacencies;
+        }
+        adjacenciesSize += 2 + nCellFaces + nAdjacencies;
+
+        const long *interfaces = cell.getInterfaces();
+        int nInterfaces = cell.getInterfaceCount();
+        if (!interfacesBegin || interfaces < interfacesBegin) {
+            interfacesBegin = interfaces;
+        }
+        if (!interfacesEnd || interfaces + nInterfaces > interfacesEnd) {
+            interfacesEnd = interfaces + nInterfaces;
+        }
+        interfacesSize += 2 + nCellFaces + nInterfaces;
+    }
+
+    if (static_cast<std::size_t>(adjacenciesEnd - adjacenciesBegin) > adjacenciesSize) {
+        log::cout() << "   Adjacencies are not stored contiguously!" << std::endl;
+        return 1;
+    }
+
+    if (static_cast<std::size_t>(interfacesEnd - interfacesBegin) > interfacesSize) {
+        log::cout() << "   Interfaces are not stored contiguously!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing storage of the connectivity in the patch.
+*/
+int subtest_001()
+{
+    // Create the patch
+    log::cout() << std::endl;
+    log::cout() << "Creating 3D patch..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(3, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(3);
+#endif
+    patch.setConnectivityStorageMode(PatchKernel::CONNECTIVITY_STORAGE_PATCH);
+    createStructuredGrid(8, &patch);
+    patch.update();
+
+    std::unordered_map<long, std::vector<long>> expectedConnects;
+    for (const Cell &cell : patch.getCells()) {
+        const long *connect = cell.getConnect();
+        expectedConnects[cell.getId()].assign(connect, connect + cell.getConnectSize());
+    }
+
+    log::cout() << " Checking connectivity of the new patch..." << std::endl;
+    if (checkConnectivity(patch, expectedConnects, true) != 0) {
+        return 1;
+    }
+
+    // Delete some cells and add new polyhedral cells
+    //
+    // Adding cells should not move the connectivity of existing cells.
+    log::cout() << " Checking connectivity after deleting and adding cells..." << std::endl;
+    const long lastCellId = patch.getCells().back().getId();
+    const long *lastCellConnect = patch.getCell(lastCellId).getConnect();
+    for (long cellId = 0; cellId < 100; cellId += 3) {
+        const long *connect = patch.getCell(cellId).getConnect();
+
+        std::unique_ptr<long[]> connectStorage = std::unique_ptr<long[]>(new long[31]);
+        long *polyConnect = connectStorage.get();
+        polyConnect[0] = 6;
+        int faces[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4}, {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+        for (int f = 0; f < 6; ++f) {
+            polyConnect[1 + 5 * f] = 4;
+            for (int k = 0; k < 4; ++k) {
+                polyConnect[1 + 5 * f + 1 + k] = connect[faces[f][k]];
+            }
+        }
+
+        patch.deleteCell(cellId);
+        expectedConnects.erase(cellId);
+
+        long polyId = patch.addCell(ElementType::POLYHEDRON, std::move(connectStorage)).getId();
+        const Cell &polyCell = patch.getCell(polyId);
+        expectedConnects[polyId].assign(polyCell.getConnect(), polyCell.getConnect() + polyCell.getConnectSize());
+    }
+
+    if (patch.getCell(lastCellId).getConnect() != lastCellConnect) {
+        log::cout() << "   Connectivity of existing cells has been moved!" << std::endl;
+        return 1;
+    }
+
+    patch.update();
+    if (checkConnectivity(patch, expectedConnects, true) != 0) {
+        return 1;
+    }
+
+    // Squeeze the patch, the connectivity should be stored contiguously
+    log::cout() << " Checking connectivity after squeezing the patch..." << std::endl;
+    patch.squeeze();
+    if (checkConnectivity(patch, expectedConnects, true) != 0) {
+        return 1;
+    }
+
+    const long *expectedConnect = nullptr;
+    for (const Cell &cell : patch.getCells()) {
+        if (expectedConnect && cell.getConnect() != expectedConnect) {
+            log::cout() << "   Connectivity is not stored contiguously!" << std::endl;
+            return 1;
+        }
+        expectedConnect = cell.getConnect() + cell.getConnectSize();
+    }
+
+    // Copy the patch
+    log::cout() << " Checking connectivity of a copy of the patch..." << std::endl;
+    std::unique_ptr<VolUnstructured> patchCopy = PatchKernel::clone(&patch);
+    if (checkConnectivity(*patchCopy, expectedConnects, true) != 0) {
+        return 1;
+    }
+
+    for (const Cell &cell : patchCopy->getCells()) {
+        if (cell.getConnect() == patch.getCell(cell.getId()).getConnect()) {
+            log::cout() << "   Copied patch shares the connectivity with the original patch!" << std::endl;
+            return 1;
+        }
+    }
+
+    // Store the connectivity in the elements
+    log::cout() << " Checking connectivity after releasing the arenas..." << std::endl;
+    patch.setConnectivityStorageMode(PatchKernel::CONNECTIVITY_STORAGE_ELEMENT);
+    if (checkConnectivity(patch, expectedConnects, false) != 0) {
+        return 1;
+    }
+
+    // Interfaces
+    log::cout() << " Checking connectivity of the interfaces..." << std::endl;
+    patchCopy->initializeAdjacencies();
+    patchCopy->initializeInterfaces();
+    for (const Interface &interface : patchCopy->getInterfaces()) {
+        if (!interface.hasArenaConnect()) {
+            log::cout() << "   Connectivity of interface " << interface.getId() << " is not stored in the patch!" << std::endl;
+            return 1;
+        }
+    }
+
+    log::cout() << " Connectivity checked correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Testing storage of the adjacencies and of the interfaces in the patch.
+*/
+int subtest_002()
+{
+    // Create the patches
+    //
+    // The reference patch stores the data in the elements.
+    log::cout() << std::endl;
+    log::cout() << "Creating 3D patches..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(3, MPI_COMM_NULL);
+    VolUnstructured reference(3, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(3);
+    VolUnstructured reference(3);
+#endif
+    patch.setConnectivityStorageMode(PatchKernel::CONNECTIVITY_STORAGE_PATCH);
+    for (VolUnstructured *target : {&patch, &reference}) {
+        createStructuredGrid(6, target);
+        target->initializeAdjacencies();
+        target->initializeInterfaces();
+        target->update();
+    }
+
+    log::cout() << " Checking adjacencies and interfaces of the new patch..." << std::endl;
+    if (checkNeighbourhood(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Delete some cells
+    //
+    // The adjacencies and the interfaces of the neighbours of the deleted
+    // cells are updated.
+    log::cout() << " Checking adjacencies and interfaces after deleting cells..." << std::endl;
+    for (VolUnstructured *target : {&patch, &reference}) {
+        for (long cellId = 0; cellId < 100; cellId += 3) {
+            target->deleteCell(cellId);
+        }
+        target->update();
+    }
+
+    if (checkNeighbourhood(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Copy the patch while it contains deleted cells
+    //
+    // Deleted cells are kept by the container until it is squeezed, they
+    // should not reference the arenas that are re-created when switching
+    // the storage mode.
+    log::cout() << " Checking adjacencies and interfaces of a copy of the patch with deleted cells..." << std::endl;
+    patch.setConnectivityStorageMode(PatchKernel::CONNECTIVITY_STORAGE_ELEMENT);
+    patch.setConnectivityStorageMode(PatchKernel::CONNECTIVITY_STORAGE_PATCH);
+    std::unique_ptr<VolUnstructured> piercedPatchCopy = PatchKernel::clone(&patch);
+    if (checkNeighbourhood(*piercedPatchCopy, reference) != 0) {
+        return 1;
+    }
+
+    // Squeeze the patch, the data should be stored contiguously
+    log::cout() << " Checking adjacencies and interfaces after squeezing the patch..." << std::endl;
+    patch.squeeze();
+    if (checkNeighbourhood(patch, reference) != 0) {
+        return 1;
+    }
+
+    if (checkNeighbourhoodContiguity(patch) != 0) {
+        return 1;
+    }
+
+    // Alter the adjacencies of a cell
+    //
+    // Altering the adjacencies of a cell should not alter the adjacencies
+    // of the other cells.
+    log::cout() << " Checking adjacencies after altering the adjacencies of a cell..." << std::endl;
+    long alteredCellId = patch.getCells().begin()->getId();
+    long fakeAdjacencyId = reference.getCells().back().getId();
+    for (VolUnstructured *target : {&patch, &reference}) {
+        Cell &alteredCell = target->getCell(alteredCellId);
+        for (int face = 0; face < alteredCell.getFaceCount(); ++face) {
+            if (alteredCell.getAdjacencyCount(face) > 0) {
+                alteredCell.setAdjacency(face, 0, fakeAdjacencyId);
+                break;
+            }
+        }
+        alteredCell.pushAdjacency(0, fakeAdjacencyId);
+    }
+
+    if (checkNeighbourhood(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Copy the patch
+    log::cout() << " Checking adjacencies and interfaces of a copy of the patch..." << std::endl;
+    std::unique_ptr<VolUnstructured> patchCopy = PatchKernel::clone(&patch);
+    if (checkNeighbourhood(*patchCopy, reference) != 0) {
+        return 1;
+    }
+
+    for (const Cell &cell : patchCopy->getCells()) {
+        if (cell.getAdjacencies() == patch.getCell(cell.getId()).getAdjacencies()) {
+            log::cout() << "   Copied patch shares the adjacencies with the original patch!" << std::endl;
+            return 1;
+        }
+    }
+
+    // Store the data in the elements
+    log::cout() << " Checking adjacencies and interfaces after releasing the arenas..." << std::endl;
+    patch.setConnectivityStorageMode(PatchKernel::CONNECTIVITY_STORAGE_ELEMENT);
+    if (checkNeighbourhood(patch, reference) != 0) {
+        return 1;
+    }
+
+    log::cout() << " Adjacencies and interfaces checked correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing storage of the connectivity, adjacencies and interfaces in the patch" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
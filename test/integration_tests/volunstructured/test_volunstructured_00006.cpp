@@ -0,0 +1,187 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <algorithm>
+#include <map>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Gets the adjacencies of the patch.
+*
+* \param patch is the patch
+* \result The adjacencies of the patch, for each face of each cell the
+* sorted list of adjacencies is returned.
+*/
+std::map<std::pair<long, int>, std::vector<long>> getAdjacencies(const VolUnstructured &patch)
+{
+    std::map<std::pair<long, int>, std::vector<long>> adjacencies;
+    for (const Cell &cell : patch.getCells()) {
+        int nCellFaces = cell.getFaceCount();
+        for (int face = 0; face < nCellFaces; ++face) {
+            std::vector<long> &faceAdjacencies = adjacencies[std::make_pair(cell.getId(), face)];
+
+            int nFaceAdjacencies = cell.getAdjacencyCount(face);
+            const long *cellFaceAdjacencies = cell.getAdjacencies(face);
+            faceAdjacencies.assign(cellFaceAdjacencies, cellFaceAdjacencies + nFaceAdjacencies);
+            std::sort(faceAdjacencies.begin(), faceAdjacencies.end());
+        }
+    }
+
+    return adjacencies;
+}
+
+/*!
+* Checks the adjacencies built sorting the half-faces of the cells.
+*
+* \param dimension is the dimension of the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkSortedAdjacencies(int dimension)
+{
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patch..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(dimension);
+#endif
+    createStructuredGrid((dimension == 3) ? 24 : 128, &patch);
+
+    // Build the adjacencies with the default strategy
+    log::cout() << " Building reference adjacencies..." << std::endl;
+    patch.initializeAdjacencies(PatchKernel::ADJACENCIES_AUTOMATIC);
+    std::map<std::pair<long, int>, std::vector<long>> expectedAdjacencies = getAdjacencies(patch);
+
+    // Build the adjacencies sorting the half-faces
+    log::cout() << " Building adjacencies sorting the half-faces..." << std::endl;
+    patch.initializeAdjacencies(PatchKernel::ADJACENCIES_SORTED);
+    if (getAdjacencies(patch) != expectedAdjacencies) {
+        log::cout() << "   Adjacencies don't match the expected ones!" << std::endl;
+        return 1;
+    }
+
+    // Update the adjacencies after deleting and adding cells
+    log::cout() << " Updating adjacencies sorting the half-faces..." << std::endl;
+    std::vector<long> deletedCells;
+    for (long cellId = 0; cellId < patch.getCellCount(); cellId += 5) {
+        deletedCells.push_back(cellId);
+    }
+
+    std::vector<std::pair<ElementType, std::vector<long>>> deletedCellsData;
+    for (long cellId : deletedCells) {
+        const Cell &cell = patch.getCell(cellId);
+        ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+        deletedCellsData.emplace_back(cell.getType(), std::vector<long>(cellVertexIds.begin(), cellVertexIds.end()));
+    }
+    patch.deleteCells(deletedCells);
+    patch.updateAdjacencies();
+
+    for (std::size_t n = 0; n < deletedCells.size() / 2; ++n) {
+        patch.addCell(deletedCellsData[n].first, deletedCellsData[n].second);
+    }
+    patch.updateAdjacencies();
+
+    std::map<std::pair<long, int>, std::vector<long>> updatedAdjacencies = getAdjacencies(patch);
+
+    patch.initializeAdjacencies(PatchKernel::ADJACENCIES_AUTOMATIC);
+    if (updatedAdjacencies != getAdjacencies(patch)) {
+        log::cout() << "   Updated adjacencies don't match the expected ones!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << " Adjacencies built correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing adjacencies built sorting the half-faces of the cells.
+*/
+int subtest_001()
+{
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    int status;
+
+    status = checkSortedAdjacencies(2);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkSortedAdjacencies(3);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing adjacencies built sorting the half-faces" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
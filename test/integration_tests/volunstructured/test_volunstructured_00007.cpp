@@ -0,0 +1,296 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+typedef std::tuple<long, int, long, int, std::vector<long>> InterfaceInfo;
+
+/*!
+* Adds an isolated cell to the patch.
+*
+* The cell is placed away from the structured grid, its id and the ids of
+* its vertices follow the ones of the grid.
+*
+* \param n is the number of cells along each direction of the grid
+* \param patch is the patch that will be filled
+* \result The id of the isolated cell.
+*/
+long addIsolatedCell(int n, VolUnstructured *patch)
+{
+    int dimension = patch->getDimension();
+    long nGridCells = (dimension == 3) ? long(n) * n * n : long(n) * n;
+    long vertexOffset = (dimension == 3) ? long(n + 1) * (n + 1) * (n + 1) : long(n + 1) * (n + 1);
+
+    patch->setVertexAutoIndexing(false);
+
+    int nVertices = (dimension == 3) ? 8 : 4;
+    for (int v = 0; v < nVertices; ++v) {
+        double x = 10. + (((v + 1) / 2) % 2);
+        double y = 10. + ((v / 2) % 2);
+        double z = (dimension == 3) ? 10. + (v / 4) : 0.;
+        patch->addVertex({{x, y, z}}, vertexOffset + v);
+    }
+
+    std::vector<long> connect(nVertices);
+    for (int v = 0; v < nVertices; ++v) {
+        connect[v] = vertexOffset + v;
+    }
+
+    ElementType type = (dimension == 3) ? ElementType::HEXAHEDRON : ElementType::QUAD;
+    patch->addCell(type, connect, nGridCells);
+
+    return nGridCells;
+}
+
+/*!
+* Gets the interfaces of the patch.
+*
+* Interfaces are described by owner, owner face, neighbour, neighbour face
+* and sorted connectivity, hence the description doesn't depend on the ids
+* of the interfaces. The function also checks that the interfaces of each
+* face are paired with the adjacencies of that face.
+*
+* \param patch is the patch
+* \param[out] interfaces on output will contain the interfaces of the patch
+* \result Returns true if the interfaces are consistent with the adjacencies,
+* false otherwise.
+*/
+bool getInterfaces(const VolUnstructured &patch, std::set<InterfaceInfo> *interfaces)
+{
+    interfaces->clear();
+    for (const Interface &interface : patch.getInterfaces()) {
+        ConstProxyVector<long> interfaceConnect = interface.getVertexIds();
+        std::vector<long> sortedConnect(interfaceConnect.begin(), interfaceConnect.end());
+        std::sort(sortedConnect.begin(), sortedConnect.end());
+
+        interfaces->emplace(interface.getOwner(), interface.getOwnerFace(),
+                            interface.getNeigh(), interface.getNeighFace(),
+                            std::move(sortedConnect));
+    }
+
+    for (const Cell &cell : patch.getCells()) {
+        long cellId = cell.getId();
+        int nCellFaces = cell.getFaceCount();
+        for (int face = 0; face < nCellFaces; ++face) {
+            int nFaceAdjacencies = cell.getAdjacencyCount(face);
+            int nFaceInterfaces  = cell.getInterfaceCount(face);
+            if (nFaceInterfaces != std::max(nFaceAdjacencies, 1)) {
+                return false;
+            }
+
+            for (int k = 0; k < nFaceInterfaces; ++k) {
+                const Interface &interface = patch.getInterface(cell.getInterface(face, k));
+                long pairedCellId = interface.getOwner();
+                if (pairedCellId == cellId) {
+                    pairedCellId = interface.getNeigh();
+                } else if (interface.getNeigh() != cellId) {
+                    return false;
+                }
+
+                long expectedCellId = Cell::NULL_ID;
+                if (nFaceAdjacencies > 0) {
+                    expectedCellId = cell.getAdjacency(face, k);
+                }
+
+                if (pairedCellId != expectedCellId) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/*!
+* Checks the interfaces built in bulk.
+*
+* \param dimension is the dimension of the patch
+* \param connectivityStorageMode is the connectivity storage mode
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkBulkInterfaces(int dimension, PatchKernel::ConnectivityStorageMode connectivityStorageMode)
+{
+    int n = (dimension == 3) ? 16 : 96;
+
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patches..." << std::endl;
+
+    // Build the reference interfaces incrementally
+    //
+    // The reference patch contains an isolated cell whose interfaces are
+    // built before adding the cells of the grid. Since the patch already
+    // contains some interfaces, the interfaces of the grid will be built
+    // incrementally.
+    log::cout() << " Building reference interfaces incrementally..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured referencePatch(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured referencePatch(dimension);
+#endif
+    long isolatedCellId = addIsolatedCell(n, &referencePatch);
+    referencePatch.initializeAdjacencies();
+    referencePatch.initializeInterfaces();
+    createStructuredGrid(n, &referencePatch);
+    referencePatch.update();
+    referencePatch.deleteCell(isolatedCellId);
+    referencePatch.update();
+
+    std::set<InterfaceInfo> expectedInterfaces;
+    if (!getInterfaces(referencePatch, &expectedInterfaces)) {
+        log::cout() << "   Reference interfaces are not paired with the adjacencies!" << std::endl;
+        return 1;
+    }
+
+    // Build the interfaces in bulk
+    log::cout() << " Building interfaces in bulk..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(dimension);
+#endif
+    patch.setConnectivityStorageMode(connectivityStorageMode);
+    createStructuredGrid(n, &patch);
+    patch.initializeAdjacencies();
+    patch.initializeInterfaces();
+
+    std::set<InterfaceInfo> interfaces;
+    if (!getInterfaces(patch, &interfaces)) {
+        log::cout() << "   Interfaces are not paired with the adjacencies!" << std::endl;
+        return 1;
+    }
+
+    if (interfaces != expectedInterfaces) {
+        log::cout() << "   Interfaces don't match the expected ones!" << std::endl;
+        return 1;
+    }
+
+    // Rebuild the interfaces after deleting some cells
+    log::cout() << " Rebuilding interfaces in bulk after deleting cells..." << std::endl;
+
+    std::vector<long> deletedCells;
+    for (long cellId = 0; cellId < patch.getCellCount(); cellId += 7) {
+        deletedCells.push_back(cellId);
+    }
+    patch.deleteCells(deletedCells);
+    referencePatch.deleteCells(deletedCells);
+
+    patch.update();
+    patch.initializeInterfaces();
+    if (!getInterfaces(patch, &interfaces)) {
+        log::cout() << "   Rebuilt interfaces are not paired with the adjacencies!" << std::endl;
+        return 1;
+    }
+
+    referencePatch.update();
+    getInterfaces(referencePatch, &expectedInterfaces);
+    if (interfaces != expectedInterfaces) {
+        log::cout() << "   Rebuilt interfaces don't match the expected ones!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << " Interfaces built correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing interfaces built in bulk.
+*/
+int subtest_001()
+{
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    int status;
+
+    status = checkBulkInterfaces(2, PatchKernel::CONNECTIVITY_STORAGE_ELEMENT);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkBulkInterfaces(3, PatchKernel::CONNECTIVITY_STORAGE_ELEMENT);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkBulkInterfaces(3, PatchKernel::CONNECTIVITY_STORAGE_PATCH);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing interfaces built in bulk" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
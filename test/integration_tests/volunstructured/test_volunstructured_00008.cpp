@@ -0,0 +1,439 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Adds an isolated cell to the patch.
+*
+* The cell is a unit cell placed away from the structured grid.
+*
+* \param origin is the origin of the cell
+* \param patch is the patch that will be filled
+*/
+void addIsolatedCell(const std::array<double, 3> &origin, VolUnstructured *patch)
+{
+    int dimension = patch->getDimension();
+
+    patch->setVertexAutoIndexing(true);
+
+    int nVertices = (dimension == 3) ? 8 : 4;
+    std::vector<long> connect(nVertices);
+    for (int v = 0; v < nVertices; ++v) {
+        double x = origin[0] + (((v + 1) / 2) % 2);
+        double y = origin[1] + ((v / 2) % 2);
+        double z = (dimension == 3) ? origin[2] + (v / 4) : 0.;
+        connect[v] = patch->addVertex({{x, y, z}})->getId();
+    }
+
+    ElementType type = (dimension == 3) ? ElementType::HEXAHEDRON : ElementType::QUAD;
+    patch->addCell(type, connect);
+}
+
+/*!
+* Checks if the cached geometry matches the evaluated one.
+*
+* While the cache is up-to-date the evaluation functions of the patch return
+* the cached values, hence the reference values are evaluated on a clone of
+* the patch without the cache.
+*
+* \param patch is the patch
+* \result Returns true if the cached geometry matches the evaluated one,
+* false otherwise.
+*/
+bool isGeometryCacheValid(const VolUnstructured &patch)
+{
+    const double TOLERANCE = 1e-12;
+
+    std::unique_ptr<PatchKernel> referencePatch = patch.clone();
+    referencePatch->destroyGeometryCache();
+    const VolUnstructured &reference = static_cast<const VolUnstructured &>(*referencePatch);
+
+    for (const Cell &cell : patch.getCells()) {
+        long cellId = cell.getId();
+
+        std::array<double, 3> centroid = reference.evalCellCentroid(cellId);
+        if (norm2(patch.getCachedCellCentroid(cellId) - centroid) > TOLERANCE) {
+            log::cout() << "   Wrong cached centroid for cell " << cellId << std::endl;
+            return false;
+        }
+
+        if (patch.isGeometryCacheEnabled()) {
+            for (int d = 0; d < 3; ++d) {
+                if (std::abs(patch.getCellCentroidCache(d).at(cellId) - centroid[d]) > TOLERANCE) {
+                    log::cout() << "   Wrong centroid storage for cell " << cellId << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        double volume = reference.evalCellVolume(cellId);
+        if (std::abs(patch.getCachedCellVolume(cellId) - volume) > TOLERANCE) {
+            log::cout() << "   Wrong cached volume for cell " << cellId << std::endl;
+            return false;
+        }
+
+        if (std::abs(patch.evalCellVolume(cellId) - volume) > TOLERANCE) {
+            log::cout() << "   Wrong evaluated volume for cell " << cellId << std::endl;
+            return false;
+        }
+    }
+
+    for (const Interface &interface : patch.getInterfaces()) {
+        long interfaceId = interface.getId();
+
+        if (std::abs(patch.getCachedInterfaceArea(interfaceId) - reference.evalInterfaceArea(interfaceId)) > TOLERANCE) {
+            log::cout() << "   Wrong cached area for interface " << interfaceId << std::endl;
+            return false;
+        }
+
+        if (norm2(patch.getCachedInterfaceNormal(interfaceId) - reference.evalInterfaceNormal(interfaceId)) > TOLERANCE) {
+            log::cout() << "   Wrong cached normal for interface " << interfaceId << std::endl;
+            return false;
+        }
+
+        if (std::abs(patch.evalInterfaceArea(interfaceId) - reference.evalInterfaceArea(interfaceId)) > TOLERANCE) {
+            log::cout() << "   Wrong evaluated area for interface " << interfaceId << std::endl;
+            return false;
+        }
+
+        if (norm2(patch.evalInterfaceNormal(interfaceId) - reference.evalInterfaceNormal(interfaceId)) > TOLERANCE) {
+            log::cout() << "   Wrong evaluated normal for interface " << interfaceId << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+* Checks the geometry cache.
+*
+* \param dimension is the dimension of the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkGeometryCache(int dimension)
+{
+    int n = (dimension == 3) ? 12 : 64;
+
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patch..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(dimension);
+#endif
+    createStructuredGrid(n, &patch);
+    patch.initializeAdjacencies();
+    patch.initializeInterfaces();
+
+    // Initialize the cache
+    log::cout() << " Initializing geometry cache..." << std::endl;
+
+    patch.initializeGeometryCache();
+    if (patch.isGeometryCacheDirty() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not initialized correctly!" << std::endl;
+        return 1;
+    }
+
+    // Delete and add some cells
+    //
+    // The cached geometry of the new cells and of their interfaces, as well
+    // as the cached geometry of the interfaces of the cells adjacent to the
+    // deleted ones, will be evaluated during the update.
+    log::cout() << " Updating geometry cache after deleting and adding cells..." << std::endl;
+
+    std::vector<long> deletedCells;
+    for (long cellId = 0; cellId < patch.getCellCount(); cellId += 5) {
+        deletedCells.push_back(cellId);
+    }
+    patch.deleteCells(deletedCells);
+    patch.update();
+    if (!isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after deleting cells!" << std::endl;
+        return 1;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        addIsolatedCell({{10. + 2. * i, 10., 10.}}, &patch);
+    }
+    if (!patch.isGeometryCacheDirty()) {
+        log::cout() << "   Geometry cache is not dirty after adding cells!" << std::endl;
+        return 1;
+    }
+
+    patch.update();
+    if (patch.isGeometryCacheDirty() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after adding cells!" << std::endl;
+        return 1;
+    }
+
+    // Transform the patch
+    log::cout() << " Updating geometry cache after transforming the patch..." << std::endl;
+
+    patch.translate(1., 2., 3.);
+    patch.scale(2.);
+    patch.update();
+    if (!isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after transforming the patch!" << std::endl;
+        return 1;
+    }
+
+    // Clone the patch
+    log::cout() << " Cloning the patch..." << std::endl;
+
+    std::unique_ptr<PatchKernel> clonedPatch = patch.clone();
+    if (!isGeometryCacheValid(static_cast<const VolUnstructured &>(*clonedPatch))) {
+        log::cout() << "   Geometry cache not cloned correctly!" << std::endl;
+        return 1;
+    }
+    clonedPatch.reset();
+
+    for (int i = 0; i < 8; ++i) {
+        addIsolatedCell({{10. + 2. * i, 20., 10.}}, &patch);
+    }
+    patch.update();
+    if (!isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after destroying the clone!" << std::endl;
+        return 1;
+    }
+
+    // Destroy the cache
+    log::cout() << " Destroying geometry cache..." << std::endl;
+
+    patch.destroyGeometryCache();
+    if (patch.isGeometryCacheEnabled() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not destroyed correctly!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << " Geometry cache updated correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Checks the geometry cache of interfaces built after enabling the cache.
+*
+* \param dimension is the dimension of the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkGeometryCacheLateInterfaces(int dimension)
+{
+    int n = (dimension == 3) ? 12 : 64;
+
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patch..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(dimension);
+#endif
+    createStructuredGrid(n, &patch);
+    patch.initializeAdjacencies();
+
+    // Initialize the cache
+    log::cout() << " Initializing geometry cache..." << std::endl;
+
+    patch.initializeGeometryCache();
+    if (patch.isGeometryCacheDirty() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not initialized correctly!" << std::endl;
+        return 1;
+    }
+
+    // Build the interfaces
+    //
+    // The cached geometry of the new interfaces will be evaluated during
+    // the update, until then the evaluation functions should not return
+    // cached values.
+    log::cout() << " Updating geometry cache after building the interfaces..." << std::endl;
+
+    patch.buildInterfaces();
+    if (!patch.isGeometryCacheDirty()) {
+        log::cout() << "   Geometry cache is not dirty after building the interfaces!" << std::endl;
+        return 1;
+    }
+
+    for (const Interface &interface : patch.getInterfaces()) {
+        long interfaceId = interface.getId();
+        if (patch.evalInterfaceArea(interfaceId) <= 0.) {
+            log::cout() << "   Wrong evaluated area for interface " << interfaceId << std::endl;
+            return 1;
+        }
+    }
+
+    patch.update();
+    if (patch.isGeometryCacheDirty() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after building the interfaces!" << std::endl;
+        return 1;
+    }
+
+    // Re-build the interfaces
+    log::cout() << " Updating geometry cache after re-building the interfaces..." << std::endl;
+
+    patch.destroyInterfaces();
+    patch.initializeInterfaces(PatchKernel::INTERFACES_AUTOMATIC);
+    patch.update();
+    if (patch.isGeometryCacheDirty() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after re-building the interfaces!" << std::endl;
+        return 1;
+    }
+
+    // Add an interface
+    //
+    // The interface is a copy of an existing interface with the opposite
+    // orientation, hence its cached normal cannot match the cached normal
+    // of any other interface.
+    log::cout() << " Updating geometry cache after adding an interface..." << std::endl;
+
+    Interface flippedInterface(*(patch.getInterfaces().cbegin()));
+    long *flippedConnect = flippedInterface.getConnect();
+    std::reverse(flippedConnect, flippedConnect + flippedInterface.getConnectSize());
+    flippedInterface.setId(Element::NULL_ID);
+
+    long flippedInterfaceId = patch.addInterface(std::move(flippedInterface))->getId();
+    if (!patch.isGeometryCacheDirty()) {
+        log::cout() << "   Geometry cache is not dirty after adding an interface!" << std::endl;
+        return 1;
+    }
+
+    std::array<double, 3> flippedNormal = patch.evalInterfaceNormal(flippedInterfaceId);
+
+    patch.update();
+    if (patch.isGeometryCacheDirty() || !isGeometryCacheValid(patch)) {
+        log::cout() << "   Geometry cache not updated correctly after adding an interface!" << std::endl;
+        return 1;
+    }
+
+    if (norm2(patch.evalInterfaceNormal(flippedInterfaceId) - flippedNormal) > 1e-12) {
+        log::cout() << "   Wrong cached normal for the added interface!" << std::endl;
+        return 1;
+    }
+
+    log::cout() << " Geometry cache of late interfaces updated correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing geometry cache.
+*/
+int subtest_001()
+{
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    int status;
+
+    status = checkGeometryCache(2);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkGeometryCache(3);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Subtest 002
+*
+* Testing geometry cache of interfaces built after enabling the cache.
+*/
+int subtest_002()
+{
+    int status;
+
+    status = checkGeometryCacheLateInterfaces(2);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkGeometryCacheLateInterfaces(3);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing geometry cache" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_002();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,241 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Evaluates the id of the cell of the grid that contains the specified point.
+*
+* \param n is the number of cells along each direction
+* \param dimension is the dimension of the grid
+* \param point is the point
+* \result The id of the cell of the grid that contains the specified point,
+* if the point is outside the grid, the null id is returned.
+*/
+long evalExpectedCell(int n, int dimension, const std::array<double, 3> &point)
+{
+    std::array<long, 3> ijk = {{0, 0, 0}};
+    for (int d = 0; d < dimension; ++d) {
+        if (point[d] < 0. || point[d] > 1.) {
+            return Cell::NULL_ID;
+        }
+
+        ijk[d] = std::min(static_cast<long>(std::floor(point[d] * n)), long(n - 1));
+    }
+
+    return ijk[0] + n * (ijk[1] + n * ijk[2]);
+}
+
+/*!
+* Checks point location.
+*
+* \param dimension is the dimension of the patch
+* \param cellType is the type of the cells of the grid
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkPointLocation(int dimension, ElementType cellType)
+{
+    int n = (dimension == 3) ? 10 : 40;
+    double h = 1. / n;
+
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patch with cells of type " << static_cast<int>(cellType) << "..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured patch(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(dimension);
+#endif
+    createStructuredGrid(n, cellType, &patch);
+
+    // Generate the points
+    //
+    // Points are placed away from the faces of the cells, this way the
+    // cell that contains each point is uniquely defined.
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> cellDistribution(-2, n + 1);
+    std::uniform_real_distribution<double> offsetDistribution(-0.4, 0.4);
+
+    int nPoints = 2000;
+    std::vector<std::array<double, 3>> points(nPoints);
+    for (std::array<double, 3> &point : points) {
+        point.fill(0.);
+        for (int d = 0; d < dimension; ++d) {
+            point[d] = (cellDistribution(generator) + 0.5 + offsetDistribution(generator)) * h;
+        }
+    }
+
+    // Locate the points one at a time
+    log::cout() << " Locating points one at a time..." << std::endl;
+
+    for (const std::array<double, 3> &point : points) {
+        long expectedCellId = evalExpectedCell(n, dimension, point);
+        if (patch.locatePoint(point) != expectedCellId) {
+            log::cout() << "   Point " << point << " not located correctly!" << std::endl;
+            return 1;
+        }
+    }
+
+    // Locate the points in batch
+    log::cout() << " Locating points in batch..." << std::endl;
+
+    std::vector<long> cellIds(nPoints);
+    patch.locatePoints(nPoints, points.data(), cellIds.data());
+    for (int i = 0; i < nPoints; ++i) {
+        if (cellIds[i] != evalExpectedCell(n, dimension, points[i])) {
+            log::cout() << "   Point " << points[i] << " not located correctly!" << std::endl;
+            return 1;
+        }
+    }
+
+    // Locate the points after deleting some cells
+    log::cout() << " Locating points after deleting cells..." << std::endl;
+
+    std::vector<long> deletedCells;
+    for (long cellId = 0; cellId < patch.getCellCount(); cellId += 3) {
+        deletedCells.push_back(cellId);
+    }
+    patch.deleteCells(deletedCells);
+    patch.update();
+
+    patch.locatePoints(nPoints, points.data(), cellIds.data());
+    for (int i = 0; i < nPoints; ++i) {
+        long expectedCellId = evalExpectedCell(n, dimension, points[i]);
+        if (expectedCellId != Cell::NULL_ID && !patch.getCells().exists(expectedCellId)) {
+            expectedCellId = Cell::NULL_ID;
+        }
+
+        if (cellIds[i] != expectedCellId) {
+            log::cout() << "   Point " << points[i] << " not located correctly after deleting cells!" << std::endl;
+            return 1;
+        }
+    }
+
+    // Locate the points after translating the patch
+    log::cout() << " Locating points after translating the patch..." << std::endl;
+
+    std::array<double, 3> translation = {{0., 0., 0.}};
+    translation[0] = 0.5;
+    patch.translate(translation);
+
+    patch.locatePoints(nPoints, points.data(), cellIds.data());
+    for (int i = 0; i < nPoints; ++i) {
+        long expectedCellId = evalExpectedCell(n, dimension, points[i] - translation);
+        if (expectedCellId != Cell::NULL_ID && !patch.getCells().exists(expectedCellId)) {
+            expectedCellId = Cell::NULL_ID;
+        }
+
+        if (cellIds[i] != expectedCellId) {
+            log::cout() << "   Point " << points[i] << " not located correctly after translating the patch!" << std::endl;
+            return 1;
+        }
+    }
+
+    log::cout() << " Points located correctly" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing point location.
+*/
+int subtest_001()
+{
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    int status;
+
+    status = checkPointLocation(2, ElementType::QUAD);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkPointLocation(2, ElementType::PIXEL);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkPointLocation(3, ElementType::HEXAHEDRON);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkPointLocation(3, ElementType::VOXEL);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing point location" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,316 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <algorithm>
+#include <map>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Adds to the patch a cell with newly created vertices.
+*
+* \param origin is the origin of the cell
+* \param h is the size of the cell
+* \param patch is the patch
+*/
+void addCellWithNewVertices(const std::array<double, 3> &origin, double h, VolUnstructured *patch)
+{
+    int dimension = patch->getDimension();
+    int nz = (dimension == 3) ? 1 : 0;
+
+    std::vector<long> connect;
+    for (int k = 0; k <= nz; ++k) {
+        for (const std::array<int, 2> &ij : std::vector<std::array<int, 2>>({{{0, 0}}, {{1, 0}}, {{1, 1}}, {{0, 1}}})) {
+            std::array<double, 3> coords = origin + std::array<double, 3>({{ij[0] * h, ij[1] * h, k * h}});
+            connect.push_back(patch->addVertex(coords).getId());
+        }
+    }
+
+    if (dimension == 3) {
+        patch->addCell(ElementType::HEXAHEDRON, connect);
+    } else {
+        patch->addCell(ElementType::QUAD, connect);
+    }
+}
+
+/*!
+* Checks that the vertex incidence stored in the patch and the one-rings of
+* the vertices match the incidence evaluated looping over the cells.
+*
+* \param patch is the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkIncidence(const VolUnstructured &patch)
+{
+    std::map<long, std::vector<long>> expectedIncidence;
+    for (const Vertex &vertex : patch.getVertices()) {
+        expectedIncidence[vertex.getId()];
+    }
+
+    for (const Cell &cell : patch.getCells()) {
+        for (long vertexId : cell.getVertexIds()) {
+            expectedIncidence[vertexId].push_back(cell.getId());
+        }
+    }
+
+    for (auto &entry : expectedIncidence) {
+        long vertexId = entry.first;
+        std::vector<long> &expectedCells = entry.second;
+        std::sort(expectedCells.begin(), expectedCells.end());
+
+        int nIncidentCells = patch.getVertexIncidentCellCount(vertexId);
+        const long *incidentCells = patch.getVertexIncidentCells(vertexId);
+        if (std::vector<long>(incidentCells, incidentCells + nIncidentCells) != expectedCells) {
+            log::cout() << "   Wrong incidence for vertex " << vertexId << std::endl;
+            return 1;
+        }
+
+        if (patch.findVertexOneRing(vertexId) != expectedCells) {
+            log::cout() << "   Wrong one-ring for vertex " << vertexId << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Checks that the vertex neighbours evaluated using the vertex incidence
+* match the ones evaluated by the reference patch.
+*
+* \param patch is the patch with the vertex incidence enabled
+* \param reference is the reference patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkQueries(const VolUnstructured &patch, const VolUnstructured &reference)
+{
+    if (checkIncidence(patch) != 0) {
+        return 1;
+    }
+
+    for (const Cell &cell : reference.getCells()) {
+        long cellId = cell.getId();
+        for (bool complete : {true, false}) {
+            if (patch.findCellVertexNeighs(cellId, complete) != reference.findCellVertexNeighs(cellId, complete)) {
+                log::cout() << "   Wrong vertex neighbours for cell " << cellId << std::endl;
+                return 1;
+            }
+        }
+
+        int nCellVertices = cell.getVertexCount();
+        for (int k = 0; k < nCellVertices; ++k) {
+            if (patch.findCellVertexOneRing(cellId, k) != reference.findCellVertexOneRing(cellId, k)) {
+                log::cout() << "   Wrong one-ring for vertex " << k << " of cell " << cellId << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Checks the vertex incidence.
+*
+* \param dimension is the dimension of the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkVertexIncidence(int dimension)
+{
+    int n = (dimension == 3) ? 6 : 16;
+    double h = 1. / n;
+
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patches..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured reference(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured reference(dimension);
+#endif
+    createStructuredGrid(n, &reference);
+    reference.initializeAdjacencies();
+    reference.update();
+
+    VolUnstructured patch(reference);
+    patch.initializeVertexIncidence();
+    if (!patch.isVertexIncidenceEnabled() || patch.isVertexIncidenceDirty()) {
+        log::cout() << " Vertex incidence not initialized correctly" << std::endl;
+        return 1;
+    }
+
+    // Check queries on the initial patch
+    log::cout() << " Checking queries on the initial patch..." << std::endl;
+    if (checkQueries(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Check queries on a copy of the patch
+    log::cout() << " Checking queries on a copy of the patch..." << std::endl;
+    VolUnstructured patchCopy(patch);
+    if (checkQueries(patchCopy, reference) != 0) {
+        return 1;
+    }
+
+    // Check queries after deleting cells
+    log::cout() << " Checking queries after deleting cells..." << std::endl;
+
+    std::vector<long> deletedCells;
+    for (const Cell &cell : reference.getCells()) {
+        if (cell.getId() % 5 == 0) {
+            deletedCells.push_back(cell.getId());
+        }
+    }
+
+    for (VolUnstructured *target : {&reference, &patch}) {
+        target->deleteCells(deletedCells);
+        target->deleteOrphanVertices();
+        target->update();
+    }
+
+    if (checkQueries(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Check queries after adding cells
+    //
+    // Added cells are placed next to the grid and each cell has its own
+    // vertices, hence the new cells are not connected to the grid nor to
+    // each other. Coincident vertices are then collapsed, this connects
+    // the new cells to the rest of the patch.
+    log::cout() << " Checking queries after adding cells..." << std::endl;
+
+    for (VolUnstructured *target : {&reference, &patch}) {
+        for (int i = 0; i < n; ++i) {
+            addCellWithNewVertices({{1. + i * h, 0., 0.}}, h, target);
+        }
+        target->update();
+    }
+
+    if (checkQueries(patch, reference) != 0) {
+        return 1;
+    }
+
+    log::cout() << " Checking queries after collapsing coincident vertices..." << std::endl;
+
+    for (VolUnstructured *target : {&reference, &patch}) {
+        target->deleteCoincidentVertices();
+        target->update();
+    }
+
+    if (checkQueries(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Check queries after renumbering the cells
+    log::cout() << " Checking queries after renumbering the cells..." << std::endl;
+
+    for (VolUnstructured *target : {&reference, &patch}) {
+        target->consecutiveRenumberCells(100);
+    }
+
+    if (checkQueries(patch, reference) != 0) {
+        return 1;
+    }
+
+    // Destroy the incidence
+    patch.destroyVertexIncidence();
+    if (patch.isVertexIncidenceEnabled()) {
+        log::cout() << " Vertex incidence not destroyed correctly" << std::endl;
+        return 1;
+    }
+
+    log::cout() << " Vertex incidence is correct" << std::endl;
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing vertex incidence.
+*/
+int subtest_001()
+{
+    utils::threads::setBackend(utils::threads::BACKEND_THREAD_POOL);
+    utils::threads::setThreadCount(4);
+
+    int status;
+
+    status = checkVertexIncidence(2);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkVertexIncidence(3);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing vertex incidence" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
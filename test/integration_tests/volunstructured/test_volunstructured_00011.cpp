@@ -0,0 +1,385 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+using namespace bitpit;
+
+/*!
+* Creates a structured grid stored in an unstructured patch.
+*
+* Vertices and cells are created in random order.
+*
+* \param n is the number of cells along each direction
+* \param patch is the patch that will be filled
+*/
+void createShuffledGrid(int n, VolUnstructured *patch)
+{
+    int dimension = patch->getDimension();
+    int nz = (dimension == 3) ? n : 0;
+
+    std::mt19937 generator(1);
+
+    std::vector<std::array<int, 3>> vertexIndexes;
+    for (int k = 0; k <= nz; ++k) {
+        for (int j = 0; j <= n; ++j) {
+            for (int i = 0; i <= n; ++i) {
+                vertexIndexes.push_back({{i, j, k}});
+            }
+        }
+    }
+    std::shuffle(vertexIndexes.begin(), vertexIndexes.end(), generator);
+
+    double h = 1. / n;
+    std::map<std::array<int, 3>, long> vertexIds;
+    for (const std::array<int, 3> &ijk : vertexIndexes) {
+        vertexIds[ijk] = patch->addVertex({{ijk[0] * h, ijk[1] * h, ijk[2] * h}})->getId();
+    }
+
+    auto vertexId = [&vertexIds](int i, int j, int k) {
+        return vertexIds.at({{i, j, k}});
+    };
+
+    std::vector<std::array<int, 3>> cellIndexes;
+    for (int k = 0; k < std::max(nz, 1); ++k) {
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                cellIndexes.push_back({{i, j, k}});
+            }
+        }
+    }
+    std::shuffle(cellIndexes.begin(), cellIndexes.end(), generator);
+
+    for (const std::array<int, 3> &ijk : cellIndexes) {
+        int i = ijk[0];
+        int j = ijk[1];
+        int k = ijk[2];
+        if (dimension == 3) {
+            patch->addCell(ElementType::HEXAHEDRON, std::vector<long>({{
+                vertexId(i,     j,     k), vertexId(i + 1, j,     k),
+                vertexId(i + 1, j + 1, k), vertexId(i,     j + 1, k),
+                vertexId(i,     j,     k + 1), vertexId(i + 1, j,     k + 1),
+                vertexId(i + 1, j + 1, k + 1), vertexId(i,     j + 1, k + 1)
+            }}));
+        } else {
+            patch->addCell(ElementType::QUAD, std::vector<long>({{
+                vertexId(i, j, 0), vertexId(i + 1, j, 0),
+                vertexId(i + 1, j + 1, 0), vertexId(i, j + 1, 0)
+            }}));
+        }
+    }
+}
+
+/*!
+* Evaluates the bandwidth of the cell adjacency graph, using the position
+* of the cells in the storage as index.
+*
+* \param patch is the patch
+* \result The bandwidth of the cell adjacency graph.
+*/
+std::size_t evalBandwidth(const VolUnstructured &patch)
+{
+    std::unordered_map<long, std::size_t> positions;
+    for (const Cell &cell : patch.getCells()) {
+        positions.insert({cell.getId(), positions.size()});
+    }
+
+    std::size_t bandwidth = 0;
+    for (const Cell &cell : patch.getCells()) {
+        std::size_t position = positions.at(cell.getId());
+        for (long neighId : patch.findCellFaceNeighs(cell.getId())) {
+            std::size_t neighPosition = positions.at(neighId);
+            bandwidth = std::max(bandwidth, std::max(position, neighPosition) - std::min(position, neighPosition));
+        }
+    }
+
+    return bandwidth;
+}
+
+/*!
+* Checks that the reordered patch describes the same mesh of the reference
+* patch.
+*
+* \param patch is the reordered patch
+* \param reference is the reference patch
+* \param cellMap maps the ids of the reference cells to the ids of the
+* reordered cells
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkMesh(const VolUnstructured &patch, const VolUnstructured &reference,
+              const std::unordered_map<long, long> &cellMap)
+{
+    if (patch.getCellCount() != reference.getCellCount() || patch.getVertexCount() != reference.getVertexCount() ||
+            patch.getInterfaceCount() != reference.getInterfaceCount()) {
+        log::cout() << "   Wrong number of items" << std::endl;
+        return 1;
+    }
+
+    for (const Cell &referenceCell : reference.getCells()) {
+        long referenceId = referenceCell.getId();
+        long cellId = cellMap.at(referenceId);
+        if (!patch.getCells().exists(cellId)) {
+            log::cout() << "   Cell " << referenceId << " was lost" << std::endl;
+            return 1;
+        }
+
+        if (norm2(patch.evalCellCentroid(cellId) - reference.evalCellCentroid(referenceId)) > 1e-12) {
+            log::cout() << "   Wrong centroid for cell " << cellId << std::endl;
+            return 1;
+        }
+
+        std::vector<long> expectedNeighs;
+        for (long referenceNeighId : reference.findCellFaceNeighs(referenceId)) {
+            expectedNeighs.push_back(cellMap.at(referenceNeighId));
+        }
+        std::sort(expectedNeighs.begin(), expectedNeighs.end());
+
+        std::vector<long> neighs = patch.findCellFaceNeighs(cellId);
+        std::sort(neighs.begin(), neighs.end());
+        if (neighs != expectedNeighs) {
+            log::cout() << "   Wrong neighbours for cell " << cellId << std::endl;
+            return 1;
+        }
+
+        const Cell &cell = patch.getCell(cellId);
+        int nCellInterfaces = cell.getInterfaceCount();
+        const long *interfaces = cell.getInterfaces();
+        for (int k = 0; k < nCellInterfaces; ++k) {
+            const Interface &interface = patch.getInterface(interfaces[k]);
+            if (interface.getOwner() != cellId && interface.getNeigh() != cellId) {
+                log::cout() << "   Wrong interfaces for cell " << cellId << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Checks the reordering of the patch.
+*
+* \param dimension is the dimension of the patch
+* \result Returns zero on success, a non-zero value otherwise.
+*/
+int checkReorder(int dimension)
+{
+    int n = (dimension == 3) ? 8 : 16;
+
+    log::cout() << std::endl;
+    log::cout() << "Creating " << dimension << "D patch..." << std::endl;
+
+#if BITPIT_ENABLE_MPI
+    VolUnstructured reference(dimension, MPI_COMM_NULL);
+#else
+    VolUnstructured reference(dimension);
+#endif
+    createShuffledGrid(n, &reference);
+    reference.initializeAdjacencies();
+    reference.initializeInterfaces();
+    reference.update();
+
+    std::size_t referenceBandwidth = evalBandwidth(reference);
+    log::cout() << " Bandwidth of the initial patch: " << referenceBandwidth << std::endl;
+
+    std::unordered_map<long, long> identityMap;
+    for (const Cell &cell : reference.getCells()) {
+        identityMap.insert({cell.getId(), cell.getId()});
+    }
+
+    double h = 1. / n;
+    for (PatchKernel::SpatialOrdering ordering : {PatchKernel::SPATIAL_ORDERING_HILBERT, PatchKernel::SPATIAL_ORDERING_MORTON, PatchKernel::SPATIAL_ORDERING_RCM}) {
+        log::cout() << " Checking ordering " << ordering << "..." << std::endl;
+
+        // Reorder the patch
+        VolUnstructured patch(reference);
+
+        PiercedStorage<long, long> cellData(1, &patch.getCells(), PiercedSyncMaster::SYNC_MODE_JOURNALED);
+        for (const Cell &cell : patch.getCells()) {
+            cellData[cell.getId()] = cell.getId();
+        }
+
+        std::vector<adaption::Info> reorderInfo = patch.reorder(ordering);
+        if (!reorderInfo.empty()) {
+            log::cout() << "   Ids changed without renumbering" << std::endl;
+            return 1;
+        }
+
+        if (checkMesh(patch, reference, identityMap) != 0) {
+            return 1;
+        }
+
+        for (const Cell &cell : patch.getCells()) {
+            if (cellData[cell.getId()] != cell.getId()) {
+                log::cout() << "   Synchronized storage doesn't follow the cells" << std::endl;
+                return 1;
+            }
+        }
+
+        std::size_t bandwidth = evalBandwidth(patch);
+        log::cout() << "   Bandwidth of the reordered patch: " << bandwidth << std::endl;
+        if (bandwidth >= referenceBandwidth) {
+            log::cout() << "   Reordering didn't reduce the bandwidth" << std::endl;
+            return 1;
+        }
+
+        // Consecutive cells along a Hilbert curve are face neighbours
+        if (ordering == PatchKernel::SPATIAL_ORDERING_HILBERT) {
+            std::array<double, 3> previousCentroid = patch.evalCellCentroid(patch.getCells().begin()->getId());
+            for (const Cell &cell : patch.getCells()) {
+                std::array<double, 3> centroid = patch.evalCellCentroid(cell.getId());
+                double distance = norm2(centroid - previousCentroid);
+                if (cell.getId() != patch.getCells().begin()->getId() && !utils::DoubleFloatingEqual()(distance, h)) {
+                    log::cout() << "   Consecutive cells are not face neighbours" << std::endl;
+                    return 1;
+                }
+                previousCentroid = centroid;
+            }
+        }
+
+        // Reorder and renumber the patch
+        VolUnstructured renumberedPatch(reference);
+        reorderInfo = renumberedPatch.reorder(ordering, true);
+
+        std::unordered_map<long, long> cellMap = identityMap;
+        std::map<long, long> interfaceMap;
+        for (const adaption::Info &info : reorderInfo) {
+            if (info.type != adaption::TYPE_RENUMBERING || info.previous.size() != 1 || info.current.size() != 1) {
+                log::cout() << "   Wrong renumbering information" << std::endl;
+                return 1;
+            }
+
+            if (info.entity == adaption::ENTITY_CELL) {
+                cellMap[info.previous[0]] = info.current[0];
+            } else {
+                interfaceMap[info.previous[0]] = info.current[0];
+            }
+        }
+
+        if (checkMesh(renumberedPatch, reference, cellMap) != 0) {
+            return 1;
+        }
+
+        long expectedCellId = 0;
+        for (const Cell &cell : renumberedPatch.getCells()) {
+            if (cell.getId() != expectedCellId++) {
+                log::cout() << "   Cells are not numbered consecutively" << std::endl;
+                return 1;
+            }
+        }
+
+        long expectedVertexId = 0;
+        for (const Vertex &vertex : renumberedPatch.getVertices()) {
+            if (vertex.getId() != expectedVertexId++) {
+                log::cout() << "   Vertices are not numbered consecutively" << std::endl;
+                return 1;
+            }
+        }
+
+        for (const Interface &interface : reference.getInterfaces()) {
+            long interfaceId = interface.getId();
+            auto interfaceItr = interfaceMap.find(interfaceId);
+            if (interfaceItr != interfaceMap.end()) {
+                interfaceId = interfaceItr->second;
+            }
+
+            const Interface &renumberedInterface = renumberedPatch.getInterface(interfaceId);
+            if (renumberedInterface.getOwner() != cellMap.at(interface.getOwner())) {
+                log::cout() << "   Wrong renumbering information for interface " << interface.getId() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing spatial reordering of the patch.
+*/
+int subtest_001()
+{
+    utils::threads::setThreadCount(4);
+
+    int status;
+
+    status = checkReorder(2);
+    if (status != 0) {
+        return status;
+    }
+
+    status = checkReorder(3);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing spatial reordering" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,212 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Checks that the memory usage matches the sum of its breakdown.
+*
+* \param patch is the patch
+* \result Returns zero if the check succeeded, a non-zero value otherwise.
+*/
+int checkBreakdown(const VolUnstructured &patch)
+{
+    std::map<std::string, std::size_t> breakdown = patch.getMemoryUsageBreakdown();
+
+    std::size_t breakdownTotal = 0;
+    for (const auto &entry : breakdown) {
+        log::cout() << "    " << entry.first << ": " << entry.second << " bytes" << std::endl;
+        breakdownTotal += entry.second;
+    }
+
+    if (breakdownTotal != patch.getMemoryUsage()) {
+        log::cout() << "  Memory usage doesn't match the sum of its breakdown" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing memory usage accounting of an unstructured patch.
+*/
+int subtest_001()
+{
+    const int N = 8;
+
+    int status;
+
+    // Create the patch
+#if BITPIT_ENABLE_MPI==1
+    VolUnstructured patch(3, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(3);
+#endif
+
+    std::size_t emptyMemory = patch.getMemoryUsage();
+    log::cout() << "  Memory usage of the empty patch: " << emptyMemory << " bytes" << std::endl;
+    status = checkBreakdown(patch);
+    if (status != 0) {
+        return status;
+    }
+
+    // Fill the patch
+    createStructuredGrid(N, &patch);
+
+    std::map<std::string, std::size_t> gridBreakdown = patch.getMemoryUsageBreakdown();
+    log::cout() << "  Memory usage after creating the grid: " << patch.getMemoryUsage() << " bytes" << std::endl;
+    status = checkBreakdown(patch);
+    if (status != 0) {
+        return status;
+    }
+
+    if (gridBreakdown.at("vertices") < static_cast<std::size_t>((N + 1) * (N + 1) * (N + 1)) * sizeof(Vertex)) {
+        log::cout() << "  Memory used by the vertices is smaller than expected" << std::endl;
+        return 1;
+    }
+
+    if (gridBreakdown.at("cells") < static_cast<std::size_t>(N * N * N) * (sizeof(Cell) + 8 * sizeof(long))) {
+        log::cout() << "  Memory used by the cells is smaller than expected" << std::endl;
+        return 1;
+    }
+
+    if (gridBreakdown.at("point locator") != 0) {
+        log::cout() << "  Point locator memory should be zero before the locator is built" << std::endl;
+        return 1;
+    }
+
+    // Build adjacencies and interfaces
+    patch.initializeAdjacencies();
+    patch.initializeInterfaces();
+
+    std::map<std::string, std::size_t> connectivityBreakdown = patch.getMemoryUsageBreakdown();
+    log::cout() << "  Memory usage after building adjacencies and interfaces: " << patch.getMemoryUsage() << " bytes" << std::endl;
+    status = checkBreakdown(patch);
+    if (status != 0) {
+        return status;
+    }
+
+    if (connectivityBreakdown.at("cells") <= gridBreakdown.at("cells")) {
+        log::cout() << "  Memory used by the cells should grow after building adjacencies" << std::endl;
+        return 1;
+    }
+
+    if (connectivityBreakdown.at("interfaces") <= gridBreakdown.at("interfaces")) {
+        log::cout() << "  Memory used by the interfaces should grow after building interfaces" << std::endl;
+        return 1;
+    }
+
+    // Build the point locator
+    patch.locatePoint(std::array<double, 3>{{0.5, 0.5, 0.5}});
+
+    std::size_t locatorMemory = patch.getMemoryUsage();
+    std::map<std::string, std::size_t> locatorBreakdown = patch.getMemoryUsageBreakdown();
+    log::cout() << "  Memory usage after building the point locator: " << locatorMemory << " bytes" << std::endl;
+    status = checkBreakdown(patch);
+    if (status != 0) {
+        return status;
+    }
+
+    if (locatorBreakdown.at("point locator") == 0) {
+        log::cout() << "  Memory used by the point locator should be positive" << std::endl;
+        return 1;
+    }
+
+    // Display statistics
+    std::stringstream stats;
+    patch.displayMemoryStats(stats, 2);
+    log::cout() << stats.str();
+
+    if (stats.str().find("point locator") == std::string::npos) {
+        log::cout() << "  Memory statistics don't contain the point locator" << std::endl;
+        return 1;
+    }
+
+    // Reset the patch
+    patch.reset();
+    patch.squeeze();
+
+    log::cout() << "  Memory usage after resetting the patch: " << patch.getMemoryUsage() << " bytes" << std::endl;
+    status = checkBreakdown(patch);
+    if (status != 0) {
+        return status;
+    }
+
+    if (patch.getMemoryUsage() >= locatorMemory) {
+        log::cout() << "  Memory usage should shrink after resetting the patch" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing memory usage accounting" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001();
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}
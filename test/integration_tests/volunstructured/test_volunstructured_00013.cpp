@@ -0,0 +1,286 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2023 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitpit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <string>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "helpers/structured_grid.hpp"
+
+using namespace bitpit;
+
+/*!
+* Checks if the restored patch matches the reference patch.
+*
+* \param patch is the restored patch
+* \param reference is the reference patch
+* \result Returns zero if the patches match, a non-zero value otherwise.
+*/
+int checkPatch(const VolUnstructured &patch, const VolUnstructured &reference)
+{
+    // Vertices
+    if (patch.getVertexCount() != reference.getVertexCount()) {
+        log::cout() << "  Number of restored vertices doesn't match" << std::endl;
+        return 1;
+    }
+
+    auto restoredVertexItr = patch.getVertices().cbegin();
+    for (const Vertex &vertex : reference.getVertices()) {
+        long vertexId = vertex.getId();
+        if (restoredVertexItr->getId() != vertexId) {
+            log::cout() << "  Order of restored vertices doesn't match" << std::endl;
+            return 1;
+        }
+
+        if (restoredVertexItr->getCoords() != vertex.getCoords()) {
+            log::cout() << "  Coordinates of vertex " << vertexId << " don't match" << std::endl;
+            return 1;
+        }
+
+        ++restoredVertexItr;
+    }
+
+    // Cells
+    if (patch.getCellCount() != reference.getCellCount()) {
+        log::cout() << "  Number of restored cells doesn't match" << std::endl;
+        return 1;
+    }
+
+    auto restoredCellItr = patch.getCells().cbegin();
+    for (const Cell &cell : reference.getCells()) {
+        long cellId = cell.getId();
+        const Cell &restoredCell = *restoredCellItr;
+        if (restoredCell.getId() != cellId) {
+            log::cout() << "  Order of restored cells doesn't match" << std::endl;
+            return 1;
+        }
+
+        if (restoredCell.getType() != cell.getType() || restoredCell.getPID() != cell.getPID()) {
+            log::cout() << "  Type or PID of cell " << cellId << " don't match" << std::endl;
+            return 1;
+        }
+
+        int nCellVertices = cell.getVertexCount();
+        for (int k = 0; k < nCellVertices; ++k) {
+            if (restoredCell.getVertexId(k) != cell.getVertexId(k)) {
+                log::cout() << "  Connectivity of cell " << cellId << " doesn't match" << std::endl;
+                return 1;
+            }
+        }
+
+        int nCellFaces = cell.getFaceCount();
+        for (int face = 0; face < nCellFaces; ++face) {
+            if (restoredCell.getAdjacencyCount(face) != cell.getAdjacencyCount(face)) {
+                log::cout() << "  Adjacencies of cell " << cellId << " don't match" << std::endl;
+                return 1;
+            }
+
+            if (restoredCell.getInterfaceCount(face) != cell.getInterfaceCount(face)) {
+                log::cout() << "  Interfaces of cell " << cellId << " don't match" << std::endl;
+                return 1;
+            }
+        }
+
+        ++restoredCellItr;
+    }
+
+    // Interfaces
+    if (patch.getInterfaceCount() != reference.getInterfaceCount()) {
+        log::cout() << "  Number of restored interfaces doesn't match" << std::endl;
+        return 1;
+    }
+
+    for (const Interface &interface : reference.getInterfaces()) {
+        long interfaceId = interface.getId();
+        const Interface &restoredInterface = patch.getInterface(interfaceId);
+        if (restoredInterface.getOwner() != interface.getOwner() || restoredInterface.getOwnerFace() != interface.getOwnerFace()) {
+            log::cout() << "  Owner of interface " << interfaceId << " doesn't match" << std::endl;
+            return 1;
+        }
+
+        if (restoredInterface.getNeigh() != interface.getNeigh()) {
+            log::cout() << "  Neighbour of interface " << interfaceId << " doesn't match" << std::endl;
+            return 1;
+        }
+
+        if (restoredInterface.getPID() != interface.getPID()) {
+            log::cout() << "  PID of interface " << interfaceId << " doesn't match" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+* Subtest 001
+*
+* Testing checkpoint of an unstructured patch.
+*
+* \param connectivityStorageMode is the connectivity storage mode of the
+* restored patch
+*/
+int subtest_001(PatchKernel::ConnectivityStorageMode connectivityStorageMode)
+{
+    const int N = 6;
+
+    int status;
+
+    // Create the patch
+#if BITPIT_ENABLE_MPI==1
+    VolUnstructured patch(3, MPI_COMM_NULL);
+#else
+    VolUnstructured patch(3);
+#endif
+    patch.initializeAdjacencies(PatchKernel::ADJACENCIES_AUTOMATIC);
+    patch.initializeInterfaces(PatchKernel::INTERFACES_AUTOMATIC);
+    createStructuredGrid(N, &patch);
+
+    // Assign the PIDs and delete some cells, in order to have holes in the
+    // containers
+    std::vector<long> gridDeletedCells;
+    for (Cell &cell : patch.getCells()) {
+        long cellId = cell.getId();
+        cell.setPID((cellId % N) % 3);
+        if (cellId % 7 == 3) {
+            gridDeletedCells.push_back(cellId);
+        }
+    }
+    patch.deleteCells(gridDeletedCells);
+    patch.update();
+
+    log::cout() << "  Created patch with " << patch.getCellCount() << " cells and " << patch.getInterfaceCount() << " interfaces" << std::endl;
+
+    // Dump the patch and some additional data
+    const std::string ARCHIVE_NAME = "volunstructured_checkpoint";
+    const std::string ADDITIONAL_DATA = "additional data";
+
+    OMappedArchive writer(ARCHIVE_NAME, patch.getDumpVersion());
+    patch.dump(writer);
+    utils::binary::write(writer, ADDITIONAL_DATA);
+    writer.close();
+
+    // Restore the patch
+#if BITPIT_ENABLE_MPI==1
+    VolUnstructured restored(MPI_COMM_NULL);
+#else
+    VolUnstructured restored;
+#endif
+    restored.setConnectivityStorageMode(connectivityStorageMode);
+
+    IMappedArchive reader(ARCHIVE_NAME);
+    restored.restore(reader);
+
+    std::string additionalData;
+    utils::binary::read(reader, additionalData);
+    reader.close();
+
+    log::cout() << "  Restored patch with " << restored.getCellCount() << " cells and " << restored.getInterfaceCount() << " interfaces" << std::endl;
+
+    status = checkPatch(restored, patch);
+    if (status != 0) {
+        return status;
+    }
+
+    if (additionalData != ADDITIONAL_DATA) {
+        log::cout() << "  Additional data doesn't match" << std::endl;
+        return 1;
+    }
+
+    // Dump and restore the patch using the checkpoint functions
+#if BITPIT_ENABLE_MPI==1
+    VolUnstructured checkpointRestored(MPI_COMM_NULL);
+#else
+    VolUnstructured checkpointRestored;
+#endif
+    checkpointRestored.setConnectivityStorageMode(connectivityStorageMode);
+
+    restored.dumpCheckpoint(ARCHIVE_NAME);
+    checkpointRestored.restoreCheckpoint(ARCHIVE_NAME);
+
+    status = checkPatch(checkpointRestored, patch);
+    if (status != 0) {
+        return status;
+    }
+
+    // The restored patch should be usable
+    std::vector<long> deletedCells = {patch.getCells().cbegin()->getId()};
+    patch.deleteCells(deletedCells);
+    patch.update();
+
+    checkpointRestored.deleteCells(deletedCells);
+    checkpointRestored.update();
+
+    status = checkPatch(checkpointRestored, patch);
+    if (status != 0) {
+        return status;
+    }
+
+    return 0;
+}
+
+/*!
+* Main program.
+*/
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+    MPI_Init(&argc,&argv);
+#else
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+#endif
+
+    // Initialize the logger
+    log::manager().initialize(log::MODE_COMBINE);
+
+    // Run the subtests
+    log::cout() << "Testing checkpoint of unstructured patches" << std::endl;
+
+    int status;
+    try {
+        status = subtest_001(PatchKernel::CONNECTIVITY_STORAGE_ELEMENT);
+        if (status != 0) {
+            return status;
+        }
+
+        status = subtest_001(PatchKernel::CONNECTIVITY_STORAGE_PATCH);
+        if (status != 0) {
+            return status;
+        }
+    } catch (const std::exception &exception) {
+        log::cout() << exception.what();
+        exit(1);
+    }
+
+#if BITPIT_ENABLE_MPI==1
+    MPI_Finalize();
+#endif
+}